@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Submix buses with gains and ducking, updated once per frame
+//------------------------------------------------------------------------
+
+#include "FZN/Includes.h"
+#include "FZN/Audio/AudioMixer.h"
+
+
+namespace fzn
+{
+	AudioMixer::AudioMixer()
+	{
+		for( uint8_t uBus = 0; uBus < NbBuses; ++uBus )
+		{
+			m_aBusGains[ uBus ]			= 1.f;
+			m_aPendingBusGains[ uBus ]	= 1.f;
+			m_aOutputGains[ uBus ]		= 1.f;
+		}
+	}
+
+	bool AudioMixer::Update( float _fDeltaTime, const uint16_t* _pNbActiveVoices )
+	{
+		m_fMasterGain = m_fPendingMasterGain;
+
+		for( uint8_t uBus = 0; uBus < NbBuses; ++uBus )
+			m_aBusGains[ uBus ] = m_aPendingBusGains[ uBus ];
+
+		for( Ducking& oDucking : m_oDuckings )
+		{
+			const bool bTriggered = _pNbActiveVoices[ (uint8_t)oDucking.m_oDesc.m_eTrigger ] > 0;
+			const float fTarget = bTriggered ? oDucking.m_oDesc.m_fGain : 1.f;
+			const float fTime = bTriggered ? oDucking.m_oDesc.m_fAttack : oDucking.m_oDesc.m_fRelease;
+
+			if( fTime <= 0.f )
+			{
+				oDucking.m_fCurrentGain = fTarget;
+				continue;
+			}
+
+			//Linear ramp covering the whole ducking range in the attack or release time.
+			const float fStep = Math::Abs( 1.f - oDucking.m_oDesc.m_fGain ) * _fDeltaTime / fTime;
+
+			if( oDucking.m_fCurrentGain < fTarget )
+				oDucking.m_fCurrentGain = Math::Min( oDucking.m_fCurrentGain + fStep, fTarget );
+			else
+				oDucking.m_fCurrentGain = Math::Max( oDucking.m_fCurrentGain - fStep, fTarget );
+		}
+
+		bool bChanged = false;
+
+		for( uint8_t uBus = 0; uBus < NbBuses; ++uBus )
+		{
+			float fGain = m_fMasterGain * m_aBusGains[ uBus ];
+
+			for( const Ducking& oDucking : m_oDuckings )
+			{
+				if( (uint8_t)oDucking.m_oDesc.m_eTarget == uBus )
+					fGain *= oDucking.m_fCurrentGain;
+			}
+
+			if( fGain != m_aOutputGains[ uBus ] )
+			{
+				m_aOutputGains[ uBus ] = fGain;
+				bChanged = true;
+			}
+		}
+
+		return bChanged;
+	}
+
+	void AudioMixer::SetMasterGain( float _fGain )
+	{
+		m_fPendingMasterGain = Math::Clamp( _fGain, 0.f, 1.f );
+	}
+
+	float AudioMixer::GetMasterGain() const
+	{
+		return m_fPendingMasterGain;
+	}
+
+	void AudioMixer::SetBusGain( AudioBus _eBus, float _fGain )
+	{
+		if( _eBus >= AudioBus::eCount )
+			return;
+
+		m_aPendingBusGains[ (uint8_t)_eBus ] = Math::Clamp( _fGain, 0.f, 1.f );
+	}
+
+	float AudioMixer::GetBusGain( AudioBus _eBus ) const
+	{
+		if( _eBus >= AudioBus::eCount )
+			return 0.f;
+
+		return m_aPendingBusGains[ (uint8_t)_eBus ];
+	}
+
+	const float* AudioMixer::GetOutputGains() const
+	{
+		return m_aOutputGains;
+	}
+
+	float AudioMixer::GetOutputGain( AudioBus _eBus ) const
+	{
+		if( _eBus >= AudioBus::eCount )
+			return 0.f;
+
+		return m_aOutputGains[ (uint8_t)_eBus ];
+	}
+
+	void AudioMixer::AddDucking( const DuckingDesc& _oDucking )
+	{
+		if( _oDucking.m_eTrigger >= AudioBus::eCount || _oDucking.m_eTarget >= AudioBus::eCount || _oDucking.m_eTrigger == _oDucking.m_eTarget )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Invalid ducking." );
+			return;
+		}
+
+		Ducking oDucking;
+		oDucking.m_oDesc = _oDucking;
+		oDucking.m_oDesc.m_fGain = Math::Clamp( _oDucking.m_fGain, 0.f, 1.f );
+
+		m_oDuckings.push_back( oDucking );
+	}
+
+	void AudioMixer::ClearDuckings()
+	{
+		m_oDuckings.clear();
+	}
+
+	AudioBus AudioMixer::GetBusFromName( const std::string& _sName, AudioBus _eDefault /*= AudioBus::eSFX*/ )
+	{
+		if( _sName == "Music" )	return AudioBus::eMusic;
+		if( _sName == "SFX" )	return AudioBus::eSFX;
+		if( _sName == "UI" )	return AudioBus::eUI;
+		if( _sName == "Voice" )	return AudioBus::eVoice;
+
+		return _eDefault;
+	}
+} //namespace fzn
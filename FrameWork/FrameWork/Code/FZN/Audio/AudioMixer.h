@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Submix buses with gains and ducking, updated once per frame
+//------------------------------------------------------------------------
+
+#ifndef _AUDIOMIXER_H_
+#define _AUDIOMIXER_H_
+
+#include <string>
+#include <vector>
+
+#include "FZN/Defines.h"
+
+
+namespace fzn
+{
+	enum class AudioBus : uint8_t
+	{
+		eMusic,
+		eSFX,
+		eUI,
+		eVoice,
+		eCount,
+	};
+
+	//The gains set during the frame are only applied by Update, so the voices volumes are refreshed at most once per frame.
+	//The output gain of a bus is : master gain * bus gain * gain of each ducking targeting the bus.
+	class FZN_EXPORT AudioMixer
+	{
+	public:
+		static constexpr uint8_t NbBuses{ (uint8_t)AudioBus::eCount };
+
+		struct DuckingDesc
+		{
+			AudioBus	m_eTrigger{ AudioBus::eVoice };		//Bus whose activity ducks the target
+			AudioBus	m_eTarget{ AudioBus::eMusic };
+			float		m_fGain{ 0.3f };					//Gain of the target while the trigger bus is active
+			float		m_fAttack{ 0.1f };					//Time to reach the ducked gain (s)
+			float		m_fRelease{ 0.5f };					//Time to go back to full gain (s)
+		};
+
+		AudioMixer();
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Applies the pending gains and moves the duckings towards their target
+		//Parameter 1 : Elapsed time since the last update (s)
+		//Parameter 2 : Number of active voices on each bus (NbBuses values)
+		//Return value : At least one output gain changed (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool					Update( float _fDeltaTime, const uint16_t* _pNbActiveVoices );
+
+		void					SetMasterGain( float _fGain );
+		float					GetMasterGain() const;
+		void					SetBusGain( AudioBus _eBus, float _fGain );
+		float					GetBusGain( AudioBus _eBus ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the final gains of the buses, as of the last update
+		//Return value : NbBuses gains
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		const float*			GetOutputGains() const;
+		float					GetOutputGain( AudioBus _eBus ) const;
+
+		void					AddDucking( const DuckingDesc& _oDucking );
+		void					ClearDuckings();
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Converts the name of a bus as written in the xml files ("Music", "SFX", "UI", "Voice")
+		//Parameter 1 : Name of the bus
+		//Parameter 2 : Bus returned if the name is unknown
+		//Return value : Corresponding bus
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static AudioBus			GetBusFromName( const std::string& _sName, AudioBus _eDefault = AudioBus::eSFX );
+
+	private:
+		struct Ducking
+		{
+			DuckingDesc			m_oDesc;
+			float				m_fCurrentGain{ 1.f };
+		};
+
+		float					m_fMasterGain{ 1.f };
+		float					m_fPendingMasterGain{ 1.f };
+		float					m_aBusGains[ NbBuses ];
+		float					m_aPendingBusGains[ NbBuses ];
+		float					m_aOutputGains[ NbBuses ];
+
+		std::vector< Ducking >	m_oDuckings;
+	};
+} //namespace fzn
+
+#endif //_AUDIOMIXER_H_
@@ -0,0 +1,731 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Fixed pool of voices with priorities, voice stealing and virtual voices
+//------------------------------------------------------------------------
+
+#include <cmath>
+
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+
+#include "FZN/Includes.h"
+#include "FZN/Audio/VoiceManager.h"
+
+
+namespace fzn
+{
+	//=========================================================
+	//=====================SfmlVoiceBackend=====================
+	//=========================================================
+
+	SfmlVoiceBackend::SfmlVoiceBackend( uint16_t _uNbRealVoices )
+	{
+		m_oSounds.resize( _uNbRealVoices );
+
+		for( sf::Sound*& pSound : m_oSounds )
+			pSound = new sf::Sound();
+	}
+
+	SfmlVoiceBackend::~SfmlVoiceBackend()
+	{
+		for( sf::Sound*& pSound : m_oSounds )
+			CheckNullptrDelete( pSound );
+	}
+
+	void SfmlVoiceBackend::Play( uint16_t _uRealVoice, const sf::SoundBuffer& _oBuffer, bool _bLoop, float _fVolume, float _fOffset )
+	{
+		sf::Sound* pSound = m_oSounds[ _uRealVoice ];
+
+		pSound->setBuffer( _oBuffer );
+		pSound->setLoop( _bLoop );
+		pSound->setVolume( _fVolume );
+		pSound->play();
+
+		if( _fOffset > 0.f )
+			pSound->setPlayingOffset( sf::seconds( _fOffset ) );
+	}
+
+	void SfmlVoiceBackend::Stop( uint16_t _uRealVoice )
+	{
+		m_oSounds[ _uRealVoice ]->stop();
+	}
+
+	void SfmlVoiceBackend::Pause( uint16_t _uRealVoice )
+	{
+		m_oSounds[ _uRealVoice ]->pause();
+	}
+
+	void SfmlVoiceBackend::Resume( uint16_t _uRealVoice )
+	{
+		if( m_oSounds[ _uRealVoice ]->getStatus() == sf::Sound::Paused )
+			m_oSounds[ _uRealVoice ]->play();
+	}
+
+	void SfmlVoiceBackend::SetVolume( uint16_t _uRealVoice, float _fVolume )
+	{
+		m_oSounds[ _uRealVoice ]->setVolume( _fVolume );
+	}
+
+	bool SfmlVoiceBackend::IsFinished( uint16_t _uRealVoice ) const
+	{
+		return m_oSounds[ _uRealVoice ]->getStatus() == sf::Sound::Stopped;
+	}
+
+
+	//=========================================================
+	//====================OfflineVoiceBackend===================
+	//=========================================================
+
+	OfflineVoiceBackend::OfflineVoiceBackend( uint16_t _uNbRealVoices, uint32_t _uSampleRate /*= 44100*/ )
+		: m_uSampleRate( Math::Max( _uSampleRate, 1u ) )
+	{
+		m_oVoices.resize( _uNbRealVoices );
+	}
+
+	void OfflineVoiceBackend::Play( uint16_t _uRealVoice, const sf::SoundBuffer& _oBuffer, bool _bLoop, float _fVolume, float _fOffset )
+	{
+		RealVoice& oVoice = m_oVoices[ _uRealVoice ];
+
+		oVoice.m_pBuffer	= &_oBuffer;
+		oVoice.m_dPosition	= (double)_fOffset * _oBuffer.getSampleRate();
+		oVoice.m_fVolume	= _fVolume;
+		oVoice.m_bLoop		= _bLoop;
+		oVoice.m_bPlaying	= true;
+		oVoice.m_bPaused	= false;
+	}
+
+	void OfflineVoiceBackend::Stop( uint16_t _uRealVoice )
+	{
+		m_oVoices[ _uRealVoice ].m_bPlaying = false;
+		m_oVoices[ _uRealVoice ].m_pBuffer = nullptr;
+	}
+
+	void OfflineVoiceBackend::Pause( uint16_t _uRealVoice )
+	{
+		m_oVoices[ _uRealVoice ].m_bPaused = true;
+	}
+
+	void OfflineVoiceBackend::Resume( uint16_t _uRealVoice )
+	{
+		m_oVoices[ _uRealVoice ].m_bPaused = false;
+	}
+
+	void OfflineVoiceBackend::SetVolume( uint16_t _uRealVoice, float _fVolume )
+	{
+		m_oVoices[ _uRealVoice ].m_fVolume = _fVolume;
+	}
+
+	bool OfflineVoiceBackend::IsFinished( uint16_t _uRealVoice ) const
+	{
+		return m_oVoices[ _uRealVoice ].m_bPlaying == false;
+	}
+
+	void OfflineVoiceBackend::Render( float* _pOutput, uint32_t _uNbFrames )
+	{
+		std::fill( _pOutput, _pOutput + 2 * _uNbFrames, 0.f );
+
+		for( RealVoice& oVoice : m_oVoices )
+		{
+			if( oVoice.m_bPlaying == false || oVoice.m_bPaused || oVoice.m_pBuffer == nullptr )
+				continue;
+
+			const sf::Int16*	pSamples		= oVoice.m_pBuffer->getSamples();
+			const uint32_t		uNbChannels		= oVoice.m_pBuffer->getChannelCount();
+			const uint64_t		uNbFrames		= uNbChannels > 0 ? oVoice.m_pBuffer->getSampleCount() / uNbChannels : 0;
+			const double		dStep			= (double)oVoice.m_pBuffer->getSampleRate() / m_uSampleRate;
+			const float			fGain			= oVoice.m_fVolume / ( 100.f * 32768.f );
+
+			if( uNbFrames == 0 )
+			{
+				oVoice.m_bPlaying = false;
+				continue;
+			}
+
+			//Nearest sample, mono buffers being sent to both channels.
+			for( uint32_t uFrame = 0; uFrame < _uNbFrames; ++uFrame )
+			{
+				uint64_t uSourceFrame = (uint64_t)oVoice.m_dPosition;
+
+				if( uSourceFrame >= uNbFrames )
+				{
+					if( oVoice.m_bLoop == false )
+					{
+						oVoice.m_bPlaying = false;
+						break;
+					}
+
+					oVoice.m_dPosition = std::fmod( oVoice.m_dPosition, (double)uNbFrames );
+					uSourceFrame = (uint64_t)oVoice.m_dPosition;
+				}
+
+				const sf::Int16* pFrame = pSamples + uSourceFrame * uNbChannels;
+
+				_pOutput[ 2 * uFrame ]		+= pFrame[ 0 ] * fGain;
+				_pOutput[ 2 * uFrame + 1 ]	+= pFrame[ uNbChannels > 1 ? 1 : 0 ] * fGain;
+
+				oVoice.m_dPosition += dStep;
+			}
+		}
+	}
+
+	uint32_t OfflineVoiceBackend::GetSampleRate() const
+	{
+		return m_uSampleRate;
+	}
+
+
+	//=========================================================
+	//=======================VoiceManager=======================
+	//=========================================================
+
+	VoiceManager::VoiceManager( VoiceBackend* _pBackend, uint16_t _uNbRealVoices /*= DefaultNbRealVoices*/, uint16_t _uNbVoices /*= DefaultNbVoices*/ )
+		: m_pBackend( _pBackend )
+	{
+		//The last index is kept for NO_REAL_VOICE.
+		_uNbVoices = Math::Min< uint16_t >( _uNbVoices, NO_REAL_VOICE - 1 );
+		_uNbRealVoices = Math::Min( _uNbRealVoices, _uNbVoices );
+
+		m_oVoices.resize( _uNbVoices );
+		m_oFreeVoices.reserve( _uNbVoices );
+		m_oActiveVoices.reserve( _uNbVoices );
+		m_oFreeRealVoices.reserve( _uNbRealVoices );
+		m_oRealVoiceOwners.resize( _uNbRealVoices, NO_REAL_VOICE );
+		m_aHeaps[ eActiveHeap ].reserve( _uNbVoices );
+		m_aHeaps[ eRealHeap ].reserve( _uNbRealVoices );
+		m_aHeaps[ eVirtualHeap ].reserve( _uNbVoices );
+
+		//Pushed in reverse order so the first indices are used first.
+		for( uint16_t uVoice = _uNbVoices; uVoice > 0; --uVoice )
+			m_oFreeVoices.push_back( uVoice - 1 );
+
+		for( uint16_t uRealVoice = _uNbRealVoices; uRealVoice > 0; --uRealVoice )
+			m_oFreeRealVoices.push_back( uRealVoice - 1 );
+
+		for( uint8_t uBus = 0; uBus < MaxBuses; ++uBus )
+		{
+			m_aBusGains[ uBus ] = 1.f;
+			m_aNbActiveVoices[ uBus ] = 0;
+		}
+	}
+
+	VoiceManager::~VoiceManager()
+	{
+		StopAll();
+		CheckNullptrDelete( m_pBackend );
+	}
+
+	void VoiceManager::Update( float _fDeltaTime )
+	{
+		//Going backward as releasing a voice moves the last active voice at its place.
+		for( size_t iActive = m_oActiveVoices.size(); iActive > 0; --iActive )
+		{
+			const uint16_t uIndex = m_oActiveVoices[ iActive - 1 ];
+			Voice& oVoice = m_oVoices[ uIndex ];
+
+			if( oVoice.m_eState != VoiceState::ePlaying )
+				continue;
+
+			oVoice.m_fPosition += _fDeltaTime;
+
+			if( oVoice.m_fPosition >= oVoice.m_fDuration )
+			{
+				if( oVoice.m_bLoop == false || oVoice.m_fDuration <= 0.f )
+				{
+					_Release( uIndex );
+					continue;
+				}
+
+				oVoice.m_fPosition = std::fmod( oVoice.m_fPosition, oVoice.m_fDuration );
+			}
+
+			if( oVoice.m_uRealVoice != NO_REAL_VOICE && m_pBackend->IsFinished( oVoice.m_uRealVoice ) )
+				_Release( uIndex );
+		}
+
+		_PromoteVirtualVoices();
+	}
+
+	VoiceHandle VoiceManager::Play( const sf::SoundBuffer& _oBuffer, const PlayDesc& _oDesc )
+	{
+		if( m_oFreeVoices.empty() )
+		{
+			const uint16_t uLowestVoice = _GetHeapTop( eActiveHeap );
+
+			if( uLowestVoice == NOT_IN_HEAP || m_oVoices[ uLowestVoice ].m_iPriority >= _oDesc.m_iPriority )
+				return INVALID_VOICE;
+
+			_Release( uLowestVoice );
+		}
+
+		const uint16_t uIndex = m_oFreeVoices.back();
+		m_oFreeVoices.pop_back();
+
+		Voice& oVoice = m_oVoices[ uIndex ];
+		oVoice.m_pBuffer		= &_oBuffer;
+		oVoice.m_uSound			= _oDesc.m_uSound;
+		oVoice.m_iPriority		= _oDesc.m_iPriority;
+		oVoice.m_iNbInstances	= 1;
+		oVoice.m_fVolume		= _oDesc.m_fVolume;
+		oVoice.m_fPosition		= 0.f;
+		oVoice.m_fDuration		= _oBuffer.getDuration().asSeconds();
+		oVoice.m_uBus			= _oDesc.m_uBus < MaxBuses ? _oDesc.m_uBus : 0;
+		oVoice.m_bLoop			= _oDesc.m_bLoop;
+		oVoice.m_eState			= VoiceState::ePlaying;
+		oVoice.m_uRealVoice		= NO_REAL_VOICE;
+		oVoice.m_uActiveIndex	= (uint16_t)m_oActiveVoices.size();
+
+		m_oActiveVoices.push_back( uIndex );
+		++m_aNbActiveVoices[ oVoice.m_uBus ];
+		_PushInHeap( eActiveHeap, uIndex );
+
+		if( _AcquireRealVoice( uIndex ) == false )
+			_PushInHeap( eVirtualHeap, uIndex );
+
+		return _GetHandle( uIndex );
+	}
+
+	void VoiceManager::Stop( VoiceHandle _uVoice )
+	{
+		if( _GetVoice( _uVoice ) != nullptr )
+			_Release( (uint16_t)( _uVoice & 0xFFFF ) );
+	}
+
+	void VoiceManager::Pause( VoiceHandle _uVoice )
+	{
+		Voice* pVoice = _GetVoice( _uVoice );
+
+		if( pVoice == nullptr || pVoice->m_eState != VoiceState::ePlaying )
+			return;
+
+		pVoice->m_eState = VoiceState::ePaused;
+
+		if( pVoice->m_uRealVoice != NO_REAL_VOICE )
+			m_pBackend->Pause( pVoice->m_uRealVoice );
+		else
+			_RemoveFromHeap( eVirtualHeap, (uint16_t)( _uVoice & 0xFFFF ) );
+	}
+
+	void VoiceManager::Resume( VoiceHandle _uVoice )
+	{
+		Voice* pVoice = _GetVoice( _uVoice );
+
+		if( pVoice == nullptr || pVoice->m_eState != VoiceState::ePaused )
+			return;
+
+		pVoice->m_eState = VoiceState::ePlaying;
+
+		if( pVoice->m_uRealVoice != NO_REAL_VOICE )
+			m_pBackend->Resume( pVoice->m_uRealVoice );
+		else
+			_PushInHeap( eVirtualHeap, (uint16_t)( _uVoice & 0xFFFF ) );
+	}
+
+	void VoiceManager::SetVolume( VoiceHandle _uVoice, float _fVolume )
+	{
+		Voice* pVoice = _GetVoice( _uVoice );
+
+		if( pVoice == nullptr )
+			return;
+
+		pVoice->m_fVolume = _fVolume;
+
+		if( pVoice->m_uRealVoice != NO_REAL_VOICE )
+			m_pBackend->SetVolume( pVoice->m_uRealVoice, _GetOutputVolume( *pVoice ) );
+	}
+
+	void VoiceManager::AddInstance( VoiceHandle _uVoice )
+	{
+		Voice* pVoice = _GetVoice( _uVoice );
+
+		if( pVoice != nullptr )
+			++pVoice->m_iNbInstances;
+	}
+
+	void VoiceManager::RemoveInstance( VoiceHandle _uVoice )
+	{
+		Voice* pVoice = _GetVoice( _uVoice );
+
+		if( pVoice != nullptr && --pVoice->m_iNbInstances <= 0 )
+			_Release( (uint16_t)( _uVoice & 0xFFFF ) );
+	}
+
+	void VoiceManager::StopAll()
+	{
+		while( m_oActiveVoices.empty() == false )
+			_Release( m_oActiveVoices.back() );
+	}
+
+	void VoiceManager::StopBuffer( const sf::SoundBuffer* _pBuffer )
+	{
+		for( size_t iActive = m_oActiveVoices.size(); iActive > 0; --iActive )
+		{
+			const uint16_t uIndex = m_oActiveVoices[ iActive - 1 ];
+
+			if( m_oVoices[ uIndex ].m_pBuffer == _pBuffer )
+				_Release( uIndex );
+		}
+	}
+
+	void VoiceManager::RefreshBuffer( const sf::SoundBuffer* _pBuffer )
+	{
+		if( _pBuffer == nullptr )
+			return;
+
+		const float fDuration = _pBuffer->getDuration().asSeconds();
+
+		for( size_t iActive = m_oActiveVoices.size(); iActive > 0; --iActive )
+		{
+			const uint16_t uIndex = m_oActiveVoices[ iActive - 1 ];
+			Voice& oVoice = m_oVoices[ uIndex ];
+
+			if( oVoice.m_pBuffer != _pBuffer )
+				continue;
+
+			oVoice.m_fDuration = fDuration;
+
+			if( oVoice.m_fPosition >= fDuration )
+			{
+				if( oVoice.m_bLoop == false || fDuration <= 0.f )
+				{
+					_Release( uIndex );
+					continue;
+				}
+
+				oVoice.m_fPosition = std::fmod( oVoice.m_fPosition, fDuration );
+			}
+
+			//Loading a buffer stops the sounds using it.
+			if( oVoice.m_uRealVoice != NO_REAL_VOICE )
+			{
+				m_pBackend->Play( oVoice.m_uRealVoice, *oVoice.m_pBuffer, oVoice.m_bLoop, _GetOutputVolume( oVoice ), oVoice.m_fPosition );
+
+				if( oVoice.m_eState == VoiceState::ePaused )
+					m_pBackend->Pause( oVoice.m_uRealVoice );
+			}
+		}
+	}
+
+	void VoiceManager::PauseAll()
+	{
+		for( uint16_t uIndex : m_oActiveVoices )
+			Pause( _GetHandle( uIndex ) );
+	}
+
+	void VoiceManager::ResumeAll()
+	{
+		for( uint16_t uIndex : m_oActiveVoices )
+			Resume( _GetHandle( uIndex ) );
+	}
+
+	void VoiceManager::SetBusGains( const float* _pGains, uint8_t _uNbBuses )
+	{
+		bool aChangedBuses[ MaxBuses ] = { false };
+		bool bChanged = false;
+
+		for( uint8_t uBus = 0; uBus < Math::Min( _uNbBuses, MaxBuses ); ++uBus )
+		{
+			if( m_aBusGains[ uBus ] != _pGains[ uBus ] )
+			{
+				m_aBusGains[ uBus ] = _pGains[ uBus ];
+				aChangedBuses[ uBus ] = true;
+				bChanged = true;
+			}
+		}
+
+		if( bChanged == false )
+			return;
+
+		for( uint16_t uRealVoice = 0; uRealVoice < m_oRealVoiceOwners.size(); ++uRealVoice )
+		{
+			if( m_oRealVoiceOwners[ uRealVoice ] == NO_REAL_VOICE )
+				continue;
+
+			const Voice& oVoice = m_oVoices[ m_oRealVoiceOwners[ uRealVoice ] ];
+
+			if( aChangedBuses[ oVoice.m_uBus ] )
+				m_pBackend->SetVolume( uRealVoice, _GetOutputVolume( oVoice ) );
+		}
+	}
+
+	bool VoiceManager::IsValid( VoiceHandle _uVoice ) const
+	{
+		return _GetVoice( _uVoice ) != nullptr;
+	}
+
+	bool VoiceManager::IsVirtual( VoiceHandle _uVoice ) const
+	{
+		const Voice* pVoice = _GetVoice( _uVoice );
+
+		return pVoice != nullptr && pVoice->m_uRealVoice == NO_REAL_VOICE;
+	}
+
+	VoiceHandle VoiceManager::FindVoice( uint32_t _uSound ) const
+	{
+		for( uint16_t uIndex : m_oActiveVoices )
+		{
+			if( m_oVoices[ uIndex ].m_uSound == _uSound )
+				return _GetHandle( uIndex );
+		}
+
+		return INVALID_VOICE;
+	}
+
+	uint16_t VoiceManager::GetNbVoices() const
+	{
+		return (uint16_t)m_oVoices.size();
+	}
+
+	uint16_t VoiceManager::GetNbActiveVoices() const
+	{
+		return (uint16_t)m_oActiveVoices.size();
+	}
+
+	uint16_t VoiceManager::GetNbActiveVoices( uint8_t _uBus ) const
+	{
+		return _uBus < MaxBuses ? m_aNbActiveVoices[ _uBus ] : 0;
+	}
+
+	uint16_t VoiceManager::GetNbRealVoices() const
+	{
+		return (uint16_t)m_oRealVoiceOwners.size();
+	}
+
+	uint16_t VoiceManager::GetNbUsedRealVoices() const
+	{
+		return (uint16_t)( m_oRealVoiceOwners.size() - m_oFreeRealVoices.size() );
+	}
+
+	VoiceBackend* VoiceManager::GetBackend() const
+	{
+		return m_pBackend;
+	}
+
+	VoiceManager::Voice* VoiceManager::_GetVoice( VoiceHandle _uVoice )
+	{
+		return const_cast< Voice* >( static_cast< const VoiceManager* >( this )->_GetVoice( _uVoice ) );
+	}
+
+	const VoiceManager::Voice* VoiceManager::_GetVoice( VoiceHandle _uVoice ) const
+	{
+		const uint16_t uIndex = (uint16_t)( _uVoice & 0xFFFF );
+		const uint16_t uGeneration = (uint16_t)( _uVoice >> 16 );
+
+		if( _uVoice == INVALID_VOICE || uIndex >= m_oVoices.size() )
+			return nullptr;
+
+		const Voice& oVoice = m_oVoices[ uIndex ];
+
+		if( oVoice.m_eState == VoiceState::eFree || oVoice.m_uGeneration != uGeneration )
+			return nullptr;
+
+		return &oVoice;
+	}
+
+	VoiceHandle VoiceManager::_GetHandle( uint16_t _uIndex ) const
+	{
+		return ( (VoiceHandle)m_oVoices[ _uIndex ].m_uGeneration << 16 ) | _uIndex;
+	}
+
+	float VoiceManager::_GetOutputVolume( const Voice& _oVoice ) const
+	{
+		return _oVoice.m_fVolume * m_aBusGains[ _oVoice.m_uBus ];
+	}
+
+	void VoiceManager::_Release( uint16_t _uIndex )
+	{
+		Voice& oVoice = m_oVoices[ _uIndex ];
+
+		if( oVoice.m_uRealVoice != NO_REAL_VOICE )
+		{
+			m_pBackend->Stop( oVoice.m_uRealVoice );
+			m_oRealVoiceOwners[ oVoice.m_uRealVoice ] = NO_REAL_VOICE;
+			m_oFreeRealVoices.push_back( oVoice.m_uRealVoice );
+			oVoice.m_uRealVoice = NO_REAL_VOICE;
+			_RemoveFromHeap( eRealHeap, _uIndex );
+		}
+		else
+			_RemoveFromHeap( eVirtualHeap, _uIndex );
+
+		_RemoveFromHeap( eActiveHeap, _uIndex );
+
+		//Swap-remove from the active voices.
+		const uint16_t uLastIndex = m_oActiveVoices.back();
+		m_oActiveVoices[ oVoice.m_uActiveIndex ] = uLastIndex;
+		m_oVoices[ uLastIndex ].m_uActiveIndex = oVoice.m_uActiveIndex;
+		m_oActiveVoices.pop_back();
+		--m_aNbActiveVoices[ oVoice.m_uBus ];
+
+		oVoice.m_pBuffer = nullptr;
+		oVoice.m_eState = VoiceState::eFree;
+
+		//Generation 0 would allow the handle of the first voice to be INVALID_VOICE.
+		if( ++oVoice.m_uGeneration == 0 )
+			oVoice.m_uGeneration = 1;
+
+		m_oFreeVoices.push_back( _uIndex );
+	}
+
+	bool VoiceManager::_AcquireRealVoice( uint16_t _uIndex )
+	{
+		if( m_oFreeRealVoices.empty() == false )
+		{
+			const uint16_t uRealVoice = m_oFreeRealVoices.back();
+			m_oFreeRealVoices.pop_back();
+
+			_BindRealVoice( _uIndex, uRealVoice );
+			return true;
+		}
+
+		//Stealing the real voice of lowest priority, its voice becomes virtual.
+		const uint16_t uStolenIndex = _GetHeapTop( eRealHeap );
+
+		if( uStolenIndex == NOT_IN_HEAP )
+			return false;
+
+		Voice& oStolenVoice = m_oVoices[ uStolenIndex ];
+
+		if( oStolenVoice.m_iPriority >= m_oVoices[ _uIndex ].m_iPriority )
+			return false;
+
+		const uint16_t uRealVoice = oStolenVoice.m_uRealVoice;
+
+		m_pBackend->Stop( uRealVoice );
+		oStolenVoice.m_uRealVoice = NO_REAL_VOICE;
+		_RemoveFromHeap( eRealHeap, uStolenIndex );
+
+		if( oStolenVoice.m_eState == VoiceState::ePlaying )
+			_PushInHeap( eVirtualHeap, uStolenIndex );
+
+		_BindRealVoice( _uIndex, uRealVoice );
+		return true;
+	}
+
+	void VoiceManager::_BindRealVoice( uint16_t _uIndex, uint16_t _uRealVoice )
+	{
+		Voice& oVoice = m_oVoices[ _uIndex ];
+
+		oVoice.m_uRealVoice = _uRealVoice;
+		m_oRealVoiceOwners[ _uRealVoice ] = _uIndex;
+
+		_RemoveFromHeap( eVirtualHeap, _uIndex );
+		_PushInHeap( eRealHeap, _uIndex );
+
+		m_pBackend->Play( _uRealVoice, *oVoice.m_pBuffer, oVoice.m_bLoop, _GetOutputVolume( oVoice ), oVoice.m_fPosition );
+
+		if( oVoice.m_eState == VoiceState::ePaused )
+			m_pBackend->Pause( _uRealVoice );
+	}
+
+	void VoiceManager::_PromoteVirtualVoices()
+	{
+		while( m_oFreeRealVoices.empty() == false && m_aHeaps[ eVirtualHeap ].empty() == false )
+			_AcquireRealVoice( _GetHeapTop( eVirtualHeap ) );
+	}
+
+
+	/////////////////PRIORITY HEAPS/////////////////
+
+	bool VoiceManager::_IsInHeap( HeapType _eHeap, uint16_t _uIndex ) const
+	{
+		return m_oVoices[ _uIndex ].m_aHeapPositions[ _eHeap ] != NOT_IN_HEAP;
+	}
+
+	uint16_t VoiceManager::_GetHeapTop( HeapType _eHeap ) const
+	{
+		return m_aHeaps[ _eHeap ].empty() ? NOT_IN_HEAP : m_aHeaps[ _eHeap ].front();
+	}
+
+	void VoiceManager::_PushInHeap( HeapType _eHeap, uint16_t _uIndex )
+	{
+		if( _IsInHeap( _eHeap, _uIndex ) )
+			return;
+
+		std::vector< uint16_t >& oHeap = m_aHeaps[ _eHeap ];
+
+		oHeap.push_back( _uIndex );
+		m_oVoices[ _uIndex ].m_aHeapPositions[ _eHeap ] = (uint16_t)( oHeap.size() - 1 );
+
+		_SiftUp( _eHeap, (uint16_t)( oHeap.size() - 1 ) );
+	}
+
+	void VoiceManager::_RemoveFromHeap( HeapType _eHeap, uint16_t _uIndex )
+	{
+		if( _IsInHeap( _eHeap, _uIndex ) == false )
+			return;
+
+		std::vector< uint16_t >& oHeap = m_aHeaps[ _eHeap ];
+		const uint16_t uPosition = m_oVoices[ _uIndex ].m_aHeapPositions[ _eHeap ];
+		const uint16_t uLastIndex = oHeap.back();
+
+		oHeap.pop_back();
+		m_oVoices[ _uIndex ].m_aHeapPositions[ _eHeap ] = NOT_IN_HEAP;
+
+		if( uLastIndex == _uIndex )
+			return;
+
+		//The last voice takes the freed position and moves up or down from there.
+		_SetHeapPosition( _eHeap, uPosition, uLastIndex );
+		_SiftUp( _eHeap, uPosition );
+		_SiftDown( _eHeap, m_oVoices[ uLastIndex ].m_aHeapPositions[ _eHeap ] );
+	}
+
+	bool VoiceManager::_IsHigherInHeap( HeapType _eHeap, uint16_t _uIndexA, uint16_t _uIndexB ) const
+	{
+		if( _eHeap == eVirtualHeap )
+			return m_oVoices[ _uIndexA ].m_iPriority > m_oVoices[ _uIndexB ].m_iPriority;
+
+		return m_oVoices[ _uIndexA ].m_iPriority < m_oVoices[ _uIndexB ].m_iPriority;
+	}
+
+	void VoiceManager::_SetHeapPosition( HeapType _eHeap, uint16_t _uPosition, uint16_t _uIndex )
+	{
+		m_aHeaps[ _eHeap ][ _uPosition ] = _uIndex;
+		m_oVoices[ _uIndex ].m_aHeapPositions[ _eHeap ] = _uPosition;
+	}
+
+	void VoiceManager::_SiftUp( HeapType _eHeap, uint16_t _uPosition )
+	{
+		std::vector< uint16_t >& oHeap = m_aHeaps[ _eHeap ];
+		const uint16_t uIndex = oHeap[ _uPosition ];
+
+		while( _uPosition > 0 )
+		{
+			const uint16_t uParent = ( _uPosition - 1 ) / 2;
+
+			if( _IsHigherInHeap( _eHeap, uIndex, oHeap[ uParent ] ) == false )
+				break;
+
+			_SetHeapPosition( _eHeap, _uPosition, oHeap[ uParent ] );
+			_uPosition = uParent;
+		}
+
+		_SetHeapPosition( _eHeap, _uPosition, uIndex );
+	}
+
+	void VoiceManager::_SiftDown( HeapType _eHeap, uint16_t _uPosition )
+	{
+		std::vector< uint16_t >& oHeap = m_aHeaps[ _eHeap ];
+		const size_t uSize = oHeap.size();
+		const uint16_t uIndex = oHeap[ _uPosition ];
+
+		while( true )
+		{
+			size_t uChild = 2 * (size_t)_uPosition + 1;
+
+			if( uChild >= uSize )
+				break;
+
+			if( uChild + 1 < uSize && _IsHigherInHeap( _eHeap, oHeap[ uChild + 1 ], oHeap[ uChild ] ) )
+				++uChild;
+
+			if( _IsHigherInHeap( _eHeap, oHeap[ uChild ], uIndex ) == false )
+				break;
+
+			_SetHeapPosition( _eHeap, _uPosition, oHeap[ uChild ] );
+			_uPosition = (uint16_t)uChild;
+		}
+
+		_SetHeapPosition( _eHeap, _uPosition, uIndex );
+	}
+} //namespace fzn
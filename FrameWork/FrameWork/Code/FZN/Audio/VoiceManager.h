@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Fixed pool of voices with priorities, voice stealing and virtual voices
+//------------------------------------------------------------------------
+
+#ifndef _VOICEMANAGER_H_
+#define _VOICEMANAGER_H_
+
+#include <vector>
+
+#include "FZN/Defines.h"
+
+
+namespace sf
+{
+	class Sound;
+	class SoundBuffer;
+}
+
+namespace fzn
+{
+	typedef uint32_t VoiceHandle;						//Index of the voice in the low 16 bits, generation of the voice in the high 16 bits
+	static constexpr VoiceHandle INVALID_VOICE{ 0 };
+
+	typedef uint32_t SoundHandle;						//Sound resolved by the AudioManager (see AudioManager::GetSoundHandle)
+	static constexpr SoundHandle INVALID_SOUND{ Uint32_Max };
+
+
+	//=========================================================
+	//=======================VoiceBackend=======================
+	//=========================================================
+
+	//Plays the real voices, the VoiceManager decides which voices are real and which ones are virtual.
+	class FZN_EXPORT VoiceBackend
+	{
+	public:
+		virtual ~VoiceBackend() {}
+
+		virtual void	Play( uint16_t _uRealVoice, const sf::SoundBuffer& _oBuffer, bool _bLoop, float _fVolume, float _fOffset ) = 0;
+		virtual void	Stop( uint16_t _uRealVoice ) = 0;
+		virtual void	Pause( uint16_t _uRealVoice ) = 0;
+		virtual void	Resume( uint16_t _uRealVoice ) = 0;
+		virtual void	SetVolume( uint16_t _uRealVoice, float _fVolume ) = 0;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Tells if a real voice stopped by itself (end of the buffer or device error)
+		//Parameter : Index of the real voice
+		//Return value : The voice is finished (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		virtual bool	IsFinished( uint16_t _uRealVoice ) const = 0;
+	};
+
+	//Plays the real voices with SFML sounds.
+	class FZN_EXPORT SfmlVoiceBackend : public VoiceBackend
+	{
+	public:
+		SfmlVoiceBackend( uint16_t _uNbRealVoices );
+		~SfmlVoiceBackend();
+
+		virtual void	Play( uint16_t _uRealVoice, const sf::SoundBuffer& _oBuffer, bool _bLoop, float _fVolume, float _fOffset ) override;
+		virtual void	Stop( uint16_t _uRealVoice ) override;
+		virtual void	Pause( uint16_t _uRealVoice ) override;
+		virtual void	Resume( uint16_t _uRealVoice ) override;
+		virtual void	SetVolume( uint16_t _uRealVoice, float _fVolume ) override;
+		virtual bool	IsFinished( uint16_t _uRealVoice ) const override;
+
+	private:
+		std::vector< sf::Sound* >	m_oSounds;
+	};
+
+	//Doesn't output anything, the voices only end when the VoiceManager reaches the end of their buffer.
+	//Used to run the audio logic without any device (tools, servers, benchmarks...).
+	class FZN_EXPORT NullVoiceBackend : public VoiceBackend
+	{
+	public:
+		virtual void	Play( uint16_t /*_uRealVoice*/, const sf::SoundBuffer& /*_oBuffer*/, bool /*_bLoop*/, float /*_fVolume*/, float /*_fOffset*/ ) override {}
+		virtual void	Stop( uint16_t /*_uRealVoice*/ ) override {}
+		virtual void	Pause( uint16_t /*_uRealVoice*/ ) override {}
+		virtual void	Resume( uint16_t /*_uRealVoice*/ ) override {}
+		virtual void	SetVolume( uint16_t /*_uRealVoice*/, float /*_fVolume*/ ) override {}
+		virtual bool	IsFinished( uint16_t /*_uRealVoice*/ ) const override { return false; }
+	};
+
+	//Mixes the real voices in a buffer instead of a device, on demand.
+	//Used to check the output of the mixer or to measure the mixing throughput without any device.
+	class FZN_EXPORT OfflineVoiceBackend : public VoiceBackend
+	{
+	public:
+		OfflineVoiceBackend( uint16_t _uNbRealVoices, uint32_t _uSampleRate = 44100 );
+
+		virtual void	Play( uint16_t _uRealVoice, const sf::SoundBuffer& _oBuffer, bool _bLoop, float _fVolume, float _fOffset ) override;
+		virtual void	Stop( uint16_t _uRealVoice ) override;
+		virtual void	Pause( uint16_t _uRealVoice ) override;
+		virtual void	Resume( uint16_t _uRealVoice ) override;
+		virtual void	SetVolume( uint16_t _uRealVoice, float _fVolume ) override;
+		virtual bool	IsFinished( uint16_t _uRealVoice ) const override;
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mixes the playing voices and advances them
+		//Parameter 1 : Interleaved stereo output, 2 * _uNbFrames samples between -1 and 1 (not clipped)
+		//Parameter 2 : Number of frames to render
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void			Render( float* _pOutput, uint32_t _uNbFrames );
+		uint32_t		GetSampleRate() const;
+
+	private:
+		struct RealVoice
+		{
+			const sf::SoundBuffer*	m_pBuffer{ nullptr };
+			double					m_dPosition{ 0. };			//Position in the buffer (frames of the buffer)
+			float					m_fVolume{ 100.f };
+			bool					m_bLoop{ false };
+			bool					m_bPlaying{ false };
+			bool					m_bPaused{ false };
+		};
+
+		std::vector< RealVoice >	m_oVoices;
+		uint32_t					m_uSampleRate{ 44100 };
+	};
+
+
+	//=========================================================
+	//=======================VoiceManager=======================
+	//=========================================================
+
+	//All the voices are allocated at construction, playing, stopping and accessing a voice don't allocate anything.
+	//Only a limited number of voices are real (played by the backend), the other ones are virtual: they keep track of their position and take a real voice back when one is available.
+	//When the pool is full, the voice of lowest priority is stolen if the new one has a higher priority, otherwise the new one is refused.
+	//The active, real and virtual voices are kept in priority heaps, so finding the voice to steal or to promote is done in constant time and updating them in logarithmic time.
+	class FZN_EXPORT VoiceManager
+	{
+	public:
+		struct PlayDesc
+		{
+			uint32_t	m_uSound{ 0 };						//Identifier of the played sound (SoundHandle for the AudioManager), used by FindVoice
+			int			m_iPriority{ DefaultPriority };		//The higher, the more important
+			float		m_fVolume{ 100.f };
+			uint8_t		m_uBus{ 0 };						//The volume of the voice is multiplied by the gain of its bus (see SetBusGains)
+			bool		m_bLoop{ false };
+		};
+
+		static constexpr int		DefaultPriority{ 128 };
+		static constexpr uint8_t	MaxBuses{ 8 };
+		static constexpr uint16_t	DefaultNbVoices{ 256 };
+		static constexpr uint16_t	DefaultNbRealVoices{ 64 };
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Constructor
+		//Parameter 1 : Backend playing the real voices, deleted by the manager
+		//Parameter 2 : Number of real voices
+		//Parameter 3 : Total number of voices (real and virtual)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		VoiceManager( VoiceBackend* _pBackend, uint16_t _uNbRealVoices = DefaultNbRealVoices, uint16_t _uNbVoices = DefaultNbVoices );
+		~VoiceManager();
+
+		VoiceManager( const VoiceManager& ) = delete;
+		VoiceManager& operator=( const VoiceManager& ) = delete;
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Advances the voices, releases the finished ones and gives the free real voices to the virtual voices of highest priority
+		//Parameter : Elapsed time since the last update (s)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						Update( float _fDeltaTime );
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Starts a voice
+		//Parameter 1 : Buffer to play, it has to stay valid until the voice ends
+		//Parameter 2 : Parameters of the voice
+		//Return value : Handle on the voice, INVALID_VOICE if the pool is full of voices of higher priority
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		VoiceHandle					Play( const sf::SoundBuffer& _oBuffer, const PlayDesc& _oDesc );
+		void						Stop( VoiceHandle _uVoice );
+		void						Pause( VoiceHandle _uVoice );
+		void						Resume( VoiceHandle _uVoice );
+		void						SetVolume( VoiceHandle _uVoice, float _fVolume );
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds or removes an instance to a voice shared by several requests (looping sounds played only once for example)
+		//Removing the last instance stops the voice
+		//Parameter : Handle on the voice
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						AddInstance( VoiceHandle _uVoice );
+		void						RemoveInstance( VoiceHandle _uVoice );
+
+		void						StopAll();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Stops the voices playing a buffer, has to be called before the buffer is destroyed
+		//Parameter : Buffer about to be destroyed
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						StopBuffer( const sf::SoundBuffer* _pBuffer );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Refreshes the duration of the voices playing a buffer that has been loaded again, and restarts their real voices where they were
+		//Parameter : Reloaded buffer
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						RefreshBuffer( const sf::SoundBuffer* _pBuffer );
+		void						PauseAll();
+		void						ResumeAll();
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Sets the gains of the buses and refreshes the volume of the real voices whose bus changed, meant to be called once per frame
+		//Parameter 1 : Gains of the buses
+		//Parameter 2 : Number of gains (MaxBuses at most)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						SetBusGains( const float* _pGains, uint8_t _uNbBuses );
+
+		bool						IsValid( VoiceHandle _uVoice ) const;
+		bool						IsVirtual( VoiceHandle _uVoice ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for an active voice playing the given sound
+		//Parameter : Identifier of the sound (PlayDesc::m_uSound)
+		//Return value : Handle on the voice, INVALID_VOICE if there is none
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		VoiceHandle					FindVoice( uint32_t _uSound ) const;
+
+		uint16_t					GetNbVoices() const;
+		uint16_t					GetNbActiveVoices() const;
+		uint16_t					GetNbActiveVoices( uint8_t _uBus ) const;
+		uint16_t					GetNbRealVoices() const;
+		uint16_t					GetNbUsedRealVoices() const;
+		VoiceBackend*				GetBackend() const;
+
+	private:
+		static constexpr uint16_t	NO_REAL_VOICE{ 0xFFFF };
+
+		enum class VoiceState : uint8_t
+		{
+			eFree,
+			ePlaying,
+			ePaused,
+		};
+
+		enum HeapType : uint8_t
+		{
+			eActiveHeap,										//All the active voices, lowest priority on top (stolen when the pool is full)
+			eRealHeap,											//Voices bound to a real voice, lowest priority on top (stolen by a voice of higher priority)
+			eVirtualHeap,										//Playing virtual voices, highest priority on top (promoted when a real voice is released)
+			eHeapCount,
+		};
+
+		static constexpr uint16_t	NOT_IN_HEAP{ 0xFFFF };
+
+		struct Voice
+		{
+			const sf::SoundBuffer*	m_pBuffer{ nullptr };
+			uint32_t				m_uSound{ 0 };
+			int						m_iPriority{ DefaultPriority };
+			int						m_iNbInstances{ 0 };
+			float					m_fVolume{ 100.f };
+			float					m_fPosition{ 0.f };			//Current position in the buffer (s), tracked even when the voice is virtual
+			float					m_fDuration{ 0.f };
+			uint8_t					m_uBus{ 0 };
+			bool					m_bLoop{ false };
+			VoiceState				m_eState{ VoiceState::eFree };
+			uint16_t				m_uGeneration{ 1 };
+			uint16_t				m_uRealVoice{ NO_REAL_VOICE };
+			uint16_t				m_uActiveIndex{ 0 };		//Index in m_oActiveVoices
+			uint16_t				m_aHeapPositions[ eHeapCount ]{ NOT_IN_HEAP, NOT_IN_HEAP, NOT_IN_HEAP };
+		};
+
+		Voice*						_GetVoice( VoiceHandle _uVoice );
+		const Voice*				_GetVoice( VoiceHandle _uVoice ) const;
+		VoiceHandle					_GetHandle( uint16_t _uIndex ) const;
+		float						_GetOutputVolume( const Voice& _oVoice ) const;
+
+		void						_Release( uint16_t _uIndex );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Gives a real voice to a voice, stealing the one of lowest priority if there is no free one
+		//Parameter : Index of the voice
+		//Return value : The voice is real (true) or stays virtual
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool						_AcquireRealVoice( uint16_t _uIndex );
+		void						_BindRealVoice( uint16_t _uIndex, uint16_t _uRealVoice );
+		void						_PromoteVirtualVoices();
+
+		/////////////////PRIORITY HEAPS/////////////////
+
+		bool						_IsInHeap( HeapType _eHeap, uint16_t _uIndex ) const;
+		uint16_t					_GetHeapTop( HeapType _eHeap ) const;
+		void						_PushInHeap( HeapType _eHeap, uint16_t _uIndex );
+		void						_RemoveFromHeap( HeapType _eHeap, uint16_t _uIndex );
+		bool						_IsHigherInHeap( HeapType _eHeap, uint16_t _uIndexA, uint16_t _uIndexB ) const;
+		void						_SetHeapPosition( HeapType _eHeap, uint16_t _uPosition, uint16_t _uIndex );
+		void						_SiftUp( HeapType _eHeap, uint16_t _uPosition );
+		void						_SiftDown( HeapType _eHeap, uint16_t _uPosition );
+
+		VoiceBackend*				m_pBackend{ nullptr };
+
+		std::vector< Voice >		m_oVoices;
+		std::vector< uint16_t >		m_oFreeVoices;				//Stack of the free voices
+		std::vector< uint16_t >		m_oActiveVoices;			//Dense array of the playing and paused voices
+		std::vector< uint16_t >		m_oFreeRealVoices;			//Stack of the free real voices
+		std::vector< uint16_t >		m_oRealVoiceOwners;			//Voice bound to each real voice
+		std::vector< uint16_t >		m_aHeaps[ eHeapCount ];		//Binary heaps of voice indices, see HeapType
+
+		float						m_aBusGains[ MaxBuses ];
+		uint16_t					m_aNbActiveVoices[ MaxBuses ];
+	};
+} //namespace fzn
+
+#endif //_VOICEMANAGER_H_
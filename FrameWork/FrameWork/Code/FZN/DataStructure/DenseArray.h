@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Contiguous array with constant time removal and stable handles
+//------------------------------------------------------------------------
+
+#ifndef _DENSEARRAY_H_
+#define _DENSEARRAY_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace fzn
+{
+	//The elements are stored next to each other, so iterating on them only reads contiguous memory.
+	//A removal moves the last element in the removed one's place, so the indices of the elements can change but their handles stay valid until they are removed.
+	template <class USER_TYPE> class DenseArray
+	{
+	public:
+		//Identifies an element independently of its index in the array
+		struct Handle
+		{
+			bool IsValid() const { return m_uSlot != UINT32_MAX; }
+
+			uint32_t m_uSlot{ UINT32_MAX };
+			uint32_t m_uGeneration{ 0 };
+		};
+
+		/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Default parametered constructor
+		//Parameter : Number of elements to reserve memory for
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		DenseArray( int _iInitialSize = DefaultSize );
+
+
+		/////////////////OTHER FUNCTIONS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds an element at the end of the array
+		//Parameter : Element to add
+		//Return value : Index of the element
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int PushBack( const USER_TYPE& _element );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes the last element of the array
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void PopBack();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes an element from the array, the last element takes its place
+		//Parameter : Index of the element to remove
+		//Return value : The element has been removed (true) or the index is out of range
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool Remove( int _index );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes an element from the array, the last element takes its place
+		//Parameter : Handle of the element to remove
+		//Return value : The element has been removed (true) or the handle isn't valid anymore
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool Remove( Handle _handle );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Finds the first element equal to the given one
+		//Parameter : Element to look for
+		//Return value : Element (nullptr if not found)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		USER_TYPE* FindElement( const USER_TYPE& _element );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Finds the index of the first element equal to the given one
+		//Parameter : Element to look for
+		//Return value : Index (-1 if not found)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int FindIndex( const USER_TYPE& _element ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes all the elements, their handles become invalid
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Clear();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Allocates the memory for a given number of elements
+		//Parameter : Number of elements
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Reserve( int _iSize );
+
+
+		/////////////////OPERATORS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Access operator, the index has to be in range (asserted)
+		//Parameter : Index to reach in the array
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		USER_TYPE& operator[]( int _index );
+		const USER_TYPE& operator[]( int _index ) const;
+
+
+		/////////////////ACCESSOR / MUTATOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the handle of an element
+		//Parameter : Index of the element
+		//Return value : Handle of the element (invalid if the index is out of range)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		Handle GetHandle( int _index ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the current index of an element
+		//Parameter : Handle of the element
+		//Return value : Index of the element (-1 if it has been removed)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int GetIndex( Handle _handle ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on an element
+		//Parameter : Handle of the element
+		//Return value : Element (nullptr if it has been removed)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		USER_TYPE* Get( Handle _handle );
+
+		USER_TYPE& Front() { return m_oElements.front(); }
+		USER_TYPE& Back() { return m_oElements.back(); }
+		USER_TYPE* begin() { return m_oElements.data(); }
+		USER_TYPE* end() { return m_oElements.data() + m_oElements.size(); }
+		const USER_TYPE* begin() const { return m_oElements.data(); }
+		const USER_TYPE* end() const { return m_oElements.data() + m_oElements.size(); }
+
+		int Size() const { return (int)m_oElements.size(); }
+		bool Empty() const { return m_oElements.empty(); }
+
+		static constexpr int DefaultSize{ 20 };
+
+	private:
+		struct Slot
+		{
+			uint32_t m_uIndex{ 0 };				//Index of the element, or next free slot if this one is free
+			uint32_t m_uGeneration{ 0 };		//Incremented each time the slot is freed, invalidating the handles using it
+		};
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Gives the slot of a removed element to the next added one
+		//Parameter : Slot to free
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _FreeSlot( uint32_t _uSlot );
+
+
+		/////////////////MEMBER VARIABLES/////////////////
+
+		std::vector< USER_TYPE >	m_oElements;
+		std::vector< uint32_t >		m_oElementsSlots;					//Slot of each element, same indices as m_oElements
+		std::vector< Slot >			m_oSlots;
+		uint32_t					m_uFirstFreeSlot{ UINT32_MAX };
+	};
+} //namespace fzn
+
+#include "FZN/DataStructure/DenseArray.inl"
+
+#endif //_DENSEARRAY_H_
@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Contiguous array with constant time removal and stable handles
+//------------------------------------------------------------------------
+
+#include <cassert>
+
+#include "FZN/DataStructure/DenseArray.h"
+#include "FZN/Tools/Logging.h"
+
+
+namespace fzn
+{
+	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Default parametered constructor
+	//Parameter : Number of elements to reserve memory for
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	DenseArray<USER_TYPE>::DenseArray( int _iInitialSize )
+	{
+		Reserve( _iInitialSize );
+	}
+
+
+	/////////////////OTHER FUNCTIONS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds an element at the end of the array
+	//Parameter : Element to add
+	//Return value : Index of the element
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	int DenseArray<USER_TYPE>::PushBack( const USER_TYPE& _element )
+	{
+		uint32_t uSlot = m_uFirstFreeSlot;
+
+		if( uSlot == UINT32_MAX )
+		{
+			uSlot = (uint32_t)m_oSlots.size();
+			m_oSlots.emplace_back();
+		}
+		else
+			m_uFirstFreeSlot = m_oSlots[ uSlot ].m_uIndex;
+
+		m_oSlots[ uSlot ].m_uIndex = (uint32_t)m_oElements.size();
+		m_oElements.push_back( _element );
+		m_oElementsSlots.push_back( uSlot );
+
+		return (int)m_oElements.size() - 1;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes the last element of the array
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	void DenseArray<USER_TYPE>::PopBack()
+	{
+		if( m_oElements.empty() )
+			return;
+
+		_FreeSlot( m_oElementsSlots.back() );
+		m_oElements.pop_back();
+		m_oElementsSlots.pop_back();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes an element from the array, the last element takes its place
+	//Parameter : Index of the element to remove
+	//Return value : The element has been removed (true) or the index is out of range
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	bool DenseArray<USER_TYPE>::Remove( int _index )
+	{
+		if( _index < 0 || _index >= Size() )
+			return false;
+
+		_FreeSlot( m_oElementsSlots[ _index ] );
+
+		const int iLast = Size() - 1;
+
+		if( _index != iLast )
+		{
+			m_oElements[ _index ] = std::move( m_oElements[ iLast ] );
+			m_oElementsSlots[ _index ] = m_oElementsSlots[ iLast ];
+			m_oSlots[ m_oElementsSlots[ _index ] ].m_uIndex = (uint32_t)_index;
+		}
+
+		m_oElements.pop_back();
+		m_oElementsSlots.pop_back();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes an element from the array, the last element takes its place
+	//Parameter : Handle of the element to remove
+	//Return value : The element has been removed (true) or the handle isn't valid anymore
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	bool DenseArray<USER_TYPE>::Remove( Handle _handle )
+	{
+		return Remove( GetIndex( _handle ) );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Finds the first element equal to the given one
+	//Parameter : Element to look for
+	//Return value : Element (nullptr if not found)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	USER_TYPE* DenseArray<USER_TYPE>::FindElement( const USER_TYPE& _element )
+	{
+		const int index = FindIndex( _element );
+
+		if( index == -1 )
+			return nullptr;
+
+		return &m_oElements[ index ];
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Finds the index of the first element equal to the given one
+	//Parameter : Element to look for
+	//Return value : Index (-1 if not found)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	int DenseArray<USER_TYPE>::FindIndex( const USER_TYPE& _element ) const
+	{
+		const int iNbElements = Size();
+
+		for( int index = 0 ; index < iNbElements ; ++index )
+		{
+			if( m_oElements[ index ] == _element )
+				return index;
+		}
+
+		return -1;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes all the elements, their handles become invalid
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	void DenseArray<USER_TYPE>::Clear()
+	{
+		for( const uint32_t uSlot : m_oElementsSlots )
+			_FreeSlot( uSlot );
+
+		m_oElements.clear();
+		m_oElementsSlots.clear();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Allocates the memory for a given number of elements
+	//Parameter : Number of elements
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	void DenseArray<USER_TYPE>::Reserve( int _iSize )
+	{
+		if( _iSize <= 0 )
+			return;
+
+		m_oElements.reserve( _iSize );
+		m_oElementsSlots.reserve( _iSize );
+		m_oSlots.reserve( _iSize );
+	}
+
+
+	/////////////////OPERATORS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Access operator, the index has to be in range (asserted)
+	//Parameter : Index to reach in the array
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	USER_TYPE& DenseArray<USER_TYPE>::operator[]( int _index )
+	{
+		assert( _index >= 0 && _index < Size() && "DenseArray index out of range." );
+
+		//Release builds fall back on the first element, there is none to return if the array is empty.
+		if( _index < 0 || _index >= Size() )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Index %d out of range (%d max).", _index, Size() );
+			return m_oElements[ 0 ];
+		}
+
+		return m_oElements[ _index ];
+	}
+
+	template <class USER_TYPE>
+	const USER_TYPE& DenseArray<USER_TYPE>::operator[]( int _index ) const
+	{
+		assert( _index >= 0 && _index < Size() && "DenseArray index out of range." );
+
+		//Release builds fall back on the first element, there is none to return if the array is empty.
+		if( _index < 0 || _index >= Size() )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Index %d out of range (%d max).", _index, Size() );
+			return m_oElements[ 0 ];
+		}
+
+		return m_oElements[ _index ];
+	}
+
+
+	/////////////////ACCESSOR / MUTATOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on the handle of an element
+	//Parameter : Index of the element
+	//Return value : Handle of the element (invalid if the index is out of range)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	typename DenseArray<USER_TYPE>::Handle DenseArray<USER_TYPE>::GetHandle( int _index ) const
+	{
+		Handle oHandle;
+
+		if( _index < 0 || _index >= Size() )
+			return oHandle;
+
+		oHandle.m_uSlot = m_oElementsSlots[ _index ];
+		oHandle.m_uGeneration = m_oSlots[ oHandle.m_uSlot ].m_uGeneration;
+		return oHandle;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on the current index of an element
+	//Parameter : Handle of the element
+	//Return value : Index of the element (-1 if it has been removed)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	int DenseArray<USER_TYPE>::GetIndex( Handle _handle ) const
+	{
+		if( _handle.m_uSlot >= m_oSlots.size() || m_oSlots[ _handle.m_uSlot ].m_uGeneration != _handle.m_uGeneration )
+			return -1;
+
+		return (int)m_oSlots[ _handle.m_uSlot ].m_uIndex;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on an element
+	//Parameter : Handle of the element
+	//Return value : Element (nullptr if it has been removed)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	USER_TYPE* DenseArray<USER_TYPE>::Get( Handle _handle )
+	{
+		const int index = GetIndex( _handle );
+
+		if( index == -1 )
+			return nullptr;
+
+		return &m_oElements[ index ];
+	}
+
+
+	//=========================================================
+	//==========================PRIVATE=========================
+	//=========================================================
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Gives the slot of a removed element to the next added one
+	//Parameter : Slot to free
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_TYPE>
+	void DenseArray<USER_TYPE>::_FreeSlot( uint32_t _uSlot )
+	{
+		Slot& oSlot = m_oSlots[ _uSlot ];
+
+		++oSlot.m_uGeneration;
+		oSlot.m_uIndex = m_uFirstFreeSlot;
+		m_uFirstFreeSlot = _uSlot;
+	}
+} //namespace fzn
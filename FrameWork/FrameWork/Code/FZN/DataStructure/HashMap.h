@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Open addressing hash map storing its elements contiguously
+//------------------------------------------------------------------------
+
+#ifndef _HASHMAP_H_
+#define _HASHMAP_H_
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+namespace fzn
+{
+	//The elements are stored next to each other in insertion order (until a removal moves the last one in the removed one's place).
+	//The buckets only hold the index of their element and a part of its key hash, and are probed linearly so a search reads contiguous memory.
+	template <class USER_KEY, class USER_TYPE, class HASHER = std::hash< USER_KEY > > class HashMap
+	{
+	public:
+		struct Element
+		{
+			USER_KEY		key;
+			USER_TYPE		data;
+		};
+
+		/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Default parametered constructor
+		//Parameter : Number of elements to reserve memory for
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		HashMap( int _iInitialSize = 0 );
+
+
+		/////////////////OTHER FUNCTIONS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds an element or replaces the data of an existing one
+		//Parameter 1 : Key of the element
+		//Parameter 2 : Data of the element
+		//Return value : Data stored in the map
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		USER_TYPE& Insert( const USER_KEY& _key, const USER_TYPE& _data );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes an element
+		//Parameter : Key of the element
+		//Return value : The element has been removed (true) or wasn't in the map
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool Remove( const USER_KEY& _key );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Finds an element from its key
+		//Parameter : Key of the element
+		//Return value : Element (nullptr if not found)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		Element* Find( const USER_KEY& _key );
+		const Element* Find( const USER_KEY& _key ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes all the elements, the memory is kept for the next ones
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Clear();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Allocates the memory for a given number of elements
+		//Parameter : Number of elements
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Reserve( int _iSize );
+
+
+		/////////////////OPERATORS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Access operator, adds a default element if the key isn't in the map
+		//Parameter : Key of the element
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		USER_TYPE& operator[]( const USER_KEY& _key );
+
+
+		/////////////////ACCESSOR / MUTATOR/////////////////
+
+		Element* begin() { return m_oElements.data(); }
+		Element* end() { return m_oElements.data() + m_oElements.size(); }
+		const Element* begin() const { return m_oElements.data(); }
+		const Element* end() const { return m_oElements.data() + m_oElements.size(); }
+
+		int Size() const { return (int)m_oElements.size(); }
+		bool Empty() const { return m_oElements.empty(); }
+
+	private:
+		static constexpr uint32_t EmptyBucket{ UINT32_MAX };
+		static constexpr size_t MinBucketCount{ 8 };
+
+		struct Bucket
+		{
+			uint32_t m_uElement{ EmptyBucket };		//Index of the element in m_oElements
+			uint32_t m_uHash{ 0 };
+		};
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mixes the hasher result so keys with a poor hash (like aligned pointers) are spread over all the buckets
+		//Parameter : Key to hash
+		//Return value : Hash of the key
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static uint32_t _Hash( const USER_KEY& _key );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Finds the bucket of a key
+		//Parameter 1 : Key to look for
+		//Parameter 2 : Hash of the key
+		//Return value : Index of the bucket holding the key, or of the empty bucket ending its probe sequence
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		size_t _FindBucket( const USER_KEY& _key, uint32_t _uHash ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds an element that isn't in the map yet
+		//Parameter 1 : Key of the element
+		//Parameter 2 : Hash of the key
+		//Parameter 3 : Data of the element
+		//Return value : Data stored in the map
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		USER_TYPE& _Add( const USER_KEY& _key, uint32_t _uHash, const USER_TYPE& _data );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Reallocates the buckets and places the elements in them again
+		//Parameter : New number of buckets (power of 2)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _Rehash( size_t _uNbBuckets );
+
+
+		/////////////////MEMBER VARIABLES/////////////////
+
+		std::vector< Element >		m_oElements;
+		std::vector< Bucket >		m_oBuckets;				//Number of buckets always being a power of 2, the hash is masked to get the first bucket to probe
+	};
+} //namespace fzn
+
+#include "FZN/DataStructure/HashMap.inl"
+
+#endif //_HASHMAP_H_
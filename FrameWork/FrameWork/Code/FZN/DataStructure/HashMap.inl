@@ -0,0 +1,268 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Open addressing hash map storing its elements contiguously
+//------------------------------------------------------------------------
+
+#include "FZN/DataStructure/HashMap.h"
+
+
+namespace fzn
+{
+	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Default parametered constructor
+	//Parameter : Number of elements to reserve memory for
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	HashMap<USER_KEY, USER_TYPE, HASHER>::HashMap( int _iInitialSize /*= 0*/ )
+	{
+		Reserve( _iInitialSize );
+	}
+
+
+	/////////////////OTHER FUNCTIONS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds an element or replaces the data of an existing one
+	//Parameter 1 : Key of the element
+	//Parameter 2 : Data of the element
+	//Return value : Data stored in the map
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	USER_TYPE& HashMap<USER_KEY, USER_TYPE, HASHER>::Insert( const USER_KEY& _key, const USER_TYPE& _data )
+	{
+		const uint32_t uHash = _Hash( _key );
+
+		if( m_oBuckets.empty() == false )
+		{
+			const Bucket& oBucket = m_oBuckets[ _FindBucket( _key, uHash ) ];
+
+			if( oBucket.m_uElement != EmptyBucket )
+				return m_oElements[ oBucket.m_uElement ].data = _data;
+		}
+
+		return _Add( _key, uHash, _data );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes an element
+	//Parameter : Key of the element
+	//Return value : The element has been removed (true) or wasn't in the map
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	bool HashMap<USER_KEY, USER_TYPE, HASHER>::Remove( const USER_KEY& _key )
+	{
+		if( m_oBuckets.empty() )
+			return false;
+
+		const size_t uMask = m_oBuckets.size() - 1;
+		size_t uBucket = _FindBucket( _key, _Hash( _key ) );
+		const uint32_t uElement = m_oBuckets[ uBucket ].m_uElement;
+
+		if( uElement == EmptyBucket )
+			return false;
+
+		//The last element takes the place of the removed one, its bucket has to point to its new index.
+		const uint32_t uLast = (uint32_t)m_oElements.size() - 1;
+
+		if( uElement != uLast )
+		{
+			m_oBuckets[ _FindBucket( m_oElements[ uLast ].key, _Hash( m_oElements[ uLast ].key ) ) ].m_uElement = uElement;
+			m_oElements[ uElement ] = std::move( m_oElements[ uLast ] );
+		}
+
+		m_oElements.pop_back();
+
+		//The following buckets of the probe sequence are moved back so no search stops on the emptied bucket before finding its key.
+		size_t uNext = ( uBucket + 1 ) & uMask;
+
+		while( m_oBuckets[ uNext ].m_uElement != EmptyBucket )
+		{
+			const size_t uIdealBucket = m_oBuckets[ uNext ].m_uHash & uMask;
+
+			if( ( ( uNext - uIdealBucket ) & uMask ) >= ( ( uNext - uBucket ) & uMask ) )
+			{
+				m_oBuckets[ uBucket ] = m_oBuckets[ uNext ];
+				uBucket = uNext;
+			}
+
+			uNext = ( uNext + 1 ) & uMask;
+		}
+
+		m_oBuckets[ uBucket ] = Bucket();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Finds an element from its key
+	//Parameter : Key of the element
+	//Return value : Element (nullptr if not found)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	typename HashMap<USER_KEY, USER_TYPE, HASHER>::Element* HashMap<USER_KEY, USER_TYPE, HASHER>::Find( const USER_KEY& _key )
+	{
+		return const_cast< Element* >( static_cast< const HashMap* >( this )->Find( _key ) );
+	}
+
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	const typename HashMap<USER_KEY, USER_TYPE, HASHER>::Element* HashMap<USER_KEY, USER_TYPE, HASHER>::Find( const USER_KEY& _key ) const
+	{
+		if( m_oBuckets.empty() )
+			return nullptr;
+
+		const uint32_t uElement = m_oBuckets[ _FindBucket( _key, _Hash( _key ) ) ].m_uElement;
+
+		if( uElement == EmptyBucket )
+			return nullptr;
+
+		return &m_oElements[ uElement ];
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes all the elements, the memory is kept for the next ones
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	void HashMap<USER_KEY, USER_TYPE, HASHER>::Clear()
+	{
+		m_oElements.clear();
+		m_oBuckets.assign( m_oBuckets.size(), Bucket() );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Allocates the memory for a given number of elements
+	//Parameter : Number of elements
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	void HashMap<USER_KEY, USER_TYPE, HASHER>::Reserve( int _iSize )
+	{
+		if( _iSize <= 0 )
+			return;
+
+		m_oElements.reserve( _iSize );
+
+		//The buckets are kept at most 3/4 full, the probe sequences getting long above that.
+		size_t uNbBuckets = MinBucketCount;
+
+		while( uNbBuckets * 3 < (size_t)_iSize * 4 )
+			uNbBuckets *= 2;
+
+		if( uNbBuckets > m_oBuckets.size() )
+			_Rehash( uNbBuckets );
+	}
+
+
+	/////////////////OPERATORS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Access operator, adds a default element if the key isn't in the map
+	//Parameter : Key of the element
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	USER_TYPE& HashMap<USER_KEY, USER_TYPE, HASHER>::operator[]( const USER_KEY& _key )
+	{
+		const uint32_t uHash = _Hash( _key );
+
+		if( m_oBuckets.empty() == false )
+		{
+			const Bucket& oBucket = m_oBuckets[ _FindBucket( _key, uHash ) ];
+
+			if( oBucket.m_uElement != EmptyBucket )
+				return m_oElements[ oBucket.m_uElement ].data;
+		}
+
+		return _Add( _key, uHash, USER_TYPE() );
+	}
+
+
+	//=========================================================
+	//==========================PRIVATE=========================
+	//=========================================================
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mixes the hasher result so keys with a poor hash (like aligned pointers) are spread over all the buckets
+	//Parameter : Key to hash
+	//Return value : Hash of the key
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	uint32_t HashMap<USER_KEY, USER_TYPE, HASHER>::_Hash( const USER_KEY& _key )
+	{
+		uint64_t uHash = (uint64_t)HASHER()( _key );
+
+		uHash ^= uHash >> 33;
+		uHash *= 0xff51afd7ed558ccdull;
+		uHash ^= uHash >> 33;
+
+		return (uint32_t)uHash;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Finds the bucket of a key
+	//Parameter 1 : Key to look for
+	//Parameter 2 : Hash of the key
+	//Return value : Index of the bucket holding the key, or of the empty bucket ending its probe sequence
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	size_t HashMap<USER_KEY, USER_TYPE, HASHER>::_FindBucket( const USER_KEY& _key, uint32_t _uHash ) const
+	{
+		const size_t uMask = m_oBuckets.size() - 1;
+		size_t uBucket = _uHash & uMask;
+
+		//There is always at least one empty bucket, the loop ends.
+		while( true )
+		{
+			const Bucket& oBucket = m_oBuckets[ uBucket ];
+
+			if( oBucket.m_uElement == EmptyBucket || ( oBucket.m_uHash == _uHash && m_oElements[ oBucket.m_uElement ].key == _key ) )
+				return uBucket;
+
+			uBucket = ( uBucket + 1 ) & uMask;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds an element that isn't in the map yet
+	//Parameter 1 : Key of the element
+	//Parameter 2 : Hash of the key
+	//Parameter 3 : Data of the element
+	//Return value : Data stored in the map
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	USER_TYPE& HashMap<USER_KEY, USER_TYPE, HASHER>::_Add( const USER_KEY& _key, uint32_t _uHash, const USER_TYPE& _data )
+	{
+		if( ( m_oElements.size() + 1 ) * 4 > m_oBuckets.size() * 3 )
+			_Rehash( m_oBuckets.empty() ? MinBucketCount : m_oBuckets.size() * 2 );
+
+		Bucket& oBucket = m_oBuckets[ _FindBucket( _key, _uHash ) ];
+		oBucket.m_uElement = (uint32_t)m_oElements.size();
+		oBucket.m_uHash = _uHash;
+
+		m_oElements.push_back( { _key, _data } );
+		return m_oElements.back().data;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Reallocates the buckets and places the elements in them again
+	//Parameter : New number of buckets (power of 2)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template <class USER_KEY, class USER_TYPE, class HASHER>
+	void HashMap<USER_KEY, USER_TYPE, HASHER>::_Rehash( size_t _uNbBuckets )
+	{
+		m_oBuckets.assign( _uNbBuckets, Bucket() );
+
+		const size_t uMask = _uNbBuckets - 1;
+
+		for( uint32_t uElement = 0 ; uElement < (uint32_t)m_oElements.size() ; ++uElement )
+		{
+			const uint32_t uHash = _Hash( m_oElements[ uElement ].key );
+			size_t uBucket = uHash & uMask;
+
+			while( m_oBuckets[ uBucket ].m_uElement != EmptyBucket )
+				uBucket = ( uBucket + 1 ) & uMask;
+
+			m_oBuckets[ uBucket ].m_uElement = uElement;
+			m_oBuckets[ uBucket ].m_uHash = uHash;
+		}
+	}
+} //namespace fzn
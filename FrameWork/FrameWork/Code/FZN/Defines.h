@@ -25,9 +25,10 @@
 #define CheckNullptrReturn( Arg, Ret )	{ if( Arg == nullptr ) return Ret; }
 #define CheckNullptrDelete( Arg )		{ if( Arg != nullptr ) { delete Arg; Arg = nullptr; } }
 
-#define RandIncludeMax( min, max )		( rand() % ( max - min + 1 ) + min )
-#define Rand( min, max )				( rand() % ( max - min ) + min )
-#define CoinFlip						( rand() % 2 == 1 )
+//Use the default generator of the calling thread (fzn::Random::GetDefault), so they give the same sequences on every platform for a given seed.
+#define RandIncludeMax( min, max )		( fzn::Random::GetDefault().GetInt( (int)( min ), (int)( max ) ) )
+#define Rand( min, max )				( fzn::Random::GetDefault().GetInt( (int)( min ), (int)( max ) - 1 ) )
+#define CoinFlip						( fzn::Random::GetDefault().GetBool() )
 
 #define ToString( Arg )					#Arg
 
@@ -20,7 +20,6 @@ namespace fzn
 	Animation::Animation()
 	{
 		m_texture = nullptr;
-		m_clock.restart();
 		m_iCurrentIndex = 0;
 		m_bReverseReading = FALSE;
 		m_eState = Playing;
@@ -65,7 +64,6 @@ namespace fzn
 		m_sprite = _animation.m_sprite;
 		m_rect = _animation.m_rect;
 		m_fDeltaTime = _animation.m_fDeltaTime;
-		m_clock = _animation.m_clock;
 		m_iNbrFrames = _animation.m_iNbrFrames;
 		m_iCurrentIndex = _animation.m_iCurrentIndex;
 		m_eState = _animation.m_eState;
@@ -103,7 +101,6 @@ namespace fzn
 		m_sprite = _animation.m_sprite;
 		m_rect = _animation.m_rect;
 		m_fDeltaTime = _animation.m_fDeltaTime;
-		m_clock = _animation.m_clock;
 		m_iNbrFrames = _animation.m_iNbrFrames;
 		m_iCurrentIndex = _animation.m_iCurrentIndex;
 		m_eState = _animation.m_eState;
@@ -141,7 +138,6 @@ namespace fzn
 		m_sprite = _animation.m_sprite;
 		m_rect = _animation.m_rect;
 		m_fDeltaTime = _animation.m_fDeltaTime;
-		m_clock = _animation.m_clock;
 		m_iNbrFrames = _animation.m_iNbrFrames;
 		m_iCurrentIndex = _animation.m_iCurrentIndex;
 		m_eState = _animation.m_eState;
@@ -189,7 +185,14 @@ namespace fzn
 
 	void Animation::LoadFromFile( const std::string& _name, const std::string& _path )
 	{
-		m_positions = nullptr;
+		//The animation can be loaded again by the hot reload, so the previous frames have to be released.
+		if( m_positions != nullptr )
+		{
+			delete[] m_positions;
+			m_positions = nullptr;
+		}
+
+		m_iCurrentIndex = 0;
 		m_iFirstCol = 0;
 		m_iFirstRow = 0;
 
@@ -245,7 +248,6 @@ namespace fzn
 
 		RectPositioning();
 
-		m_clock.restart();
 		m_iCurrentIndex = 0;
 		m_eState = Playing;
 		m_fSpeed = 1.f;
@@ -262,7 +264,7 @@ namespace fzn
 
 		if( m_positions != nullptr )
 		{
-			m_fTimer += m_bUseUnmodifiedFrameTime ? UnmodifiedFrameTime : FrameTime;
+			m_fTimer += g_pFZN_Core->GetTimeService().GetDeltaSeconds( m_bUseUnmodifiedFrameTime ? TimeDomain::Real : TimeDomain::Animation );
 			if( m_eState == State::Playing && m_fTimer >= m_fDeltaTime /** ( 1 / m_fSpeed )*/ )
 			{
 				UpdateIndex();
@@ -270,7 +272,6 @@ namespace fzn
 				int x = m_positions[m_iCurrentIndex].x;
 				int y = m_positions[m_iCurrentIndex].y;
 				m_sprite.setTextureRect( sf::IntRect( x, y, m_rect.x, m_rect.y ) );
-				m_clock.restart();
 				m_fTimer -= m_fDeltaTime;
 			}
 			else if( m_eState == State::Paused )
@@ -378,7 +379,6 @@ namespace fzn
 		if( bReset )
 		{
 			m_iCurrentIndex = 0;
-			m_clock.restart();
 		}
 	}
 
@@ -394,7 +394,6 @@ namespace fzn
 		{
 			m_iCurrentIndex = 0;
 			m_sprite.setTextureRect( sf::IntRect( m_positions[0].x, m_positions[0].y, m_rect.x, m_rect.y ) );
-			m_clock.restart();
 		}
 	}
 
@@ -190,7 +190,6 @@ namespace fzn
 		sf::Sprite		m_sprite;
 		sf::Vector2i	m_rect;						//Size of the textureRects of the animation
 		float			m_fDeltaTime;				//Delta time between each frame
-		sf::Clock		m_clock;					//Internal animation timer
 		int				m_iFirstCol;				//Pixel position of the first column of the animation (left of the animation)
 		int				m_iFirstRow;				//Pixel position of the first line of the animation (top of the animation)
 		int				m_iNbrCol;					//Number of columns in the animation spritesheet
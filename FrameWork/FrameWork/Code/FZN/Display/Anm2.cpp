@@ -4,6 +4,9 @@
 /// Description : The Binding Of Isaac Rebirth animation class
 //------------------------------------------------------------------------
 
+#include <cmath>
+#include <unordered_set>
+
 #include "FZN/Includes.h"
 #include "FZN/Managers/AnimManager.h"
 #include "FZN/Managers/AudioManager.h"
@@ -16,6 +19,16 @@
 
 namespace fzn
 {
+	namespace
+	{
+		//Copies of the DataManager templates, re-bound when their template is reloaded.
+		std::unordered_set< Anm2* >& GetTemplateCopies()
+		{
+			static std::unordered_set< Anm2* > s_oCopies;
+			return s_oCopies;
+		}
+	}
+
 	const std::string Anm2::ANIMATION_START = "AnimationStart";
 	const std::string Anm2::ANIMATION_END	= "AnimationEnd";
 
@@ -47,8 +60,19 @@ namespace fzn
 	}
 
 
+	Anm2::TriggerContent::TriggerContent( const std::string& _sSound, bool _bRemoveCallbackWhenCalled /*= false*/ )
+		: m_pCallback( nullptr )
+		, m_uSound( g_pFZN_AudioMgr != nullptr ? g_pFZN_AudioMgr->GetSoundHandle( _sSound ) : INVALID_SOUND )
+		, m_bRemoveCallbackWhenCalled( _bRemoveCallbackWhenCalled )
+	{
+		if( g_pFZN_AudioMgr == nullptr && _sSound.empty() == false )
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Failure : the trigger sound \"%s\" can't be resolved without the audio module, it is ignored.", _sSound.c_str() );
+	}
+
+
 	Anm2::Anm2()
 		: Animation()
+		, m_bTriggerTableDirty( true )
 		, m_bIsProcessingTriggers( false )
 		, m_bReplaceTriggers( false )
 		, m_fDuration( 0.f )
@@ -60,6 +84,8 @@ namespace fzn
 		, m_fRotation( 0.f )
 		, m_vFlippedScale( { 1.f, 1.f } )
 		, m_fScaleRatio( 1.f )
+		, m_pTemplate( nullptr )
+		, m_bIsTemplate( false )
 	{
 		m_iCurrentIndex = -1;
 
@@ -72,8 +98,11 @@ namespace fzn
 	}
 
 	Anm2::Anm2( const Anm2& _oAnm )
-		: m_bIsProcessingTriggers( false )
+		: m_bTriggerTableDirty( true )
+		, m_bIsProcessingTriggers( false )
 		, m_bReplaceTriggers( false )
+		, m_pTemplate( nullptr )
+		, m_bIsTemplate( false )
 	{
 		*this = _oAnm;
 
@@ -88,6 +117,27 @@ namespace fzn
 
 	Anm2::~Anm2()
 	{
+		std::unordered_set< Anm2* >& oCopies = GetTemplateCopies();
+
+		if( m_bIsTemplate == false )
+		{
+			if( m_pTemplate != nullptr )
+				oCopies.erase( this );
+
+			return;
+		}
+
+		//The copies of an unloaded template keep their data but aren't reloaded anymore.
+		for( std::unordered_set< Anm2* >::iterator itCopy = oCopies.begin(); itCopy != oCopies.end(); )
+		{
+			if( ( *itCopy )->m_pTemplate == this )
+			{
+				( *itCopy )->m_pTemplate = nullptr;
+				itCopy = oCopies.erase( itCopy );
+			}
+			else
+				++itCopy;
+		}
 	}
 
 	bool Anm2::IsValid() const
@@ -125,6 +175,8 @@ namespace fzn
 		m_vFlippedScale				= _animation.m_vFlippedScale;
 		m_fScaleRatio				= _animation.m_fScaleRatio;
 
+		_SetTemplate( &_animation );
+
 		return *this;
 	}
 
@@ -208,6 +260,8 @@ namespace fzn
 		else
 			m_fRotation = _pAnimation->m_fRotation;
 
+		_SetTemplate( _pAnimation );
+
 		return true;
 	}
 
@@ -314,7 +368,7 @@ namespace fzn
 		{
 			bool bRestart = false;
 
-			m_fTimer += m_bUseUnmodifiedFrameTime ? UnmodifiedFrameTime : FrameTime;
+			m_fTimer += g_pFZN_Core->GetTimeService().GetDeltaSeconds( m_bUseUnmodifiedFrameTime ? TimeDomain::Real : TimeDomain::Animation );
 
 			if( m_fTimer >= m_fDuration * m_fSpeedRatio )
 			{
@@ -1279,13 +1333,16 @@ namespace fzn
 				pEvent = pEvent->NextSiblingElement();
 			}
 
-			oTrigger.m_fTime = pXMLTrigger->IntAttribute( "AtFrame" ) * AnimFrameTime;
+			oTrigger.m_iFrame = pXMLTrigger->IntAttribute( "AtFrame" );
+			oTrigger.m_fTime = oTrigger.m_iFrame * AnimFrameTime;
 
 			if( oTrigger.IsValid() )
 				m_oTriggers.push_back( oTrigger );
 
 			pXMLTrigger = pXMLTrigger->NextSiblingElement();
 		}
+
+		m_bTriggerTableDirty = true;
 	}
 
 	void Anm2::_FillFrameInformations( FrameInfo& _oFrame, tinyxml2::XMLElement* _pXMLFrame )
@@ -1369,7 +1426,7 @@ namespace fzn
 		for( LayerInfo& oCurrentLayer : _oVector )
 		{
 			const FrameInfo& oCurrentFrameInfo = oCurrentLayer.m_oFrames[ oCurrentLayer.m_iFrameIndex ];
-			oCurrentLayer.m_fTimer += m_bUseUnmodifiedFrameTime ? UnmodifiedFrameTime : FrameTime;
+			oCurrentLayer.m_fTimer += g_pFZN_Core->GetTimeService().GetDeltaSeconds( m_bUseUnmodifiedFrameTime ? TimeDomain::Real : TimeDomain::Animation );
 
 			const float fDuration = oCurrentFrameInfo.m_fDuration * m_fSpeedRatio;
 
@@ -1471,19 +1528,53 @@ namespace fzn
 		if( _bAnimStarting )
 			_ProcessTriggerContents( m_oAnimationStartTrigger );
 
-		for( Trigger& oTrigger : m_oTriggers )
+		if( m_bTriggerTableDirty )
+			_BuildTriggerTable();
+
+		const float fFrameDuration = m_iFPS > 0 ? AnimFrameTime * m_fSpeedRatio : 0.f;
+
+		if( m_oTriggers.empty() == false && fFrameDuration > 0.f )
 		{
-			const float fTargetTime = oTrigger.m_fTime * m_fSpeedRatio;
+			//Triggers of the frames in ]previous timer, timer], the first frame being included when the animation starts.
+			const int iLastEntry = (int)m_oTriggerTable.size() - 1;
+			const int iFirstFrame = m_fPreviousTimer == 0.f ? 0 : (int)( m_fPreviousTimer / fFrameDuration ) + 1;
+			const int iLastFrame = (int)( m_fTimer / fFrameDuration );
 
-			if( m_fTimer >= fTargetTime && ( m_fPreviousTimer < fTargetTime || fTargetTime == 0.f && m_fPreviousTimer == 0.f ) )
+			if( iFirstFrame <= iLastFrame && iFirstFrame <= iLastEntry )
 			{
-				_ProcessTriggerContents( oTrigger );
+				const size_t uLastTrigger = m_oTriggerTable[ Math::Min( iLastFrame + 1, iLastEntry ) ];
+
+				//Indices are checked against the vector size as a callback can add triggers.
+				for( size_t uTrigger = m_oTriggerTable[ iFirstFrame ]; uTrigger < uLastTrigger && uTrigger < m_oTriggers.size(); ++uTrigger )
+					_ProcessTriggerContents( m_oTriggers[ uTrigger ] );
 			}
 		}
 
 		_ProcessTriggersBuffers();
 	}
 
+	void Anm2::_BuildTriggerTable()
+	{
+		std::stable_sort( m_oTriggers.begin(), m_oTriggers.end(), []( const Trigger& _oTriggerA, const Trigger& _oTriggerB )
+		{
+			return _oTriggerA.m_iFrame < _oTriggerB.m_iFrame;
+		} );
+
+		const int iNbFrames = m_oTriggers.empty() ? 0 : m_oTriggers.back().m_iFrame + 1;
+		m_oTriggerTable.assign( iNbFrames + 1, 0 );
+
+		size_t uTrigger = 0;
+		for( int iFrame = 0; iFrame <= iNbFrames; ++iFrame )
+		{
+			while( uTrigger < m_oTriggers.size() && m_oTriggers[ uTrigger ].m_iFrame < iFrame )
+				++uTrigger;
+
+			m_oTriggerTable[ iFrame ] = (uint16_t)uTrigger;
+		}
+
+		m_bTriggerTableDirty = false;
+	}
+
 	void Anm2::_UpdateFlippedScale( LayerInfoVector& _oVector )
 	{
 		for( LayerInfo& oCurrentLayer : _oVector )
@@ -1558,8 +1649,8 @@ namespace fzn
 			{
 				itContent->m_pCallback->Call( _oTrigger.m_sName, this );
 			}
-			else
-				g_pFZN_AudioMgr->Sound_Play( itContent->m_sSound );
+			else if( g_pFZN_AudioMgr != nullptr )
+				g_pFZN_AudioMgr->Sound_Play( itContent->m_uSound );
 
 			if( itContent->m_bRemoveCallbackWhenCalled )
 				itContent = _oTrigger.m_oContent.erase( itContent );
@@ -1582,6 +1673,7 @@ namespace fzn
 			m_oAnimationEndTriggerBuffer.m_oContent.clear();
 
 			m_bReplaceTriggers = false;
+			m_bTriggerTableDirty = true;
 		}
 
 		m_bIsProcessingTriggers = false;
@@ -1602,6 +1694,7 @@ namespace fzn
 			m_oTriggers					= _pAnimation->m_oTriggers;
 			m_oAnimationStartTrigger	= _pAnimation->m_oAnimationStartTrigger;
 			m_oAnimationEndTrigger		= _pAnimation->m_oAnimationEndTrigger;
+			m_bTriggerTableDirty		= true;
 
 			m_oTriggersBuffer.clear();
 			m_oAnimationStartTriggerBuffer.Reset();
@@ -1609,6 +1702,64 @@ namespace fzn
 		}
 	}
 
+	void Anm2::_SetTemplate( const Anm2* _pSource )
+	{
+		if( m_bIsTemplate )
+			return;
+
+		m_pTemplate = _pSource->m_bIsTemplate ? _pSource : _pSource->m_pTemplate;
+
+		if( m_pTemplate != nullptr )
+			GetTemplateCopies().insert( this );
+		else
+			GetTemplateCopies().erase( this );
+	}
+
+	void Anm2::_OnTemplateReloaded( const Anm2* _pTemplate )
+	{
+		std::vector< Anm2* > oCopies;
+
+		for( Anm2* pCopy : GetTemplateCopies() )
+		{
+			if( pCopy->m_pTemplate == _pTemplate )
+				oCopies.push_back( pCopy );
+		}
+
+		for( Anm2* pCopy : oCopies )
+		{
+			//The frames may have changed, so the copy restarts the reloaded animation but keeps its state, flip, scale and callbacks.
+			const State			eState			= pCopy->m_eState;
+			const int			iFlip			= pCopy->GetFlipX();
+			const float			fScaleRatio		= pCopy->m_fScaleRatio;
+			const TriggerVector	oTriggers		= pCopy->m_oTriggers;
+			const Trigger		oStartTrigger	= pCopy->m_oAnimationStartTrigger;
+			const Trigger		oEndTrigger		= pCopy->m_oAnimationEndTrigger;
+
+			pCopy->ChangeAnimation( _pTemplate, ChangeAnimationSettings::eKeepPosition | ChangeAnimationSettings::eKeepRotation | ChangeAnimationSettings::eOverrideScaleRatio );
+
+			if( fScaleRatio != pCopy->m_fScaleRatio )
+				pCopy->SetScaleRatio( fScaleRatio );
+
+			pCopy->FlipX( iFlip );
+			pCopy->m_eState = eState;
+
+			for( const Trigger& oTrigger : oTriggers )
+			{
+				if( _FindTriggerInTriggerVector( pCopy->m_oTriggers, oTrigger.m_sName ) == pCopy->m_oTriggers.end() )
+					continue;
+
+				for( const TriggerContent& oContent : oTrigger.m_oContent )
+					pCopy->_AddContentToTriggerVector( pCopy->m_oTriggers, oContent, oTrigger.m_sName );
+			}
+
+			for( const TriggerContent& oContent : oStartTrigger.m_oContent )
+				pCopy->_AddContentToTriggerContentVector( pCopy->m_oAnimationStartTrigger.m_oContent, oContent );
+
+			for( const TriggerContent& oContent : oEndTrigger.m_oContent )
+				pCopy->_AddContentToTriggerContentVector( pCopy->m_oAnimationEndTrigger.m_oContent, oContent );
+		}
+	}
+
 	void Anm2::_AddContentToTriggerVector( TriggerVector& _oVector, const TriggerContent& _oContent, const std::string& _sTrigger, const float _fTime /*= -1.f*/ )
 	{
 		TriggerVector::iterator itTrigger = _FindTriggerInTriggerVector( _oVector, _sTrigger, _fTime );
@@ -1617,9 +1768,12 @@ namespace fzn
 		{
 			if( _fTime >= 0.f )
 			{
-				_oVector.push_back( Trigger( _sTrigger, _fTime ) );
+				_oVector.push_back( Trigger( _sTrigger, _fTime, (int)std::round( _fTime * m_iFPS ) ) );
 
 				_AddContentToTriggerContentVector( _oVector.back().m_oContent, _oContent );
+
+				if( &_oVector == &m_oTriggers )
+					m_bTriggerTableDirty = true;
 			}
 			else
 				FZN_COLOR_LOG( fzn::DBG_MSG_COLORS::DBG_MSG_COL_RED, "Trigger \"%s\" not found in given vector. (\"%s\")", _sTrigger.c_str(), m_sName.c_str() );
@@ -1718,7 +1872,7 @@ namespace fzn
 	{
 		return std::find_if( _oVector.begin(), _oVector.end(), [_oContent]( const TriggerContent& oContent )
 		{
-			return oContent.m_pCallback == _oContent.m_pCallback && oContent.m_sSound == _oContent.m_sSound;
+			return oContent.m_pCallback == _oContent.m_pCallback && oContent.m_uSound == _oContent.m_uSound;
 		} );
 	}
 
@@ -1726,7 +1880,7 @@ namespace fzn
 	{
 		return std::find_if( _oVector.cbegin(), _oVector.cend(), [_oContent]( const TriggerContent& oContent )
 		{
-			return oContent.m_pCallback == _oContent.m_pCallback && oContent.m_sSound == _oContent.m_sSound;
+			return oContent.m_pCallback == _oContent.m_pCallback && oContent.m_uSound == _oContent.m_uSound;
 		} );
 	}
 
@@ -12,6 +12,7 @@
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Rect.hpp>
 
+#include "FZN/Audio/VoiceManager.h"
 #include "FZN/Display/Animation.h"
 #include "FZN/Tools/Callbacks.h"
 
@@ -26,6 +27,8 @@ namespace fzn
 {
 	class FZN_EXPORT Anm2 : public Animation
 	{
+		friend class DataManager;
+
 	public:
 		enum ChangeAnimationSettings
 		{
@@ -44,28 +47,24 @@ namespace fzn
 		{
 			TriggerContent( const TriggerContent& _oContent )
 				: m_pCallback( _oContent.m_pCallback )
-				, m_sSound( _oContent.m_sSound )
+				, m_uSound( _oContent.m_uSound )
 				, m_bRemoveCallbackWhenCalled( _oContent.m_bRemoveCallbackWhenCalled )
 			{}
 			TriggerContent( TriggerCallback _pCallback, bool _bRemoveCallbackWhenCalled = false )
 				: m_pCallback( _pCallback )
-				, m_sSound( "" )
+				, m_uSound( INVALID_SOUND )
 				, m_bRemoveCallbackWhenCalled( _bRemoveCallbackWhenCalled )
 			{}
-			TriggerContent( const std::string& _sSound, bool _bRemoveCallbackWhenCalled = false )
-				: m_pCallback( nullptr )
-				, m_sSound( _sSound )
-				, m_bRemoveCallbackWhenCalled( _bRemoveCallbackWhenCalled )
-			{
-			}
+			//The sound is resolved here, once, so firing the trigger doesn't need any string lookup (the content is invalid if the audio module isn't created).
+			TriggerContent( const std::string& _sSound, bool _bRemoveCallbackWhenCalled = false );
 
 			bool IsValid() const
 			{
-				return m_pCallback != nullptr || m_sSound.empty() == false;
+				return m_pCallback != nullptr || m_uSound != INVALID_SOUND;
 			}
 
 			TriggerCallback	m_pCallback;
-			std::string		m_sSound;
+			SoundHandle		m_uSound;
 			bool			m_bRemoveCallbackWhenCalled;
 		};
 		typedef std::vector< TriggerContent > TriggerContentVector;
@@ -76,9 +75,10 @@ namespace fzn
 			{
 				Reset();
 			}
-			Trigger( const std::string& _sName, float _fTime )
+			Trigger( const std::string& _sName, float _fTime, int _iFrame )
 				: m_sName( _sName )
 				, m_fTime( _fTime )
+				, m_iFrame( _iFrame )
 			{
 				m_oContent.clear();
 			}
@@ -91,6 +91,7 @@ namespace fzn
 			{
 				m_sName = "";
 				m_fTime = -1.f;
+				m_iFrame = -1;
 				m_oContent.clear();
 			}
 
@@ -101,6 +102,7 @@ namespace fzn
 
 			std::string				m_sName;
 			float					m_fTime;
+			int						m_iFrame;
 			TriggerContentVector	m_oContent;
 		};
 
@@ -159,7 +161,6 @@ namespace fzn
 				m_iBaseTextureId = 0;
 				m_sName = "";
 				m_iFrameIndex = 0;
-				m_oClock.restart();
 				m_fTimer = 0.f;
 				m_iFrameCount = 0;
 				m_bVisible = false;
@@ -188,7 +189,6 @@ namespace fzn
 			std::vector< FrameInfo >	m_oFrames;
 			int							m_iBaseTextureId;			// Base texture index in the vector.
 			sf::Sprite					m_oSprite;
-			sf::Clock					m_oClock;
 			float						m_fTimer;
 			int							m_iFrameCount;
 			int							m_iFrameIndex;
@@ -315,6 +315,7 @@ namespace fzn
 		void						_UpdateLayerInfos( LayerInfo& _oLayer, float _fPreviousFrameDuration = -1.f );
 		void						_ChangeAnimationLayerSetup( LayerInfo& _oDstLayer, const LayerInfo& _oSrcLayer );
 		void						_UpdateTriggers( bool _bAnimStarting );
+		void						_BuildTriggerTable();
 		void						_UpdateFlippedScale( LayerInfoVector& _oVector );
 		float						_GetLayerTotalDuration( const LayerInfo& _oLayer ) const;
 		float						_GetLayerDurationToIndex( const LayerInfo& _oLayer, int _iFrameIndex ) const;
@@ -325,6 +326,16 @@ namespace fzn
 		void						_ProcessTriggerContents( Trigger& _oTrigger );
 		void						_ProcessTriggersBuffers();
 		void						_ReplaceTriggersOnAnimationChange( const Anm2* _pAnimation );
+		//-------------------------------------------------------------------------------------------------
+		/// Keeps track of the DataManager template the animation comes from, so it can be re-bound by the hot reload.
+		/// @param	_pSource	: Animation copied (template or copy of a template).
+		//-------------------------------------------------------------------------------------------------
+		void						_SetTemplate( const Anm2* _pSource );
+		//-------------------------------------------------------------------------------------------------
+		/// Re-binds the live copies of a template the DataManager has just reloaded, keeping their position, rotation, timers and state.
+		/// @param	_pTemplate	: Reloaded template.
+		//-------------------------------------------------------------------------------------------------
+		static void					_OnTemplateReloaded( const Anm2* _pTemplate );
 
 		void						_AddContentToTriggerVector( TriggerVector& _oVector, const TriggerContent& _oContent, const std::string& _sTrigger, const float _fTime = -1.f );
 		bool						_TriggerVectorHasContent( const TriggerVector& _oVector, const TriggerContent& _oContent, const std::string& _sTrigger ) const;
@@ -347,6 +358,9 @@ namespace fzn
 		Trigger						m_oAnimationStartTrigger;
 		Trigger						m_oAnimationEndTrigger;
 
+		std::vector< uint16_t >		m_oTriggerTable;		//Index, in the triggers sorted by frame, of the first trigger of each frame (one more entry than frames)
+		bool						m_bTriggerTableDirty;
+
 		bool						m_bIsProcessingTriggers;
 		bool						m_bReplaceTriggers;
 		TriggerVector				m_oTriggersBuffer;
@@ -358,7 +372,6 @@ namespace fzn
 		float						m_fDuration;
 		float						m_fSpeedRatio;
 		int							m_iFPS;
-		sf::Clock					m_oClock;
 		float						m_fPreviousTimer;
 		std::string					m_sName;
 		sf::Vector2f				m_vPosition;
@@ -366,6 +379,9 @@ namespace fzn
 		bool						m_bResetAtEnd;
 		sf::Vector2f				m_vFlippedScale;
 		float						m_fScaleRatio;
+
+		const Anm2*					m_pTemplate;			//Template of the DataManager this animation has been copied from (nullptr for the templates)
+		bool						m_bIsTemplate;			//Owned by the DataManager, never copied
 	};
 }
 
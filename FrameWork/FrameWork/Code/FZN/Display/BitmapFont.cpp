@@ -1,5 +1,7 @@
 #include "FZN/Includes.h"
 
+#include <algorithm>
+
 #include <tinyXML2/tinyxml2.h>
 
 #include "FZN/Display/BitmapFont.h"
@@ -10,21 +12,32 @@ namespace fzn
 {
 	BitmapFont::BitmapFont()
 	: m_pTexture( nullptr )
+	, m_pAtlas( nullptr )
+	, m_vShelfPosition( 0, 0 )
+	, m_uShelfHeight( 0 )
+	, m_uFallbackGlyph( NoGlyph )
 	, m_fKerning( 0.f )
 	, m_fCharacterMinHeight( 0.f )
 	, m_fCharacterSmallHeight( 0.f )
 	, m_fVerticalSpacing( 0.f )
 	, m_fCustomGlyphsOffset( 0.f )
+	, m_uVersion( 0 )
 	{
 	}
 
 	BitmapFont::~BitmapFont()
 	{
+		_ClearAtlas();
 	}
 
 	void BitmapFont::LoadFromFile( const std::string& _sPath )
 	{
 		m_oGlyphs.clear();
+		m_oGlyphIndices.clear();
+		m_oKerningPairs.clear();
+		m_uFallbackGlyph = NoGlyph;
+		_ClearAtlas();
+		++m_uVersion;
 
 		tinyxml2::XMLDocument resFile;
 
@@ -56,46 +69,114 @@ namespace fzn
 
 		m_pTexture = g_pFZN_DataMgr->LoadTexture( sName, sTexturePath );
 
-		tinyxml2::XMLElement* pCharacter = pFont->FirstChildElement( "Character" );
-
-		while( pCharacter != nullptr )
+		for( tinyxml2::XMLElement* pElement = pFont->FirstChildElement(); pElement != nullptr; pElement = pElement->NextSiblingElement() )
 		{
-			BitmapGlyph oGlyph;
-			char cCharacter = *Tools::XMLStringAttribute( pCharacter, "Name" ).c_str();
-			
-			if( m_oGlyphs.find( cCharacter ) != m_oGlyphs.end() )
+			const std::string sElement = pElement->Value();
+
+			if( sElement == "Character" )
 			{
-				pCharacter = pCharacter->NextSiblingElement();
-				continue;
+				//The character can either be given by its UTF-8 name or by its code point.
+				const uint32_t uCodePoint = pElement->Attribute( "Code" ) != nullptr ? pElement->UnsignedAttribute( "Code" ) : _GetCodePoint( pElement, "Name" );
+
+				BitmapGlyph oGlyph;
+				oGlyph.m_fTop				= pElement->FloatAttribute( "Top" );
+				oGlyph.m_fLeft				= pElement->FloatAttribute( "Left" );
+				oGlyph.m_fWidth				= pElement->FloatAttribute( "Width" );
+				oGlyph.m_fHeight			= pElement->FloatAttribute( "Height" );
+				oGlyph.m_bLowerCharacter	= pElement->BoolAttribute( "Lower" );
+
+				_AddGlyph( uCodePoint, oGlyph );
 			}
+			else if( sElement == "Kerning" )
+			{
+				const uint32_t uFirst = _GetCodePoint( pElement, "First" );
+				const uint32_t uSecond = _GetCodePoint( pElement, "Second" );
 
-			oGlyph.m_fTop				= pCharacter->FloatAttribute( "Top" );
-			oGlyph.m_fLeft				= pCharacter->FloatAttribute( "Left" );
-			oGlyph.m_fWidth				= pCharacter->FloatAttribute( "Width" );
-			oGlyph.m_fHeight			= pCharacter->FloatAttribute( "Height" );
-			oGlyph.m_bLowerCharacter	= pCharacter->BoolAttribute( "Lower" );
+				if( uFirst > MaxCodePoint || uSecond > MaxCodePoint )
+					continue;
 
-			m_oGlyphs[ cCharacter ] = oGlyph;
+				KerningPair oPair;
+				oPair.m_uPair	= ( (uint64_t)uFirst << 32 ) | uSecond;
+				oPair.m_fAmount	= pElement->FloatAttribute( "Amount" );
 
-			pCharacter = pCharacter->NextSiblingElement();
+				m_oKerningPairs.push_back( oPair );
+			}
 		}
+
+		std::stable_sort( m_oKerningPairs.begin(), m_oKerningPairs.end(), []( const KerningPair& _oPairA, const KerningPair& _oPairB ) { return _oPairA.m_uPair < _oPairB.m_uPair; } );
+
+		if( m_oGlyphIndices.size() > '_' && m_oGlyphIndices[ '_' ] != NoGlyph )
+			m_uFallbackGlyph = m_oGlyphIndices[ '_' ];
+		else if( m_oGlyphIndices.size() > ' ' )
+			m_uFallbackGlyph = m_oGlyphIndices[ ' ' ];
 	}
 
 	sf::Texture* BitmapFont::GetTexture() const
 	{
+		if( m_pAtlas != nullptr )
+			return m_pAtlas;
+
 		return m_pTexture;
 	}
 
-	const BitmapGlyph* BitmapFont::GetGlyph( const char& _cCharacter ) const
+	const BitmapGlyph* BitmapFont::GetGlyph( uint32_t _uCodePoint ) const
 	{
-		std::unordered_map< char, BitmapGlyph >::const_iterator it = m_oGlyphs.find( _cCharacter );
+		if( _uCodePoint >= m_oGlyphIndices.size() || m_oGlyphIndices[ _uCodePoint ] == NoGlyph )
+			return nullptr;
+
+		return &m_oGlyphs[ m_oGlyphIndices[ _uCodePoint ] ];
+	}
+
+	const BitmapGlyph* BitmapFont::GetCustomGlyph( const std::string& _sName, const std::string& _sTag )
+	{
+		for( const PackedGlyph& oPackedGlyph : m_oCustomGlyphs )
+		{
+			if( oPackedGlyph.m_sName == _sName && oPackedGlyph.m_sTag == _sTag )
+				return &oPackedGlyph.m_oGlyph;
+		}
+
+		const CustomBitmapGlyph* pCustomGlyph = g_pFZN_DataMgr->GetBitmapGlyph( _sName, _sTag );
+
+		if( pCustomGlyph == nullptr || pCustomGlyph->m_pTexture == nullptr )
+			return nullptr;
+
+		PackedGlyph oPackedGlyph;
+		oPackedGlyph.m_sName	= _sName;
+		oPackedGlyph.m_sTag		= _sTag;
+
+		if( _PackCustomGlyph( *pCustomGlyph, oPackedGlyph.m_oGlyph ) == false )
+			return nullptr;
+
+		m_oCustomGlyphs.push_back( oPackedGlyph );
+		return &m_oCustomGlyphs.back().m_oGlyph;
+	}
+
+	void BitmapFont::OnTextureReloaded( const sf::Texture* _pTexture )
+	{
+		if( m_pAtlas == nullptr || _pTexture == nullptr )
+			return;
 
-		if( it != m_oGlyphs.end() )
+		bool bUsedByAtlas = _pTexture == m_pTexture;
+
+		for( const PackedGlyph& oPackedGlyph : m_oCustomGlyphs )
 		{
-			return &it->second;
+			if( bUsedByAtlas )
+				break;
+
+			const CustomBitmapGlyph* pCustomGlyph = g_pFZN_DataMgr->GetBitmapGlyph( oPackedGlyph.m_sName, oPackedGlyph.m_sTag, false );
+			bUsedByAtlas = pCustomGlyph != nullptr && pCustomGlyph->m_pTexture == _pTexture;
 		}
 
-		return nullptr;
+		if( bUsedByAtlas )
+			_RebuildAtlas();
+	}
+
+	const BitmapGlyph* BitmapFont::GetFallbackGlyph() const
+	{
+		if( m_uFallbackGlyph == NoGlyph )
+			return nullptr;
+
+		return &m_oGlyphs[ m_uFallbackGlyph ];
 	}
 
 	float BitmapFont::GetKerning() const
@@ -103,6 +184,20 @@ namespace fzn
 		return m_fKerning;
 	}
 
+	float BitmapFont::GetKerning( uint32_t _uFirst, uint32_t _uSecond ) const
+	{
+		if( m_oKerningPairs.empty() )
+			return 0.f;
+
+		const uint64_t uPair = ( (uint64_t)_uFirst << 32 ) | _uSecond;
+		std::vector< KerningPair >::const_iterator it = std::lower_bound( m_oKerningPairs.begin(), m_oKerningPairs.end(), uPair, []( const KerningPair& _oPair, uint64_t _uPair ) { return _oPair.m_uPair < _uPair; } );
+
+		if( it != m_oKerningPairs.end() && it->m_uPair == uPair )
+			return it->m_fAmount;
+
+		return 0.f;
+	}
+
 	float BitmapFont::GetCharacterMinHeight() const
 	{
 		return m_fCharacterMinHeight;
@@ -123,4 +218,142 @@ namespace fzn
 		return m_fCustomGlyphsOffset;
 	}
 
+	uint32_t BitmapFont::GetVersion() const
+	{
+		return m_uVersion;
+	}
+
+	void BitmapFont::_AddGlyph( uint32_t _uCodePoint, const BitmapGlyph& _oGlyph )
+	{
+		if( _uCodePoint > MaxCodePoint )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Character U+%X out of the supported range.", _uCodePoint );
+			return;
+		}
+
+		if( _uCodePoint >= m_oGlyphIndices.size() )
+			m_oGlyphIndices.resize( _uCodePoint + 1, NoGlyph );
+
+		if( m_oGlyphIndices[ _uCodePoint ] != NoGlyph || m_oGlyphs.size() >= NoGlyph )
+			return;
+
+		m_oGlyphIndices[ _uCodePoint ] = (uint16_t)m_oGlyphs.size();
+		m_oGlyphs.push_back( _oGlyph );
+	}
+
+	uint32_t BitmapFont::_GetCodePoint( const tinyxml2::XMLElement* _pElement, const char* _sAttribute )
+	{
+		const std::string sCharacter = Tools::XMLStringAttribute( _pElement, _sAttribute );
+
+		if( sCharacter.empty() )
+			return Uint32_Max;
+
+		size_t uPosition = 0;
+		return Tools::decode_utf8( sCharacter, uPosition );
+	}
+
+	bool BitmapFont::_PackCustomGlyph( const CustomBitmapGlyph& _oCustomGlyph, BitmapGlyph& _oPackedGlyph )
+	{
+		if( m_pTexture == nullptr )
+			return false;
+
+		//The atlas starts as a copy of the font texture, the custom glyphs are then packed on shelves under it.
+		if( m_pAtlas == nullptr )
+			_ResetAtlasImage();
+
+		if( _PlaceCustomGlyph( _oCustomGlyph, _oPackedGlyph ) == false )
+			return false;
+
+		return _UploadAtlas();
+	}
+
+	void BitmapFont::_ResetAtlasImage()
+	{
+		m_oAtlasImage		= m_pTexture->copyToImage();
+		m_vShelfPosition	= { 0, m_oAtlasImage.getSize().y + AtlasPadding };
+		m_uShelfHeight		= 0;
+	}
+
+	bool BitmapFont::_PlaceCustomGlyph( const CustomBitmapGlyph& _oCustomGlyph, BitmapGlyph& _oPackedGlyph )
+	{
+		const sf::IntRect oSourceRect( (int)_oCustomGlyph.m_oGlyph.m_fLeft, (int)_oCustomGlyph.m_oGlyph.m_fTop, (int)_oCustomGlyph.m_oGlyph.m_fWidth, (int)_oCustomGlyph.m_oGlyph.m_fHeight );
+		const sf::Vector2u vGlyphSize( (unsigned)oSourceRect.width + AtlasPadding, (unsigned)oSourceRect.height + AtlasPadding );
+
+		if( m_vShelfPosition.x > 0 && m_vShelfPosition.x + vGlyphSize.x > m_oAtlasImage.getSize().x )
+		{
+			m_vShelfPosition = { 0, m_vShelfPosition.y + m_uShelfHeight };
+			m_uShelfHeight = 0;
+		}
+
+		const sf::Vector2u vCurrentSize = m_oAtlasImage.getSize();
+		const sf::Vector2u vNewSize( Math::Max( vCurrentSize.x, m_vShelfPosition.x + vGlyphSize.x ), Math::Max( vCurrentSize.y, m_vShelfPosition.y + vGlyphSize.y ) );
+
+		if( vNewSize.x > sf::Texture::getMaximumSize() || vNewSize.y > sf::Texture::getMaximumSize() )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Not enough room in the font atlas for the custom glyph \"%s\".", _oCustomGlyph.m_sName.c_str() );
+			return false;
+		}
+
+		if( vNewSize != vCurrentSize )
+		{
+			sf::Image oGrownImage;
+			oGrownImage.create( vNewSize.x, vNewSize.y, sf::Color::Transparent );
+			oGrownImage.copy( m_oAtlasImage, 0, 0 );
+			m_oAtlasImage = oGrownImage;
+		}
+
+		m_oAtlasImage.copy( _oCustomGlyph.m_pTexture->copyToImage(), m_vShelfPosition.x, m_vShelfPosition.y, oSourceRect );
+
+		_oPackedGlyph			= _oCustomGlyph.m_oGlyph;
+		_oPackedGlyph.m_fLeft	= (float)m_vShelfPosition.x;
+		_oPackedGlyph.m_fTop	= (float)m_vShelfPosition.y;
+
+		m_vShelfPosition.x += vGlyphSize.x;
+		m_uShelfHeight = Math::Max( m_uShelfHeight, vGlyphSize.y );
+
+		return true;
+	}
+
+	bool BitmapFont::_UploadAtlas()
+	{
+		if( m_pAtlas == nullptr )
+			m_pAtlas = new sf::Texture;
+
+		if( m_pAtlas->loadFromImage( m_oAtlasImage ) == false )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't update the font atlas." );
+			_ClearAtlas();
+			return false;
+		}
+
+		m_pAtlas->setSmooth( m_pTexture->isSmooth() );
+		return true;
+	}
+
+	void BitmapFont::_RebuildAtlas()
+	{
+		_ResetAtlasImage();
+
+		//The glyphs are repacked in place, the texts keep pointers on them.
+		for( PackedGlyph& oPackedGlyph : m_oCustomGlyphs )
+		{
+			const CustomBitmapGlyph* pCustomGlyph = g_pFZN_DataMgr->GetBitmapGlyph( oPackedGlyph.m_sName, oPackedGlyph.m_sTag, false );
+
+			if( pCustomGlyph == nullptr || pCustomGlyph->m_pTexture == nullptr || _PlaceCustomGlyph( *pCustomGlyph, oPackedGlyph.m_oGlyph ) == false )
+				oPackedGlyph.m_oGlyph = BitmapGlyph();
+		}
+
+		_UploadAtlas();
+		++m_uVersion;
+	}
+
+	void BitmapFont::_ClearAtlas()
+	{
+		CheckNullptrDelete( m_pAtlas );
+
+		m_oAtlasImage		= sf::Image();
+		m_vShelfPosition	= { 0, 0 };
+		m_uShelfHeight		= 0;
+		m_oCustomGlyphs.clear();
+	}
 }
@@ -1,35 +1,110 @@
 #pragma once
 
+#include <deque>
 #include <string>
-#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include "FZN/Defines.h"
 
+namespace tinyxml2 { class XMLElement; }
+
 namespace fzn
 {
+	//Glyphs are indexed by code point (Basic Multilingual Plane), the characters names in the font file being UTF-8.
 	class FZN_EXPORT BitmapFont
 	{
 	public:
+		static constexpr uint32_t	MaxCodePoint{ 0xFFFF };
+
 		BitmapFont();
 		~BitmapFont();
 
 		void						LoadFromFile( const std::string& _sPath );
 
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the texture containing all the glyphs, the custom ones included once they have been packed
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		sf::Texture*				GetTexture() const;
-		const BitmapGlyph*			GetGlyph( const char& _cCharacter ) const;
+		const BitmapGlyph*			GetGlyph( uint32_t _uCodePoint ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on a custom glyph (icon) of the DataManager, packed in the font atlas on its first use so a text can be drawn in a single draw call
+		//Parameter 1 : Name of the custom glyph
+		//Parameter 2 : Tag of the custom glyph
+		//Return value : Glyph with its coordinates in the atlas, nullptr if it doesn't exist or couldn't be packed
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		const BitmapGlyph*			GetCustomGlyph( const std::string& _sName, const std::string& _sTag );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Rebuilds the atlas if the reloaded texture is the font one or the one of a packed custom glyph, the atlas being a copy of them
+		//Parameter : Texture reloaded by the DataManager
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						OnTextureReloaded( const sf::Texture* _pTexture );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the glyph used for the characters missing in the font ('_' or ' ')
+		//Return value : Fallback glyph, nullptr if the font has none of them
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		const BitmapGlyph*			GetFallbackGlyph() const;
 		float						GetKerning() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Kerning of a pair of characters, added to the global kerning between them
+		//Parameter 1 : Code point of the first character
+		//Parameter 2 : Code point of the second character
+		//Return value : Horizontal adjustment, 0 if the pair isn't in the font
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		float						GetKerning( uint32_t _uFirst, uint32_t _uSecond ) const;
 		float						GetCharacterMinHeight() const;
 		float						GetCharacterSmallHeight() const;
 		float						GetVerticalSpacing() const;
 		float						GetCustomGlyphsOffset() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Incremented each time the font is loaded or its atlas rebuilt, so the texts using it know their layout is outdated
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		uint32_t					GetVersion() const;
 
 	protected:
-		sf::Texture*					m_pTexture;
-		std::unordered_map< char, BitmapGlyph >	m_oGlyphs;
-		float							m_fKerning;
-		float							m_fCharacterMinHeight;
-		float							m_fCharacterSmallHeight;
-		float							m_fVerticalSpacing;
-		float							m_fCustomGlyphsOffset;
+		static constexpr uint16_t	NoGlyph{ 0xFFFF };
+
+		static constexpr unsigned	AtlasPadding{ 1 };		//Space around the custom glyphs to avoid bleeding
+
+		struct KerningPair
+		{
+			uint64_t				m_uPair{ 0 };			//First code point in the high bits, second in the low bits
+			float					m_fAmount{ 0.f };
+		};
+
+		struct PackedGlyph
+		{
+			std::string				m_sName;
+			std::string				m_sTag;
+			BitmapGlyph				m_oGlyph;				//Coordinates in the atlas
+		};
+
+		void						_AddGlyph( uint32_t _uCodePoint, const BitmapGlyph& _oGlyph );
+		static uint32_t				_GetCodePoint( const tinyxml2::XMLElement* _pElement, const char* _sAttribute );
+		bool						_PackCustomGlyph( const CustomBitmapGlyph& _oCustomGlyph, BitmapGlyph& _oPackedGlyph );
+		void						_ResetAtlasImage();
+		bool						_PlaceCustomGlyph( const CustomBitmapGlyph& _oCustomGlyph, BitmapGlyph& _oPackedGlyph );
+		bool						_UploadAtlas();
+		void						_RebuildAtlas();
+		void						_ClearAtlas();
+
+		sf::Texture*				m_pTexture;
+		sf::Texture*				m_pAtlas;				//Font texture followed by the packed custom glyphs, nullptr until a custom glyph is used
+		sf::Image					m_oAtlasImage;
+		sf::Vector2u				m_vShelfPosition;		//Where the next custom glyph will be packed
+		unsigned					m_uShelfHeight;
+		std::deque< PackedGlyph >	m_oCustomGlyphs;		//Deque so the returned glyphs stay valid when new ones are packed
+		std::vector< BitmapGlyph >	m_oGlyphs;
+		std::vector< uint16_t >		m_oGlyphIndices;		//Index in m_oGlyphs of each code point, NoGlyph if missing
+		std::vector< KerningPair >	m_oKerningPairs;		//Sorted by pair
+		uint16_t					m_uFallbackGlyph;
+		float						m_fKerning;
+		float						m_fCharacterMinHeight;
+		float						m_fCharacterSmallHeight;
+		float						m_fVerticalSpacing;
+		float						m_fCustomGlyphsOffset;
+		uint32_t					m_uVersion;
 	};
 } // namespace fzn
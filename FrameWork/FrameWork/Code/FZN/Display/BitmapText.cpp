@@ -1,16 +1,20 @@
 #include "FZN/Includes.h"
 
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
 #include "FZN/Display/BitmapFont.h"
 #include "FZN/Display/BitmapText.h"
-#include "FZN/Managers/DataManager.h"
 
 
 namespace fzn
 {
 	BitmapText::BitmapText()
 		: m_pFont( nullptr )
+		, m_uFontVersion( 0 )
 		, m_sText( "" )
-		, m_oVertices( sf::PrimitiveType::Quads, 4 )
+		, m_oVertices( sf::PrimitiveType::Quads, 0 )
 		, m_eAnchor( Anchor::eTopLeft )
 		, m_eAlignment( Alignment::eLeft )
 		, m_vBounds( 0.f, 0.f )
@@ -26,182 +30,70 @@ namespace fzn
 
 	void BitmapText::SetFont( BitmapFont* _pFont )
 	{
+		if( m_pFont == _pFont )
+			return;
+
 		m_pFont = _pFont;
+		m_oLines.clear();
+
+		if( m_pFont == nullptr || m_sText.empty() )
+			return;
+
+		std::string sText;
+		sText.swap( m_sText );
+		SetText( sText );
+	}
+
+	BitmapFont* BitmapText::GetFont() const
+	{
+		return m_pFont;
 	}
 
 	void BitmapText::SetText( const std::string& _sText )
 	{
-		if( m_pFont == nullptr || m_sText == _sText )
+		if( m_pFont == nullptr )
 			return;
 
-		const int iTextLength = _sText.length();
-
-		if( m_sText.length() != iTextLength )
-			m_oVertices.resize( iTextLength * 4 );
+		if( m_uFontVersion != m_pFont->GetVersion() )
+		{
+			m_oLines.clear();
+			m_uFontVersion = m_pFont->GetVersion();
+		}
+		else if( m_sText == _sText && m_oLines.empty() == false )
+			return;
 
 		m_sText = _sText;
-		m_vBounds = { 0.f, 0.f };
-		m_oLinesWidths.clear();
-		m_oBitmapGlyphs.clear();
 
-		float fX = 0.f;
-		float fY = 0.f;
-		int iNewLine = 0;
-		int iVertex = 0;
-		float fMaxHeight = 0.f;
-		float fCurrentHeight = 0.f;
-		const float fMinHeight = m_pFont->GetCharacterMinHeight();
-		const float fSmallHeight = m_pFont->GetCharacterSmallHeight();
-		const float fVerticalSpacing = m_pFont->GetVerticalSpacing();
-		const float fCustomGlyphsOffset = m_pFont->GetCustomGlyphsOffset();
-
-		m_oLinesWidths.push_back( std::pair< int, float >( 0, 0.f ) );
+		size_t uLine = 0;
+		size_t uLineStart = 0;
 
-		int iChar = 0;
-		while( iChar < (int)m_sText.size() )
+		while( uLineStart <= m_sText.size() )
 		{
-			const BitmapGlyph* pGlyph = nullptr;
-			bool bIsCustomGlyph = false;
-
-			if( m_sText[ iChar ] == '%' && ( iChar + 1 ) < (int)m_sText.size() && m_sText[ iChar + 1 ] == '%' )
-			{
-				int iGlyphEnd = m_sText.find( "%%", iChar + 2 );
-				std::string sGlyphName = m_sText.substr( iChar + 2, iGlyphEnd - ( iChar + 2 ) );
-				int iCharOffset = sGlyphName.length() + 4;
-
-				int iComma = sGlyphName.find( "," );
-				std::string sTag = "";
-
-				if( iComma >= 0 )
-				{
-					sTag = sGlyphName.substr( iComma + 1 );
-					sGlyphName = sGlyphName.substr( 0, iComma );
-				}
-
-				CustomBitmapGlyph* pCustomGlyph = g_pFZN_DataMgr->GetBitmapGlyph( sGlyphName, sTag );
-
-				if( pCustomGlyph != nullptr && pCustomGlyph->m_pTexture != nullptr )
-				{
-					pGlyph = &pCustomGlyph->m_oGlyph;
-					m_oBitmapGlyphs.push_back( std::pair< int, sf::Texture* >( iVertex, pCustomGlyph->m_pTexture ) );
-
-					iChar += iCharOffset;
-					bIsCustomGlyph = true;
-				}
-				else
-				{
-					m_sText.erase( iChar, iCharOffset );
-
-					if( sGlyphName.empty() == false )
-						m_sText.insert( iChar, "[" + sGlyphName + "]" );
-
-					continue;
-				}
-
-			}
-			else
-			{
-				if( m_sText[ iChar ] == '\n' )
-				{
-					++iNewLine;
-					iVertex += 4;
-					fX = 0.f;
-
-					if( fMaxHeight == 0.f )
-						fCurrentHeight += fMinHeight;
-					else
-						fCurrentHeight += fMaxHeight;
-
-					fMaxHeight = 0.f;
-
-					if( m_oLinesWidths.back().second == 0.f )
-						m_oLinesWidths.back().first = iVertex;
-					else
-						m_oLinesWidths.push_back( std::pair< int, float >( iVertex, 0.f ) );
-
-					++iChar;
-					continue;
-				}
-
-				pGlyph = m_pFont->GetGlyph( m_sText[ iChar ] );
-
-				if( pGlyph == nullptr )
-				{
-					pGlyph = m_pFont->GetGlyph( '_' );
+			size_t uLineEnd = m_sText.find( '\n', uLineStart );
 
-					if( pGlyph == nullptr )
-					{
-						pGlyph = m_pFont->GetGlyph( ' ' );
+			if( uLineEnd == std::string::npos )
+				uLineEnd = m_sText.size();
 
-						if( pGlyph == nullptr )
-						{
-							++iChar;
-							continue;
-						}
-					}
-				}
+			const std::string_view sLine( m_sText.data() + uLineStart, uLineEnd - uLineStart );
+			const bool bNewLine = uLine >= m_oLines.size();
 
-				++iChar;
-			}
+			if( bNewLine )
+				m_oLines.emplace_back();
 
-			if( bIsCustomGlyph )
-			{
-				fY = fCustomGlyphsOffset - pGlyph->m_fHeight * 0.5f;
-			}
-			else
-			{
-				if( pGlyph->m_bLowerCharacter )
-					fY = fMinHeight - fSmallHeight;
-				else if( pGlyph->m_fHeight < fMinHeight )
-					fY = fMinHeight - pGlyph->m_fHeight;
-				else
-					fY = 0.f;
-			}
-
-			fY += iNewLine * fVerticalSpacing + fCurrentHeight;
+			Line& oLine = m_oLines[ uLine ];
 
-			m_oVertices[ iVertex + 0 ].position = { fX,						fY };
-			m_oVertices[ iVertex + 1 ].position = { fX + pGlyph->m_fWidth,	fY };
-			m_oVertices[ iVertex + 2 ].position = { fX + pGlyph->m_fWidth,	fY + pGlyph->m_fHeight };
-			m_oVertices[ iVertex + 3 ].position = { fX,						fY + pGlyph->m_fHeight };
-
-			m_oVertices[ iVertex + 0 ].texCoords = { pGlyph->m_fLeft,						pGlyph->m_fTop };
-			m_oVertices[ iVertex + 1 ].texCoords = { pGlyph->m_fLeft + pGlyph->m_fWidth,	pGlyph->m_fTop };
-			m_oVertices[ iVertex + 2 ].texCoords = { pGlyph->m_fLeft + pGlyph->m_fWidth,	pGlyph->m_fTop + pGlyph->m_fHeight };
-			m_oVertices[ iVertex + 3 ].texCoords = { pGlyph->m_fLeft,						pGlyph->m_fTop + pGlyph->m_fHeight };
-
-			if( bIsCustomGlyph == false || m_bColorGlyphs )
-			{
-				m_oVertices[ iVertex + 0 ].color = m_oColor;
-				m_oVertices[ iVertex + 1 ].color = m_oColor;
-				m_oVertices[ iVertex + 2 ].color = m_oColor;
-				m_oVertices[ iVertex + 3 ].color = m_oColor;
-			}
-			else
+			if( bNewLine || oLine.m_sText != sLine )
 			{
-				m_oVertices[ iVertex + 0 ].color = sf::Color::White;
-				m_oVertices[ iVertex + 1 ].color = sf::Color::White;
-				m_oVertices[ iVertex + 2 ].color = sf::Color::White;
-				m_oVertices[ iVertex + 3 ].color = sf::Color::White;
+				oLine.m_sText = sLine;
+				_BuildLine( oLine );
 			}
 
-			fX += pGlyph->m_fWidth + m_pFont->GetKerning();
-
-			m_oLinesWidths.back().second = fX;
-
-			if( pGlyph->m_bLowerCharacter == false )
-				InfThenAffect( fMaxHeight, pGlyph->m_fHeight );
-
-			InfThenAffect( m_vBounds.x, fX );
-			InfThenAffect( m_vBounds.y, iNewLine * fVerticalSpacing + fCurrentHeight + fMaxHeight );
-
-			iVertex += 4;
+			++uLine;
+			uLineStart = uLineEnd + 1;
 		}
 
-		if( iVertex < (int)m_oVertices.getVertexCount() )
-			m_oVertices.resize( iVertex );
-
-		m_oVertices.resize( m_oVertices.getVertexCount() - iNewLine * 4 );
+		m_oLines.resize( uLine );
+		_AssembleLines();
 	}
 
 	std::string BitmapText::GetText() const
@@ -211,14 +103,27 @@ namespace fzn
 
 	void BitmapText::FormatText( const char* _message, ... )
 	{
-		const int iLength = 2048;
-		char sMessage[ iLength ];
 		va_list args;
 		va_start( args, _message );
 
-		vsprintf_s( sMessage, iLength - 1, _message, args );
+		va_list argsCopy;
+		va_copy( argsCopy, args );
+		const int iLength = vsnprintf( nullptr, 0, _message, argsCopy );
+		va_end( argsCopy );
 
-		SetText( sMessage );
+		if( iLength < 0 )
+		{
+			va_end( args );
+			return;
+		}
+
+		//The buffer is kept between calls so formatting the same kind of text every frame doesn't allocate.
+		m_sFormatBuffer.resize( iLength + 1 );
+		vsnprintf( &m_sFormatBuffer[ 0 ], iLength + 1, _message, args );
+		m_sFormatBuffer.resize( iLength );
+		va_end( args );
+
+		SetText( m_sFormatBuffer );
 	}
 
 	void BitmapText::SetAnchorAndAlignment( const Anchor& _eAnchor, const Alignment& _eAlignment )
@@ -226,24 +131,24 @@ namespace fzn
 		if( _eAnchor >= Anchor::eNbAnchors || _eAlignment >= Alignment::eNbAlignments )
 			return;
 
+		if( m_eAnchor == _eAnchor && m_eAlignment == _eAlignment )
+			return;
+
 		m_eAnchor = _eAnchor;
 		m_eAlignment = _eAlignment;
+
+		if( m_pFont != nullptr )
+			_AssembleLines();
 	}
 
 	void BitmapText::SetAnchor( const Anchor& _eAnchor )
 	{
-		if( _eAnchor >= Anchor::eNbAnchors )
-			return;
-
-		m_eAnchor = _eAnchor;
+		SetAnchorAndAlignment( _eAnchor, m_eAlignment );
 	}
 
 	void BitmapText::SetAlignment( const Alignment& _eAlignment )
 	{
-		if( _eAlignment >= Alignment::eNbAlignments )
-			return;
-
-		m_eAlignment = _eAlignment;
+		SetAnchorAndAlignment( m_eAnchor, _eAlignment );
 	}
 
 	void BitmapText::SetVisible( bool _bVisible )
@@ -263,7 +168,7 @@ namespace fzn
 		int iBitmapGlyph = 0;
 		for( unsigned int iVertex = 0; iVertex < m_oVertices.getVertexCount(); )
 		{
-			if( iBitmapGlyph < (int)m_oBitmapGlyphs.size() && iVertex == m_oBitmapGlyphs[ iBitmapGlyph ].first )
+			if( m_bColorGlyphs == false && iBitmapGlyph < (int)m_oBitmapGlyphs.size() && iVertex == m_oBitmapGlyphs[ iBitmapGlyph ] )
 			{
 				++iBitmapGlyph;
 
@@ -296,14 +201,29 @@ namespace fzn
 
 	void BitmapText::SetColorGlyphs( bool _bColor )
 	{
+		if( m_bColorGlyphs == _bColor )
+			return;
+
 		m_bColorGlyphs = _bColor;
+
+		if( m_pFont != nullptr )
+			_AssembleLines();
 	}
 
 	sf::FloatRect BitmapText::GetBounds() const
 	{
+		_RefreshLayout();
+
 		return sf::FloatRect( getPosition().x, getPosition().y, m_vBounds.x, m_vBounds.y );
 	}
 
+	const sf::VertexArray& BitmapText::GetVertices() const
+	{
+		_RefreshLayout();
+
+		return m_oVertices;
+	}
+
 	/*		eTopLeft,
 			eTopCenter,
 			eTopRight,
@@ -376,62 +296,16 @@ namespace fzn
 
 	void BitmapText::draw( sf::RenderTarget& _oTarget, sf::RenderStates _oStates ) const
 	{
+		_RefreshLayout();
+
 		if( m_pFont == nullptr || m_oVertices.getVertexCount() == 0 || m_bVisible == false )
 			return;
 
+		//The custom glyphs are packed in the font atlas and the alignment is already applied, so the whole text is a single draw call.
 		_oStates.transform *= getTransform();
-
 		_oStates.texture = m_pFont->GetTexture();
 
-		sf::Vector2f vAnchorOffset = _GetAnchorOffset();
-
-		sf::VertexArray oAlignedVertices( m_oVertices );
-		int iNextLine = 0;
-		int iBitmapGlyph = 0;
-		sf::Vector2f vAlignmentOffset = vAnchorOffset;
-
-		for( unsigned int iVertex = 0; iVertex < oAlignedVertices.getVertexCount(); iVertex += 4 )
-		{
-			// New line.
-			if( iNextLine < (int)m_oLinesWidths.size() && iVertex == m_oLinesWidths[ iNextLine ].first )
-			{
-				vAlignmentOffset = _GetLineAlignmentOffset( vAnchorOffset, m_oLinesWidths[ iNextLine ].second );
-				++iNextLine;
-			}
-
-			oAlignedVertices[ iVertex + 0 ].position -= vAlignmentOffset;
-			oAlignedVertices[ iVertex + 1 ].position -= vAlignmentOffset;
-			oAlignedVertices[ iVertex + 2 ].position -= vAlignmentOffset;
-			oAlignedVertices[ iVertex + 3 ].position -= vAlignmentOffset;
-
-			if( iBitmapGlyph < (int)m_oBitmapGlyphs.size() && iVertex == m_oBitmapGlyphs[ iBitmapGlyph ].first )
-			{
-				sf::RenderStates oStates = _oStates;
-				oStates.texture = m_oBitmapGlyphs[ iBitmapGlyph ].second;
-
-				++iBitmapGlyph;
-
-				sf::VertexArray oGlyphVerices( sf::PrimitiveType::Quads, 4 );
-
-				oGlyphVerices[ 0 ] = oAlignedVertices[ iVertex + 0 ];
-				oGlyphVerices[ 1 ] = oAlignedVertices[ iVertex + 1 ];
-				oGlyphVerices[ 2 ] = oAlignedVertices[ iVertex + 2 ];
-				oGlyphVerices[ 3 ] = oAlignedVertices[ iVertex + 3 ];
-
-				oAlignedVertices[ iVertex + 0 ].texCoords = { 0.f, 0.f };
-				oAlignedVertices[ iVertex + 1 ].texCoords = { 0.f, 0.f };
-				oAlignedVertices[ iVertex + 2 ].texCoords = { 0.f, 0.f };
-				oAlignedVertices[ iVertex + 3 ].texCoords = { 0.f, 0.f };
-
-				if( oStates.texture != nullptr )
-				{
-					_oTarget.draw( oGlyphVerices, oStates );
-					continue;
-				}
-			}
-		}
-
-		_oTarget.draw( oAlignedVertices, _oStates );
+		_oTarget.draw( m_oVertices, _oStates );
 	}
 
 	sf::Vector2f BitmapText::_GetAnchorOffset() const
@@ -485,4 +359,187 @@ namespace fzn
 
 		return _vCurrentOffset - sf::Vector2f( m_vBounds.x - _fLineWidth, 0.f );
 	}
+
+	void BitmapText::_BuildLine( Line& _oLine ) const
+	{
+		_oLine.m_oQuads.clear();
+		_oLine.m_oCustomGlyphs.clear();
+		_oLine.m_fWidth = 0.f;
+		_oLine.m_fHeight = 0.f;
+
+		const std::string& sText = _oLine.m_sText;
+		const float fMinHeight = m_pFont->GetCharacterMinHeight();
+		const float fSmallHeight = m_pFont->GetCharacterSmallHeight();
+		const float fCustomGlyphsOffset = m_pFont->GetCustomGlyphsOffset();
+		const float fKerning = m_pFont->GetKerning();
+
+		float fX = 0.f;
+		uint32_t uPreviousCodePoint = Uint32_Max;
+
+		auto AddQuad = [&]( const BitmapGlyph& _oGlyph, float _fY )
+		{
+			_oLine.m_oQuads.push_back( sf::Vertex( { fX,						_fY },						{ _oGlyph.m_fLeft,						_oGlyph.m_fTop } ) );
+			_oLine.m_oQuads.push_back( sf::Vertex( { fX + _oGlyph.m_fWidth,	_fY },						{ _oGlyph.m_fLeft + _oGlyph.m_fWidth,	_oGlyph.m_fTop } ) );
+			_oLine.m_oQuads.push_back( sf::Vertex( { fX + _oGlyph.m_fWidth,	_fY + _oGlyph.m_fHeight },	{ _oGlyph.m_fLeft + _oGlyph.m_fWidth,	_oGlyph.m_fTop + _oGlyph.m_fHeight } ) );
+			_oLine.m_oQuads.push_back( sf::Vertex( { fX,						_fY + _oGlyph.m_fHeight },	{ _oGlyph.m_fLeft,						_oGlyph.m_fTop + _oGlyph.m_fHeight } ) );
+
+			fX += _oGlyph.m_fWidth + fKerning;
+			_oLine.m_fWidth = fX;
+
+			if( _oGlyph.m_bLowerCharacter == false )
+				InfThenAffect( _oLine.m_fHeight, _oGlyph.m_fHeight );
+		};
+
+		auto AddCharacter = [&]( uint32_t _uCodePoint )
+		{
+			const BitmapGlyph* pGlyph = m_pFont->GetGlyph( _uCodePoint );
+
+			if( pGlyph == nullptr )
+				pGlyph = m_pFont->GetFallbackGlyph();
+
+			if( pGlyph == nullptr )
+				return;
+
+			if( uPreviousCodePoint != Uint32_Max )
+				fX += m_pFont->GetKerning( uPreviousCodePoint, _uCodePoint );
+
+			float fY = 0.f;
+
+			if( pGlyph->m_bLowerCharacter )
+				fY = fMinHeight - fSmallHeight;
+			else if( pGlyph->m_fHeight < fMinHeight )
+				fY = fMinHeight - pGlyph->m_fHeight;
+
+			AddQuad( *pGlyph, fY );
+			uPreviousCodePoint = _uCodePoint;
+		};
+
+		size_t uChar = 0;
+		while( uChar < sText.size() )
+		{
+			if( sText.compare( uChar, 2, "%%" ) == 0 )
+			{
+				const size_t uGlyphEnd = sText.find( "%%", uChar + 2 );
+
+				if( uGlyphEnd != std::string::npos )
+				{
+					std::string sGlyphName = sText.substr( uChar + 2, uGlyphEnd - ( uChar + 2 ) );
+					std::string sTag = "";
+
+					const size_t uComma = sGlyphName.find( ',' );
+
+					if( uComma != std::string::npos )
+					{
+						sTag = sGlyphName.substr( uComma + 1 );
+						sGlyphName = sGlyphName.substr( 0, uComma );
+					}
+
+					uChar = uGlyphEnd + 2;
+
+					const BitmapGlyph* pCustomGlyph = m_pFont->GetCustomGlyph( sGlyphName, sTag );
+
+					if( pCustomGlyph != nullptr )
+					{
+						_oLine.m_oCustomGlyphs.push_back( (int)_oLine.m_oQuads.size() );
+						AddQuad( *pCustomGlyph, fCustomGlyphsOffset - pCustomGlyph->m_fHeight * 0.5f );
+						uPreviousCodePoint = Uint32_Max;
+					}
+					else if( sGlyphName.empty() == false )
+					{
+						//Unknown glyphs are displayed by name so they can be spotted and fixed.
+						const std::string sMissingGlyph = "[" + sGlyphName + "]";
+
+						for( size_t uMissingChar = 0; uMissingChar < sMissingGlyph.size(); )
+							AddCharacter( Tools::decode_utf8( sMissingGlyph, uMissingChar ) );
+					}
+
+					continue;
+				}
+			}
+
+			AddCharacter( Tools::decode_utf8( sText, uChar ) );
+		}
+	}
+
+	void BitmapText::_AssembleLines() const
+	{
+		size_t uNbVertices = 0;
+		m_vBounds = { 0.f, 0.f };
+
+		const float fMinHeight = m_pFont->GetCharacterMinHeight();
+		const float fVerticalSpacing = m_pFont->GetVerticalSpacing();
+		float fCurrentHeight = 0.f;
+
+		//The bounds are needed by the anchor, so they're computed before placing the vertices.
+		for( int iLine = 0; iLine < (int)m_oLines.size(); ++iLine )
+		{
+			const Line& oLine = m_oLines[ iLine ];
+			const float fLineTop = iLine * fVerticalSpacing + fCurrentHeight;
+
+			fCurrentHeight += oLine.m_fHeight == 0.f ? fMinHeight : oLine.m_fHeight;
+
+			if( oLine.m_oQuads.empty() )
+				continue;
+
+			uNbVertices += oLine.m_oQuads.size();
+			InfThenAffect( m_vBounds.x, oLine.m_fWidth );
+			InfThenAffect( m_vBounds.y, fLineTop + oLine.m_fHeight );
+		}
+
+		m_oVertices.resize( uNbVertices );
+		m_oBitmapGlyphs.clear();
+
+		const sf::Vector2f vAnchorOffset = _GetAnchorOffset();
+		const sf::Color oGlyphsColor = m_bColorGlyphs ? m_oColor : sf::Color::White;
+
+		int iVertex = 0;
+		fCurrentHeight = 0.f;
+
+		for( int iLine = 0; iLine < (int)m_oLines.size(); ++iLine )
+		{
+			const Line& oLine = m_oLines[ iLine ];
+			const float fLineTop = iLine * fVerticalSpacing + fCurrentHeight;
+
+			fCurrentHeight += oLine.m_fHeight == 0.f ? fMinHeight : oLine.m_fHeight;
+
+			if( oLine.m_oQuads.empty() )
+				continue;
+
+			const sf::Vector2f vOffset = sf::Vector2f( 0.f, fLineTop ) - _GetLineAlignmentOffset( vAnchorOffset, oLine.m_fWidth );
+
+			int iCustomGlyph = 0;
+			for( int iQuadVertex = 0; iQuadVertex < (int)oLine.m_oQuads.size(); iQuadVertex += 4 )
+			{
+				sf::Color oColor = m_oColor;
+
+				if( iCustomGlyph < (int)oLine.m_oCustomGlyphs.size() && iQuadVertex == oLine.m_oCustomGlyphs[ iCustomGlyph ] )
+				{
+					m_oBitmapGlyphs.push_back( iVertex );
+					oColor = oGlyphsColor;
+					++iCustomGlyph;
+				}
+
+				for( int iCorner = 0; iCorner < 4; ++iCorner )
+				{
+					sf::Vertex& oVertex = m_oVertices[ iVertex++ ];
+					oVertex = oLine.m_oQuads[ iQuadVertex + iCorner ];
+					oVertex.position += vOffset;
+					oVertex.color = oColor;
+				}
+			}
+		}
+	}
+
+	void BitmapText::_RefreshLayout() const
+	{
+		if( m_pFont == nullptr || m_uFontVersion == m_pFont->GetVersion() )
+			return;
+
+		m_uFontVersion = m_pFont->GetVersion();
+
+		for( Line& oLine : m_oLines )
+			_BuildLine( oLine );
+
+		_AssembleLines();
+	}
 }
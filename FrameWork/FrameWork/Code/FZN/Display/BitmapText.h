@@ -44,6 +44,11 @@ namespace fzn
 		~BitmapText();
 
 		void					SetFont( BitmapFont* _pFont );
+		BitmapFont*				GetFont() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Sets the UTF-8 text to display, only the lines that changed since the previous text are laid out again
+		//Parameter : Text, custom glyphs being written %%Name%% or %%Name,Tag%%
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void					SetText( const std::string& _sText );
 		std::string				GetText() const;
 		void					FormatText( const char* _message, ... );
@@ -54,27 +59,58 @@ namespace fzn
 		bool					IsVisible() const;
 		void					SetColor( const sf::Color& _oColor );
 		sf::Color				GetColor() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Changes the color of a single displayed glyph
+		//Parameter 1 : Color
+		//Parameter 2 : Index of the glyph, line breaks excluded
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void					ColorLetter( const sf::Color& _oColor, int _iLetterIndex );
 		void					SetColorGlyphs( bool _bColor );
 		sf::FloatRect			GetBounds() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the vertices of the text, anchor and alignment applied, in local coordinates
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		const sf::VertexArray&	GetVertices() const;
 
 		static Anchor			GetAnchorFromString( const std::string& _rAnchor );
 		static std::string		GetAnchorFromString( Anchor _eAnchor );
 
 	protected:
+		//Layout of a line of text, kept between two SetText so the unchanged lines don't have to be laid out again.
+		struct Line
+		{
+			std::string					m_sText;			//Text of the line, without the line break
+			std::vector< sf::Vertex >	m_oQuads;			//4 vertices per glyph, positioned from the top left of the line
+			std::vector< int >			m_oCustomGlyphs;	//First vertex in m_oQuads of each custom glyph
+			float						m_fWidth{ 0.f };
+			float						m_fHeight{ 0.f };	//Height of the tallest glyph that isn't a lower character
+		};
+
 		virtual void			draw( sf::RenderTarget& _oTarget, sf::RenderStates _oStates) const;
 
 		sf::Vector2f			_GetAnchorOffset() const;
 		sf::Vector2f			_GetLineAlignmentOffset( const sf::Vector2f& _vCurrentOffset, float _fLineWidth ) const;
+		void					_BuildLine( Line& _oLine ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Gathers the quads of all the lines in the vertex array, placing the lines under each other and applying the anchor and the alignment
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void					_AssembleLines() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Lays all the lines out again if the font changed since the last layout (hot reload), before the vertices or the bounds are used
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void					_RefreshLayout() const;
 
+		//The layout is mutable so a text whose font has been reloaded is laid out again when it is drawn.
 		BitmapFont*				m_pFont;
+		mutable uint32_t		m_uFontVersion;		//Version of the font when the lines were laid out
 		std::string				m_sText;
-		sf::VertexArray			m_oVertices;
-		std::vector< std::pair< int, sf::Texture* > > m_oBitmapGlyphs;
+		std::string				m_sFormatBuffer;
+		mutable std::vector< Line >	m_oLines;
+		mutable sf::VertexArray	m_oVertices;
+		mutable std::vector< int >	m_oBitmapGlyphs;		//First vertex of each custom glyph
 		Anchor					m_eAnchor;
 		Alignment				m_eAlignment;
-		sf::Vector2f			m_vBounds;
-		std::vector< std::pair< int, float > >	m_oLinesWidths;
+		mutable sf::Vector2f	m_vBounds;
 		bool					m_bVisible;
 		sf::Color				m_oColor;
 		bool					m_bColorGlyphs;
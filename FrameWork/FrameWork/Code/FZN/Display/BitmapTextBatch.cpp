@@ -0,0 +1,75 @@
+#include "FZN/Includes.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include "FZN/Display/BitmapFont.h"
+#include "FZN/Display/BitmapText.h"
+#include "FZN/Display/BitmapTextBatch.h"
+
+
+namespace fzn
+{
+	BitmapTextBatch::BitmapTextBatch( BitmapFont* _pFont /*= nullptr*/ )
+		: m_pFont( _pFont )
+	{
+	}
+
+	BitmapTextBatch::~BitmapTextBatch()
+	{
+	}
+
+	void BitmapTextBatch::SetFont( BitmapFont* _pFont )
+	{
+		m_pFont = _pFont;
+		m_oVertices.clear();
+	}
+
+	BitmapFont* BitmapTextBatch::GetFont() const
+	{
+		return m_pFont;
+	}
+
+	void BitmapTextBatch::Clear()
+	{
+		m_oVertices.clear();
+	}
+
+	bool BitmapTextBatch::Add( const BitmapText& _oText )
+	{
+		if( m_pFont == nullptr || _oText.GetFont() != m_pFont )
+			return false;
+
+		if( _oText.IsVisible() == false )
+			return true;
+
+		const sf::VertexArray& oVertices = _oText.GetVertices();
+		const sf::Transform& oTransform = _oText.getTransform();
+		const size_t uFirstVertex = m_oVertices.size();
+
+		m_oVertices.resize( uFirstVertex + oVertices.getVertexCount() );
+
+		for( size_t uVertex = 0; uVertex < oVertices.getVertexCount(); ++uVertex )
+		{
+			sf::Vertex& oVertex = m_oVertices[ uFirstVertex + uVertex ];
+			oVertex = oVertices[ uVertex ];
+			oVertex.position = oTransform.transformPoint( oVertex.position );
+		}
+
+		return true;
+	}
+
+	size_t BitmapTextBatch::GetVertexCount() const
+	{
+		return m_oVertices.size();
+	}
+
+	void BitmapTextBatch::draw( sf::RenderTarget& _oTarget, sf::RenderStates _oStates ) const
+	{
+		if( m_pFont == nullptr || m_oVertices.empty() )
+			return;
+
+		_oStates.texture = m_pFont->GetTexture();
+
+		_oTarget.draw( m_oVertices.data(), m_oVertices.size(), sf::PrimitiveType::Quads, _oStates );
+	}
+}
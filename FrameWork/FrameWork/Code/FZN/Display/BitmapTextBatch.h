@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include "FZN/Defines.h"
+
+namespace fzn
+{
+	class BitmapFont;
+	class BitmapText;
+
+	//Gathers the vertices of many texts sharing a font to draw them all in a single draw call.
+	//The batch is meant to be cleared and filled every frame, its buffer being kept between frames.
+	class FZN_EXPORT BitmapTextBatch : public sf::Drawable
+	{
+	public:
+		BitmapTextBatch( BitmapFont* _pFont = nullptr );
+		~BitmapTextBatch();
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Changes the font of the batch, removing the texts already added
+		//Parameter : Font shared by all the texts of the batch
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void					SetFont( BitmapFont* _pFont );
+		BitmapFont*				GetFont() const;
+
+		void					Clear();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds the vertices of a text to the batch, its transform applied
+		//Parameter : Text to add, ignored if it's hidden
+		//Return value : The text has been added (true) or it doesn't use the batch font (false)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool					Add( const BitmapText& _oText );
+		size_t					GetVertexCount() const;
+
+	protected:
+		virtual void			draw( sf::RenderTarget& _oTarget, sf::RenderStates _oStates ) const;
+
+		BitmapFont*				m_pFont;
+		std::vector< sf::Vertex >	m_oVertices;
+	};
+} // namespace fzn
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------
+/// Author : Philippe OFFERMANN
+/// Date : 19.10.26
+/// Description : Typed values shared by the nodes of a flat behavior tree
+//------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "FZN/Includes.h"
+#include "FZN/Game/BehaviorTree/BTBlackboard.h"
+
+
+namespace fzn
+{
+	//=========================================================
+	///==================BTBLACKBOARDLAYOUT=====================
+	//=========================================================
+
+	//-------------------------------------------------------------------------------------------------
+	/// Finds a key from its name.
+	/// @param	_sName	: Name of the key.
+	/// @return	Index of the key (InvalidKey if not found).
+	//-------------------------------------------------------------------------------------------------
+	uint32_t BTBlackboardLayout::GetKey( std::string_view _sName ) const
+	{
+		const auto* pKey = m_oKeysByHash.Find( Tools::hash_string( _sName ) );
+
+		if( pKey == nullptr || m_oKeys[ pKey->data ].m_sName != _sName )
+			return InvalidKey;
+
+		return pKey->data;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Gets the type of a key.
+	/// @param	_uKey	: Index of the key.
+	/// @return	Type of the key (COUNT if the key doesn't exist).
+	//-------------------------------------------------------------------------------------------------
+	BTBlackboardType BTBlackboardLayout::GetType( uint32_t _uKey ) const
+	{
+		if( _uKey >= m_oKeys.size() )
+			return BTBlackboardType::COUNT;
+
+		return m_oKeys[ _uKey ].m_eType;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Gets the name of a key.
+	/// @param	_uKey	: Index of the key.
+	/// @return	Name of the key (empty if the key doesn't exist).
+	//-------------------------------------------------------------------------------------------------
+	std::string_view BTBlackboardLayout::GetName( uint32_t _uKey ) const
+	{
+		if( _uKey >= m_oKeys.size() )
+			return {};
+
+		return m_oKeys[ _uKey ].m_sName;
+	}
+
+	uint32_t BTBlackboardLayout::_AddKey( std::string_view _sName, BTBlackboardType _eType )
+	{
+		const uint32_t uHash = Tools::hash_string( _sName );
+
+		if( const auto* pKey = m_oKeysByHash.Find( uHash ) )
+		{
+			const Key& oKey = m_oKeys[ pKey->data ];
+
+			if( oKey.m_sName != _sName )
+			{
+				FZN_COLOR_LOG( DBG_MSG_COL_RED, "Blackboard key \"%.*s\" has the same hash as \"%s\", rename one of them.", (int)_sName.size(), _sName.data(), oKey.m_sName.c_str() );
+				return InvalidKey;
+			}
+
+			if( oKey.m_eType != _eType )
+			{
+				FZN_COLOR_LOG( DBG_MSG_COL_RED, "Blackboard key \"%s\" already exists with another type.", oKey.m_sName.c_str() );
+				return InvalidKey;
+			}
+
+			return pKey->data;
+		}
+
+		const uint32_t uKey = (uint32_t)m_oKeys.size();
+		m_oKeys.push_back( { std::string( _sName ), _eType } );
+		m_oKeysByHash.Insert( uHash, uKey );
+
+		return uKey;
+	}
+
+
+	//=========================================================
+	///======================BTBLACKBOARD=======================
+	//=========================================================
+
+	//-------------------------------------------------------------------------------------------------
+	/// Constructor.
+	/// @param [in]	_pLayout	: Keys of the blackboard, must stay alive as long as the blackboard.
+	//-------------------------------------------------------------------------------------------------
+	BTBlackboard::BTBlackboard( const BTBlackboardLayout* _pLayout /*= nullptr*/ )
+	: m_pLayout( _pLayout )
+	{
+		if( m_pLayout != nullptr )
+			m_oValues.assign( m_pLayout->GetKeysNumber(), 0 );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Sets all the values to zero.
+	//-------------------------------------------------------------------------------------------------
+	void BTBlackboard::Clear()
+	{
+		std::fill( m_oValues.begin(), m_oValues.end(), 0 );
+	}
+
+	bool BTBlackboard::_IsValidKey( uint32_t _uKey, BTBlackboardType _eType ) const
+	{
+		if( _uKey >= m_oValues.size() )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Blackboard key %u doesn't exist.", _uKey );
+			return false;
+		}
+
+		if( m_pLayout->GetType( _uKey ) != _eType )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Blackboard key \"%s\" isn't accessed with its type.", m_pLayout->GetName( _uKey ).data() );
+			return false;
+		}
+
+		return true;
+	}
+} //namespace fzn
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------
+/// Author : Philippe OFFERMANN
+/// Date : 19.10.26
+/// Description : Typed values shared by the nodes of a flat behavior tree
+//------------------------------------------------------------------------
+
+#ifndef _BTBLACKBOARD_H_
+#define _BTBLACKBOARD_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "FZN/Defines.h"
+#include "FZN/DataStructure/HashMap.h"
+#include "FZN/Tools/Logging.h"
+#include "FZN/Tools/Tools.h"
+
+#pragma warning( push )
+#pragma warning( disable: 4251 )
+
+namespace fzn
+{
+	enum class BTBlackboardType : uint8_t
+	{
+		Bool,
+		Int,
+		Float,
+		Vector2f,
+		Pointer,
+		COUNT,
+	};
+
+	template< typename T > struct BTBlackboardTypeOf;
+	template<> struct BTBlackboardTypeOf< bool >			{ static constexpr BTBlackboardType Value{ BTBlackboardType::Bool }; };
+	template<> struct BTBlackboardTypeOf< int >				{ static constexpr BTBlackboardType Value{ BTBlackboardType::Int }; };
+	template<> struct BTBlackboardTypeOf< float >			{ static constexpr BTBlackboardType Value{ BTBlackboardType::Float }; };
+	template<> struct BTBlackboardTypeOf< sf::Vector2f >	{ static constexpr BTBlackboardType Value{ BTBlackboardType::Vector2f }; };
+	template<> struct BTBlackboardTypeOf< void* >			{ static constexpr BTBlackboardType Value{ BTBlackboardType::Pointer }; };
+
+
+	//=========================================================
+	///==================BTBLACKBOARDLAYOUT=====================
+	//=========================================================
+
+	//-------------------------------------------------------------------------------------------------
+	/// Names and types of the keys of a blackboard, shared by all the agents using the same tree.
+	/// The keys are identified by their index, the names only being used to find them when setting up the agents.
+	//-------------------------------------------------------------------------------------------------
+	class FZN_EXPORT BTBlackboardLayout
+	{
+	public :
+		static constexpr uint32_t InvalidKey{ UINT32_MAX };
+
+		//-------------------------------------------------------------------------------------------------
+		/// Adds a key to the layout, or gets the existing one if it has the same type.
+		/// @param	_sName	: Name of the key.
+		/// @return	Index of the key (InvalidKey if the name is already used by a key of another type).
+		//-------------------------------------------------------------------------------------------------
+		template< typename T >
+		uint32_t AddKey( std::string_view _sName )
+		{
+			return _AddKey( _sName, BTBlackboardTypeOf< T >::Value );
+		}
+
+		//-------------------------------------------------------------------------------------------------
+		/// Finds a key from its name.
+		/// @param	_sName	: Name of the key.
+		/// @return	Index of the key (InvalidKey if not found).
+		//-------------------------------------------------------------------------------------------------
+		uint32_t GetKey( std::string_view _sName ) const;
+		//-------------------------------------------------------------------------------------------------
+		/// Gets the type of a key.
+		/// @param	_uKey	: Index of the key.
+		/// @return	Type of the key (COUNT if the key doesn't exist).
+		//-------------------------------------------------------------------------------------------------
+		BTBlackboardType GetType( uint32_t _uKey ) const;
+		//-------------------------------------------------------------------------------------------------
+		/// Gets the name of a key.
+		/// @param	_uKey	: Index of the key.
+		/// @return	Name of the key (empty if the key doesn't exist).
+		//-------------------------------------------------------------------------------------------------
+		std::string_view GetName( uint32_t _uKey ) const;
+		//-------------------------------------------------------------------------------------------------
+		/// Gets the number of keys.
+		/// @return	Number of keys.
+		//-------------------------------------------------------------------------------------------------
+		uint32_t GetKeysNumber() const { return (uint32_t)m_oKeys.size(); }
+
+	private :
+		struct Key
+		{
+			std::string			m_sName;
+			BTBlackboardType	m_eType{ BTBlackboardType::COUNT };
+		};
+
+		uint32_t _AddKey( std::string_view _sName, BTBlackboardType _eType );
+
+		std::vector< Key >				m_oKeys;
+		HashMap< uint32_t, uint32_t >	m_oKeysByHash;		//Index of the keys by hash of their name
+	};
+
+
+	//=========================================================
+	///======================BTBLACKBOARD=======================
+	//=========================================================
+
+	//-------------------------------------------------------------------------------------------------
+	/// Values of the keys of a layout for one agent.
+	/// Each value takes 8 bytes, so the whole blackboard is one small contiguous block.
+	//-------------------------------------------------------------------------------------------------
+	class FZN_EXPORT BTBlackboard
+	{
+	public :
+		//-------------------------------------------------------------------------------------------------
+		/// Constructor.
+		/// @param [in]	_pLayout	: Keys of the blackboard, must stay alive as long as the blackboard.
+		//-------------------------------------------------------------------------------------------------
+		BTBlackboard( const BTBlackboardLayout* _pLayout = nullptr );
+
+		//-------------------------------------------------------------------------------------------------
+		/// Sets all the values to zero.
+		//-------------------------------------------------------------------------------------------------
+		void Clear();
+
+		//-------------------------------------------------------------------------------------------------
+		/// Gets the value of a key.
+		/// @param	_uKey	: Index of the key in the layout.
+		/// @return	Value of the key (default value if the key doesn't exist or doesn't have this type).
+		//-------------------------------------------------------------------------------------------------
+		template< typename T >
+		T Get( uint32_t _uKey ) const
+		{
+			if( _IsValidKey( _uKey, BTBlackboardTypeOf< T >::Value ) == false )
+				return T{};
+
+			T oValue;
+			memcpy( &oValue, &m_oValues[ _uKey ], sizeof( T ) );
+			return oValue;
+		}
+
+		//-------------------------------------------------------------------------------------------------
+		/// Sets the value of a key.
+		/// @param	_uKey	: Index of the key in the layout.
+		/// @param	_oValue	: New value.
+		//-------------------------------------------------------------------------------------------------
+		template< typename T >
+		void Set( uint32_t _uKey, const T& _oValue )
+		{
+			static_assert( sizeof( T ) <= sizeof( uint64_t ) && std::is_trivially_copyable_v< T >, "Blackboard values have to fit in 8 bytes and be trivially copyable." );
+
+			if( _IsValidKey( _uKey, BTBlackboardTypeOf< T >::Value ) == false )
+				return;
+
+			memcpy( &m_oValues[ _uKey ], &_oValue, sizeof( T ) );
+		}
+
+		//-------------------------------------------------------------------------------------------------
+		/// Gets the value of a key from its name, slower than using its index.
+		/// @param	_sName	: Name of the key.
+		/// @return	Value of the key (default value if the key doesn't exist or doesn't have this type).
+		//-------------------------------------------------------------------------------------------------
+		template< typename T >
+		T Get( std::string_view _sName ) const
+		{
+			return Get< T >( m_pLayout != nullptr ? m_pLayout->GetKey( _sName ) : BTBlackboardLayout::InvalidKey );
+		}
+
+		//-------------------------------------------------------------------------------------------------
+		/// Sets the value of a key from its name, slower than using its index.
+		/// @param	_sName	: Name of the key.
+		/// @param	_oValue	: New value.
+		//-------------------------------------------------------------------------------------------------
+		template< typename T >
+		void Set( std::string_view _sName, const T& _oValue )
+		{
+			Set< T >( m_pLayout != nullptr ? m_pLayout->GetKey( _sName ) : BTBlackboardLayout::InvalidKey, _oValue );
+		}
+
+		const BTBlackboardLayout* GetLayout() const { return m_pLayout; }
+
+	private :
+		bool _IsValidKey( uint32_t _uKey, BTBlackboardType _eType ) const;
+
+		const BTBlackboardLayout*	m_pLayout;
+		std::vector< uint64_t >		m_oValues;
+	};
+} //namespace fzn
+
+#pragma warning( pop )
+
+#endif //_BTBLACKBOARD_H_
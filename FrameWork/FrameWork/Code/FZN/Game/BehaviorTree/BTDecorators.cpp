@@ -41,21 +41,21 @@ namespace fzn
 	}
 
 
-	void Timer::SetTimeLimit( DWORD _seconds )
+	void Timer::SetTimeLimit( float _seconds )
 	{
-		m_maxTime = _seconds * 1000;
+		m_maxTime = (uint64_t)( _seconds * 1000000000.0 );
 	}
 
 	void Timer::OnInitialize()
 	{
-		m_initialTime = GetTickCount();
+		m_initialTime = g_pFZN_Core->GetTimeService().GetTime( TimeDomain::AI );
 	}
 
 	BTElement::State Timer::Update()
 	{
 		for( ;;)
 		{
-			m_currentTime = GetTickCount();
+			m_currentTime = g_pFZN_Core->GetTimeService().GetTime( TimeDomain::AI );
 
 			if( m_currentTime - m_initialTime >= m_maxTime )
 				return State::Success;
@@ -75,21 +75,21 @@ namespace fzn
 	}
 
 
-	void Delayer::SetTargetTime( DWORD _seconds )
+	void Delayer::SetTargetTime( float _seconds )
 	{
-		m_targetTime = _seconds * 1000;
+		m_targetTime = (uint64_t)( _seconds * 1000000000.0 );
 	}
 
 	void Delayer::OnInitialize()
 	{
-		m_initialTime = GetTickCount();
+		m_initialTime = g_pFZN_Core->GetTimeService().GetTime( TimeDomain::AI );
 	}
 
 	BTElement::State Delayer::Update()
 	{
 		for( ;;)
 		{
-			m_currentTime = GetTickCount();
+			m_currentTime = g_pFZN_Core->GetTimeService().GetTime( TimeDomain::AI );
 
 			if( m_currentTime - m_initialTime >= m_targetTime )
 			{
@@ -58,10 +58,10 @@ namespace fzn
 		virtual ~Timer(){}
 
 		//-------------------------------------------------------------------------------------------------
-		/// Sets time limit.
+		/// Sets time limit, measured in the AI time domain.
 		/// @param	_seconds	The seconds.
 		//-------------------------------------------------------------------------------------------------
-		void SetTimeLimit(DWORD _seconds);
+		void SetTimeLimit(float _seconds);
 
 		//-------------------------------------------------------------------------------------------------
 		/// Executes the initialize action.
@@ -74,9 +74,9 @@ namespace fzn
 		State Update();
 
 	protected :
-		DWORD m_initialTime;
-		DWORD m_currentTime;
-		DWORD m_maxTime;
+		uint64_t m_initialTime;		//Nanoseconds
+		uint64_t m_currentTime;
+		uint64_t m_maxTime;
 	};
 
 	class FZN_EXPORT Delayer : public Decorator
@@ -93,10 +93,10 @@ namespace fzn
 		virtual ~Delayer(){}
 
 		//-------------------------------------------------------------------------------------------------
-		/// Sets target time.
+		/// Sets target time, measured in the AI time domain.
 		/// @param	_seconds	The seconds.
 		//-------------------------------------------------------------------------------------------------
-		void SetTargetTime(DWORD _seconds);
+		void SetTargetTime(float _seconds);
 
 		//-------------------------------------------------------------------------------------------------
 		/// Executes the initialize action.
@@ -109,9 +109,9 @@ namespace fzn
 		State Update();
 
 	protected:
-		DWORD m_initialTime;
-		DWORD m_currentTime;
-		DWORD m_targetTime;
+		uint64_t m_initialTime;		//Nanoseconds
+		uint64_t m_currentTime;
+		uint64_t m_targetTime;
 	};
 
 	class FZN_EXPORT Reverse : public Decorator
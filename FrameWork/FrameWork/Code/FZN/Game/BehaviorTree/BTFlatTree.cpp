@@ -0,0 +1,545 @@
+//------------------------------------------------------------------------
+/// Author : Philippe OFFERMANN
+/// Date : 19.10.26
+/// Description : Behavior tree stored in a flat node array shared by all the agents using it
+//------------------------------------------------------------------------
+
+#include "FZN/Includes.h"
+#include "FZN/Game/BehaviorTree/BTFlatTree.h"
+
+
+namespace fzn
+{
+	//=========================================================
+	///=======================BTFLATTREE========================
+	//=========================================================
+
+	BTFlatTree::BTFlatTree()
+	: m_uMemorySize( 0 )
+	, m_bBuilt( false )
+	{
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Opens a composite node, its children being the nodes added until the call to EndNode.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTree::AddSequence()
+	{
+		_AddNode( NodeType::Sequence, true, true );
+	}
+
+	void BTFlatTree::AddSelector()
+	{
+		_AddNode( NodeType::Selector, true, true );
+	}
+
+	void BTFlatTree::AddRandomSelector()
+	{
+		_AddNode( NodeType::RandomSelector, true, true );
+	}
+
+	void BTFlatTree::AddLoop()
+	{
+		_AddNode( NodeType::Loop, true, true );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Opens a decorator node, its child being the node added before the call to EndNode.
+	/// @param	_iCount		: Number of times the child has to succeed (0 or less to repeat it forever, once per tick).
+	/// @param	_fSeconds	: Time limit of the Timer, or delay of the Delayer.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTree::AddRepeat( int _iCount )
+	{
+		if( Node* pNode = _AddNode( NodeType::Repeat, true, true ) )
+			pNode->m_iCount = _iCount;
+	}
+
+	void BTFlatTree::AddTimer( float _fSeconds )
+	{
+		if( Node* pNode = _AddNode( NodeType::Timer, true, true ) )
+			pNode->m_fSeconds = _fSeconds;
+	}
+
+	void BTFlatTree::AddDelayer( float _fSeconds )
+	{
+		if( Node* pNode = _AddNode( NodeType::Delayer, true, true ) )
+			pNode->m_fSeconds = _fSeconds;
+	}
+
+	void BTFlatTree::AddReverse()
+	{
+		_AddNode( NodeType::Reverse, true, false );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Closes the last opened composite or decorator node.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTree::EndNode()
+	{
+		if( m_bBuilt || m_oOpenedNodes.empty() )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "No behavior tree node to end." );
+			return;
+		}
+
+		m_oNodes[ m_oOpenedNodes.back() ].m_uEnd = (uint32_t)m_oNodes.size();
+		m_oOpenedNodes.pop_back();
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Adds an action leaf.
+	/// @param	_pUpdate	: Function called each tick while the action is running.
+	/// @param	_pAbort		: Function called if the action is interrupted while running (optional).
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTree::AddAction( BTActionFct _pUpdate, BTAbortFct _pAbort /*= nullptr*/ )
+	{
+		if( _pUpdate == nullptr )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Behavior tree action without update function." );
+			return;
+		}
+
+		if( Node* pNode = _AddNode( NodeType::Action, false, false ) )
+		{
+			pNode->m_uFunction = (uint32_t)m_oActions.size();
+			m_oActions.push_back( { _pUpdate, _pAbort } );
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Adds a condition leaf.
+	/// @param	_pCondition	: Function telling if the condition succeeds.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTree::AddCondition( BTConditionFct _pCondition )
+	{
+		if( _pCondition == nullptr )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Behavior tree condition without function." );
+			return;
+		}
+
+		if( Node* pNode = _AddNode( NodeType::Condition, false, false ) )
+		{
+			pNode->m_uFunction = (uint32_t)m_oConditions.size();
+			m_oConditions.push_back( _pCondition );
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Checks the added nodes can be executed and allows the instances to use the tree.
+	/// @return	True if the tree is valid.
+	//-------------------------------------------------------------------------------------------------
+	bool BTFlatTree::Build()
+	{
+		if( m_bBuilt )
+			return true;
+
+		if( m_oNodes.empty() )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Empty behavior tree." );
+			return false;
+		}
+
+		if( m_oOpenedNodes.empty() == false )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "%u behavior tree node(s) not ended.", (uint32_t)m_oOpenedNodes.size() );
+			return false;
+		}
+
+		if( m_oNodes.front().m_uEnd != m_oNodes.size() )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Behavior tree with several roots." );
+			return false;
+		}
+
+		for( uint32_t uNode = 0 ; uNode < m_oNodes.size() ; ++uNode )
+		{
+			const Node& oNode = m_oNodes[ uNode ];
+			uint32_t uNbChildren = 0;
+
+			for( uint32_t uChild = uNode + 1 ; uChild < oNode.m_uEnd ; uChild = m_oNodes[ uChild ].m_uEnd )
+				++uNbChildren;
+
+			if( _IsComposite( oNode.m_eType ) && uNbChildren == 0 )
+			{
+				FZN_COLOR_LOG( DBG_MSG_COL_RED, "Behavior tree composite node %u has no child.", uNode );
+				return false;
+			}
+
+			if( _IsDecorator( oNode.m_eType ) && uNbChildren != 1 )
+			{
+				FZN_COLOR_LOG( DBG_MSG_COL_RED, "Behavior tree decorator node %u has %u children instead of 1.", uNode, uNbChildren );
+				return false;
+			}
+		}
+
+		m_bBuilt = true;
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Removes all the nodes and blackboard keys, the tree mustn't be used by any instance anymore.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTree::Clear()
+	{
+		m_oNodes.clear();
+		m_oActions.clear();
+		m_oConditions.clear();
+		m_oOpenedNodes.clear();
+		m_uMemorySize = 0;
+		m_oBlackboardLayout = BTBlackboardLayout();
+		m_bBuilt = false;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Adds a node at the end of the array.
+	/// @param	_eType		: Type of the node.
+	/// @param	_bOpened	: The node has children and will be closed by EndNode.
+	/// @param	_bMemory	: The node needs to store data in the instances.
+	/// @return	The added node.
+	//-------------------------------------------------------------------------------------------------
+	BTFlatTree::Node* BTFlatTree::_AddNode( NodeType _eType, bool _bOpened, bool _bMemory )
+	{
+		if( m_bBuilt )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Can't add nodes to a built behavior tree." );
+			return nullptr;
+		}
+
+		const uint32_t uNode = (uint32_t)m_oNodes.size();
+		Node& oNode = m_oNodes.emplace_back();
+
+		oNode.m_eType = _eType;
+		oNode.m_uParent = m_oOpenedNodes.empty() ? InvalidNode : m_oOpenedNodes.back();
+		oNode.m_uEnd = uNode + 1;
+		oNode.m_uFunction = 0;
+
+		if( _bMemory )
+			oNode.m_uMemory = m_uMemorySize++;
+
+		if( _bOpened )
+			m_oOpenedNodes.push_back( uNode );
+
+		return &oNode;
+	}
+
+
+	//=========================================================
+	///===================BTFLATTREEINSTANCE====================
+	//=========================================================
+
+	//-------------------------------------------------------------------------------------------------
+	/// Constructor.
+	/// @param [in]	_oTree		: Built tree to execute, must stay alive as long as the instance.
+	/// @param [in]	_pUserData	: Data given to the action and condition functions (the agent).
+	//-------------------------------------------------------------------------------------------------
+	BTFlatTreeInstance::BTFlatTreeInstance( const BTFlatTree& _oTree, void* _pUserData /*= nullptr*/ )
+	: m_pTree( &_oTree )
+	, m_pUserData( _pUserData )
+	, m_oBlackboard( &_oTree.GetBlackboardLayout() )
+	, m_oMemory( _oTree.m_uMemorySize, Memory{ 0 } )
+	, m_uRunningNode( BTFlatTree::InvalidNode )
+	, m_fTime( 0.f )
+	, m_eState( BTElement::State::Invalid )
+	{
+		if( _oTree.IsBuilt() == false )
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Behavior tree instance created from a tree that isn't built." );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Executes the tree until an action is running or the root is terminated.
+	/// @param	_fDeltaTime	: Time elapsed since the last tick, in seconds.
+	/// @return	The state of the root.
+	//-------------------------------------------------------------------------------------------------
+	BTElement::State BTFlatTreeInstance::Tick( float _fDeltaTime )
+	{
+		typedef BTFlatTree::NodeType NodeType;
+		typedef BTElement::State State;
+
+		if( m_pTree->IsBuilt() == false || m_oMemory.size() != m_pTree->m_uMemorySize )
+			return State::Invalid;
+
+		//Enter : the node starts its execution. Execute : the node continues its execution. ChildDone : a child of the node is terminated. Done : the node is terminated or running.
+		enum class Step { Enter, Execute, ChildDone, Done };
+
+		const std::vector< BTFlatTree::Node >& oNodes = m_pTree->m_oNodes;
+		uint32_t uNode = 0;
+		Step eStep = Step::Enter;
+		State eState = State::Invalid;
+
+		m_fTime += _fDeltaTime;
+
+		if( m_uRunningNode != BTFlatTree::InvalidNode )
+		{
+			uNode = m_uRunningNode;
+			eStep = Step::Execute;
+
+			const uint32_t uExpiredTimer = _FindExpiredTimer();
+
+			if( uExpiredTimer != BTFlatTree::InvalidNode )
+			{
+				_AbortRunningNode();
+				uNode = uExpiredTimer;
+				eState = State::Success;
+				eStep = Step::Done;
+			}
+
+			m_uRunningNode = BTFlatTree::InvalidNode;
+		}
+
+		while( true )
+		{
+			const BTFlatTree::Node& oNode = oNodes[ uNode ];
+			Memory* pMemory = oNode.m_uMemory != BTFlatTree::InvalidNode ? &m_oMemory[ oNode.m_uMemory ] : nullptr;
+
+			if( eStep == Step::Enter )
+			{
+				_Enter( uNode );
+				eStep = Step::Execute;
+			}
+
+			if( eStep == Step::Execute )
+			{
+				uint32_t uChild = BTFlatTree::InvalidNode;
+
+				switch( oNode.m_eType )
+				{
+					case NodeType::Sequence:
+					case NodeType::Selector:
+					case NodeType::RandomSelector:
+					case NodeType::Loop:
+						uChild = pMemory->m_uChild;
+						break;
+					case NodeType::Repeat:
+					case NodeType::Reverse:
+						uChild = uNode + 1;
+						break;
+					case NodeType::Timer:
+					{
+						if( m_fTime - pMemory->m_fStartTime >= oNode.m_fSeconds )
+							eState = State::Success;
+						else
+							uChild = uNode + 1;
+						break;
+					}
+					case NodeType::Delayer:
+					{
+						if( m_fTime - pMemory->m_fStartTime >= oNode.m_fSeconds )
+							uChild = uNode + 1;
+						else
+							eState = State::Running;
+						break;
+					}
+					case NodeType::Action:
+						eState = m_pTree->m_oActions[ oNode.m_uFunction ].m_pUpdate( m_pUserData, m_oBlackboard, _fDeltaTime );
+						break;
+					case NodeType::Condition:
+						eState = m_pTree->m_oConditions[ oNode.m_uFunction ]( m_pUserData, m_oBlackboard ) ? State::Success : State::Failure;
+						break;
+				}
+
+				if( uChild != BTFlatTree::InvalidNode )
+				{
+					uNode = uChild;
+					eStep = Step::Enter;
+					continue;
+				}
+
+				eStep = Step::Done;
+			}
+			else if( eStep == Step::ChildDone )
+			{
+				uint32_t uNextChild = BTFlatTree::InvalidNode;
+
+				switch( oNode.m_eType )
+				{
+					case NodeType::Sequence:
+					{
+						if( eState == State::Success )
+						{
+							uNextChild = oNodes[ pMemory->m_uChild ].m_uEnd;
+
+							if( uNextChild >= oNode.m_uEnd )
+								uNextChild = BTFlatTree::InvalidNode;
+						}
+						break;
+					}
+					case NodeType::Selector:
+					{
+						if( eState == State::Failure )
+						{
+							uNextChild = oNodes[ pMemory->m_uChild ].m_uEnd;
+
+							//Same as the Selector class : succeeds when all the children failed.
+							if( uNextChild >= oNode.m_uEnd )
+							{
+								uNextChild = BTFlatTree::InvalidNode;
+								eState = State::Success;
+							}
+						}
+						break;
+					}
+					case NodeType::Loop:
+					{
+						if( eState == State::Failure )
+						{
+							//Starts again from the first child on the next tick.
+							pMemory->m_uChild = uNode + 1;
+							eState = State::Running;
+						}
+						else if( eState == State::Success )
+						{
+							uNextChild = oNodes[ pMemory->m_uChild ].m_uEnd;
+
+							if( uNextChild >= oNode.m_uEnd )
+								uNextChild = BTFlatTree::InvalidNode;
+						}
+						break;
+					}
+					case NodeType::Repeat:
+					{
+						if( eState == State::Success )
+						{
+							if( oNode.m_iCount <= 0 )
+								eState = State::Running;
+							else if( ++pMemory->m_iCount < oNode.m_iCount )
+								uNextChild = uNode + 1;
+						}
+						break;
+					}
+					case NodeType::Reverse:
+					{
+						if( eState == State::Success )
+							eState = State::Failure;
+						else if( eState == State::Failure )
+							eState = State::Success;
+						break;
+					}
+					default:
+						break;
+				}
+
+				if( uNextChild != BTFlatTree::InvalidNode )
+				{
+					if( pMemory != nullptr && oNode.m_eType != NodeType::Repeat )
+						pMemory->m_uChild = uNextChild;
+
+					uNode = uNextChild;
+					eStep = Step::Enter;
+					continue;
+				}
+
+				eStep = Step::Done;
+			}
+
+			//The ancestors of a running node are running too, they will get its result when it is terminated.
+			if( eState == State::Running )
+			{
+				m_uRunningNode = uNode;
+				break;
+			}
+
+			if( oNode.m_uParent == BTFlatTree::InvalidNode )
+				break;
+
+			uNode = oNode.m_uParent;
+			eStep = Step::ChildDone;
+		}
+
+		m_eState = eState;
+		return m_eState;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Interrupts the running action, the next tick starts from the root.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTreeInstance::Abort()
+	{
+		if( m_uRunningNode == BTFlatTree::InvalidNode )
+			return;
+
+		_AbortRunningNode();
+		m_uRunningNode = BTFlatTree::InvalidNode;
+		m_eState = BTElement::State::Aborted;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Initializes the memory of a node starting its execution.
+	/// @param	_uNode	: Index of the node.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTreeInstance::_Enter( uint32_t _uNode )
+	{
+		const BTFlatTree::Node& oNode = m_pTree->m_oNodes[ _uNode ];
+
+		if( oNode.m_uMemory == BTFlatTree::InvalidNode )
+			return;
+
+		Memory& oMemory = m_oMemory[ oNode.m_uMemory ];
+
+		switch( oNode.m_eType )
+		{
+			case BTFlatTree::NodeType::RandomSelector:
+			{
+				uint32_t uNbChildren = 0;
+
+				for( uint32_t uChild = _uNode + 1 ; uChild < oNode.m_uEnd ; uChild = m_pTree->m_oNodes[ uChild ].m_uEnd )
+					++uNbChildren;
+
+				uint32_t uChild = _uNode + 1;
+
+				for( int iChild = Rand( 0, (int)uNbChildren ) ; iChild > 0 ; --iChild )
+					uChild = m_pTree->m_oNodes[ uChild ].m_uEnd;
+
+				oMemory.m_uChild = uChild;
+				break;
+			}
+			case BTFlatTree::NodeType::Repeat:
+				oMemory.m_iCount = 0;
+				break;
+			case BTFlatTree::NodeType::Timer:
+			case BTFlatTree::NodeType::Delayer:
+				oMemory.m_fStartTime = m_fTime;
+				break;
+			default:
+				oMemory.m_uChild = _uNode + 1;
+				break;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Finds the first Timer above the running node whose time limit is reached.
+	/// @return	Index of the Timer (BTFlatTree::InvalidNode if none).
+	//-------------------------------------------------------------------------------------------------
+	uint32_t BTFlatTreeInstance::_FindExpiredTimer() const
+	{
+		const std::vector< BTFlatTree::Node >& oNodes = m_pTree->m_oNodes;
+		uint32_t uExpiredTimer = BTFlatTree::InvalidNode;
+
+		//The Timers are checked from the root when walking the whole tree, so the highest expired one is kept.
+		for( uint32_t uNode = oNodes[ m_uRunningNode ].m_uParent ; uNode != BTFlatTree::InvalidNode ; uNode = oNodes[ uNode ].m_uParent )
+		{
+			const BTFlatTree::Node& oNode = oNodes[ uNode ];
+
+			if( oNode.m_eType == BTFlatTree::NodeType::Timer && m_fTime - m_oMemory[ oNode.m_uMemory ].m_fStartTime >= oNode.m_fSeconds )
+				uExpiredTimer = uNode;
+		}
+
+		return uExpiredTimer;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Calls the abort function of the running node if it is an action.
+	//-------------------------------------------------------------------------------------------------
+	void BTFlatTreeInstance::_AbortRunningNode()
+	{
+		const BTFlatTree::Node& oNode = m_pTree->m_oNodes[ m_uRunningNode ];
+
+		if( oNode.m_eType != BTFlatTree::NodeType::Action )
+			return;
+
+		const BTFlatTree::Action& oAction = m_pTree->m_oActions[ oNode.m_uFunction ];
+
+		if( oAction.m_pAbort != nullptr )
+			oAction.m_pAbort( m_pUserData, m_oBlackboard );
+	}
+} //namespace fzn
@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------
+/// Author : Philippe OFFERMANN
+/// Date : 19.10.26
+/// Description : Behavior tree stored in a flat node array shared by all the agents using it
+//------------------------------------------------------------------------
+
+#ifndef _BTFLATTREE_H_
+#define _BTFLATTREE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "FZN/Defines.h"
+#include "FZN/Game/BehaviorTree/BTBasicElements.h"
+#include "FZN/Game/BehaviorTree/BTBlackboard.h"
+
+#pragma warning( push )
+#pragma warning( disable: 4251 )
+
+namespace fzn
+{
+	//-------------------------------------------------------------------------------------------------
+	/// Function called each tick while an action node is running.
+	/// @param [in]	_pUserData		: Data given to the instance ticking the tree (the agent).
+	/// @param [in]	_oBlackboard	: Blackboard of the instance.
+	/// @param		_fDeltaTime		: Time elapsed since the last tick, in seconds.
+	/// @return	State of the action.
+	//-------------------------------------------------------------------------------------------------
+	typedef BTElement::State ( *BTActionFct )( void* _pUserData, BTBlackboard& _oBlackboard, float _fDeltaTime );
+	//-------------------------------------------------------------------------------------------------
+	/// Function called when a running action is interrupted (by a Timer or BTFlatTreeInstance::Abort).
+	//-------------------------------------------------------------------------------------------------
+	typedef void ( *BTAbortFct )( void* _pUserData, BTBlackboard& _oBlackboard );
+	//-------------------------------------------------------------------------------------------------
+	/// Function evaluated by a condition node, which succeeds if it returns true and fails otherwise.
+	//-------------------------------------------------------------------------------------------------
+	typedef bool ( *BTConditionFct )( void* _pUserData, const BTBlackboard& _oBlackboard );
+
+
+	//=========================================================
+	///=======================BTFLATTREE========================
+	//=========================================================
+
+	//-------------------------------------------------------------------------------------------------
+	/// Definition of a behavior tree, compiled in an array of nodes in depth first order.
+	/// The children of a node directly follow it, and each node knows where its subtree ends, so the tree is walked without any pointer.
+	/// The tree only holds constant data: the state of each agent is in a BTFlatTreeInstance, so one tree can be shared by any number of agents.
+	/// The composites and decorators behave like their BTElement counterparts.
+	///
+	/// The nodes are added in depth first order, a composite or decorator being closed by EndNode once its children have been added:
+	///		oTree.AddSelector();
+	///			oTree.AddSequence();
+	///				oTree.AddCondition( &IsTargetVisible );
+	///				oTree.AddAction( &Attack );
+	///			oTree.EndNode();
+	///			oTree.AddAction( &Patrol );
+	///		oTree.EndNode();
+	///		oTree.Build();
+	//-------------------------------------------------------------------------------------------------
+	class FZN_EXPORT BTFlatTree
+	{
+	public :
+		enum class NodeType : uint8_t
+		{
+			Sequence,
+			Selector,
+			RandomSelector,
+			Loop,
+			Repeat,
+			Timer,
+			Delayer,
+			Reverse,
+			Action,
+			Condition,
+		};
+
+		static constexpr uint32_t InvalidNode{ UINT32_MAX };
+
+		BTFlatTree();
+
+		//-------------------------------------------------------------------------------------------------
+		/// Opens a composite node, its children being the nodes added until the call to EndNode.
+		//-------------------------------------------------------------------------------------------------
+		void AddSequence();
+		void AddSelector();
+		void AddRandomSelector();
+		void AddLoop();
+		//-------------------------------------------------------------------------------------------------
+		/// Opens a decorator node, its child being the node added before the call to EndNode.
+		/// @param	_iCount		: Number of times the child has to succeed (0 or less to repeat it forever, once per tick).
+		/// @param	_fSeconds	: Time limit of the Timer, or delay of the Delayer.
+		//-------------------------------------------------------------------------------------------------
+		void AddRepeat( int _iCount );
+		void AddTimer( float _fSeconds );
+		void AddDelayer( float _fSeconds );
+		void AddReverse();
+		//-------------------------------------------------------------------------------------------------
+		/// Closes the last opened composite or decorator node.
+		//-------------------------------------------------------------------------------------------------
+		void EndNode();
+		//-------------------------------------------------------------------------------------------------
+		/// Adds an action leaf.
+		/// @param	_pUpdate	: Function called each tick while the action is running.
+		/// @param	_pAbort		: Function called if the action is interrupted while running (optional).
+		//-------------------------------------------------------------------------------------------------
+		void AddAction( BTActionFct _pUpdate, BTAbortFct _pAbort = nullptr );
+		//-------------------------------------------------------------------------------------------------
+		/// Adds a condition leaf.
+		/// @param	_pCondition	: Function telling if the condition succeeds.
+		//-------------------------------------------------------------------------------------------------
+		void AddCondition( BTConditionFct _pCondition );
+
+		//-------------------------------------------------------------------------------------------------
+		/// Checks the added nodes can be executed and allows the instances to use the tree.
+		/// @return	True if the tree is valid.
+		//-------------------------------------------------------------------------------------------------
+		bool Build();
+		//-------------------------------------------------------------------------------------------------
+		/// Removes all the nodes and blackboard keys, the tree mustn't be used by any instance anymore.
+		//-------------------------------------------------------------------------------------------------
+		void Clear();
+
+		bool IsBuilt() const { return m_bBuilt; }
+		uint32_t GetNodesNumber() const { return (uint32_t)m_oNodes.size(); }
+		//-------------------------------------------------------------------------------------------------
+		/// Gets the keys of the blackboards of the instances, they have to be added before creating the instances.
+		/// @return	Blackboard layout.
+		//-------------------------------------------------------------------------------------------------
+		BTBlackboardLayout& GetBlackboardLayout() { return m_oBlackboardLayout; }
+		const BTBlackboardLayout& GetBlackboardLayout() const { return m_oBlackboardLayout; }
+
+	private :
+		friend class BTFlatTreeInstance;
+
+		struct Node
+		{
+			NodeType	m_eType{ NodeType::Action };
+			uint32_t	m_uParent{ InvalidNode };
+			uint32_t	m_uEnd{ 0 };						//Index following the last node of the subtree
+			uint32_t	m_uMemory{ InvalidNode };			//Index of the data the node needs in the instances
+			union
+			{
+				int			m_iCount;
+				float		m_fSeconds;
+				uint32_t	m_uFunction;					//Index of the action or condition function
+			};
+		};
+
+		struct Action
+		{
+			BTActionFct	m_pUpdate{ nullptr };
+			BTAbortFct	m_pAbort{ nullptr };
+		};
+
+		//-------------------------------------------------------------------------------------------------
+		/// Adds a node at the end of the array.
+		/// @param	_eType		: Type of the node.
+		/// @param	_bOpened	: The node has children and will be closed by EndNode.
+		/// @param	_bMemory	: The node needs to store data in the instances.
+		/// @return	The added node.
+		//-------------------------------------------------------------------------------------------------
+		Node* _AddNode( NodeType _eType, bool _bOpened, bool _bMemory );
+
+		static bool _IsComposite( NodeType _eType ) { return _eType <= NodeType::Loop; }
+		static bool _IsDecorator( NodeType _eType ) { return _eType >= NodeType::Repeat && _eType <= NodeType::Reverse; }
+
+		std::vector< Node >				m_oNodes;
+		std::vector< Action >			m_oActions;
+		std::vector< BTConditionFct >	m_oConditions;
+		std::vector< uint32_t >			m_oOpenedNodes;			//Nodes waiting for their EndNode
+		uint32_t						m_uMemorySize;			//Number of memory slots needed by an instance
+		BTBlackboardLayout				m_oBlackboardLayout;
+		bool							m_bBuilt;
+	};
+
+
+	//=========================================================
+	///===================BTFLATTREEINSTANCE====================
+	//=========================================================
+
+	//-------------------------------------------------------------------------------------------------
+	/// Execution state of a BTFlatTree for one agent: one 4 bytes slot per node needing memory, and the blackboard.
+	/// A tick resumes from the node left running by the previous one, and its result goes up the tree from there.
+	//-------------------------------------------------------------------------------------------------
+	class FZN_EXPORT BTFlatTreeInstance
+	{
+	public :
+		//-------------------------------------------------------------------------------------------------
+		/// Constructor.
+		/// @param [in]	_oTree		: Built tree to execute, must stay alive as long as the instance.
+		/// @param [in]	_pUserData	: Data given to the action and condition functions (the agent).
+		//-------------------------------------------------------------------------------------------------
+		BTFlatTreeInstance( const BTFlatTree& _oTree, void* _pUserData = nullptr );
+
+		//-------------------------------------------------------------------------------------------------
+		/// Executes the tree until an action is running or the root is terminated.
+		/// @param	_fDeltaTime	: Time elapsed since the last tick, in seconds.
+		/// @return	The state of the root.
+		//-------------------------------------------------------------------------------------------------
+		BTElement::State Tick( float _fDeltaTime );
+		//-------------------------------------------------------------------------------------------------
+		/// Interrupts the running action, the next tick starts from the root.
+		//-------------------------------------------------------------------------------------------------
+		void Abort();
+
+		BTElement::State GetState() const { return m_eState; }
+		bool IsRunning() const { return m_eState == BTElement::State::Running; }
+		//-------------------------------------------------------------------------------------------------
+		/// Gets the node the next tick will resume from.
+		/// @return	Index of the node (BTFlatTree::InvalidNode if the tree isn't running).
+		//-------------------------------------------------------------------------------------------------
+		uint32_t GetRunningNode() const { return m_uRunningNode; }
+		BTBlackboard& GetBlackboard() { return m_oBlackboard; }
+		const BTBlackboard& GetBlackboard() const { return m_oBlackboard; }
+
+	private :
+		union Memory
+		{
+			uint32_t	m_uChild;				//Composites current child
+			int			m_iCount;				//Repeat count
+			float		m_fStartTime;			//Timer and Delayer start time
+		};
+
+		//-------------------------------------------------------------------------------------------------
+		/// Initializes the memory of a node starting its execution.
+		/// @param	_uNode	: Index of the node.
+		//-------------------------------------------------------------------------------------------------
+		void _Enter( uint32_t _uNode );
+		//-------------------------------------------------------------------------------------------------
+		/// Finds the first Timer above the running node whose time limit is reached.
+		/// @return	Index of the Timer (BTFlatTree::InvalidNode if none).
+		//-------------------------------------------------------------------------------------------------
+		uint32_t _FindExpiredTimer() const;
+		//-------------------------------------------------------------------------------------------------
+		/// Calls the abort function of the running node if it is an action.
+		//-------------------------------------------------------------------------------------------------
+		void _AbortRunningNode();
+
+		const BTFlatTree*		m_pTree;
+		void*					m_pUserData;
+		BTBlackboard			m_oBlackboard;
+		std::vector< Memory >	m_oMemory;
+		uint32_t				m_uRunningNode;
+		float					m_fTime;				//Sum of the ticks delta times, used by the Timers and Delayers
+		BTElement::State		m_eState;
+	};
+} //namespace fzn
+
+#pragma warning( pop )
+
+#endif //_BTFLATTREE_H_
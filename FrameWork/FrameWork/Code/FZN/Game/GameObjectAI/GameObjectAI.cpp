@@ -49,4 +49,16 @@ namespace fzn
 	{
 		return m_ID;
 	}
+
+
+	/////////////////OTHER FUNCTIONS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Update called by the AI manager when the GameObject is scheduled (see AIManager::Schedule)
+	//Parameter : Time elapsed since the last scheduled update, in seconds (it depends on the level of detail of the GameObject)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void GameObjectAI::ScheduledUpdate( float /*_fElapsedTime*/ )
+	{
+		Update();
+	}
 } //namespace fzn
@@ -38,6 +38,15 @@ namespace fzn
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		int GetID();
 
+
+		/////////////////OTHER FUNCTIONS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Update called by the AI manager when the GameObject is scheduled (see AIManager::Schedule)
+		//Parameter : Time elapsed since the last scheduled update, in seconds (it depends on the level of detail of the GameObject)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		virtual void ScheduledUpdate( float _fElapsedTime );
+
 	protected:
 		/////////////////MEMBER VARIABLES/////////////////
 
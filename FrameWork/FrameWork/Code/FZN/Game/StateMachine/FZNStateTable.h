@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : State machine whose states are rows of a function table shared by all its instances
+//------------------------------------------------------------------------
+
+#ifndef _FZNSTATETABLE_H_
+#define _FZNSTATETABLE_H_
+
+#include <cstdint>
+
+#include "FZN/Tools/Logging.h"
+
+
+namespace fzn
+{
+	//The states of a type are described once in a table indexed by the enum values, holding their member functions and their parent.
+	//A child state without update or display function uses the one of its closest ancestor, resolved by Build so an update is a single call.
+	//The machines only hold a pointer to the table and their current state, so any number of objects can own one without allocation.
+	template< class T, class EnumState, int StatesNumber = (int)EnumState::COUNT >
+	class FZNStateTable
+	{
+	public:
+		typedef void( T::* TransitionCallBack )( EnumState );		//Receives the previous state on enter, the next one on exit
+		typedef EnumState( T::* UpdateCallBack )();					//Returns the next state (the current one to stay in it)
+		typedef void( T::* DisplayCallBack )();
+
+		static constexpr int InvalidState{ -1 };
+
+		/////////////////STATES DEFINITION/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Defines the functions of a state, the ones left to nullptr do nothing (or are inherited from the parent for update and display)
+		//Parameter 1 : State to define
+		//Parameter 2 to 5 : Enter, exit, update and display functions
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetState( EnumState _eState, TransitionCallBack _pOnEnter = nullptr, TransitionCallBack _pOnExit = nullptr, UpdateCallBack _pOnUpdate = nullptr, DisplayCallBack _pOnDisplay = nullptr );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Places a state under another one: being in the child also means being in the parent, which is entered before and exited after it
+		//Parameter 1 : Child state
+		//Parameter 2 : Parent state
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetParent( EnumState _eState, EnumState _eParent );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Checks the hierarchy and resolves the inherited functions, has to be called before the machines use the table
+		//Return value : The table is valid (true) or the hierarchy has a cycle
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool Build();
+
+		bool IsBuilt() const { return m_bBuilt; }
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the parent of a state
+		//Parameter : Index of the state
+		//Return value : Index of the parent (InvalidState if none)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int GetParent( int _iState ) const { return m_oStates[ _iState ].m_iParent; }
+		int GetDepth( int _iState ) const { return m_oStates[ _iState ].m_iDepth; }
+
+		static bool IsValidState( int _iState ) { return _iState >= 0 && _iState < StatesNumber; }
+
+	private:
+		template< class, class, int > friend class FZNTableStateMachine;
+
+		struct State
+		{
+			TransitionCallBack	m_pEnterFct{ nullptr };
+			TransitionCallBack	m_pExitFct{ nullptr };
+			UpdateCallBack		m_pUpdateFct{ nullptr };			//Own function, or the closest ancestor one once built
+			DisplayCallBack		m_pDisplayFct{ nullptr };
+			int					m_iParent{ InvalidState };
+			int					m_iDepth{ 0 };						//Number of ancestors
+			bool				m_bOwnUpdate{ false };
+			bool				m_bOwnDisplay{ false };
+		};
+
+		State	m_oStates[ StatesNumber ];
+		bool	m_bBuilt{ false };
+	};
+
+
+	//Current state of an object using a FZNStateTable.
+	//A transition requested while another one is running (from an enter or exit function) is queued and done right after it.
+	//The transitions requested with QueueTransition wait for the next update, even when Enter is called in between.
+	template< class T, class EnumState, int StatesNumber = (int)EnumState::COUNT >
+	class FZNTableStateMachine
+	{
+	public:
+		typedef FZNStateTable< T, EnumState, StatesNumber > Table;
+
+		/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Constructor
+		//Parameter 1 : Built table of the states, must stay alive as long as the machine
+		//Parameter 2 : Object the functions are called on
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZNTableStateMachine( const Table& _oTable, T* _pOwner );
+
+
+		/////////////////STATES MANAGEMENT/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Goes to a state, exiting the current states up to the common ancestor and entering the ones down to the new state
+		//Parameter : New state (entering the current state exits and enters it again)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Enter( EnumState _eState );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Requests a transition done at the beginning of the next update (the ones requested during that update wait for the following one)
+		//Parameter : New state
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void QueueTransition( EnumState _eState );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Does the transitions queued before the update, then calls the update function of the current state and goes to the state it returns
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Update();
+		void Display();
+
+
+		/////////////////ACCESSORS / MUTATORS/////////////////
+
+		int GetCurrentStateID() const { return m_iCurrentState; }
+		EnumState GetCurrentState() const { return static_cast< EnumState >( m_iCurrentState ); }
+		bool IsCurrentState( EnumState _eState ) const { return m_iCurrentState == static_cast< int >( _eState ); }
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Tells if a state is the current one or one of its ancestors
+		//Parameter : State to test
+		//Return value : The machine is in the state (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool IsInState( EnumState _eState ) const;
+
+	private:
+		static constexpr uint8_t QueueCapacity{ 8 };
+		static constexpr int MaxChainedTransitions{ 32 };			//Stops transitions endlessly queuing each other
+
+		//Ring buffer of the requested transitions.
+		struct TransitionQueue
+		{
+			int		m_oStates[ QueueCapacity ];
+			uint8_t	m_uStart{ 0 };
+			uint8_t	m_uSize{ 0 };
+		};
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Calls the exit and enter functions between the current state and a new one
+		//Parameter : Index of the new state
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _Transition( int _iState );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Goes to a state, then does the transitions requested by its exit and enter functions in the order they were requested
+		//Parameter : Index of the new state
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _ChainTransitions( int _iState );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a transition at the end of a queue
+		//Parameter 1 : Queue to fill
+		//Parameter 2 : Index of the new state
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _Push( TransitionQueue& _oQueue, int _iState );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes the first transition of a queue, which must not be empty
+		//Parameter : Queue to read
+		//Return value : Index of the new state
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static int _Pop( TransitionQueue& _oQueue );
+
+
+		/////////////////MEMBER VARIABLES/////////////////
+
+		const Table*	m_pTable;
+		T*				m_pOwner;
+		int				m_iCurrentState{ Table::InvalidState };
+		TransitionQueue	m_oQueuedTransitions;							//Requested with QueueTransition, done on the next update
+		TransitionQueue	m_oChainedTransitions;							//Requested during a transition, done right after it
+		bool			m_bInTransition{ false };
+	};
+} //namespace fzn
+
+#include "FZN/Game/StateMachine/FZNStateTable.inl"
+
+#endif //_FZNSTATETABLE_H_
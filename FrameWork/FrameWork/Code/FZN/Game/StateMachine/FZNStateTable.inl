@@ -0,0 +1,352 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : State machine whose states are rows of a function table shared by all its instances
+//------------------------------------------------------------------------
+
+#include "FZN/Game/StateMachine/FZNStateTable.h"
+
+
+namespace fzn
+{
+	//=========================================================
+	//=======================FZNSTATETABLE======================
+	//=========================================================
+
+	/////////////////STATES DEFINITION/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Defines the functions of a state, the ones left to nullptr do nothing (or are inherited from the parent for update and display)
+	//Parameter 1 : State to define
+	//Parameter 2 to 5 : Enter, exit, update and display functions
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNStateTable< T, EnumState, StatesNumber >::SetState( EnumState _eState, TransitionCallBack _pOnEnter /*= nullptr*/, TransitionCallBack _pOnExit /*= nullptr*/, UpdateCallBack _pOnUpdate /*= nullptr*/, DisplayCallBack _pOnDisplay /*= nullptr*/ )
+	{
+		const int iState = static_cast< int >( _eState );
+
+		if( IsValidState( iState ) == false )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "State %d out of range (%d states).", iState, StatesNumber );
+			return;
+		}
+
+		State& oState = m_oStates[ iState ];
+		oState.m_pEnterFct = _pOnEnter;
+		oState.m_pExitFct = _pOnExit;
+		oState.m_pUpdateFct = _pOnUpdate;
+		oState.m_pDisplayFct = _pOnDisplay;
+		oState.m_bOwnUpdate = _pOnUpdate != nullptr;
+		oState.m_bOwnDisplay = _pOnDisplay != nullptr;
+
+		m_bBuilt = false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Places a state under another one: being in the child also means being in the parent, which is entered before and exited after it
+	//Parameter 1 : Child state
+	//Parameter 2 : Parent state
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNStateTable< T, EnumState, StatesNumber >::SetParent( EnumState _eState, EnumState _eParent )
+	{
+		const int iState = static_cast< int >( _eState );
+		const int iParent = static_cast< int >( _eParent );
+
+		if( IsValidState( iState ) == false || IsValidState( iParent ) == false || iState == iParent )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "State %d can't have %d as parent.", iState, iParent );
+			return;
+		}
+
+		m_oStates[ iState ].m_iParent = iParent;
+		m_bBuilt = false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Checks the hierarchy and resolves the inherited functions, has to be called before the machines use the table
+	//Return value : The table is valid (true) or the hierarchy has a cycle
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	bool FZNStateTable< T, EnumState, StatesNumber >::Build()
+	{
+		m_bBuilt = false;
+
+		for( int iState = 0 ; iState < StatesNumber ; ++iState )
+		{
+			State& oState = m_oStates[ iState ];
+			oState.m_iDepth = 0;
+
+			//A state can't have more ancestors than there are other states, unless they loop.
+			for( int iAncestor = oState.m_iParent ; iAncestor != InvalidState ; iAncestor = m_oStates[ iAncestor ].m_iParent )
+			{
+				if( ++oState.m_iDepth >= StatesNumber )
+				{
+					FZN_COLOR_LOG( DBG_MSG_COL_RED, "The parents of state %d form a cycle.", iState );
+					return false;
+				}
+			}
+
+			if( oState.m_bOwnUpdate == false )
+				oState.m_pUpdateFct = nullptr;
+
+			if( oState.m_bOwnDisplay == false )
+				oState.m_pDisplayFct = nullptr;
+
+			for( int iAncestor = oState.m_iParent ; iAncestor != InvalidState && ( oState.m_pUpdateFct == nullptr || oState.m_pDisplayFct == nullptr ) ; iAncestor = m_oStates[ iAncestor ].m_iParent )
+			{
+				const State& oAncestor = m_oStates[ iAncestor ];
+
+				if( oState.m_pUpdateFct == nullptr && oAncestor.m_bOwnUpdate )
+					oState.m_pUpdateFct = oAncestor.m_pUpdateFct;
+
+				if( oState.m_pDisplayFct == nullptr && oAncestor.m_bOwnDisplay )
+					oState.m_pDisplayFct = oAncestor.m_pDisplayFct;
+			}
+		}
+
+		m_bBuilt = true;
+		return true;
+	}
+
+
+	//=========================================================
+	//===================FZNTABLESTATEMACHINE===================
+	//=========================================================
+
+	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Constructor
+	//Parameter 1 : Built table of the states, must stay alive as long as the machine
+	//Parameter 2 : Object the functions are called on
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	FZNTableStateMachine< T, EnumState, StatesNumber >::FZNTableStateMachine( const Table& _oTable, T* _pOwner )
+	: m_pTable( &_oTable )
+	, m_pOwner( _pOwner )
+	{
+	}
+
+
+	/////////////////STATES MANAGEMENT/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Goes to a state, exiting the current states up to the common ancestor and entering the ones down to the new state
+	//Parameter : New state (entering the current state exits and enters it again)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNTableStateMachine< T, EnumState, StatesNumber >::Enter( EnumState _eState )
+	{
+		const int iState = static_cast< int >( _eState );
+
+		if( Table::IsValidState( iState ) == false || m_pTable->IsBuilt() == false )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Can't enter state %d (invalid state or table not built).", iState );
+			return;
+		}
+
+		if( m_bInTransition )
+			_Push( m_oChainedTransitions, iState );
+		else
+			_ChainTransitions( iState );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Requests a transition done at the beginning of the next update (the ones requested during that update wait for the following one)
+	//Parameter : New state
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNTableStateMachine< T, EnumState, StatesNumber >::QueueTransition( EnumState _eState )
+	{
+		const int iState = static_cast< int >( _eState );
+
+		if( Table::IsValidState( iState ) == false )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "State %d out of range (%d states).", iState, StatesNumber );
+			return;
+		}
+
+		_Push( m_oQueuedTransitions, iState );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Does the transitions queued before the update, then calls the update function of the current state and goes to the state it returns
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNTableStateMachine< T, EnumState, StatesNumber >::Update()
+	{
+		if( m_pTable->IsBuilt() == false )
+			return;
+
+		//The transitions queued by the enter and exit functions called here are left for the next update.
+		for( uint8_t uNbTransitions = m_oQueuedTransitions.m_uSize ; uNbTransitions > 0 && m_oQueuedTransitions.m_uSize > 0 ; --uNbTransitions )
+			_ChainTransitions( _Pop( m_oQueuedTransitions ) );
+
+		if( m_iCurrentState == Table::InvalidState )
+			return;
+
+		const typename Table::UpdateCallBack pUpdate = m_pTable->m_oStates[ m_iCurrentState ].m_pUpdateFct;
+
+		if( pUpdate == nullptr )
+			return;
+
+		const EnumState eNextState = ( m_pOwner->*pUpdate )();
+
+		if( static_cast< int >( eNextState ) != m_iCurrentState )
+			Enter( eNextState );
+	}
+
+	template< class T, class EnumState, int StatesNumber >
+	void FZNTableStateMachine< T, EnumState, StatesNumber >::Display()
+	{
+		if( m_iCurrentState == Table::InvalidState )
+			return;
+
+		const typename Table::DisplayCallBack pDisplay = m_pTable->m_oStates[ m_iCurrentState ].m_pDisplayFct;
+
+		if( pDisplay != nullptr )
+			( m_pOwner->*pDisplay )();
+	}
+
+
+	/////////////////ACCESSORS / MUTATORS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Tells if a state is the current one or one of its ancestors
+	//Parameter : State to test
+	//Return value : The machine is in the state (true) or not
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	bool FZNTableStateMachine< T, EnumState, StatesNumber >::IsInState( EnumState _eState ) const
+	{
+		const int iState = static_cast< int >( _eState );
+
+		for( int iAncestor = m_iCurrentState ; iAncestor != Table::InvalidState ; iAncestor = m_pTable->GetParent( iAncestor ) )
+		{
+			if( iAncestor == iState )
+				return true;
+		}
+
+		return false;
+	}
+
+
+	//=========================================================
+	//==========================PRIVATE=========================
+	//=========================================================
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Calls the exit and enter functions between the current state and a new one
+	//Parameter : Index of the new state
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNTableStateMachine< T, EnumState, StatesNumber >::_Transition( int _iState )
+	{
+		const int iPreviousState = m_iCurrentState;
+		int iCommonAncestor = Table::InvalidState;
+
+		//Entering the current state again exits and enters it, but not its ancestors.
+		if( iPreviousState == _iState )
+			iCommonAncestor = m_pTable->GetParent( _iState );
+		else if( iPreviousState != Table::InvalidState )
+		{
+			int iFrom = iPreviousState;
+			int iTo = _iState;
+
+			while( m_pTable->GetDepth( iFrom ) > m_pTable->GetDepth( iTo ) )
+				iFrom = m_pTable->GetParent( iFrom );
+
+			while( m_pTable->GetDepth( iTo ) > m_pTable->GetDepth( iFrom ) )
+				iTo = m_pTable->GetParent( iTo );
+
+			while( iFrom != iTo )
+			{
+				iFrom = m_pTable->GetParent( iFrom );
+				iTo = m_pTable->GetParent( iTo );
+			}
+
+			iCommonAncestor = iFrom;
+		}
+
+		m_bInTransition = true;
+
+		for( int iExited = iPreviousState ; iExited != iCommonAncestor ; iExited = m_pTable->GetParent( iExited ) )
+		{
+			if( const typename Table::TransitionCallBack pExit = m_pTable->m_oStates[ iExited ].m_pExitFct )
+				( m_pOwner->*pExit )( static_cast< EnumState >( _iState ) );
+		}
+
+		//The states are entered from the top of the hierarchy, so they are gathered from the new state first.
+		int oEnteredStates[ StatesNumber ];
+		int iNbEnteredStates = 0;
+
+		for( int iEntered = _iState ; iEntered != iCommonAncestor ; iEntered = m_pTable->GetParent( iEntered ) )
+			oEnteredStates[ iNbEnteredStates++ ] = iEntered;
+
+		m_iCurrentState = _iState;
+
+		while( iNbEnteredStates > 0 )
+		{
+			if( const typename Table::TransitionCallBack pEnter = m_pTable->m_oStates[ oEnteredStates[ --iNbEnteredStates ] ].m_pEnterFct )
+				( m_pOwner->*pEnter )( static_cast< EnumState >( iPreviousState ) );
+		}
+
+		m_bInTransition = false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Goes to a state, then does the transitions requested by its exit and enter functions in the order they were requested
+	//Parameter : Index of the new state
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNTableStateMachine< T, EnumState, StatesNumber >::_ChainTransitions( int _iState )
+	{
+		_Transition( _iState );
+
+		for( int iTransition = 1 ; m_oChainedTransitions.m_uSize > 0 ; ++iTransition )
+		{
+			if( iTransition == MaxChainedTransitions )
+			{
+				FZN_COLOR_LOG( DBG_MSG_COL_RED, "Too many chained transitions from state %d, the queue is cleared.", m_iCurrentState );
+				m_oChainedTransitions.m_uSize = 0;
+				return;
+			}
+
+			_Transition( _Pop( m_oChainedTransitions ) );
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds a transition at the end of a queue
+	//Parameter 1 : Queue to fill
+	//Parameter 2 : Index of the new state
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	void FZNTableStateMachine< T, EnumState, StatesNumber >::_Push( TransitionQueue& _oQueue, int _iState )
+	{
+		if( _oQueue.m_uSize == QueueCapacity )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Too many queued transitions, state %d ignored.", _iState );
+			return;
+		}
+
+		_oQueue.m_oStates[ ( _oQueue.m_uStart + _oQueue.m_uSize ) % QueueCapacity ] = _iState;
+		++_oQueue.m_uSize;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes the first transition of a queue, which must not be empty
+	//Parameter : Queue to read
+	//Return value : Index of the new state
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< class T, class EnumState, int StatesNumber >
+	int FZNTableStateMachine< T, EnumState, StatesNumber >::_Pop( TransitionQueue& _oQueue )
+	{
+		const int iState = _oQueue.m_oStates[ _oQueue.m_uStart ];
+		_oQueue.m_uStart = ( _oQueue.m_uStart + 1 ) % QueueCapacity;
+		--_oQueue.m_uSize;
+
+		return iState;
+	}
+} //namespace fzn
@@ -0,0 +1,647 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Places groups of steering entities in formation behind their leader
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <execution>
+
+#include "FZN/Includes.h"
+#include "FZN/Game/Steering/SteeringEntity.h"
+#include "FZN/Game/Steering/FormationSolver.h"
+
+
+namespace fzn
+{
+	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Default constructor
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	FormationSolver::FormationSolver()
+	{
+	}
+
+
+	/////////////////GROUPS MANAGEMENT/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Creates a group following a leader
+	//Parameter 1 : Leader of the group, not steered by the solver
+	//Parameter 2 : Description of the formation
+	//Return value : Index of the group (InvalidGroup if the leader is null)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int FormationSolver::AddGroup( SteeringEntity* _pLeader, const Desc& _oDesc )
+	{
+		if( _pLeader == nullptr )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "A formation needs a leader." );
+			return InvalidGroup;
+		}
+
+		int iGroup = (int)m_oGroups.size();
+
+		if( m_oFreeGroups.empty() == false )
+		{
+			iGroup = m_oFreeGroups.back();
+			m_oFreeGroups.pop_back();
+		}
+		else
+			m_oGroups.emplace_back();
+
+		Group& oGroup = m_oGroups[ iGroup ];
+		oGroup.m_pLeader = _pLeader;
+		oGroup.m_oDesc = _oDesc;
+		oGroup.m_vBack = sf::Vector2f( 0.f, 1.f );
+		oGroup.m_oSlotPrices.clear();
+		oGroup.m_uUpdatesSinceAssignment = 0;
+		oGroup.m_uAssignmentOffset = (uint32_t)iGroup;
+		oGroup.m_bMembersChanged = true;
+		oGroup.m_bUsed = true;
+
+		return iGroup;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes a group, its members stop receiving forces from the solver
+	//Parameter : Index of the group
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::RemoveGroup( int _iGroup )
+	{
+		if( _IsValidGroup( _iGroup ) == false )
+			return;
+
+		Group& oGroup = m_oGroups[ _iGroup ];
+
+		for( const SteeringEntity* pMember : oGroup.m_oMembers )
+			m_oEntityGroups.Remove( pMember );
+
+		oGroup.m_pLeader = nullptr;
+		oGroup.m_oMembers.clear();
+		oGroup.m_oMemberSlots.clear();
+		oGroup.m_bUsed = false;
+
+		m_oFreeGroups.push_back( _iGroup );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds an entity in a group
+	//Parameter 1 : Index of the group
+	//Parameter 2 : Entity to add
+	//Return value : The entity has been added (true) or is already in a group
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool FormationSolver::AddMember( int _iGroup, SteeringEntity* _pEntity )
+	{
+		if( _IsValidGroup( _iGroup ) == false || _pEntity == nullptr || _pEntity == m_oGroups[ _iGroup ].m_pLeader )
+			return false;
+
+		if( m_oEntityGroups.Find( _pEntity ) != nullptr )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "The entity is already in a formation." );
+			return false;
+		}
+
+		Group& oGroup = m_oGroups[ _iGroup ];
+		oGroup.m_oMembers.push_back( _pEntity );
+		oGroup.m_bMembersChanged = true;
+
+		m_oEntityGroups.Insert( _pEntity, _iGroup );
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes an entity from its group
+	//Parameter : Entity to remove
+	//Return value : The entity has been removed (true) or wasn't in a group
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool FormationSolver::RemoveMember( SteeringEntity* _pEntity )
+	{
+		const auto* pEntityGroup = m_oEntityGroups.Find( _pEntity );
+
+		if( pEntityGroup == nullptr )
+			return false;
+
+		Group& oGroup = m_oGroups[ pEntityGroup->data ];
+		auto itMember = std::find( oGroup.m_oMembers.begin(), oGroup.m_oMembers.end(), _pEntity );
+
+		if( itMember != oGroup.m_oMembers.end() )
+		{
+			*itMember = oGroup.m_oMembers.back();
+			oGroup.m_oMembers.pop_back();
+			oGroup.m_bMembersChanged = true;
+		}
+
+		m_oEntityGroups.Remove( _pEntity );
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes every reference to an entity about to be destroyed (as a member or as a leader)
+	//Parameter : Entity
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::RemoveEntity( SteeringEntity* _pEntity )
+	{
+		RemoveMember( _pEntity );
+
+		for( Group& oGroup : m_oGroups )
+		{
+			if( oGroup.m_pLeader == _pEntity )
+				oGroup.m_pLeader = nullptr;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Computes the slots of each group and gives their members the force bringing them there
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::Update()
+	{
+		m_oActiveGroups.clear();
+
+		for( int iGroup = 0 ; iGroup < (int)m_oGroups.size() ; ++iGroup )
+		{
+			if( m_oGroups[ iGroup ].m_bUsed && m_oGroups[ iGroup ].m_pLeader != nullptr && m_oGroups[ iGroup ].m_oMembers.empty() == false )
+				m_oActiveGroups.push_back( iGroup );
+		}
+
+		//Each group only writes in its own members, which are in no other group, so the result doesn't depend on the order the groups are processed in.
+		if( m_oActiveGroups.size() > 1 )
+			std::for_each( std::execution::par, m_oActiveGroups.begin(), m_oActiveGroups.end(), [this]( int _iGroup ) { _UpdateGroup( m_oGroups[ _iGroup ] ); } );
+		else if( m_oActiveGroups.size() == 1 )
+			_UpdateGroup( m_oGroups[ m_oActiveGroups.front() ] );
+	}
+
+
+	/////////////////ACCESSORS / MUTATORS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the formation of a group, the slots are assigned again at the next update
+	//Parameter 1 : Index of the group
+	//Parameter 2 : Description of the formation
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::SetDesc( int _iGroup, const Desc& _oDesc )
+	{
+		if( _IsValidGroup( _iGroup ) == false )
+			return;
+
+		//The prices of the previous slots would only slow the next auction down.
+		m_oGroups[ _iGroup ].m_oDesc = _oDesc;
+		m_oGroups[ _iGroup ].m_oSlotPrices.clear();
+		m_oGroups[ _iGroup ].m_bMembersChanged = true;
+	}
+
+	const FormationSolver::Desc* FormationSolver::GetDesc( int _iGroup ) const
+	{
+		return _IsValidGroup( _iGroup ) ? &m_oGroups[ _iGroup ].m_oDesc : nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the leader of a group
+	//Parameter 1 : Index of the group
+	//Parameter 2 : New leader (nullptr stops the group)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::SetLeader( int _iGroup, SteeringEntity* _pLeader )
+	{
+		if( _IsValidGroup( _iGroup ) == false )
+			return;
+
+		if( _pLeader != nullptr && m_oEntityGroups.Find( _pLeader ) != nullptr && m_oEntityGroups.Find( _pLeader )->data == _iGroup )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "The leader of a formation can't be one of its members." );
+			return;
+		}
+
+		m_oGroups[ _iGroup ].m_pLeader = _pLeader;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on the position an entity is going to
+	//Parameter 1 : Entity
+	//Parameter 2 : Position of its slot at the last update
+	//Return value : The entity is in a group (true) or not
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool FormationSolver::GetSlotPosition( const SteeringEntity* _pEntity, sf::Vector2f& _vPosition ) const
+	{
+		const auto* pEntityGroup = m_oEntityGroups.Find( _pEntity );
+
+		if( pEntityGroup == nullptr )
+			return false;
+
+		const Group& oGroup = m_oGroups[ pEntityGroup->data ];
+		const auto itMember = std::find( oGroup.m_oMembers.begin(), oGroup.m_oMembers.end(), _pEntity );
+		const size_t uMember = itMember - oGroup.m_oMembers.begin();
+
+		if( uMember >= oGroup.m_oMemberSlots.size() || oGroup.m_oMemberSlots[ uMember ] >= (int)oGroup.m_oSlots.size() )
+			return false;
+
+		_vPosition = oGroup.m_oSlots[ oGroup.m_oMemberSlots[ uMember ] ];
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on the group of an entity
+	//Parameter : Entity
+	//Return value : Index of the group (InvalidGroup if none)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int FormationSolver::GetGroup( const SteeringEntity* _pEntity ) const
+	{
+		const auto* pEntityGroup = m_oEntityGroups.Find( _pEntity );
+
+		return pEntityGroup != nullptr ? pEntityGroup->data : InvalidGroup;
+	}
+
+	int FormationSolver::GetMembersNumber( int _iGroup ) const
+	{
+		return _IsValidGroup( _iGroup ) ? (int)m_oGroups[ _iGroup ].m_oMembers.size() : 0;
+	}
+
+
+	/////////////////PRIVATE FUNCTIONS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Computes the slots of a group, assigns them and steers its members
+	//Parameter : Group to update
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::_UpdateGroup( Group& _oGroup )
+	{
+		const int iNbMembers = (int)_oGroup.m_oMembers.size();
+		const Desc& oDesc = _oGroup.m_oDesc;
+
+		_oGroup.m_oPositions.resize( iNbMembers );
+		_oGroup.m_oVelocities.resize( iNbMembers );
+
+		for( int iMember = 0 ; iMember < iNbMembers ; ++iMember )
+		{
+			_oGroup.m_oPositions[ iMember ] = _oGroup.m_oMembers[ iMember ]->m_position;
+			_oGroup.m_oVelocities[ iMember ] = _oGroup.m_oMembers[ iMember ]->m_velocity;
+		}
+
+		_ComputeSlots( _oGroup );
+
+		++_oGroup.m_uUpdatesSinceAssignment;
+
+		if( _oGroup.m_bMembersChanged || ( oDesc.m_uReassignmentPeriod > 0 && _oGroup.m_uUpdatesSinceAssignment >= oDesc.m_uReassignmentPeriod ) )
+			_AssignSlots( _oGroup );
+
+		const bool bFlocking = oDesc.m_fNeighbourRadius > 0.f && ( oDesc.m_fSeparationWeight != 0.f || oDesc.m_fCohesionWeight != 0.f || oDesc.m_fAlignmentWeight != 0.f );
+
+		if( bFlocking )
+		{
+			const float fInvCellSize = 1.f / oDesc.m_fNeighbourRadius;
+			_oGroup.m_oCells.resize( iNbMembers );
+
+			for( int iMember = 0 ; iMember < iNbMembers ; ++iMember )
+			{
+				const sf::Vector2f& vPosition = _oGroup.m_oPositions[ iMember ];
+				_oGroup.m_oCells[ iMember ] = { _GetCellKey( (int)std::floor( vPosition.x * fInvCellSize ), (int)std::floor( vPosition.y * fInvCellSize ) ), iMember };
+			}
+
+			std::sort( _oGroup.m_oCells.begin(), _oGroup.m_oCells.end() );
+		}
+
+		for( int iMember = 0 ; iMember < iNbMembers ; ++iMember )
+		{
+			SteeringEntity* pMember = _oGroup.m_oMembers[ iMember ];
+			const sf::Vector2f vTargetOffset = _oGroup.m_oSlots[ _oGroup.m_oMemberSlots[ iMember ] ] - _oGroup.m_oPositions[ iMember ];
+			const float fDistance = Math::VectorLength( vTargetOffset );
+			sf::Vector2f vForce;
+
+			//Same as Arrival::ArrivalBehavior, without its allocation.
+			if( Math::IsZeroByEpsilon( fDistance ) == false )
+			{
+				const float fRampedSpeed = oDesc.m_fSlowingDistance > 0.f ? pMember->m_maxSpeed * ( fDistance / oDesc.m_fSlowingDistance ) : pMember->m_maxSpeed;
+				const float fClippedSpeed = Math::Min( fRampedSpeed, pMember->m_maxSpeed );
+
+				vForce = ( vTargetOffset * ( fClippedSpeed / fDistance ) - _oGroup.m_oVelocities[ iMember ] ) * oDesc.m_fFormationWeight;
+			}
+
+			if( bFlocking )
+				vForce += _GetFlockingForce( _oGroup, iMember );
+
+			pMember->AddSteeringForce( vForce );
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Computes the world position of the slots of a group from its leader
+	//Parameter : Group
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::_ComputeSlots( Group& _oGroup )
+	{
+		const int iNbSlots = (int)_oGroup.m_oMembers.size();
+		const Desc& oDesc = _oGroup.m_oDesc;
+		const sf::Vector2f vLeaderPos = _oGroup.m_pLeader->m_position;
+
+		//A stopped leader keeps its last heading, instead of making the formation spin around it.
+		if( Math::VectorLengthSq( _oGroup.m_pLeader->m_velocity ) > 1.f )
+			_oGroup.m_vBack = Math::VectorNormalization( _oGroup.m_pLeader->m_velocity ) * -1.f;
+
+		const sf::Vector2f vBack = _oGroup.m_vBack;
+		const sf::Vector2f vRight( -vBack.y, vBack.x );
+
+		_oGroup.m_oSlots.resize( iNbSlots );
+
+		switch( oDesc.m_eShape )
+		{
+			case Shape::Circle:
+			{
+				const float fRadius = Math::Max( oDesc.m_fOffset, iNbSlots * oDesc.m_fOffset / ( 2.f * Math::PI ) );		//The slots are an offset apart on the circle
+				const float fAngleStep = 2.f * Math::PI / iNbSlots;
+
+				for( int iSlot = 0 ; iSlot < iNbSlots ; ++iSlot )
+					_oGroup.m_oSlots[ iSlot ] = vLeaderPos + sf::Vector2f( std::cos( iSlot * fAngleStep ), std::sin( iSlot * fAngleStep ) ) * fRadius;
+				break;
+			}
+			case Shape::V:
+			case Shape::Line:
+			{
+				//The first slot is behind the leader, the next ones alternate on each side of it.
+				sf::Vector2f vLeftBranch = vRight * -1.f;
+				sf::Vector2f vRightBranch = vRight;
+
+				if( oDesc.m_eShape == Shape::V )
+				{
+					vLeftBranch = vBack;
+					vRightBranch = vBack;
+					Math::VectorRotateR( vLeftBranch, -oDesc.m_fAngle * 0.5f );
+					Math::VectorRotateR( vRightBranch, oDesc.m_fAngle * 0.5f );
+				}
+
+				const sf::Vector2f vFirstSlot = vLeaderPos + vBack * oDesc.m_fOffset;
+
+				for( int iSlot = 0 ; iSlot < iNbSlots ; ++iSlot )
+				{
+					const float fSideOffset = ( ( iSlot + 1 ) / 2 ) * oDesc.m_fOffset;
+					_oGroup.m_oSlots[ iSlot ] = vFirstSlot + ( Math::IsOdd( iSlot ) ? vLeftBranch : vRightBranch ) * fSideOffset;
+				}
+				break;
+			}
+			case Shape::Multiline:
+			{
+				const int iPerLine = Math::Max( 1, oDesc.m_iEntitiesPerLine );
+
+				for( int iSlot = 0 ; iSlot < iNbSlots ; ++iSlot )
+				{
+					const int iLine = iSlot / iPerLine;
+					const int iLineSize = Math::Min( iPerLine, iNbSlots - iLine * iPerLine );		//The last line can be shorter, it is centered too
+					const float fLateral = ( ( iSlot % iPerLine ) - ( iLineSize - 1 ) * 0.5f ) * oDesc.m_fOffset;
+
+					_oGroup.m_oSlots[ iSlot ] = vLeaderPos + vBack * ( oDesc.m_fOffset * ( iLine + 1 ) ) + vRight * fLateral;
+				}
+				break;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Assigns a slot to each member, keeping the current assignment if the new one isn't cheaper enough
+	//Parameter : Group
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::_AssignSlots( Group& _oGroup )
+	{
+		std::vector< int > oAssignment( _oGroup.m_oMembers.size() );
+		_SolveAssignment( _oGroup, oAssignment );
+
+		//Switching slots for a small gain makes the members cross each other's path back and forth.
+		const bool bKeepCurrent = _oGroup.m_bMembersChanged == false && _GetAssignmentCost( _oGroup, oAssignment ) > _GetAssignmentCost( _oGroup, _oGroup.m_oMemberSlots ) * ( 1.0 - ReassignmentGain );
+
+		if( bKeepCurrent == false )
+			_oGroup.m_oMemberSlots.swap( oAssignment );
+
+		//The groups created together are all assigned on their first update, they start their period at different updates.
+		const uint32_t uPeriod = _oGroup.m_oDesc.m_uReassignmentPeriod;
+		_oGroup.m_uUpdatesSinceAssignment = _oGroup.m_bMembersChanged && uPeriod > 0 ? _oGroup.m_uAssignmentOffset % uPeriod : 0;
+		_oGroup.m_bMembersChanged = false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Finds an assignment whose sum of the squared distances between the members and their slot is at most AssignmentTolerance above the optimal one (auction algorithm)
+	//Parameter 1 : Group, its slot prices are updated
+	//Parameter 2 : Slot of each member
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void FormationSolver::_SolveAssignment( Group& _oGroup, std::vector< int >& _oAssignment )
+	{
+		const int iSize = (int)_oGroup.m_oMembers.size();
+
+		if( iSize == 1 )
+		{
+			_oAssignment[ 0 ] = 0;
+			return;
+		}
+
+		std::vector< double >& oPrices = _oGroup.m_oSlotPrices;
+		std::vector< int >& oSlotMembers = _oGroup.m_oSlotMembers;
+		std::vector< int >& oBidders = _oGroup.m_oBidders;
+		const bool bWarmStart = (int)oPrices.size() == iSize && (int)oSlotMembers.size() == iSize;
+
+		//The assignment is warm started from the prices and the slots of the previous auction.
+		if( bWarmStart == false )
+		{
+			oPrices.assign( iSize, 0.0 );
+			oSlotMembers.assign( iSize, -1 );
+		}
+
+		//Computed in place, the auction evaluates it iSize times per bid.
+		auto GetCost = [&]( const sf::Vector2f& _vPosition, int _iSlot )
+		{
+			const sf::Vector2f vOffset = _oGroup.m_oSlots[ _iSlot ] - _vPosition;
+			return (double)( vOffset.x * vOffset.x + vOffset.y * vOffset.y );
+		};
+		auto GetValue = [&]( const sf::Vector2f& _vPosition, int _iSlot ) { return -GetCost( _vPosition, _iSlot ) - oPrices[ _iSlot ]; };
+
+		//Each member going to its closest slot is a lower bound of the optimal cost.
+		double dLowerBound = 0.0;
+		double dMaxCost = 0.0;
+
+		for( int iMember = 0 ; iMember < iSize ; ++iMember )
+		{
+			double dMinCost = DBL_MAX;
+
+			for( int iSlot = 0 ; iSlot < iSize ; ++iSlot )
+			{
+				const double dCost = GetCost( _oGroup.m_oPositions[ iMember ], iSlot );
+				dMinCost = Math::Min( dMinCost, dCost );
+				dMaxCost = Math::Max( dMaxCost, dCost );
+			}
+
+			dLowerBound += dMinCost;
+		}
+
+		//An assignment where each member is within epsilon of its best slot costs at most iSize * epsilon more than the optimal one.
+		const double dMinEpsilon = Math::Max( AssignmentTolerance * dLowerBound / iSize, MinAssignmentEpsilon );
+		double dEpsilon = bWarmStart ? dMinEpsilon : Math::Max( dMaxCost / EpsilonScaling, dMinEpsilon );
+
+		while( true )
+		{
+			//The members whose slot is still within epsilon of their best one keep it, the other ones bid again.
+			std::fill( _oAssignment.begin(), _oAssignment.end(), -1 );
+			oBidders.clear();
+
+			for( int iSlot = 0 ; iSlot < iSize ; ++iSlot )
+			{
+				if( oSlotMembers[ iSlot ] >= 0 )
+					_oAssignment[ oSlotMembers[ iSlot ] ] = iSlot;
+			}
+
+			for( int iMember = iSize - 1 ; iMember >= 0 ; --iMember )
+			{
+				const int iSlot = _oAssignment[ iMember ];
+
+				if( iSlot >= 0 )
+				{
+					const sf::Vector2f vPosition = _oGroup.m_oPositions[ iMember ];
+					const double dThreshold = GetValue( vPosition, iSlot ) + dEpsilon;
+					int iOtherSlot = 0;
+
+					while( iOtherSlot < iSize && GetValue( vPosition, iOtherSlot ) <= dThreshold )
+						++iOtherSlot;
+
+					if( iOtherSlot == iSize )
+						continue;
+
+					oSlotMembers[ iSlot ] = -1;
+					_oAssignment[ iMember ] = -1;
+				}
+
+				oBidders.push_back( iMember );
+			}
+
+			//Each member without slot bids for the one it values the most, outbidding its holder by the value difference with its second choice.
+			while( oBidders.empty() == false )
+			{
+				const int iMember = oBidders.back();
+				const sf::Vector2f vPosition = _oGroup.m_oPositions[ iMember ];
+				double dBestValue = -DBL_MAX;
+				double dSecondValue = -DBL_MAX;
+				int iBestSlot = 0;
+
+				oBidders.pop_back();
+
+				for( int iSlot = 0 ; iSlot < iSize ; ++iSlot )
+				{
+					const double dValue = GetValue( vPosition, iSlot );
+
+					if( dValue > dBestValue )
+					{
+						dSecondValue = dBestValue;
+						dBestValue = dValue;
+						iBestSlot = iSlot;
+					}
+					else if( dValue > dSecondValue )
+						dSecondValue = dValue;
+				}
+
+				oPrices[ iBestSlot ] += dBestValue - dSecondValue + dEpsilon;
+
+				if( oSlotMembers[ iBestSlot ] >= 0 )
+				{
+					_oAssignment[ oSlotMembers[ iBestSlot ] ] = -1;
+					oBidders.push_back( oSlotMembers[ iBestSlot ] );
+				}
+
+				oSlotMembers[ iBestSlot ] = iMember;
+				_oAssignment[ iMember ] = iBestSlot;
+			}
+
+			if( dEpsilon <= dMinEpsilon )
+				break;
+
+			dEpsilon = Math::Max( dEpsilon / EpsilonScaling, dMinEpsilon );
+		}
+
+		//Only the price differences matter, they are kept close to zero so they don't lose precision over the assignments.
+		const double dMinPrice = *std::min_element( oPrices.begin(), oPrices.end() );
+
+		for( double& dPrice : oPrices )
+			dPrice -= dMinPrice;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Sum of the squared distances between the members and their slot
+	//Parameter 1 : Group
+	//Parameter 2 : Slot of each member
+	//Return value : Cost
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	double FormationSolver::_GetAssignmentCost( const Group& _oGroup, const std::vector< int >& _oAssignment )
+	{
+		double dCost = 0.0;
+
+		for( int iMember = 0 ; iMember < (int)_oAssignment.size() ; ++iMember )
+			dCost += Math::VectorLengthSq( _oGroup.m_oSlots[ _oAssignment[ iMember ] ] - _oGroup.m_oPositions[ iMember ] );
+
+		return dCost;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Sums the separation, cohesion and alignment forces of a member with the others of its group
+	//Parameter 1 : Group (its spatial hash has to be sorted)
+	//Parameter 2 : Index of the member
+	//Return value : Weighted sum of the flocking forces
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	sf::Vector2f FormationSolver::_GetFlockingForce( const Group& _oGroup, int _iMember )
+	{
+		const Desc& oDesc = _oGroup.m_oDesc;
+		const sf::Vector2f& vPosition = _oGroup.m_oPositions[ _iMember ];
+		const float fRadius = oDesc.m_fNeighbourRadius;
+		const float fRadiusSq = fRadius * fRadius;
+		const int iCellX = (int)std::floor( vPosition.x / fRadius );
+		const int iCellY = (int)std::floor( vPosition.y / fRadius );
+
+		sf::Vector2f vSeparation;
+		sf::Vector2f vAveragePos;
+		sf::Vector2f vAverageVelocity;
+		int iNbNeighbours = 0;
+
+		//The cells are as large as the radius, so the neighbours are in the 3x3 cells around the member.
+		for( int iOffsetY = -1 ; iOffsetY <= 1 ; ++iOffsetY )
+		{
+			for( int iOffsetX = -1 ; iOffsetX <= 1 ; ++iOffsetX )
+			{
+				const uint64_t uKey = _GetCellKey( iCellX + iOffsetX, iCellY + iOffsetY );
+				auto itCell = std::lower_bound( _oGroup.m_oCells.begin(), _oGroup.m_oCells.end(), std::pair< uint64_t, int >( uKey, INT_MIN ) );
+
+				for( ; itCell != _oGroup.m_oCells.end() && itCell->first == uKey ; ++itCell )
+				{
+					if( itCell->second == _iMember )
+						continue;
+
+					const sf::Vector2f vToMember = vPosition - _oGroup.m_oPositions[ itCell->second ];
+					const float fDistanceSq = Math::VectorLengthSq( vToMember );
+
+					if( fDistanceSq > fRadiusSq )
+						continue;
+
+					//Same forces as the Separation, Cohesion and Alignment behaviors, limited to the members of the group.
+					if( fDistanceSq > 0.f )
+						vSeparation += vToMember * ( fRadius / std::sqrt( fDistanceSq ) );
+
+					vAveragePos += _oGroup.m_oPositions[ itCell->second ];
+					vAverageVelocity += _oGroup.m_oVelocities[ itCell->second ];
+					++iNbNeighbours;
+				}
+			}
+		}
+
+		if( iNbNeighbours == 0 )
+			return sf::Vector2f( 0.f, 0.f );
+
+		const float fInvNbNeighbours = 1.f / iNbNeighbours;
+
+		return vSeparation * oDesc.m_fSeparationWeight
+			+ ( vAveragePos * fInvNbNeighbours - vPosition ) * oDesc.m_fCohesionWeight
+			+ ( vAverageVelocity * fInvNbNeighbours - _oGroup.m_oVelocities[ _iMember ] ) * oDesc.m_fAlignmentWeight;
+	}
+
+	uint64_t FormationSolver::_GetCellKey( int _iX, int _iY )
+	{
+		return ( (uint64_t)(uint32_t)_iX << 32 ) | (uint32_t)_iY;
+	}
+
+	bool FormationSolver::_IsValidGroup( int _iGroup ) const
+	{
+		return _iGroup >= 0 && _iGroup < (int)m_oGroups.size() && m_oGroups[ _iGroup ].m_bUsed;
+	}
+} //namespace fzn
@@ -0,0 +1,215 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Places groups of steering entities in formation behind their leader
+//------------------------------------------------------------------------
+
+#ifndef _FORMATIONSOLVER_H_
+#define _FORMATIONSOLVER_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "FZN/Defines.h"
+#include "FZN/DataStructure/HashMap.h"
+#include "FZN/Tools/Math.h"
+
+#pragma warning( push )
+#pragma warning( disable: 4251 )
+
+
+namespace fzn
+{
+	class SteeringEntity;
+
+	//The slots of a group are computed once per frame from its leader, and each member keeps the same slot until a new assignment is clearly cheaper.
+	//The groups don't share any entity, so they are steered in parallel. The forces are given to the entities, which integrate them in their own update.
+	//The assignment is an auction with epsilon scaling: its sum of the squared distances to the slots is at most AssignmentTolerance above the optimal one, whatever the size of the group.
+	//The slot prices of the last assignment are kept, so checking the assignment of members which barely moved since only takes a few bids.
+	//The periodic checks of the groups created together are spread over their period.
+	class FZN_EXPORT FormationSolver
+	{
+	public:
+		enum class Shape : uint8_t
+		{
+			Circle,
+			V,
+			Line,
+			Multiline,
+		};
+
+		struct Desc
+		{
+			Shape		m_eShape{ Shape::Line };
+			float		m_fOffset{ 30.f };						//Distance between two slots
+			float		m_fAngle{ Math::PIdiv2 };				//Angle between the two branches of the V (radians)
+			int			m_iEntitiesPerLine{ 5 };				//Multiline only
+			float		m_fSlowingDistance{ 100.f };			//Distance to the slot at which the entities start to brake
+			float		m_fFormationWeight{ 1.f };
+			float		m_fNeighbourRadius{ 20.f };				//Distance at which the members of the group see each other for the flocking behaviors
+			float		m_fSeparationWeight{ 1.f };
+			float		m_fCohesionWeight{ 0.f };
+			float		m_fAlignmentWeight{ 0.f };
+			uint32_t	m_uReassignmentPeriod{ 30 };			//Number of updates between two checks of the assignment (0 to only do it when the members change)
+		};
+
+		static constexpr int InvalidGroup{ -1 };
+		static constexpr double AssignmentTolerance{ 0.01 };	//Part of the optimal cost the assignment can be above it
+		static constexpr double MinAssignmentEpsilon{ 0.01 };	//Smallest bid increment of the auction (squared distance), the cost can also be above the optimal one by this much per member
+		static constexpr float ReassignmentGain{ 0.05f };		//Part of the assignment cost a new assignment has to save to replace the current one
+
+
+		/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Default constructor
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FormationSolver();
+
+
+		/////////////////GROUPS MANAGEMENT/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Creates a group following a leader
+		//Parameter 1 : Leader of the group, not steered by the solver
+		//Parameter 2 : Description of the formation
+		//Return value : Index of the group (InvalidGroup if the leader is null)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int AddGroup( SteeringEntity* _pLeader, const Desc& _oDesc );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes a group, its members stop receiving forces from the solver
+		//Parameter : Index of the group
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void RemoveGroup( int _iGroup );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds an entity in a group
+		//Parameter 1 : Index of the group
+		//Parameter 2 : Entity to add
+		//Return value : The entity has been added (true) or is already in a group
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool AddMember( int _iGroup, SteeringEntity* _pEntity );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes an entity from its group
+		//Parameter : Entity to remove
+		//Return value : The entity has been removed (true) or wasn't in a group
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool RemoveMember( SteeringEntity* _pEntity );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes every reference to an entity about to be destroyed (as a member or as a leader)
+		//Parameter : Entity
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void RemoveEntity( SteeringEntity* _pEntity );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Computes the slots of each group and gives their members the force bringing them there
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Update();
+
+
+		/////////////////ACCESSORS / MUTATORS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the formation of a group, the slots are assigned again at the next update
+		//Parameter 1 : Index of the group
+		//Parameter 2 : Description of the formation
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetDesc( int _iGroup, const Desc& _oDesc );
+		const Desc* GetDesc( int _iGroup ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the leader of a group
+		//Parameter 1 : Index of the group
+		//Parameter 2 : New leader (nullptr stops the group)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetLeader( int _iGroup, SteeringEntity* _pLeader );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the position an entity is going to
+		//Parameter 1 : Entity
+		//Parameter 2 : Position of its slot at the last update
+		//Return value : The entity is in a group (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool GetSlotPosition( const SteeringEntity* _pEntity, sf::Vector2f& _vPosition ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the group of an entity
+		//Parameter : Entity
+		//Return value : Index of the group (InvalidGroup if none)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int GetGroup( const SteeringEntity* _pEntity ) const;
+		int GetMembersNumber( int _iGroup ) const;
+
+	private:
+		static constexpr double EpsilonScaling{ 8.0 };			//Ratio between the bid increments of two phases of the auction
+
+		struct Group
+		{
+			SteeringEntity*							m_pLeader{ nullptr };
+			Desc									m_oDesc;
+			std::vector< SteeringEntity* >			m_oMembers;
+			std::vector< int >						m_oMemberSlots;					//Slot of each member
+			std::vector< sf::Vector2f >				m_oSlots;						//World position of each slot at the current update
+			std::vector< sf::Vector2f >				m_oPositions;					//Copies of the members positions and velocities, read contiguously by the flocking
+			std::vector< sf::Vector2f >				m_oVelocities;
+			std::vector< std::pair< uint64_t, int > >	m_oCells;					//Cell of each member in the spatial hash, sorted
+			std::vector< double >					m_oSlotPrices;					//Prices of the last auction, the next one starts from them
+			std::vector< int >						m_oSlotMembers;					//Member holding each slot, the next auction starts from the last one
+			std::vector< int >						m_oBidders;						//Members without slot during the auction
+			sf::Vector2f							m_vBack{ 0.f, 1.f };			//Direction from the leader to the back of the formation
+			uint32_t								m_uUpdatesSinceAssignment{ 0 };
+			uint32_t								m_uAssignmentOffset{ 0 };		//Updates already counted after a forced assignment, so the periodic checks of the groups are spread
+			bool									m_bMembersChanged{ true };
+			bool									m_bUsed{ false };
+		};
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Computes the slots of a group, assigns them and steers its members
+		//Parameter : Group to update
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static void _UpdateGroup( Group& _oGroup );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Computes the world position of the slots of a group from its leader
+		//Parameter : Group
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static void _ComputeSlots( Group& _oGroup );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Assigns a slot to each member, keeping the current assignment if the new one isn't cheaper enough
+		//Parameter : Group
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static void _AssignSlots( Group& _oGroup );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Finds an assignment whose sum of the squared distances between the members and their slot is at most AssignmentTolerance above the optimal one (auction algorithm)
+		//Parameter 1 : Group, its slot prices are updated
+		//Parameter 2 : Slot of each member
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static void _SolveAssignment( Group& _oGroup, std::vector< int >& _oAssignment );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Sum of the squared distances between the members and their slot
+		//Parameter 1 : Group
+		//Parameter 2 : Slot of each member
+		//Return value : Cost
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static double _GetAssignmentCost( const Group& _oGroup, const std::vector< int >& _oAssignment );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Sums the separation, cohesion and alignment forces of a member with the others of its group
+		//Parameter 1 : Group (its spatial hash has to be sorted)
+		//Parameter 2 : Index of the member
+		//Return value : Weighted sum of the flocking forces
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static sf::Vector2f _GetFlockingForce( const Group& _oGroup, int _iMember );
+		static uint64_t _GetCellKey( int _iX, int _iY );
+
+		bool _IsValidGroup( int _iGroup ) const;
+
+
+		/////////////////MEMBER VARIABLES/////////////////
+
+		std::vector< Group >					m_oGroups;
+		std::vector< int >						m_oFreeGroups;					//Indices of the removed groups, reused by the next ones
+		std::vector< int >						m_oActiveGroups;				//Indices of the groups to update, rebuilt at each update
+		HashMap< const SteeringEntity*, int >	m_oEntityGroups;				//Group of each member
+	};
+} //namespace fzn
+
+#pragma warning( pop )
+
+#endif //_FORMATIONSOLVER_H_
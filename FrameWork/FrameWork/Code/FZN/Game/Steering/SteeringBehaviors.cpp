@@ -206,7 +206,7 @@ namespace fzn
 		displacement.x = cos( _entity->m_fWanderAngle ) * fDisplacementLength;
 		displacement.y = sin( _entity->m_fWanderAngle ) * fDisplacementLength;
 
-		_entity->m_fWanderAngle += rand() % 2 * ( Math::PIdiv4 ) - ( Math::PIdiv4 ) * 0.5f;
+		_entity->m_fWanderAngle += Rand( 0, 2 ) * ( Math::PIdiv4 ) - ( Math::PIdiv4 ) * 0.5f;
 
 		m_steering = circlePos + displacement;
 
@@ -59,7 +59,7 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	sf::Vector2f SteeringEntity::Steer()
 	{
-		sf::Vector2f steeringDirection;
+		sf::Vector2f steeringDirection = m_externalForce;
 		int iNbBehaviors = m_behaviors.size();
 
 		for( int i = 0 ; i < iNbBehaviors ; ++i )
@@ -68,6 +68,8 @@ namespace fzn
 			steeringDirection += behavior->behavior->Update() *= behavior->weight;
 			delete behavior;
 		}
+
+		m_externalForce = sf::Vector2f( 0.f, 0.f );
 		return steeringDirection;
 	}
 
@@ -135,6 +137,15 @@ namespace fzn
 		m_fWanderAngle = 0.f;
 	}
 
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds a force computed outside of the entity's behaviors (formations), applied at the next update
+	//Parameter : Force to add
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void SteeringEntity::AddSteeringForce( const sf::Vector2f& _force )
+	{
+		m_externalForce += _force;
+	}
+
 
 	/////////////////ACCESSORS / MUTATORS/////////////////
 
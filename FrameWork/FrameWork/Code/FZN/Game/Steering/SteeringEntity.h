@@ -51,6 +51,11 @@ namespace fzn
 		//Removes all the behaviors from the entity
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void ClearBehaviors();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a force computed outside of the entity's behaviors (formations), applied at the next update
+		//Parameter : Force to add
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void AddSteeringForce( const sf::Vector2f& _force );
 
 
 		/////////////////ACCESSORS / MUTATORS/////////////////
@@ -77,6 +82,7 @@ namespace fzn
 		/////////////////MEMBER VARIABLES/////////////////
 
 		sf::Vector2f m_lastForce;		//Last force applied to the entity
+		sf::Vector2f m_externalForce;	//Sum of the forces added since the last update
 
 		std::vector<WeightedBehavior*> m_behaviors;			 // All the behaviors and their weight associated
 
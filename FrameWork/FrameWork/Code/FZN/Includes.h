@@ -22,6 +22,7 @@
 #include "Tools/Logging.h"
 #include "Tools/Math.h"
 #include "Tools/Tools.h"
+#include "Tools/Random.h"
 
 #include "Managers/FazonCore.h"
 
@@ -5,14 +5,28 @@
 //Portions Copyright (C) Steve Rabin, 2001
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <chrono>
+
 #include "FZN/Includes.h"
 #include "FZN/Managers/AIManager.h"
+#include "FZN/Managers/MessageManager.h"
 
 
 FZN_EXPORT fzn::AIManager* g_pFZN_AIMgr = nullptr;
 
 namespace fzn
 {
+	namespace
+	{
+		static constexpr uint32_t NotInBatch{ Uint32_Max };
+
+		//Position in the due GameObjects of the one the thread is updating in a batch.
+		thread_local uint32_t t_uBatchObject{ NotInBatch };
+	}
+
 	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -21,6 +35,7 @@ namespace fzn
 	AIManager::AIManager()
 	{
 		m_nextFreeID = 1;
+		m_lodTiers.push_back( { FLT_MAX, 1 } );
 
 		g_pFZN_AIMgr = this;
 	}
@@ -30,7 +45,12 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	AIManager::~AIManager()
 	{
+		_StopWorkers();
+
+		m_scheduledObjects.Clear();
+		m_scheduledObjectsHandles.Clear();
 		m_gameObjects.Clear();
+		m_gameObjectsHandles.Clear();
 
 		g_pFZN_AIMgr = nullptr;
 	}
@@ -48,11 +68,13 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void AIManager::Store(GameObjectAI* _gameObject)
 	{
+		assert( t_uBatchObject == NotInBatch && "GameObjects can't be stored during a batch." );
+
 		if(_gameObject == nullptr)
 			return;
 
-		if(m_gameObjects.FindElement(_gameObject) == nullptr)
-			m_gameObjects.PushBack(_gameObject);
+		if(m_gameObjectsHandles.Find(_gameObject->GetID()) == nullptr)
+			m_gameObjectsHandles.Insert(_gameObject->GetID(), m_gameObjects.GetHandle(m_gameObjects.PushBack(_gameObject)));
 	}
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -76,12 +98,22 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void AIManager::Remove(int _ID)
 	{
+		DeferredCall oCall;
+		oCall.m_eType = DeferredCall::eRemove;
+		oCall.m_iID = _ID;
+
+		if( _DeferCall( oCall ) )
+			return;
+
 		int index = FindGameObject(_ID);
 
 		if(index == -1)
 			return;
 
+		Unschedule(_ID);
+
 		m_gameObjects.Remove(index);
+		m_gameObjectsHandles.Remove(_ID);
 	}
 
 
@@ -111,10 +143,495 @@ namespace fzn
 		m_nextFreeID = 1;
 	}
 
+
+	/////////////////SCHEDULING/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Updates the scheduled GameObjects due this frame, until the frame budget is spent
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::Update()
+	{
+		m_uLastFrameUpdates = 0;
+		m_uLastFrameDuration = 0;
+		++m_uFrame;
+
+		if( m_scheduledObjects.Empty() )
+			return;
+
+		const std::chrono::steady_clock::time_point oStart = std::chrono::steady_clock::now();
+		auto GetElapsedMicroseconds = [ &oStart ]() { return (uint32_t)std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - oStart ).count(); };
+
+		const uint64_t uTime = g_pFZN_Core->GetTimeService().GetTime( TimeDomain::AI );
+
+		//The objects left by the budget of the previous frame come first, then the ones of this frame bucket.
+		//The entries of the removed objects and the ones replaced by a newer entry are dropped.
+		m_dueEntries.clear();
+
+		for( const DueEntry& oEntry : m_lateEntries )
+		{
+			const ScheduledObject* pObject = m_scheduledObjects.Get( oEntry.m_handle );
+
+			if( pObject != nullptr && pObject->m_uDueEntry == oEntry.m_uEntry )
+				m_dueEntries.push_back( oEntry );
+		}
+
+		m_lateEntries.clear();
+
+		std::vector< DueEntry >& oBucket = m_dueBuckets[ m_uFrame % NbDueBuckets ];
+		size_t uNbKeptEntries = 0;
+
+		for( const DueEntry& oEntry : oBucket )
+		{
+			const ScheduledObject* pObject = m_scheduledObjects.Get( oEntry.m_handle );
+
+			if( pObject == nullptr || pObject->m_uDueEntry != oEntry.m_uEntry )
+				continue;
+
+			//Due after another lap of the ring.
+			if( (int32_t)( pObject->m_uNextFrame - m_uFrame ) > 0 )
+				oBucket[ uNbKeptEntries++ ] = oEntry;
+			else
+				m_dueEntries.push_back( oEntry );
+		}
+
+		oBucket.resize( uNbKeptEntries );
+
+		m_dueObjects.clear();
+
+		for( const DueEntry& oEntry : m_dueEntries )
+			m_dueObjects.push_back( m_scheduledObjects.GetIndex( oEntry.m_handle ) );
+
+		//Objects can be unscheduled by the updates, they are only removed at the end so the indices stay valid.
+		m_bUpdating = true;
+
+		const uint32_t uNbDueObjects = (uint32_t)m_dueObjects.size();
+		const uint32_t uMaxBatchSize = (uint32_t)( m_workers.size() + 1 ) * 8;
+		uint32_t uDueObject = 0;
+
+		while( uDueObject < uNbDueObjects )
+		{
+			//At least one object is updated each frame, whatever the budget.
+			if( m_uFrameBudget > 0 && uDueObject > 0 && GetElapsedMicroseconds() >= m_uFrameBudget )
+				break;
+
+			if( m_workers.empty() == false && m_scheduledObjects[ m_dueObjects[ uDueObject ] ].m_bWorkerThread )
+			{
+				uint32_t uBatchEnd = uDueObject + 1;
+
+				while( uBatchEnd < uNbDueObjects && uBatchEnd - uDueObject < uMaxBatchSize && m_scheduledObjects[ m_dueObjects[ uBatchEnd ] ].m_bWorkerThread )
+					++uBatchEnd;
+
+				_RunBatch( uDueObject, uBatchEnd, uTime );
+				uDueObject = uBatchEnd;
+			}
+			else
+				_UpdateScheduledObject( m_dueObjects[ uDueObject++ ], uTime );
+		}
+
+		//The updated objects wait in the bucket of their next frame, the other ones are updated first on the next frame.
+		for( uint32_t uUpdatedObject = 0 ; uUpdatedObject < uDueObject ; ++uUpdatedObject )
+		{
+			if( m_scheduledObjects[ m_dueObjects[ uUpdatedObject ] ].m_pObject != nullptr )
+				_AddDueEntry( m_dueObjects[ uUpdatedObject ] );
+		}
+
+		m_lateEntries.assign( m_dueEntries.begin() + uDueObject, m_dueEntries.end() );
+
+		m_bUpdating = false;
+
+		if( m_bHasUnscheduledObjects )
+			_RemoveUnscheduledObjects();
+
+		m_uLastFrameUpdates = uDueObject;
+		m_uLastFrameDuration = GetElapsedMicroseconds();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Lets the manager update a GameObject (see GameObjectAI::ScheduledUpdate)
+	//Parameter 1 : GameObject to update, it has to be stored in the manager
+	//Parameter 2 : The GameObject update doesn't depend on the others and can be called on a worker thread
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::Schedule( GameObjectAI* _gameObject, bool _bWorkerThread /*= false*/ )
+	{
+		DeferredCall oCall;
+		oCall.m_eType = DeferredCall::eSchedule;
+		oCall.m_pObject = _gameObject;
+		oCall.m_iParameter = _bWorkerThread ? 1 : 0;
+
+		if( _DeferCall( oCall ) )
+			return;
+
+		if( _gameObject == nullptr || FindGameObject( _gameObject->GetID() ) == -1 )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Only the GameObjects stored in the AI manager can be scheduled." );
+			return;
+		}
+
+		if( auto* pHandle = m_scheduledObjectsHandles.Find( _gameObject->GetID() ) )
+		{
+			m_scheduledObjects.Get( pHandle->data )->m_bWorkerThread = _bWorkerThread;
+			return;
+		}
+
+		ScheduledObject oObject;
+		oObject.m_pObject = _gameObject;
+		oObject.m_uNextFrame = m_uFrame + 1;
+		oObject.m_uLastUpdateTime = g_pFZN_Core->GetTimeService().GetTime( TimeDomain::AI );
+		oObject.m_bWorkerThread = _bWorkerThread;
+
+		const int index = m_scheduledObjects.PushBack( oObject );
+
+		m_scheduledObjectsHandles.Insert( _gameObject->GetID(), m_scheduledObjects.GetHandle( index ) );
+		_AddDueEntry( index );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Stops the updates of a GameObject by the manager
+	//Parameter : ID of the GameObject
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::Unschedule( int _ID )
+	{
+		DeferredCall oCall;
+		oCall.m_eType = DeferredCall::eUnschedule;
+		oCall.m_iID = _ID;
+
+		if( _DeferCall( oCall ) )
+			return;
+
+		const auto* pHandle = m_scheduledObjectsHandles.Find( _ID );
+
+		if( pHandle == nullptr )
+			return;
+
+		if( m_bUpdating )
+		{
+			m_scheduledObjects.Get( pHandle->data )->m_pObject = nullptr;
+			m_bHasUnscheduledObjects = true;
+		}
+		else
+			m_scheduledObjects.Remove( pHandle->data );
+
+		m_scheduledObjectsHandles.Remove( _ID );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the levels of detail
+	//Parameter : Tiers, sorted by distance (the last one is used for the GameObjects further than all of them)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::SetLodTiers( const std::vector< LodTier >& _tiers )
+	{
+		if( _tiers.empty() )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "At least one level of detail is needed." );
+			return;
+		}
+
+		m_lodTiers = _tiers;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the position the distance of the GameObjects is computed from
+	//Parameter : Focus point
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::SetLodFocus( const sf::Vector2f& _focus )
+	{
+		m_lodFocus = _focus;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Forces the level of detail of a GameObject, whatever its distance
+	//Parameter 1 : ID of the GameObject
+	//Parameter 2 : Index of the tier (-1 to use the distance again)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::SetForcedLodTier( int _ID, int _tier )
+	{
+		DeferredCall oCall;
+		oCall.m_eType = DeferredCall::eSetForcedLodTier;
+		oCall.m_iID = _ID;
+		oCall.m_iParameter = _tier;
+
+		if( _DeferCall( oCall ) )
+			return;
+
+		const auto* pHandle = m_scheduledObjectsHandles.Find( _ID );
+
+		if( pHandle == nullptr )
+			return;
+
+		ScheduledObject* pObject = m_scheduledObjects.Get( pHandle->data );
+
+		if( pObject->m_iForcedTier != _tier )
+		{
+			//The object could be waiting for a long period, the new tier is applied right away.
+			pObject->m_iForcedTier = _tier;
+			pObject->m_uNextFrame = m_uFrame + 1;
+			_AddDueEntry( m_scheduledObjects.GetIndex( pHandle->data ) );
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the time the updates can take each frame
+	//Parameter : Budget in microseconds (0 for no limit)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::SetFrameBudget( uint32_t _budget )
+	{
+		m_uFrameBudget = _budget;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the number of threads helping the main thread with the GameObjects scheduled on worker threads
+	//Parameter : Number of threads (0 to update everything on the main thread)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::SetWorkerThreadsNumber( uint32_t _threads )
+	{
+		if( m_bUpdating )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "The AI worker threads can't be changed during the update." );
+			return;
+		}
+
+		_StopWorkers();
+
+		for( uint32_t uThread = 0 ; uThread < _threads ; ++uThread )
+			m_workers.emplace_back( &AIManager::_RunWorker, this, m_uBatchId );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Defers a message sent by a GameObject updated in a batch, called by MessageManager::Send
+	//Parameters : See MessageManager::Send
+	//Return value : The calling thread is updating a batch and the message will be sent once it is done (true), or it has to be sent right away
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool AIManager::DeferMessage( float _delay, int _type, int _sender, int _receiver, void* _data, int _state )
+	{
+		DeferredCall oCall;
+		oCall.m_eType = DeferredCall::eSendMessage;
+		oCall.m_fDelay = _delay;
+		oCall.m_iParameter = _type;
+		oCall.m_iSender = _sender;
+		oCall.m_iID = _receiver;
+		oCall.m_pData = _data;
+		oCall.m_iState = _state;
+
+		return _DeferCall( oCall );
+	}
+
 	//=========================================================
 	//==========================PRIVATE=========================
 	//=========================================================
 
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Updates a scheduled GameObject and computes when it has to be updated again
+	//Parameter 1 : Index of the GameObject in the scheduled ones
+	//Parameter 2 : Time of the update (AI time domain, in nanoseconds)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::_UpdateScheduledObject( int _index, uint64_t _uTime )
+	{
+		GameObjectAI* pGameObject = m_scheduledObjects[ _index ].m_pObject;
+
+		if( pGameObject == nullptr )
+			return;
+
+		pGameObject->ScheduledUpdate( ( _uTime - m_scheduledObjects[ _index ].m_uLastUpdateTime ) * 0.000000001f );
+
+		//The update can schedule other objects and reallocate the array, the reference is only taken now.
+		ScheduledObject& oObject = m_scheduledObjects[ _index ];
+
+		if( oObject.m_pObject == nullptr )
+			return;
+
+		oObject.m_uLastUpdateTime = _uTime;
+
+		int iTier = oObject.m_iForcedTier;
+
+		if( iTier < 0 || iTier >= (int)m_lodTiers.size() )
+		{
+			const sf::Vector2f oToFocus = pGameObject->getPosition() - m_lodFocus;
+			const float fSquaredDistance = oToFocus.x * oToFocus.x + oToFocus.y * oToFocus.y;
+
+			iTier = (int)m_lodTiers.size() - 1;
+
+			for( int iLodTier = 0 ; iLodTier < (int)m_lodTiers.size() ; ++iLodTier )
+			{
+				if( fSquaredDistance <= m_lodTiers[ iLodTier ].m_fMaxDistance * m_lodTiers[ iLodTier ].m_fMaxDistance )
+				{
+					iTier = iLodTier;
+					break;
+				}
+			}
+		}
+
+		//The IDs give the objects of a tier different phases, so their updates are spread over the frames of its period.
+		const uint32_t uPeriod = std::max< uint32_t >( m_lodTiers[ iTier ].m_uUpdatePeriod, 1 );
+		oObject.m_uNextFrame = m_uFrame + uPeriod - ( m_uFrame + (uint32_t)pGameObject->GetID() ) % uPeriod;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds a scheduled GameObject to the due bucket of its next frame, invalidating its previous entry
+	//Parameter : Index of the GameObject in the scheduled ones
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::_AddDueEntry( int _index )
+	{
+		ScheduledObject& oObject = m_scheduledObjects[ _index ];
+
+		DueEntry oEntry;
+		oEntry.m_handle = m_scheduledObjects.GetHandle( _index );
+		oEntry.m_uEntry = ++oObject.m_uDueEntry;
+
+		m_dueBuckets[ oObject.m_uNextFrame % NbDueBuckets ].push_back( oEntry );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Keeps a call made during a batch for the end of the batch
+	//Parameter : Call
+	//Return value : The calling thread is updating a batch and the call is deferred (true), or it has to be made right away
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool AIManager::_DeferCall( DeferredCall& _call )
+	{
+		if( t_uBatchObject == NotInBatch )
+			return false;
+
+		_call.m_uDueObject = t_uBatchObject;
+
+		std::lock_guard< std::mutex > oLock( m_deferredCallsMutex );
+		m_deferredCalls.push_back( _call );
+
+		return true;
+	}
+
+	void AIManager::_ApplyDeferredCalls()
+	{
+		if( m_deferredCalls.empty() )
+			return;
+
+		//The threads pick the objects in any order, the calls are applied as if the objects had been updated one after the other.
+		std::stable_sort( m_deferredCalls.begin(), m_deferredCalls.end(), []( const DeferredCall& _callA, const DeferredCall& _callB ) { return _callA.m_uDueObject < _callB.m_uDueObject; } );
+
+		for( const DeferredCall& oCall : m_deferredCalls )
+		{
+			switch( oCall.m_eType )
+			{
+			case DeferredCall::eRemove:
+				Remove( oCall.m_iID );
+				break;
+			case DeferredCall::eSchedule:
+				Schedule( oCall.m_pObject, oCall.m_iParameter != 0 );
+				break;
+			case DeferredCall::eUnschedule:
+				Unschedule( oCall.m_iID );
+				break;
+			case DeferredCall::eSetForcedLodTier:
+				SetForcedLodTier( oCall.m_iID, oCall.m_iParameter );
+				break;
+			case DeferredCall::eSendMessage:
+				if( g_pFZN_MessageMgr != nullptr )
+					g_pFZN_MessageMgr->Send( oCall.m_fDelay, oCall.m_iParameter, oCall.m_iSender, oCall.m_iID, oCall.m_pData, oCall.m_iState );
+				break;
+			}
+		}
+
+		m_deferredCalls.clear();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Updates the due GameObjects of the batch until there isn't any left, called by the main thread and the workers
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::_ProcessBatch()
+	{
+		for( uint32_t uDueObject = m_uNextBatchObject.fetch_add( 1 ) ; uDueObject < m_uBatchEnd ; uDueObject = m_uNextBatchObject.fetch_add( 1 ) )
+		{
+			t_uBatchObject = uDueObject;
+			_UpdateScheduledObject( m_dueObjects[ uDueObject ], m_uBatchTime );
+		}
+
+		t_uBatchObject = NotInBatch;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Updates consecutive due GameObjects on the worker threads and the main thread
+	//Parameter 1 : First GameObject in the due ones
+	//Parameter 2 : Index following the last GameObject in the due ones
+	//Parameter 3 : Time of the update (AI time domain, in nanoseconds)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::_RunBatch( uint32_t _uFirst, uint32_t _uEnd, uint64_t _uTime )
+	{
+		{
+			std::lock_guard< std::mutex > oLock( m_workersMutex );
+			m_uBatchEnd = _uEnd;
+			m_uBatchTime = _uTime;
+			m_uNextBatchObject.store( _uFirst );
+			m_uBusyWorkers = (uint32_t)m_workers.size();
+			++m_uBatchId;
+		}
+
+		m_workersCondition.notify_all();
+		_ProcessBatch();
+
+		{
+			std::unique_lock< std::mutex > oLock( m_workersMutex );
+			m_batchDoneCondition.wait( oLock, [ this ]() { return m_uBusyWorkers == 0; } );
+		}
+
+		_ApplyDeferredCalls();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Worker thread loop, processing the batches until the workers are stopped
+	//Parameter : Last batch when the thread was created, the following ones have to be processed
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::_RunWorker( uint32_t _uBatchId )
+	{
+		std::unique_lock< std::mutex > oLock( m_workersMutex );
+		uint32_t uLastBatchId = _uBatchId;
+
+		while( true )
+		{
+			m_workersCondition.wait( oLock, [ this, &uLastBatchId ]() { return m_bStopWorkers || m_uBatchId != uLastBatchId; } );
+
+			if( m_bStopWorkers )
+				return;
+
+			uLastBatchId = m_uBatchId;
+
+			oLock.unlock();
+			_ProcessBatch();
+			oLock.lock();
+
+			if( --m_uBusyWorkers == 0 )
+				m_batchDoneCondition.notify_one();
+		}
+	}
+
+	void AIManager::_StopWorkers()
+	{
+		{
+			std::lock_guard< std::mutex > oLock( m_workersMutex );
+			m_bStopWorkers = true;
+		}
+
+		m_workersCondition.notify_all();
+
+		for( std::thread& oWorker : m_workers )
+			oWorker.join();
+
+		m_workers.clear();
+		m_bStopWorkers = false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes the GameObjects unscheduled during the update
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void AIManager::_RemoveUnscheduledObjects()
+	{
+		//Going backward, the object moved in place of a removed one has already been checked.
+		for( int iObject = m_scheduledObjects.Size() - 1 ; iObject >= 0 ; --iObject )
+		{
+			if( m_scheduledObjects[ iObject ].m_pObject == nullptr )
+				m_scheduledObjects.Remove( iObject );
+		}
+
+		m_bHasUnscheduledObjects = false;
+	}
+
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	//Finds a GameObject from its ID
 	//Parameter : Id of the GameObject
@@ -125,18 +642,11 @@ namespace fzn
 		if(_ID <= 0 || _ID > m_nextFreeID)
 			return -1;
 
-		int iNbAIs = m_gameObjects.Size();
-		int IndexInArray = -1;
+		const auto* pHandle = m_gameObjectsHandles.Find(_ID);
 
-		for(int i=0 ; i<iNbAIs ; ++i)
-		{
-			if(m_gameObjects[i]->GetID() == _ID)
-			{
-				IndexInArray = i;
-				i = iNbAIs;
-			}
-		}
+		if(pHandle == nullptr)
+			return -1;
 
-		return IndexInArray;
+		return m_gameObjects.GetIndex(pHandle->data);
 	}
 } //namespace fzn
@@ -9,14 +9,32 @@
 #ifndef _AIMANAGER_H_
 #define _AIMANAGER_H_
 
-#include "FZN/DataStructure/Vector.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "FZN/DataStructure/DenseArray.h"
+#include "FZN/DataStructure/HashMap.h"
 #include "FZN/Game/GameObjectAI/GameObjectAI.h"
 
 #define NewID g_pFZN_AIMgr->GetNewObjectID()
 #define MaxID g_pFZN_AIMgr->GetCurrentMaxID()
 
+#pragma warning( push )
+#pragma warning( disable: 4251 )
+
 namespace fzn
 {
+	//The scheduled GameObjects are updated by the manager instead of the game, at a frequency depending on their level of detail.
+	//The level of detail of a GameObject is given by its distance to a focus point (camera, player...) or forced by the game if it is relevant for another reason.
+	//The updates of a frame stop once the frame budget is spent, the remaining GameObjects being updated first on the next frame.
+	//The GameObjects scheduled on worker threads are updated in batches. During a batch, Store is forbidden (asserted) and the calls to Remove, Schedule, Unschedule,
+	//SetForcedLodTier and MessageManager::Send are deferred: they are applied by the main thread once the batch is done, in the order of the updates that made them.
+	//Apart from the messages, these updates must not use the other managers nor log anything.
 	class FZN_EXPORT AIManager : public sf::NonCopyable
 	{
 	public:
@@ -66,7 +84,157 @@ namespace fzn
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void ResetObjectID();
 
+
+		/////////////////SCHEDULING/////////////////
+
+		//Level of detail of the GameObjects closer to the focus point than its distance
+		struct LodTier
+		{
+			float		m_fMaxDistance;
+			uint32_t	m_uUpdatePeriod;					//Number of frames between two updates
+		};
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Updates the scheduled GameObjects due this frame, until the frame budget is spent
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Update();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Lets the manager update a GameObject (see GameObjectAI::ScheduledUpdate)
+		//Parameter 1 : GameObject to update, it has to be stored in the manager
+		//Parameter 2 : The GameObject update doesn't depend on the others and can be called on a worker thread (see the restrictions above)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Schedule( GameObjectAI* _gameObject, bool _bWorkerThread = false );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Stops the updates of a GameObject by the manager
+		//Parameter : ID of the GameObject
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Unschedule( int _ID );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the levels of detail
+		//Parameter : Tiers, sorted by distance (the last one is used for the GameObjects further than all of them)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetLodTiers( const std::vector< LodTier >& _tiers );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the position the distance of the GameObjects is computed from
+		//Parameter : Focus point
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetLodFocus( const sf::Vector2f& _focus );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Forces the level of detail of a GameObject, whatever its distance
+		//Parameter 1 : ID of the GameObject
+		//Parameter 2 : Index of the tier (-1 to use the distance again)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetForcedLodTier( int _ID, int _tier );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the time the updates can take each frame
+		//Parameter : Budget in microseconds (0 for no limit)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetFrameBudget( uint32_t _budget );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the number of threads helping the main thread with the GameObjects scheduled on worker threads
+		//Parameter : Number of threads (0 to update everything on the main thread)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetWorkerThreadsNumber( uint32_t _threads );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the number of GameObjects updated during the last frame
+		//Return value : Number of updates
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		uint32_t GetLastFrameUpdatesNumber() const { return m_uLastFrameUpdates; }
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the time spent updating the GameObjects during the last frame
+		//Return value : Time in microseconds
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		uint32_t GetLastFrameDuration() const { return m_uLastFrameDuration; }
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Defers a message sent by a GameObject updated in a batch, called by MessageManager::Send
+		//Parameters : See MessageManager::Send
+		//Return value : The calling thread is updating a batch and the message will be sent once it is done (true), or it has to be sent right away
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool DeferMessage( float _delay, int _type, int _sender, int _receiver, void* _data, int _state );
+
 	private:
+		struct ScheduledObject
+		{
+			GameObjectAI*	m_pObject{ nullptr };			//nullptr once unscheduled during the update
+			uint32_t		m_uNextFrame{ 0 };
+			uint64_t		m_uLastUpdateTime{ 0 };			//AI time domain (nanoseconds)
+			int				m_iForcedTier{ -1 };
+			uint32_t		m_uDueEntry{ 0 };				//Identifier of the only valid entry of the object in the due buckets
+			bool			m_bWorkerThread{ false };
+		};
+
+		//Entry of a scheduled GameObject in the due bucket of its next frame, ignored once the object is removed or has a newer entry.
+		struct DueEntry
+		{
+			DenseArray<ScheduledObject>::Handle	m_handle;
+			uint32_t							m_uEntry{ 0 };
+		};
+
+		//Call made by a GameObject updated in a batch, applied by the main thread once the batch is done.
+		struct DeferredCall
+		{
+			enum Type : uint8_t
+			{
+				eRemove,
+				eSchedule,
+				eUnschedule,
+				eSetForcedLodTier,
+				eSendMessage,
+			};
+
+			Type			m_eType{ eRemove };
+			uint32_t		m_uDueObject{ 0 };				//Position of the calling GameObject in the due ones, to apply the calls in the order of the updates
+			int				m_iID{ 0 };						//GameObject ID, receiver of the message
+			int				m_iParameter{ 0 };				//Tier, worker thread flag, type of the message
+			GameObjectAI*	m_pObject{ nullptr };
+			float			m_fDelay{ 0.f };
+			int				m_iSender{ 0 };
+			int				m_iState{ -1 };
+			void*			m_pData{ nullptr };
+		};
+
+		static constexpr uint32_t NbDueBuckets{ 64 };		//Frames covered by the ring of due buckets, the objects due later wait in the bucket for more laps
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Updates a scheduled GameObject and computes when it has to be updated again
+		//Parameter 1 : Index of the GameObject in the scheduled ones
+		//Parameter 2 : Time of the update (AI time domain, in nanoseconds)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _UpdateScheduledObject( int _index, uint64_t _uTime );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a scheduled GameObject to the due bucket of its next frame, invalidating its previous entry
+		//Parameter : Index of the GameObject in the scheduled ones
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _AddDueEntry( int _index );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Keeps a call made during a batch for the end of the batch
+		//Parameter : Call
+		//Return value : The calling thread is updating a batch and the call is deferred (true), or it has to be made right away
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool _DeferCall( DeferredCall& _call );
+		void _ApplyDeferredCalls();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Updates the due GameObjects of the batch until there isn't any left, called by the main thread and the workers
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _ProcessBatch();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Updates consecutive due GameObjects on the worker threads and the main thread
+		//Parameter 1 : First GameObject in the due ones
+		//Parameter 2 : Index following the last GameObject in the due ones
+		//Parameter 3 : Time of the update (AI time domain, in nanoseconds)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _RunBatch( uint32_t _uFirst, uint32_t _uEnd, uint64_t _uTime );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Worker thread loop, processing the batches until the workers are stopped
+		//Parameter : Last batch when the thread was created, the following ones have to be processed
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _RunWorker( uint32_t _uBatchId );
+		void _StopWorkers();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes the GameObjects unscheduled during the update
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void _RemoveUnscheduledObjects();
+
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		//Finds a GameObject from its ID
 		//Parameter : Id of the GameObject
@@ -77,10 +245,42 @@ namespace fzn
 		/////////////////MEMBER VARIABLES/////////////////
 
 		int m_nextFreeID;										//ID of the next GameObject created
-		Vector<GameObjectAI*> m_gameObjects;					//Array of Game Objects
+		DenseArray<GameObjectAI*> m_gameObjects;				//Array of Game Objects
+		HashMap<int, DenseArray<GameObjectAI*>::Handle> m_gameObjectsHandles;	//Handle of each Game Object in the array, by ID
+
+		DenseArray<ScheduledObject> m_scheduledObjects;
+		HashMap<int, DenseArray<ScheduledObject>::Handle> m_scheduledObjectsHandles;	//Handle of each scheduled Game Object, by ID
+		std::vector<DueEntry> m_dueBuckets[ NbDueBuckets ];		//Entries of the scheduled Game Objects, by next frame modulo NbDueBuckets
+		std::vector<DueEntry> m_lateEntries;					//Due Game Objects left by the frame budget, updated first on the next frame
+		std::vector<DueEntry> m_dueEntries;						//Entries of the Game Objects to update this frame
+		std::vector<int> m_dueObjects;							//Indices of the scheduled Game Objects to update this frame
+		std::vector<LodTier> m_lodTiers;
+		sf::Vector2f m_lodFocus;
+		uint32_t m_uFrame{ 0 };
+		uint32_t m_uFrameBudget{ 0 };
+		uint32_t m_uLastFrameUpdates{ 0 };
+		uint32_t m_uLastFrameDuration{ 0 };
+		bool m_bUpdating{ false };
+		bool m_bHasUnscheduledObjects{ false };
+
+		std::vector<std::thread> m_workers;
+		std::mutex m_workersMutex;
+		std::condition_variable m_workersCondition;			//Signals a new batch or the end of the workers
+		std::condition_variable m_batchDoneCondition;
+		uint32_t m_uBatchId{ 0 };
+		uint32_t m_uBusyWorkers{ 0 };
+		uint32_t m_uBatchEnd{ 0 };
+		uint64_t m_uBatchTime{ 0 };
+		std::atomic<uint32_t> m_uNextBatchObject{ 0 };
+		bool m_bStopWorkers{ false };
+
+		std::mutex m_deferredCallsMutex;
+		std::vector<DeferredCall> m_deferredCalls;
 	};
 } //namespace fzn
 
+#pragma warning( pop )
+
 extern FZN_EXPORT fzn::AIManager* g_pFZN_AIMgr;
 
 #endif //_AIMANAGER_H_
@@ -8,12 +8,23 @@
 #include <Fmod/fmod.hpp>
 #include "FZN/Managers/AudioManager.h"
 #include "FZN/Managers/DataManager.h"
+#include "FZN/Tools/FileWatcher.h"
 
 
 FZN_EXPORT fzn::AudioManager* g_pFZN_AudioMgr = nullptr;
 
 const char* SOUNDS_FILE_NAME = "XMLFiles/Sounds.xml";
 
+static fzn::VoiceBackend* CreateVoiceBackend( fzn::AudioBackendType _eBackend )
+{
+	switch( _eBackend )
+	{
+	case fzn::AudioBackendType::eNull:		return new fzn::NullVoiceBackend();
+	case fzn::AudioBackendType::eOffline:	return new fzn::OfflineVoiceBackend( fzn::VoiceManager::DefaultNbRealVoices );
+	default:								return new fzn::SfmlVoiceBackend( fzn::VoiceManager::DefaultNbRealVoices );
+	}
+}
+
 namespace fzn
 {
 	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
@@ -21,8 +32,10 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	//Default constructor
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-	AudioManager::AudioManager( bool _bUseFMOD /*= false*/ )
+	AudioManager::AudioManager( bool _bUseFMOD /*= false*/, AudioBackendType _eBackend /*= AudioBackendType::eSFML*/ )
 		: m_bUseFMOD( _bUseFMOD )
+		, m_eBackend( _eBackend )
+		, m_oVoices( CreateVoiceBackend( _eBackend ) )
 	{
 		if( m_bUseFMOD )
 		{
@@ -46,23 +59,7 @@ namespace fzn
 		if( m_system != nullptr )
 			m_system->release();
 
-		SoundInstances::iterator itSound = m_oSounds.begin();
-		while( itSound != m_oSounds.end() )
-		{
-			CheckNullptrDelete( itSound->m_pSound );
-
-			++itSound;
-		}
-		m_oSounds.clear();
-
-		itSound = m_oAvailableSounds.begin();
-		while( itSound != m_oAvailableSounds.end() )
-		{
-			CheckNullptrDelete( itSound->m_pSound );
-
-			++itSound;
-		}
-		m_oAvailableSounds.clear();
+		m_oVoices.StopAll();
 
 		g_pFZN_AudioMgr = nullptr;
 	}
@@ -71,7 +68,7 @@ namespace fzn
 	/////////////////MANAGEMENT FUNCTIONS/////////////////
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-	//Updates the channels
+	//Updates the channels, the voices and the mixer (the offline backend only starts the waiting sounds, its voices and mixer are advanced by RenderOffline)
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void AudioManager::Update()
 	{
@@ -83,30 +80,49 @@ namespace fzn
 
 		_CheckWaitingList();
 
-		SoundInstances::iterator itSound = m_oSounds.begin();
-		while( itSound != m_oSounds.end() )
+		//The offline output is advanced by the duration of the rendered frames (RenderOffline), so it doesn't depend on the frame rate.
+		if( m_eBackend == AudioBackendType::eOffline )
+			return;
+
+		const float fDeltaTime = m_oVoicesClock.restart().asSeconds();
+
+		m_oVoices.Update( fDeltaTime );
+		_UpdateMixer( fDeltaTime );
+	}
+
+	bool AudioManager::RenderOffline( std::vector< float >& _oOutput, uint32_t _uNbFrames )
+	{
+		if( m_eBackend != AudioBackendType::eOffline )
 		{
-			bool bRemove = false;
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "The audio manager doesn't use the offline backend." );
+			return false;
+		}
 
-			if( itSound->m_pSound != nullptr )
-			{
-				if( itSound->m_pSound->getStatus() == sf::Music::Stopped )
-					bRemove = true;
-			}
-			else
-				bRemove = true;
+		OfflineVoiceBackend* pBackend = static_cast< OfflineVoiceBackend* >( m_oVoices.GetBackend() );
 
-			if( bRemove )
-			{
-				SoundInfo oSoundInfo = *itSound;
+		_oOutput.resize( 2 * (size_t)_uNbFrames );
+		pBackend->Render( _oOutput.data(), _uNbFrames );
 
-				m_oAvailableSounds.push_back( oSoundInfo );
+		//The voices and the mixer are advanced by exactly the rendered duration, two renders of the same sounds give the same output.
+		const float fDeltaTime = (float)_uNbFrames / pBackend->GetSampleRate();
 
-				itSound = m_oSounds.erase( itSound );
-			}
-			else
-				++itSound;
-		}
+		m_oVoices.Update( fDeltaTime );
+		_UpdateMixer( fDeltaTime );
+
+		return true;
+	}
+
+	void AudioManager::OnFileModified( const std::string& _sPath )
+	{
+		if( _sPath != FileWatcher::NormalizePath( DATAPATH( SOUNDS_FILE_NAME ) ) )
+			return;
+
+		FZN_LOG( "Reloading sound pool." );
+
+		m_oSoundPool.clear();
+		_LoadSoundPoolFromXML();
+
+		++m_uSoundsGeneration;
 	}
 
 
@@ -130,39 +146,40 @@ namespace fzn
 
 	void AudioManager::Sound_Play( const std::string& _sSound, bool _bOnlyOne /*= false*/, bool _bLoop /*= false */ )
 	{
-		if( _sSound.empty() )
+		Sound_Play( GetSoundHandle( _sSound ), _bOnlyOne, _bLoop );
+	}
+
+	void AudioManager::Sound_Play( SoundHandle _uSound, bool _bOnlyOne /*= false*/, bool _bLoop /*= false */ )
+	{
+		if( _uSound >= m_oResolvedSounds.size() )
 			return;
 
-		if( _bOnlyOne )
-		{
-			SoundInstances::iterator itSound = _FindSound( m_oSounds, _sSound );
+		ResolvedSound& oResolvedSound = m_oResolvedSounds[ _uSound ];
 
-			if( itSound != m_oSounds.end() )
-			{
-				if( _bLoop )
-					++itSound->m_iNbInstances;
+		if( _bOnlyOne && m_oVoices.IsValid( oResolvedSound.m_uVoice ) )
+		{
+			if( _bLoop )
+				m_oVoices.AddInstance( oResolvedSound.m_uVoice );
 
-				return;
-			}
+			return;
 		}
 
-		SoundInstances::iterator itSound = _FindSound( m_oWaitingList, _sSound );
-
-		if( itSound != m_oWaitingList.end() )
+		if( oResolvedSound.m_iWaitingIndex >= 0 )
 		{
 			if( _bOnlyOne && _bLoop )
-				++itSound->m_iNbInstances;
+				++m_oWaitingList[ oResolvedSound.m_iWaitingIndex ].m_iNbInstances;
 
 			return;
 		}
 
 		SoundInfo oSound;
-		oSound.m_sName = _sSound;
+		oSound.m_uSound = _uSound;
 		oSound.m_bLoop = _bLoop;
 
 		if( _bOnlyOne && _bLoop )
 			++oSound.m_iNbInstances;
 
+		oResolvedSound.m_iWaitingIndex = (int)m_oWaitingList.size();
 		m_oWaitingList.push_back( oSound );
 	}
 
@@ -193,65 +210,53 @@ namespace fzn
 
 	void AudioManager::Sound_Stop( const std::string& _sSound )
 	{
-		if( _sSound.empty() )
+		Sound_Stop( GetSoundHandle( _sSound ) );
+	}
+
+	void AudioManager::Sound_Stop( SoundHandle _uSound )
+	{
+		if( _uSound >= m_oResolvedSounds.size() )
 			return;
 
-		SoundInstances::iterator itSound = _FindSound( m_oSounds, _sSound );
+		ResolvedSound& oResolvedSound = m_oResolvedSounds[ _uSound ];
 
-		if( itSound != m_oSounds.end() )
+		if( m_oVoices.IsValid( oResolvedSound.m_uVoice ) )
 		{
-			if( itSound->m_iNbInstances > 0 )
-				--itSound->m_iNbInstances;
-
-			if( itSound->m_iNbInstances <= 0 )
-				itSound->m_pSound->stop();
-
+			m_oVoices.RemoveInstance( oResolvedSound.m_uVoice );
 			return;
 		}
 
-		itSound = _FindSound( m_oWaitingList, _sSound );
+		if( oResolvedSound.m_iWaitingIndex < 0 )
+			return;
 
-		if( itSound != m_oWaitingList.end() )
-		{
-			if( itSound->m_iNbInstances > 0 )
-				--itSound->m_iNbInstances;
+		SoundInfo& oSound = m_oWaitingList[ oResolvedSound.m_iWaitingIndex ];
 
-			if( itSound->m_iNbInstances <= 0 )
-				m_oWaitingList.erase( itSound );
-		}
+		if( oSound.m_iNbInstances > 0 )
+			--oSound.m_iNbInstances;
+
+		if( oSound.m_iNbInstances > 0 )
+			return;
+
+		//The waiting sounds are all started on the next update, their order doesn't matter.
+		oSound = m_oWaitingList.back();
+		m_oResolvedSounds[ oSound.m_uSound ].m_iWaitingIndex = oResolvedSound.m_iWaitingIndex;
+		oResolvedSound.m_iWaitingIndex = -1;
+		m_oWaitingList.pop_back();
 	}
 
 	void AudioManager::Sound_PauseAll()
 	{
-		for( SoundInfo& oSound : m_oSounds )
-		{
-			if( oSound.m_pSound != nullptr && oSound.m_pSound->getStatus() == sf::Sound::Playing )
-			{
-				oSound.m_pSound->pause();
-			}
-		}
+		m_oVoices.PauseAll();
 	}
 
 	void AudioManager::Sound_ResumeAll()
 	{
-		for( SoundInfo& oSound : m_oSounds )
-		{
-			if( oSound.m_pSound != nullptr && oSound.m_pSound->getStatus() == sf::Sound::Paused )
-			{
-				oSound.m_pSound->play();
-			}
-		}
+		m_oVoices.ResumeAll();
 	}
 
 	void AudioManager::Sound_StopAll()
 	{
-		for( SoundInfo& oSound : m_oSounds )
-		{
-			if( oSound.m_pSound != nullptr )
-			{
-				oSound.m_pSound->stop();
-			}
-		}
+		m_oVoices.StopAll();
 	}
 
 	void AudioManager::Music_Play( const std::string& _sMusic, bool _bLoop, Audio::MusicCallbackPtr _pCallback, bool _bDeleteCallback )
@@ -275,7 +280,7 @@ namespace fzn
 		if( m_oMusic.m_pMusic != nullptr )
 		{
 			m_oMusic.m_pMusic->setLoop( _bLoop );
-			m_oMusic.m_pMusic->setVolume( m_fMusicVolume );
+			m_oMusic.m_pMusic->setVolume( m_fMusicVolume * m_oMixer.GetOutputGain( AudioBus::eMusic ) );
 
 			m_oMusic.m_pMusic->stop();
 			m_oMusic.m_pMusic->play();
@@ -330,6 +335,21 @@ namespace fzn
 		return m_system;
 	}
 
+	VoiceManager& AudioManager::GetVoiceManager()
+	{
+		return m_oVoices;
+	}
+
+	AudioMixer& AudioManager::GetMixer()
+	{
+		return m_oMixer;
+	}
+
+	AudioBackendType AudioManager::GetBackendType() const
+	{
+		return m_eBackend;
+	}
+
 	bool AudioManager::IsUsingFMOD() const
 	{
 		return m_bUseFMOD;
@@ -342,9 +362,9 @@ namespace fzn
 
 		Sounds::const_iterator itSound = m_oSoundPool.find( _sSound );
 
-		if( itSound != m_oSoundPool.end() && itSound->second.empty() == false )
+		if( itSound != m_oSoundPool.end() && itSound->second.m_oSoundBuffers.empty() == false )
 		{
-			for( const std::string& sSound : itSound->second )
+			for( const std::string& sSound : itSound->second.m_oSoundBuffers )
 			{
 				if( g_pFZN_DataMgr->ResourceExists( fzn::DataManager::ResourceType::eSound, sSound ) == false )
 					return false;
@@ -356,6 +376,38 @@ namespace fzn
 		return g_pFZN_DataMgr->ResourceExists( fzn::DataManager::ResourceType::eSound, _sSound );
 	}
 
+	SoundHandle AudioManager::GetSoundHandle( const std::string& _sSound )
+	{
+		if( _sSound.empty() )
+			return INVALID_SOUND;
+
+		std::unordered_map< std::string, SoundHandle >::const_iterator itHandle = m_oSoundHandles.find( _sSound );
+
+		if( itHandle != m_oSoundHandles.end() )
+			return itHandle->second;
+
+		const SoundHandle uSound = (SoundHandle)m_oResolvedSounds.size();
+
+		m_oResolvedSounds.push_back( ResolvedSound() );
+		m_oResolvedSounds.back().m_sName = _sSound;
+		m_oSoundHandles[ _sSound ] = uSound;
+
+		return uSound;
+	}
+
+	void AudioManager::InvalidateSoundBuffers( const sf::SoundBuffer* _pUnloadedBuffer /*= nullptr*/ )
+	{
+		if( _pUnloadedBuffer != nullptr )
+			m_oVoices.StopBuffer( _pUnloadedBuffer );
+
+		++m_uSoundsGeneration;
+	}
+
+	void AudioManager::OnSoundBufferReloaded( const sf::SoundBuffer* _pBuffer )
+	{
+		m_oVoices.RefreshBuffer( _pBuffer );
+	}
+
 	void AudioManager::SetSoundsVolume( float _fVolume )
 	{
 		m_fSoundsVolume = fzn::Math::Clamp( _fVolume, 0.f, 100.f );
@@ -399,12 +451,16 @@ namespace fzn
 		while( pSound != nullptr )
 		{
 			std::string sSoundName = fzn::Tools::XMLStringAttribute( pSound, "Name" );
+			SoundDesc& oSoundDesc = m_oSoundPool[ sSoundName ];
+
+			oSoundDesc.m_iPriority = pSound->IntAttribute( "Priority", VoiceManager::DefaultPriority );
+			oSoundDesc.m_eBus = AudioMixer::GetBusFromName( fzn::Tools::XMLStringAttribute( pSound, "Bus" ) );
 
 			tinyxml2::XMLElement* pSoundBuffer = pSound->FirstChildElement( "SoundBuffer" );
 
 			while( pSoundBuffer != nullptr )
 			{
-				m_oSoundPool[ sSoundName ].push_back( fzn::Tools::XMLStringAttribute( pSoundBuffer, "Name" ) );
+				oSoundDesc.m_oSoundBuffers.push_back( fzn::Tools::XMLStringAttribute( pSoundBuffer, "Name" ) );
 				pSoundBuffer = pSoundBuffer->NextSiblingElement();
 			}
 
@@ -416,71 +472,88 @@ namespace fzn
 	{
 		for( const SoundInfo& oSound : m_oWaitingList )
 		{
+			m_oResolvedSounds[ oSound.m_uSound ].m_iWaitingIndex = -1;
 			_PlaySound( oSound );
 		}
 
 		m_oWaitingList.clear();
 	}
 
-	void AudioManager::_PlaySound( const SoundInfo& _oSound )
+	void AudioManager::_UpdateMixer( float _fDeltaTime )
 	{
-		std::string sSound = "";
-		Sounds::iterator itSound = m_oSoundPool.find( _oSound.m_sName );
+		uint16_t aNbActiveVoices[ AudioMixer::NbBuses ];
 
-		if( itSound != m_oSoundPool.end() )
-		{
-			if( itSound->second.empty() )
-				return;
+		for( uint8_t uBus = 0; uBus < AudioMixer::NbBuses; ++uBus )
+			aNbActiveVoices[ uBus ] = m_oVoices.GetNbActiveVoices( uBus );
 
-			const int iRandomSoundBuffer = Rand( 0, itSound->second.size() );
-			sSound = itSound->second[ iRandomSoundBuffer ];
-		}
-		else
-			sSound = _oSound.m_sName;
+		const bool bMusicPlaying = m_oMusic.m_pMusic != nullptr && m_oMusic.m_pMusic->getStatus() == sf::Music::Playing;
+		aNbActiveVoices[ (uint8_t)AudioBus::eMusic ] += bMusicPlaying ? 1 : 0;
 
-		SoundInfo* pSound = nullptr;
+		if( m_oMixer.Update( _fDeltaTime, aNbActiveVoices ) == false )
+			return;
 
-		if( m_oAvailableSounds.empty() == false )
-		{
-			m_oSounds.push_back( m_oAvailableSounds.back() );
-			pSound = &m_oSounds.back();
-			m_oAvailableSounds.pop_back();
-		}
-		else if( m_oSounds.size() < 100 )
-		{
-			m_oSounds.push_back( SoundInfo() );
-			pSound = &m_oSounds.back();
-			pSound->m_pSound = new sf::Sound();
-		}
+		m_oVoices.SetBusGains( m_oMixer.GetOutputGains(), AudioMixer::NbBuses );
 
-		if( pSound != nullptr )
-		{
-			pSound->m_sName = sSound;
+		if( m_oMusic.m_pMusic != nullptr )
+			m_oMusic.m_pMusic->setVolume( m_fMusicVolume * m_oMixer.GetOutputGain( AudioBus::eMusic ) );
+	}
 
-			sf::SoundBuffer* pSoundBuffer = g_pFZN_DataMgr->GetSoundBuffer( pSound->m_sName );
+	void AudioManager::_PlaySound( const SoundInfo& _oSound )
+	{
+		ResolvedSound& oSound = m_oResolvedSounds[ _oSound.m_uSound ];
 
-			if( pSoundBuffer == nullptr )
-			{
-				pSound->m_pSound->stop();	// Stopping the sound for good measure and leaving it for the update to put it in the available sounds vector.
-				return;
-			}
+		if( oSound.m_uGeneration != m_uSoundsGeneration )
+			_ResolveSound( oSound );
 
-			pSound->m_pSound->setBuffer( *pSoundBuffer );
-			pSound->m_pSound->setVolume( m_fSoundsVolume );
-			pSound->m_pSound->setLoop( _oSound.m_bLoop );
-			pSound->m_pSound->play();
+		if( oSound.m_oSoundBuffers.empty() )
+			return;
 
-			if( _oSound.m_bLoop )
-				pSound->m_iNbInstances += _oSound.m_iNbInstances;
+		const int iRandomSoundBuffer = oSound.m_oSoundBuffers.size() > 1 ? Rand( 0, oSound.m_oSoundBuffers.size() ) : 0;
+		sf::SoundBuffer* pSoundBuffer = oSound.m_oSoundBuffers[ iRandomSoundBuffer ];
+
+		if( pSoundBuffer == nullptr )
+			return;
+
+		VoiceManager::PlayDesc oDesc;
+		oDesc.m_uSound		= _oSound.m_uSound;
+		oDesc.m_iPriority	= oSound.m_iPriority;
+		oDesc.m_fVolume		= m_fSoundsVolume;
+		oDesc.m_uBus		= (uint8_t)oSound.m_eBus;
+		oDesc.m_bLoop		= _oSound.m_bLoop;
+
+		const VoiceHandle uVoice = m_oVoices.Play( *pSoundBuffer, oDesc );
+
+		if( uVoice != INVALID_VOICE )
+			oSound.m_uVoice = uVoice;
+
+		//The voice starts with one instance, the other "only one" requests of the frame are added to it.
+		if( uVoice != INVALID_VOICE && _oSound.m_bLoop )
+		{
+			for( int iInstance = 1; iInstance < _oSound.m_iNbInstances; ++iInstance )
+				m_oVoices.AddInstance( uVoice );
 		}
 	}
 
-	fzn::AudioManager::SoundInstances::iterator AudioManager::_FindSound( SoundInstances& _oVector, const std::string& _sSound ) const
+	void AudioManager::_ResolveSound( ResolvedSound& _oSound )
 	{
-		return std::find_if( _oVector.begin(), _oVector.end(), [ _sSound ]( const SoundInfo& oSound )
-			{
-				return oSound.m_sName == _sSound;
-			} );
+		_oSound.m_oSoundBuffers.clear();
+		_oSound.m_iPriority		= VoiceManager::DefaultPriority;
+		_oSound.m_eBus			= AudioBus::eSFX;			//Bus of the sounds that aren't in the sound pool
+		_oSound.m_uGeneration	= m_uSoundsGeneration;
+
+		Sounds::const_iterator itSound = m_oSoundPool.find( _oSound.m_sName );
+
+		if( itSound == m_oSoundPool.end() )
+		{
+			_oSound.m_oSoundBuffers.push_back( g_pFZN_DataMgr->GetSoundBuffer( _oSound.m_sName ) );
+			return;
+		}
+
+		_oSound.m_iPriority	= itSound->second.m_iPriority;
+		_oSound.m_eBus		= itSound->second.m_eBus;
+
+		for( const std::string& sSoundBuffer : itSound->second.m_oSoundBuffers )
+			_oSound.m_oSoundBuffers.push_back( g_pFZN_DataMgr->GetSoundBuffer( sSoundBuffer ) );
 	}
 
 }
@@ -11,8 +11,11 @@
 #include <vector>
 
 #include <Fmod/fmod.hpp>
+#include <SFML/System/Clock.hpp>
+#include "FZN/Audio/AudioMixer.h"
 #include "FZN/Audio/AudioObject.h"
 #include "FZN/Audio/Channel.h"
+#include "FZN/Audio/VoiceManager.h"
 #include "FZN/Tools/Callbacks.h"
 #include "FZN/Defines.h"
 
@@ -38,6 +41,13 @@ namespace fzn
 		using MusicCallback = Member1DynArgCallback< T, const std::string& >;
 	};
 
+	enum class AudioBackendType : uint8_t
+	{
+		eSFML,
+		eNull,			//No output at all (NullVoiceBackend)
+		eOffline,		//Output rendered on demand in a buffer (OfflineVoiceBackend, see AudioManager::RenderOffline)
+	};
+
 	class FZN_EXPORT AudioManager
 	{
 	public:
@@ -45,8 +55,10 @@ namespace fzn
 
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		//Default constructor
+		//Parameter 1 : Use FMOD for the AudioObjects
+		//Parameter 2 : Device the sounds are played on
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-		AudioManager( bool _bUseFMOD = false );
+		AudioManager( bool _bUseFMOD = false, AudioBackendType _eBackend = AudioBackendType::eSFML );
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		//Default destructor
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -56,9 +68,21 @@ namespace fzn
 		/////////////////MANAGEMENT FUNCTIONS/////////////////
 
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-		//Updates the channels
+		//Updates the channels, the voices and the mixer (the offline backend only starts the waiting sounds, its voices and mixer are advanced by RenderOffline)
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void						Update();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mixes the playing sounds in a buffer then advances the voices and the mixer by the rendered duration, only available with the offline backend
+		//Parameter 1 : Interleaved stereo output, resized to 2 * _uNbFrames samples
+		//Parameter 2 : Number of frames to render
+		//Return value : The output has been rendered (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool						RenderOffline( std::vector< float >& _oOutput, uint32_t _uNbFrames );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Reloads the sound pool if the modified file is the sounds file (used by the hot reload)
+		//Parameter : Normalized path of the modified file
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						OnFileModified( const std::string& _sPath );
 
 
 		/////////////////SOUND FUNCTIONS/////////////////
@@ -71,6 +95,13 @@ namespace fzn
 		void						Sound_Play( AudioObject& _audioObject, FMOD::ChannelGroup* _channelGroup = FMOD_DEFAULT );
 		void						Sound_Play( const std::string& _sSound, bool _bOnlyOne = false, bool _bLoop = false );
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Plays a sound resolved beforehand, without any string lookup
+		//Parameter 1 : Handle on the sound (see GetSoundHandle)
+		//Parameter 2 : Don't play the sound if it's already playing
+		//Parameter 3 : Loop the sound
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						Sound_Play( SoundHandle _uSound, bool _bOnlyOne = false, bool _bLoop = false );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		//Pauses an AudioObject on the right channel
 		//Parameter : AudioObject to pause
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -82,6 +113,7 @@ namespace fzn
 		void						Sound_Resume( AudioObject& _audioObject );
 		void						Sound_Stop( AudioObject& _audioObject );
 		void						Sound_Stop( const std::string& _sSound );
+		void						Sound_Stop( SoundHandle _uSound );
 
 		void						Sound_PauseAll();
 		void						Sound_ResumeAll();
@@ -106,8 +138,31 @@ namespace fzn
 		//Return value : Audio system
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		FMOD::System*				GetAudioSystem();
+		VoiceManager&				GetVoiceManager();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the mixer, its bus gains are applied to the sounds and the music at the next update
+		//Return value : Mixer
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		AudioMixer&					GetMixer();
+		AudioBackendType			GetBackendType() const;
 		bool						IsUsingFMOD() const;
 		bool						IsSoundValid( const std::string& _sSound ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Resolves a sound of the sound pool (or a sound buffer) once so it can be played without any string lookup
+		//Parameter : Name of the sound
+		//Return value : Handle on the sound, the same for every call with the same name (INVALID_SOUND if the name is empty)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		SoundHandle					GetSoundHandle( const std::string& _sSound );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Forces the resolved sounds to look for their buffers again, called by the DataManager when sound buffers are loaded or unloaded
+		//Parameter : Buffer about to be destroyed, its voices are stopped
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						InvalidateSoundBuffers( const sf::SoundBuffer* _pUnloadedBuffer = nullptr );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Refreshes the voices playing a sound buffer loaded again by the hot reload
+		//Parameter : Reloaded buffer
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void						OnSoundBufferReloaded( const sf::SoundBuffer* _pBuffer );
 
 		void						SetSoundsVolume( float _fVolume );
 		float						GetSoundsVolume() const;
@@ -117,12 +172,30 @@ namespace fzn
 	protected:
 		struct SoundInfo
 		{
-			std::string				m_sName{ "" };
-			sf::Sound*				m_pSound{ nullptr };
+			SoundHandle				m_uSound{ INVALID_SOUND };
 			bool					m_bLoop{ false };
 			int						m_iNbInstances{ 0 };
 		};
 
+		struct SoundDesc
+		{
+			StringVector			m_oSoundBuffers;							//One of them is randomly picked each time the sound is played
+			int						m_iPriority{ VoiceManager::DefaultPriority };
+			AudioBus				m_eBus{ AudioBus::eSFX };
+		};
+
+		//Sound pool entry and buffers of a sound, resolved again when the generation of the manager changes.
+		struct ResolvedSound
+		{
+			std::string						m_sName{ "" };
+			std::vector< sf::SoundBuffer* >	m_oSoundBuffers;
+			int								m_iPriority{ VoiceManager::DefaultPriority };
+			AudioBus						m_eBus{ AudioBus::eSFX };
+			uint32_t						m_uGeneration{ 0 };
+			VoiceHandle						m_uVoice{ INVALID_VOICE };		//Last voice started for the sound, invalid once the voice is released (generation check)
+			int								m_iWaitingIndex{ -1 };			//Index in the waiting list, -1 if the sound isn't waiting
+		};
+
 		struct MusicInfo
 		{
 			std::string					m_sName{ "" };
@@ -131,25 +204,32 @@ namespace fzn
 			bool						m_bDeleteCallback{ false };
 		};
 
-		typedef std::unordered_map< std::string, StringVector >	Sounds;
+		typedef std::unordered_map< std::string, SoundDesc >	Sounds;
 		typedef std::vector< SoundInfo >						SoundInstances;
 
 		void						_LoadSoundPoolFromXML();
 
 		void						_CheckWaitingList();
+		void						_UpdateMixer( float _fDeltaTime );
 		void						_PlaySound( const SoundInfo& _oSound );
-		SoundInstances::iterator	_FindSound( SoundInstances& _oVector, const std::string& _sSound ) const;
+		void						_ResolveSound( ResolvedSound& _oSound );
 
 		bool						m_bUseFMOD{ false };
+		AudioBackendType			m_eBackend{ AudioBackendType::eSFML };
 
 		float						m_fSoundsVolume{ 50.f };
 		float						m_fMusicVolume{ 50.f };
 
 		Sounds						m_oSoundPool;
-		SoundInstances				m_oAvailableSounds;	 // Sound infos created before that are available to use instead of creating new ones.
-		SoundInstances				m_oSounds;
 		SoundInstances				m_oWaitingList;
 
+		std::vector< ResolvedSound >						m_oResolvedSounds;		//Indexed by SoundHandle
+		std::unordered_map< std::string, SoundHandle >		m_oSoundHandles;
+		uint32_t											m_uSoundsGeneration{ 1 };
+		VoiceManager				m_oVoices;
+		sf::Clock					m_oVoicesClock;
+		AudioMixer					m_oMixer;
+
 		MusicInfo					m_oMusic;
 
 		FMOD::Channel*				m_channel{ nullptr };
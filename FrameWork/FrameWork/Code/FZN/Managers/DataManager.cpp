@@ -17,6 +17,9 @@
 #include <tinyXML2/tinyxml2.h>
 #include "FZN/Managers/DataManager.h"
 #include "FZN/Tools/Shaders.h"
+#include "FZN/Tools/ResourceManifest.h"
+#include "FZN/Tools/FileWatcher.h"
+#include "FZN/Managers/AudioManager.h"
 
 
 FZN_EXPORT fzn::DataManager* g_pFZN_DataMgr = nullptr;
@@ -167,6 +170,9 @@ namespace fzn
 		m_mapAnimatedObjets.clear();
 		m_mapResourceGroups.clear();
 
+		CheckNullptrDelete( m_pFileWatcher );
+		m_mapWatchedResources.clear();
+
 		g_pFZN_DataMgr = nullptr;
 	}
 
@@ -199,6 +205,7 @@ namespace fzn
 
 			FZN_LOG( "Loading texture \"%s\" at \"%s\".", _szName.c_str(), _path.c_str() );
 
+			_WatchResource( ResourceType::eTexture, _szName, _path );
 			_SendFileLoadedEvent();
 			return m_mapTextures[_szName] = tmpTexture;
 		}
@@ -277,6 +284,7 @@ namespace fzn
 		{
 			FZN_LOG( "Loading animation \"%s\" at \"%s\".", _szName.c_str(), _path.c_str() );
 
+			_WatchResource( ResourceType::eAnimation, _szName, _path );
 			return m_mapAnimations[_szName] = new Animation( _szName, _path );
 		}
 
@@ -347,13 +355,18 @@ namespace fzn
 		if( pAnimations == nullptr )
 			return;
 
+		_WatchResource( ResourceType::eAnm2, _sAnimatedObject, _sFile );
+
 		tinyxml2::XMLElement* pCurrentAnimation = pAnimations->FirstChildElement( "Animation" );
 		std::string szAnimName = "";
 
 		while( pCurrentAnimation != nullptr )
 		{
 			szAnimName = Tools::XMLStringAttribute( pCurrentAnimation, "Name" );
-			m_mapAnimatedObjets[ _sAnimatedObject ][ szAnimName ] = new Anm2( pContent, pCurrentAnimation, _sFile );
+			Anm2* pAnm2 = new Anm2( pContent, pCurrentAnimation, _sFile );
+			pAnm2->m_bIsTemplate = true;
+
+			m_mapAnimatedObjets[ _sAnimatedObject ][ szAnimName ] = pAnm2;
 			szAnimName.clear();
 
 			pCurrentAnimation = pCurrentAnimation->NextSiblingElement();
@@ -597,6 +610,9 @@ namespace fzn
 
 		if( it == m_mapSoundBuffers.end() )
 		{
+			if( g_pFZN_AudioMgr != nullptr )
+				g_pFZN_AudioMgr->InvalidateSoundBuffers();
+
 			if( _bCryptedFile )
 				return _LoadCryptedSoundBuffer( _name, _path );
 
@@ -605,6 +621,7 @@ namespace fzn
 
 			FZN_LOG( "Loading sound buffer \"%s\" at \"%s\".", _name.c_str(), _path.c_str() );
 
+			_WatchResource( ResourceType::eSound, _name, _path );
 			_SendFileLoadedEvent();
 			return m_mapSoundBuffers[ _name ];
 		}
@@ -630,6 +647,9 @@ namespace fzn
 
 		if( it != m_mapSoundBuffers.end() )
 		{
+			if( g_pFZN_AudioMgr != nullptr )
+				g_pFZN_AudioMgr->InvalidateSoundBuffers( it->second );
+
 			delete it->second;
 			it->second = nullptr;
 			m_mapSoundBuffers.erase( it );
@@ -713,6 +733,8 @@ namespace fzn
 
 			FZN_LOG( "Loading bitmap font \"%s\" at \"%s\".", _name.c_str(), _path.c_str() );
 
+			_WatchResource( ResourceType::eBitmapFont, _name, _path );
+
 			return m_mapBitmapFonts[_name] = tmpFont;
 		}
 
@@ -781,6 +803,8 @@ namespace fzn
 
 			if( m_mapShaders[ _sName ].loadFromFile( sVert, sFrag ) )
 			{
+				_WatchResource( ResourceType::eShader, _sName, sVert );
+				_WatchResource( ResourceType::eShader, _sName, sFrag );
 				_SendFileLoadedEvent();
 				return &m_mapShaders[ _sName ];
 			}
@@ -864,6 +888,13 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void DataManager::LoadResourceFile( const char* _resourceFile /*= DATAPATH( "XMLFiles/Resources" )*/, bool _bLocalResourceFile /*= true*/ )
 	{
+		if( _resourceFile != nullptr && _LoadResourceManifest( _resourceFile ) )
+		{
+			m_bResourceFileExists = true;
+			m_bResourceFileLoaded = true;
+			return;
+		}
+
 		tinyxml2::XMLDocument resFile;
 
 		if( _resourceFile == nullptr || g_pFZN_DataMgr->LoadXMLFile( resFile, _resourceFile ) )
@@ -886,6 +917,10 @@ namespace fzn
 		_LookForResources( pResources, Tools::XMLStringAttribute( pResources, "Path" ) );
 
 		m_bResourceFileLoaded = true;
+
+		//The manifest is missing or outdated, it is compiled now so the next launches (and the crypted data) can use it.
+		if( USINGCRYPTEDFILES == false )
+			ResourceManifest::Compile( _resourceFile );
 	}
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1029,19 +1064,154 @@ namespace fzn
 		}*/
 		}
 
-		for( MapResourceGroups::const_iterator itResourceGroup = m_mapResourceGroups.cbegin(); itResourceGroup != m_mapResourceGroups.cend(); ++itResourceGroup )
+		//Different names can have the same hash, the names are compared too.
+		const auto oGroupedResources = m_oGroupedResources.equal_range( Tools::hash_string( _sResourceName ) );
+
+		for( auto it = oGroupedResources.first; it != oGroupedResources.second; ++it )
 		{
-			for( const Resource& oResource : itResourceGroup->second->m_oResources )
-			{
-				if( oResource.m_sName == _sResourceName )
-					return true;
-			}
+			if( it->second == _sResourceName )
+				return true;
 		}
 
 		FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Resource %s (%d) doesn't exist !", _sResourceName.c_str(), _eType );
 		return false;
 	}
 
+	/////////////////HOT RELOAD/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Reloads the modified files gathered by the file watcher
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void DataManager::Update()
+	{
+		if( m_pFileWatcher == nullptr )
+			return;
+
+		for( const std::string& sFile : m_pFileWatcher->PopModifiedFiles() )
+			ReloadFile( sFile );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Starts or stops watching the data folder, not available with crypted files
+	//Parameter : Watch the data folder (true) or not
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void DataManager::EnableHotReload( bool _bEnable )
+	{
+		if( _bEnable == IsHotReloadEnabled() )
+			return;
+
+		if( _bEnable == false )
+		{
+			CheckNullptrDelete( m_pFileWatcher );
+			return;
+		}
+
+		if( USINGCRYPTEDFILES )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Hot reload isn't available with crypted files." );
+			return;
+		}
+
+		m_pFileWatcher = new FileWatcher;
+
+		if( m_pFileWatcher->Start( g_pFZN_Core->GetDataFolder() ) == false )
+			CheckNullptrDelete( m_pFileWatcher );
+	}
+
+	bool DataManager::IsHotReloadEnabled() const
+	{
+		return m_pFileWatcher != nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Reloads in place every resource loaded from the given file, pointers on them stay valid
+	//Parameter : Path to the modified file
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void DataManager::ReloadFile( const std::string& _sPath )
+	{
+		const std::string sPath = FileWatcher::NormalizePath( _sPath );
+		MapWatchedResources::const_iterator itFile = m_mapWatchedResources.find( sPath );
+
+		if( itFile != m_mapWatchedResources.end() )
+		{
+			for( const WatchedResource& oResource : itFile->second )
+			{
+				FZN_LOG( "Reloading \"%s\" from \"%s\".", oResource.m_sName.c_str(), sPath.c_str() );
+
+				switch( oResource.m_eType )
+				{
+				case ResourceType::eTexture:
+				{
+					sf::Texture* pTexture = GetTexture( oResource.m_sName, false );
+
+					if( pTexture != nullptr && pTexture->loadFromFile( sPath ) )
+					{
+						pTexture->setSmooth( m_bSmoothTextures );
+
+						//The font atlases are copies of the font and custom glyph textures.
+						for( MapBitmapFonts::value_type& oFont : m_mapBitmapFonts )
+						{
+							if( oFont.second != nullptr )
+								oFont.second->OnTextureReloaded( pTexture );
+						}
+					}
+
+					break;
+				}
+				case ResourceType::eAnimation:
+				{
+					Animation* pAnimation = GetAnimation( oResource.m_sName, false );
+
+					if( pAnimation != nullptr )
+						pAnimation->LoadFromFile( oResource.m_sName, sPath );
+
+					break;
+				}
+				case ResourceType::eAnm2:
+				{
+					_ReloadAnm2s( oResource.m_sName, sPath );
+					break;
+				}
+				case ResourceType::eSound:
+				{
+					sf::SoundBuffer* pSoundBuffer = GetSoundBuffer( oResource.m_sName, false );
+
+					if( pSoundBuffer != nullptr && pSoundBuffer->loadFromFile( sPath ) && g_pFZN_AudioMgr != nullptr )
+						g_pFZN_AudioMgr->OnSoundBufferReloaded( pSoundBuffer );
+
+					break;
+				}
+				case ResourceType::eBitmapFont:
+				{
+					BitmapFont* pFont = GetBitmapFont( oResource.m_sName, false );
+
+					if( pFont != nullptr )
+						pFont->LoadFromFile( sPath );
+
+					break;
+				}
+				case ResourceType::eShader:
+				{
+					MapShaders::iterator itShader = m_mapShaders.find( oResource.m_sName );
+
+					if( itShader != m_mapShaders.end() )
+					{
+						const std::string sShader = sPath.substr( 0, sPath.find_last_of( '.' ) );
+						itShader->second.loadFromFile( sShader + ".vert", sShader + ".frag" );
+					}
+
+					break;
+				}
+				default:
+					break;
+				}
+			}
+		}
+
+		if( g_pFZN_AudioMgr != nullptr )
+			g_pFZN_AudioMgr->OnFileModified( sPath );
+	}
+
 	//=========================================================
 	//==========================PRIVATE=========================
 	//=========================================================
@@ -1239,6 +1409,65 @@ namespace fzn
 		return oRet;
 	}
 
+	bool DataManager::_LoadResourceManifest( const std::string& _sResourceFile )
+	{
+		const std::string sManifestFile = _sResourceFile + ResourceManifest::EXTENSION;
+
+		if( std::filesystem::exists( sManifestFile ) == false )
+			return false;
+
+		ResourceManifest oManifest;
+
+		if( oManifest.LoadFromFile( sManifestFile, USINGCRYPTEDFILES ) == false )
+			return false;
+
+		//Crypted files are packed with their manifest, there is nothing newer to look for.
+		if( USINGCRYPTEDFILES == false && oManifest.IsUpToDate( _sResourceFile, sManifestFile ) == false )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_YELLOW, "Resource manifest \"%s\" is older than its resource file, using the resource file instead.", sManifestFile.c_str() );
+			return false;
+		}
+
+		FZN_LOG( "Loading resource manifest \"%s\".", sManifestFile.c_str() );
+
+		std::vector< ResourceGroup* > oGroups( oManifest.GetNbGroups(), nullptr );
+
+		for( uint32_t uGroup = 0; uGroup < oManifest.GetNbGroups(); ++uGroup )
+		{
+			const ResourceManifest::GroupEntry& oGroupEntry = oManifest.GetGroup( uGroup );
+			const std::string sGroup = oManifest.GetString( oGroupEntry.m_uName );
+
+			ResourceGroup*& pResGrp = m_mapResourceGroups[ sGroup ];
+
+			if( pResGrp == nullptr )
+			{
+				pResGrp = new ResourceGroup();
+				pResGrp->m_sName = sGroup;
+				pResGrp->m_bLoaded = false;
+			}
+
+			pResGrp->m_oResources.reserve( pResGrp->m_oResources.size() + oGroupEntry.m_uNbResources );
+			oGroups[ uGroup ] = pResGrp;
+		}
+
+		for( uint32_t uResource = 0; uResource < oManifest.GetNbResources(); ++uResource )
+		{
+			const ResourceManifest::ResourceEntry& oEntry = oManifest.GetResource( uResource );
+
+			if( oEntry.m_uGroup == ResourceManifest::NO_GROUP )
+			{
+				_FindAndLoadResource( oManifest.GetString( oEntry.m_uType ), oManifest.GetString( oEntry.m_uName ), oManifest.GetString( oEntry.m_uPath ) );
+				continue;
+			}
+
+			//Only the name of the resource, as _AddResource does, so ResourceExists gives the same answer with or without the manifest.
+			oGroups[ oEntry.m_uGroup ]->m_oResources.push_back( { oManifest.GetString( oEntry.m_uName ), oManifest.GetString( oEntry.m_uPath ), oManifest.GetString( oEntry.m_uType ) } );
+			m_oGroupedResources.insert( { oEntry.m_uNameHash, oManifest.GetString( oEntry.m_uName ) } );
+		}
+
+		return true;
+	}
+
 	void DataManager::_LookForResources( tinyxml2::XMLNode* _pNode, const std::string& _sCurrenntPath )
 	{
 		if( _pNode == nullptr )
@@ -1294,6 +1523,68 @@ namespace fzn
 			}
 
 			pResourcesVector->push_back( { Tools::XMLStringAttribute( _pElement, "Name" ), _sCurrenntPath, _pElement->Name() } );
+			m_oGroupedResources.insert( { Tools::hash_string( pResourcesVector->back().m_sName ), pResourcesVector->back().m_sName } );
+		}
+	}
+
+	/////////////////HOT RELOAD/////////////////
+
+	void DataManager::_WatchResource( ResourceType _eType, const std::string& _sName, const std::string& _sPath )
+	{
+		//Crypted files are packed, there is nothing to watch.
+		if( USINGCRYPTEDFILES )
+			return;
+
+		std::vector< WatchedResource >& oResources = m_mapWatchedResources[ FileWatcher::NormalizePath( _sPath ) ];
+
+		for( const WatchedResource& oResource : oResources )
+		{
+			if( oResource.m_eType == _eType && oResource.m_sName == _sName )
+				return;
+		}
+
+		oResources.push_back( { _eType, _sName } );
+	}
+
+	void DataManager::_ReloadAnm2s( const std::string& _sAnimatedObject, const std::string& _sFile )
+	{
+		tinyxml2::XMLDocument oAnmFile;
+
+		if( LoadXMLFile( oAnmFile, _sFile ) )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Failure : %s", oAnmFile.ErrorStr() );
+			return;
+		}
+
+		tinyxml2::XMLElement* pRoot = oAnmFile.FirstChildElement( "AnimatedActor" );
+		tinyxml2::XMLElement* pContent = pRoot != nullptr ? pRoot->FirstChildElement( "Content" ) : nullptr;
+		tinyxml2::XMLElement* pAnimations = pRoot != nullptr ? pRoot->FirstChildElement( "Animations" ) : nullptr;
+
+		if( pContent == nullptr || pAnimations == nullptr )
+			return;
+
+		MapAnm2s& oAnm2s = m_mapAnimatedObjets[ _sAnimatedObject ];
+		tinyxml2::XMLElement* pCurrentAnimation = pAnimations->FirstChildElement( "Animation" );
+
+		while( pCurrentAnimation != nullptr )
+		{
+			const std::string sAnimName = Tools::XMLStringAttribute( pCurrentAnimation, "Name" );
+			MapAnm2s::iterator itAnm2 = oAnm2s.find( sAnimName );
+
+			//The templates are modified in place for the next copies, and the live copies are re-bound to them.
+			if( itAnm2 != oAnm2s.end() && itAnm2->second != nullptr )
+			{
+				*itAnm2->second = Anm2( pContent, pCurrentAnimation, _sFile );
+				Anm2::_OnTemplateReloaded( itAnm2->second );
+			}
+			else
+			{
+				Anm2* pAnm2 = new Anm2( pContent, pCurrentAnimation, _sFile );
+				pAnm2->m_bIsTemplate = true;
+				oAnm2s[ sAnimName ] = pAnm2;
+			}
+
+			pCurrentAnimation = pCurrentAnimation->NextSiblingElement();
 		}
 	}
 } //namespace fzn
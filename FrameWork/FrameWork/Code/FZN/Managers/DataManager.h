@@ -11,6 +11,7 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <any>
 
@@ -39,6 +40,7 @@ namespace fzn
 	class Music;
 	class Sound;
 	class BitmapFont;
+	class FileWatcher;
 
 	//=========================================================
 	//========================Resource===========================
@@ -81,6 +83,7 @@ namespace fzn
 			eAnimation,
 			eAnm2,
 			eBitmapGlyph,
+			eShader,
 			eNbResourceTypes,
 		};
 
@@ -255,6 +258,25 @@ namespace fzn
 
 		bool ResourceExists( const ResourceType& _eType, const std::string& _sResourceName, const std::string& _sAdditionalName = "" );
 		std::vector< unsigned char > _DecryptFile( const std::string& _sPath, bool _bTextFile = false );
+
+
+		/////////////////HOT RELOAD/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Reloads the modified files gathered by the file watcher
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Update();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Starts or stops watching the data folder, not available with crypted files
+		//Parameter : Watch the data folder (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void EnableHotReload( bool _bEnable );
+		bool IsHotReloadEnabled() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Reloads in place every resource loaded from the given file, pointers on them stay valid
+		//Parameter : Path to the modified file
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void ReloadFile( const std::string& _sPath );
 	private:
 		struct MusicData
 		{
@@ -282,6 +304,13 @@ namespace fzn
 		typedef std::function<void( const std::string& )> ResourceUnloadFct;
 		typedef std::unordered_map< std::string, ResourceUnloadFct > MapResourceUnloadFcts;
 
+		struct WatchedResource
+		{
+			ResourceType	m_eType;
+			std::string		m_sName;
+		};
+		typedef std::unordered_map< std::string, std::vector< WatchedResource > > MapWatchedResources;		//Resources loaded from each file, by normalized path
+
 
 		/////////////////CRYPTED DATA LOADING/////////////////
 
@@ -312,10 +341,19 @@ namespace fzn
 
 		void _LoadBitmapGlyphFile( const std::string& _sFile );
 
+		void _WatchResource( ResourceType _eType, const std::string& _sName, const std::string& _sPath );
+		void _ReloadAnm2s( const std::string& _sAnimatedObject, const std::string& _sFile );
+
 		void _LoadShaders();
 
 		void _SendFileLoadedEvent();
 
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Loads the compiled version of the resource file if there is an up to date one next to it
+		//Parameter : Path to the xml resource file
+		//Return value : The manifest has been loaded (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool _LoadResourceManifest( const std::string& _sResourceFile );
 		void _LookForResources( tinyxml2::XMLNode* _pNode, const std::string& _sCurrenntPath );
 		void _AddResource( tinyxml2::XMLElement* _pElement, const std::string& _sCurrenntPath );
 
@@ -337,12 +375,17 @@ namespace fzn
 		MapResourceGroups	m_mapResourceGroups;
 		MapResourceLoadFcts	m_mapResourceLoadFcts;
 		MapResourceUnloadFcts m_mapResourceUnloadFcts;
+		std::unordered_multimap< uint32_t, std::string > m_oGroupedResources;	//Names of the resources declared in a group, by hash
 
 		/////////////////RESOURCE FILE/////////////////
 		bool m_bResourceFileExists;			//Does the resource file exists
 		bool m_bResourceFileLoaded;			//Has the resource file been loaded
 
 		bool m_bSmoothTextures{ true };
+
+		/////////////////HOT RELOAD/////////////////
+		MapWatchedResources	m_mapWatchedResources;
+		FileWatcher*		m_pFileWatcher{ nullptr };
 	};
 } //namspace fzn
 
@@ -49,7 +49,7 @@ namespace fzn
 
 		m_console = GetConsoleWindow();
 
-		srand( (unsigned)time( nullptr ) );
+		Random::SeedDefault( (uint64_t)time( nullptr ) );
 
 		g_pFZN_Core = this;
 	}
@@ -160,7 +160,7 @@ namespace fzn
 
 		if( Tools::mask_has_flag_raised( _oDesc.m_uModules, CoreModuleFlags_AudioModule ) && m_pAudioManager == nullptr )
 		{
-			m_pAudioManager = new AudioManager( _oDesc.m_bUseFMOD );
+			m_pAudioManager = new AudioManager( _oDesc.m_bUseFMOD, _oDesc.m_eAudioBackend );
 			m_iActivatedModulesNbr++;
 		}
 
@@ -257,16 +257,20 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void FazonCore::Update()
 	{
+		m_oTimeService.BeginFrame();
+
 		_ManageEvents();
 
 		if( m_iActivatedModulesNbr == 0 )
 			return;
 
+		if( m_pDataManager != nullptr )		m_pDataManager->Update();
 		if( m_pInputManager != nullptr )	m_pInputManager->Update();
 		if( m_pAnimManager != nullptr )		m_pAnimManager->Update();
 		if( m_pAudioManager != nullptr )	m_pAudioManager->Update();
 
 		if( m_pSteeringManager != nullptr )	m_pSteeringManager->Update();
+		if( m_pAIManager != nullptr )		m_pAIManager->Update();
 		if( m_pMessageManager != nullptr )	m_pMessageManager->Update();
 	}
 
@@ -740,7 +744,7 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	sf::Time FazonCore::GetGlobalTime()
 	{
-		return m_GlobalTime.getElapsedTime();
+		return sf::microseconds( (sf::Int64)( m_oTimeService.GetElapsedTime() / 1000 ) );
 	}
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -865,7 +869,8 @@ namespace fzn
 
 	void FazonCore::PushEvent( const Event& _oEvent )
 	{
-		m_oEvents.push( _oEvent );
+		if( m_oEvents.Push( _oEvent ) == false )
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Events queue full, event of type %d lost.", _oEvent.m_eType );
 	}
 
 	void FazonCore::PushEvent( void* _pUserData )
@@ -876,7 +881,11 @@ namespace fzn
 		Event oEvent( Event::Type::eUserEvent );
 		oEvent.m_pUserData = _pUserData;
 
-		m_oEvents.push( oEvent );
+		if( m_oEvents.Push( oEvent ) == false )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Events queue full, user event lost." );
+			CheckNullptrDelete( oEvent.m_pUserData );
+		}
 	}
 
 	const fzn::Event& FazonCore::GetEvent() const
@@ -884,6 +893,14 @@ namespace fzn
 		return m_oCurrentEvent;
 	}
 
+	void FazonCore::UnsubscribeEvent( Event::Type _eType, DataCallbackHandle _oHandle )
+	{
+		if( _eType >= Event::eNbTypes )
+			return;
+
+		m_oEventSubscribers[ _eType ].RemoveCallback( _oHandle );
+	}
+
 	void FazonCore::_TransferCallBacks( bool _bToWindowManager )
 	{
 		if( m_pWindowManager == nullptr )
@@ -970,18 +987,26 @@ namespace fzn
 
 	void FazonCore::_ManageEvents()
 	{
-		while( m_oEvents.empty() == false )
+		//The events are popped by batches, the ones pushed by the callbacks being sent in the next batch.
+		while( m_oEvents.PopAll( m_oEventsBatch ) > 0 )
 		{
-			m_oCurrentEvent = m_oEvents.front();
-			m_oEvents.pop();
+			for( const Event& oEvent : m_oEventsBatch )
+			{
+				m_oCurrentEvent = oEvent;
 
-			if( m_pWindowManager != nullptr )
-				m_pWindowManager->ProcessEventsCallBacks();
-			else
-				m_oCallbacksHolder.ExecuteCallbacks( DataCallbackType::Event );
+				if( m_oCurrentEvent.m_eType < Event::eNbTypes )
+					m_oEventSubscribers[ m_oCurrentEvent.m_eType ].ExecuteCallbacks( DataCallbackType::Event );
+
+				if( m_pWindowManager != nullptr )
+					m_pWindowManager->ProcessEventsCallBacks();
+				else
+					m_oCallbacksHolder.ExecuteCallbacks( DataCallbackType::Event );
+
+				if( m_oCurrentEvent.m_eType == Event::eUserEvent )
+					CheckNullptrDelete( m_oCurrentEvent.m_pUserData );
+			}
 
-			if( m_oCurrentEvent.m_eType == Event::eUserEvent )
-				CheckNullptrDelete( m_oCurrentEvent.m_pUserData );
+			m_oEventsBatch.clear();
 		};
 
 		m_oCurrentEvent = Event();
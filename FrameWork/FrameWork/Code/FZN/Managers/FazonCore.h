@@ -18,7 +18,6 @@ class FazonCore;
 #include <SFML/Graphics/Rect.hpp>
 #include <vector>
 //#include <Windows.h>
-#include <queue>
 
 #include <SFML/System/Clock.hpp>
 #include <SFML/System/Time.hpp>
@@ -29,6 +28,8 @@ class FazonCore;
 #include "FZN/Managers/WindowManager.h"
 #include "FZN/Tools/Event.h"
 #include "FZN/Tools/DataCallback.h"
+#include "FZN/Tools/MPSCQueue.h"
+#include "FZN/Tools/TimeService.h"
 
 namespace sf
 {
@@ -42,6 +43,7 @@ namespace fzn
 	class AudioManager;
 	class DataManager;
 	class InputManager;
+	enum class AudioBackendType : uint8_t;
 	class MessageManager;
 	class SteeringManager;
 	class VersionsManager;
@@ -97,6 +99,7 @@ namespace fzn
 			std::string		m_sSaveFolderName{ m_sName };
 			bool			m_bUseCryptedData{ false };
 			bool			m_bUseFMOD{ false };
+			AudioBackendType m_eAudioBackend{};						//Device the sounds are played on (SFML by default)
 			std::string		m_sDataFolderPath{ "../../Data/" };
 		};
 
@@ -253,6 +256,12 @@ namespace fzn
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		sf::Time GetGlobalTime();
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the frame times of the application (advanced at the beginning of each update)
+		//Return value : Time service
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		TimeService& GetTimeService() { return m_oTimeService; }
+		const TimeService& GetTimeService() const { return m_oTimeService; }
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		//Accessor on the indicator of the members creation
 		//Return value : The components are created (true) or not
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -284,12 +293,12 @@ namespace fzn
 		bool FileExists( const std::string& _sFilePath ) const;
 
 		template< typename CallbackType >
-		void AddCallback( CallbackType* _pObject, typename DataCallback<CallbackType>::CallbackFct _pFct, DataCallbackType _eCallbackType, int _iPriority = 0, int _iWindow = -1 )
+		DataCallbackHandle AddCallback( CallbackType* _pObject, typename DataCallback<CallbackType>::CallbackFct _pFct, DataCallbackType _eCallbackType, int _iPriority = 0, int _iWindow = -1 )
 		{
 			if( m_pWindowManager != nullptr )
-				m_pWindowManager->AddCallback< CallbackType >( _pObject, _pFct, _eCallbackType, _iPriority, _iWindow );
+				return m_pWindowManager->AddCallback< CallbackType >( _pObject, _pFct, _eCallbackType, _iPriority, _iWindow );
 			else
-				m_oCallbacksHolder.AddCallback< CallbackType >( _pObject, _pFct, _eCallbackType, _iPriority );
+				return m_oCallbacksHolder.AddCallback< CallbackType >( _pObject, _pFct, _eCallbackType, _iPriority );
 		}
 
 		template< typename CallbackType >
@@ -301,10 +310,46 @@ namespace fzn
 				m_oCallbacksHolder.RemoveCallback< CallbackType >( _pObject, _pFct, _eCallbackType );
 		}
 
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes a callback from the handle returned by AddCallback, without searching for it
+		//Parameter 1 : Handle of the callback
+		//Parameter 2 : Window the callback has been added to (-1 for the main window)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void RemoveCallback( DataCallbackHandle _oHandle, int _iWindow = -1 )
+		{
+			if( m_pWindowManager != nullptr )
+				m_pWindowManager->RemoveCallback( _oHandle, _iWindow );
+			else
+				m_oCallbacksHolder.RemoveCallback( _oHandle );
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds an event to the queue, it will be sent at the beginning of the next update. Can be called from any thread
+		//Parameter : Event to send
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void PushEvent( const Event& _oEvent );
 		void PushEvent( void* _pUserData );
 		const Event& GetEvent() const;
 
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a callback called only for the events of a given type, before the Event callbacks receiving all of them
+		//Parameter 1 : Type of event to listen to
+		//Parameter 2 : Object on which the callback will be called
+		//Parameter 3 : Callback, the event can be retrieved with GetEvent
+		//Parameter 4 : Priority among the subscribers of the same type
+		//Return value : Handle to give to UnsubscribeEvent
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		template< typename CallbackType >
+		DataCallbackHandle SubscribeEvent( Event::Type _eType, CallbackType* _pObject, typename DataCallback<CallbackType>::CallbackFct _pFct, int _iPriority = 0 )
+		{
+			if( _eType >= Event::eNbTypes )
+				return {};
+
+			return m_oEventSubscribers[ _eType ].AddCallback< CallbackType >( _pObject, _pFct, DataCallbackType::Event, _iPriority );
+		}
+
+		void UnsubscribeEvent( Event::Type _eType, DataCallbackHandle _oHandle );
+
 		
 
 	private :
@@ -349,7 +394,7 @@ namespace fzn
 
 		int						m_iActivatedModulesNbr{ 0 };		//Number of modules created.
 
-		sf::Clock				m_GlobalTime;					//Application global timer.
+		TimeService				m_oTimeService;					//Application global timer.
 
 		HWND					m_console;						//Application console window handle.
 
@@ -358,7 +403,11 @@ namespace fzn
 		std::string				m_sSaveFolderName;
 		std::string				m_sSaveFolderPath;
 
-		std::queue< Event >		m_oEvents;
+		static constexpr size_t	EventQueueCapacity{ 2048 };
+
+		MPSCQueue< Event, EventQueueCapacity >	m_oEvents;
+		std::vector< Event >	m_oEventsBatch;										//Events popped from the queue, reused each update
+		DataCallbacksHolder		m_oEventSubscribers[ Event::eNbTypes ];				//Callbacks of each event type
 		Event					m_oCurrentEvent;
 	};
 } //namespace fzn
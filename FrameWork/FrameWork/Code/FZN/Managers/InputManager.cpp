@@ -33,7 +33,7 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	InputManager::InputManager()
 	{
-		g_pFZN_Core->AddCallback< InputManager >( this, &InputManager::OnEvent, fzn::DataCallbackType::Event );
+		g_pFZN_Core->SubscribeEvent< InputManager >( Event::eToggleFullScreen, this, &InputManager::OnEvent );
 
 		m_bUsingKeyboard = true;
 
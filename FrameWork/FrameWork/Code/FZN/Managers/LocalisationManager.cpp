@@ -1,4 +1,8 @@
+#include <cstring>
+#include <fstream>
+
 #include "LocalisationManager.h"
+#include "FZN/Tools/Tools.h"
 
 
 FZN_EXPORT fzn::Localisation::Manager* g_pFZN_LocMgr = nullptr;
@@ -7,6 +11,95 @@ namespace fzn
 {
 	namespace Localisation
 	{
+		namespace
+		{
+			/**
+			* @brief Build an open addressing hash table of the entry names, using linear probing. A duplicated name keeps its first entry.
+			* @param _entries The entries to index.
+			* @return The hash table, its size being a power of two at least twice the number of entries.
+			**/
+			std::vector< Compiled::HashSlot > build_name_hash_table( const Entries& _entries )
+			{
+				uint32_t table_size{ 2 };
+
+				while( table_size < _entries.size() * 2 )
+					table_size <<= 1;
+
+				auto hash_table = std::vector< Compiled::HashSlot >( table_size );
+				const uint32_t mask{ table_size - 1 };
+
+				for( uint32_t entry_id{ 0 }; entry_id < _entries.size(); ++entry_id )
+				{
+					const uint32_t hash{ Tools::hash_string( _entries[ entry_id ].m_name ) };
+					uint32_t slot{ hash & mask };
+					bool duplicate{ false };
+
+					while( hash_table[ slot ].m_entry_id != Uint32_Max )
+					{
+						if( hash_table[ slot ].m_hash == hash && _entries[ hash_table[ slot ].m_entry_id ].m_name == _entries[ entry_id ].m_name )
+						{
+							duplicate = true;
+							break;
+						}
+
+						slot = ( slot + 1 ) & mask;
+					}
+
+					if( duplicate == false )
+						hash_table[ slot ] = { hash, entry_id };
+				}
+
+				return hash_table;
+			}
+
+			/**
+			* @brief Transform the case of an UTF-8 string.
+			* @param _text The string to transform.
+			* @param _case_transform How to transform the case of the string.
+			* @return The transformed string.
+			**/
+			std::string transform_case( std::string_view _text, Case _case_transform )
+			{
+				if( _case_transform == Case::all_lower )
+					return Tools::get_utf8_lower_string( _text );
+
+				if( _case_transform == Case::all_upper )
+					return Tools::get_utf8_upper_string( _text );
+
+				auto ret = std::string{};
+				ret.reserve( _text.size() );
+
+				bool capitalize_next{ true };
+
+				for( size_t position{ 0 }; position < _text.size(); )
+				{
+					const uint32_t code_point{ Tools::decode_utf8( _text, position ) };
+					const bool is_cased{ Tools::to_lower_code_point( code_point ) != Tools::to_upper_code_point( code_point ) };
+
+					if( capitalize_next && is_cased )
+					{
+						Tools::encode_utf8( Tools::to_upper_code_point( code_point ), ret );
+						capitalize_next = false;
+						continue;
+					}
+
+					if( _case_transform == Case::first_letter_upper_all_words )
+					{
+						const bool is_space{ code_point == ' ' || code_point == '\t' || code_point == '\n' || code_point == 0xA0 };
+
+						if( is_space )
+							capitalize_next = true;
+						else if( is_cased )
+							capitalize_next = false;
+					}
+
+					Tools::encode_utf8( code_point, ret );
+				}
+
+				return ret;
+			}
+		}
+
 
 		Manager::Manager()
 		{
@@ -19,12 +112,38 @@ namespace fzn
 		}
 
 		/**
-		* @brief Load translation entries from localisation json.
+		* @brief Load translation entries from localisation json, or map the compiled file if the path ends with Compiled::extension.
 		* @param _path The path to the entries definition file.
 		**/
 		void Manager::load_entries( std::string_view _path )
 		{
-			load_entries( _path, m_loc_data );
+			m_compiled_file.Close();
+			m_compiled_header = nullptr;
+			m_compiled_languages = nullptr;
+			m_compiled_names = nullptr;
+			m_name_hash_table = nullptr;
+			m_name_hash_table_size = 0;
+			m_name_index.clear();
+			m_case_caches.clear();
+
+			if( _path.ends_with( Compiled::extension ) )
+			{
+				if( _load_compiled_entries( _path ) == false )
+				{
+					m_compiled_file.Close();
+					m_loc_data.clear();
+				}
+			}
+			else
+			{
+				load_entries( _path, m_loc_data );
+				_build_name_index();
+			}
+
+			if( m_current_language >= m_loc_data.m_languages.size() )
+				m_current_language = 0;
+
+			m_case_caches.resize( m_loc_data.m_languages.size() * static_cast< uint32_t >( Case::COUNT ) );
 		}
 
 		/**
@@ -79,6 +198,105 @@ namespace fzn
 				_load_entry( *it_entry, _localisation_data );
 		}
 
+		/**
+		* @brief Write the given localisation data in the compiled format.
+		* @param _path				The path to the compiled file.
+		* @param _localisation_data	The localisation data to write.
+		* @return True if the file has been written.
+		**/
+		bool Manager::save_compiled_entries( std::string_view _path, const LocalisationData& _localisation_data )
+		{
+			const Entries& entries{ _localisation_data.m_entries };
+			const StringVector& languages{ _localisation_data.m_languages };
+			const std::vector< Compiled::HashSlot > hash_table{ build_name_hash_table( entries ) };
+
+			auto data = std::vector< char >{};
+
+			auto reserve = [ &data ]( size_t _size )
+				{
+					data.resize( ( data.size() + 3 ) & ~size_t{ 3 } );		// Keeps the tables aligned on 4 bytes.
+
+					const auto offset = static_cast< uint32_t >( data.size() );
+					data.resize( data.size() + _size );
+					return offset;
+				};
+			auto add_string = [ &data ]( std::string_view _string )
+				{
+					if( _string.empty() )
+						return Compiled::String{};
+
+					const auto string = Compiled::String{ static_cast< uint32_t >( data.size() ), static_cast< uint32_t >( _string.size() ) };
+					data.insert( data.end(), _string.begin(), _string.end() );
+					data.push_back( '\0' );
+					return string;
+				};
+			auto write = [ &data ]( uint32_t _offset, const auto& _value )
+				{
+					memcpy( data.data() + _offset, &_value, sizeof( _value ) );
+				};
+
+			auto header = Compiled::Header{};
+			header.m_nb_entries = static_cast< uint32_t >( entries.size() );
+			header.m_nb_languages = static_cast< uint32_t >( languages.size() );
+			header.m_hash_table_size = static_cast< uint32_t >( hash_table.size() );
+
+			reserve( sizeof( Compiled::Header ) );
+			header.m_languages_offset = reserve( languages.size() * sizeof( Compiled::Language ) );
+			header.m_names_offset = reserve( entries.size() * sizeof( Compiled::String ) );
+			header.m_hash_table_offset = reserve( hash_table.size() * sizeof( Compiled::HashSlot ) );
+
+			for( uint32_t hash_slot{ 0 }; hash_slot < hash_table.size(); ++hash_slot )
+				write( header.m_hash_table_offset + hash_slot * sizeof( Compiled::HashSlot ), hash_table[ hash_slot ] );
+
+			for( uint32_t entry_id{ 0 }; entry_id < entries.size(); ++entry_id )
+				write( header.m_names_offset + entry_id * sizeof( Compiled::String ), add_string( entries[ entry_id ].m_name ) );
+
+			for( uint32_t language_id{ 0 }; language_id < languages.size(); ++language_id )
+			{
+				auto language = Compiled::Language{};
+				language.m_name = add_string( languages[ language_id ] );
+				language.m_strings_offset = reserve( entries.size() * sizeof( Compiled::String ) );
+
+				for( uint32_t entry_id{ 0 }; entry_id < entries.size(); ++entry_id )
+				{
+					const StringVector& translations{ entries[ entry_id ].m_translations };
+					const std::string_view translation{ language_id < translations.size() ? std::string_view{ translations[ language_id ] } : std::string_view{} };
+
+					write( language.m_strings_offset + entry_id * sizeof( Compiled::String ), add_string( translation ) );
+				}
+
+				language.m_blob_size = static_cast< uint32_t >( data.size() ) - language.m_strings_offset;
+				write( header.m_languages_offset + language_id * sizeof( Compiled::Language ), language );
+			}
+
+			write( 0, header );
+
+			if( data.size() >= Uint32_Max )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Too much data to compile localisation file: %s", _path.data() );
+				return false;
+			}
+
+			auto file = std::ofstream{ _path.data(), std::ios::binary | std::ios::trunc };
+
+			if( file.is_open() == false )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't open file: %s", _path.data() );
+				return false;
+			}
+
+			file.write( data.data(), data.size() );
+
+			if( file.good() == false )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't write file: %s", _path.data() );
+				return false;
+			}
+
+			FZN_LOG( "Compiled %d entries in %d languages to %s.", entries.size(), languages.size(), _path.data() );
+			return true;
+		}
+
 		uint32_t Manager::get_language_id( std::string_view _language ) const
 		{
 			return get_language_id( _language, m_loc_data.m_languages );
@@ -114,12 +332,27 @@ namespace fzn
 		**/
 		uint32_t Manager::get_localisation_id_from_name( std::string_view _name ) const
 		{
-			auto it_entry = std::ranges::find( m_loc_data.m_entries, _name.data(), &Entry::m_name );
-
-			if( it_entry == m_loc_data.m_entries.end() )
+			if( m_name_hash_table == nullptr || m_name_hash_table_size == 0 )
 				return Uint32_Max;
 
-			return std::distance( m_loc_data.m_entries.begin(), it_entry );
+			const uint32_t hash{ Tools::hash_string( _name ) };
+			const uint32_t mask{ m_name_hash_table_size - 1 };
+			uint32_t slot{ hash & mask };
+
+			for( uint32_t nb_probes{ 0 }; nb_probes < m_name_hash_table_size; ++nb_probes )
+			{
+				const Compiled::HashSlot& hash_slot{ m_name_hash_table[ slot ] };
+
+				if( hash_slot.m_entry_id == Uint32_Max )
+					return Uint32_Max;
+
+				if( hash_slot.m_hash == hash && get_entry_name_from_id( hash_slot.m_entry_id ) == _name )
+					return hash_slot.m_entry_id;
+
+				slot = ( slot + 1 ) & mask;
+			}
+
+			return Uint32_Max;
 		}
 
 		/**
@@ -129,9 +362,12 @@ namespace fzn
 		**/
 		std::string_view Manager::get_entry_name_from_id( uint32_t _entry_id ) const
 		{
-			if( _entry_id >= m_loc_data.m_entries.size() )
+			if( _entry_id >= _get_nb_entries() )
 				return {};
 
+			if( is_compiled() )
+				return _get_compiled_string( m_compiled_names[ _entry_id ] );
+
 			return m_loc_data.m_entries[ _entry_id ].m_name;
 		}
 
@@ -173,5 +409,197 @@ namespace fzn
 			_localisation_data.m_entries.push_back( std::move( entry ) );
 		}
 
+		/**
+		* @brief Map a compiled localisation file and check its header and tables.
+		* @param _path The path to the compiled file.
+		* @return True if the file is valid.
+		**/
+		bool Manager::_load_compiled_entries( std::string_view _path )
+		{
+			if( m_compiled_file.Open( std::string{ _path } ) == false )
+				return false;
+
+			FZN_LOG( "Loading compiled entries at %s...", _path.data() );
+
+			const uint8_t* data{ m_compiled_file.GetData() };
+			const uint64_t file_size{ m_compiled_file.GetSize() };
+
+			auto table_fits = [ file_size ]( uint64_t _offset, uint64_t _count, uint64_t _element_size )
+				{
+					return _offset % alignof( uint32_t ) == 0 && _offset + _count * _element_size <= file_size;
+				};
+
+			const auto* header = reinterpret_cast< const Compiled::Header* >( data );
+			const auto reference_header = Compiled::Header{};
+
+			if( file_size < sizeof( Compiled::Header ) || memcmp( header->m_magic, reference_header.m_magic, sizeof( header->m_magic ) ) != 0 )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Invalid compiled localisation file: %s", _path.data() );
+				return false;
+			}
+
+			if( header->m_version != Compiled::version )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Compiled localisation file version %d instead of %d, it has to be exported again: %s", header->m_version, Compiled::version, _path.data() );
+				return false;
+			}
+
+			const bool hash_table_valid{ header->m_hash_table_size > header->m_nb_entries && ( header->m_hash_table_size & ( header->m_hash_table_size - 1 ) ) == 0 };
+
+			if( hash_table_valid == false
+				|| table_fits( header->m_languages_offset, header->m_nb_languages, sizeof( Compiled::Language ) ) == false
+				|| table_fits( header->m_names_offset, header->m_nb_entries, sizeof( Compiled::String ) ) == false
+				|| table_fits( header->m_hash_table_offset, header->m_hash_table_size, sizeof( Compiled::HashSlot ) ) == false )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Corrupted compiled localisation file: %s", _path.data() );
+				return false;
+			}
+
+			const auto* languages = reinterpret_cast< const Compiled::Language* >( data + header->m_languages_offset );
+
+			for( uint32_t language_id{ 0 }; language_id < header->m_nb_languages; ++language_id )
+			{
+				if( table_fits( languages[ language_id ].m_strings_offset, header->m_nb_entries, sizeof( Compiled::String ) ) == false )
+				{
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Corrupted compiled localisation file: %s", _path.data() );
+					return false;
+				}
+			}
+
+			m_compiled_header = header;
+			m_compiled_languages = languages;
+			m_compiled_names = reinterpret_cast< const Compiled::String* >( data + header->m_names_offset );
+			m_name_hash_table = reinterpret_cast< const Compiled::HashSlot* >( data + header->m_hash_table_offset );
+			m_name_hash_table_size = header->m_hash_table_size;
+
+			// Only the language names are copied, the entries stay in the mapped file.
+			m_loc_data.clear();
+			m_loc_data.m_languages.reserve( header->m_nb_languages );
+
+			for( uint32_t language_id{ 0 }; language_id < header->m_nb_languages; ++language_id )
+				m_loc_data.m_languages.emplace_back( _get_compiled_string( languages[ language_id ].m_name ) );
+
+			return true;
+		}
+
+		/**
+		* @brief Build the name hash table of the entries loaded from json.
+		**/
+		void Manager::_build_name_index()
+		{
+			m_name_index = build_name_hash_table( m_loc_data.m_entries );
+			m_name_hash_table = m_name_index.data();
+			m_name_hash_table_size = static_cast< uint32_t >( m_name_index.size() );
+		}
+
+		/**
+		* @brief Retrieve an entry translation from its ID, in the compiled file or the json entries.
+		* @param _entry_id The ID of the entry.
+		* @param _language_id The ID of the language.
+		* @param _case_transform How to transform the case of the string. COUNT means to transformation is done.
+		* @return The translation, the entry name if there is none, empty if the entry or the language doesn't exist.
+		**/
+		std::string_view Manager::_get_string( uint32_t _entry_id, uint32_t _language_id, Case _case_transform ) const
+		{
+			const uint32_t nb_entries{ _get_nb_entries() };
+
+			if( _entry_id >= nb_entries )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Entry #%d not found. (nb entries: %d)", _entry_id, nb_entries );
+				return {};
+			}
+
+			const std::string_view entry_name{ get_entry_name_from_id( _entry_id ) };
+
+			if( _language_id >= m_loc_data.m_languages.size() )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Language #%d for entry %s (#%d) not found. (max nb languages: %d)", _language_id, entry_name.data(), _entry_id, m_loc_data.m_languages.size() );
+				return {};
+			}
+
+			std::string_view translation{};
+
+			if( is_compiled() )
+			{
+				const auto* strings = reinterpret_cast< const Compiled::String* >( m_compiled_file.GetData() + m_compiled_languages[ _language_id ].m_strings_offset );
+				translation = _get_compiled_string( strings[ _entry_id ] );
+			}
+			else if( _language_id < m_loc_data.m_entries[ _entry_id ].m_translations.size() )
+				translation = m_loc_data.m_entries[ _entry_id ].m_translations[ _language_id ];
+
+			// If there is no translation in the requested language, return the entry name to make it obvious so it can be fixed.
+			if( translation.empty() )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "No translation in language #%d found for entry '%s' (#%d)", _language_id, entry_name.data(), _entry_id );
+				return entry_name;
+			}
+
+			if( _case_transform < Case::COUNT )
+				return _get_case_transformed_string( _entry_id, _language_id, _case_transform, translation );
+
+			return translation;
+		}
+
+		/**
+		* @brief Retrieve a string from the compiled file.
+		* @param _string The location of the string.
+		* @return The string, empty if it is out of the file.
+		**/
+		std::string_view Manager::_get_compiled_string( const Compiled::String& _string ) const
+		{
+			if( _string.m_size == 0 || static_cast< uint64_t >( _string.m_offset ) + _string.m_size >= m_compiled_file.GetSize() )
+				return {};
+
+			return { reinterpret_cast< const char* >( m_compiled_file.GetData() ) + _string.m_offset, _string.m_size };
+		}
+
+		uint32_t Manager::_get_nb_entries() const
+		{
+			if( is_compiled() )
+				return m_compiled_header->m_nb_entries;
+
+			return static_cast< uint32_t >( m_loc_data.m_entries.size() );
+		}
+
+		/**
+		* @brief Retrieve the case transformed version of a translation, transforming it on first use.
+		* @param _entry_id The ID of the entry.
+		* @param _language_id The ID of the language.
+		* @param _case_transform How to transform the case of the string.
+		* @param _translation The translation to transform.
+		* @return The transformed translation, valid until the entries are reloaded or the language changes.
+		**/
+		std::string_view Manager::_get_case_transformed_string( uint32_t _entry_id, uint32_t _language_id, Case _case_transform, std::string_view _translation ) const
+		{
+			const uint32_t cache_id{ _language_id * static_cast< uint32_t >( Case::COUNT ) + static_cast< uint32_t >( _case_transform ) };
+
+			if( cache_id >= m_case_caches.size() )
+				return _translation;
+
+			StringVector& cache{ m_case_caches[ cache_id ] };
+
+			// Sized once so the strings never move while string_views on them are in use.
+			if( cache.empty() )
+				cache.resize( _get_nb_entries() );
+
+			// A transformed translation is never empty, an empty string means it hasn't been computed yet.
+			if( cache[ _entry_id ].empty() )
+				cache[ _entry_id ] = transform_case( _translation, _case_transform );
+
+			return cache[ _entry_id ];
+		}
+
+		/**
+		* @brief Free the case transformed strings of all the languages but the current one.
+		**/
+		void Manager::_release_case_caches()
+		{
+			for( uint32_t cache_id{ 0 }; cache_id < m_case_caches.size(); ++cache_id )
+			{
+				if( cache_id / static_cast< uint32_t >( Case::COUNT ) != m_current_language )
+					StringVector{}.swap( m_case_caches[ cache_id ] );
+			}
+		}
+
 	} // namespace Localisation
-} // namespace fzn
\ No newline at end of file
+} // namespace fzn
@@ -8,6 +8,7 @@
 
 #include "FZN/Defines.h"
 #include "FZN/Tools/Logging.h"
+#include "FZN/Tools/MappedFile.h"
 
 
 namespace fzn
@@ -52,6 +53,48 @@ namespace fzn
 			StringVector	m_languages;	// All the languages available.
 		};
 
+		/************************************************************************
+		* @brief Layout of the compiled localisation files, exported by TranslatR. All offsets are from the start of the file.
+		* Header, languages, entry names, name hash table, then for each language its string table followed by its strings blob.
+		* The strings of a language being contiguous, only the pages of the current language are loaded once the file is mapped.
+		************************************************************************/
+		namespace Compiled
+		{
+			static constexpr uint32_t	version{ 1 };
+			static constexpr char		extension[]{ ".trloc" };
+
+			struct Header
+			{
+				char		m_magic[ 4 ]{ 'T', 'R', 'L', 'C' };
+				uint32_t	m_version{ version };
+				uint32_t	m_nb_entries{ 0 };
+				uint32_t	m_nb_languages{ 0 };
+				uint32_t	m_hash_table_size{ 0 };		// Power of two, at least twice the number of entries.
+				uint32_t	m_languages_offset{ 0 };	// Language[ m_nb_languages ]
+				uint32_t	m_names_offset{ 0 };		// String[ m_nb_entries ]
+				uint32_t	m_hash_table_offset{ 0 };	// HashSlot[ m_hash_table_size ]
+			};
+
+			struct String
+			{
+				uint32_t	m_offset{ 0 };				// Offset of the first character, the string is followed by a '\0'.
+				uint32_t	m_size{ 0 };				// Size without the '\0', 0 if there is no translation.
+			};
+
+			struct Language
+			{
+				String		m_name;
+				uint32_t	m_strings_offset{ 0 };		// String[ m_nb_entries ], indexed by entry ID.
+				uint32_t	m_blob_size{ 0 };			// Size of the string table and the strings of the language.
+			};
+
+			struct HashSlot
+			{
+				uint32_t	m_hash{ 0 };				// Tools::hash_string of the entry name.
+				uint32_t	m_entry_id{ Uint32_Max };	// Uint32_Max for empty slots.
+			};
+		} // namespace Compiled
+
 		/************************************************************************
 		* @brief The manager that will handle translation querries in the project. Takes an enum value, and a language ID, returns the translation.
 		************************************************************************/
@@ -62,7 +105,7 @@ namespace fzn
 			~Manager();
 
 			/**
-			* @brief Load translation entries from localisation json.
+			* @brief Load translation entries from localisation json, or map the compiled file if the path ends with Compiled::extension.
 			* @param _path The path to the entries definition file.
 			**/
 			void load_entries( std::string_view _path );
@@ -72,6 +115,18 @@ namespace fzn
 			* @param [out] _localisation_data	The localisation data to be filled with the entries contained in the given file and all the available languages.
 			**/
 			static void load_entries( std::string_view _path, LocalisationData& _localisation_data );
+			/**
+			* @brief Write the given localisation data in the compiled format.
+			* @param _path				The path to the compiled file.
+			* @param _localisation_data	The localisation data to write.
+			* @return True if the file has been written.
+			**/
+			static bool save_compiled_entries( std::string_view _path, const LocalisationData& _localisation_data );
+			/**
+			* @brief Check if the entries come from a compiled file.
+			* @return True if a compiled file is mapped.
+			**/
+			bool is_compiled() const { return m_compiled_file.IsOpen(); }
 
 			/**
 			* @brief Retrieve an entry translation from its ID. The two params will be casted in uint32_t in the function, allowing to use project local types to call the function.
@@ -83,31 +138,7 @@ namespace fzn
 			template< typename EntryType, typename LanguageType >
 			std::string_view get_string( EntryType _entry, LanguageType _language, Case _case_transform = Case::COUNT )
 			{
-				auto entry_id = static_cast< uint32_t >( _entry );
-				auto language_id = static_cast< uint32_t >( _language );
-
-				if( entry_id >= m_loc_data.m_entries.size() )
-				{
-					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Entry #%d not found. (nb entries: %d)", entry_id, m_loc_data.m_entries.size() );
-					return {};
-				}
-
-				const Entry& entry{ m_loc_data.m_entries[ entry_id ] };
-
-				if( language_id >= entry.m_translations.size() )
-				{
-					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Language #%d for entry %s (#%d) not found. (max nb languages: %d, nb translations for entry: %d)", language_id, entry.m_name.c_str(), entry_id, m_loc_data.m_languages.size(), entry.m_translations.size() );
-					return {};
-				}
-
-				// If there is no translation in the requested language, return the entry name to make it obvious so it can be fixed.
-				if( entry.m_translations[ language_id ].empty() )
-				{
-					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "No translation in language #%d found for entry '%s' (#%d)", language_id, entry.m_name.c_str(), entry_id );
-					return entry.m_name;
-				}
-
-				return entry.m_translations[ language_id ];
+				return _get_string( static_cast< uint32_t >( _entry ), static_cast< uint32_t >( _language ), _case_transform );
 			}
 			/**
 			* @brief Retrieve an entry translation from its ID. The two params will be casted in uint32_t in the function, allowing to use project local types to call the function.
@@ -138,10 +169,11 @@ namespace fzn
 			{
 				auto language_id = static_cast< uint32_t >( _language );
 
-				if( language_id >= m_loc_data.m_languages.size() )
+				if( language_id >= m_loc_data.m_languages.size() || language_id == m_current_language )
 					return;
 
 				m_current_language = language_id;
+				_release_case_caches();
 			}
 
 			uint32_t get_language_id( std::string_view _language ) const;
@@ -169,8 +201,55 @@ namespace fzn
 			* @param [out] _localisation_data	The localisation data to be filled.
 			**/
 			static void _load_entry( const Json::Value& _entry, LocalisationData& _localisation_data );
+			/**
+			* @brief Map a compiled localisation file and check its header and tables.
+			* @param _path The path to the compiled file.
+			* @return True if the file is valid.
+			**/
+			bool _load_compiled_entries( std::string_view _path );
+			/**
+			* @brief Build the name hash table of the entries loaded from json.
+			**/
+			void _build_name_index();
+			/**
+			* @brief Retrieve an entry translation from its ID, in the compiled file or the json entries.
+			* @param _entry_id The ID of the entry.
+			* @param _language_id The ID of the language.
+			* @param _case_transform How to transform the case of the string. COUNT means to transformation is done.
+			* @return The translation, the entry name if there is none, empty if the entry or the language doesn't exist.
+			**/
+			std::string_view _get_string( uint32_t _entry_id, uint32_t _language_id, Case _case_transform ) const;
+			/**
+			* @brief Retrieve a string from the compiled file.
+			* @param _string The location of the string.
+			* @return The string, empty if it is out of the file.
+			**/
+			std::string_view _get_compiled_string( const Compiled::String& _string ) const;
+			uint32_t _get_nb_entries() const;
+			/**
+			* @brief Retrieve the case transformed version of a translation, transforming it on first use.
+			* @param _entry_id The ID of the entry.
+			* @param _language_id The ID of the language.
+			* @param _case_transform How to transform the case of the string.
+			* @param _translation The translation to transform.
+			* @return The transformed translation, valid until the entries are reloaded or the language changes.
+			**/
+			std::string_view _get_case_transformed_string( uint32_t _entry_id, uint32_t _language_id, Case _case_transform, std::string_view _translation ) const;
+			/**
+			* @brief Free the case transformed strings of all the languages but the current one.
+			**/
+			void _release_case_caches();
+
+			LocalisationData m_loc_data;		// Languages, and entries when loaded from json.
 
-			LocalisationData m_loc_data;
+			MappedFile							m_compiled_file;					// Compiled localisation file, mapped as long as it is used.
+			const Compiled::Header*				m_compiled_header{ nullptr };
+			const Compiled::Language*			m_compiled_languages{ nullptr };
+			const Compiled::String*				m_compiled_names{ nullptr };
+			const Compiled::HashSlot*			m_name_hash_table{ nullptr };		// Points either in the compiled file or in m_name_index.
+			uint32_t							m_name_hash_table_size{ 0 };
+			std::vector< Compiled::HashSlot >	m_name_index;						// Name hash table of the json entries.
+			mutable std::vector< StringVector >	m_case_caches;						// Case transformed translations indexed by language ID * Case::COUNT + case, then by entry ID. Filled on first use.
 
 			uint32_t	m_current_language{ 0 };	// Currently selected language for the software.
 		};
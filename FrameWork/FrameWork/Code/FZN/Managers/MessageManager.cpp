@@ -5,12 +5,14 @@
 //Portions Copyright (C) Steve Rabin, 2001
 //------------------------------------------------------------------------
 
+#include <algorithm>
+
 #include "FZN/Includes.h"
 #include "FZN/Game/Message/Message.h"
 #include "FZN/Game/GameObjectAI/GameObjectAI.h"
 #include "FZN/Game/StateMachine/StateMachine.h"
 #include "FZN/Managers/AIManager.h"
-#include "FZN/DataStructure/Vector.h"
+#include "FZN/DataStructure/DenseArray.h"
 #include "FZN/Managers/MessageManager.h"
 
 
@@ -25,7 +27,6 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	MessageManager::MessageManager()
 	{
-		m_deliveryTimer.restart();
 		m_iNbMessages = 0;
 
 		g_pFZN_MessageMgr = this;
@@ -73,20 +74,31 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void MessageManager::DeliverDelayedMessage()
 	{
+		const float fCurrentTime = GetMessagesTime();
 		int index = 0;
 
+		//The due messages are taken out of the array before being delivered, so the messages sent by their receivers don't interfere with the loop.
 		while( index < m_iNbMessages )
 		{
-			if( m_delayedMessages[index]->m_fDeliveryTime <= m_deliveryTimer.getElapsedTime().asSeconds() )
+			if( m_delayedMessages[index]->m_fDeliveryTime <= fCurrentTime )
 			{
-
-				RouteMsg( m_delayedMessages[index] );
-				delete m_delayedMessages[index];
+				m_dueMessages.push_back( m_delayedMessages[index] );
 				m_delayedMessages.Remove( index );
 				m_iNbMessages--;
 			}
 			else ++index;
 		}
+
+		//Removals change the order of the array, so the messages are sorted to be delivered in chronological order.
+		std::stable_sort( m_dueMessages.begin(), m_dueMessages.end(), []( const Message* _pLeft, const Message* _pRight ) { return _pLeft->m_fDeliveryTime < _pRight->m_fDeliveryTime; } );
+
+		for( Message* pMessage : m_dueMessages )
+		{
+			RouteMsg( pMessage );
+			delete pMessage;
+		}
+
+		m_dueMessages.clear();
 	}
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -99,10 +111,14 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void MessageManager::Send( float _delay, int _name, int _sender, int _receiver, void* _data, int _state )
 	{
+		//The GameObjects updated in a batch by the AI manager send their messages once the batch is done.
+		if( g_pFZN_AIMgr != nullptr && g_pFZN_AIMgr->DeferMessage( _delay, _name, _sender, _receiver, _data, _state ) )
+			return;
+
 		//Imediate delivery
 		if( _delay <= 0.f )
 		{
-			Message msg( m_deliveryTimer.getElapsedTime().asSeconds(), _name, _sender, _receiver, _data, _state );
+			Message msg( GetMessagesTime(), _name, _sender, _receiver, _data, _state );
 			RouteMsg( &msg );
 		}
 		else
@@ -114,7 +130,7 @@ namespace fzn
 					return;				//Already in list, don't add
 			}
 
-			float fDeliveryTime = _delay + m_deliveryTimer.getElapsedTime().asSeconds();
+			float fDeliveryTime = _delay + GetMessagesTime();
 			m_delayedMessages.PushBack( new Message( fDeliveryTime, _name, _sender, _receiver, _data, _state ) );
 			m_iNbMessages++;
 		}
@@ -139,4 +155,13 @@ namespace fzn
 			object->Process( StateMachine::EVENT_Message, _msg );
 		}
 	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Time the delays are measured with (AI domain of the time service, at the current frame)
+	//Return value : Time in seconds
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	float MessageManager::GetMessagesTime() const
+	{
+		return (float)g_pFZN_Core->GetTimeService().GetStep( TimeDomain::AI ).GetSeconds();
+	}
 }
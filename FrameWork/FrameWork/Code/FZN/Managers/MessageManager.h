@@ -10,7 +10,9 @@
 
 #define NoSender -1						//Sender of the message is nobody
 
-#include "FZN/DataStructure/Vector.h"
+#include <vector>
+
+#include "FZN/DataStructure/DenseArray.h"
 
 namespace fzn
 {
@@ -52,7 +54,7 @@ namespace fzn
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void DeliverDelayedMessage();
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-		//Sends a message 
+		//Sends a message (from a batch of updates on the worker threads of the AI manager, it is sent once the batch is done)
 		//Parameter 1 : Time of the delivery (0 if instant)
 		//Parameter 2 : Message type
 		//Parameter 3 and 4 : Sender and receiver ID
@@ -67,13 +69,18 @@ namespace fzn
 		//Parameter : Message to deliver
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void RouteMsg( Message* _message );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Time the delays are measured with (AI domain of the time service, at the current frame)
+		//Return value : Time in seconds
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		float GetMessagesTime() const;
 
 
 		/////////////////MEMBER VARIABLES/////////////////
 
-		Vector<Message*> m_delayedMessages;					//Delayed messages storage
+		DenseArray<Message*> m_delayedMessages;				//Delayed messages storage
+		std::vector<Message*> m_dueMessages;					//Delayed messages to deliver this frame, kept to avoid allocations
 		int m_iNbMessages	;									//Number of messages in the delivery list
-		sf::Clock m_deliveryTimer;								//Message delivering timer
 	};
 } //namespace fzn
 
@@ -7,7 +7,7 @@
 #include "FZN/Includes.h"
 #include "FZN/Game/Steering/SteeringEntity.h"
 #include "FZN/Game/Steering/SteeringObject.h"
-#include "FZN/DataStructure/Vector.h"
+#include "FZN/DataStructure/DenseArray.h"
 #include "FZN/Managers/SteeringManager.h"
 
 
@@ -35,7 +35,9 @@ namespace fzn
 	SteeringManager::~SteeringManager()
 	{
 		m_entities.Clear();
+		m_entitiesHandles.Clear();
 		m_objects.Clear();
+		m_objectsHandles.Clear();
 
 		g_pFZN_SteeringMgr = nullptr;
 	}
@@ -57,9 +59,9 @@ namespace fzn
 		if( _entity == nullptr )
 			return FALSE;
 
-		if( m_entities.FindElement( _entity ) == nullptr )
+		if( m_entitiesHandles.Find( _entity ) == nullptr )
 		{
-			m_entities.PushBack( _entity );
+			m_entitiesHandles.Insert( _entity, m_entities.GetHandle( m_entities.PushBack( _entity ) ) );
 			m_iNbEntities++;
 			return TRUE;
 		}
@@ -76,12 +78,14 @@ namespace fzn
 		if( _entity == nullptr || !_entity->m_isInManager )
 			return FALSE;
 
-		int iEntityIndex = m_entities.FindIndex( _entity );
+		const auto* pEntityHandle = m_entitiesHandles.Find( _entity );
 
-		if( iEntityIndex == -1 )
+		if( pEntityHandle == nullptr )
 			return FALSE;
 
-		m_entities.Remove( iEntityIndex );
+		m_entities.Remove( pEntityHandle->data );
+		m_entitiesHandles.Remove( _entity );
+		m_formationSolver.RemoveEntity( _entity );
 
 		m_iNbEntities--;
 		return TRUE;
@@ -97,9 +101,9 @@ namespace fzn
 		if( _object == nullptr )
 			return FALSE;
 
-		if( m_objects.FindElement( _object ) == nullptr )
+		if( m_objectsHandles.Find( _object ) == nullptr )
 		{
-			m_objects.PushBack( _object );
+			m_objectsHandles.Insert( _object, m_objects.GetHandle( m_objects.PushBack( _object ) ) );
 			m_iNbObjects++;
 			return TRUE;
 		}
@@ -116,22 +120,25 @@ namespace fzn
 		if( _object == nullptr || !_object->m_isInManager )
 			return FALSE;
 
-		int iObjectIndex = m_objects.FindIndex( _object );
+		const auto* pObjectHandle = m_objectsHandles.Find( _object );
 
-		if( iObjectIndex == -1 )
+		if( pObjectHandle == nullptr )
 			return FALSE;
 
-		m_objects.Remove( iObjectIndex );
+		m_objects.Remove( pObjectHandle->data );
+		m_objectsHandles.Remove( _object );
 
 		m_iNbObjects--;
 		return TRUE;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-	//Updates all the entities in the array
+	//Updates the formations, then all the entities in the array
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	void SteeringManager::Update()
 	{
+		m_formationSolver.Update();
+
 		for( int i = 0 ; i < m_iNbEntities ; ++i )
 			m_entities[i]->Update();
 	}
@@ -161,7 +168,7 @@ namespace fzn
 	//Accessor on the entities array
 	//Return value : Entities
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-	Vector<SteeringEntity*>& SteeringManager::GetEntities()
+	DenseArray<SteeringEntity*>& SteeringManager::GetEntities()
 	{
 		return m_entities;
 	}
@@ -170,8 +177,17 @@ namespace fzn
 	//Accessor on the objects array
 	//Return value : Objects
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-	Vector<SteeringObject*>& SteeringManager::GetObjects()
+	DenseArray<SteeringObject*>& SteeringManager::GetObjects()
 	{
 		return m_objects;
 	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on the formations of the entities
+	//Return value : Formation solver
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	FormationSolver& SteeringManager::GetFormationSolver()
+	{
+		return m_formationSolver;
+	}
 } //namespace fzn
@@ -7,7 +7,9 @@
 #ifndef _STEERINGMANAGER_H_
 #define _STEERINGMANAGER_H_
 
-#include "FZN/DataStructure/Vector.h"
+#include "FZN/DataStructure/DenseArray.h"
+#include "FZN/DataStructure/HashMap.h"
+#include "FZN/Game/Steering/FormationSolver.h"
 
 
 namespace fzn
@@ -55,7 +57,7 @@ namespace fzn
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		INT8 RemoveObject( SteeringObject* _object );
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-		//Updates all the entities in the array
+		//Updates the formations, then all the entities in the array
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void Update();
 
@@ -76,12 +78,17 @@ namespace fzn
 		//Accessor on the entities array
 		//Return value : Entities
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-		Vector<SteeringEntity*>& GetEntities();
+		DenseArray<SteeringEntity*>& GetEntities();
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		//Accessor on the objects array
 		//Return value : Objects
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-		Vector<SteeringObject*>& GetObjects();
+		DenseArray<SteeringObject*>& GetObjects();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the formations of the entities
+		//Return value : Formation solver
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FormationSolver& GetFormationSolver();
 
 
 		/////////////////MEMBER VARIABLES/////////////////
@@ -93,13 +100,17 @@ namespace fzn
 
 		/////////////////ENTITIES MANAGEMENT/////////////////
 
-		Vector<SteeringEntity*> m_entities;						//Container of all the steering entities		
+		DenseArray<SteeringEntity*> m_entities;					//Container of all the steering entities
+		HashMap<SteeringEntity*, DenseArray<SteeringEntity*>::Handle> m_entitiesHandles;	//Handle of each entity in the array, to find it without going through the whole array
 		int m_iNbEntities;										//The number of entities currently in the array
 
 		/////////////////OBJECTS MANAGEMENT/////////////////
 
-		Vector<SteeringObject*> m_objects;							//Container of all the animations in use			
+		DenseArray<SteeringObject*> m_objects;						//Container of all the animations in use
+		HashMap<SteeringObject*, DenseArray<SteeringObject*>::Handle> m_objectsHandles;	//Handle of each object in the array, to find it without going through the whole array
 		int m_iNbObjects;										//The number of objects currently in the array
+
+		FormationSolver m_formationSolver;						//Groups of entities following a leader in formation
 	};
 } //namespace fzn
 
@@ -254,7 +254,6 @@ namespace fzn
 		, m_bCloseAppWithLastWindow( true )
 		//, m_iTimer( 0 )
 		//, m_iDesiredFrameTime( 0 )
-		, m_fTimeFactor( 1.f )
 	{
 		//m_frameTime = m_frameClock.restart();
 
@@ -618,15 +617,12 @@ namespace fzn
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	float WindowManager::GetFrameTimeS()
 	{
-		return GetUnmodifiedFrameTimeS() * m_fTimeFactor;
+		return g_pFZN_Core->GetTimeService().GetDeltaSeconds( TimeDomain::Game );
 	}
 
 	float WindowManager::GetUnmodifiedFrameTimeS()
 	{
-		if( m_iMainWindow >= (int)m_oWindows.size() )
-			return 0;
-
-		return m_oWindows[m_iMainWindow]->m_fFrameTime;
+		return g_pFZN_Core->GetTimeService().GetDeltaSeconds( TimeDomain::Real );
 	}
 
 	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -666,13 +662,12 @@ namespace fzn
 
 	void WindowManager::SetTimeFactor( float _fTimeFactor )
 	{
-		if( _fTimeFactor >= 0.f )
-			m_fTimeFactor = _fTimeFactor;
+		g_pFZN_Core->GetTimeService().SetScale( TimeDomain::Game, _fTimeFactor );
 	}
 
 	float WindowManager::GetTimeFactor() const
 	{
-		return m_fTimeFactor;
+		return g_pFZN_Core->GetTimeService().GetScale( TimeDomain::Game );
 	}
 
 	void WindowManager::RemoveClosedWindows()
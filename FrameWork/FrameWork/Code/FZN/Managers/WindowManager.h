@@ -205,7 +205,7 @@ namespace fzn
 		/////////////////ACCESSORS / MUTATORS/////////////////
 
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
-		//Accessor on the time of a frame
+		//Accessor on the time of a frame (Game and Real domains of the time service)
 		//Return value : Time in seconds
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		float GetFrameTimeS();
@@ -227,6 +227,9 @@ namespace fzn
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void SetCloseWithLastWindow( bool _bClose );
 
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the scale of the Game time domain
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		void SetTimeFactor( float _fTimeFactor );
 		float GetTimeFactor() const;
 
@@ -239,17 +242,17 @@ namespace fzn
 	private:
 
 		template< typename CallbackType >
-		void AddCallback( CallbackType* _pObject, typename DataCallback<CallbackType>::CallbackFct _pFct, DataCallbackType _eCallbackType, int _iPriority = 0, int _iWindow = -1 )
+		DataCallbackHandle AddCallback( CallbackType* _pObject, typename DataCallback<CallbackType>::CallbackFct _pFct, DataCallbackType _eCallbackType, int _iPriority = 0, int _iWindow = -1 )
 		{
 			if( m_oWindows.empty() )
-				return;
+				return {};
 
 			int iWindow = m_iMainWindow;
 
 			if( _iWindow >= 0 && _iWindow < (int)m_oWindows.size() )
 				iWindow = _iWindow;
 
-			m_oWindows[ iWindow ]->m_oCallbacksHolder.AddCallback< CallbackType >( _pObject, _pFct, _eCallbackType, _iPriority );
+			return m_oWindows[ iWindow ]->m_oCallbacksHolder.AddCallback< CallbackType >( _pObject, _pFct, _eCallbackType, _iPriority );
 		}
 
 		template< typename CallbackType >
@@ -266,6 +269,19 @@ namespace fzn
 			m_oWindows[ iWindow ]->m_oCallbacksHolder.RemoveCallback< CallbackType >( _pObject, _pFct, _eCallbackType );
 		}
 
+		void RemoveCallback( DataCallbackHandle _oHandle, int _iWindow = -1 )
+		{
+			if( m_oWindows.empty() )
+				return;
+
+			int iWindow = m_iMainWindow;
+
+			if( _iWindow >= 0 && _iWindow < (int)m_oWindows.size() )
+				iWindow = _iWindow;
+
+			m_oWindows[ iWindow ]->m_oCallbacksHolder.RemoveCallback( _oHandle );
+		}
+
 		void RemoveClosedWindows();
 
 
@@ -277,7 +293,6 @@ namespace fzn
 		bool							m_bCloseAppWithLastWindow;	//Closes the application when the last windows is closed.
 
 		sf::Uint32						m_uMinSupportedPeriod;
-		float							m_fTimeFactor;
 	};
 } //namespace fzn
 
@@ -0,0 +1,615 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Set of colliders finding their contacts through a dynamic AABB tree
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cfloat>
+
+#include "FZN/Includes.h"
+#include "FZN/Tools/CollisionWorld.h"
+#include "FZN/Tools/ConvexCollision.h"
+
+
+namespace fzn
+{
+	namespace
+	{
+		sf::Vector2f GetRectCenter( const sf::FloatRect& _oRect )
+		{
+			return sf::Vector2f( _oRect.left + _oRect.width * 0.5f, _oRect.top + _oRect.height * 0.5f );
+		}
+
+		ConvexCollider GetRectCollider( const sf::FloatRect& _oRect )
+		{
+			return ConvexCollider::OBB( GetRectCenter( _oRect ), sf::Vector2f( _oRect.width * 0.5f, _oRect.height * 0.5f ), 0.f );
+		}
+
+		//Boxes sharing an edge overlap, as in the tree and the circle and GJK tests (Tools::CollisionAABBAABB needs a strict overlap).
+		bool AABBOverlap( const sf::FloatRect& _oRectA, const sf::FloatRect& _oRectB )
+		{
+			return _oRectA.left <= _oRectB.left + _oRectB.width && _oRectB.left <= _oRectA.left + _oRectA.width && _oRectA.top <= _oRectB.top + _oRectB.height && _oRectB.top <= _oRectA.top + _oRectA.height;
+		}
+	}
+
+	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Default parametered constructor
+	//Parameter : Margin added around the boxes of the colliders in the tree
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	CollisionWorld::CollisionWorld( float _fMargin /*= 4.f*/ )
+	: m_oTree( _fMargin )
+	{
+	}
+
+
+	/////////////////COLLIDERS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds an axis aligned box
+	//Parameter 1 : Box
+	//Parameter 2 : Value given back in the contacts and queries
+	//Return value : Identifier of the collider
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int CollisionWorld::AddAABB( const sf::FloatRect& _oAABB, void* _pUserData /*= nullptr*/ )
+	{
+		Collider oCollider;
+		oCollider.m_eType = ColliderType::AABB;
+		oCollider.m_oBounds = _oAABB;
+		oCollider.m_pUserData = _pUserData;
+
+		return _AddCollider( oCollider );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds a circle
+	//Parameter 1 : Center
+	//Parameter 2 : Radius
+	//Parameter 3 : Value given back in the contacts and queries
+	//Return value : Identifier of the collider
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int CollisionWorld::AddCircle( const sf::Vector2f& _vCenter, float _fRadius, void* _pUserData /*= nullptr*/ )
+	{
+		Collider oCollider;
+		oCollider.m_eType = ColliderType::Circle;
+		oCollider.m_vCenter = _vCenter;
+		oCollider.m_fRadius = _fRadius;
+		oCollider.m_oBounds = sf::FloatRect( _vCenter.x - _fRadius, _vCenter.y - _fRadius, _fRadius * 2.f, _fRadius * 2.f );
+		oCollider.m_pUserData = _pUserData;
+
+		return _AddCollider( oCollider );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds a convex SFML shape, it isn't copied and has to stay alive until the collider is removed
+	//Parameter 1 : Shape
+	//Parameter 2 : Value given back in the contacts and queries
+	//Return value : Identifier of the collider
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int CollisionWorld::AddShape( const sf::Shape* _pShape, void* _pUserData /*= nullptr*/ )
+	{
+		if( _pShape == nullptr )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Null shape given." );
+			return InvalidCollider;
+		}
+
+		Collider oCollider;
+		oCollider.m_eType = ColliderType::Shape;
+		oCollider.m_pShape = _pShape;
+		oCollider.m_oBounds = _pShape->getGlobalBounds();
+		oCollider.m_pUserData = _pUserData;
+
+		return _AddCollider( oCollider );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes a collider, its current contacts are reported as ended at the next update
+	//Its identifier isn't given to a new collider before that update
+	//Parameter : Identifier of the collider
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void CollisionWorld::RemoveCollider( int _iCollider )
+	{
+		if( IsColliderValid( _iCollider ) == false )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Invalid collider %d.", _iCollider );
+			return;
+		}
+
+		//Its pairs are dropped by the next update, which goes through all of them anyway. Until then the slot keeps the user data of the ended contacts and isn't given to a new collider.
+		Collider& oCollider = m_oColliders[ _iCollider ];
+		m_oTree.DestroyProxy( oCollider.m_iProxy );
+
+		oCollider.m_iProxy = DynamicAABBTree::NullNode;
+		oCollider.m_bMoved = false;
+		m_oRemovedColliders.push_back( _iCollider );
+	}
+
+	void CollisionWorld::SetAABB( int _iCollider, const sf::FloatRect& _oAABB )
+	{
+		if( IsColliderValid( _iCollider ) == false || m_oColliders[ _iCollider ].m_eType != ColliderType::AABB )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Collider %d isn't a valid box.", _iCollider );
+			return;
+		}
+
+		Collider& oCollider = m_oColliders[ _iCollider ];
+		const sf::FloatRect oPreviousBounds = oCollider.m_oBounds;
+
+		oCollider.m_oBounds = _oAABB;
+		_MoveCollider( _iCollider, oPreviousBounds );
+	}
+
+	void CollisionWorld::SetCircle( int _iCollider, const sf::Vector2f& _vCenter, float _fRadius )
+	{
+		if( IsColliderValid( _iCollider ) == false || m_oColliders[ _iCollider ].m_eType != ColliderType::Circle )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Collider %d isn't a valid circle.", _iCollider );
+			return;
+		}
+
+		Collider& oCollider = m_oColliders[ _iCollider ];
+		const sf::FloatRect oPreviousBounds = oCollider.m_oBounds;
+
+		oCollider.m_vCenter = _vCenter;
+		oCollider.m_fRadius = _fRadius;
+		oCollider.m_oBounds = sf::FloatRect( _vCenter.x - _fRadius, _vCenter.y - _fRadius, _fRadius * 2.f, _fRadius * 2.f );
+		_MoveCollider( _iCollider, oPreviousBounds );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Reads the transform of a shape collider again, to call after moving the shape
+	//Parameter : Identifier of the collider
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void CollisionWorld::UpdateShape( int _iCollider )
+	{
+		if( IsColliderValid( _iCollider ) == false || m_oColliders[ _iCollider ].m_eType != ColliderType::Shape )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Collider %d isn't a valid shape.", _iCollider );
+			return;
+		}
+
+		Collider& oCollider = m_oColliders[ _iCollider ];
+		const sf::FloatRect oPreviousBounds = oCollider.m_oBounds;
+
+		oCollider.m_oBounds = oCollider.m_pShape->getGlobalBounds();
+		_MoveCollider( _iCollider, oPreviousBounds );
+	}
+
+	bool CollisionWorld::IsColliderValid( int _iCollider ) const
+	{
+		return _iCollider >= 0 && _iCollider < (int)m_oColliders.size() && m_oColliders[ _iCollider ].m_iProxy != DynamicAABBTree::NullNode;
+	}
+
+	CollisionWorld::ColliderType CollisionWorld::GetColliderType( int _iCollider ) const
+	{
+		if( IsColliderValid( _iCollider ) == false )
+			return ColliderType::AABB;
+
+		return m_oColliders[ _iCollider ].m_eType;
+	}
+
+	void* CollisionWorld::GetUserData( int _iCollider ) const
+	{
+		if( IsColliderValid( _iCollider ) == false )
+			return nullptr;
+
+		return m_oColliders[ _iCollider ].m_pUserData;
+	}
+
+	sf::FloatRect CollisionWorld::GetColliderBounds( int _iCollider ) const
+	{
+		if( IsColliderValid( _iCollider ) == false )
+			return sf::FloatRect();
+
+		return m_oColliders[ _iCollider ].m_oBounds;
+	}
+
+
+	/////////////////CONTACTS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the new pairs around the colliders that moved and tests all the cached pairs
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void CollisionWorld::Update()
+	{
+		m_oContacts.clear();
+		m_oBeginContacts.clear();
+		m_oEndContacts.clear();
+
+		//Broad phase: only the colliders that left their fat box can have new pairs.
+		m_oNewPairs.clear();
+
+		for( int iCollider : m_oMovedColliders )
+		{
+			Collider& oCollider = m_oColliders[ iCollider ];
+
+			//Removed after it moved.
+			if( oCollider.m_bMoved == false )
+				continue;
+
+			oCollider.m_bMoved = false;
+
+			m_oTree.Query( m_oTree.GetFatAABB( oCollider.m_iProxy ), [&]( int _iProxy )
+			{
+				const int iOther = m_oTree.GetUserData( _iProxy );
+
+				if( iOther != iCollider )
+					m_oNewPairs.push_back( _GetPairKey( iCollider, iOther ) );
+
+				return true;
+			} );
+		}
+
+		m_oMovedColliders.clear();
+
+		std::sort( m_oNewPairs.begin(), m_oNewPairs.end() );
+		m_oNewPairs.erase( std::unique( m_oNewPairs.begin(), m_oNewPairs.end() ), m_oNewPairs.end() );
+
+		//Merges the new pairs in the sorted cache, keeping the state of the ones already known.
+		if( m_oNewPairs.empty() == false )
+		{
+			std::vector< Pair > oMergedPairs;
+			oMergedPairs.reserve( m_oPairs.size() + m_oNewPairs.size() );
+
+			size_t uNewPair = 0;
+
+			for( const Pair& oPair : m_oPairs )
+			{
+				while( uNewPair < m_oNewPairs.size() && m_oNewPairs[ uNewPair ] < oPair.m_uKey )
+					oMergedPairs.push_back( { m_oNewPairs[ uNewPair++ ], false } );
+
+				if( uNewPair < m_oNewPairs.size() && m_oNewPairs[ uNewPair ] == oPair.m_uKey )
+					++uNewPair;
+
+				oMergedPairs.push_back( oPair );
+			}
+
+			while( uNewPair < m_oNewPairs.size() )
+				oMergedPairs.push_back( { m_oNewPairs[ uNewPair++ ], false } );
+
+			m_oPairs.swap( oMergedPairs );
+		}
+
+		//Narrow phase on every cached pair, the ones whose fat boxes separated or with a removed collider are dropped.
+		size_t uKeptPairs = 0;
+
+		for( Pair& oPair : m_oPairs )
+		{
+			const Collider& oColliderA = m_oColliders[ (int)( oPair.m_uKey >> 32 ) ];
+			const Collider& oColliderB = m_oColliders[ (int)( oPair.m_uKey & UINT32_MAX ) ];
+
+			const bool bRemoved = oColliderA.m_iProxy == DynamicAABBTree::NullNode || oColliderB.m_iProxy == DynamicAABBTree::NullNode;
+			const bool bFatOverlap = bRemoved == false && AABBOverlap( m_oTree.GetFatAABB( oColliderA.m_iProxy ), m_oTree.GetFatAABB( oColliderB.m_iProxy ) );
+			const bool bTouching = bFatOverlap && _TestPair( oColliderA, oColliderB );
+
+			if( bTouching != oPair.m_bTouching )
+			{
+				if( bTouching )
+					m_oBeginContacts.push_back( _GetContact( oPair.m_uKey ) );
+				else
+					m_oEndContacts.push_back( _GetContact( oPair.m_uKey ) );
+			}
+
+			oPair.m_bTouching = bTouching;
+
+			if( bTouching )
+				m_oContacts.push_back( _GetContact( oPair.m_uKey ) );
+
+			if( bFatOverlap )
+				m_oPairs[ uKeptPairs++ ] = oPair;
+		}
+
+		m_oPairs.resize( uKeptPairs );
+
+		//The identifiers of the removed colliders can be given again now that their pairs are gone.
+		for( int iCollider : m_oRemovedColliders )
+		{
+			m_oColliders[ iCollider ] = Collider();
+			m_oFreeColliders.push_back( iCollider );
+		}
+
+		m_oRemovedColliders.clear();
+	}
+
+
+	/////////////////QUERIES/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the colliders overlapping a box
+	//Parameter 1 : Box to test
+	//Parameter 2 : Identifiers of the found colliders (added to the ones already in the vector)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void CollisionWorld::QueryAABB( const sf::FloatRect& _oAABB, std::vector< int >& _oColliders ) const
+	{
+		m_oTree.Query( _oAABB, [&]( int _iProxy )
+		{
+			const int iCollider = m_oTree.GetUserData( _iProxy );
+
+			if( _TestAABB( m_oColliders[ iCollider ], _oAABB ) )
+				_oColliders.push_back( iCollider );
+
+			return true;
+		} );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the colliders containing a point
+	//Parameter 1 : Point to test
+	//Parameter 2 : Identifiers of the found colliders (added to the ones already in the vector)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void CollisionWorld::QueryPoint( const sf::Vector2f& _vPoint, std::vector< int >& _oColliders ) const
+	{
+		m_oTree.QueryPoint( _vPoint, [&]( int _iProxy )
+		{
+			const int iCollider = m_oTree.GetUserData( _iProxy );
+
+			if( _TestPoint( m_oColliders[ iCollider ], _vPoint ) )
+				_oColliders.push_back( iCollider );
+
+			return true;
+		} );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the first collider crossed by a segment
+	//Parameter 1 & 2 : Start and end of the segment
+	//Parameter 3 : Closest hit
+	//Return value : A collider has been hit (true) or not
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool CollisionWorld::RayCast( const sf::Vector2f& _vStart, const sf::Vector2f& _vEnd, RayCastHit& _oHit ) const
+	{
+		_oHit = RayCastHit();
+
+		m_oTree.RayCast( _vStart, _vEnd, [&]( int _iProxy, float _fMaxFraction )
+		{
+			const int iCollider = m_oTree.GetUserData( _iProxy );
+			RayCastHit oHit;
+
+			if( _RayCastCollider( m_oColliders[ iCollider ], _vStart, _vEnd, oHit ) == false || oHit.m_fFraction >= _fMaxFraction )
+				return _fMaxFraction;
+
+			_oHit = oHit;
+			_oHit.m_iCollider = iCollider;
+			_oHit.m_pUserData = m_oColliders[ iCollider ].m_pUserData;
+
+			return oHit.m_fFraction;
+		} );
+
+		return _oHit.m_iCollider != InvalidCollider;
+	}
+
+
+	/////////////////PRIVATE FUNCTIONS/////////////////
+
+	uint64_t CollisionWorld::_GetPairKey( int _iColliderA, int _iColliderB )
+	{
+		if( _iColliderA > _iColliderB )
+			std::swap( _iColliderA, _iColliderB );
+
+		return ( (uint64_t)_iColliderA << 32 ) | (uint64_t)_iColliderB;
+	}
+
+	CollisionWorld::Contact CollisionWorld::_GetContact( uint64_t _uKey ) const
+	{
+		Contact oContact;
+		oContact.m_iColliderA = (int)( _uKey >> 32 );
+		oContact.m_iColliderB = (int)( _uKey & UINT32_MAX );
+		oContact.m_pUserDataA = m_oColliders[ oContact.m_iColliderA ].m_pUserData;
+		oContact.m_pUserDataB = m_oColliders[ oContact.m_iColliderB ].m_pUserData;
+
+		return oContact;
+	}
+
+	int CollisionWorld::_AddCollider( Collider& _oCollider )
+	{
+		int iCollider = (int)m_oColliders.size();
+
+		if( m_oFreeColliders.empty() == false )
+		{
+			iCollider = m_oFreeColliders.back();
+			m_oFreeColliders.pop_back();
+		}
+		else
+			m_oColliders.emplace_back();
+
+		_oCollider.m_iProxy = m_oTree.CreateProxy( _oCollider.m_oBounds, iCollider );
+		_oCollider.m_bMoved = true;
+
+		m_oColliders[ iCollider ] = _oCollider;
+		m_oMovedColliders.push_back( iCollider );
+
+		return iCollider;
+	}
+
+	void CollisionWorld::_MoveCollider( int _iCollider, const sf::FloatRect& _oPreviousBounds )
+	{
+		Collider& oCollider = m_oColliders[ _iCollider ];
+		const sf::Vector2f vDisplacement = GetRectCenter( oCollider.m_oBounds ) - GetRectCenter( _oPreviousBounds );
+
+		if( m_oTree.MoveProxy( oCollider.m_iProxy, oCollider.m_oBounds, vDisplacement ) && oCollider.m_bMoved == false )
+		{
+			oCollider.m_bMoved = true;
+			m_oMovedColliders.push_back( _iCollider );
+		}
+	}
+
+	bool CollisionWorld::_TestPair( const Collider& _oColliderA, const Collider& _oColliderB ) const
+	{
+		const Collider* pA = &_oColliderA;
+		const Collider* pB = &_oColliderB;
+
+		//Orders the types so each combination has only one case.
+		if( pA->m_eType > pB->m_eType )
+			std::swap( pA, pB );
+
+		if( pB->m_eType == ColliderType::Shape )
+		{
+			const ConvexCollider oShapeB = ConvexCollider::FromShape( pB->m_pShape );
+
+			if( pA->m_eType == ColliderType::Shape )
+				return Math::GJKIntersect( ConvexCollider::FromShape( pA->m_pShape ), oShapeB );
+
+			if( pA->m_eType == ColliderType::Circle )
+				return Math::GJKIntersect( ConvexCollider::Circle( pA->m_vCenter, pA->m_fRadius ), oShapeB );
+
+			return Math::GJKIntersect( GetRectCollider( pA->m_oBounds ), oShapeB );
+		}
+
+		if( pB->m_eType == ColliderType::Circle )
+		{
+			if( pA->m_eType == ColliderType::Circle )
+				return Tools::CollisionCircleCircle( pA->m_vCenter, pA->m_fRadius, pB->m_vCenter, pB->m_fRadius );
+
+			return Tools::CollisionAABBCircle( pA->m_oBounds, pB->m_vCenter, pB->m_fRadius );
+		}
+
+		return AABBOverlap( pA->m_oBounds, pB->m_oBounds );
+	}
+
+	bool CollisionWorld::_TestAABB( const Collider& _oCollider, const sf::FloatRect& _oAABB ) const
+	{
+		switch( _oCollider.m_eType )
+		{
+			case ColliderType::Circle:
+				return Tools::CollisionAABBCircle( _oAABB, _oCollider.m_vCenter, _oCollider.m_fRadius );
+			case ColliderType::Shape:
+				return Math::GJKIntersect( GetRectCollider( _oAABB ), ConvexCollider::FromShape( _oCollider.m_pShape ) );
+			case ColliderType::AABB:
+			default:
+				return AABBOverlap( _oCollider.m_oBounds, _oAABB );
+		}
+	}
+
+	bool CollisionWorld::_TestPoint( const Collider& _oCollider, const sf::Vector2f& _vPoint ) const
+	{
+		switch( _oCollider.m_eType )
+		{
+			case ColliderType::Circle:
+				return Math::VectorLengthSq( _vPoint - _oCollider.m_vCenter ) <= Math::Square( _oCollider.m_fRadius );
+			case ColliderType::Shape:
+				return Tools::CollisionOBBPoint( *_oCollider.m_pShape, _vPoint );
+			case ColliderType::AABB:
+			default:
+				return Tools::CollisionAABBPoint( _oCollider.m_oBounds, _vPoint );
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Intersection between a segment and a collider
+	//Parameter 1 : Collider
+	//Parameter 2 & 3 : Start and end of the segment
+	//Parameter 4 : Hit to fill, only its fraction, point and normal are set
+	//Return value : The segment hits the collider (true) or not
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool CollisionWorld::_RayCastCollider( const Collider& _oCollider, const sf::Vector2f& _vStart, const sf::Vector2f& _vEnd, RayCastHit& _oHit ) const
+	{
+		const sf::Vector2f vSegment = _vEnd - _vStart;
+		float fEnter = 0.f;
+		sf::Vector2f vNormal = -Math::VectorNormalization( vSegment );
+
+		if( _oCollider.m_eType == ColliderType::Circle )
+		{
+			const sf::Vector2f vToStart = _vStart - _oCollider.m_vCenter;
+			const float fC = Math::VectorLengthSq( vToStart ) - Math::Square( _oCollider.m_fRadius );
+
+			if( fC > 0.f )
+			{
+				const float fA = Math::VectorLengthSq( vSegment );
+				const float fB = Math::VectorDot( vToStart, vSegment );
+				const float fDiscriminant = fB * fB - fA * fC;
+
+				if( fA <= FLT_EPSILON || fB >= 0.f || fDiscriminant < 0.f )
+					return false;
+
+				fEnter = ( -fB - std::sqrt( fDiscriminant ) ) / fA;
+
+				if( fEnter > 1.f )
+					return false;
+
+				vNormal = Math::VectorNormalization( vToStart + vSegment * fEnter );
+			}
+		}
+		else
+		{
+			//Clips the segment by each side of the convex polygon (Cyrus-Beck), the last side it enters gives the normal.
+			sf::Vector2f pBoxPoints[ 4 ];
+			const sf::Vector2f* pPoints = pBoxPoints;
+			std::vector< sf::Vector2f > oShapePoints;
+			int iPointsNumber = 4;
+
+			if( _oCollider.m_eType == ColliderType::Shape )
+			{
+				const sf::Transform& rTransform = _oCollider.m_pShape->getTransform();
+				iPointsNumber = (int)_oCollider.m_pShape->getPointCount();
+				oShapePoints.resize( iPointsNumber );
+
+				for( int iPoint = 0 ; iPoint < iPointsNumber ; ++iPoint )
+					oShapePoints[ iPoint ] = rTransform.transformPoint( _oCollider.m_pShape->getPoint( iPoint ) );
+
+				pPoints = oShapePoints.data();
+			}
+			else
+			{
+				const sf::FloatRect& oBounds = _oCollider.m_oBounds;
+				pBoxPoints[ 0 ] = sf::Vector2f( oBounds.left, oBounds.top );
+				pBoxPoints[ 1 ] = sf::Vector2f( oBounds.left + oBounds.width, oBounds.top );
+				pBoxPoints[ 2 ] = sf::Vector2f( oBounds.left + oBounds.width, oBounds.top + oBounds.height );
+				pBoxPoints[ 3 ] = sf::Vector2f( oBounds.left, oBounds.top + oBounds.height );
+			}
+
+			if( iPointsNumber < 3 )
+				return false;
+
+			float fArea = 0.f;
+
+			for( int iPoint = 0 ; iPoint < iPointsNumber ; ++iPoint )
+			{
+				const sf::Vector2f& vPoint = pPoints[ iPoint ];
+				const sf::Vector2f& vNext = pPoints[ ( iPoint + 1 ) % iPointsNumber ];
+				fArea += vPoint.x * vNext.y - vPoint.y * vNext.x;
+			}
+
+			const float fOrientation = fArea >= 0.f ? 1.f : -1.f;
+			float fExit = 1.f;
+
+			for( int iPoint = 0 ; iPoint < iPointsNumber ; ++iPoint )
+			{
+				const sf::Vector2f vEdge = pPoints[ ( iPoint + 1 ) % iPointsNumber ] - pPoints[ iPoint ];
+				const sf::Vector2f vEdgeNormal = sf::Vector2f( vEdge.y, -vEdge.x ) * fOrientation;
+
+				const float fNumerator = Math::VectorDot( vEdgeNormal, pPoints[ iPoint ] - _vStart );
+				const float fDenominator = Math::VectorDot( vEdgeNormal, vSegment );
+
+				if( fDenominator == 0.f )
+				{
+					if( fNumerator < 0.f )
+						return false;
+
+					continue;
+				}
+
+				const float fRatio = fNumerator / fDenominator;
+
+				if( fDenominator < 0.f && fRatio > fEnter )
+				{
+					fEnter = fRatio;
+					vNormal = Math::VectorNormalization( vEdgeNormal );
+				}
+				else if( fDenominator > 0.f && fRatio < fExit )
+					fExit = fRatio;
+
+				if( fExit < fEnter )
+					return false;
+			}
+		}
+
+		_oHit.m_fFraction = fEnter;
+		_oHit.m_vPoint = _vStart + vSegment * fEnter;
+		_oHit.m_vNormal = vNormal;
+
+		return true;
+	}
+} //namespace fzn
@@ -0,0 +1,208 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Set of colliders finding their contacts through a dynamic AABB tree
+//------------------------------------------------------------------------
+
+#ifndef _COLLISIONWORLD_H_
+#define _COLLISIONWORLD_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "FZN/Defines.h"
+#include "FZN/Tools/DynamicAABBTree.h"
+
+#pragma warning( push )
+#pragma warning( disable: 4251 )
+
+
+namespace sf
+{
+	class Shape;
+}
+
+namespace fzn
+{
+	//The broad phase keeps the pairs of colliders whose fat boxes overlap from one update to the next, and only looks for new ones around the colliders that left their fat box.
+	//The narrow phase then tests the cached pairs with the collision functions of Tools (and GJK for the convex shapes).
+	//Contacts are reported as a whole list plus the ones that began and ended during the last update.
+	//Colliders that only touch (shared edge, tangent circles) are in contact, as in the queries.
+	class FZN_EXPORT CollisionWorld
+	{
+	public:
+		enum class ColliderType : uint8_t
+		{
+			AABB,
+			Circle,
+			Shape,						//Convex sf::Shape (rotated rectangle, polygon...) with its transform
+		};
+
+		static constexpr int InvalidCollider{ -1 };
+
+		struct Contact
+		{
+			int		m_iColliderA{ InvalidCollider };				//Smallest identifier of the two
+			int		m_iColliderB{ InvalidCollider };
+			void*	m_pUserDataA{ nullptr };						//Still valid in the ended contacts of a removed collider
+			void*	m_pUserDataB{ nullptr };
+		};
+
+		struct RayCastHit
+		{
+			int				m_iCollider{ InvalidCollider };
+			void*			m_pUserData{ nullptr };
+			sf::Vector2f	m_vPoint{ 0.f, 0.f };
+			sf::Vector2f	m_vNormal{ 0.f, 0.f };					//Opposite of the ray when it starts inside the collider
+			float			m_fFraction{ 1.f };						//Position of the hit on the segment, from 0 (start) to 1 (end)
+		};
+
+		/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Default parametered constructor
+		//Parameter : Margin added around the boxes of the colliders in the tree
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		CollisionWorld( float _fMargin = 4.f );
+
+
+		/////////////////COLLIDERS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds an axis aligned box
+		//Parameter 1 : Box
+		//Parameter 2 : Value given back in the contacts and queries
+		//Return value : Identifier of the collider
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int AddAABB( const sf::FloatRect& _oAABB, void* _pUserData = nullptr );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a circle
+		//Parameter 1 : Center
+		//Parameter 2 : Radius
+		//Parameter 3 : Value given back in the contacts and queries
+		//Return value : Identifier of the collider
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int AddCircle( const sf::Vector2f& _vCenter, float _fRadius, void* _pUserData = nullptr );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a convex SFML shape, it isn't copied and has to stay alive until the collider is removed
+		//Parameter 1 : Shape
+		//Parameter 2 : Value given back in the contacts and queries
+		//Return value : Identifier of the collider
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int AddShape( const sf::Shape* _pShape, void* _pUserData = nullptr );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes a collider, its current contacts are reported as ended at the next update
+		//Its identifier isn't given to a new collider before that update
+		//Parameter : Identifier of the collider
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void RemoveCollider( int _iCollider );
+
+		void SetAABB( int _iCollider, const sf::FloatRect& _oAABB );
+		void SetCircle( int _iCollider, const sf::Vector2f& _vCenter, float _fRadius );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Reads the transform of a shape collider again, to call after moving the shape
+		//Parameter : Identifier of the collider
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void UpdateShape( int _iCollider );
+
+		bool IsColliderValid( int _iCollider ) const;
+		ColliderType GetColliderType( int _iCollider ) const;
+		void* GetUserData( int _iCollider ) const;
+		sf::FloatRect GetColliderBounds( int _iCollider ) const;
+		int GetCollidersNumber() const { return m_oTree.GetProxiesNumber(); }
+		const DynamicAABBTree& GetTree() const { return m_oTree; }
+
+
+		/////////////////CONTACTS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the new pairs around the colliders that moved and tests all the cached pairs
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Update();
+
+		const std::vector< Contact >& GetContacts() const { return m_oContacts; }
+		const std::vector< Contact >& GetBeginContacts() const { return m_oBeginContacts; }
+		const std::vector< Contact >& GetEndContacts() const { return m_oEndContacts; }
+
+
+		/////////////////QUERIES/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the colliders overlapping a box
+		//Parameter 1 : Box to test
+		//Parameter 2 : Identifiers of the found colliders (added to the ones already in the vector)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void QueryAABB( const sf::FloatRect& _oAABB, std::vector< int >& _oColliders ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the colliders containing a point
+		//Parameter 1 : Point to test
+		//Parameter 2 : Identifiers of the found colliders (added to the ones already in the vector)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void QueryPoint( const sf::Vector2f& _vPoint, std::vector< int >& _oColliders ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the first collider crossed by a segment
+		//Parameter 1 & 2 : Start and end of the segment
+		//Parameter 3 : Closest hit
+		//Return value : A collider has been hit (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool RayCast( const sf::Vector2f& _vStart, const sf::Vector2f& _vEnd, RayCastHit& _oHit ) const;
+
+	private:
+		struct Collider
+		{
+			ColliderType		m_eType{ ColliderType::AABB };
+			int					m_iProxy{ DynamicAABBTree::NullNode };	//NullNode when the slot is free or the collider removed
+			sf::FloatRect		m_oBounds;
+			sf::Vector2f		m_vCenter{ 0.f, 0.f };					//Circle only
+			float				m_fRadius{ 0.f };						//Circle only
+			const sf::Shape*	m_pShape{ nullptr };
+			void*				m_pUserData{ nullptr };
+			bool				m_bMoved{ false };						//Left its fat box since the last update
+		};
+
+		//Pair of colliders whose fat boxes overlap, sorted by their identifiers.
+		struct Pair
+		{
+			uint64_t	m_uKey{ 0 };
+			bool		m_bTouching{ false };
+		};
+
+		static uint64_t _GetPairKey( int _iColliderA, int _iColliderB );
+		Contact _GetContact( uint64_t _uKey ) const;
+
+		int _AddCollider( Collider& _oCollider );
+		void _MoveCollider( int _iCollider, const sf::FloatRect& _oPreviousBounds );
+		bool _TestPair( const Collider& _oColliderA, const Collider& _oColliderB ) const;
+		bool _TestAABB( const Collider& _oCollider, const sf::FloatRect& _oAABB ) const;
+		bool _TestPoint( const Collider& _oCollider, const sf::Vector2f& _vPoint ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Intersection between a segment and a collider
+		//Parameter 1 : Collider
+		//Parameter 2 & 3 : Start and end of the segment
+		//Parameter 4 : Hit to fill, only its fraction, point and normal are set
+		//Return value : The segment hits the collider (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool _RayCastCollider( const Collider& _oCollider, const sf::Vector2f& _vStart, const sf::Vector2f& _vEnd, RayCastHit& _oHit ) const;
+
+
+		/////////////////MEMBER VARIABLES/////////////////
+
+		DynamicAABBTree			m_oTree;
+		std::vector< Collider >	m_oColliders;
+		std::vector< int >		m_oFreeColliders;
+		std::vector< int >		m_oMovedColliders;
+		std::vector< Pair >		m_oPairs;
+		std::vector< uint64_t >	m_oNewPairs;							//Kept between updates to avoid allocating at each one
+		std::vector< Contact >	m_oContacts;
+		std::vector< Contact >	m_oBeginContacts;
+		std::vector< Contact >	m_oEndContacts;
+		std::vector< int >		m_oRemovedColliders;					//Freed at the next update, once their pairs are dropped
+	};
+} //namespace fzn
+
+#pragma warning( pop )
+
+#endif //_COLLISIONWORLD_H_
@@ -0,0 +1,622 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Collision queries between convex shapes (GJK and EPA)
+//------------------------------------------------------------------------
+
+#include <cfloat>
+#include <cmath>
+
+#include "FZN/Includes.h"
+#include "FZN/Tools/ConvexCollision.h"
+
+
+namespace fzn
+{
+	/////////////////CONSTRUCTION/////////////////
+
+	ConvexCollider::ConvexCollider( Type _eType )
+	: m_eType( _eType )
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Convex polygon given in world coordinates
+	//Parameter 1 : Points of the polygon (any order, the ones inside the hull are ignored)
+	//Parameter 2 : Number of points
+	//Parameter 3 : Radius rounding the polygon
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	ConvexCollider ConvexCollider::Polygon( const sf::Vector2f* _pPoints, int _iPointsNumber, float _fRadius /*= 0.f*/ )
+	{
+		ConvexCollider oCollider( Type::Polygon );
+		oCollider.m_pPoints = _pPoints;
+		oCollider.m_iPointsNumber = _pPoints != nullptr ? _iPointsNumber : 0;
+		oCollider.m_fRadius = _fRadius;
+
+		return oCollider;
+	}
+
+	ConvexCollider ConvexCollider::Circle( const sf::Vector2f& _vCenter, float _fRadius )
+	{
+		ConvexCollider oCollider( Type::Circle );
+		oCollider.m_vPointA = _vCenter;
+		oCollider.m_fRadius = _fRadius;
+
+		return oCollider;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Segment inflated by a radius
+	//Parameter 1 & 2 : Ends of the segment
+	//Parameter 3 : Radius
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	ConvexCollider ConvexCollider::Capsule( const sf::Vector2f& _vPointA, const sf::Vector2f& _vPointB, float _fRadius )
+	{
+		ConvexCollider oCollider( Type::Capsule );
+		oCollider.m_vPointA = _vPointA;
+		oCollider.m_vPointB = _vPointB;
+		oCollider.m_fRadius = _fRadius;
+
+		return oCollider;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Oriented box
+	//Parameter 1 : Center of the box
+	//Parameter 2 : Half of its size on its own axes
+	//Parameter 3 : Rotation (radians)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	ConvexCollider ConvexCollider::OBB( const sf::Vector2f& _vCenter, const sf::Vector2f& _vHalfExtents, float _fAngle )
+	{
+		const float fCos = std::cos( _fAngle );
+		const float fSin = std::sin( _fAngle );
+
+		ConvexCollider oCollider( Type::OBB );
+		oCollider.m_vPointA = _vCenter;
+		oCollider.m_vAxisX = sf::Vector2f( fCos, fSin ) * _vHalfExtents.x;
+		oCollider.m_vAxisY = sf::Vector2f( -fSin, fCos ) * _vHalfExtents.y;
+
+		return oCollider;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//SFML shape with its transform, its points are read at each query (Math::GetFarthestPointInDirection)
+	//Parameter : Convex shape (a null one gives an invalid collider)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	ConvexCollider ConvexCollider::FromShape( const sf::Shape* _pShape )
+	{
+		if( _pShape == nullptr )
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Null shape given." );
+
+		ConvexCollider oCollider( Type::Shape );
+		oCollider.m_pShape = _pShape;
+
+		return oCollider;
+	}
+
+
+	/////////////////SUPPORT FUNCTIONS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the farthest point of the shape in a given direction
+	//Parameter : Direction (doesn't need to be normalized)
+	//Return value : Farthest point, radius included
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	sf::Vector2f ConvexCollider::GetSupportPoint( const sf::Vector2f& _vDirection ) const
+	{
+		const sf::Vector2f vCorePoint = GetCoreSupportPoint( _vDirection );
+
+		if( m_fRadius <= 0.f )
+			return vCorePoint;
+
+		return vCorePoint + Math::VectorNormalization( _vDirection ) * m_fRadius;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the farthest point of the core of the shape in a given direction
+	//Parameter : Direction (doesn't need to be normalized)
+	//Return value : Farthest point, radius excluded
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	sf::Vector2f ConvexCollider::GetCoreSupportPoint( const sf::Vector2f& _vDirection ) const
+	{
+		switch( m_eType )
+		{
+			case Type::Circle:
+				return m_vPointA;
+			case Type::Capsule:
+				return Math::VectorDot( m_vPointB - m_vPointA, _vDirection ) > 0.f ? m_vPointB : m_vPointA;
+			case Type::OBB:
+			{
+				const sf::Vector2f vX = Math::VectorDot( m_vAxisX, _vDirection ) >= 0.f ? m_vAxisX : -m_vAxisX;
+				const sf::Vector2f vY = Math::VectorDot( m_vAxisY, _vDirection ) >= 0.f ? m_vAxisY : -m_vAxisY;
+
+				return m_vPointA + vX + vY;
+			}
+			case Type::Shape:
+				return Math::GetFarthestPointInDirection( m_pShape, _vDirection );
+			case Type::Polygon:
+			default:
+			{
+				if( m_iPointsNumber <= 0 )
+					return sf::Vector2f( 0.f, 0.f );
+
+				int iBestPoint = 0;
+				float fBestProjection = Math::VectorDot( m_pPoints[ 0 ], _vDirection );
+
+				for( int iPoint = 1 ; iPoint < m_iPointsNumber ; ++iPoint )
+				{
+					const float fProjection = Math::VectorDot( m_pPoints[ iPoint ], _vDirection );
+
+					if( fProjection > fBestProjection )
+					{
+						fBestProjection = fProjection;
+						iBestPoint = iPoint;
+					}
+				}
+
+				return m_pPoints[ iBestPoint ];
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on a point inside the shape, used to start the searches
+	//Return value : Center of the core
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	sf::Vector2f ConvexCollider::GetCenter() const
+	{
+		switch( m_eType )
+		{
+			case Type::Capsule:
+				return ( m_vPointA + m_vPointB ) * 0.5f;
+			case Type::Shape:
+				return m_pShape != nullptr ? m_pShape->getTransform().transformPoint( m_pShape->getLocalBounds().left + m_pShape->getLocalBounds().width * 0.5f, m_pShape->getLocalBounds().top + m_pShape->getLocalBounds().height * 0.5f ) : sf::Vector2f( 0.f, 0.f );
+			case Type::Polygon:
+			{
+				sf::Vector2f vCenter( 0.f, 0.f );
+
+				for( int iPoint = 0 ; iPoint < m_iPointsNumber ; ++iPoint )
+					vCenter += m_pPoints[ iPoint ];
+
+				return m_iPointsNumber > 0 ? vCenter / (float)m_iPointsNumber : vCenter;
+			}
+			default:
+				return m_vPointA;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Tells if the collider has something to collide with, the queries ignore the invalid ones
+	//Return value : False for a shape collider without shape or a polygon without points
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool ConvexCollider::IsValid() const
+	{
+		switch( m_eType )
+		{
+			case Type::Shape:
+				return m_pShape != nullptr;
+			case Type::Polygon:
+				return m_pPoints != nullptr && m_iPointsNumber > 0;
+			default:
+				return true;
+		}
+	}
+
+
+	namespace Math
+	{
+		namespace
+		{
+			static constexpr int	MaxGJKIterations{ 32 };
+			static constexpr int	MaxEPAVertices{ 64 };
+			static constexpr float	GJKTolerance{ 0.000001f };			//Relative progress under which GJK stops
+			static constexpr float	EPATolerance{ 0.0001f };			//Relative expansion under which EPA stops
+			static constexpr float	OverlapTolerance{ 0.0001f };		//Distance between the cores under which they are considered overlapping
+
+			//Point of the Minkowski difference A - B, with the points of A and B it comes from to find the closest points.
+			struct SimplexVertex
+			{
+				sf::Vector2f	m_vPoint;
+				sf::Vector2f	m_vPointA;
+				sf::Vector2f	m_vPointB;
+				float			m_fWeight{ 1.f };						//Barycentric coordinate of the closest point to the origin
+			};
+
+			struct Simplex
+			{
+				SimplexVertex	m_oVertices[ 3 ];
+				int				m_iCount{ 0 };
+			};
+
+			float Cross( const sf::Vector2f& _vA, const sf::Vector2f& _vB )
+			{
+				return _vA.x * _vB.y - _vA.y * _vB.x;
+			}
+
+			SimplexVertex GetMinkowskiVertex( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB, const sf::Vector2f& _vDirection, bool _bCore )
+			{
+				SimplexVertex oVertex;
+				oVertex.m_vPointA = _bCore ? _oShapeA.GetCoreSupportPoint( _vDirection ) : _oShapeA.GetSupportPoint( _vDirection );
+				oVertex.m_vPointB = _bCore ? _oShapeB.GetCoreSupportPoint( -_vDirection ) : _oShapeB.GetSupportPoint( -_vDirection );
+				oVertex.m_vPoint = oVertex.m_vPointA - oVertex.m_vPointB;
+
+				return oVertex;
+			}
+
+			//Reduces the simplex to the smallest feature holding its closest point to the origin and computes the weights of that point (Voronoi regions).
+			void ReduceSimplex( Simplex& _oSimplex )
+			{
+				SimplexVertex* pVertices = _oSimplex.m_oVertices;
+
+				if( _oSimplex.m_iCount == 1 )
+				{
+					pVertices[ 0 ].m_fWeight = 1.f;
+					return;
+				}
+
+				const sf::Vector2f& vW1 = pVertices[ 0 ].m_vPoint;
+				const sf::Vector2f& vW2 = pVertices[ 1 ].m_vPoint;
+
+				if( _oSimplex.m_iCount == 2 )
+				{
+					const sf::Vector2f vE12 = vW2 - vW1;
+					const float fD12_1 = VectorDot( vW2, vE12 );
+					const float fD12_2 = -VectorDot( vW1, vE12 );
+
+					if( fD12_2 <= 0.f )
+					{
+						pVertices[ 0 ].m_fWeight = 1.f;
+						_oSimplex.m_iCount = 1;
+					}
+					else if( fD12_1 <= 0.f )
+					{
+						pVertices[ 0 ] = pVertices[ 1 ];
+						pVertices[ 0 ].m_fWeight = 1.f;
+						_oSimplex.m_iCount = 1;
+					}
+					else
+					{
+						const float fInvSum = 1.f / ( fD12_1 + fD12_2 );
+						pVertices[ 0 ].m_fWeight = fD12_1 * fInvSum;
+						pVertices[ 1 ].m_fWeight = fD12_2 * fInvSum;
+					}
+					return;
+				}
+
+				const sf::Vector2f& vW3 = pVertices[ 2 ].m_vPoint;
+
+				const sf::Vector2f vE12 = vW2 - vW1;
+				const float fD12_1 = VectorDot( vW2, vE12 );
+				const float fD12_2 = -VectorDot( vW1, vE12 );
+
+				const sf::Vector2f vE13 = vW3 - vW1;
+				const float fD13_1 = VectorDot( vW3, vE13 );
+				const float fD13_2 = -VectorDot( vW1, vE13 );
+
+				const sf::Vector2f vE23 = vW3 - vW2;
+				const float fD23_1 = VectorDot( vW3, vE23 );
+				const float fD23_2 = -VectorDot( vW2, vE23 );
+
+				const float fArea = Cross( vE12, vE13 );
+				const float fD123_1 = fArea * Cross( vW2, vW3 );
+				const float fD123_2 = fArea * Cross( vW3, vW1 );
+				const float fD123_3 = fArea * Cross( vW1, vW2 );
+
+				if( fD12_2 <= 0.f && fD13_2 <= 0.f )
+				{
+					pVertices[ 0 ].m_fWeight = 1.f;
+					_oSimplex.m_iCount = 1;
+				}
+				else if( fD12_1 > 0.f && fD12_2 > 0.f && fD123_3 <= 0.f )
+				{
+					const float fInvSum = 1.f / ( fD12_1 + fD12_2 );
+					pVertices[ 0 ].m_fWeight = fD12_1 * fInvSum;
+					pVertices[ 1 ].m_fWeight = fD12_2 * fInvSum;
+					_oSimplex.m_iCount = 2;
+				}
+				else if( fD13_1 > 0.f && fD13_2 > 0.f && fD123_2 <= 0.f )
+				{
+					const float fInvSum = 1.f / ( fD13_1 + fD13_2 );
+					pVertices[ 1 ] = pVertices[ 2 ];
+					pVertices[ 0 ].m_fWeight = fD13_1 * fInvSum;
+					pVertices[ 1 ].m_fWeight = fD13_2 * fInvSum;
+					_oSimplex.m_iCount = 2;
+				}
+				else if( fD12_1 <= 0.f && fD23_2 <= 0.f )
+				{
+					pVertices[ 0 ] = pVertices[ 1 ];
+					pVertices[ 0 ].m_fWeight = 1.f;
+					_oSimplex.m_iCount = 1;
+				}
+				else if( fD13_1 <= 0.f && fD23_1 <= 0.f )
+				{
+					pVertices[ 0 ] = pVertices[ 2 ];
+					pVertices[ 0 ].m_fWeight = 1.f;
+					_oSimplex.m_iCount = 1;
+				}
+				else if( fD23_1 > 0.f && fD23_2 > 0.f && fD123_1 <= 0.f )
+				{
+					const float fInvSum = 1.f / ( fD23_1 + fD23_2 );
+					pVertices[ 0 ] = pVertices[ 2 ];
+					pVertices[ 0 ].m_fWeight = fD23_2 * fInvSum;
+					pVertices[ 1 ].m_fWeight = fD23_1 * fInvSum;
+					_oSimplex.m_iCount = 2;
+				}
+				else
+				{
+					//The origin is inside the triangle.
+					const float fInvSum = 1.f / ( fD123_1 + fD123_2 + fD123_3 );
+					pVertices[ 0 ].m_fWeight = fD123_1 * fInvSum;
+					pVertices[ 1 ].m_fWeight = fD123_2 * fInvSum;
+					pVertices[ 2 ].m_fWeight = fD123_3 * fInvSum;
+				}
+			}
+
+			sf::Vector2f GetClosestPoint( const Simplex& _oSimplex )
+			{
+				sf::Vector2f vPoint( 0.f, 0.f );
+
+				for( int iVertex = 0 ; iVertex < _oSimplex.m_iCount ; ++iVertex )
+					vPoint += _oSimplex.m_oVertices[ iVertex ].m_vPoint * _oSimplex.m_oVertices[ iVertex ].m_fWeight;
+
+				return vPoint;
+			}
+
+			//Distance between the shapes (or their cores), 0 if they overlap. Stops early with a lower bound of the distance once it is above _fSeparationBound.
+			float RunGJK( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB, bool _bCore, float _fSeparationBound, Simplex& _oSimplex, sf::Vector2f& _vPointA, sf::Vector2f& _vPointB )
+			{
+				sf::Vector2f vDirection = _oShapeB.GetCenter() - _oShapeA.GetCenter();
+
+				if( VectorLengthSq( vDirection ) < FLT_EPSILON )
+					vDirection = sf::Vector2f( 1.f, 0.f );
+
+				_oSimplex.m_iCount = 1;
+				_oSimplex.m_oVertices[ 0 ] = GetMinkowskiVertex( _oShapeA, _oShapeB, vDirection, _bCore );
+
+				float fDistance = 0.f;
+
+				for( int iIteration = 0 ; iIteration < MaxGJKIterations ; ++iIteration )
+				{
+					ReduceSimplex( _oSimplex );
+
+					const sf::Vector2f vClosest = GetClosestPoint( _oSimplex );
+					const float fDistanceSq = VectorLengthSq( vClosest );
+					fDistance = std::sqrt( fDistanceSq );
+
+					if( _oSimplex.m_iCount == 3 || fDistanceSq <= OverlapTolerance * OverlapTolerance )
+					{
+						fDistance = 0.f;
+						break;
+					}
+
+					const SimplexVertex oVertex = GetMinkowskiVertex( _oShapeA, _oShapeB, -vClosest, _bCore );
+					const float fProjection = VectorDot( oVertex.m_vPoint, vClosest );
+
+					//Every point of the difference projects further than the new support point on the current direction, so its projection bounds the distance.
+					if( fProjection > _fSeparationBound * fDistance )
+						return fProjection / fDistance;
+
+					if( fDistanceSq - fProjection <= GJKTolerance * fDistanceSq )
+						break;
+
+					bool bDuplicate = false;
+
+					for( int iVertex = 0 ; iVertex < _oSimplex.m_iCount ; ++iVertex )
+						bDuplicate |= _oSimplex.m_oVertices[ iVertex ].m_vPoint == oVertex.m_vPoint;
+
+					if( bDuplicate )
+						break;
+
+					_oSimplex.m_oVertices[ _oSimplex.m_iCount++ ] = oVertex;
+				}
+
+				_vPointA = sf::Vector2f( 0.f, 0.f );
+				_vPointB = sf::Vector2f( 0.f, 0.f );
+
+				for( int iVertex = 0 ; iVertex < _oSimplex.m_iCount ; ++iVertex )
+				{
+					_vPointA += _oSimplex.m_oVertices[ iVertex ].m_vPointA * _oSimplex.m_oVertices[ iVertex ].m_fWeight;
+					_vPointB += _oSimplex.m_oVertices[ iVertex ].m_vPointB * _oSimplex.m_oVertices[ iVertex ].m_fWeight;
+				}
+
+				return fDistance;
+			}
+
+			//Expands the polytope of the Minkowski difference from the GJK simplex until its closest edge to the origin is on the boundary.
+			void RunEPA( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB, const Simplex& _oSimplex, ConvexContact& _oContact )
+			{
+				SimplexVertex oPolytope[ MaxEPAVertices ];
+				int iCount = 0;
+
+				for( int iVertex = 0 ; iVertex < _oSimplex.m_iCount ; ++iVertex )
+					oPolytope[ iCount++ ] = _oSimplex.m_oVertices[ iVertex ];
+
+				//The origin can be on a point or an edge of the simplex when the shapes touch, the polytope is completed to get an area.
+				const sf::Vector2f pDirections[ 4 ] = { { 1.f, 0.f }, { -1.f, 0.f }, { 0.f, 1.f }, { 0.f, -1.f } };
+
+				if( iCount == 2 )
+				{
+					const sf::Vector2f vEdge = oPolytope[ 1 ].m_vPoint - oPolytope[ 0 ].m_vPoint;
+					oPolytope[ iCount++ ] = GetMinkowskiVertex( _oShapeA, _oShapeB, sf::Vector2f( -vEdge.y, vEdge.x ), false );
+
+					if( std::fabs( Cross( vEdge, oPolytope[ 2 ].m_vPoint - oPolytope[ 0 ].m_vPoint ) ) <= FLT_EPSILON )
+						oPolytope[ 2 ] = GetMinkowskiVertex( _oShapeA, _oShapeB, sf::Vector2f( vEdge.y, -vEdge.x ), false );
+				}
+
+				for( int iDirection = 0 ; iDirection < 4 && iCount < 3 ; ++iDirection )
+				{
+					const SimplexVertex oVertex = GetMinkowskiVertex( _oShapeA, _oShapeB, pDirections[ iDirection ], false );
+
+					if( oVertex.m_vPoint == oPolytope[ 0 ].m_vPoint || ( iCount == 2 && std::fabs( Cross( oPolytope[ 1 ].m_vPoint - oPolytope[ 0 ].m_vPoint, oVertex.m_vPoint - oPolytope[ 0 ].m_vPoint ) ) <= FLT_EPSILON ) )
+						continue;
+
+					oPolytope[ iCount++ ] = oVertex;
+				}
+
+				if( iCount < 3 || std::fabs( Cross( oPolytope[ 1 ].m_vPoint - oPolytope[ 0 ].m_vPoint, oPolytope[ 2 ].m_vPoint - oPolytope[ 0 ].m_vPoint ) ) <= FLT_EPSILON )
+				{
+					//Flat shapes: no area to find a penetration direction in.
+					_oContact.m_vPointA = oPolytope[ 0 ].m_vPointA;
+					_oContact.m_vPointB = oPolytope[ 0 ].m_vPointB;
+					return;
+				}
+
+				if( Cross( oPolytope[ 1 ].m_vPoint - oPolytope[ 0 ].m_vPoint, oPolytope[ 2 ].m_vPoint - oPolytope[ 0 ].m_vPoint ) < 0.f )
+					std::swap( oPolytope[ 1 ], oPolytope[ 2 ] );
+
+				int iClosestEdge = 0;
+				sf::Vector2f vNormal( 0.f, 0.f );
+				float fDistance = 0.f;
+
+				while( true )
+				{
+					fDistance = FLT_MAX;
+
+					for( int iEdge = 0 ; iEdge < iCount ; ++iEdge )
+					{
+						const sf::Vector2f vEdge = oPolytope[ ( iEdge + 1 ) % iCount ].m_vPoint - oPolytope[ iEdge ].m_vPoint;
+						const float fEdgeLength = VectorLength( vEdge );
+
+						if( fEdgeLength <= FLT_EPSILON )
+							continue;
+
+						//Outward normal of a counterclockwise polygon.
+						const sf::Vector2f vEdgeNormal( vEdge.y / fEdgeLength, -vEdge.x / fEdgeLength );
+						const float fEdgeDistance = VectorDot( vEdgeNormal, oPolytope[ iEdge ].m_vPoint );
+
+						if( fEdgeDistance < fDistance )
+						{
+							fDistance = fEdgeDistance;
+							vNormal = vEdgeNormal;
+							iClosestEdge = iEdge;
+						}
+					}
+
+					const SimplexVertex oVertex = GetMinkowskiVertex( _oShapeA, _oShapeB, vNormal, false );
+
+					if( VectorDot( oVertex.m_vPoint, vNormal ) - fDistance <= EPATolerance * Max( 1.f, fDistance ) || iCount == MaxEPAVertices )
+						break;
+
+					for( int iVertex = iCount ; iVertex > iClosestEdge + 1 ; --iVertex )
+						oPolytope[ iVertex ] = oPolytope[ iVertex - 1 ];
+
+					oPolytope[ iClosestEdge + 1 ] = oVertex;
+					++iCount;
+				}
+
+				//The deepest points come from the projection of the origin on the closest edge.
+				const SimplexVertex& oStart = oPolytope[ iClosestEdge ];
+				const SimplexVertex& oEnd = oPolytope[ ( iClosestEdge + 1 ) % iCount ];
+				const sf::Vector2f vEdge = oEnd.m_vPoint - oStart.m_vPoint;
+				const float fRatio = Clamp( -VectorDot( oStart.m_vPoint, vEdge ) / Max( VectorLengthSq( vEdge ), FLT_EPSILON ), 0.f, 1.f );
+
+				_oContact.m_fPenetration = Max( fDistance, 0.f );
+				_oContact.m_vNormal = vNormal;
+				_oContact.m_vPointA = oStart.m_vPointA + ( oEnd.m_vPointA - oStart.m_vPointA ) * fRatio;
+				_oContact.m_vPointB = oStart.m_vPointB + ( oEnd.m_vPointB - oStart.m_vPointB ) * fRatio;
+			}
+		}
+
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Intersection test between two convex shapes, stopping as soon as a separating direction is found
+		//Parameters : Concerned shapes
+		//Return value : The two shapes overlap or touch (true) or not, false if one of them is invalid
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool GJKIntersect( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB )
+		{
+			if( _oShapeA.IsValid() == false || _oShapeB.IsValid() == false )
+				return false;
+
+			Simplex oSimplex;
+			sf::Vector2f vPointA, vPointB;
+			const float fRadii = _oShapeA.GetRadius() + _oShapeB.GetRadius();
+
+			return RunGJK( _oShapeA, _oShapeB, true, fRadii, oSimplex, vPointA, vPointB ) <= fRadii;
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Distance between two convex shapes, stopping at the overlap without measuring the penetration (see GJKCollide)
+		//Parameter 1 & 2 : Concerned shapes
+		//Parameter 3 & 4 : Closest point of each shape (optional), points inside the overlap when they overlap
+		//Return value : Distance between the shapes, 0 if they overlap, FLT_MAX if one of them is invalid
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		float GJKDistance( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB, sf::Vector2f* _pPointA /*= nullptr*/, sf::Vector2f* _pPointB /*= nullptr*/ )
+		{
+			if( _oShapeA.IsValid() == false || _oShapeB.IsValid() == false )
+				return FLT_MAX;
+
+			Simplex oSimplex;
+			sf::Vector2f vPointA, vPointB;
+
+			const float fRadiusA = _oShapeA.GetRadius();
+			const float fRadiusB = _oShapeB.GetRadius();
+			const float fCoreDistance = RunGJK( _oShapeA, _oShapeB, true, FLT_MAX, oSimplex, vPointA, vPointB );
+
+			//Overlapping cores give a common point, otherwise the radii move the closest points of the cores towards each other.
+			if( fCoreDistance > 0.f )
+			{
+				const sf::Vector2f vNormal = ( vPointB - vPointA ) / fCoreDistance;
+				vPointA += vNormal * fRadiusA;
+				vPointB -= vNormal * fRadiusB;
+			}
+
+			if( _pPointA != nullptr )
+				*_pPointA = vPointA;
+
+			if( _pPointB != nullptr )
+				*_pPointB = vPointB;
+
+			return Max( fCoreDistance - fRadiusA - fRadiusB, 0.f );
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Full query between two convex shapes: distance when apart, penetration (EPA) when overlapping
+		//Parameters : Concerned shapes
+		//Return value : Contact information, not colliding at a FLT_MAX distance if one of them is invalid
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		ConvexContact GJKCollide( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB )
+		{
+			ConvexContact oContact;
+
+			if( _oShapeA.IsValid() == false || _oShapeB.IsValid() == false )
+			{
+				oContact.m_fDistance = FLT_MAX;
+				return oContact;
+			}
+
+			Simplex oSimplex;
+			sf::Vector2f vCoreA, vCoreB;
+
+			const float fRadiusA = _oShapeA.GetRadius();
+			const float fRadiusB = _oShapeB.GetRadius();
+			const float fCoreDistance = RunGJK( _oShapeA, _oShapeB, true, FLT_MAX, oSimplex, vCoreA, vCoreB );
+
+			if( fCoreDistance > 0.f )
+			{
+				//The cores are apart, the radii give the contact on the line between their closest points.
+				oContact.m_vNormal = ( vCoreB - vCoreA ) / fCoreDistance;
+				oContact.m_vPointA = vCoreA + oContact.m_vNormal * fRadiusA;
+				oContact.m_vPointB = vCoreB - oContact.m_vNormal * fRadiusB;
+				oContact.m_bColliding = fCoreDistance <= fRadiusA + fRadiusB;
+
+				if( oContact.m_bColliding )
+					oContact.m_fPenetration = fRadiusA + fRadiusB - fCoreDistance;
+				else
+					oContact.m_fDistance = fCoreDistance - fRadiusA - fRadiusB;
+
+				return oContact;
+			}
+
+			oContact.m_bColliding = true;
+
+			//The cores overlap: the full shapes are needed to measure how deep.
+			if( fRadiusA > 0.f || fRadiusB > 0.f )
+				RunGJK( _oShapeA, _oShapeB, false, FLT_MAX, oSimplex, vCoreA, vCoreB );
+
+			RunEPA( _oShapeA, _oShapeB, oSimplex, oContact );
+
+			return oContact;
+		}
+	} //namespace Math
+} //namespace fzn
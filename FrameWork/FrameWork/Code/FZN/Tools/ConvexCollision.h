@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Collision queries between convex shapes (GJK and EPA)
+//------------------------------------------------------------------------
+
+#ifndef _CONVEXCOLLISION_H_
+#define _CONVEXCOLLISION_H_
+
+#include <cstdint>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "FZN/Defines.h"
+
+
+namespace sf
+{
+	class Shape;
+}
+
+namespace fzn
+{
+	//Convex shape only known through its support function: a core (point, segment, box or polygon) inflated by a radius.
+	//The round shapes keep their core separated from the radius so the queries stay exact on them instead of approximating a curve.
+	//The polygon points and the sf::Shape aren't copied, they have to stay alive as long as the collider is used.
+	class FZN_EXPORT ConvexCollider
+	{
+	public:
+		enum class Type : uint8_t
+		{
+			Polygon,
+			Circle,
+			Capsule,
+			OBB,
+			Shape,
+		};
+
+		/////////////////CONSTRUCTION/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Convex polygon given in world coordinates
+		//Parameter 1 : Points of the polygon (any order, the ones inside the hull are ignored)
+		//Parameter 2 : Number of points
+		//Parameter 3 : Radius rounding the polygon
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static ConvexCollider Polygon( const sf::Vector2f* _pPoints, int _iPointsNumber, float _fRadius = 0.f );
+		static ConvexCollider Circle( const sf::Vector2f& _vCenter, float _fRadius );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Segment inflated by a radius
+		//Parameter 1 & 2 : Ends of the segment
+		//Parameter 3 : Radius
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static ConvexCollider Capsule( const sf::Vector2f& _vPointA, const sf::Vector2f& _vPointB, float _fRadius );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Oriented box
+		//Parameter 1 : Center of the box
+		//Parameter 2 : Half of its size on its own axes
+		//Parameter 3 : Rotation (radians)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static ConvexCollider OBB( const sf::Vector2f& _vCenter, const sf::Vector2f& _vHalfExtents, float _fAngle );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//SFML shape with its transform, its points are read at each query (Math::GetFarthestPointInDirection)
+		//Parameter : Convex shape (a null one gives an invalid collider)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static ConvexCollider FromShape( const sf::Shape* _pShape );
+
+
+		/////////////////SUPPORT FUNCTIONS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the farthest point of the shape in a given direction
+		//Parameter : Direction (doesn't need to be normalized)
+		//Return value : Farthest point, radius included
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		sf::Vector2f GetSupportPoint( const sf::Vector2f& _vDirection ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the farthest point of the core of the shape in a given direction
+		//Parameter : Direction (doesn't need to be normalized)
+		//Return value : Farthest point, radius excluded
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		sf::Vector2f GetCoreSupportPoint( const sf::Vector2f& _vDirection ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on a point inside the shape, used to start the searches
+		//Return value : Center of the core
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		sf::Vector2f GetCenter() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Tells if the collider has something to collide with, the queries ignore the invalid ones
+		//Return value : False for a shape collider without shape or a polygon without points
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool IsValid() const;
+
+		Type GetType() const { return m_eType; }
+		float GetRadius() const { return m_fRadius; }
+
+	private:
+		ConvexCollider( Type _eType );
+
+
+		/////////////////MEMBER VARIABLES/////////////////
+
+		Type				m_eType;
+		sf::Vector2f		m_vPointA;								//Center (circle, box) or first end (capsule)
+		sf::Vector2f		m_vPointB;								//Second end (capsule)
+		sf::Vector2f		m_vAxisX;								//Axes of the box, scaled by its half size
+		sf::Vector2f		m_vAxisY;
+		const sf::Vector2f*	m_pPoints{ nullptr };
+		int					m_iPointsNumber{ 0 };
+		const sf::Shape*	m_pShape{ nullptr };
+		float				m_fRadius{ 0.f };
+	};
+
+	struct ConvexContact
+	{
+		bool				m_bColliding{ false };
+		float				m_fDistance{ 0.f };						//Gap between the shapes when they don't collide
+		float				m_fPenetration{ 0.f };					//Depth of the overlap when they collide
+		sf::Vector2f		m_vNormal{ 0.f, 0.f };					//From A to B: moving B by m_vNormal * m_fPenetration separates the shapes
+		sf::Vector2f		m_vPointA{ 0.f, 0.f };					//Closest points when apart, deepest points when overlapping
+		sf::Vector2f		m_vPointB{ 0.f, 0.f };
+	};
+
+	namespace Math
+	{
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Intersection test between two convex shapes, stopping as soon as a separating direction is found
+		//Parameters : Concerned shapes
+		//Return value : The two shapes overlap or touch (true) or not, false if one of them is invalid
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT bool GJKIntersect( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Distance between two convex shapes, stopping at the overlap without measuring the penetration (see GJKCollide)
+		//Parameter 1 & 2 : Concerned shapes
+		//Parameter 3 & 4 : Closest point of each shape (optional), points inside the overlap when they overlap
+		//Return value : Distance between the shapes, 0 if they overlap, FLT_MAX if one of them is invalid
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT float GJKDistance( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB, sf::Vector2f* _pPointA = nullptr, sf::Vector2f* _pPointB = nullptr );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Full query between two convex shapes: distance when apart, penetration (EPA) when overlapping
+		//Parameters : Concerned shapes
+		//Return value : Contact information, not colliding at a FLT_MAX distance if one of them is invalid
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT ConvexContact GJKCollide( const ConvexCollider& _oShapeA, const ConvexCollider& _oShapeB );
+	} //namespace Math
+} //namespace fzn
+
+#endif //_CONVEXCOLLISION_H_
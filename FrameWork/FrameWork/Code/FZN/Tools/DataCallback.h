@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 
 
@@ -13,50 +16,50 @@ namespace fzn
 		COUNT,
 	};
 
-	class DataCallbackBase
+	//Identifies a registered callback so it can be removed without searching for it
+	struct DataCallbackHandle
 	{
-	public:
-		virtual void Call() = 0;
+		bool IsValid() const { return m_uSlot != UINT32_MAX; }
 
-		int m_iPriority{ 0 };
+		uint32_t m_uSlot{ UINT32_MAX };
+		uint32_t m_uGeneration{ 0 };
 	};
 
-	typedef std::vector<DataCallbackBase*> DataCallBacksVector;
-	
 	template< typename T>
-	class DataCallback : public DataCallbackBase
+	class DataCallback
 	{
 	public:
 		typedef void ( T::* CallbackFct )();
 
-		DataCallback( T* _pObject, CallbackFct _pCallback, int _iPriority = 0 ) :
-			m_pObject( _pObject ),
-			m_pCallback( _pCallback )
+		static void Invoke( void* _pObject, const void* _pFct )
 		{
-			m_iPriority = _iPriority;
-		}
+			CallbackFct pCallback;
+			memcpy( &pCallback, _pFct, sizeof( CallbackFct ) );
 
-		virtual void Call() override
-		{
-			( m_pObject->*m_pCallback )();
+			( static_cast< T* >( _pObject )->*pCallback )();
 		}
-
-		T*				m_pObject{ nullptr };
-		CallbackFct		m_pCallback{ nullptr };
 	};
 
+	//The callbacks are stored by value, sorted by priority, so calling them doesn't require any allocation or indirection other than the call itself.
+	//Callbacks removed or added while the callbacks of their type are being called are only removed or added once all of them have been called.
 	class DataCallbacksHolder
 	{
 	public:
 		template< typename CallbackType >
-		void AddCallback( CallbackType* _pObject, typename DataCallback<CallbackType>::CallbackFct _pFct, DataCallbackType _eCallbackType, int _iPriority = 0 )
+		DataCallbackHandle AddCallback( CallbackType* _pObject, typename DataCallback<CallbackType>::CallbackFct _pFct, DataCallbackType _eCallbackType, int _iPriority = 0 )
 		{
+			static_assert( sizeof( typename DataCallback<CallbackType>::CallbackFct ) <= MaxFctSize, "Member function pointer too big to be stored in a callback." );
+
 			if( _pObject == nullptr || _pFct  == nullptr || _eCallbackType >= DataCallbackType::COUNT )
-				return;
+				return {};
 
-			m_daCallbacks[ (int)_eCallbackType ].push_back( new DataCallback<CallbackType>( _pObject, _pFct, _iPriority ) );
+			Delegate oDelegate;
+			oDelegate.m_pObject = _pObject;
+			oDelegate.m_pInvoker = &DataCallback<CallbackType>::Invoke;
+			memcpy( oDelegate.m_oFct, &_pFct, sizeof( _pFct ) );
+			oDelegate.m_iPriority = _iPriority;
 
-			std::sort( m_daCallbacks[ (int)_eCallbackType ].begin(), m_daCallbacks[ (int)_eCallbackType ].end(), DataCallbackSorter );
+			return _AddDelegate( oDelegate, _eCallbackType );
 		}
 
 		template< typename CallbackType >
@@ -65,39 +68,203 @@ namespace fzn
 			if( _pObject == nullptr || _pFct == nullptr || _eCallbackType >= DataCallbackType::COUNT )
 				return;
 
-			for( int iCallback = 0; iCallback < m_daCallbacks[ (int)_eCallbackType ].size(); ++iCallback )
+			unsigned char oFct[ MaxFctSize ]{};
+			memcpy( oFct, &_pFct, sizeof( _pFct ) );
+
+			auto IsSearchedCallback = [&]( const Delegate& _oDelegate )
+			{
+				return _oDelegate.m_pObject == _pObject && _oDelegate.m_pInvoker == &DataCallback<CallbackType>::Invoke && memcmp( _oDelegate.m_oFct, oFct, MaxFctSize ) == 0;
+			};
+
+			const int iType = (int)_eCallbackType;
+
+			for( Delegate& oDelegate : m_oCallbacks[ iType ] )
 			{
-				if( DataCallback<CallbackType>* pCallback = dynamic_cast< DataCallback<CallbackType>* >( m_daCallbacks[ (int)_eCallbackType ][ iCallback ] ) )
+				if( IsSearchedCallback( oDelegate ) )
 				{
-					if( pCallback->m_pObject == _pObject && pCallback->m_pCallback == _pFct )
-					{
-						delete m_daCallbacks[ (int)_eCallbackType ][ iCallback ];
-						m_daCallbacks[ (int)_eCallbackType ].erase( m_daCallbacks[ (int)_eCallbackType ].begin() + iCallback );
-						return;
-					}
+					_KillDelegate( oDelegate, iType );
+					return;
+				}
+			}
+
+			for( Delegate& oDelegate : m_oPendingCallbacks[ iType ] )
+			{
+				if( IsSearchedCallback( oDelegate ) )
+				{
+					_KillDelegate( oDelegate, iType );
+					return;
 				}
 			}
 		}
 
-		void ExecuteCallbacks( DataCallbackType _eCallbackType )
+		void RemoveCallback( DataCallbackHandle _oHandle )
 		{
-			for( DataCallbackBase* pCallback : m_daCallbacks[ (int)_eCallbackType ] )
-				pCallback->Call();
+			if( _oHandle.m_uSlot >= m_oSlots.size() )
+				return;
+
+			const Slot& oSlot = m_oSlots[ _oHandle.m_uSlot ];
+
+			if( oSlot.m_bUsed == false || oSlot.m_uGeneration != _oHandle.m_uGeneration )
+				return;
+
+			const int iType = (int)oSlot.m_eType;
+			std::vector< Delegate >& oDelegates = oSlot.m_bPending ? m_oPendingCallbacks[ iType ] : m_oCallbacks[ iType ];
+
+			_KillDelegate( oDelegates[ oSlot.m_uIndex ], iType );
 		}
 
-		static bool DataCallbackSorter( const DataCallbackBase* _pCallbackA, const DataCallbackBase* _pCallbackB )
+		void ExecuteCallbacks( DataCallbackType _eCallbackType )
 		{
-			if( _pCallbackA == nullptr )
-				return false;
+			const int iType = (int)_eCallbackType;
+			const std::vector< Delegate >& oDelegates = m_oCallbacks[ iType ];
+
+			//Nothing can be inserted in the vector until the end of the loop, only the size is read again in case of a nested call.
+			++m_iDispatchDepth[ iType ];
+
+			for( size_t iCallback = 0; iCallback < oDelegates.size(); ++iCallback )
+			{
+				const Delegate& oDelegate = oDelegates[ iCallback ];
 
-			if( _pCallbackB == nullptr )
-				return true;
+				if( oDelegate.m_pObject != nullptr )
+					oDelegate.m_pInvoker( oDelegate.m_pObject, oDelegate.m_oFct );
+			}
 
-			return _pCallbackA->m_iPriority < _pCallbackB->m_iPriority;
+			if( --m_iDispatchDepth[ iType ] == 0 )
+				_Flush( iType );
 		}
 
 	protected:
-		DataCallBacksVector m_daCallbacks[ (int)DataCallbackType::COUNT ];
+		//Biggest member function pointer: MSVC, unknown inheritance (code pointer followed by three int offsets, 16 bytes on x86 and 20 on x64), rounded up to the pointer alignment.
+		static constexpr size_t MaxFctSize{ ( sizeof( void* ) + 3 * sizeof( int ) + sizeof( void* ) - 1 ) / sizeof( void* ) * sizeof( void* ) };
+
+		typedef void ( *InvokerFct )( void*, const void* );
+
+		struct Delegate
+		{
+			void*			m_pObject{ nullptr };		//nullptr once removed
+			InvokerFct		m_pInvoker{ nullptr };
+			alignas( void* ) unsigned char m_oFct[ MaxFctSize ]{};
+			int				m_iPriority{ 0 };
+			uint32_t		m_uSlot{ UINT32_MAX };
+		};
+
+		struct Slot
+		{
+			uint32_t			m_uGeneration{ 0 };
+			uint32_t			m_uIndex{ 0 };			//Index of the callback in its vector
+			DataCallbackType	m_eType{ DataCallbackType::COUNT };
+			bool				m_bPending{ false };	//Added during the execution of the callbacks, the callback is in m_oPendingCallbacks
+			bool				m_bUsed{ false };
+		};
+
+		DataCallbackHandle _AddDelegate( Delegate& _oDelegate, DataCallbackType _eCallbackType )
+		{
+			const int iType = (int)_eCallbackType;
+			DataCallbackHandle oHandle;
+
+			if( m_oFreeSlots.empty() )
+			{
+				oHandle.m_uSlot = (uint32_t)m_oSlots.size();
+				m_oSlots.emplace_back();
+			}
+			else
+			{
+				oHandle.m_uSlot = m_oFreeSlots.back();
+				m_oFreeSlots.pop_back();
+			}
+
+			Slot& oSlot = m_oSlots[ oHandle.m_uSlot ];
+			oSlot.m_eType = _eCallbackType;
+			oSlot.m_bUsed = true;
+			oHandle.m_uGeneration = oSlot.m_uGeneration;
+			_oDelegate.m_uSlot = oHandle.m_uSlot;
+
+			if( m_iDispatchDepth[ iType ] > 0 )
+			{
+				oSlot.m_bPending = true;
+				oSlot.m_uIndex = (uint32_t)m_oPendingCallbacks[ iType ].size();
+				m_oPendingCallbacks[ iType ].push_back( _oDelegate );
+			}
+			else
+				_InsertDelegate( _oDelegate, iType );
+
+			return oHandle;
+		}
+
+		//Inserted after the callbacks of the same priority, so they are called in the order they have been added.
+		void _InsertDelegate( const Delegate& _oDelegate, int _iType )
+		{
+			std::vector< Delegate >& oDelegates = m_oCallbacks[ _iType ];
+			const auto itInsert = std::upper_bound( oDelegates.begin(), oDelegates.end(), _oDelegate.m_iPriority, []( int _iPriority, const Delegate& _oOther ) { return _iPriority < _oOther.m_iPriority; } );
+			const size_t iInsert = itInsert - oDelegates.begin();
+
+			oDelegates.insert( itInsert, _oDelegate );
+			_UpdateSlots( _iType, iInsert );
+		}
+
+		void _KillDelegate( Delegate& _oDelegate, int _iType )
+		{
+			if( _oDelegate.m_pObject == nullptr )
+				return;
+
+			Slot& oSlot = m_oSlots[ _oDelegate.m_uSlot ];
+			oSlot.m_bUsed = false;
+			++oSlot.m_uGeneration;
+			m_oFreeSlots.push_back( _oDelegate.m_uSlot );
+
+			_oDelegate.m_pObject = nullptr;
+			_oDelegate.m_uSlot = UINT32_MAX;
+			m_bHasDeadCallbacks[ _iType ] = true;
+		}
+
+		//Removes the dead callbacks and inserts the ones added during the execution
+		void _Flush( int _iType )
+		{
+			std::vector< Delegate >& oDelegates = m_oCallbacks[ _iType ];
+
+			if( m_bHasDeadCallbacks[ _iType ] )
+			{
+				const auto itFirstDead = std::find_if( oDelegates.begin(), oDelegates.end(), []( const Delegate& _oDelegate ) { return _oDelegate.m_pObject == nullptr; } );
+				const size_t iFirstMoved = itFirstDead - oDelegates.begin();
+
+				oDelegates.erase( std::remove_if( itFirstDead, oDelegates.end(), []( const Delegate& _oDelegate ) { return _oDelegate.m_pObject == nullptr; } ), oDelegates.end() );
+				_UpdateSlots( _iType, iFirstMoved );
+
+				m_bHasDeadCallbacks[ _iType ] = false;
+			}
+
+			if( m_oPendingCallbacks[ _iType ].empty() == false )
+			{
+				for( const Delegate& oDelegate : m_oPendingCallbacks[ _iType ] )
+				{
+					if( oDelegate.m_pObject == nullptr )
+						continue;
+
+					m_oSlots[ oDelegate.m_uSlot ].m_bPending = false;
+					_InsertDelegate( oDelegate, _iType );
+				}
+
+				m_oPendingCallbacks[ _iType ].clear();
+			}
+		}
+
+		void _UpdateSlots( int _iType, size_t _iFirstCallback )
+		{
+			std::vector< Delegate >& oDelegates = m_oCallbacks[ _iType ];
+
+			for( size_t iCallback = _iFirstCallback; iCallback < oDelegates.size(); ++iCallback )
+			{
+				if( oDelegates[ iCallback ].m_uSlot != UINT32_MAX )
+					m_oSlots[ oDelegates[ iCallback ].m_uSlot ].m_uIndex = (uint32_t)iCallback;
+			}
+		}
+
+		std::vector< Delegate >		m_oCallbacks[ (int)DataCallbackType::COUNT ];
+		std::vector< Delegate >		m_oPendingCallbacks[ (int)DataCallbackType::COUNT ];	//Added during the execution of their type
+		std::vector< Slot >			m_oSlots;
+		std::vector< uint32_t >		m_oFreeSlots;
+		int							m_iDispatchDepth[ (int)DataCallbackType::COUNT ]{};
+		bool						m_bHasDeadCallbacks[ (int)DataCallbackType::COUNT ]{};
 	};
 
-} //fzn
\ No newline at end of file
+} //fzn
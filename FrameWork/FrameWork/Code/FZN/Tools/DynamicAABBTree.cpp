@@ -0,0 +1,381 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Bounding volume hierarchy of axis aligned boxes that can move
+//------------------------------------------------------------------------
+
+#include "FZN/Includes.h"
+#include "FZN/Tools/DynamicAABBTree.h"
+
+
+namespace fzn
+{
+	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Default parametered constructor
+	//Parameter : Margin added on each side of the boxes
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	DynamicAABBTree::DynamicAABBTree( float _fMargin /*= 4.f*/ )
+	: m_fMargin( _fMargin )
+	{
+	}
+
+
+	/////////////////PROXIES/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Adds a box in the tree
+	//Parameter 1 : Box
+	//Parameter 2 : Value given back by the queries
+	//Return value : Proxy identifying the box
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int DynamicAABBTree::CreateProxy( const sf::FloatRect& _oAABB, int _iUserData )
+	{
+		const int iProxy = _AllocateNode();
+		const sf::Vector2f vMargin( m_fMargin, m_fMargin );
+		const AABB oAABB = _ToAABB( _oAABB );
+
+		Node& oNode = m_oNodes[ iProxy ];
+		oNode.m_oAABB.m_vMin = oAABB.m_vMin - vMargin;
+		oNode.m_oAABB.m_vMax = oAABB.m_vMax + vMargin;
+		oNode.m_iUserData = _iUserData;
+		oNode.m_iHeight = 0;
+
+		_InsertLeaf( iProxy );
+		++m_iProxiesNumber;
+
+		return iProxy;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Removes a box from the tree
+	//Parameter : Proxy given by CreateProxy
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void DynamicAABBTree::DestroyProxy( int _iProxy )
+	{
+		if( _iProxy < 0 || _iProxy >= (int)m_oNodes.size() || m_oNodes[ _iProxy ].m_iHeight != 0 )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Invalid proxy %d.", _iProxy );
+			return;
+		}
+
+		_RemoveLeaf( _iProxy );
+		_FreeNode( _iProxy );
+		--m_iProxiesNumber;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Moves a box, the tree is only modified if it left its fat box
+	//Parameter 1 : Proxy given by CreateProxy
+	//Parameter 2 : New box
+	//Parameter 3 : Move since the last call, to extend the fat box where the box is going
+	//Return value : The proxy has been inserted again (true) or its fat box still contains it
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool DynamicAABBTree::MoveProxy( int _iProxy, const sf::FloatRect& _oAABB, const sf::Vector2f& _vDisplacement )
+	{
+		if( _iProxy < 0 || _iProxy >= (int)m_oNodes.size() || m_oNodes[ _iProxy ].m_iHeight != 0 )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Invalid proxy %d.", _iProxy );
+			return false;
+		}
+
+		const AABB oAABB = _ToAABB( _oAABB );
+		const sf::Vector2f vMargin( m_fMargin, m_fMargin );
+		const sf::Vector2f vDisplacement = _vDisplacement * DisplacementMultiplier;
+
+		AABB oFatAABB = { oAABB.m_vMin - vMargin, oAABB.m_vMax + vMargin };
+
+		if( vDisplacement.x < 0.f )
+			oFatAABB.m_vMin.x += vDisplacement.x;
+		else
+			oFatAABB.m_vMax.x += vDisplacement.x;
+
+		if( vDisplacement.y < 0.f )
+			oFatAABB.m_vMin.y += vDisplacement.y;
+		else
+			oFatAABB.m_vMax.y += vDisplacement.y;
+
+		const AABB& oTreeAABB = m_oNodes[ _iProxy ].m_oAABB;
+
+		if( oTreeAABB.Contains( oAABB ) )
+		{
+			//A fat box left much bigger by a fast move that stopped would give many useless pairs, it is shrunk back.
+			const AABB oHugeAABB = { oFatAABB.m_vMin - vMargin * 4.f, oFatAABB.m_vMax + vMargin * 4.f };
+
+			if( oHugeAABB.Contains( oTreeAABB ) )
+				return false;
+		}
+
+		_RemoveLeaf( _iProxy );
+		m_oNodes[ _iProxy ].m_oAABB = oFatAABB;
+		_InsertLeaf( _iProxy );
+
+		return true;
+	}
+
+	int DynamicAABBTree::GetUserData( int _iProxy ) const
+	{
+		if( _iProxy < 0 || _iProxy >= (int)m_oNodes.size() )
+			return -1;
+
+		return m_oNodes[ _iProxy ].m_iUserData;
+	}
+
+	sf::FloatRect DynamicAABBTree::GetFatAABB( int _iProxy ) const
+	{
+		if( _iProxy < 0 || _iProxy >= (int)m_oNodes.size() )
+			return sf::FloatRect();
+
+		const AABB& oAABB = m_oNodes[ _iProxy ].m_oAABB;
+
+		return sf::FloatRect( oAABB.m_vMin, oAABB.m_vMax - oAABB.m_vMin );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on the height of the tree
+	//Return value : Number of levels under the root (0 when it is empty or has only one proxy)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int DynamicAABBTree::GetHeight() const
+	{
+		if( m_iRoot == NullNode )
+			return 0;
+
+		return m_oNodes[ m_iRoot ].m_iHeight;
+	}
+
+
+	/////////////////PRIVATE FUNCTIONS/////////////////
+
+	DynamicAABBTree::AABB DynamicAABBTree::_ToAABB( const sf::FloatRect& _oRect )
+	{
+		return { { _oRect.left, _oRect.top }, { _oRect.left + _oRect.width, _oRect.top + _oRect.height } };
+	}
+
+	int DynamicAABBTree::_AllocateNode()
+	{
+		if( m_iFreeList == NullNode )
+		{
+			m_oNodes.emplace_back();
+			return (int)m_oNodes.size() - 1;
+		}
+
+		const int iNode = m_iFreeList;
+		m_iFreeList = m_oNodes[ iNode ].m_iParent;
+		m_oNodes[ iNode ] = Node();
+
+		return iNode;
+	}
+
+	void DynamicAABBTree::_FreeNode( int _iNode )
+	{
+		m_oNodes[ _iNode ].m_iParent = m_iFreeList;
+		m_oNodes[ _iNode ].m_iHeight = -1;
+		m_iFreeList = _iNode;
+	}
+
+	void DynamicAABBTree::_InsertLeaf( int _iLeaf )
+	{
+		if( m_iRoot == NullNode )
+		{
+			m_iRoot = _iLeaf;
+			m_oNodes[ m_iRoot ].m_iParent = NullNode;
+			return;
+		}
+
+		//Looks for the best sibling, the one whose merge with the leaf makes the smallest increase of the sum of the perimeters of the tree.
+		const AABB oLeafAABB = m_oNodes[ _iLeaf ].m_oAABB;
+		int iIndex = m_iRoot;
+
+		while( m_oNodes[ iIndex ].IsLeaf() == false )
+		{
+			const Node& oNode = m_oNodes[ iIndex ];
+			const float fPerimeter = oNode.m_oAABB.GetPerimeter();
+			const float fCombinedPerimeter = AABB::Merge( oNode.m_oAABB, oLeafAABB ).GetPerimeter();
+
+			//Cost of making a new parent for this node and the leaf.
+			const float fCost = 2.f * fCombinedPerimeter;
+
+			//Minimum cost of pushing the leaf further down the tree, every ancestor grows by the same amount.
+			const float fInheritanceCost = 2.f * ( fCombinedPerimeter - fPerimeter );
+
+			auto GetDescentCost = [&]( int _iChild )
+			{
+				const Node& oChild = m_oNodes[ _iChild ];
+				const float fMergedPerimeter = AABB::Merge( oLeafAABB, oChild.m_oAABB ).GetPerimeter();
+
+				if( oChild.IsLeaf() )
+					return fMergedPerimeter + fInheritanceCost;
+
+				return fMergedPerimeter - oChild.m_oAABB.GetPerimeter() + fInheritanceCost;
+			};
+
+			const float fCost1 = GetDescentCost( oNode.m_iChild1 );
+			const float fCost2 = GetDescentCost( oNode.m_iChild2 );
+
+			if( fCost < fCost1 && fCost < fCost2 )
+				break;
+
+			iIndex = fCost1 < fCost2 ? oNode.m_iChild1 : oNode.m_iChild2;
+		}
+
+		const int iSibling = iIndex;
+
+		//The allocation can move the nodes, no reference is kept across it.
+		const int iNewParent = _AllocateNode();
+		const int iOldParent = m_oNodes[ iSibling ].m_iParent;
+
+		Node& oNewParent = m_oNodes[ iNewParent ];
+		oNewParent.m_iParent = iOldParent;
+		oNewParent.m_oAABB = AABB::Merge( oLeafAABB, m_oNodes[ iSibling ].m_oAABB );
+		oNewParent.m_iHeight = m_oNodes[ iSibling ].m_iHeight + 1;
+		oNewParent.m_iChild1 = iSibling;
+		oNewParent.m_iChild2 = _iLeaf;
+
+		if( iOldParent != NullNode )
+		{
+			if( m_oNodes[ iOldParent ].m_iChild1 == iSibling )
+				m_oNodes[ iOldParent ].m_iChild1 = iNewParent;
+			else
+				m_oNodes[ iOldParent ].m_iChild2 = iNewParent;
+		}
+		else
+			m_iRoot = iNewParent;
+
+		m_oNodes[ iSibling ].m_iParent = iNewParent;
+		m_oNodes[ _iLeaf ].m_iParent = iNewParent;
+
+		//Fixes the heights and boxes of the ancestors, balancing them on the way.
+		iIndex = m_oNodes[ _iLeaf ].m_iParent;
+
+		while( iIndex != NullNode )
+		{
+			iIndex = _Balance( iIndex );
+
+			Node& oNode = m_oNodes[ iIndex ];
+			oNode.m_iHeight = 1 + Math::Max( m_oNodes[ oNode.m_iChild1 ].m_iHeight, m_oNodes[ oNode.m_iChild2 ].m_iHeight );
+			oNode.m_oAABB = AABB::Merge( m_oNodes[ oNode.m_iChild1 ].m_oAABB, m_oNodes[ oNode.m_iChild2 ].m_oAABB );
+
+			iIndex = oNode.m_iParent;
+		}
+	}
+
+	void DynamicAABBTree::_RemoveLeaf( int _iLeaf )
+	{
+		if( _iLeaf == m_iRoot )
+		{
+			m_iRoot = NullNode;
+			return;
+		}
+
+		const int iParent = m_oNodes[ _iLeaf ].m_iParent;
+		const int iGrandParent = m_oNodes[ iParent ].m_iParent;
+		const int iSibling = m_oNodes[ iParent ].m_iChild1 == _iLeaf ? m_oNodes[ iParent ].m_iChild2 : m_oNodes[ iParent ].m_iChild1;
+
+		_FreeNode( iParent );
+
+		if( iGrandParent == NullNode )
+		{
+			m_iRoot = iSibling;
+			m_oNodes[ iSibling ].m_iParent = NullNode;
+			return;
+		}
+
+		if( m_oNodes[ iGrandParent ].m_iChild1 == iParent )
+			m_oNodes[ iGrandParent ].m_iChild1 = iSibling;
+		else
+			m_oNodes[ iGrandParent ].m_iChild2 = iSibling;
+
+		m_oNodes[ iSibling ].m_iParent = iGrandParent;
+
+		int iIndex = iGrandParent;
+
+		while( iIndex != NullNode )
+		{
+			iIndex = _Balance( iIndex );
+
+			Node& oNode = m_oNodes[ iIndex ];
+			oNode.m_iHeight = 1 + Math::Max( m_oNodes[ oNode.m_iChild1 ].m_iHeight, m_oNodes[ oNode.m_iChild2 ].m_iHeight );
+			oNode.m_oAABB = AABB::Merge( m_oNodes[ oNode.m_iChild1 ].m_oAABB, m_oNodes[ oNode.m_iChild2 ].m_oAABB );
+
+			iIndex = oNode.m_iParent;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Rotates the tree around a node if its children heights differ by more than one
+	//Parameter : Node to balance
+	//Return value : Node now at the position of the given one
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int DynamicAABBTree::_Balance( int _iNode )
+	{
+		Node& oA = m_oNodes[ _iNode ];
+
+		if( oA.IsLeaf() || oA.m_iHeight < 2 )
+			return _iNode;
+
+		const int iB = oA.m_iChild1;
+		const int iC = oA.m_iChild2;
+		Node& oB = m_oNodes[ iB ];
+		Node& oC = m_oNodes[ iC ];
+
+		const int iBalance = oC.m_iHeight - oB.m_iHeight;
+
+		//Rotates the higher child up, its higher child stays under it and its other child goes under the node.
+		auto Rotate = [&]( int _iUp, Node& _oUp, Node& _oOther, bool _bUpIsChild2 )
+		{
+			const int iF = _oUp.m_iChild1;
+			const int iG = _oUp.m_iChild2;
+			Node& oF = m_oNodes[ iF ];
+			Node& oG = m_oNodes[ iG ];
+
+			_oUp.m_iChild1 = _iNode;
+			_oUp.m_iParent = oA.m_iParent;
+			oA.m_iParent = _iUp;
+
+			if( _oUp.m_iParent != NullNode )
+			{
+				if( m_oNodes[ _oUp.m_iParent ].m_iChild1 == _iNode )
+					m_oNodes[ _oUp.m_iParent ].m_iChild1 = _iUp;
+				else
+					m_oNodes[ _oUp.m_iParent ].m_iChild2 = _iUp;
+			}
+			else
+				m_iRoot = _iUp;
+
+			const bool bKeepF = oF.m_iHeight > oG.m_iHeight;
+			const int iKept = bKeepF ? iF : iG;
+			const int iMoved = bKeepF ? iG : iF;
+			Node& oMoved = m_oNodes[ iMoved ];
+
+			_oUp.m_iChild2 = iKept;
+
+			if( _bUpIsChild2 )
+				oA.m_iChild2 = iMoved;
+			else
+				oA.m_iChild1 = iMoved;
+
+			oMoved.m_iParent = _iNode;
+
+			oA.m_oAABB = AABB::Merge( _oOther.m_oAABB, oMoved.m_oAABB );
+			_oUp.m_oAABB = AABB::Merge( oA.m_oAABB, m_oNodes[ iKept ].m_oAABB );
+
+			oA.m_iHeight = 1 + Math::Max( _oOther.m_iHeight, oMoved.m_iHeight );
+			_oUp.m_iHeight = 1 + Math::Max( oA.m_iHeight, m_oNodes[ iKept ].m_iHeight );
+		};
+
+		if( iBalance > 1 )
+		{
+			Rotate( iC, oC, oB, true );
+			return iC;
+		}
+
+		if( iBalance < -1 )
+		{
+			Rotate( iB, oB, oC, false );
+			return iB;
+		}
+
+		return _iNode;
+	}
+} //namespace fzn
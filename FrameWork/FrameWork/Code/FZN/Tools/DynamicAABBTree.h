@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Bounding volume hierarchy of axis aligned boxes that can move
+//------------------------------------------------------------------------
+
+#ifndef _DYNAMICAABBTREE_H_
+#define _DYNAMICAABBTREE_H_
+
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "FZN/Defines.h"
+#include "FZN/Tools/Math.h"
+
+#pragma warning( push )
+#pragma warning( disable: 4251 )
+
+
+namespace fzn
+{
+	//Each proxy is a leaf holding a box enlarged by a margin (fat box), so small moves don't change the tree at all.
+	//The tree is kept balanced by rotations when inserting, so the queries stay in O(log N) whatever the order of the insertions.
+	//The nodes are stored in one array and refer to each other by index, a removed node is reused by the next insertion.
+	class FZN_EXPORT DynamicAABBTree
+	{
+	public:
+		static constexpr int NullNode{ -1 };
+		static constexpr float DisplacementMultiplier{ 4.f };		//Part of the displacement added to the fat box in the direction of the move
+		static constexpr int QueryStackSize{ 256 };				//Nodes waiting to be visited during a query, far above the height of a balanced tree
+
+		/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Default parametered constructor
+		//Parameter : Margin added on each side of the boxes
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		DynamicAABBTree( float _fMargin = 4.f );
+
+
+		/////////////////PROXIES/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a box in the tree
+		//Parameter 1 : Box
+		//Parameter 2 : Value given back by the queries
+		//Return value : Proxy identifying the box
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int CreateProxy( const sf::FloatRect& _oAABB, int _iUserData );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes a box from the tree
+		//Parameter : Proxy given by CreateProxy
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void DestroyProxy( int _iProxy );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Moves a box, the tree is only modified if it left its fat box
+		//Parameter 1 : Proxy given by CreateProxy
+		//Parameter 2 : New box
+		//Parameter 3 : Move since the last call, to extend the fat box where the box is going
+		//Return value : The proxy has been inserted again (true) or its fat box still contains it
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool MoveProxy( int _iProxy, const sf::FloatRect& _oAABB, const sf::Vector2f& _vDisplacement );
+
+		int GetUserData( int _iProxy ) const;
+		sf::FloatRect GetFatAABB( int _iProxy ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the height of the tree
+		//Return value : Number of levels under the root (0 when it is empty or has only one proxy)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int GetHeight() const;
+		int GetProxiesNumber() const { return m_iProxiesNumber; }
+		float GetMargin() const { return m_fMargin; }
+
+
+		/////////////////QUERIES/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the proxies whose fat box overlaps a given box
+		//Parameter 1 : Box to test
+		//Parameter 2 : Function called with each overlapping proxy, bool( int _iProxy ), returning false stops the query
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		template< typename Callback >
+		void Query( const sf::FloatRect& _oAABB, Callback&& _fnCallback ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the proxies whose fat box contains a point
+		//Parameter 1 : Point to test
+		//Parameter 2 : Function called with each proxy, bool( int _iProxy ), returning false stops the query
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		template< typename Callback >
+		void QueryPoint( const sf::Vector2f& _vPoint, Callback&& _fnCallback ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Looks for the proxies whose fat box is crossed by a segment
+		//Parameter 1 & 2 : Start and end of the segment
+		//Parameter 3 : Function called with each proxy, float( int _iProxy, float _fMaxFraction ).
+		//				It returns the part of the segment to keep testing: 0 stops the query, the distance of a hit keeps only the closer proxies, _fMaxFraction ignores the proxy.
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		template< typename Callback >
+		void RayCast( const sf::Vector2f& _vStart, const sf::Vector2f& _vEnd, Callback&& _fnCallback ) const;
+
+	private:
+		struct AABB
+		{
+			//Defined here as the nested types aren't exported with the class and the queries are instantiated in the user's code.
+			bool Contains( const AABB& _oAABB ) const { return m_vMin.x <= _oAABB.m_vMin.x && m_vMin.y <= _oAABB.m_vMin.y && _oAABB.m_vMax.x <= m_vMax.x && _oAABB.m_vMax.y <= m_vMax.y; }
+			bool Overlaps( const AABB& _oAABB ) const { return m_vMin.x <= _oAABB.m_vMax.x && _oAABB.m_vMin.x <= m_vMax.x && m_vMin.y <= _oAABB.m_vMax.y && _oAABB.m_vMin.y <= m_vMax.y; }
+			float GetPerimeter() const { return 2.f * ( m_vMax.x - m_vMin.x + m_vMax.y - m_vMin.y ); }
+			static AABB Merge( const AABB& _oAABB1, const AABB& _oAABB2 )
+			{
+				return { { Math::Min( _oAABB1.m_vMin.x, _oAABB2.m_vMin.x ), Math::Min( _oAABB1.m_vMin.y, _oAABB2.m_vMin.y ) }, { Math::Max( _oAABB1.m_vMax.x, _oAABB2.m_vMax.x ), Math::Max( _oAABB1.m_vMax.y, _oAABB2.m_vMax.y ) } };
+			}
+
+			sf::Vector2f	m_vMin;
+			sf::Vector2f	m_vMax;
+		};
+
+		struct Node
+		{
+			bool IsLeaf() const { return m_iChild1 == NullNode; }
+
+			AABB	m_oAABB;
+			int		m_iParent{ NullNode };								//Next free node when the node isn't used
+			int		m_iChild1{ NullNode };
+			int		m_iChild2{ NullNode };
+			int		m_iHeight{ -1 };									//0 for the leaves, -1 for the free nodes
+			int		m_iUserData{ -1 };
+		};
+
+		static AABB _ToAABB( const sf::FloatRect& _oRect );
+
+		int _AllocateNode();
+		void _FreeNode( int _iNode );
+		void _InsertLeaf( int _iLeaf );
+		void _RemoveLeaf( int _iLeaf );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Rotates the tree around a node if its children heights differ by more than one
+		//Parameter : Node to balance
+		//Return value : Node now at the position of the given one
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		int _Balance( int _iNode );
+
+
+		/////////////////MEMBER VARIABLES/////////////////
+
+		std::vector< Node >			m_oNodes;
+		int							m_iRoot{ NullNode };
+		int							m_iFreeList{ NullNode };
+		int							m_iProxiesNumber{ 0 };
+		float						m_fMargin{ 4.f };
+	};
+} //namespace fzn
+
+#pragma warning( pop )
+
+#include "FZN/Tools/DynamicAABBTree.inl"
+
+#endif //_DYNAMICAABBTREE_H_
@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Bounding volume hierarchy of axis aligned boxes that can move
+//------------------------------------------------------------------------
+
+#include <cmath>
+#include <utility>
+
+#include "FZN/Tools/DynamicAABBTree.h"
+#include "FZN/Tools/Logging.h"
+
+
+namespace fzn
+{
+	/////////////////QUERIES/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the proxies whose fat box overlaps a given box
+	//Parameter 1 : Box to test
+	//Parameter 2 : Function called with each overlapping proxy, bool( int _iProxy ), returning false stops the query
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< typename Callback >
+	void DynamicAABBTree::Query( const sf::FloatRect& _oAABB, Callback&& _fnCallback ) const
+	{
+		if( m_iRoot == NullNode )
+			return;
+
+		const AABB oAABB = _ToAABB( _oAABB );
+
+		int pStack[ QueryStackSize ];
+		int iStackSize = 0;
+		pStack[ iStackSize++ ] = m_iRoot;
+
+		while( iStackSize > 0 )
+		{
+			const int iNode = pStack[ --iStackSize ];
+			const Node& oNode = m_oNodes[ iNode ];
+
+			if( oNode.m_oAABB.Overlaps( oAABB ) == false )
+				continue;
+
+			if( oNode.IsLeaf() )
+			{
+				if( _fnCallback( iNode ) == false )
+					return;
+			}
+			else
+			{
+				if( iStackSize + 2 > QueryStackSize )
+				{
+					FZN_COLOR_LOG( DBG_MSG_COL_RED, "Query stack overflow, the tree is too high (%d).", GetHeight() );
+					return;
+				}
+
+				pStack[ iStackSize++ ] = oNode.m_iChild1;
+				pStack[ iStackSize++ ] = oNode.m_iChild2;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the proxies whose fat box contains a point
+	//Parameter 1 : Point to test
+	//Parameter 2 : Function called with each proxy, bool( int _iProxy ), returning false stops the query
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< typename Callback >
+	void DynamicAABBTree::QueryPoint( const sf::Vector2f& _vPoint, Callback&& _fnCallback ) const
+	{
+		Query( sf::FloatRect( _vPoint, sf::Vector2f( 0.f, 0.f ) ), std::forward< Callback >( _fnCallback ) );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Looks for the proxies whose fat box is crossed by a segment
+	//Parameter 1 & 2 : Start and end of the segment
+	//Parameter 3 : Function called with each proxy, float( int _iProxy, float _fMaxFraction ).
+	//				It returns the part of the segment to keep testing: 0 stops the query, the distance of a hit keeps only the closer proxies, _fMaxFraction ignores the proxy.
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< typename Callback >
+	void DynamicAABBTree::RayCast( const sf::Vector2f& _vStart, const sf::Vector2f& _vEnd, Callback&& _fnCallback ) const
+	{
+		if( m_iRoot == NullNode )
+			return;
+
+		const sf::Vector2f vSegment = _vEnd - _vStart;
+		const sf::Vector2f vDirection = Math::VectorNormalization( vSegment );
+
+		//Perpendicular of the segment, the boxes too far from its line are skipped before the more expensive box test.
+		const sf::Vector2f vNormal( -vDirection.y, vDirection.x );
+		const sf::Vector2f vAbsNormal( std::fabs( vNormal.x ), std::fabs( vNormal.y ) );
+
+		float fMaxFraction = 1.f;
+		sf::Vector2f vSegmentEnd = _vEnd;
+		AABB oSegmentAABB = { { Math::Min( _vStart.x, vSegmentEnd.x ), Math::Min( _vStart.y, vSegmentEnd.y ) }, { Math::Max( _vStart.x, vSegmentEnd.x ), Math::Max( _vStart.y, vSegmentEnd.y ) } };
+
+		int pStack[ QueryStackSize ];
+		int iStackSize = 0;
+		pStack[ iStackSize++ ] = m_iRoot;
+
+		while( iStackSize > 0 )
+		{
+			const int iNode = pStack[ --iStackSize ];
+			const Node& oNode = m_oNodes[ iNode ];
+
+			if( oNode.m_oAABB.Overlaps( oSegmentAABB ) == false )
+				continue;
+
+			const sf::Vector2f vCenter = ( oNode.m_oAABB.m_vMin + oNode.m_oAABB.m_vMax ) * 0.5f;
+			const sf::Vector2f vExtents = ( oNode.m_oAABB.m_vMax - oNode.m_oAABB.m_vMin ) * 0.5f;
+
+			if( std::fabs( Math::VectorDot( vNormal, _vStart - vCenter ) ) - Math::VectorDot( vAbsNormal, vExtents ) > 0.f )
+				continue;
+
+			if( oNode.IsLeaf() )
+			{
+				const float fFraction = _fnCallback( iNode, fMaxFraction );
+
+				if( fFraction == 0.f )
+					return;
+
+				if( fFraction > 0.f && fFraction < fMaxFraction )
+				{
+					fMaxFraction = fFraction;
+					vSegmentEnd = _vStart + vSegment * fMaxFraction;
+					oSegmentAABB = { { Math::Min( _vStart.x, vSegmentEnd.x ), Math::Min( _vStart.y, vSegmentEnd.y ) }, { Math::Max( _vStart.x, vSegmentEnd.x ), Math::Max( _vStart.y, vSegmentEnd.y ) } };
+				}
+			}
+			else
+			{
+				if( iStackSize + 2 > QueryStackSize )
+				{
+					FZN_COLOR_LOG( DBG_MSG_COL_RED, "Ray cast stack overflow, the tree is too high (%d).", GetHeight() );
+					return;
+				}
+
+				pStack[ iStackSize++ ] = oNode.m_iChild1;
+				pStack[ iStackSize++ ] = oNode.m_iChild2;
+			}
+		}
+	}
+} //namespace fzn
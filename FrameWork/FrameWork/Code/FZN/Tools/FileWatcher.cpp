@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Watches a folder on a worker thread and gathers the modified files
+//------------------------------------------------------------------------
+
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+
+#if defined( __linux__ )
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "FZN/Includes.h"
+#include "FZN/Tools/FileWatcher.h"
+
+
+namespace fzn
+{
+	FileWatcher::FileWatcher()
+	{
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		Stop();
+	}
+
+	bool FileWatcher::Start( const std::string& _sFolder, int _iPollingInterval /*= 500*/ )
+	{
+		Stop();
+
+		std::error_code oError;
+
+		if( std::filesystem::is_directory( _sFolder, oError ) == false )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Can't watch \"%s\", folder not found.", _sFolder.c_str() );
+			return false;
+		}
+
+		m_sFolder			= NormalizePath( _sFolder );
+		m_iPollingInterval	= Math::Max( _iPollingInterval, 10 );
+		m_bRunning			= true;
+
+#if defined( __linux__ )
+		m_oThread = std::thread( &FileWatcher::_RunInotify, this );
+#else
+		m_oThread = std::thread( &FileWatcher::_RunPolling, this );
+#endif
+
+		FZN_LOG( "Watching \"%s\".", m_sFolder.c_str() );
+		return true;
+	}
+
+	void FileWatcher::Stop()
+	{
+		m_bRunning = false;
+
+		if( m_oThread.joinable() )
+			m_oThread.join();
+
+		std::lock_guard< std::mutex > oLock( m_oMutex );
+		m_oModifiedFiles.clear();
+	}
+
+	bool FileWatcher::IsRunning() const
+	{
+		return m_bRunning;
+	}
+
+	StringVector FileWatcher::PopModifiedFiles()
+	{
+		StringVector oFiles;
+
+		std::lock_guard< std::mutex > oLock( m_oMutex );
+		oFiles.swap( m_oModifiedFiles );
+
+		return oFiles;
+	}
+
+	std::string FileWatcher::NormalizePath( const std::string& _sPath )
+	{
+		return std::filesystem::path( _sPath ).lexically_normal().generic_string();
+	}
+
+	void FileWatcher::_RunInotify()
+	{
+#if defined( __linux__ )
+		const int iInotify = inotify_init1( IN_NONBLOCK );
+
+		if( iInotify < 0 )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_YELLOW, "inotify unavailable, scanning \"%s\" instead.", m_sFolder.c_str() );
+			_RunPolling();
+			return;
+		}
+
+		const uint32_t uMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+		std::unordered_map< int, std::string > oWatchedFolders;
+
+		auto AddWatch = [&]( const std::string& _sFolder )
+		{
+			const int iWatch = inotify_add_watch( iInotify, _sFolder.c_str(), uMask );
+
+			if( iWatch >= 0 )
+				oWatchedFolders[ iWatch ] = _sFolder;
+		};
+
+		auto AddWatchRecursive = [&]( const std::string& _sFolder )
+		{
+			AddWatch( _sFolder );
+
+			std::error_code oError;
+			for( std::filesystem::recursive_directory_iterator it( _sFolder, oError ), itEnd; it != itEnd; it.increment( oError ) )
+			{
+				if( it->is_directory( oError ) )
+					AddWatch( NormalizePath( it->path().string() ) );
+			}
+		};
+
+		AddWatchRecursive( m_sFolder );
+
+		alignas( inotify_event ) char aBuffer[ 4096 ];
+		pollfd oPoll{ iInotify, POLLIN, 0 };
+
+		while( m_bRunning )
+		{
+			if( poll( &oPoll, 1, 100 ) <= 0 )
+				continue;
+
+			ssize_t iLength = 0;
+			while( ( iLength = read( iInotify, aBuffer, sizeof( aBuffer ) ) ) > 0 )
+			{
+				for( char* pCursor = aBuffer; pCursor < aBuffer + iLength; )
+				{
+					const inotify_event* pEvent = (const inotify_event*)pCursor;
+					pCursor += sizeof( inotify_event ) + pEvent->len;
+
+					std::unordered_map< int, std::string >::const_iterator itFolder = oWatchedFolders.find( pEvent->wd );
+
+					if( itFolder == oWatchedFolders.end() || pEvent->len == 0 )
+						continue;
+
+					const std::string sPath = itFolder->second + "/" + pEvent->name;
+
+					if( pEvent->mask & IN_ISDIR )
+					{
+						if( pEvent->mask & ( IN_CREATE | IN_MOVED_TO ) )
+							AddWatchRecursive( sPath );
+					}
+					else if( pEvent->mask & ( IN_CLOSE_WRITE | IN_MOVED_TO ) )
+						_PushModifiedFile( sPath );
+				}
+			}
+		}
+
+		close( iInotify );
+#else
+		_RunPolling();
+#endif
+	}
+
+	void FileWatcher::_RunPolling()
+	{
+		typedef std::unordered_map< std::string, std::filesystem::file_time_type > FileTimes;
+
+		auto ScanFolder = [&]( FileTimes& _oTimes )
+		{
+			std::error_code oError;
+			for( std::filesystem::recursive_directory_iterator it( m_sFolder, oError ), itEnd; it != itEnd; it.increment( oError ) )
+			{
+				if( it->is_regular_file( oError ) )
+					_oTimes[ NormalizePath( it->path().string() ) ] = it->last_write_time( oError );
+			}
+		};
+
+		FileTimes oPreviousTimes;
+		ScanFolder( oPreviousTimes );
+
+		while( m_bRunning )
+		{
+			//Sleeping by small steps so Stop doesn't have to wait for a whole interval.
+			for( int iWaited = 0; iWaited < m_iPollingInterval && m_bRunning; iWaited += 10 )
+				std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+			FileTimes oCurrentTimes;
+			ScanFolder( oCurrentTimes );
+
+			for( const FileTimes::value_type& oFile : oCurrentTimes )
+			{
+				FileTimes::const_iterator itPrevious = oPreviousTimes.find( oFile.first );
+
+				if( itPrevious == oPreviousTimes.end() || itPrevious->second != oFile.second )
+					_PushModifiedFile( oFile.first );
+			}
+
+			oPreviousTimes.swap( oCurrentTimes );
+		}
+	}
+
+	void FileWatcher::_PushModifiedFile( const std::string& _sPath )
+	{
+		const std::string sPath = NormalizePath( _sPath );
+
+		std::lock_guard< std::mutex > oLock( m_oMutex );
+
+		if( std::find( m_oModifiedFiles.begin(), m_oModifiedFiles.end(), sPath ) == m_oModifiedFiles.end() )
+			m_oModifiedFiles.push_back( sPath );
+	}
+} //namespace fzn
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Watches a folder on a worker thread and gathers the modified files
+//------------------------------------------------------------------------
+
+#ifndef _FILEWATCHER_H_
+#define _FILEWATCHER_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "FZN/Defines.h"
+
+
+namespace fzn
+{
+	//Uses inotify on Linux and compares the files modification times on the other platforms.
+	//The modified files are only gathered by the worker thread, it's up to the owner to pop them on the main thread and do something about them.
+	class FZN_EXPORT FileWatcher
+	{
+	public:
+		FileWatcher();
+		~FileWatcher();
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Starts watching a folder and all its sub folders
+		//Parameter 1 : Folder to watch
+		//Parameter 2 : Time between two scans of the folder when inotify isn't available (ms)
+		//Return value : The worker thread has been started (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool				Start( const std::string& _sFolder, int _iPollingInterval = 500 );
+		void				Stop();
+		bool				IsRunning() const;
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Retrieves the files modified since the last call, each file only being there once
+		//Return value : Normalized paths of the files (see NormalizePath)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		StringVector		PopModifiedFiles();
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Formats a path the same way the watcher does so they can be compared
+		//Parameter : Path to normalize
+		//Return value : Normalized path, with forward slashes
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static std::string	NormalizePath( const std::string& _sPath );
+
+	private:
+		void				_RunInotify();
+		void				_RunPolling();
+		void				_PushModifiedFile( const std::string& _sPath );
+
+		std::string			m_sFolder{ "" };
+		int					m_iPollingInterval{ 500 };
+
+		std::thread			m_oThread;
+		std::atomic< bool >	m_bRunning{ false };
+
+		std::mutex			m_oMutex;
+		StringVector		m_oModifiedFiles;
+	};
+} //namespace fzn
+
+#endif //_FILEWATCHER_H_
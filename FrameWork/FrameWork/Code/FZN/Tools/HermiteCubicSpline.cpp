@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "FZN/Includes.h"
 #include "FZN/Tools/HermiteCubicSpline.h"
 
@@ -7,6 +11,7 @@ namespace fzn
 	: m_iNbSections( 100 )
 	, m_oVertices( sf::LineStrip, m_iNbSections + 1 )
 	, m_bLoop( false )
+	, m_bTablesValid( false )
 	{
 	}
 
@@ -22,6 +27,7 @@ namespace fzn
 
 		m_oVertices.resize( m_iNbSections + 1 );
 		_GenerateTangents();
+		_GenerateLookUpTable();
 
 		float fStep = 1.f / m_iNbSections;
 		float fCurrentU = 0.f;
@@ -33,10 +39,7 @@ namespace fzn
 		}
 
 		if( _fDistance > 0.f && m_oVertices.getVertexCount() >= 2 )
-		{
-			_GenerateLookUpTable();
 			_MakeUniform( _fDistance );
-		}
 	}
 
 
@@ -51,11 +54,14 @@ namespace fzn
 
 		for( int iControlPoint = 0 ; iControlPoint < (int)_oPositions.size() ; ++iControlPoint )
 			m_oControlPoints.push_back( SplineControlPoint( _oPositions[iControlPoint] ) );
+
+		m_bTablesValid = false;
 	}
 
 	void HermiteCubicSpline::AddPoint( const sf::Vector2f & _vPosition, const sf::Vector2f& _vTangent /*= sf::Vector2f( 0.f, 0.f )*/ )
 	{
 		m_oControlPoints.push_back( SplineControlPoint( _vPosition, _vTangent ) );
+		m_bTablesValid = false;
 	}
 
 	void HermiteCubicSpline::SetControlPointPosition( unsigned int _iControlPoint, const sf::Vector2f& _vPosition )
@@ -64,6 +70,7 @@ namespace fzn
 			return;
 
 		m_oControlPoints[_iControlPoint].m_vPosition = _vPosition;
+		_UpdateSegmentsAround( _iControlPoint );
 	}
 
 	sf::Vector2f HermiteCubicSpline::GetControlPointPosition( unsigned int _iControlPoint ) const
@@ -80,6 +87,7 @@ namespace fzn
 			return;
 
 		m_oControlPoints[_iControlPoint].m_vTangent = _vTangent;
+		_UpdateSegmentsAround( _iControlPoint );
 	}
 
 	sf::Vector2f HermiteCubicSpline::GetControlPointTangent( unsigned int _iControlPoint ) const
@@ -102,6 +110,7 @@ namespace fzn
 	void HermiteCubicSpline::SetLoop( bool _bLoop )
 	{
 		m_bLoop = _bLoop;
+		m_bTablesValid = false;
 	}
 
 	bool HermiteCubicSpline::IsLooping() const
@@ -109,6 +118,79 @@ namespace fzn
 		return m_bLoop;
 	}
 
+	float HermiteCubicSpline::GetLength() const
+	{
+		return m_bTablesValid ? m_oSegmentStarts.back() : 0.f;
+	}
+
+	float HermiteCubicSpline::GetDistanceAtProgression( float _fProgression ) const
+	{
+		if( m_bTablesValid == false )
+			return 0.f;
+
+		const int iNbSegments = _GetSegmentsNumber();
+		const float fScaledProgression = Math::Clamp( _fProgression, 0.f, 1.f ) * iNbSegments;
+		const int iSegment = Math::Min( (int)fScaledProgression, iNbSegments - 1 );
+		const float* pArcLengths = &m_oArcLengths[ iSegment * ArcLengthSamples ];
+
+		const float fSample = ( fScaledProgression - iSegment ) * ArcLengthSamples;
+		const int iSample = Math::Min( (int)fSample, ArcLengthSamples - 1 );
+		const float fLowerLength = iSample == 0 ? 0.f : pArcLengths[ iSample - 1 ];
+
+		return m_oSegmentStarts[ iSegment ] + fLowerLength + ( pArcLengths[ iSample ] - fLowerLength ) * ( fSample - iSample );
+	}
+
+	sf::Vector2f HermiteCubicSpline::GetPositionAtDistance( float _fDistance ) const
+	{
+		if( m_bTablesValid == false )
+			return sf::Vector2f( std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN() );
+
+		const float fDistance = _WrapDistance( _fDistance );
+		const int iSegment = _FindSegment( fDistance );
+
+		return _EvaluatePosition( iSegment, _GetSegmentProgression( iSegment, fDistance ) );
+	}
+
+	sf::Vector2f HermiteCubicSpline::GetTangentAtDistance( float _fDistance ) const
+	{
+		if( m_bTablesValid == false )
+			return sf::Vector2f( std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN() );
+
+		const float fDistance = _WrapDistance( _fDistance );
+		const int iSegment = _FindSegment( fDistance );
+
+		return _EvaluateTangent( iSegment, _GetSegmentProgression( iSegment, fDistance ) );
+	}
+
+	void HermiteCubicSpline::SampleAtDistances( const float* _pDistances, int _iCount, sf::Vector2f* _pPositions, sf::Vector2f* _pTangents /*= nullptr*/ ) const
+	{
+		if( m_bTablesValid == false || _pDistances == nullptr || _pPositions == nullptr )
+			return;
+
+		const int iNbSegments = _GetSegmentsNumber();
+		int iSegment = 0;
+
+		for( int iSample = 0 ; iSample < _iCount ; ++iSample )
+		{
+			const float fDistance = _WrapDistance( _pDistances[ iSample ] );
+
+			//Sorted distances stay in the same segment or go to the next one, the search is only needed when they jump.
+			if( fDistance < m_oSegmentStarts[ iSegment ] || ( fDistance >= m_oSegmentStarts[ iSegment + 1 ] && iSegment < iNbSegments - 1 ) )
+			{
+				if( fDistance >= m_oSegmentStarts[ iSegment + 1 ] && fDistance < m_oSegmentStarts[ iSegment + 2 ] )
+					++iSegment;
+				else
+					iSegment = _FindSegment( fDistance );
+			}
+
+			const float fT = _GetSegmentProgression( iSegment, fDistance );
+			_pPositions[ iSample ] = _EvaluatePosition( iSegment, fT );
+
+			if( _pTangents != nullptr )
+				_pTangents[ iSample ] = _EvaluateTangent( iSegment, fT );
+		}
+	}
+
 	void HermiteCubicSpline::DebugDraw( bool _bDrawControlPoints /*= true*/, int _iWindow /*= MainWindow*/ )
 	{
 		if( m_oControlPoints.empty() )
@@ -199,14 +281,6 @@ namespace fzn
 			_oControlPoint.m_vTangent *= Math::VectorLength( vNext );
 	}
 
-	void MulMatVector4( float* _pOut, const float* _pMat4, const float* _pVec4 )
-	{
-		_pOut[0] = _pMat4[0] * _pVec4[0] + _pMat4[1] * _pVec4[1] + _pMat4[2] * _pVec4[2] + _pMat4[3] * _pVec4[3];
-		_pOut[1] = _pMat4[4] * _pVec4[0] + _pMat4[5] * _pVec4[1] + _pMat4[6] * _pVec4[2] + _pMat4[7] * _pVec4[3];
-		_pOut[2] = _pMat4[8] * _pVec4[0] + _pMat4[9] * _pVec4[1] + _pMat4[10] * _pVec4[2] + _pMat4[11] * _pVec4[3];
-		_pOut[3] = _pMat4[12] * _pVec4[0] + _pMat4[13] * _pVec4[1] + _pMat4[14] * _pVec4[2] + _pMat4[15] * _pVec4[3];
-	}
-
 	void HermiteCubicSpline::draw( sf::RenderTarget& _oTarget, sf::RenderStates _oStates ) const
 	{
 		if( m_oControlPoints.empty() )
@@ -239,49 +313,142 @@ namespace fzn
 		GenerateTangents( m_oControlPoints, m_bLoop );
 	}
 
-	sf::Vector2f HermiteCubicSpline::_ProcessSteps( float _fProgression )
+	sf::Vector2f HermiteCubicSpline::_ProcessSteps( float _fProgression ) const
+	{
+		const int iNbSegments = _GetSegmentsNumber();
+		const float fScaledProgression = _fProgression * iNbSegments;				//Progression from 0 to the number of segments.
+		const int iSegment = Math::Clamp( (int)fScaledProgression, 0, iNbSegments - 1 );
+
+		return _EvaluatePosition( iSegment, fScaledProgression - iSegment );
+	}
+
+	void HermiteCubicSpline::_GenerateLookUpTable()
+	{
+		const int iNbSegments = _GetSegmentsNumber();
+
+		m_oSegments.resize( iNbSegments );
+		m_oArcLengths.resize( iNbSegments * ArcLengthSamples );
+
+		for( int iSegment = 0 ; iSegment < iNbSegments ; ++iSegment )
+			_UpdateSegment( iSegment );
+
+		_UpdateSegmentStarts();
+		m_bTablesValid = true;
+	}
+
+	void HermiteCubicSpline::_UpdateSegment( int _iSegment )
 	{
-		float fScaledProgression = _fProgression * ( m_oControlPoints.size() - 1 ); //Progression from 0  to nb CP - 1.
+		const SplineControlPoint& oStart = m_oControlPoints[ _iSegment ];
+		const SplineControlPoint& oEnd = m_oControlPoints[ ( _iSegment + 1 ) % m_oControlPoints.size() ];
+		const sf::Vector2f pGeometry[4] = { oStart.m_vPosition, oEnd.m_vPosition, oStart.m_vTangent, oEnd.m_vTangent };
+		Segment& oSegment = m_oSegments[ _iSegment ];
 
-		if( m_bLoop )
-			fScaledProgression = _fProgression * ( m_oControlPoints.size() );
+		//Each row of the Hermite matrix gives the weight of a point or tangent for each power of t.
+		for( int iPower = 0 ; iPower < 4 ; ++iPower )
+		{
+			oSegment.m_pCoefs[ iPower ] = sf::Vector2f( 0.f, 0.f );
+
+			for( int iGeometry = 0 ; iGeometry < 4 ; ++iGeometry )
+				oSegment.m_pCoefs[ iPower ] += m_pHermiteCoef[ iGeometry * 4 + iPower ] * pGeometry[ iGeometry ];
+		}
+
+		float* pArcLengths = &m_oArcLengths[ _iSegment * ArcLengthSamples ];
+		sf::Vector2f vPreviousPoint = oStart.m_vPosition;
+		float fLength = 0.f;
+
+		for( int iSample = 0 ; iSample < ArcLengthSamples ; ++iSample )
+		{
+			const sf::Vector2f vPoint = _EvaluatePosition( _iSegment, (float)( iSample + 1 ) / ArcLengthSamples );
+
+			fLength += Math::VectorLength( vPoint - vPreviousPoint );
+			pArcLengths[ iSample ] = fLength;
+			vPreviousPoint = vPoint;
+		}
+	}
 
-		float fClampedProgression = Math::Max( fScaledProgression - 1.f, 0.f );
-		fClampedProgression = ceilf( fClampedProgression );							//First point => ClampedProgression / Second point => ClampedProgression + 1
+	void HermiteCubicSpline::_UpdateSegmentsAround( unsigned int _iControlPoint )
+	{
+		if( m_bTablesValid == false )
+			return;
 
-		float fFinalProgression = fScaledProgression - fClampedProgression;			//Final progression : [0, 1] between current points.
+		const int iNbSegments = _GetSegmentsNumber();
+		const int iPreviousSegment = _iControlPoint > 0 ? (int)_iControlPoint - 1 : ( m_bLoop ? iNbSegments - 1 : -1 );
 
-		float pU[4] = { Math::Cube( fFinalProgression ), Math::Square( fFinalProgression ), fFinalProgression, 1 };
-		float pOut[4] = { 0.f, 0.f, 0.f, 0.f };
+		if( iPreviousSegment >= 0 )
+			_UpdateSegment( iPreviousSegment );
 
-		MulMatVector4( pOut, m_pHermiteCoef, pU );
+		if( (int)_iControlPoint < iNbSegments )
+			_UpdateSegment( _iControlPoint );
 
-		int iP1 = static_cast<int>( fClampedProgression );
-		int iP2 = iP1 + 1;
+		_UpdateSegmentStarts();
+	}
 
-		if( iP2 == m_oControlPoints.size() )
-			iP2 = 0;
+	void HermiteCubicSpline::_UpdateSegmentStarts()
+	{
+		const int iNbSegments = (int)m_oSegments.size();
 
-		sf::Vector2f vPoint = pOut[0] * m_oControlPoints[iP1].m_vPosition + pOut[1] * m_oControlPoints[iP2].m_vPosition;
-		vPoint += pOut[2] * m_oControlPoints[iP1].m_vTangent + pOut[3] * m_oControlPoints[iP2].m_vTangent;
+		m_oSegmentStarts.resize( iNbSegments + 1 );
+		m_oSegmentStarts[ 0 ] = 0.f;
 
-		return vPoint;
+		for( int iSegment = 0 ; iSegment < iNbSegments ; ++iSegment )
+			m_oSegmentStarts[ iSegment + 1 ] = m_oSegmentStarts[ iSegment ] + m_oArcLengths[ iSegment * ArcLengthSamples + ArcLengthSamples - 1 ];
 	}
 
-	void HermiteCubicSpline::_GenerateLookUpTable()
+	int HermiteCubicSpline::_GetSegmentsNumber() const
 	{
-		m_oLookUpTable.clear();
+		if( m_oControlPoints.size() < 2 )
+			return 0;
 
-		m_oLookUpTable[0.f] = 0.f;
-		float fCurrentDistance = 0.f;
-		const float fStep = 1.f / m_iNbSections;
+		return m_bLoop ? (int)m_oControlPoints.size() : (int)m_oControlPoints.size() - 1;
+	}
+
+	float HermiteCubicSpline::_WrapDistance( float _fDistance ) const
+	{
+		const float fLength = m_oSegmentStarts.back();
 
-		for( unsigned int uVertex = 1 ; uVertex < m_oVertices.getVertexCount() ; ++uVertex )
+		if( m_bLoop && fLength > 0.f )
 		{
-			const sf::Vector2f vCurrentDistance = m_oVertices[uVertex].position - m_oVertices[uVertex - 1].position;
-			fCurrentDistance += Math::VectorLength( vCurrentDistance );
-			m_oLookUpTable[fCurrentDistance] = Math::Min( uVertex * fStep, 1.f );
+			const float fDistance = std::fmod( _fDistance, fLength );
+			return fDistance < 0.f ? fDistance + fLength : fDistance;
 		}
+
+		return Math::Clamp( _fDistance, 0.f, fLength );
+	}
+
+	int HermiteCubicSpline::_FindSegment( float _fDistance ) const
+	{
+		//The first start is always 0, the search begins at the second one so the result is directly the segment index.
+		const int iSegment = (int)( std::upper_bound( m_oSegmentStarts.begin() + 1, m_oSegmentStarts.end(), _fDistance ) - ( m_oSegmentStarts.begin() + 1 ) );
+
+		return Math::Min( iSegment, (int)m_oSegments.size() - 1 );
+	}
+
+	float HermiteCubicSpline::_GetSegmentProgression( int _iSegment, float _fDistance ) const
+	{
+		const float fLocalDistance = _fDistance - m_oSegmentStarts[ _iSegment ];
+		const float* pArcLengths = &m_oArcLengths[ _iSegment * ArcLengthSamples ];
+
+		const int iSample = (int)( std::lower_bound( pArcLengths, pArcLengths + ArcLengthSamples - 1, fLocalDistance ) - pArcLengths );
+
+		const float fLowerLength = iSample == 0 ? 0.f : pArcLengths[ iSample - 1 ];
+		const float fSampleLength = pArcLengths[ iSample ] - fLowerLength;
+		const float fInterpolationCoeff = fSampleLength > 0.f ? Math::Clamp( ( fLocalDistance - fLowerLength ) / fSampleLength, 0.f, 1.f ) : 0.f;
+
+		return ( iSample + fInterpolationCoeff ) / ArcLengthSamples;
+	}
+
+	sf::Vector2f HermiteCubicSpline::_EvaluatePosition( int _iSegment, float _fT ) const
+	{
+		const sf::Vector2f* pCoefs = m_oSegments[ _iSegment ].m_pCoefs;
+
+		return ( ( pCoefs[0] * _fT + pCoefs[1] ) * _fT + pCoefs[2] ) * _fT + pCoefs[3];
+	}
+
+	sf::Vector2f HermiteCubicSpline::_EvaluateTangent( int _iSegment, float _fT ) const
+	{
+		const sf::Vector2f* pCoefs = m_oSegments[ _iSegment ].m_pCoefs;
+
+		return Math::VectorNormalization( ( pCoefs[0] * ( 3.f * _fT ) + pCoefs[1] * 2.f ) * _fT + pCoefs[2] );
 	}
 
 	void HermiteCubicSpline::_MakeUniform( const float _fDistance )
@@ -290,25 +457,11 @@ namespace fzn
 			return;
 
 		const sf::Vector2f vLastPointPosition = m_oVertices[ m_oVertices.getVertexCount() - 1].position;
+		const float fLength = GetLength();
 		m_oVertices.clear();
-		float fCurrentDistance = 0.f;
-		std::map<float, float>::const_iterator itUpper = m_oLookUpTable.upper_bound( fCurrentDistance );
-		std::map<float, float>::const_iterator itLower;
-	
-		while( itUpper != m_oLookUpTable.cend() )
-		{
-			itLower = itUpper;
-			itLower--;
-
-			const float fInterpolationCoeff = ( fCurrentDistance - itLower->first ) / ( itUpper->first - itLower->first );
-			const float fU = itLower->second * ( 1.f - fInterpolationCoeff ) + itUpper->second * fInterpolationCoeff;
-
-			m_oVertices.append( sf::Vertex( _ProcessSteps( fU ) ) );
-
-			fCurrentDistance += _fDistance;
-			itUpper = m_oLookUpTable.upper_bound( fCurrentDistance );
-		}
 
+		for( float fCurrentDistance = 0.f ; fCurrentDistance < fLength ; fCurrentDistance += _fDistance )
+			m_oVertices.append( sf::Vertex( GetPositionAtDistance( fCurrentDistance ) ) );
 
 		m_oVertices.append( vLastPointPosition );
 	}
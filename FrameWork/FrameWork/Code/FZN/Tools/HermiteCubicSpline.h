@@ -31,7 +31,7 @@ namespace fzn
 
 		const std::vector< SplineControlPoint >&	GetControlPoints() const { return m_oControlPoints; }
 		const sf::VertexArray&				GetVertices() const;
-		void								ClearPoints() { m_oControlPoints.clear(); }
+		void								ClearPoints() { m_oControlPoints.clear(); m_bTablesValid = false; }
 		void								SetControlPoints( const std::vector< sf::Vector2f >& _oPositions );
 		void								AddPoint( const sf::Vector2f& _vPosition, const sf::Vector2f& _vTangent = sf::Vector2f( 0.f, 0.f ) );
 		void								SetControlPointPosition( unsigned int _iControlPoint, const sf::Vector2f& _vPosition );
@@ -42,6 +42,15 @@ namespace fzn
 		void								SetLoop( bool _bLoop );
 		bool								IsLooping() const;
 
+		//Runtime evaluation, valid once the spline is built. Moving a control point or its tangent afterwards only updates the two segments around it.
+		//The distances are clamped to the spline length, or wrapped around it when looping.
+		float								GetLength() const;
+		float								GetDistanceAtProgression( float _fProgression ) const;
+		sf::Vector2f						GetPositionAtDistance( float _fDistance ) const;
+		sf::Vector2f						GetTangentAtDistance( float _fDistance ) const;		//Normalized
+		//Samples many distances at once (followers), faster when they are sorted. The tangents are optional.
+		void								SampleAtDistances( const float* _pDistances, int _iCount, sf::Vector2f* _pPositions, sf::Vector2f* _pTangents = nullptr ) const;
+
 		void								DebugDraw( bool _bDrawControlPoints = true, int _iWindow = FZN_MainWindow );
 
 		static void							GenerateTangents( std::vector< SplineControlPoint >& _oControlPoints, bool _bLoop = false );
@@ -50,9 +59,26 @@ namespace fzn
 	protected:
 		virtual void						draw( sf::RenderTarget& _oTarget, sf::RenderStates _oStates ) const;
 
+		//Polynomial of a segment between two control points: ( ( A * t + B ) * t + C ) * t + D.
+		struct Segment
+		{
+			sf::Vector2f m_pCoefs[4];
+		};
+
+		static constexpr int ArcLengthSamples = 32;				//Samples per segment in the arc length table
+
 		void								_GenerateTangents();
-		sf::Vector2f						_ProcessSteps( float _fProgression );
+		sf::Vector2f						_ProcessSteps( float _fProgression ) const;
 		void								_GenerateLookUpTable();
+		void								_UpdateSegment( int _iSegment );
+		void								_UpdateSegmentsAround( unsigned int _iControlPoint );
+		void								_UpdateSegmentStarts();
+		int									_GetSegmentsNumber() const;
+		float								_WrapDistance( float _fDistance ) const;
+		int									_FindSegment( float _fDistance ) const;
+		float								_GetSegmentProgression( int _iSegment, float _fDistance ) const;
+		sf::Vector2f						_EvaluatePosition( int _iSegment, float _fT ) const;
+		sf::Vector2f						_EvaluateTangent( int _iSegment, float _fT ) const;
 		void								_MakeUniform( const float _fDistance );
 
 		std::vector< SplineControlPoint >	m_oControlPoints;
@@ -60,7 +86,10 @@ namespace fzn
 		sf::VertexArray						m_oVertices;
 		bool								m_bLoop;
 
-		std::map<float, float>				m_oLookUpTable;
+		std::vector< Segment >				m_oSegments;
+		std::vector< float >				m_oSegmentStarts;			//Distance at the beginning of each segment, followed by the length of the spline
+		std::vector< float >				m_oArcLengths;				//Distance from the beginning of its segment of each sample, ArcLengthSamples per segment
+		bool								m_bTablesValid;
 
 		static constexpr float m_pHermiteCoef[16] =
 		{
@@ -72,4 +101,4 @@ namespace fzn
 	};
 }
 
-#endif //__FZN_HERMITE_CUBIC_SPLINE_H__
\ No newline at end of file
+#endif //__FZN_HERMITE_CUBIC_SPLINE_H__
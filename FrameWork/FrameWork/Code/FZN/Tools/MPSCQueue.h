@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Bounded lock free queue, filled by any thread and emptied by a single one
+//------------------------------------------------------------------------
+
+#ifndef _MPSCQUEUE_H_
+#define _MPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace fzn
+{
+	//Ring buffer where each cell holds a sequence number telling the producers and the consumer if it can be written or read.
+	//A producer reserves a cell by incrementing the write position, writes the value, then publishes it by updating the cell sequence.
+	//Only one thread at a time can pop the values.
+	template< typename T, size_t Capacity >
+	class MPSCQueue
+	{
+		static_assert( Capacity >= 2 && ( Capacity & ( Capacity - 1 ) ) == 0, "MPSCQueue capacity must be a power of 2." );
+
+	public:
+		MPSCQueue()
+		{
+			for( size_t iCell = 0; iCell < Capacity; ++iCell )
+				m_oCells[ iCell ].m_uSequence.store( iCell, std::memory_order_relaxed );
+		}
+
+		MPSCQueue( const MPSCQueue& ) = delete;
+		MPSCQueue& operator=( const MPSCQueue& ) = delete;
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Adds a value at the end of the queue, can be called from any thread
+		//Parameter : Value to add
+		//Return value : The value has been added (true) or the queue is full
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool Push( const T& _oValue )
+		{
+			size_t uPosition = m_uWritePosition.load( std::memory_order_relaxed );
+
+			while( true )
+			{
+				Cell& oCell = m_oCells[ uPosition & ( Capacity - 1 ) ];
+				const size_t uSequence = oCell.m_uSequence.load( std::memory_order_acquire );
+				const intptr_t iDifference = (intptr_t)uSequence - (intptr_t)uPosition;
+
+				if( iDifference == 0 )
+				{
+					if( m_uWritePosition.compare_exchange_weak( uPosition, uPosition + 1, std::memory_order_relaxed ) )
+					{
+						oCell.m_oValue = _oValue;
+						oCell.m_uSequence.store( uPosition + 1, std::memory_order_release );
+						return true;
+					}
+				}
+				else if( iDifference < 0 )
+					return false;		//The consumer hasn't read this cell yet, the queue is full.
+				else
+					uPosition = m_uWritePosition.load( std::memory_order_relaxed );
+			}
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Removes the first value of the queue, must only be called by the consumer thread
+		//Parameter : Popped value
+		//Return value : A value has been popped (true) or the queue is empty
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool Pop( T& _oValue )
+		{
+			Cell& oCell = m_oCells[ m_uReadPosition & ( Capacity - 1 ) ];
+
+			if( oCell.m_uSequence.load( std::memory_order_acquire ) != m_uReadPosition + 1 )
+				return false;
+
+			_oValue = oCell.m_oValue;
+			oCell.m_uSequence.store( m_uReadPosition + Capacity, std::memory_order_release );
+			++m_uReadPosition;
+
+			return true;
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Moves all the published values at the end of a vector, must only be called by the consumer thread
+		//Parameter : Vector receiving the values
+		//Return value : Number of popped values
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		size_t PopAll( std::vector< T >& _oValues )
+		{
+			size_t uNbValues = 0;
+			T oValue;
+
+			while( Pop( oValue ) )
+			{
+				_oValues.push_back( oValue );
+				++uNbValues;
+			}
+
+			return uNbValues;
+		}
+
+		bool IsEmpty() const
+		{
+			return m_oCells[ m_uReadPosition & ( Capacity - 1 ) ].m_uSequence.load( std::memory_order_acquire ) != m_uReadPosition + 1;
+		}
+
+	private:
+		static constexpr size_t CacheLineSize{ 64 };
+
+		struct Cell
+		{
+			std::atomic< size_t >	m_uSequence{ 0 };
+			T						m_oValue{};
+		};
+
+		Cell									m_oCells[ Capacity ];
+		alignas( CacheLineSize ) std::atomic< size_t >	m_uWritePosition{ 0 };		//Shared by the producers
+		alignas( CacheLineSize ) size_t					m_uReadPosition{ 0 };		//Only used by the consumer
+	};
+} //namespace fzn
+
+#endif //_MPSCQUEUE_H_
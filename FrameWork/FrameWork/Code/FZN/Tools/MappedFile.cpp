@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Read only memory mapping of a file
+//------------------------------------------------------------------------
+
+#if defined( _WIN32 )
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "FZN/Includes.h"
+#include "FZN/Tools/MappedFile.h"
+
+
+namespace fzn
+{
+	MappedFile::MappedFile()
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open( const std::string& _sPath )
+	{
+		Close();
+
+#if defined( _WIN32 )
+		HANDLE hFile = CreateFileA( _sPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+		if( hFile == INVALID_HANDLE_VALUE )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't open file: %s", _sPath.c_str() );
+			return false;
+		}
+
+		LARGE_INTEGER oSize;
+
+		if( GetFileSizeEx( hFile, &oSize ) == FALSE || oSize.QuadPart == 0 )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Empty or invalid file: %s", _sPath.c_str() );
+			CloseHandle( hFile );
+			return false;
+		}
+
+		HANDLE hMapping = CreateFileMappingA( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+		const void* pView = hMapping != nullptr ? MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+
+		if( pView == nullptr )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't map file: %s", _sPath.c_str() );
+
+			if( hMapping != nullptr )
+				CloseHandle( hMapping );
+
+			CloseHandle( hFile );
+			return false;
+		}
+
+		m_hFile		= hFile;
+		m_hMapping	= hMapping;
+		m_pData		= (const uint8_t*)pView;
+		m_uSize		= (size_t)oSize.QuadPart;
+#else
+		const int iFile = open( _sPath.c_str(), O_RDONLY );
+
+		if( iFile < 0 )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't open file: %s", _sPath.c_str() );
+			return false;
+		}
+
+		struct stat oStat;
+
+		if( fstat( iFile, &oStat ) != 0 || oStat.st_size == 0 )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Empty or invalid file: %s", _sPath.c_str() );
+			close( iFile );
+			return false;
+		}
+
+		void* pView = mmap( nullptr, (size_t)oStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0 );
+
+		if( pView == MAP_FAILED )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't map file: %s", _sPath.c_str() );
+			close( iFile );
+			return false;
+		}
+
+		m_iFile	= iFile;
+		m_pData	= (const uint8_t*)pView;
+		m_uSize	= (size_t)oStat.st_size;
+#endif
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+#if defined( _WIN32 )
+		if( m_pData != nullptr )
+			UnmapViewOfFile( m_pData );
+
+		if( m_hMapping != nullptr )
+			CloseHandle( (HANDLE)m_hMapping );
+
+		if( m_hFile != nullptr )
+			CloseHandle( (HANDLE)m_hFile );
+
+		m_hFile		= nullptr;
+		m_hMapping	= nullptr;
+#else
+		if( m_pData != nullptr )
+			munmap( (void*)m_pData, m_uSize );
+
+		if( m_iFile >= 0 )
+			close( m_iFile );
+
+		m_iFile = -1;
+#endif
+
+		m_pData = nullptr;
+		m_uSize = 0;
+	}
+
+	bool MappedFile::IsOpen() const
+	{
+		return m_pData != nullptr;
+	}
+
+	const uint8_t* MappedFile::GetData() const
+	{
+		return m_pData;
+	}
+
+	size_t MappedFile::GetSize() const
+	{
+		return m_uSize;
+	}
+} //namespace fzn
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Read only memory mapping of a file
+//------------------------------------------------------------------------
+
+#ifndef _MAPPEDFILE_H_
+#define _MAPPEDFILE_H_
+
+#include <string>
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include "FZN/Defines.h"
+
+
+namespace fzn
+{
+	//The pages of the file are only loaded by the system when they are accessed.
+	class FZN_EXPORT MappedFile : public sf::NonCopyable
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Maps the whole file in memory, closing the previously mapped one
+		//Parameter 1 : Path to the file
+		//Return value : The file has been mapped (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool				Open( const std::string& _sPath );
+		void				Close();
+		bool				IsOpen() const;
+
+		const uint8_t*		GetData() const;
+		size_t				GetSize() const;
+
+	private:
+		const uint8_t*		m_pData{ nullptr };
+		size_t				m_uSize{ 0 };
+
+#if defined( _WIN32 )
+		void*				m_hFile{ nullptr };
+		void*				m_hMapping{ nullptr };
+#else
+		int					m_iFile{ -1 };
+#endif
+	};
+} //namespace fzn
+
+#endif //_MAPPEDFILE_H_
@@ -0,0 +1,337 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Math functions applied to arrays of values at once
+//------------------------------------------------------------------------
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+#include "FZN/Includes.h"
+#include "FZN/Tools/MathBatch.h"
+
+#if defined( __AVX__ )
+	#include <immintrin.h>
+	#define FZN_BATCH_AVX
+	#define FZN_BATCH_SSE2								//Used for the colors, AVX only having float operations on 256 bits
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#include <emmintrin.h>
+	#define FZN_BATCH_SSE2
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+	#include <arm_neon.h>
+	#define FZN_BATCH_NEON
+#endif
+
+
+namespace fzn
+{
+	namespace Math
+	{
+		namespace
+		{
+			static_assert( sizeof( sf::Color ) == 4, "The colors are processed as arrays of bytes." );
+
+			/////////////////LANES/////////////////
+
+			//Operations on a register of floats, the kernels are written once for all of them.
+			struct ScalarLanes
+			{
+				typedef float Type;
+				static constexpr int Size = 1;
+
+				static Type Load( const float* _pValues )				{ return *_pValues; }
+				static void Store( float* _pValues, Type _oValue )		{ *_pValues = _oValue; }
+				static Type Set( float _fValue )						{ return _fValue; }
+				static Type Add( Type _oA, Type _oB )					{ return _oA + _oB; }
+				static Type Sub( Type _oA, Type _oB )					{ return _oA - _oB; }
+				static Type Mul( Type _oA, Type _oB )					{ return _oA * _oB; }
+				static Type Div( Type _oA, Type _oB )					{ return _oA / _oB; }
+				static Type Max( Type _oA, Type _oB )					{ return _oA > _oB ? _oA : _oB; }
+				static Type Sqrt( Type _oValue )						{ return std::sqrt( _oValue ); }
+			};
+
+#if defined( FZN_BATCH_AVX )
+			struct SimdLanes
+			{
+				typedef __m256 Type;
+				static constexpr int Size = 8;
+
+				static Type Load( const float* _pValues )				{ return _mm256_loadu_ps( _pValues ); }
+				static void Store( float* _pValues, Type _oValue )		{ _mm256_storeu_ps( _pValues, _oValue ); }
+				static Type Set( float _fValue )						{ return _mm256_set1_ps( _fValue ); }
+				static Type Add( Type _oA, Type _oB )					{ return _mm256_add_ps( _oA, _oB ); }
+				static Type Sub( Type _oA, Type _oB )					{ return _mm256_sub_ps( _oA, _oB ); }
+				static Type Mul( Type _oA, Type _oB )					{ return _mm256_mul_ps( _oA, _oB ); }
+				static Type Div( Type _oA, Type _oB )					{ return _mm256_div_ps( _oA, _oB ); }
+				static Type Max( Type _oA, Type _oB )					{ return _mm256_max_ps( _oA, _oB ); }
+				static Type Sqrt( Type _oValue )						{ return _mm256_sqrt_ps( _oValue ); }
+			};
+#elif defined( FZN_BATCH_SSE2 )
+			struct SimdLanes
+			{
+				typedef __m128 Type;
+				static constexpr int Size = 4;
+
+				static Type Load( const float* _pValues )				{ return _mm_loadu_ps( _pValues ); }
+				static void Store( float* _pValues, Type _oValue )		{ _mm_storeu_ps( _pValues, _oValue ); }
+				static Type Set( float _fValue )						{ return _mm_set1_ps( _fValue ); }
+				static Type Add( Type _oA, Type _oB )					{ return _mm_add_ps( _oA, _oB ); }
+				static Type Sub( Type _oA, Type _oB )					{ return _mm_sub_ps( _oA, _oB ); }
+				static Type Mul( Type _oA, Type _oB )					{ return _mm_mul_ps( _oA, _oB ); }
+				static Type Div( Type _oA, Type _oB )					{ return _mm_div_ps( _oA, _oB ); }
+				static Type Max( Type _oA, Type _oB )					{ return _mm_max_ps( _oA, _oB ); }
+				static Type Sqrt( Type _oValue )						{ return _mm_sqrt_ps( _oValue ); }
+			};
+#elif defined( FZN_BATCH_NEON )
+			struct SimdLanes
+			{
+				typedef float32x4_t Type;
+				static constexpr int Size = 4;
+
+				static Type Load( const float* _pValues )				{ return vld1q_f32( _pValues ); }
+				static void Store( float* _pValues, Type _oValue )		{ vst1q_f32( _pValues, _oValue ); }
+				static Type Set( float _fValue )						{ return vdupq_n_f32( _fValue ); }
+				static Type Add( Type _oA, Type _oB )					{ return vaddq_f32( _oA, _oB ); }
+				static Type Sub( Type _oA, Type _oB )					{ return vsubq_f32( _oA, _oB ); }
+				static Type Mul( Type _oA, Type _oB )					{ return vmulq_f32( _oA, _oB ); }
+				static Type Div( Type _oA, Type _oB )					{ return vdivq_f32( _oA, _oB ); }
+				static Type Max( Type _oA, Type _oB )					{ return vmaxq_f32( _oA, _oB ); }
+				static Type Sqrt( Type _oValue )						{ return vsqrtq_f32( _oValue ); }
+			};
+#else
+			typedef ScalarLanes SimdLanes;
+#endif
+
+
+			/////////////////KERNELS/////////////////
+
+			//Each float kernel processes the values from _iStart by packs of Lanes::Size and returns the index of the first value it couldn't process.
+			template< class Lanes >
+			int LerpKernel( const float* _pFrom, const float* _pTo, float _fRatio, float* _pOut, int _iStart, int _iCount )
+			{
+				const typename Lanes::Type oRatio = Lanes::Set( _fRatio );
+				int iValue = _iStart;
+
+				for( ; iValue + Lanes::Size <= _iCount ; iValue += Lanes::Size )
+				{
+					const typename Lanes::Type oFrom = Lanes::Load( _pFrom + iValue );
+					Lanes::Store( _pOut + iValue, Lanes::Add( oFrom, Lanes::Mul( Lanes::Sub( Lanes::Load( _pTo + iValue ), oFrom ), oRatio ) ) );
+				}
+
+				return iValue;
+			}
+
+			template< class Lanes >
+			int LerpRatiosKernel( const float* _pFrom, const float* _pTo, const float* _pRatios, float* _pOut, int _iStart, int _iCount )
+			{
+				int iValue = _iStart;
+
+				for( ; iValue + Lanes::Size <= _iCount ; iValue += Lanes::Size )
+				{
+					const typename Lanes::Type oFrom = Lanes::Load( _pFrom + iValue );
+					Lanes::Store( _pOut + iValue, Lanes::Add( oFrom, Lanes::Mul( Lanes::Sub( Lanes::Load( _pTo + iValue ), oFrom ), Lanes::Load( _pRatios + iValue ) ) ) );
+				}
+
+				return iValue;
+			}
+
+			template< class Lanes >
+			int LengthKernel( const float* _pX, const float* _pY, float* _pOut, int _iStart, int _iCount )
+			{
+				int iVector = _iStart;
+
+				for( ; iVector + Lanes::Size <= _iCount ; iVector += Lanes::Size )
+				{
+					const typename Lanes::Type oX = Lanes::Load( _pX + iVector );
+					const typename Lanes::Type oY = Lanes::Load( _pY + iVector );
+					Lanes::Store( _pOut + iVector, Lanes::Sqrt( Lanes::Add( Lanes::Mul( oX, oX ), Lanes::Mul( oY, oY ) ) ) );
+				}
+
+				return iVector;
+			}
+
+			template< class Lanes >
+			int NormalizeKernel( float* _pX, float* _pY, int _iStart, int _iCount )
+			{
+				//Dividing by at least FLT_MIN leaves the null vectors null without a branch.
+				const typename Lanes::Type oMinLength = Lanes::Set( FLT_MIN );
+				int iVector = _iStart;
+
+				for( ; iVector + Lanes::Size <= _iCount ; iVector += Lanes::Size )
+				{
+					const typename Lanes::Type oX = Lanes::Load( _pX + iVector );
+					const typename Lanes::Type oY = Lanes::Load( _pY + iVector );
+					const typename Lanes::Type oLength = Lanes::Max( Lanes::Sqrt( Lanes::Add( Lanes::Mul( oX, oX ), Lanes::Mul( oY, oY ) ) ), oMinLength );
+
+					Lanes::Store( _pX + iVector, Lanes::Div( oX, oLength ) );
+					Lanes::Store( _pY + iVector, Lanes::Div( oY, oLength ) );
+				}
+
+				return iVector;
+			}
+
+			template< class Lanes >
+			int TransformKernel( const float* _pMatrix, const float* _pX, const float* _pY, float* _pOutX, float* _pOutY, int _iStart, int _iCount )
+			{
+				//sf::Transform stores a 4x4 column major matrix, only the 2D affine part is used.
+				const typename Lanes::Type oA = Lanes::Set( _pMatrix[ 0 ] );
+				const typename Lanes::Type oB = Lanes::Set( _pMatrix[ 4 ] );
+				const typename Lanes::Type oC = Lanes::Set( _pMatrix[ 12 ] );
+				const typename Lanes::Type oD = Lanes::Set( _pMatrix[ 1 ] );
+				const typename Lanes::Type oE = Lanes::Set( _pMatrix[ 5 ] );
+				const typename Lanes::Type oF = Lanes::Set( _pMatrix[ 13 ] );
+				int iPoint = _iStart;
+
+				for( ; iPoint + Lanes::Size <= _iCount ; iPoint += Lanes::Size )
+				{
+					const typename Lanes::Type oX = Lanes::Load( _pX + iPoint );
+					const typename Lanes::Type oY = Lanes::Load( _pY + iPoint );
+
+					Lanes::Store( _pOutX + iPoint, Lanes::Add( Lanes::Add( Lanes::Mul( oA, oX ), Lanes::Mul( oB, oY ) ), oC ) );
+					Lanes::Store( _pOutY + iPoint, Lanes::Add( Lanes::Add( Lanes::Mul( oD, oX ), Lanes::Mul( oE, oY ) ), oF ) );
+				}
+
+				return iPoint;
+			}
+
+			//Processes the colors 4 by 4 (16 bytes), each byte being converted to a float.
+			void ColorLerpKernel( const uint8_t* _pFrom, const uint8_t* _pTo, float _fRatio, uint8_t* _pOut, int _iCount )
+			{
+				int iColor = 0;
+
+#if defined( FZN_BATCH_SSE2 )
+				const __m128i oZero = _mm_setzero_si128();
+				const __m128 oRatio = _mm_set1_ps( _fRatio );
+
+				auto Lerp = [&]( __m128i _oFrom, __m128i _oTo ) -> __m128i
+				{
+					const __m128 oFrom = _mm_cvtepi32_ps( _oFrom );
+					return _mm_cvtps_epi32( _mm_add_ps( oFrom, _mm_mul_ps( _mm_sub_ps( _mm_cvtepi32_ps( _oTo ), oFrom ), oRatio ) ) );
+				};
+
+				for( ; iColor + 4 <= _iCount ; iColor += 4 )
+				{
+					const __m128i oFrom = _mm_loadu_si128( reinterpret_cast< const __m128i* >( _pFrom + iColor * 4 ) );
+					const __m128i oTo = _mm_loadu_si128( reinterpret_cast< const __m128i* >( _pTo + iColor * 4 ) );
+					const __m128i oFromLow = _mm_unpacklo_epi8( oFrom, oZero );
+					const __m128i oFromHigh = _mm_unpackhi_epi8( oFrom, oZero );
+					const __m128i oToLow = _mm_unpacklo_epi8( oTo, oZero );
+					const __m128i oToHigh = _mm_unpackhi_epi8( oTo, oZero );
+
+					const __m128i oLow = _mm_packs_epi32( Lerp( _mm_unpacklo_epi16( oFromLow, oZero ), _mm_unpacklo_epi16( oToLow, oZero ) ), Lerp( _mm_unpackhi_epi16( oFromLow, oZero ), _mm_unpackhi_epi16( oToLow, oZero ) ) );
+					const __m128i oHigh = _mm_packs_epi32( Lerp( _mm_unpacklo_epi16( oFromHigh, oZero ), _mm_unpacklo_epi16( oToHigh, oZero ) ), Lerp( _mm_unpackhi_epi16( oFromHigh, oZero ), _mm_unpackhi_epi16( oToHigh, oZero ) ) );
+
+					_mm_storeu_si128( reinterpret_cast< __m128i* >( _pOut + iColor * 4 ), _mm_packus_epi16( oLow, oHigh ) );
+				}
+#elif defined( FZN_BATCH_NEON )
+				const float32x4_t oRatio = vdupq_n_f32( _fRatio );
+
+				auto Lerp = [&]( uint16x4_t _oFrom, uint16x4_t _oTo ) -> uint16x4_t
+				{
+					const float32x4_t oFrom = vcvtq_f32_u32( vmovl_u16( _oFrom ) );
+					return vmovn_u32( vcvtnq_u32_f32( vmlaq_f32( oFrom, vsubq_f32( vcvtq_f32_u32( vmovl_u16( _oTo ) ), oFrom ), oRatio ) ) );
+				};
+
+				for( ; iColor + 4 <= _iCount ; iColor += 4 )
+				{
+					const uint8x16_t oFrom = vld1q_u8( _pFrom + iColor * 4 );
+					const uint8x16_t oTo = vld1q_u8( _pTo + iColor * 4 );
+					const uint16x8_t oFromLow = vmovl_u8( vget_low_u8( oFrom ) );
+					const uint16x8_t oFromHigh = vmovl_u8( vget_high_u8( oFrom ) );
+					const uint16x8_t oToLow = vmovl_u8( vget_low_u8( oTo ) );
+					const uint16x8_t oToHigh = vmovl_u8( vget_high_u8( oTo ) );
+
+					const uint16x8_t oLow = vcombine_u16( Lerp( vget_low_u16( oFromLow ), vget_low_u16( oToLow ) ), Lerp( vget_high_u16( oFromLow ), vget_high_u16( oToLow ) ) );
+					const uint16x8_t oHigh = vcombine_u16( Lerp( vget_low_u16( oFromHigh ), vget_low_u16( oToHigh ) ), Lerp( vget_high_u16( oFromHigh ), vget_high_u16( oToHigh ) ) );
+
+					vst1q_u8( _pOut + iColor * 4, vcombine_u8( vmovn_u16( oLow ), vmovn_u16( oHigh ) ) );
+				}
+#endif
+
+				//Same rounding as the SIMD conversions (to nearest, ties to even).
+				for( int iByte = iColor * 4 ; iByte < _iCount * 4 ; ++iByte )
+					_pOut[ iByte ] = (uint8_t)std::nearbyint( _pFrom[ iByte ] + ( _pTo[ iByte ] - _pFrom[ iByte ] ) * _fRatio );
+			}
+		}
+
+
+		/////////////////BATCH FUNCTIONS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Linear interpolation of arrays of values with the same ratio
+		//Parameter 1 & 2 : Values at ratio 0 and 1
+		//Parameter 3 : Interpolation ratio (not clamped)
+		//Parameter 4 : Interpolated values
+		//Parameter 5 : Number of values
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void BatchLerp( const float* _pFrom, const float* _pTo, float _fRatio, float* _pOut, int _iCount )
+		{
+			const int iDone = LerpKernel< SimdLanes >( _pFrom, _pTo, _fRatio, _pOut, 0, _iCount );
+			LerpKernel< ScalarLanes >( _pFrom, _pTo, _fRatio, _pOut, iDone, _iCount );
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Linear interpolation of arrays of values, each with its own ratio
+		//Parameter 1 & 2 : Values at ratio 0 and 1
+		//Parameter 3 : Interpolation ratios (not clamped)
+		//Parameter 4 : Interpolated values
+		//Parameter 5 : Number of values
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void BatchLerp( const float* _pFrom, const float* _pTo, const float* _pRatios, float* _pOut, int _iCount )
+		{
+			const int iDone = LerpRatiosKernel< SimdLanes >( _pFrom, _pTo, _pRatios, _pOut, 0, _iCount );
+			LerpRatiosKernel< ScalarLanes >( _pFrom, _pTo, _pRatios, _pOut, iDone, _iCount );
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Length of an array of vectors
+		//Parameter 1 & 2 : Coordinates of the vectors
+		//Parameter 3 : Lengths
+		//Parameter 4 : Number of vectors
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void BatchVectorLength( const float* _pX, const float* _pY, float* _pOut, int _iCount )
+		{
+			const int iDone = LengthKernel< SimdLanes >( _pX, _pY, _pOut, 0, _iCount );
+			LengthKernel< ScalarLanes >( _pX, _pY, _pOut, iDone, _iCount );
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Normalisation of an array of vectors, the null vectors stay null (same as VectorNormalize)
+		//Parameter 1 & 2 : Coordinates of the vectors, replaced by the normalized ones
+		//Parameter 3 : Number of vectors
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void BatchVectorNormalize( float* _pX, float* _pY, int _iCount )
+		{
+			const int iDone = NormalizeKernel< SimdLanes >( _pX, _pY, 0, _iCount );
+			NormalizeKernel< ScalarLanes >( _pX, _pY, iDone, _iCount );
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Transformation of an array of points (same as sf::Transform::transformPoint)
+		//Parameter 1 : Transform to apply
+		//Parameter 2 & 3 : Coordinates of the points
+		//Parameter 4 & 5 : Coordinates of the transformed points
+		//Parameter 6 : Number of points
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void BatchTransformPoints( const sf::Transform& _oTransform, const float* _pX, const float* _pY, float* _pOutX, float* _pOutY, int _iCount )
+		{
+			const float* pMatrix = _oTransform.getMatrix();
+
+			const int iDone = TransformKernel< SimdLanes >( pMatrix, _pX, _pY, _pOutX, _pOutY, 0, _iCount );
+			TransformKernel< ScalarLanes >( pMatrix, _pX, _pY, _pOutX, _pOutY, iDone, _iCount );
+		}
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Linear interpolation of an array of colors, rounded to the nearest value
+		//Parameter 1 & 2 : Colors at ratio 0 and 1
+		//Parameter 3 : Interpolation ratio (clamped between 0 and 1)
+		//Parameter 4 : Interpolated colors
+		//Parameter 5 : Number of colors
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void BatchColorLerp( const sf::Color* _pFrom, const sf::Color* _pTo, float _fRatio, sf::Color* _pOut, int _iCount )
+		{
+			ColorLerpKernel( reinterpret_cast< const uint8_t* >( _pFrom ), reinterpret_cast< const uint8_t* >( _pTo ), Clamp( _fRatio, 0.f, 1.f ), reinterpret_cast< uint8_t* >( _pOut ), _iCount );
+		}
+	} //namespace Math
+} //namespace fzn
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Math functions applied to arrays of values at once
+//------------------------------------------------------------------------
+
+#ifndef _MATHBATCH_H_
+#define _MATHBATCH_H_
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+#include "FZN/Defines.h"
+
+
+namespace fzn
+{
+	namespace Math
+	{
+		//The vectors are given as separate arrays of X and Y (structure of arrays), so each instruction processes several vectors.
+		//The arrays don't need any alignment. An output array can be the same as an input one, but not overlap it partially.
+		//The compiler target chooses between AVX, SSE2, NEON or the scalar code, the elements left over are always done by the scalar code.
+		//The x64 builds of the framework are compiled with AVX (/arch:AVX), the Win32 ones with SSE2, so the x64 ones need a processor with AVX.
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Linear interpolation of arrays of values with the same ratio
+		//Parameter 1 & 2 : Values at ratio 0 and 1
+		//Parameter 3 : Interpolation ratio (not clamped)
+		//Parameter 4 : Interpolated values
+		//Parameter 5 : Number of values
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT void BatchLerp( const float* _pFrom, const float* _pTo, float _fRatio, float* _pOut, int _iCount );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Linear interpolation of arrays of values, each with its own ratio
+		//Parameter 1 & 2 : Values at ratio 0 and 1
+		//Parameter 3 : Interpolation ratios (not clamped)
+		//Parameter 4 : Interpolated values
+		//Parameter 5 : Number of values
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT void BatchLerp( const float* _pFrom, const float* _pTo, const float* _pRatios, float* _pOut, int _iCount );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Length of an array of vectors
+		//Parameter 1 & 2 : Coordinates of the vectors
+		//Parameter 3 : Lengths
+		//Parameter 4 : Number of vectors
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT void BatchVectorLength( const float* _pX, const float* _pY, float* _pOut, int _iCount );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Normalisation of an array of vectors, the null vectors stay null (same as VectorNormalize)
+		//Parameter 1 & 2 : Coordinates of the vectors, replaced by the normalized ones
+		//Parameter 3 : Number of vectors
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT void BatchVectorNormalize( float* _pX, float* _pY, int _iCount );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Transformation of an array of points (same as sf::Transform::transformPoint)
+		//Parameter 1 : Transform to apply
+		//Parameter 2 & 3 : Coordinates of the points
+		//Parameter 4 & 5 : Coordinates of the transformed points
+		//Parameter 6 : Number of points
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT void BatchTransformPoints( const sf::Transform& _oTransform, const float* _pX, const float* _pY, float* _pOutX, float* _pOutY, int _iCount );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Linear interpolation of an array of colors, rounded to the nearest value
+		//Parameter 1 & 2 : Colors at ratio 0 and 1
+		//Parameter 3 : Interpolation ratio (clamped between 0 and 1)
+		//Parameter 4 : Interpolated colors
+		//Parameter 5 : Number of colors
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT void BatchColorLerp( const sf::Color* _pFrom, const sf::Color* _pTo, float _fRatio, sf::Color* _pOut, int _iCount );
+	} //namespace Math
+} //namespace fzn
+
+#endif //_MATHBATCH_H_
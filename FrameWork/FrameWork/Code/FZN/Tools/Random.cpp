@@ -1,21 +1,50 @@
+#include <mutex>
+
 #include "FZN/Includes.h"
 #include "FZN/Tools/Random.h"
 
 namespace fzn
 {
+	namespace
+	{
+		//Generator the default ones of the threads are split from, the threads can start at the same time.
+		struct MasterRandom
+		{
+			std::mutex	m_oMutex;
+			Random		m_oRandom;
+		};
+
+		MasterRandom& GetMasterRandom()
+		{
+			static MasterRandom oMaster;
+			return oMaster;
+		}
+
+		Random SplitMasterRandom()
+		{
+			MasterRandom& oMaster = GetMasterRandom();
+			std::lock_guard< std::mutex > oLock( oMaster.m_oMutex );
+
+			return oMaster.m_oRandom.Split();
+		}
+	}
+
 	//-------------------------------------------------------------------------------------------------
-	/// Default constructor.
+	/// Default constructor, seeded with the current time.
 	//-------------------------------------------------------------------------------------------------
-	Random::Random() : m_oRandomEngine( ( sf::Uint32 )time( nullptr ) )
+	Random::Random()
 	{
+		Seed( (uint64_t)time( nullptr ) );
 	}
 
 	//-------------------------------------------------------------------------------------------------
 	/// Constructor.
-	/// @param	_uSeed	: Seed for the random number generation.
+	/// @param	_uSeed		: Seed for the random number generation.
+	/// @param	_uStream	: Identifier of the sequence, two streams with the same seed don't overlap.
 	//-------------------------------------------------------------------------------------------------
-	Random::Random( sf::Uint32 _uSeed ) : m_oRandomEngine( _uSeed )
+	Random::Random( uint64_t _uSeed, uint64_t _uStream /*= 0*/ )
 	{
+		Seed( _uSeed, _uStream );
 	}
 
 	//-------------------------------------------------------------------------------------------------
@@ -25,10 +54,94 @@ namespace fzn
 	{
 	}
 
+	//-------------------------------------------------------------------------------------------------
+	/// Default generator of the calling thread (Rand macros), split from a master generator the first time the thread uses it.
+	//-------------------------------------------------------------------------------------------------
+	Random& Random::GetDefault()
+	{
+		thread_local Random t_oDefault( SplitMasterRandom() );
+		return t_oDefault;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Seeds the master generator and splits the default generator of the calling thread from it again.
+	/// The threads that already have their default generator keep it, the other ones get theirs from the new seed.
+	/// @param	_uSeed	: Seed for the random number generation.
+	//-------------------------------------------------------------------------------------------------
+	void Random::SeedDefault( uint64_t _uSeed )
+	{
+		//Before the lock, the first call of the thread splits the master too.
+		Random& oDefault = GetDefault();
+		MasterRandom& oMaster = GetMasterRandom();
+		std::lock_guard< std::mutex > oLock( oMaster.m_oMutex );
+
+		oMaster.m_oRandom.Seed( _uSeed );
+		oDefault = oMaster.m_oRandom.Split();
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Restarts the generator on a new sequence.
+	/// @param	_uSeed		: Seed for the random number generation.
+	/// @param	_uStream	: Identifier of the sequence.
+	//-------------------------------------------------------------------------------------------------
+	void Random::Seed( uint64_t _uSeed, uint64_t _uStream /*= 0*/ )
+	{
+		//The increment has to be odd, each one gives a different sequence.
+		m_oState.m_uState = 0;
+		m_oState.m_uIncrement = ( _uStream << 1u ) | 1u;
+
+		Next();
+		m_oState.m_uState += _uSeed;
+		Next();
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Creates a generator on another stream, seeded from this one. The sequence of the new generator only depends on the state of this one.
+	//-------------------------------------------------------------------------------------------------
+	Random Random::Split()
+	{
+		//One call per statement, the order of evaluation of the operands would depend on the compiler.
+		uint64_t uSeed = (uint64_t)Next() << 32u;
+		uSeed |= Next();
+
+		uint64_t uStream = (uint64_t)Next() << 32u;
+		uStream |= Next();
+
+		return Random( uSeed, uStream );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Skips values, in logarithmic time in the number of values.
+	/// @param	_uDelta	: Number of values to skip.
+	//-------------------------------------------------------------------------------------------------
+	void Random::Advance( uint64_t _uDelta )
+	{
+		//Applying the step n times is an affine function of the state, built by squaring the one of a single step.
+		uint64_t uStepMultiplier = Multiplier;
+		uint64_t uStepIncrement = m_oState.m_uIncrement;
+		uint64_t uMultiplier = 1u;
+		uint64_t uIncrement = 0u;
+
+		while( _uDelta > 0 )
+		{
+			if( _uDelta & 1u )
+			{
+				uMultiplier *= uStepMultiplier;
+				uIncrement = uIncrement * uStepMultiplier + uStepIncrement;
+			}
+
+			uStepIncrement = ( uStepMultiplier + 1u ) * uStepIncrement;
+			uStepMultiplier *= uStepMultiplier;
+			_uDelta >>= 1u;
+		}
+
+		m_oState.m_uState = uMultiplier * m_oState.m_uState + uIncrement;
+	}
+
 	//-------------------------------------------------------------------------------------------------
 	/// Returns a random value
 	/// @param	_uMinValue	: Minimum random value.
-	/// @param	_uMinValue	: Maximum random value (included).
+	/// @param	_uMaxValue	: Maximum random value (included).
 	//-------------------------------------------------------------------------------------------------
 	sf::Uint32 Random::operator()( sf::Uint32 _uMinValue /*= 0*/, sf::Uint32 _uMaxValue /*= UINT32_MAX*/ )
 	{
@@ -38,14 +151,50 @@ namespace fzn
 	//-------------------------------------------------------------------------------------------------
 	/// Returns a random value
 	/// @param	_uMinValue	: Minimum random value.
-	/// @param	_uMinValue	: Maximum random value (included).
+	/// @param	_uMaxValue	: Maximum random value (included).
 	//-------------------------------------------------------------------------------------------------
 	sf::Uint32 Random::GetValue( sf::Uint32 _uMinValue /*= 0*/, sf::Uint32 _uMaxValue /*= UINT32_MAX*/ )
 	{
-		if( _uMaxValue < UINT32_MAX )
-			_uMaxValue++;
+		if( _uMaxValue <= _uMinValue )
+			return _uMinValue;
+
+		const sf::Uint32 uRange = _uMaxValue - _uMinValue + 1u;
+
+		return _uMinValue + _GetValueInRange( uRange, uRange != 0u ? ( 0u - uRange ) % uRange : 0u );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Returns a random signed value
+	/// @param	_iMinValue	: Minimum random value.
+	/// @param	_iMaxValue	: Maximum random value (included), the minimum is returned if it is lower.
+	//-------------------------------------------------------------------------------------------------
+	int Random::GetInt( int _iMinValue, int _iMaxValue )
+	{
+		if( _iMaxValue <= _iMinValue )
+			return _iMinValue;
+
+		const sf::Uint32 uRange = (sf::Uint32)_iMaxValue - (sf::Uint32)_iMinValue + 1u;
+
+		return (int)( (sf::Uint32)_iMinValue + _GetValueInRange( uRange, uRange != 0u ? ( 0u - uRange ) % uRange : 0u ) );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Returns a random value between 0 (included) and 1 (excluded), on 24 bits.
+	//-------------------------------------------------------------------------------------------------
+	float Random::GetFloat()
+	{
+		//24 bits fit exactly in the mantissa, so every value is representable and 1 can't be reached by rounding.
+		return (float)( Next() >> 8u ) * ( 1.f / 16777216.f );
+	}
 
-		return m_oRandomEngine() % ( _uMaxValue - _uMinValue ) + _uMinValue;
+	//-------------------------------------------------------------------------------------------------
+	/// Returns a random value
+	/// @param	_fMinValue	: Minimum random value (included).
+	/// @param	_fMaxValue	: Maximum random value (excluded).
+	//-------------------------------------------------------------------------------------------------
+	float Random::GetFloat( float _fMinValue, float _fMaxValue )
+	{
+		return _fMinValue + ( _fMaxValue - _fMinValue ) * GetFloat();
 	}
 
 	//-------------------------------------------------------------------------------------------------
@@ -53,6 +202,76 @@ namespace fzn
 	//-------------------------------------------------------------------------------------------------
 	bool Random::GetBool()
 	{
-		return GetValue( 0, 1 ) == 1;
+		//The high bit is the best distributed one.
+		return ( Next() >> 31u ) == 1u;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Fills an array with random values on the whole 32 bits range.
+	/// @param	_pValues	: Array to fill.
+	/// @param	_iCount		: Number of values.
+	//-------------------------------------------------------------------------------------------------
+	void Random::Fill( sf::Uint32* _pValues, int _iCount )
+	{
+		for( int iValue = 0; iValue < _iCount; ++iValue )
+			_pValues[ iValue ] = Next();
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Fills an array with random values, the range is prepared once for all of them.
+	/// @param	_pValues	: Array to fill.
+	/// @param	_iCount		: Number of values.
+	/// @param	_uMinValue	: Minimum random value.
+	/// @param	_uMaxValue	: Maximum random value (included).
+	//-------------------------------------------------------------------------------------------------
+	void Random::Fill( sf::Uint32* _pValues, int _iCount, sf::Uint32 _uMinValue, sf::Uint32 _uMaxValue )
+	{
+		if( _uMaxValue <= _uMinValue )
+		{
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+				_pValues[ iValue ] = _uMinValue;
+
+			return;
+		}
+
+		const sf::Uint32 uRange = _uMaxValue - _uMinValue + 1u;
+		const sf::Uint32 uThreshold = uRange != 0u ? ( 0u - uRange ) % uRange : 0u;
+
+		for( int iValue = 0; iValue < _iCount; ++iValue )
+			_pValues[ iValue ] = _uMinValue + _GetValueInRange( uRange, uThreshold );
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Fills an array with random values.
+	/// @param	_pValues	: Array to fill.
+	/// @param	_iCount		: Number of values.
+	/// @param	_fMinValue	: Minimum random value (included).
+	/// @param	_fMaxValue	: Maximum random value (excluded).
+	//-------------------------------------------------------------------------------------------------
+	void Random::Fill( float* _pValues, int _iCount, float _fMinValue /*= 0.f*/, float _fMaxValue /*= 1.f*/ )
+	{
+		const float fScale = ( _fMaxValue - _fMinValue ) * ( 1.f / 16777216.f );
+
+		for( int iValue = 0; iValue < _iCount; ++iValue )
+			_pValues[ iValue ] = _fMinValue + (float)( Next() >> 8u ) * fScale;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	/// Maps a random value on a range of a given size.
+	/// @param	_uRange		: Number of possible values (0 for the whole 32 bits range).
+	/// @param	_uThreshold	: Rejection threshold of the range (2^32 modulo _uRange).
+	//-------------------------------------------------------------------------------------------------
+	sf::Uint32 Random::_GetValueInRange( sf::Uint32 _uRange, sf::Uint32 _uThreshold )
+	{
+		if( _uRange == 0u )
+			return Next();
+
+		//The high half of the product is the value, the low half tells if it comes from the part of the 32 bits that would favor some values.
+		uint64_t uProduct = (uint64_t)Next() * _uRange;
+
+		while( (sf::Uint32)uProduct < _uThreshold )
+			uProduct = (uint64_t)Next() * _uRange;
+
+		return (sf::Uint32)( uProduct >> 32u );
 	}
 }
@@ -1,46 +1,156 @@
 #ifndef __FZN_RANDOM_H__
 #define __FZN_RANDOM_H__
 
-#include <random>
+#include <cstdint>
+
+#include <SFML/Config.hpp>
+
+#include "FZN/Defines.h"
 
 namespace fzn
 {
+	//-------------------------------------------------------------------------------------------------
+	/// Random number generator (PCG32: 64 bits state, 32 bits output).
+	/// Only integer operations are used, so a seed gives the same sequence on every platform and compiler.
+	/// Each stream identifier gives an independent sequence for the same seed, so each system or thread can have its own generator.
+	/// The ranges are mapped without bias (multiplication and rejection instead of a modulo).
+	//-------------------------------------------------------------------------------------------------
 	class FZN_EXPORT Random
 	{
 	public:
 		//-------------------------------------------------------------------------------------------------
-		/// Default constructor.
+		/// Full state of a generator, to save and restore a sequence (replays).
+		//-------------------------------------------------------------------------------------------------
+		struct State
+		{
+			uint64_t m_uState{ 0 };
+			uint64_t m_uIncrement{ 1 };
+		};
+
+		//-------------------------------------------------------------------------------------------------
+		/// Default constructor, seeded with the current time.
 		//-------------------------------------------------------------------------------------------------
 		Random();
 		//-------------------------------------------------------------------------------------------------
 		/// Constructor.
-		/// @param	_uSeed	: Seed for the random number generation.
+		/// @param	_uSeed		: Seed for the random number generation.
+		/// @param	_uStream	: Identifier of the sequence, two streams with the same seed don't overlap.
 		//-------------------------------------------------------------------------------------------------
-		Random( sf::Uint32 _uSeed );
+		Random( uint64_t _uSeed, uint64_t _uStream = 0 );
 		//-------------------------------------------------------------------------------------------------
 		/// Destructor.
 		//-------------------------------------------------------------------------------------------------
 		~Random();
 
+		//-------------------------------------------------------------------------------------------------
+		/// Default generator of the calling thread (Rand macros), split from a master generator the first time the thread uses it.
+		//-------------------------------------------------------------------------------------------------
+		static Random& GetDefault();
+		//-------------------------------------------------------------------------------------------------
+		/// Seeds the master generator and splits the default generator of the calling thread from it again.
+		/// The threads that already have their default generator keep it, the other ones get theirs from the new seed.
+		/// @param	_uSeed	: Seed for the random number generation.
+		//-------------------------------------------------------------------------------------------------
+		static void SeedDefault( uint64_t _uSeed );
+
+		//-------------------------------------------------------------------------------------------------
+		/// Restarts the generator on a new sequence.
+		/// @param	_uSeed		: Seed for the random number generation.
+		/// @param	_uStream	: Identifier of the sequence.
+		//-------------------------------------------------------------------------------------------------
+		void		Seed( uint64_t _uSeed, uint64_t _uStream = 0 );
+		//-------------------------------------------------------------------------------------------------
+		/// Creates a generator on another stream, seeded from this one. The sequence of the new generator only depends on the state of this one.
+		//-------------------------------------------------------------------------------------------------
+		Random		Split();
+		//-------------------------------------------------------------------------------------------------
+		/// Skips values, in logarithmic time in the number of values.
+		/// @param	_uDelta	: Number of values to skip.
+		//-------------------------------------------------------------------------------------------------
+		void		Advance( uint64_t _uDelta );
+		State		GetState() const { return m_oState; }
+		void		SetState( const State& _oState ) { m_oState = _oState; }
+
+		//-------------------------------------------------------------------------------------------------
+		/// Returns a random value on the whole 32 bits range.
+		//-------------------------------------------------------------------------------------------------
+		sf::Uint32	Next()
+		{
+			const uint64_t uOldState = m_oState.m_uState;
+			m_oState.m_uState = uOldState * Multiplier + m_oState.m_uIncrement;
+
+			const sf::Uint32 uXorShifted = (sf::Uint32)( ( ( uOldState >> 18u ) ^ uOldState ) >> 27u );
+			const sf::Uint32 uRotation = (sf::Uint32)( uOldState >> 59u );
+
+			return ( uXorShifted >> uRotation ) | ( uXorShifted << ( ( 0u - uRotation ) & 31u ) );
+		}
 		//-------------------------------------------------------------------------------------------------
 		/// Returns a random value
 		/// @param	_uMinValue	: Minimum random value.
-		/// @param	_uMinValue	: Maximum random value (included).
+		/// @param	_uMaxValue	: Maximum random value (included).
 		//-------------------------------------------------------------------------------------------------
 		sf::Uint32	operator()( sf::Uint32 _uMinValue = 0, sf::Uint32 _uMaxValue = UINT32_MAX );
 		//-------------------------------------------------------------------------------------------------
 		/// Returns a random value
 		/// @param	_uMinValue	: Minimum random value.
-		/// @param	_uMinValue	: Maximum random value (included).
+		/// @param	_uMaxValue	: Maximum random value (included).
 		//-------------------------------------------------------------------------------------------------
 		sf::Uint32	GetValue( sf::Uint32 _uMinValue = 0, sf::Uint32 _uMaxValue = UINT32_MAX );
 		//-------------------------------------------------------------------------------------------------
+		/// Returns a random signed value
+		/// @param	_iMinValue	: Minimum random value.
+		/// @param	_iMaxValue	: Maximum random value (included), the minimum is returned if it is lower.
+		//-------------------------------------------------------------------------------------------------
+		int			GetInt( int _iMinValue, int _iMaxValue );
+		//-------------------------------------------------------------------------------------------------
+		/// Returns a random value between 0 (included) and 1 (excluded), on 24 bits.
+		//-------------------------------------------------------------------------------------------------
+		float		GetFloat();
+		//-------------------------------------------------------------------------------------------------
+		/// Returns a random value
+		/// @param	_fMinValue	: Minimum random value (included).
+		/// @param	_fMaxValue	: Maximum random value (excluded).
+		//-------------------------------------------------------------------------------------------------
+		float		GetFloat( float _fMinValue, float _fMaxValue );
+		//-------------------------------------------------------------------------------------------------
 		/// Returns true or false.
 		//-------------------------------------------------------------------------------------------------
 		bool		GetBool();
 
+		//-------------------------------------------------------------------------------------------------
+		/// Fills an array with random values on the whole 32 bits range.
+		/// @param	_pValues	: Array to fill.
+		/// @param	_iCount		: Number of values.
+		//-------------------------------------------------------------------------------------------------
+		void		Fill( sf::Uint32* _pValues, int _iCount );
+		//-------------------------------------------------------------------------------------------------
+		/// Fills an array with random values, the range is prepared once for all of them.
+		/// @param	_pValues	: Array to fill.
+		/// @param	_iCount		: Number of values.
+		/// @param	_uMinValue	: Minimum random value.
+		/// @param	_uMaxValue	: Maximum random value (included).
+		//-------------------------------------------------------------------------------------------------
+		void		Fill( sf::Uint32* _pValues, int _iCount, sf::Uint32 _uMinValue, sf::Uint32 _uMaxValue );
+		//-------------------------------------------------------------------------------------------------
+		/// Fills an array with random values.
+		/// @param	_pValues	: Array to fill.
+		/// @param	_iCount		: Number of values.
+		/// @param	_fMinValue	: Minimum random value (included).
+		/// @param	_fMaxValue	: Maximum random value (excluded).
+		//-------------------------------------------------------------------------------------------------
+		void		Fill( float* _pValues, int _iCount, float _fMinValue = 0.f, float _fMaxValue = 1.f );
+
 	private :
-		std::default_random_engine m_oRandomEngine;
+		static constexpr uint64_t Multiplier{ 6364136223846793005ull };
+
+		//-------------------------------------------------------------------------------------------------
+		/// Maps a random value on a range of a given size.
+		/// @param	_uRange		: Number of possible values (0 for the whole 32 bits range).
+		/// @param	_uThreshold	: Rejection threshold of the range (2^32 modulo _uRange).
+		//-------------------------------------------------------------------------------------------------
+		sf::Uint32	_GetValueInRange( sf::Uint32 _uRange, sf::Uint32 _uThreshold );
+
+		State m_oState;
 	};
 }
 
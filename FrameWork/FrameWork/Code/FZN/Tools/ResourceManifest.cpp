@@ -0,0 +1,342 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Compiled version of the resource file (groups, resources and their dependencies)
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#include "FZN/Includes.h"
+#include "FZN/Managers/DataManager.h"
+#include "FZN/Tools/ResourceManifest.h"
+
+
+namespace fzn
+{
+	const char* ResourceManifest::EXTENSION = ".fzrm";
+
+	namespace
+	{
+		struct ManifestStrings
+		{
+			uint32_t Add( const std::string& _sString )
+			{
+				std::unordered_map< std::string, uint32_t >::iterator it = m_oOffsets.find( _sString );
+
+				if( it != m_oOffsets.end() )
+					return it->second;
+
+				const uint32_t uOffset = (uint32_t)m_oBlob.size();
+				m_oBlob.insert( m_oBlob.end(), _sString.begin(), _sString.end() );
+				m_oBlob.push_back( '\0' );
+
+				m_oOffsets[ _sString ] = uOffset;
+				return uOffset;
+			}
+
+			std::vector< char >								m_oBlob;
+			std::unordered_map< std::string, uint32_t >		m_oOffsets;
+		};
+
+		struct ManifestResource
+		{
+			Resource				m_oResource;
+			std::string				m_sGroup{ "" };
+		};
+
+		tinyxml2::XMLError LoadManifestXMLFile( tinyxml2::XMLDocument& _oFile, const std::string& _sPath )
+		{
+			if( g_pFZN_DataMgr != nullptr )
+				return g_pFZN_DataMgr->LoadXMLFile( _oFile, _sPath );
+
+			return _oFile.LoadFile( _sPath.c_str() );
+		}
+
+		//Same traversal as DataManager::_LookForResources.
+		void LookForResources( tinyxml2::XMLNode* _pNode, const std::string& _sCurrentPath, std::vector< ManifestResource >& _oResources )
+		{
+			if( _pNode == nullptr )
+				return;
+
+			for( tinyxml2::XMLNode* pNode = _pNode->FirstChild(); pNode != nullptr; pNode = pNode->NextSibling() )
+			{
+				tinyxml2::XMLElement* pElement = pNode->ToElement();
+
+				if( pElement == nullptr )
+					continue;
+
+				const std::string sPath = _sCurrentPath + Tools::XMLStringAttribute( pElement, "Path" );
+
+				if( strcmp( pElement->Name(), "Folder" ) == 0 )
+				{
+					LookForResources( pNode, sPath, _oResources );
+					continue;
+				}
+
+				ManifestResource oResource;
+				oResource.m_oResource	= { Tools::XMLStringAttribute( pElement, "Name" ), sPath, pElement->Name() };
+				oResource.m_sGroup		= Tools::XMLStringAttribute( pElement, "Group" );
+
+				_oResources.push_back( oResource );
+			}
+		}
+	}
+
+
+	/////////////////COMPILATION/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Parses a resource file and writes the compiled manifest
+	//Parameter 1 : Path to the xml resource file
+	//Parameter 2 : Path to the compiled file (resource file path + EXTENSION if empty)
+	//Return value : The manifest has been written (true) or not
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool ResourceManifest::Compile( const std::string& _sResourceFile, const std::string& _sOutputFile /*= ""*/ )
+	{
+		tinyxml2::XMLDocument resFile;
+
+		if( LoadManifestXMLFile( resFile, _sResourceFile ) )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Failure : %s.", resFile.ErrorStr() );
+			return false;
+		}
+
+		tinyxml2::XMLElement* pResources = resFile.FirstChildElement( "Resources" );
+
+		if( pResources == nullptr )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Failure : \"Resources\" tag not found." );
+			return false;
+		}
+
+		std::vector< ManifestResource > oResources;
+		LookForResources( pResources, Tools::XMLStringAttribute( pResources, "Path" ), oResources );
+
+		//Groups are stored in order of appearance, each one owning a contiguous range of resources. The resources without group come last.
+		StringVector oGroupNames;
+
+		for( const ManifestResource& oResource : oResources )
+		{
+			if( oResource.m_sGroup.empty() == false && std::find( oGroupNames.begin(), oGroupNames.end(), oResource.m_sGroup ) == oGroupNames.end() )
+				oGroupNames.push_back( oResource.m_sGroup );
+		}
+
+		ManifestStrings						oStrings;
+		std::vector< GroupEntry >			oGroups;
+		std::vector< ResourceEntry >		oResourceEntries;
+
+		auto AddResource = [&]( const ManifestResource& _oResource, uint32_t _uGroup )
+		{
+			ResourceEntry oEntry;
+			oEntry.m_uNameHash			= Tools::hash_string( _oResource.m_oResource.m_sName );
+			oEntry.m_uName				= oStrings.Add( _oResource.m_oResource.m_sName );
+			oEntry.m_uPath				= oStrings.Add( _oResource.m_oResource.m_sPath );
+			oEntry.m_uType				= oStrings.Add( _oResource.m_oResource.m_sType );
+			oEntry.m_uGroup				= _uGroup;
+
+			oResourceEntries.push_back( oEntry );
+		};
+
+		for( uint32_t uGroup = 0; uGroup < oGroupNames.size(); ++uGroup )
+		{
+			GroupEntry oGroup;
+			oGroup.m_uNameHash		= Tools::hash_string( oGroupNames[ uGroup ] );
+			oGroup.m_uName			= oStrings.Add( oGroupNames[ uGroup ] );
+			oGroup.m_uFirstResource = (uint32_t)oResourceEntries.size();
+
+			for( const ManifestResource& oResource : oResources )
+			{
+				if( oResource.m_sGroup == oGroupNames[ uGroup ] )
+					AddResource( oResource, uGroup );
+			}
+
+			oGroup.m_uNbResources = (uint32_t)oResourceEntries.size() - oGroup.m_uFirstResource;
+			oGroups.push_back( oGroup );
+		}
+
+		for( const ManifestResource& oResource : oResources )
+		{
+			if( oResource.m_sGroup.empty() )
+				AddResource( oResource, NO_GROUP );
+		}
+
+		Header oHeader;
+		oHeader.m_uVersion			= VERSION;
+		oHeader.m_uNbGroups			= (uint32_t)oGroups.size();
+		oHeader.m_uNbResources		= (uint32_t)oResourceEntries.size();
+		oHeader.m_uStringsSize		= (uint32_t)oStrings.m_oBlob.size();
+
+		const std::string sOutputFile = _sOutputFile.empty() ? _sResourceFile + EXTENSION : _sOutputFile;
+		std::ofstream oFile( sOutputFile, std::ios::binary | std::ios::trunc );
+
+		if( oFile.is_open() == false )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Failure : couldn't open \"%s\".", sOutputFile.c_str() );
+			return false;
+		}
+
+		oFile.write( (const char*)&oHeader, sizeof( Header ) );
+		oFile.write( (const char*)oGroups.data(), oGroups.size() * sizeof( GroupEntry ) );
+		oFile.write( (const char*)oResourceEntries.data(), oResourceEntries.size() * sizeof( ResourceEntry ) );
+		oFile.write( oStrings.m_oBlob.data(), oStrings.m_oBlob.size() );
+
+		FZN_LOG( "Resource manifest \"%s\" compiled: %u groups, %u resources.", sOutputFile.c_str(), oHeader.m_uNbGroups, oHeader.m_uNbResources );
+		return oFile.good();
+	}
+
+
+	/////////////////LOADING/////////////////
+
+	bool ResourceManifest::LoadFromFile( const std::string& _sPath, bool _bCryptedFile )
+	{
+		if( _bCryptedFile )
+		{
+			if( g_pFZN_DataMgr == nullptr )
+				return false;
+
+			return LoadFromMemory( g_pFZN_DataMgr->_DecryptFile( _sPath ) );
+		}
+
+		std::ifstream oFile( _sPath, std::ios::binary );
+
+		if( oFile.is_open() == false )
+			return false;
+
+		return LoadFromMemory( { std::istreambuf_iterator< char >( oFile ), std::istreambuf_iterator< char >() } );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Uses the content of a manifest file, after checking that all its counts and offsets stay in the file
+	//Parameter : Content of the file
+	//Return value : The manifest is valid (true) or has been rejected
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool ResourceManifest::LoadFromMemory( std::vector< unsigned char >&& _oData )
+	{
+		Clear();
+
+		if( _oData.size() < sizeof( Header ) )
+			return false;
+
+		const Header* pHeader = (const Header*)_oData.data();
+
+		if( memcmp( pHeader->m_aMagic, Header().m_aMagic, sizeof( Header::m_aMagic ) ) != 0 || pHeader->m_uVersion != VERSION )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Failure : invalid resource manifest (version %u, expected %u).", pHeader->m_uVersion, VERSION );
+			return false;
+		}
+
+		//Computed on 64 bits so huge counts can't wrap around to the size of the file.
+		const uint64_t uExpectedSize = sizeof( Header ) + (uint64_t)pHeader->m_uNbGroups * sizeof( GroupEntry ) + (uint64_t)pHeader->m_uNbResources * sizeof( ResourceEntry ) + pHeader->m_uStringsSize;
+
+		if( (uint64_t)_oData.size() != uExpectedSize )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Failure : truncated resource manifest." );
+			return false;
+		}
+
+		const unsigned char* pCursor = _oData.data() + sizeof( Header );
+		const GroupEntry* pGroups = (const GroupEntry*)pCursor;				pCursor += pHeader->m_uNbGroups * sizeof( GroupEntry );
+		const ResourceEntry* pResources = (const ResourceEntry*)pCursor;	pCursor += pHeader->m_uNbResources * sizeof( ResourceEntry );
+		const char* pStrings = (const char*)pCursor;
+
+		//Each string has to start in the blob, which has to end with a terminator so none of them can be read past it.
+		const uint32_t uStringsSize = pHeader->m_uStringsSize;
+		auto IsValidString = [uStringsSize]( uint32_t _uOffset ) { return _uOffset < uStringsSize; };
+		bool bValid = uStringsSize == 0 || pStrings[ uStringsSize - 1 ] == '\0';
+
+		for( uint32_t uGroup = 0; bValid && uGroup < pHeader->m_uNbGroups; ++uGroup )
+		{
+			const GroupEntry& oGroup = pGroups[ uGroup ];
+			bValid = IsValidString( oGroup.m_uName ) && oGroup.m_uFirstResource <= pHeader->m_uNbResources && oGroup.m_uNbResources <= pHeader->m_uNbResources - oGroup.m_uFirstResource;
+		}
+
+		for( uint32_t uResource = 0; bValid && uResource < pHeader->m_uNbResources; ++uResource )
+		{
+			const ResourceEntry& oResource = pResources[ uResource ];
+			bValid = IsValidString( oResource.m_uName ) && IsValidString( oResource.m_uPath ) && IsValidString( oResource.m_uType ) && ( oResource.m_uGroup == NO_GROUP || oResource.m_uGroup < pHeader->m_uNbGroups );
+		}
+
+		if( bValid == false )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Failure : corrupted resource manifest (invalid index or string offset)." );
+			return false;
+		}
+
+		m_oData = std::move( _oData );
+
+		//Moving the vector keeps its buffer, the pointers computed on it stay valid.
+		m_pHeader		= (const Header*)m_oData.data();
+		m_pGroups		= pGroups;
+		m_pResources	= pResources;
+		m_pStrings		= pStrings;
+
+		return true;
+	}
+
+	void ResourceManifest::Clear()
+	{
+		m_oData.clear();
+		m_pHeader		= nullptr;
+		m_pGroups		= nullptr;
+		m_pResources	= nullptr;
+		m_pStrings		= nullptr;
+	}
+
+	bool ResourceManifest::IsLoaded() const
+	{
+		return m_pHeader != nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Checks that the resource file hasn't been modified since the manifest has been written
+	//Parameter 1 : Path to the xml resource file
+	//Parameter 2 : Path to the compiled file
+	//Return value : The manifest can be used (true) or has to be compiled again
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	bool ResourceManifest::IsUpToDate( const std::string& _sResourceFile, const std::string& _sManifestFile ) const
+	{
+		if( IsLoaded() == false || std::filesystem::exists( _sManifestFile ) == false )
+			return false;
+
+		const std::filesystem::file_time_type oManifestTime = std::filesystem::last_write_time( _sManifestFile );
+
+		//A missing resource file doesn't invalidate the manifest, it is all that is left of it (crypted or packed data).
+		std::error_code oError;
+		const std::filesystem::file_time_type oResourceFileTime = std::filesystem::last_write_time( _sResourceFile, oError );
+
+		if( !oError && oResourceFileTime > oManifestTime )
+			return false;
+
+		return true;
+	}
+
+
+	/////////////////ACCESSORS/////////////////
+
+	uint32_t ResourceManifest::GetNbGroups() const
+	{
+		return m_pHeader != nullptr ? m_pHeader->m_uNbGroups : 0;
+	}
+
+	const ResourceManifest::GroupEntry& ResourceManifest::GetGroup( uint32_t _uIndex ) const
+	{
+		return m_pGroups[ _uIndex ];
+	}
+
+	uint32_t ResourceManifest::GetNbResources() const
+	{
+		return m_pHeader != nullptr ? m_pHeader->m_uNbResources : 0;
+	}
+
+	const ResourceManifest::ResourceEntry& ResourceManifest::GetResource( uint32_t _uIndex ) const
+	{
+		return m_pResources[ _uIndex ];
+	}
+
+	const char* ResourceManifest::GetString( uint32_t _uOffset ) const
+	{
+		return m_pStrings + _uOffset;
+	}
+} //namespace fzn
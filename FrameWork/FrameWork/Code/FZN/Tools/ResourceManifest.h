@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Compiled version of the resource file (groups, resources and their dependencies)
+//------------------------------------------------------------------------
+
+#ifndef _RESOURCEMANIFEST_H_
+#define _RESOURCEMANIFEST_H_
+
+#include <string>
+#include <vector>
+
+#include "FZN/Defines.h"
+
+
+namespace fzn
+{
+	//=========================================================
+	//===================ResourceManifest=======================
+	//=========================================================
+
+	//Binary file made of a header, the groups, the resources and a strings blob.
+	//All the names are hashed at compilation (Tools::hash_string) and all the strings are stored as offsets in the blob, checked when the file is loaded.
+	class FZN_EXPORT ResourceManifest
+	{
+	public:
+		struct Header
+		{
+			char		m_aMagic[ 4 ]{ 'F', 'Z', 'R', 'M' };
+			uint32_t	m_uVersion{ 0 };
+			uint32_t	m_uNbGroups{ 0 };
+			uint32_t	m_uNbResources{ 0 };
+			uint32_t	m_uStringsSize{ 0 };
+		};
+
+		struct GroupEntry
+		{
+			uint32_t	m_uNameHash{ 0 };
+			uint32_t	m_uName{ 0 };					//Offset of the name in the strings blob
+			uint32_t	m_uFirstResource{ 0 };
+			uint32_t	m_uNbResources{ 0 };
+		};
+
+		struct ResourceEntry
+		{
+			uint32_t	m_uNameHash{ 0 };
+			uint32_t	m_uName{ 0 };
+			uint32_t	m_uPath{ 0 };
+			uint32_t	m_uType{ 0 };					//Resource type as written in the resource file (Picture, Anm2, Sound...)
+			uint32_t	m_uGroup{ NO_GROUP };			//Index of the group, NO_GROUP for the resources loaded with the resource file
+		};
+
+		static constexpr uint32_t	VERSION{ 2 };
+		static constexpr uint32_t	NO_GROUP{ Uint32_Max };
+		static const char*			EXTENSION;
+
+		/////////////////COMPILATION/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Parses a resource file and writes the compiled manifest
+		//Parameter 1 : Path to the xml resource file
+		//Parameter 2 : Path to the compiled file (resource file path + EXTENSION if empty)
+		//Return value : The manifest has been written (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static bool					Compile( const std::string& _sResourceFile, const std::string& _sOutputFile = "" );
+
+
+		/////////////////LOADING/////////////////
+
+		bool						LoadFromFile( const std::string& _sPath, bool _bCryptedFile );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Uses the content of a manifest file, after checking that all its counts and offsets stay in the file
+		//Parameter : Content of the file
+		//Return value : The manifest is valid (true) or has been rejected
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool						LoadFromMemory( std::vector< unsigned char >&& _oData );
+		void						Clear();
+		bool						IsLoaded() const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Checks that the resource file hasn't been modified since the manifest has been written
+		//Parameter 1 : Path to the xml resource file
+		//Parameter 2 : Path to the compiled file
+		//Return value : The manifest can be used (true) or has to be compiled again
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool						IsUpToDate( const std::string& _sResourceFile, const std::string& _sManifestFile ) const;
+
+
+		/////////////////ACCESSORS/////////////////
+
+		uint32_t					GetNbGroups() const;
+		const GroupEntry&			GetGroup( uint32_t _uIndex ) const;
+		uint32_t					GetNbResources() const;
+		const ResourceEntry&		GetResource( uint32_t _uIndex ) const;
+		const char*					GetString( uint32_t _uOffset ) const;
+
+	private:
+		std::vector< unsigned char >	m_oData;
+		const Header*					m_pHeader{ nullptr };
+		const GroupEntry*				m_pGroups{ nullptr };
+		const ResourceEntry*			m_pResources{ nullptr };
+		const char*						m_pStrings{ nullptr };
+	};
+} //namespace fzn
+
+#endif //_RESOURCEMANIFEST_H_
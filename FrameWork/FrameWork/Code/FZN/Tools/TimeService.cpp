@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Frame times of the application, read by the engine components instead of their own clocks
+//------------------------------------------------------------------------
+
+#include <chrono>
+
+#include "FZN/Includes.h"
+#include "FZN/Tools/TimeService.h"
+
+
+namespace fzn
+{
+	/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Default constructor
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	TimeService::TimeService()
+	{
+		m_uStartTime = GetMonotonicTime();
+		m_uLastFrameTime = m_uStartTime;
+	}
+
+
+	/////////////////FRAME MANAGEMENT/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Advances all the domains by the time elapsed since the previous frame (or the fixed step if there is one)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void TimeService::BeginFrame()
+	{
+		const uint64_t uTime = GetMonotonicTime();
+		const uint64_t uDelta = m_uFixedStep > 0 ? m_uFixedStep : uTime - m_uLastFrameTime;
+
+		m_uLastFrameTime = uTime;
+		Advance( uDelta );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Advances all the domains by a given time, without reading the clock
+	//Parameter : Real time of the frame (nanoseconds)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void TimeService::Advance( uint64_t _uDelta )
+	{
+		++m_uFrame;
+
+		const Domain& oGame = m_oDomains[ (int)TimeDomain::Game ];
+
+		for( int iDomain = 0 ; iDomain < (int)TimeDomain::COUNT ; ++iDomain )
+		{
+			Domain& oDomain = m_oDomains[ iDomain ];
+			uint64_t uDelta = _uDelta;
+
+			if( iDomain != (int)TimeDomain::Real )
+			{
+				const bool bPaused = oDomain.m_bPaused || oGame.m_bPaused;
+				const double dScale = iDomain == (int)TimeDomain::Game ? oDomain.m_fScale : (double)oDomain.m_fScale * oGame.m_fScale;
+
+				uDelta = bPaused ? 0 : (uint64_t)( _uDelta * dScale );
+			}
+
+			oDomain.m_oStep.m_uDelta = uDelta;
+			oDomain.m_oStep.m_uTime += uDelta;
+			oDomain.m_oStep.m_uFrame = m_uFrame;
+		}
+	}
+
+
+	/////////////////ACCESSORS / MUTATORS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Accessor on the real time elapsed since the creation of the service, read from the clock instead of the current frame
+	//Return value : Time in nanoseconds
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	uint64_t TimeService::GetElapsedTime() const
+	{
+		return GetMonotonicTime() - m_uStartTime;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the speed of a domain (the Real domain can't be modified)
+	//Parameter 1 : Domain
+	//Parameter 2 : Scale applied to the real time (positive)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void TimeService::SetScale( TimeDomain _eDomain, float _fScale )
+	{
+		if( _eDomain == TimeDomain::Real || _eDomain >= TimeDomain::COUNT || _fScale < 0.f )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "Invalid time scale %f for domain %d.", _fScale, (int)_eDomain );
+			return;
+		}
+
+		m_oDomains[ (int)_eDomain ].m_fScale = _fScale;
+	}
+
+	float TimeService::GetScale( TimeDomain _eDomain ) const
+	{
+		return m_oDomains[ (int)_eDomain ].m_fScale;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the pause of a domain (the Real domain can't be modified)
+	//Parameter 1 : Domain
+	//Parameter 2 : The domain time stops (true) or goes on
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void TimeService::SetPaused( TimeDomain _eDomain, bool _bPaused )
+	{
+		if( _eDomain == TimeDomain::Real || _eDomain >= TimeDomain::COUNT )
+		{
+			FZN_COLOR_LOG( DBG_MSG_COL_RED, "The time of domain %d can't be paused.", (int)_eDomain );
+			return;
+		}
+
+		m_oDomains[ (int)_eDomain ].m_bPaused = _bPaused;
+	}
+
+	bool TimeService::IsPaused( TimeDomain _eDomain ) const
+	{
+		return m_oDomains[ (int)_eDomain ].m_bPaused;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Mutator on the fixed step, used to get the same times on every run (headless tests, replays)
+	//Parameter : Real time of each frame (nanoseconds, 0 to read the clock)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void TimeService::SetFixedStep( uint64_t _uStep )
+	{
+		m_uFixedStep = _uStep;
+	}
+
+
+	/////////////////STATIC FUNCTIONS/////////////////
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Reads the monotonic clock
+	//Return value : Time in nanoseconds, only meaningful compared to another call
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	uint64_t TimeService::GetMonotonicTime()
+	{
+		return (uint64_t)std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	}
+} //namespace fzn
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Frame times of the application, read by the engine components instead of their own clocks
+//------------------------------------------------------------------------
+
+#ifndef _TIMESERVICE_H_
+#define _TIMESERVICE_H_
+
+#include <cstdint>
+
+#include "FZN/Defines.h"
+
+
+namespace fzn
+{
+	//Each domain has its own scale and pause, the Game one also applying to all the domains but Real.
+	enum class TimeDomain : uint8_t
+	{
+		Real,									//Monotonic time, never scaled nor paused
+		Game,
+		AI,
+		Animation,
+		COUNT,
+	};
+
+	//Time of a domain at the current frame, small enough to be passed by value.
+	struct TimeStep
+	{
+		uint64_t	m_uTime{ 0 };				//Time elapsed in the domain since the creation of the service (nanoseconds)
+		uint64_t	m_uDelta{ 0 };				//Time elapsed in the domain since the previous frame (nanoseconds)
+		uint64_t	m_uFrame{ 0 };
+
+		float	GetDeltaSeconds() const { return m_uDelta * 0.000000001f; }
+		double	GetSeconds() const { return m_uTime * 0.000000001; }
+	};
+
+	class FZN_EXPORT TimeService
+	{
+	public:
+		/////////////////CONSTRUCTOR / DESTRUCTOR/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Default constructor
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		TimeService();
+
+
+		/////////////////FRAME MANAGEMENT/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Advances all the domains by the time elapsed since the previous frame (or the fixed step if there is one)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void BeginFrame();
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Advances all the domains by a given time, without reading the clock
+		//Parameter : Real time of the frame (nanoseconds)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void Advance( uint64_t _uDelta );
+
+
+		/////////////////ACCESSORS / MUTATORS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the time of a domain at the current frame
+		//Parameter : Domain
+		//Return value : Time step of the domain
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		TimeStep GetStep( TimeDomain _eDomain ) const { return m_oDomains[ (int)_eDomain ].m_oStep; }
+		uint64_t GetTime( TimeDomain _eDomain ) const { return m_oDomains[ (int)_eDomain ].m_oStep.m_uTime; }
+		float GetDeltaSeconds( TimeDomain _eDomain ) const { return m_oDomains[ (int)_eDomain ].m_oStep.GetDeltaSeconds(); }
+		uint64_t GetFrame() const { return m_uFrame; }
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Accessor on the real time elapsed since the creation of the service, read from the clock instead of the current frame
+		//Return value : Time in nanoseconds
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		uint64_t GetElapsedTime() const;
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the speed of a domain (the Real domain can't be modified)
+		//Parameter 1 : Domain
+		//Parameter 2 : Scale applied to the real time (positive)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetScale( TimeDomain _eDomain, float _fScale );
+		float GetScale( TimeDomain _eDomain ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the pause of a domain (the Real domain can't be modified)
+		//Parameter 1 : Domain
+		//Parameter 2 : The domain time stops (true) or goes on
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetPaused( TimeDomain _eDomain, bool _bPaused );
+		bool IsPaused( TimeDomain _eDomain ) const;
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Mutator on the fixed step, used to get the same times on every run (headless tests, replays)
+		//Parameter : Real time of each frame (nanoseconds, 0 to read the clock)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		void SetFixedStep( uint64_t _uStep );
+		uint64_t GetFixedStep() const { return m_uFixedStep; }
+
+
+		/////////////////STATIC FUNCTIONS/////////////////
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Reads the monotonic clock
+		//Return value : Time in nanoseconds, only meaningful compared to another call
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		static uint64_t GetMonotonicTime();
+
+	private:
+		struct Domain
+		{
+			TimeStep	m_oStep;
+			float		m_fScale{ 1.f };
+			bool		m_bPaused{ false };
+		};
+
+		Domain		m_oDomains[ (int)TimeDomain::COUNT ];
+		uint64_t	m_uStartTime;						//Monotonic time at the creation of the service
+		uint64_t	m_uLastFrameTime;					//Monotonic time of the previous frame
+		uint64_t	m_uFixedStep{ 0 };
+		uint64_t	m_uFrame{ 0 };
+	};
+} //namespace fzn
+
+#endif //_TIMESERVICE_H_
@@ -166,6 +166,214 @@ namespace fzn
 			_sString = get_upper_string( _sString );
 		}
 
+		uint32_t decode_utf8( std::string_view _text, size_t& _position )
+		{
+			static constexpr uint32_t replacement_character{ 0xFFFD };
+
+			const auto first_byte = static_cast< uint8_t >( _text[ _position ] );
+			uint32_t nb_continuation_bytes{ 0 };
+			uint32_t code_point{ 0 };
+
+			if( first_byte < 0x80 )
+			{
+				++_position;
+				return first_byte;
+			}
+			else if( ( first_byte & 0xE0 ) == 0xC0 )
+			{
+				nb_continuation_bytes = 1;
+				code_point = first_byte & 0x1F;
+			}
+			else if( ( first_byte & 0xF0 ) == 0xE0 )
+			{
+				nb_continuation_bytes = 2;
+				code_point = first_byte & 0x0F;
+			}
+			else if( ( first_byte & 0xF8 ) == 0xF0 )
+			{
+				nb_continuation_bytes = 3;
+				code_point = first_byte & 0x07;
+			}
+			else
+			{
+				++_position;
+				return replacement_character;
+			}
+
+			if( _position + nb_continuation_bytes >= _text.size() )
+			{
+				++_position;
+				return replacement_character;
+			}
+
+			for( uint32_t byte{ 1 }; byte <= nb_continuation_bytes; ++byte )
+			{
+				const auto continuation_byte = static_cast< uint8_t >( _text[ _position + byte ] );
+
+				if( ( continuation_byte & 0xC0 ) != 0x80 )
+				{
+					++_position;
+					return replacement_character;
+				}
+
+				code_point = ( code_point << 6 ) | ( continuation_byte & 0x3F );
+			}
+
+			static constexpr uint32_t min_code_points[ 4 ]{ 0, 0x80, 0x800, 0x10000 };
+
+			// Overlong encodings, surrogates and values out of the Unicode range are rejected.
+			if( code_point < min_code_points[ nb_continuation_bytes ] || code_point > 0x10FFFF || ( code_point >= 0xD800 && code_point <= 0xDFFF ) )
+			{
+				++_position;
+				return replacement_character;
+			}
+
+			_position += nb_continuation_bytes + 1;
+			return code_point;
+		}
+
+		void encode_utf8( uint32_t _code_point, std::string& _output )
+		{
+			if( _code_point < 0x80 )
+				_output.push_back( static_cast< char >( _code_point ) );
+			else if( _code_point < 0x800 )
+			{
+				_output.push_back( static_cast< char >( 0xC0 | ( _code_point >> 6 ) ) );
+				_output.push_back( static_cast< char >( 0x80 | ( _code_point & 0x3F ) ) );
+			}
+			else if( _code_point < 0x10000 )
+			{
+				_output.push_back( static_cast< char >( 0xE0 | ( _code_point >> 12 ) ) );
+				_output.push_back( static_cast< char >( 0x80 | ( ( _code_point >> 6 ) & 0x3F ) ) );
+				_output.push_back( static_cast< char >( 0x80 | ( _code_point & 0x3F ) ) );
+			}
+			else
+			{
+				_output.push_back( static_cast< char >( 0xF0 | ( _code_point >> 18 ) ) );
+				_output.push_back( static_cast< char >( 0x80 | ( ( _code_point >> 12 ) & 0x3F ) ) );
+				_output.push_back( static_cast< char >( 0x80 | ( ( _code_point >> 6 ) & 0x3F ) ) );
+				_output.push_back( static_cast< char >( 0x80 | ( _code_point & 0x3F ) ) );
+			}
+		}
+
+		uint32_t to_lower_code_point( uint32_t _code_point )
+		{
+			if( _code_point < 0x80 )
+				return ( _code_point >= 'A' && _code_point <= 'Z' ) ? _code_point + 0x20 : _code_point;
+
+			// Latin-1 Supplement (0xD7 is the multiplication sign).
+			if( _code_point >= 0xC0 && _code_point <= 0xDE && _code_point != 0xD7 )
+				return _code_point + 0x20;
+
+			// Latin Extended-A, upper and lower cases alternate (except for the dotted and dotless i).
+			if( ( _code_point >= 0x100 && _code_point <= 0x12F ) || ( _code_point >= 0x132 && _code_point <= 0x137 ) || ( _code_point >= 0x14A && _code_point <= 0x177 ) )
+				return _code_point | 1;
+
+			if( _code_point == 0x130 )
+				return 'i';
+
+			if( ( _code_point >= 0x139 && _code_point <= 0x148 ) || ( _code_point >= 0x179 && _code_point <= 0x17E ) )
+				return ( _code_point & 1 ) ? _code_point + 1 : _code_point;
+
+			if( _code_point == 0x178 )
+				return 0xFF;
+
+			// Greek.
+			if( _code_point >= 0x391 && _code_point <= 0x3A9 && _code_point != 0x3A2 )
+				return _code_point + 0x20;
+
+			if( _code_point == 0x386 )
+				return 0x3AC;
+
+			if( _code_point >= 0x388 && _code_point <= 0x38A )
+				return _code_point + 0x25;
+
+			if( _code_point == 0x38C )
+				return 0x3CC;
+
+			if( _code_point == 0x38E || _code_point == 0x38F )
+				return _code_point + 0x3F;
+
+			// Cyrillic.
+			if( _code_point >= 0x400 && _code_point <= 0x40F )
+				return _code_point + 0x50;
+
+			if( _code_point >= 0x410 && _code_point <= 0x42F )
+				return _code_point + 0x20;
+
+			return _code_point;
+		}
+
+		uint32_t to_upper_code_point( uint32_t _code_point )
+		{
+			if( _code_point < 0x80 )
+				return ( _code_point >= 'a' && _code_point <= 'z' ) ? _code_point - 0x20 : _code_point;
+
+			// Latin-1 Supplement (0xF7 is the division sign, 0xDF has no single upper case character).
+			if( _code_point >= 0xE0 && _code_point <= 0xFE && _code_point != 0xF7 )
+				return _code_point - 0x20;
+
+			if( _code_point == 0xFF )
+				return 0x178;
+
+			// Latin Extended-A, upper and lower cases alternate (except for the dotted and dotless i).
+			if( ( _code_point >= 0x100 && _code_point <= 0x12F ) || ( _code_point >= 0x132 && _code_point <= 0x137 ) || ( _code_point >= 0x14A && _code_point <= 0x177 ) )
+				return _code_point & ~1u;
+
+			if( _code_point == 0x131 )
+				return 'I';
+
+			if( ( _code_point >= 0x139 && _code_point <= 0x148 ) || ( _code_point >= 0x179 && _code_point <= 0x17E ) )
+				return ( _code_point & 1 ) ? _code_point : _code_point - 1;
+
+			// Greek, the final sigma (0x3C2) becomes a regular upper case sigma.
+			if( _code_point >= 0x3B1 && _code_point <= 0x3C9 )
+				return _code_point == 0x3C2 ? 0x3A3 : _code_point - 0x20;
+
+			if( _code_point == 0x3AC )
+				return 0x386;
+
+			if( _code_point >= 0x3AD && _code_point <= 0x3AF )
+				return _code_point - 0x25;
+
+			if( _code_point == 0x3CC )
+				return 0x38C;
+
+			if( _code_point == 0x3CD || _code_point == 0x3CE )
+				return _code_point - 0x3F;
+
+			// Cyrillic.
+			if( _code_point >= 0x430 && _code_point <= 0x44F )
+				return _code_point - 0x20;
+
+			if( _code_point >= 0x450 && _code_point <= 0x45F )
+				return _code_point - 0x50;
+
+			return _code_point;
+		}
+
+		std::string get_utf8_lower_string( std::string_view _text )
+		{
+			std::string ret;
+			ret.reserve( _text.size() );
+
+			for( size_t position{ 0 }; position < _text.size(); )
+				encode_utf8( to_lower_code_point( decode_utf8( _text, position ) ), ret );
+
+			return ret;
+		}
+
+		std::string get_utf8_upper_string( std::string_view _text )
+		{
+			std::string ret;
+			ret.reserve( _text.size() );
+
+			for( size_t position{ 0 }; position < _text.size(); )
+				encode_utf8( to_upper_code_point( decode_utf8( _text, position ) ), ret );
+
+			return ret;
+		}
+
 		bool match_filter( std::string_view _filter, std::string_view _text )
 		{
 			if( _filter.empty() )
@@ -532,15 +740,25 @@ namespace fzn
 		{
 			float fRadius = _circle.getRadius();
 
-			sf::Vector2f circle( _circle.getPosition() - _circle.getOrigin() + sf::Vector2f( fRadius, fRadius ) );
+			return CollisionAABBCircle( _rect, _circle.getPosition() - _circle.getOrigin() + sf::Vector2f( fRadius, fRadius ), fRadius );
+		}
 
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Collision test between an AABB (floatRect) and a circle
+		//Parameter 1 : floatRect
+		//Parameter 2 : Center of the circle
+		//Parameter 3 : Radius of the circle
+		//Return value : The two shapes are in collision (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		bool CollisionAABBCircle( const sf::FloatRect& _rect, const sf::Vector2f& _vCirclePos, float _fCircleRadius )
+		{
 			float rectHalfHeight = _rect.height * 0.5f;
 			float rectHalfWidth = _rect.width * 0.5f;
 
-			float circleDistX = fabs( circle.x - ( _rect.left + rectHalfWidth ) );
-			float circleDistY = fabs( circle.y - ( _rect.top + rectHalfHeight ) );
+			float circleDistX = fabs( _vCirclePos.x - ( _rect.left + rectHalfWidth ) );
+			float circleDistY = fabs( _vCirclePos.y - ( _rect.top + rectHalfHeight ) );
 
-			if( circleDistX > ( rectHalfWidth + fRadius ) || circleDistY > ( rectHalfHeight + fRadius ) )
+			if( circleDistX > ( rectHalfWidth + _fCircleRadius ) || circleDistY > ( rectHalfHeight + _fCircleRadius ) )
 				return false;
 
 			if( circleDistX <= rectHalfWidth || circleDistY <= rectHalfHeight )
@@ -548,7 +766,7 @@ namespace fzn
 
 			float fCornerDistSqr = Math::Square( circleDistX - rectHalfWidth ) + Math::Square( circleDistY - rectHalfHeight );
 
-			return fCornerDistSqr <= Math::Square( fRadius );
+			return fCornerDistSqr <= Math::Square( _fCircleRadius );
 		}
 
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
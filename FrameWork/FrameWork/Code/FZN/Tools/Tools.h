@@ -78,6 +78,42 @@ namespace fzn
 		FZN_EXPORT bool			is_number( std::string_view _text );
 		FZN_EXPORT std::vector< int > extract_numbers( std::string_view _text, char _delimiter = ' ' );
 
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Decodes the UTF-8 code point starting at the given position
+		//Parameter 1 : UTF-8 text
+		//Parameter 2 : [in,out] Position of the first byte of the code point, moved after its last byte
+		//Return value : Code point, U+FFFD if the sequence is invalid (the position is then moved by one byte)
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT uint32_t		decode_utf8( std::string_view _text, size_t& _position );
+		FZN_EXPORT void			encode_utf8( uint32_t _code_point, std::string& _output );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Simple case mapping of a code point, covering ASCII, Latin-1, Latin Extended-A, Greek and Cyrillic
+		//Parameter : Code point
+		//Return value : Mapped code point, unchanged if it has no mapping
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT uint32_t		to_lower_code_point( uint32_t _code_point );
+		FZN_EXPORT uint32_t		to_upper_code_point( uint32_t _code_point );
+		FZN_EXPORT std::string	get_utf8_lower_string( std::string_view _text );
+		FZN_EXPORT std::string	get_utf8_upper_string( std::string_view _text );
+
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//FNV-1a hash of a string, stable between runs so it can be stored in compiled data files
+		//Parameter : String to hash
+		//Return value : 32 bits hash
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		constexpr uint32_t hash_string( std::string_view _text )
+		{
+			uint32_t hash{ 2166136261u };
+
+			for( const char character : _text )
+			{
+				hash ^= static_cast< uint8_t >( character );
+				hash *= 16777619u;
+			}
+
+			return hash;
+		}
+
 		/////////////////COLLISION FUNCTIONS/////////////////
 
 		enum class CollisionSide : sf::Int8
@@ -136,6 +172,14 @@ namespace fzn
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		FZN_EXPORT bool CollisionAABBCircle( const sf::FloatRect& _floatRect, const sf::CircleShape& _circle );
 		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		//Collision test between an AABB (floatRect) and a circle
+		//Parameter 1 : floatRect
+		//Parameter 2 : Center of the circle
+		//Parameter 3 : Radius of the circle
+		//Return value : The two shapes are in collision (true) or not
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+		FZN_EXPORT bool CollisionAABBCircle( const sf::FloatRect& _floatRect, const sf::Vector2f& _vCirclePos, float _fCircleRadius );
+		//------------------------------------------------------------------------------------------------------------------------------------------------------------------
 		//Collision test between two AABB (rectangleShape)
 		//Parameters : RectangleShapes
 		//Return value : The two shapes are in collision (true) or not
@@ -0,0 +1,139 @@
+#include <algorithm>
+
+#include "TR/EntriesStats.h"
+
+
+namespace TR
+{
+	/**
+	* @brief Compute all the statistics from scratch.
+	* @param _loc_data The localisation data to analyse.
+	**/
+	void EntriesStats::rebuild( const fzn::Localisation::LocalisationData& _loc_data )
+	{
+		m_missing_translations.clear();
+		m_name_sizes.clear();
+		m_name_sizes_histogram.clear();
+		m_total_missing_translations = 0;
+
+		m_missing_translations.reserve( _loc_data.m_entries.size() );
+		m_name_sizes.reserve( _loc_data.m_entries.size() );
+
+		for( const fzn::Localisation::Entry& entry : _loc_data.m_entries )
+			on_entry_added( entry );
+	}
+
+	/**
+	* @brief Take into account an entry added at the end of the entries.
+	* @param _entry The new entry.
+	**/
+	void EntriesStats::on_entry_added( const fzn::Localisation::Entry& _entry )
+	{
+		const uint32_t nb_missing_translations{ _count_missing_translations( _entry ) };
+
+		m_missing_translations.push_back( nb_missing_translations );
+		m_total_missing_translations += nb_missing_translations;
+
+		m_name_sizes.push_back( _entry.m_name.size() );
+		++m_name_sizes_histogram[ _entry.m_name.size() ];
+	}
+
+	/**
+	* @brief Take into account the removal of an entry.
+	* @param _entry_id The ID the entry had before its removal.
+	**/
+	void EntriesStats::on_entry_removed( uint32_t _entry_id )
+	{
+		if( _entry_id >= m_missing_translations.size() )
+			return;
+
+		m_total_missing_translations -= m_missing_translations[ _entry_id ];
+		_remove_name_size( m_name_sizes[ _entry_id ] );
+
+		m_missing_translations.erase( m_missing_translations.begin() + _entry_id );
+		m_name_sizes.erase( m_name_sizes.begin() + _entry_id );
+	}
+
+	/**
+	* @brief Update the statistics of an entry after its name has been edited.
+	* @param _entry_id The ID of the entry.
+	* @param _entry The entry.
+	**/
+	void EntriesStats::on_name_changed( uint32_t _entry_id, const fzn::Localisation::Entry& _entry )
+	{
+		if( _entry_id >= m_name_sizes.size() || m_name_sizes[ _entry_id ] == _entry.m_name.size() )
+			return;
+
+		_remove_name_size( m_name_sizes[ _entry_id ] );
+
+		m_name_sizes[ _entry_id ] = _entry.m_name.size();
+		++m_name_sizes_histogram[ _entry.m_name.size() ];
+	}
+
+	/**
+	* @brief Update the statistics of an entry after one of its translations has been edited.
+	* @param _entry_id The ID of the entry.
+	* @param _entry The entry.
+	**/
+	void EntriesStats::on_translations_changed( uint32_t _entry_id, const fzn::Localisation::Entry& _entry )
+	{
+		if( _entry_id >= m_missing_translations.size() )
+			return;
+
+		const uint32_t nb_missing_translations{ _count_missing_translations( _entry ) };
+
+		m_total_missing_translations -= m_missing_translations[ _entry_id ];
+		m_total_missing_translations += nb_missing_translations;
+		m_missing_translations[ _entry_id ] = nb_missing_translations;
+	}
+
+	/**
+	* @brief Get the number of empty translations of an entry.
+	* @param _entry_id The ID of the entry.
+	* @return Number of missing translations.
+	**/
+	uint32_t EntriesStats::get_nb_missing_translations( uint32_t _entry_id ) const
+	{
+		if( _entry_id >= m_missing_translations.size() )
+			return 0;
+
+		return m_missing_translations[ _entry_id ];
+	}
+
+	/**
+	* @brief Get the number of characters of the longest entry name.
+	* @return Size of the longest name.
+	**/
+	size_t EntriesStats::get_max_name_size() const
+	{
+		if( m_name_sizes_histogram.empty() )
+			return 0;
+
+		return m_name_sizes_histogram.rbegin()->first;
+	}
+
+	/**
+	* @brief Count the empty translations of an entry.
+	* @param _entry The entry.
+	* @return Number of missing translations.
+	**/
+	uint32_t EntriesStats::_count_missing_translations( const fzn::Localisation::Entry& _entry )
+	{
+		return static_cast< uint32_t >( std::ranges::count_if( _entry.m_translations, []( const std::string& _translation ) { return _translation.empty(); } ) );
+	}
+
+	/**
+	* @brief Remove a name size from the sizes histogram.
+	* @param _name_size The size to remove.
+	**/
+	void EntriesStats::_remove_name_size( size_t _name_size )
+	{
+		auto it_size = m_name_sizes_histogram.find( _name_size );
+
+		if( it_size == m_name_sizes_histogram.end() )
+			return;
+
+		if( --it_size->second == 0 )
+			m_name_sizes_histogram.erase( it_size );
+	}
+}
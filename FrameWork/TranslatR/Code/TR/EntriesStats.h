@@ -0,0 +1,87 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <FZN/Managers/LocalisationManager.h>
+
+
+namespace TR
+{
+	/************************************************************************
+	* @brief Statistics about the entries needed every frame by the interface (missing translations, longest name).
+	* They are updated on each edit so their cost doesn't depend on the number of entries.
+	************************************************************************/
+	class EntriesStats
+	{
+	public:
+		/**
+		* @brief Compute all the statistics from scratch.
+		* @param _loc_data The localisation data to analyse.
+		**/
+		void rebuild( const fzn::Localisation::LocalisationData& _loc_data );
+
+		/**
+		* @brief Take into account an entry added at the end of the entries.
+		* @param _entry The new entry.
+		**/
+		void on_entry_added( const fzn::Localisation::Entry& _entry );
+		/**
+		* @brief Take into account the removal of an entry.
+		* @param _entry_id The ID the entry had before its removal.
+		**/
+		void on_entry_removed( uint32_t _entry_id );
+		/**
+		* @brief Update the statistics of an entry after its name has been edited.
+		* @param _entry_id The ID of the entry.
+		* @param _entry The entry.
+		**/
+		void on_name_changed( uint32_t _entry_id, const fzn::Localisation::Entry& _entry );
+		/**
+		* @brief Update the statistics of an entry after one of its translations has been edited.
+		* @param _entry_id The ID of the entry.
+		* @param _entry The entry.
+		**/
+		void on_translations_changed( uint32_t _entry_id, const fzn::Localisation::Entry& _entry );
+
+		/**
+		* @brief Get the number of entries the statistics are about.
+		* @return Number of entries.
+		**/
+		size_t get_nb_entries() const { return m_missing_translations.size(); }
+		/**
+		* @brief Get the number of empty translations of an entry.
+		* @param _entry_id The ID of the entry.
+		* @return Number of missing translations.
+		**/
+		uint32_t get_nb_missing_translations( uint32_t _entry_id ) const;
+		/**
+		* @brief Get the number of empty translations in all the entries.
+		* @return Number of missing translations.
+		**/
+		uint32_t get_total_missing_translations() const { return m_total_missing_translations; }
+		/**
+		* @brief Get the number of characters of the longest entry name.
+		* @return Size of the longest name.
+		**/
+		size_t get_max_name_size() const;
+
+	private:
+		/**
+		* @brief Count the empty translations of an entry.
+		* @param _entry The entry.
+		* @return Number of missing translations.
+		**/
+		static uint32_t _count_missing_translations( const fzn::Localisation::Entry& _entry );
+		/**
+		* @brief Remove a name size from the sizes histogram.
+		* @param _name_size The size to remove.
+		**/
+		void _remove_name_size( size_t _name_size );
+
+		std::vector< uint32_t >		m_missing_translations{};			// Number of empty translations of each entry.
+		std::vector< size_t >		m_name_sizes{};						// Name size of each entry.
+		std::map< size_t, uint32_t >	m_name_sizes_histogram{};		// Number of entries for each name size, the last one being the longest name.
+		uint32_t					m_total_missing_translations{ 0 };
+	};
+}
@@ -1,6 +1,9 @@
 #include <algorithm>
+#include <filesystem>
+#include <utility>
 
 #include <FZN/Managers/FazonCore.h>
+#include <FZN/Tools/Logging.h>
 #include <FZN/Tools/Tools.h>
 #include <FZN/Tools/Event.h>
 
@@ -10,7 +13,6 @@
 namespace TR
 {
 	static const std::string recent_paths_file{ "recent_paths.json" };
-	static const std::string enum_file_message{ "// This file is generated by the TranslatR application. Do not edit it directly or modification will be overwritten!" };
 
 
 	/************************************************************************
@@ -115,6 +117,21 @@ namespace TR
 				ImGui::EndMenu();
 			}
 
+			/************************************************************************
+			* Compiled entries
+			************************************************************************/
+			if( ImGui::BeginMenu( "Compiled Entries", has_entries ) )
+			{
+				if( ImGui_fzn::colored_menu_item( ImGui_fzn::color::dark_green, "Export", {}, false, m_project.m_compiled_entries_path.size() > 0 ) )
+					export_compiled_entries( _loc_data );
+				ImGui_fzn::simple_tooltip_on_hover( "Compiled entries path: %s", m_project.m_compiled_entries_path.c_str() );
+
+				if( ImGui_fzn::colored_menu_item( ImGui_fzn::color::dark_green, "Export As..." ) )
+					export_compiled_entries_as( _loc_data );
+
+				ImGui::EndMenu();
+			}
+
 			/************************************************************************
 			* Enum files
 			************************************************************************/
@@ -187,6 +204,7 @@ namespace TR
 
 		root[ "entries_path" ] = m_project.m_entries_path.c_str();
 		root[ "enum_file_path" ] = m_project.m_enum_file_path.c_str();
+		root[ "compiled_entries_path" ] = m_project.m_compiled_entries_path.c_str();
 
 		writer->write( root, &file );
 		_add_recent_path( FileType::project, m_project.m_project_path );
@@ -214,6 +232,7 @@ namespace TR
 	{
 		m_project.clear();
 		_loc_data.clear();
+		m_data_reloaded = true;
 		_set_window_title_from_project();
 	}
 
@@ -238,7 +257,7 @@ namespace TR
 	}
 
 	/**
-	* @brief Save the given localisation data to the previously selected path.
+	* @brief Save the given localisation data to the previously selected path. The file is written on a worker thread from a copy of the data.
 	* @param [out] _loc_data The localisation data to be saved.
 	**/
 	void FileManager::save_entries( fzn::Localisation::LocalisationData& _loc_data )
@@ -246,14 +265,7 @@ namespace TR
 		if( m_project.m_entries_path.empty() )
 			return;
 
-		auto file = std::ofstream{ m_project.m_entries_path };
-		auto root = Json::Value{};
-
-		Json::StyledWriter json_writer;
-
-		_write_languages( root, _loc_data );
-		_write_entries( root, _loc_data );
-		file << json_writer.write( root );
+		m_save_worker.save_entries( m_project.m_entries_path, m_save_worker.take_snapshot( _loc_data ) );
 
 		_add_recent_path( FileType::entries, m_project.m_entries_path );
 	}
@@ -281,6 +293,39 @@ namespace TR
 	{
 		_loc_data.clear();
 		m_project.m_entries_path.clear();
+		m_data_reloaded = true;
+	}
+
+
+	/************************************************************************
+	* COMPILED ENTRIES
+	************************************************************************/
+
+	/**
+	* @brief Export the given localisation data in the compiled format to the previously selected path.
+	* @param _loc_data The localisation data to be exported.
+	**/
+	void FileManager::export_compiled_entries( const fzn::Localisation::LocalisationData& _loc_data )
+	{
+		if( m_project.m_compiled_entries_path.empty() || _loc_data.m_entries.empty() )
+			return;
+
+		fzn::Localisation::Manager::save_compiled_entries( m_project.m_compiled_entries_path, _loc_data );
+	}
+
+	/**
+	* @brief Show a save file dialog to select where to export the given localisation data in the compiled format.
+	* @param _loc_data The localisation data to be exported.
+	**/
+	void FileManager::export_compiled_entries_as( const fzn::Localisation::LocalisationData& _loc_data )
+	{
+		std::string new_path = fzn::Tools::save_file_as( "(*.trloc) Compiled Localisation\0*.trloc\0 (*.*) All files \0*.*\0", fzn::Localisation::Compiled::extension, "Export Compiled Entries As" );
+
+		if( new_path.empty() )
+			return;
+
+		m_project.m_compiled_entries_path = new_path;
+		export_compiled_entries( _loc_data );
 	}
 
 
@@ -290,6 +335,7 @@ namespace TR
 
 	/**
 	* @brief Generate the enum file using the given localisation data to the previously selected path.
+	* The file is written on a worker thread, and only if the languages or entries changed since its last generation so the projects including it aren't rebuilt for nothing.
 	* @param [out] _loc_data The localisation data to be used.
 	**/
 	void FileManager::generate_enum_file( fzn::Localisation::LocalisationData& _loc_data )
@@ -297,32 +343,27 @@ namespace TR
 		if( m_project.m_enum_file_path.empty() || _loc_data.m_entries.empty() )
 			return;
 
-		std::ofstream output( m_project.m_enum_file_path );
+		const uint32_t signature{ _get_enum_file_signature( _loc_data ) };
+		std::error_code error;
 
-		output << "#pragma once\n\n" << enum_file_message << "\n\nenum class Language\n{\n";
+		// The written files are retrieved after checking the worker is idle, so the last generation is known whether it succeeded or failed.
+		const bool saving{ m_save_worker.is_busy() };
 
-		for( const std::string& language : _loc_data.m_languages )
+		for( const SaveWorker::GeneratedFile& generated_file : m_save_worker.pop_generated_enum_files() )
 		{
-			output << "\t" << language << "," << std::endl;
+			m_enum_file_generated_path = generated_file.m_path;
+			m_enum_file_signature = generated_file.m_signature;
 		}
 
-		output << "\tCOUNT\n};";
-
-		output << "\n\nenum class LocID\n{\n";
-
-		for( const fzn::Localisation::Entry& entry : _loc_data.m_entries )
+		if( saving == false && signature == m_enum_file_signature && m_project.m_enum_file_path == m_enum_file_generated_path && std::filesystem::exists( m_project.m_enum_file_path, error ) )
 		{
-			output << "\t" << entry.m_name << ",";
-
-			if( entry.m_translations.front().empty() == false )
-				output << "\t\t// " << entry.m_translations.front() << std::endl;
-			else
-				output << std::endl;
+			FZN_DBLOG( "'%s' is up to date.", m_project.m_enum_file_path.c_str() );
+			_add_recent_path( FileType::enum_file, m_project.m_enum_file_path );
+			return;
 		}
 
-		output << "\tCOUNT\n};\n";
+		m_save_worker.generate_enum_file( m_project.m_enum_file_path, m_save_worker.take_snapshot( _loc_data ), signature );
 
-		output.close();
 		_add_recent_path( FileType::enum_file, m_project.m_enum_file_path );
 	}
 
@@ -367,6 +408,25 @@ namespace TR
 	}
 
 
+	/**
+	* @brief Check if the localisation data have been replaced or cleared by the file manager since the last call.
+	* @return True if the data have to be analysed again.
+	**/
+	bool FileManager::pop_data_reloaded()
+	{
+		return std::exchange( m_data_reloaded, false );
+	}
+
+	/**
+	* @brief Check if files are still being written by the save worker.
+	* @return True if a save is in progress.
+	**/
+	bool FileManager::is_saving() const
+	{
+		return m_save_worker.is_busy();
+	}
+
+
 	/************************************************************************
 	* PRIVATE
 	************************************************************************/
@@ -392,8 +452,10 @@ namespace TR
 		m_project.m_project_path = _path;
 		m_project.m_entries_path = root[ "entries_path" ].asString();
 		m_project.m_enum_file_path = root[ "enum_file_path" ].asString();
+		m_project.m_compiled_entries_path = root[ "compiled_entries_path" ].asString();
 
 		fzn::Localisation::Manager::load_entries( m_project.m_entries_path, _loc_data );
+		m_data_reloaded = true;
 		_set_window_title_from_project();
 	}
 
@@ -406,62 +468,35 @@ namespace TR
 	{
 		m_project.m_entries_path = _path;
 		fzn::Localisation::Manager::load_entries( m_project.m_entries_path, _loc_data );
+		m_data_reloaded = true;
 	}
 
 	/**
-	* @brief Write the languages section of the given localisation data in the given json root.
-	* @param [in,out] _root The json root to fill with the data.
+	* @brief Compute a hash of everything written in the enum file (languages, entries names and order, comments).
 	* @param _loc_data The localisation data to use.
+	* @return The hash of the enum file content.
 	**/
-	void FileManager::_write_languages( Json::Value& _root, const fzn::Localisation::LocalisationData& _loc_data ) const
+	uint32_t FileManager::_get_enum_file_signature( const fzn::Localisation::LocalisationData& _loc_data )
 	{
-		// "available_languages" : ["english","french","spanish"],
+		uint32_t signature{ fzn::Tools::hash_string( {} ) };
 
-		for( uint32_t language_id{ 0 }; language_id < _loc_data.m_languages.size(); ++language_id )
-		{
-			_root[ "available_languages" ][ language_id ] = _loc_data.m_languages[ language_id ].c_str();
-		}
-	}
-
-	/**
-	* @brief Write the entries section of the given localisation data in the given json root.
-	* @param [in,out] _root The json root to fill with the data.
-	* @param _loc_data The localisation data to use.
-	**/
-	void FileManager::_write_entries( Json::Value& _root, const fzn::Localisation::LocalisationData& _loc_data ) const
-	{
-		/*{
-			"name" : "yes",
-			"translations":
-			[
-				["english","yes"],
-				["french","oui"],
-				["spanish","si"]
-			]
-		},*/
-
-		for( uint32_t entry_index{ 0 }; entry_index < _loc_data.m_entries.size(); ++entry_index )
-		{
-			const fzn::Localisation::Entry& entry{ _loc_data.m_entries[ entry_index ] };
-			Json::Value json_entry{};
-
-			json_entry[ "name" ] = entry.m_name.c_str();
-
-			uint32_t translation_id{ 0 };
-			for( uint32_t language_id{ 0 }; language_id < entry.m_translations.size(); ++language_id )
+		// The strings hashes are chained so their order matters, and the counts keep "ab" + "c" different from "a" + "bc".
+		auto add_string = [ &signature ]( std::string_view _text )
 			{
-				const std::string& translation{ entry.m_translations[ language_id ] };
-
-				if( translation.empty() )
-					continue;
+				signature = ( signature ^ fzn::Tools::hash_string( _text ) ) * 16777619u;
+				signature = ( signature ^ static_cast< uint32_t >( _text.size() ) ) * 16777619u;
+			};
 
-				json_entry[ "translations" ][ translation_id ][ 0 ] = _loc_data.m_languages[ language_id ].c_str();
-				json_entry[ "translations" ][ translation_id ][ 1 ] = translation.c_str();
-				++translation_id;
-			}
+		for( const std::string& language : _loc_data.m_languages )
+			add_string( language );
 
-			_root[ "entries" ][ entry_index ] = json_entry;
+		for( const fzn::Localisation::Entry& entry : _loc_data.m_entries )
+		{
+			add_string( entry.m_name );
+			add_string( entry.m_translations.empty() ? std::string_view{} : std::string_view{ entry.m_translations.front() } );
 		}
+
+		return signature;
 	}
 
 	/**
@@ -2,6 +2,8 @@
 
 #include <FZN/Managers/LocalisationManager.h>
 
+#include "TR/SaveWorker.h"
+
 
 namespace TR
 {
@@ -13,11 +15,12 @@ namespace TR
 		/**
 		* @brief Clear all paths.
 		**/
-		void clear() { m_project_path.clear(); m_entries_path.clear(); m_enum_file_path.clear(); }
+		void clear() { m_project_path.clear(); m_entries_path.clear(); m_enum_file_path.clear(); m_compiled_entries_path.clear(); }
 
-		std::string m_project_path{};		// The path to the project.
-		std::string m_entries_path{};		// The path to the entries json file.
-		std::string m_enum_file_path{};		// The path that will be used to generate the enum file.
+		std::string m_project_path{};			// The path to the project.
+		std::string m_entries_path{};			// The path to the entries json file.
+		std::string m_enum_file_path{};			// The path that will be used to generate the enum file.
+		std::string m_compiled_entries_path{};	// The path that will be used to export the compiled entries, loaded by the projects at runtime.
 	};
 
 	/************************************************************************
@@ -85,7 +88,7 @@ namespace TR
 		**/
 		void open_entries_file( fzn::Localisation::LocalisationData& _loc_data );
 		/**
-		* @brief Save the given localisation data to the previously selected path.
+		* @brief Save the given localisation data to the previously selected path. The file is written on a worker thread from a copy of the data.
 		* @param [out] _loc_data The localisation data to be saved.
 		**/
 		void save_entries( fzn::Localisation::LocalisationData& _loc_data );
@@ -101,12 +104,29 @@ namespace TR
 		void close_entries( fzn::Localisation::LocalisationData& _loc_data );
 
 
+		/************************************************************************
+		* COMPILED ENTRIES
+		************************************************************************/
+
+		/**
+		* @brief Export the given localisation data in the compiled format to the previously selected path.
+		* @param _loc_data The localisation data to be exported.
+		**/
+		void export_compiled_entries( const fzn::Localisation::LocalisationData& _loc_data );
+		/**
+		* @brief Show a save file dialog to select where to export the given localisation data in the compiled format.
+		* @param _loc_data The localisation data to be exported.
+		**/
+		void export_compiled_entries_as( const fzn::Localisation::LocalisationData& _loc_data );
+
+
 		/************************************************************************
 		* ENUM FILE
 		************************************************************************/
 
 		/**
 		* @brief Generate the enum file using the given localisation data to the previously selected path.
+		* The file is written on a worker thread, and only if the languages or entries changed since its last generation so the projects including it aren't rebuilt for nothing.
 		* @param [out] _loc_data The localisation data to be used.
 		**/
 		void generate_enum_file( fzn::Localisation::LocalisationData& _loc_data );
@@ -126,6 +146,16 @@ namespace TR
 		* @return The project name
 		**/
 		const std::string get_current_project_name() const;
+		/**
+		* @brief Check if the localisation data have been replaced or cleared by the file manager since the last call.
+		* @return True if the data have to be analysed again.
+		**/
+		bool pop_data_reloaded();
+		/**
+		* @brief Check if files are still being written by the save worker.
+		* @return True if a save is in progress.
+		**/
+		bool is_saving() const;
 
 	private:
 		enum FileType
@@ -152,17 +182,11 @@ namespace TR
 		**/
 		void _open_entries_file( std::string_view _path, fzn::Localisation::LocalisationData& _loc_data );
 		/**
-		* @brief Write the languages section of the given localisation data in the given json root.
-		* @param [in,out] _root The json root to fill with the data.
-		* @param _loc_data The localisation data to use.
-		**/
-		void _write_languages( Json::Value& _root, const fzn::Localisation::LocalisationData& _loc_data ) const;
-		/**
-		* @brief Write the entries section of the given localisation data in the given json root.
-		* @param [in,out] _root The json root to fill with the data.
+		* @brief Compute a hash of everything written in the enum file (languages, entries names and order, comments).
 		* @param _loc_data The localisation data to use.
+		* @return The hash of the enum file content.
 		**/
-		void _write_entries( Json::Value& _root, const fzn::Localisation::LocalisationData& _loc_data ) const;
+		static uint32_t _get_enum_file_signature( const fzn::Localisation::LocalisationData& _loc_data );
 		/**
 		* @brief Show a fave ile dialog to select where to generate the enum file using the given localisation data.
 		* @param _path The path to the enum file.
@@ -223,5 +247,13 @@ namespace TR
 
 		uint32_t	m_max_recent_paths{ 10 };	// The maximum number of recent path to keep in memory for each type of path (project, entries, enum file).
 		PathArray	m_recent_paths;				// Array containing the recent paths used for each type of file.
+
+	private:
+		bool		m_data_reloaded{ false };	// True when the localisation data have been opened or closed since the last pop_data_reloaded.
+
+		std::string	m_enum_file_generated_path{};	// The path of the last enum file the save worker has written.
+		uint32_t	m_enum_file_signature{ 0 };		// The signature of the data used to write the last enum file, only set once the worker reports the file as written.
+
+		SaveWorker	m_save_worker;				// Writes the entries and enum files in the background. Declared last so it's the first to be destroyed, waiting for the saves in progress.
 	};
 }
@@ -0,0 +1,370 @@
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#include <FZN/Tools/Logging.h>
+
+#include "TR/SaveWorker.h"
+
+
+namespace TR
+{
+	static const std::string enum_file_message{ "// This file is generated by the TranslatR application. Do not edit it directly or modification will be overwritten!" };
+	static const char* json_indent{ "   " };
+
+	/**
+	* @brief Write a string between quotes, escaping the characters json doesn't allow in strings. UTF-8 sequences are kept as they are.
+	* @param [in,out] _stream The stream to write to.
+	* @param _text The string to write.
+	**/
+	static void write_json_string( std::ostream& _stream, std::string_view _text )
+	{
+		static constexpr char hex_digits[]{ "0123456789abcdef" };
+
+		_stream.put( '"' );
+
+		for( const char character : _text )
+		{
+			switch( character )
+			{
+				case '"':	_stream << "\\\""; break;
+				case '\\':	_stream << "\\\\"; break;
+				case '\b':	_stream << "\\b"; break;
+				case '\f':	_stream << "\\f"; break;
+				case '\n':	_stream << "\\n"; break;
+				case '\r':	_stream << "\\r"; break;
+				case '\t':	_stream << "\\t"; break;
+				default:
+				{
+					if( static_cast< uint8_t >( character ) < 0x20 )
+						_stream << "\\u00" << hex_digits[ character >> 4 ] << hex_digits[ character & 0xF ];
+					else
+						_stream.put( character );
+				}
+			}
+		}
+
+		_stream.put( '"' );
+	}
+
+	/**
+	* @brief Write a file through a temporary file renamed over the destination once complete.
+	* @param _path The path to the file.
+	* @param _write_content The function writing the content of the file in the given stream.
+	* @return True if the file has been written and renamed.
+	**/
+	template< typename WriteContent >
+	static bool write_file_atomically( const std::string& _path, WriteContent&& _write_content )
+	{
+		const std::string temp_path{ _path + ".tmp" };
+		std::error_code error;
+
+		{
+			auto file = std::ofstream{ temp_path, std::ios::binary | std::ios::trunc };
+
+			if( file.is_open() == false )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't create '%s'.", temp_path.c_str() );
+				return false;
+			}
+
+			_write_content( file );
+			file.flush();
+
+			if( file.good() == false )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Failure while writing '%s'.", temp_path.c_str() );
+				file.close();
+				std::filesystem::remove( temp_path, error );
+				return false;
+			}
+		}
+
+		std::filesystem::rename( temp_path, _path, error );
+
+		if( error )
+		{
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Couldn't replace '%s' (%s).", _path.c_str(), error.message().c_str() );
+			std::filesystem::remove( temp_path, error );
+			return false;
+		}
+
+		return true;
+	}
+
+
+	SaveWorker::SaveWorker()
+	{
+		m_thread = std::thread( &SaveWorker::_run, this );
+	}
+
+	SaveWorker::~SaveWorker()
+	{
+		{
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_stop = true;
+		}
+
+		m_condition.notify_all();
+
+		// The worker empties the queue before stopping so no save is lost when closing the application.
+		if( m_thread.joinable() )
+			m_thread.join();
+	}
+
+	/**
+	* @brief Copy the given localisation data so they can be used by the worker thread. Only the entries that changed since the previous snapshot are copied.
+	* @param _loc_data The localisation data to copy.
+	* @return The snapshot to give to the save functions, it can be shared between several of them.
+	**/
+	SaveWorker::Snapshot SaveWorker::take_snapshot( const fzn::Localisation::LocalisationData& _loc_data )
+	{
+		auto snapshot = std::make_shared< SnapshotData >();
+		snapshot->m_languages = _loc_data.m_languages;
+		snapshot->m_entries.reserve( _loc_data.m_entries.size() );
+
+		// The entries are compared at the same index: editing one keeps the others shared, adding or removing one only copies the ones after it.
+		for( size_t entry_index{ 0 }; entry_index < _loc_data.m_entries.size(); ++entry_index )
+		{
+			const fzn::Localisation::Entry& entry{ _loc_data.m_entries[ entry_index ] };
+
+			if( m_last_snapshot != nullptr && entry_index < m_last_snapshot->m_entries.size() )
+			{
+				const EntryPtr& previous_entry{ m_last_snapshot->m_entries[ entry_index ] };
+
+				if( previous_entry->m_name == entry.m_name && previous_entry->m_translations == entry.m_translations )
+				{
+					snapshot->m_entries.push_back( previous_entry );
+					continue;
+				}
+			}
+
+			snapshot->m_entries.push_back( std::make_shared< const fzn::Localisation::Entry >( entry ) );
+		}
+
+		m_last_snapshot = snapshot;
+		return m_last_snapshot;
+	}
+
+	/**
+	* @brief Queue the writing of the entries json file. A save of the same file still waiting in the queue is replaced by this one.
+	* @param _path The path to the entries file.
+	* @param _snapshot The localisation data to write.
+	**/
+	void SaveWorker::save_entries( std::string_view _path, const Snapshot& _snapshot )
+	{
+		_push_job( { JobType::entries, std::string{ _path }, _snapshot } );
+	}
+
+	/**
+	* @brief Queue the generation of the enum file. A generation of the same file still waiting in the queue is replaced by this one.
+	* @param _path The path to the enum file.
+	* @param _snapshot The localisation data to use.
+	* @param _signature The signature of the enum file content, given back by pop_generated_enum_files once the file is written.
+	**/
+	void SaveWorker::generate_enum_file( std::string_view _path, const Snapshot& _snapshot, uint32_t _signature )
+	{
+		_push_job( { JobType::enum_file, std::string{ _path }, _snapshot, _signature } );
+	}
+
+	/**
+	* @brief Retrieve the enum files written since the last call. The failed generations aren't reported.
+	* @return The written files, in the order they have been written.
+	**/
+	std::vector< SaveWorker::GeneratedFile > SaveWorker::pop_generated_enum_files()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return std::exchange( m_generated_enum_files, {} );
+	}
+
+	/**
+	* @brief Check if files are being written or waiting to be.
+	* @return True if the worker still has something to do.
+	**/
+	bool SaveWorker::is_busy() const
+	{
+		return m_nb_pending_jobs > 0;
+	}
+
+	/**
+	* @brief Block until all the queued files have been written.
+	**/
+	void SaveWorker::wait()
+	{
+		std::unique_lock< std::mutex > lock( m_mutex );
+		m_condition.wait( lock, [ this ]() { return m_nb_pending_jobs == 0; } );
+	}
+
+	/**
+	* @brief Add a job to the queue, replacing the pending one writing the same file if any.
+	* @param _job The job to add.
+	**/
+	void SaveWorker::_push_job( Job&& _job )
+	{
+		if( _job.m_path.empty() || _job.m_snapshot == nullptr )
+			return;
+
+		{
+			std::lock_guard< std::mutex > lock( m_mutex );
+
+			for( Job& pending_job : m_jobs )
+			{
+				if( pending_job.m_type == _job.m_type && pending_job.m_path == _job.m_path )
+				{
+					pending_job.m_snapshot = std::move( _job.m_snapshot );
+					pending_job.m_signature = _job.m_signature;
+					return;
+				}
+			}
+
+			m_jobs.push_back( std::move( _job ) );
+			++m_nb_pending_jobs;
+		}
+
+		m_condition.notify_all();
+	}
+
+	/**
+	* @brief Worker thread loop, writing the queued files until the worker is destroyed.
+	**/
+	void SaveWorker::_run()
+	{
+		std::unique_lock< std::mutex > lock( m_mutex );
+
+		while( true )
+		{
+			m_condition.wait( lock, [ this ]() { return m_stop || m_jobs.empty() == false; } );
+
+			if( m_jobs.empty() )
+				return;
+
+			const Job job{ std::move( m_jobs.front() ) };
+			m_jobs.pop_front();
+
+			lock.unlock();
+
+			bool written{ false };
+
+			if( job.m_type == JobType::entries )
+				_write_entries( job.m_path, *job.m_snapshot );
+			else
+				written = _write_enum_file( job.m_path, *job.m_snapshot );
+
+			lock.lock();
+
+			if( written )
+				m_generated_enum_files.push_back( { job.m_path, job.m_signature } );
+
+			--m_nb_pending_jobs;
+
+			if( m_nb_pending_jobs == 0 )
+				m_condition.notify_all();
+		}
+	}
+
+	/**
+	* @brief Stream the given localisation data to a json file, in the format read by fzn::Localisation::Manager::load_entries.
+	* @param _path The path to the entries file.
+	* @param _loc_data The localisation data to write.
+	* @return True if the file has been written.
+	**/
+	bool SaveWorker::_write_entries( const std::string& _path, const SnapshotData& _loc_data )
+	{
+		/*{
+			"available_languages" : [ "english", "french", "spanish" ],
+			"entries" : [
+				{
+					"name" : "yes",
+					"translations" : [
+						[ "english", "yes" ],
+						[ "french", "oui" ],
+						[ "spanish", "si" ]
+					]
+				}
+			]
+		}*/
+
+		return write_file_atomically( _path, [ &_loc_data ]( std::ostream& _stream )
+			{
+				_stream << "{\n" << json_indent << "\"available_languages\" : [ ";
+
+				for( uint32_t language_id{ 0 }; language_id < _loc_data.m_languages.size(); ++language_id )
+				{
+					_stream << ( language_id > 0 ? ", " : "" );
+					write_json_string( _stream, _loc_data.m_languages[ language_id ] );
+				}
+
+				_stream << " ],\n" << json_indent << "\"entries\" : [";
+
+				for( uint32_t entry_index{ 0 }; entry_index < _loc_data.m_entries.size(); ++entry_index )
+				{
+					const fzn::Localisation::Entry& entry{ *_loc_data.m_entries[ entry_index ] };
+
+					_stream << ( entry_index > 0 ? ",\n" : "\n" ) << json_indent << json_indent << "{\n";
+					_stream << json_indent << json_indent << json_indent << "\"name\" : ";
+					write_json_string( _stream, entry.m_name );
+					_stream << ",\n" << json_indent << json_indent << json_indent << "\"translations\" : [";
+
+					bool first_translation{ true };
+					for( uint32_t language_id{ 0 }; language_id < entry.m_translations.size() && language_id < _loc_data.m_languages.size(); ++language_id )
+					{
+						const std::string& translation{ entry.m_translations[ language_id ] };
+
+						if( translation.empty() )
+							continue;
+
+						_stream << ( first_translation ? "\n" : ",\n" ) << json_indent << json_indent << json_indent << json_indent << "[ ";
+						write_json_string( _stream, _loc_data.m_languages[ language_id ] );
+						_stream << ", ";
+						write_json_string( _stream, translation );
+						_stream << " ]";
+						first_translation = false;
+					}
+
+					if( first_translation == false )
+						_stream << "\n" << json_indent << json_indent << json_indent;
+
+					_stream << "]\n" << json_indent << json_indent << "}";
+				}
+
+				_stream << "\n" << json_indent << "]\n}\n";
+			} );
+	}
+
+	/**
+	* @brief Write the enum header containing the languages and the entries IDs.
+	* @param _path The path to the enum file.
+	* @param _loc_data The localisation data to use.
+	* @return True if the file has been written.
+	**/
+	bool SaveWorker::_write_enum_file( const std::string& _path, const SnapshotData& _loc_data )
+	{
+		return write_file_atomically( _path, [ &_loc_data ]( std::ostream& _stream )
+			{
+				_stream << "#pragma once\n\n" << enum_file_message << "\n\nenum class Language\n{\n";
+
+				for( const std::string& language : _loc_data.m_languages )
+				{
+					_stream << "\t" << language << ",\n";
+				}
+
+				_stream << "\tCOUNT\n};";
+
+				_stream << "\n\nenum class LocID\n{\n";
+
+				for( const EntryPtr& entry_ptr : _loc_data.m_entries )
+				{
+					const fzn::Localisation::Entry& entry{ *entry_ptr };
+
+					_stream << "\t" << entry.m_name << ",";
+
+					if( entry.m_translations.empty() == false && entry.m_translations.front().empty() == false )
+						_stream << "\t\t// " << entry.m_translations.front() << "\n";
+					else
+						_stream << "\n";
+				}
+
+				_stream << "\tCOUNT\n};\n";
+			} );
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <FZN/Managers/LocalisationManager.h>
+
+
+namespace TR
+{
+	/************************************************************************
+	* @brief Writes the entries and enum files on a worker thread so saving never stalls the interface.
+	* The localisation data are copied when a save is requested, the worker only reading that snapshot. The entries unchanged since the previous snapshot are shared with it instead of being copied.
+	* Files are written next to their destination then renamed, so an interrupted save never leaves a truncated file.
+	************************************************************************/
+	class SaveWorker
+	{
+	public:
+		using EntryPtr = std::shared_ptr< const fzn::Localisation::Entry >;
+
+		/************************************************************************
+		* @brief Read-only copy of the localisation data, each entry being shared by the snapshots it is the same in.
+		************************************************************************/
+		struct SnapshotData
+		{
+			StringVector			m_languages{};
+			std::vector< EntryPtr >	m_entries{};
+		};
+		using Snapshot = std::shared_ptr< const SnapshotData >;
+
+		/************************************************************************
+		* @brief An enum file the worker has successfully written.
+		************************************************************************/
+		struct GeneratedFile
+		{
+			std::string	m_path{};
+			uint32_t	m_signature{ 0 };	// The signature given with the generation request.
+		};
+
+		SaveWorker();
+		~SaveWorker();
+
+		/**
+		* @brief Copy the given localisation data so they can be used by the worker thread. Only the entries that changed since the previous snapshot are copied.
+		* @param _loc_data The localisation data to copy.
+		* @return The snapshot to give to the save functions, it can be shared between several of them.
+		**/
+		Snapshot take_snapshot( const fzn::Localisation::LocalisationData& _loc_data );
+
+		/**
+		* @brief Queue the writing of the entries json file. A save of the same file still waiting in the queue is replaced by this one.
+		* @param _path The path to the entries file.
+		* @param _snapshot The localisation data to write.
+		**/
+		void save_entries( std::string_view _path, const Snapshot& _snapshot );
+		/**
+		* @brief Queue the generation of the enum file. A generation of the same file still waiting in the queue is replaced by this one.
+		* @param _path The path to the enum file.
+		* @param _snapshot The localisation data to use.
+		* @param _signature The signature of the enum file content, given back by pop_generated_enum_files once the file is written.
+		**/
+		void generate_enum_file( std::string_view _path, const Snapshot& _snapshot, uint32_t _signature );
+		/**
+		* @brief Retrieve the enum files written since the last call. The failed generations aren't reported.
+		* @return The written files, in the order they have been written.
+		**/
+		std::vector< GeneratedFile > pop_generated_enum_files();
+
+		/**
+		* @brief Check if files are being written or waiting to be.
+		* @return True if the worker still has something to do.
+		**/
+		bool is_busy() const;
+		/**
+		* @brief Block until all the queued files have been written.
+		**/
+		void wait();
+
+	private:
+		enum class JobType
+		{
+			entries,
+			enum_file,
+		};
+
+		struct Job
+		{
+			JobType		m_type{ JobType::entries };
+			std::string	m_path{};
+			Snapshot	m_snapshot{};
+			uint32_t	m_signature{ 0 };
+		};
+
+		/**
+		* @brief Add a job to the queue, replacing the pending one writing the same file if any.
+		* @param _job The job to add.
+		**/
+		void _push_job( Job&& _job );
+		/**
+		* @brief Worker thread loop, writing the queued files until the worker is destroyed.
+		**/
+		void _run();
+
+		/**
+		* @brief Stream the given localisation data to a json file, in the format read by fzn::Localisation::Manager::load_entries.
+		* @param _path The path to the entries file.
+		* @param _loc_data The localisation data to write.
+		* @return True if the file has been written.
+		**/
+		static bool _write_entries( const std::string& _path, const SnapshotData& _loc_data );
+		/**
+		* @brief Write the enum header containing the languages and the entries IDs.
+		* @param _path The path to the enum file.
+		* @param _loc_data The localisation data to use.
+		* @return True if the file has been written.
+		**/
+		static bool _write_enum_file( const std::string& _path, const SnapshotData& _loc_data );
+
+		std::thread				m_thread;
+		std::mutex				m_mutex;
+		std::condition_variable	m_condition;			// Wakes the worker when a job is added or when it has to stop, and the waiting threads when the queue is empty.
+		std::deque< Job >		m_jobs;
+		bool					m_stop{ false };
+		std::atomic< uint32_t >	m_nb_pending_jobs{ 0 };	// Jobs queued or being processed.
+		std::vector< GeneratedFile >	m_generated_enum_files;	// Filled by the worker, emptied by pop_generated_enum_files.
+
+		Snapshot				m_last_snapshot{};		// Only used by the main thread, to share the unchanged entries with the next snapshot.
+	};
+}
@@ -0,0 +1,314 @@
+#include <algorithm>
+
+#include <FZN/Tools/Tools.h>
+
+#include "TR/SearchIndex.h"
+
+
+namespace TR
+{
+	/**
+	* @brief Index all the entries from scratch.
+	* @param _loc_data The localisation data to index.
+	**/
+	void SearchIndex::rebuild( const fzn::Localisation::LocalisationData& _loc_data )
+	{
+		m_nb_fields = static_cast< uint32_t >( _loc_data.m_languages.size() ) + 1;
+		m_documents.assign( _loc_data.m_entries.size() * m_nb_fields, {} );
+
+		for( uint32_t entry_id{ 0 }; entry_id < _loc_data.m_entries.size(); ++entry_id )
+		{
+			const fzn::Localisation::Entry& entry{ _loc_data.m_entries[ entry_id ] };
+
+			m_documents[ _get_document( entry_id, 0 ) ] = fzn::Tools::get_utf8_lower_string( entry.m_name );
+
+			for( uint32_t language_id{ 0 }; language_id < entry.m_translations.size() && language_id + 1 < m_nb_fields; ++language_id )
+				m_documents[ _get_document( entry_id, language_id + 1 ) ] = fzn::Tools::get_utf8_lower_string( entry.m_translations[ language_id ] );
+		}
+
+		_index_documents();
+	}
+
+	/**
+	* @brief Index an entry added at the end of the entries.
+	* @param _entry The new entry.
+	**/
+	void SearchIndex::on_entry_added( const fzn::Localisation::Entry& _entry )
+	{
+		for( uint32_t field_id{ 0 }; field_id < m_nb_fields; ++field_id )
+		{
+			const uint32_t document{ static_cast< uint32_t >( m_documents.size() ) };
+			const std::string_view text{ field_id == 0 ? _entry.m_name : field_id <= _entry.m_translations.size() ? _entry.m_translations[ field_id - 1 ] : std::string_view{} };
+
+			m_documents.push_back( fzn::Tools::get_utf8_lower_string( text ) );
+			_get_trigrams( m_documents.back(), m_new_trigrams );
+
+			// The new document has the biggest ID, the postings stay sorted.
+			for( const Trigram trigram : m_new_trigrams )
+				m_postings[ trigram ].push_back( document );
+		}
+
+		_on_data_changed();
+	}
+
+	/**
+	* @brief Remove an entry from the index. The following entries IDs being shifted, the documents are indexed again from the stored texts.
+	* @param _entry_id The ID the entry had before its removal.
+	**/
+	void SearchIndex::on_entry_removed( uint32_t _entry_id )
+	{
+		if( _get_document( _entry_id, 0 ) >= m_documents.size() )
+			return;
+
+		const auto it_first_field{ m_documents.begin() + _get_document( _entry_id, 0 ) };
+		m_documents.erase( it_first_field, it_first_field + m_nb_fields );
+
+		_index_documents();
+	}
+
+	/**
+	* @brief Update the index after the name of an entry has been edited.
+	* @param _entry_id The ID of the entry.
+	* @param _entry The entry.
+	**/
+	void SearchIndex::on_name_changed( uint32_t _entry_id, const fzn::Localisation::Entry& _entry )
+	{
+		_set_field( _entry_id, 0, _entry.m_name );
+	}
+
+	/**
+	* @brief Update the index after one of the translations of an entry has been edited.
+	* @param _entry_id The ID of the entry.
+	* @param _language_id The language of the edited translation.
+	* @param _entry The entry.
+	**/
+	void SearchIndex::on_translation_changed( uint32_t _entry_id, uint32_t _language_id, const fzn::Localisation::Entry& _entry )
+	{
+		if( _language_id >= _entry.m_translations.size() )
+			return;
+
+		_set_field( _entry_id, _language_id + 1, _entry.m_translations[ _language_id ] );
+	}
+
+	/**
+	* @brief Find the entries matching a query. The words of the query have to be found in the same field, in the same order (see fzn::Tools::match_filter).
+	* @param _query The words to look for, case insensitive.
+	* @param _field The field to look into: all_fields, name_field or a language ID.
+	* @return The sorted IDs of the matching entries. The reference stays valid until the next search or modification of the index.
+	**/
+	const std::vector< uint32_t >& SearchIndex::search( std::string_view _query, uint32_t _field /*= all_fields*/ )
+	{
+		if( m_results_valid && m_cached_field == _field && m_cached_query == _query )
+			return m_cached_results;
+
+		m_results_valid = true;
+		m_cached_query = _query;
+		m_cached_field = _field;
+		m_cached_results.clear();
+
+		StringVector words{ fzn::Tools::split( fzn::Tools::get_utf8_lower_string( _query ), ' ' ) };
+		std::erase_if( words, []( const std::string& _word ) { return _word.empty(); } );
+
+		const uint32_t nb_entries{ static_cast< uint32_t >( m_documents.size() / m_nb_fields ) };
+
+		if( words.empty() )
+		{
+			m_cached_results.resize( nb_entries );
+
+			for( uint32_t entry_id{ 0 }; entry_id < nb_entries; ++entry_id )
+				m_cached_results[ entry_id ] = entry_id;
+
+			return m_cached_results;
+		}
+
+		// All the words have to be in the same field, so a document has to contain the trigrams of all of them.
+		std::vector< const Postings* > postings_lists;
+
+		for( const std::string& word : words )
+		{
+			_get_trigrams( word, m_new_trigrams );
+
+			for( const Trigram trigram : m_new_trigrams )
+			{
+				const auto it_postings{ m_postings.find( trigram ) };
+
+				if( it_postings == m_postings.end() )
+					return m_cached_results;
+
+				postings_lists.push_back( &it_postings->second );
+			}
+		}
+
+		auto check_document = [ this, &words, _field ]( uint32_t _document )
+			{
+				const uint32_t field_id{ _document % m_nb_fields };
+
+				if( _field == name_field && field_id != 0 )
+					return;
+				if( _field != all_fields && _field != name_field && field_id != _field + 1 )
+					return;
+
+				const uint32_t entry_id{ _document / m_nb_fields };
+
+				if( m_cached_results.empty() == false && m_cached_results.back() == entry_id )
+					return;
+
+				if( _match( words, m_documents[ _document ] ) )
+					m_cached_results.push_back( entry_id );
+			};
+
+		// Words too short to have trigrams: every document has to be checked.
+		if( postings_lists.empty() )
+		{
+			for( uint32_t document{ 0 }; document < m_documents.size(); ++document )
+				check_document( document );
+
+			return m_cached_results;
+		}
+
+		// Intersecting from the shortest list keeps the intermediate results small.
+		std::ranges::sort( postings_lists, []( const Postings* _lhs, const Postings* _rhs ) { return _lhs->size() < _rhs->size(); } );
+		postings_lists.erase( std::unique( postings_lists.begin(), postings_lists.end() ), postings_lists.end() );
+
+		Postings candidates{ *postings_lists.front() };
+		Postings intersection;
+
+		for( size_t list_id{ 1 }; list_id < postings_lists.size() && candidates.empty() == false; ++list_id )
+		{
+			intersection.clear();
+			std::ranges::set_intersection( candidates, *postings_lists[ list_id ], std::back_inserter( intersection ) );
+			candidates.swap( intersection );
+		}
+
+		for( const uint32_t document : candidates )
+			check_document( document );
+
+		return m_cached_results;
+	}
+
+	/**
+	* @brief Replace the text of a document and update the postings of the trigrams that appeared or disappeared.
+	* @param _entry_id The ID of the entry.
+	* @param _field_id 0 for the name, 1 + language ID for a translation.
+	* @param _text The new text of the field, not lowered yet.
+	**/
+	void SearchIndex::_set_field( uint32_t _entry_id, uint32_t _field_id, std::string_view _text )
+	{
+		const uint32_t document{ _get_document( _entry_id, _field_id ) };
+
+		if( _field_id >= m_nb_fields || document >= m_documents.size() )
+			return;
+
+		std::string text{ fzn::Tools::get_utf8_lower_string( _text ) };
+
+		if( text == m_documents[ document ] )
+			return;
+
+		_get_trigrams( m_documents[ document ], m_old_trigrams );
+		_get_trigrams( text, m_new_trigrams );
+
+		// Both trigrams lists are sorted, the common ones are skipped.
+		auto it_old{ m_old_trigrams.begin() };
+		auto it_new{ m_new_trigrams.begin() };
+
+		while( it_old != m_old_trigrams.end() || it_new != m_new_trigrams.end() )
+		{
+			if( it_new == m_new_trigrams.end() || ( it_old != m_old_trigrams.end() && *it_old < *it_new ) )
+			{
+				Postings& postings{ m_postings[ *it_old ] };
+
+				if( const auto it_document{ std::ranges::lower_bound( postings, document ) }; it_document != postings.end() && *it_document == document )
+					postings.erase( it_document );
+
+				if( postings.empty() )
+					m_postings.erase( *it_old );
+
+				++it_old;
+			}
+			else if( it_old == m_old_trigrams.end() || *it_new < *it_old )
+			{
+				Postings& postings{ m_postings[ *it_new ] };
+				postings.insert( std::ranges::lower_bound( postings, document ), document );
+				++it_new;
+			}
+			else
+			{
+				++it_old;
+				++it_new;
+			}
+		}
+
+		m_documents[ document ] = std::move( text );
+		_on_data_changed();
+	}
+
+	/**
+	* @brief Add the postings of all the stored documents.
+	**/
+	void SearchIndex::_index_documents()
+	{
+		m_postings.clear();
+
+		for( uint32_t document{ 0 }; document < m_documents.size(); ++document )
+		{
+			_get_trigrams( m_documents[ document ], m_new_trigrams );
+
+			for( const Trigram trigram : m_new_trigrams )
+				m_postings[ trigram ].push_back( document );
+		}
+
+		_on_data_changed();
+	}
+
+	/**
+	* @brief Invalidate the cached search results.
+	**/
+	void SearchIndex::_on_data_changed()
+	{
+		m_results_valid = false;
+	}
+
+	/**
+	* @brief Get the sorted and unique trigrams of a text.
+	* @param _text The text, already lowered.
+	* @param [out] _trigrams The trigrams of the text.
+	**/
+	void SearchIndex::_get_trigrams( std::string_view _text, std::vector< Trigram >& _trigrams )
+	{
+		_trigrams.clear();
+
+		// Bytes are used instead of code points, a substring of an UTF-8 text being the same sequence of bytes.
+		for( size_t position{ 2 }; position < _text.size(); ++position )
+		{
+			_trigrams.push_back( static_cast< uint8_t >( _text[ position - 2 ] ) << 16
+							   | static_cast< uint8_t >( _text[ position - 1 ] ) << 8
+							   | static_cast< uint8_t >( _text[ position ] ) );
+		}
+
+		std::ranges::sort( _trigrams );
+		_trigrams.erase( std::unique( _trigrams.begin(), _trigrams.end() ), _trigrams.end() );
+	}
+
+	/**
+	* @brief Check if the words of a query are in a text, in the same order.
+	* @param _words The lowered words of the query.
+	* @param _text The lowered text.
+	* @return True if all the words are found.
+	**/
+	bool SearchIndex::_match( const StringVector& _words, std::string_view _text )
+	{
+		size_t position{ 0 };
+
+		for( const std::string& word : _words )
+		{
+			position = _text.find( word, position );
+
+			if( position == std::string_view::npos )
+				return false;
+
+			position += word.size();
+		}
+
+		return true;
+	}
+}
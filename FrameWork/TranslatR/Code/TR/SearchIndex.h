@@ -0,0 +1,113 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <FZN/Managers/LocalisationManager.h>
+
+
+namespace TR
+{
+	/************************************************************************
+	* @brief Trigram index over the entries names and translations, used to filter the entries table.
+	* Each field (name or translation) of each entry is a document, and every 3 bytes sequence of its lower case text points to it.
+	* A query only checks the documents containing all the trigrams of its words, and its results are kept until the query or the data change.
+	************************************************************************/
+	class SearchIndex
+	{
+	public:
+		static constexpr uint32_t all_fields{ Uint32_Max };			// Search in the entries names and all their translations.
+		static constexpr uint32_t name_field{ Uint32_Max - 1 };	// Search in the entries names only.
+
+		/**
+		* @brief Index all the entries from scratch.
+		* @param _loc_data The localisation data to index.
+		**/
+		void rebuild( const fzn::Localisation::LocalisationData& _loc_data );
+
+		/**
+		* @brief Index an entry added at the end of the entries.
+		* @param _entry The new entry.
+		**/
+		void on_entry_added( const fzn::Localisation::Entry& _entry );
+		/**
+		* @brief Remove an entry from the index. The following entries IDs being shifted, the documents are indexed again from the stored texts.
+		* @param _entry_id The ID the entry had before its removal.
+		**/
+		void on_entry_removed( uint32_t _entry_id );
+		/**
+		* @brief Update the index after the name of an entry has been edited.
+		* @param _entry_id The ID of the entry.
+		* @param _entry The entry.
+		**/
+		void on_name_changed( uint32_t _entry_id, const fzn::Localisation::Entry& _entry );
+		/**
+		* @brief Update the index after one of the translations of an entry has been edited.
+		* @param _entry_id The ID of the entry.
+		* @param _language_id The language of the edited translation.
+		* @param _entry The entry.
+		**/
+		void on_translation_changed( uint32_t _entry_id, uint32_t _language_id, const fzn::Localisation::Entry& _entry );
+
+		/**
+		* @brief Find the entries matching a query. The words of the query have to be found in the same field, in the same order (see fzn::Tools::match_filter).
+		* @param _query The words to look for, case insensitive.
+		* @param _field The field to look into: all_fields, name_field or a language ID.
+		* @return The sorted IDs of the matching entries. The reference stays valid until the next search or modification of the index.
+		**/
+		const std::vector< uint32_t >& search( std::string_view _query, uint32_t _field = all_fields );
+
+	private:
+		using Trigram = uint32_t;
+		using Postings = std::vector< uint32_t >;	// Sorted IDs of the documents containing a trigram.
+
+		/**
+		* @brief Get the document ID of a field.
+		* @param _entry_id The ID of the entry.
+		* @param _field_id 0 for the name, 1 + language ID for a translation.
+		* @return The document ID.
+		**/
+		uint32_t _get_document( uint32_t _entry_id, uint32_t _field_id ) const { return _entry_id * m_nb_fields + _field_id; }
+		/**
+		* @brief Replace the text of a document and update the postings of the trigrams that appeared or disappeared.
+		* @param _entry_id The ID of the entry.
+		* @param _field_id 0 for the name, 1 + language ID for a translation.
+		* @param _text The new text of the field, not lowered yet.
+		**/
+		void _set_field( uint32_t _entry_id, uint32_t _field_id, std::string_view _text );
+		/**
+		* @brief Add the postings of all the stored documents.
+		**/
+		void _index_documents();
+		/**
+		* @brief Invalidate the cached search results.
+		**/
+		void _on_data_changed();
+
+		/**
+		* @brief Get the sorted and unique trigrams of a text.
+		* @param _text The text, already lowered.
+		* @param [out] _trigrams The trigrams of the text.
+		**/
+		static void _get_trigrams( std::string_view _text, std::vector< Trigram >& _trigrams );
+		/**
+		* @brief Check if the words of a query are in a text, in the same order.
+		* @param _words The lowered words of the query.
+		* @param _text The lowered text.
+		* @return True if all the words are found.
+		**/
+		static bool _match( const StringVector& _words, std::string_view _text );
+
+		uint32_t								m_nb_fields{ 1 };		// Name and one translation per language.
+		StringVector							m_documents;			// Lower case text of each field of each entry.
+		std::unordered_map< Trigram, Postings >	m_postings;
+
+		std::vector< Trigram >					m_old_trigrams;			// Temporary buffers kept to avoid allocations when editing.
+		std::vector< Trigram >					m_new_trigrams;
+
+		bool									m_results_valid{ false };
+		std::string								m_cached_query{};
+		uint32_t								m_cached_field{ all_fields };
+		std::vector< uint32_t >					m_cached_results;
+	};
+}
@@ -80,6 +80,7 @@ namespace TR
 
 		_display_menu_bar();
 
+		_display_filter();
 		_display_entries();
 
 		_add_language_popup();
@@ -157,7 +158,10 @@ namespace TR
 
 				ImGui::Separator();
 				if( ImGui_fzn::colored_menu_item( ImGui_fzn::color::dark_red, "Clear All Entries", "", false, m_loc_data.has_entries() ) )
+				{
 					m_loc_data.m_entries.clear();
+					_rebuild_entries_caches();
+				}
 				ImGui_fzn::simple_tooltip_on_hover( "Clear all entries from the table, keep the available languages" );
 
 				if( ImGui_fzn::colored_menu_item( ImGui_fzn::color::dark_red, "Remove All Languages", "", false, m_loc_data.has_entries() ) )
@@ -165,7 +169,10 @@ namespace TR
 				ImGui_fzn::simple_tooltip_on_hover( "Remove all available languages, keep the entries" );
 
 				if( ImGui_fzn::colored_menu_item( ImGui_fzn::color::dark_red, "Clear All", "", false, m_loc_data.has_entries() ) )
+				{
 					m_loc_data.clear();
+					_rebuild_entries_caches();
+				}
 				ImGui_fzn::simple_tooltip_on_hover( "Clear everything, entries and languages" );
 
 				ImGui::Separator();
@@ -179,6 +186,13 @@ namespace TR
 			const ImVec2 version_size{ ImGui::CalcTextSize( version.c_str() ) };
 			const sf::Vector2u window_size{ g_pFZN_WindowMgr->GetWindowSize() };
 
+			if( m_file_manager.is_saving() )
+			{
+				const char* saving_text{ "Saving..." };
+				ImGui::SameLine( window_size.x - version_size.x - ImGui::CalcTextSize( saving_text ).x - 4.f * ImGui::GetStyle().WindowPadding.x );
+				ImGui::TextColored( ImGui_fzn::color::light_yellow, saving_text );
+			}
+
 			ImGui::SameLine( window_size.x - ImGui::CalcTextSize( version.c_str() ).x - 2.f * ImGui::GetStyle().WindowPadding.x );
 			ImGui::TextColored( ImGui_fzn::color::light_gray, version.c_str() );
 
@@ -186,18 +200,46 @@ namespace TR
 		}
 	}
 
-	static float get_max_entry_width( float _letter_width, const fzn::Localisation::Entries& _entries )
+	/**
+	* @brief Display the filter of the entries table and the field it applies to.
+	**/
+	void TranslatR::_display_filter()
 	{
-		float max_width{ 0.f };
+		auto get_field_name = [ this ]( uint32_t _field ) -> const char*
+			{
+				if( _field == SearchIndex::name_field )
+					return "Entries Names";
+				if( _field < m_loc_data.m_languages.size() )
+					return m_loc_data.m_languages[ _field ].c_str();
+
+				return "All Fields";
+			};
+
+		if( m_filter_field != SearchIndex::all_fields && m_filter_field != SearchIndex::name_field && m_filter_field >= m_loc_data.m_languages.size() )
+			m_filter_field = SearchIndex::all_fields;
 
-		for( const fzn::Localisation::Entry& entry : _entries )
+		ImGui::SetNextItemWidth( DefaultWidgetSize.x * 2.f );
+		ImGui::InputTextWithHint( "##EntriesFilter", "<Filter>", &m_filter );
+		ImGui_fzn::simple_tooltip_on_hover( "Only display the entries containing all these words, in this order" );
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth( DefaultWidgetSize.x );
+		if( ImGui::BeginCombo( "##EntriesFilterField", get_field_name( m_filter_field ) ) )
 		{
-			// Approximate text size to be lightweight.
-			if( _letter_width * entry.m_name.size() > max_width )
-				max_width = _letter_width * entry.m_name.size();
-		}
+			if( ImGui::Selectable( get_field_name( SearchIndex::all_fields ), m_filter_field == SearchIndex::all_fields ) )
+				m_filter_field = SearchIndex::all_fields;
+
+			if( ImGui::Selectable( get_field_name( SearchIndex::name_field ), m_filter_field == SearchIndex::name_field ) )
+				m_filter_field = SearchIndex::name_field;
 
-		return max_width;
+			for( uint32_t language_id{ 0 }; language_id < m_loc_data.m_languages.size(); ++language_id )
+			{
+				if( ImGui::Selectable( get_field_name( language_id ), m_filter_field == language_id ) )
+					m_filter_field = language_id;
+			}
+
+			ImGui::EndCombo();
+		}
 	}
 
 	/**
@@ -205,10 +247,14 @@ namespace TR
 	**/
 	void TranslatR::_display_entries()
 	{
+		// The statistics are only rebuilt when the whole data changed, the edits done in the table update them incrementally.
+		if( m_file_manager.pop_data_reloaded() || m_entries_stats.get_nb_entries() != m_loc_data.m_entries.size() )
+			_rebuild_entries_caches();
+
+		const uint32_t nb_entries{ static_cast< uint32_t >( m_loc_data.m_entries.size() ) };
 		const uint32_t nb_columns{ m_loc_data.m_languages.size() + 2 };		// One column per language and two for entries IDs (number) and name (future enum)
 		const float letter_width{ ImGui::CalcTextSize( "W" ).x };
-		const float first_column_width{ fzn::Math::get_number_of_digits( m_loc_data.m_entries.size() ) * letter_width };
-		uint32_t entry_id{ 0 };
+		const float first_column_width{ fzn::Math::get_number_of_digits( nb_entries ) * letter_width };
 		static int hovered_column{ -1 };
 		static int hovered_row{ -1 };
 		int language_id_to_erase{ -1 };
@@ -221,7 +267,8 @@ namespace TR
 		{
 			ImGui::PushStyleVar( ImGuiStyleVar_FramePadding, ImVec2{ 0.f, 0.f } );
 			ImGui::TableSetupColumn( "#", ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_WidthFixed, first_column_width );
-			ImGui::TableSetupColumn( "Entry", ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_WidthFixed, get_max_entry_width( letter_width, m_loc_data.m_entries ) );
+			// Approximate text size to be lightweight.
+			ImGui::TableSetupColumn( "Entry", ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_WidthFixed, letter_width * m_entries_stats.get_max_name_size() );
 
 			for( const std::string& language : m_loc_data.m_languages )
 				ImGui::TableSetupColumn( language.c_str(), ImGuiTableColumnFlags_WidthFixed, 600.f );
@@ -254,111 +301,27 @@ namespace TR
 				ImGui::EndPopup();
 			}
 
-			StringVector missing_translations;
-			missing_translations.reserve( m_loc_data.m_languages.size() );
-			std::string missing_translations_tooltip;
-			ImVec4 missing_translations_text_color{};
-			ImVec4 missing_translations_bg_color{};
-			float missing_translations_ratio{ 0.f };
-
-			for( fzn::Localisation::Entry& entry : m_loc_data.m_entries )
-			{
-				missing_translations.clear();
-				missing_translations_tooltip.clear();
-
-				ImGui::PushID( &entry );
-
-				ImGui::TableNextColumn();
-				ImGui::AlignTextToFramePadding();
-				ImGui::Text( "%d", entry_id );
-
-				ImGui::TableNextColumn();
-				ImGui::SetNextItemWidth( ImGui::GetContentRegionAvail().x );
-				uint32_t nb_mmissing_translations{ 0 };
-				uint8_t translation_id{ 0 };
-
-				// First pass on the translations to determine which languages are missing. It has to be done here so we know if we have to change the entry text color or not.
-				for( std::string& translation : entry.m_translations )
-				{
-					if( translation.empty() )
-					{
-						missing_translations.push_back( m_loc_data.m_languages[ translation_id ] );
-						++nb_mmissing_translations;
-					}
-					++translation_id;
-				}
-
-				if( nb_mmissing_translations > 0 )
-				{
-					missing_translations_ratio = static_cast< float >( nb_mmissing_translations - 1 ) / (entry.m_translations.size() - 1);
-					missing_translations_text_color = ImLerp( ImGui_fzn::color::light_yellow, ImGui_fzn::color::light_red, missing_translations_ratio );
-					ImGui::PushStyleColor( ImGuiCol_Text, missing_translations_text_color );
-					ImGui::PushFont( ImGui_fzn::s_ImGuiFormatOptions.m_pFontBold );
-				}
-
-				ImGui::InputTextWithHint( "##EntryName", "<Entry Name>", &entry.m_name );
-
-				if( nb_mmissing_translations > 0 )
-				{
-					ImGui::PopFont();
-					ImGui::PopStyleColor();
-				}
-
-				const bool entry_hovered{ ImGui::IsItemHovered() };
-
-				translation_id = 0;
-				for( std::string& translation : entry.m_translations )
-				{
-					ImGui::TableNextColumn();
-					ImGui::SetNextItemWidth( ImGui::GetContentRegionAvail().x );
-
-					const bool no_translation{ translation.empty() };
+			// The search results are cached by the index until the filter or the entries change.
+			const std::vector< uint32_t >* filtered_entries{ m_filter.empty() ? nullptr : &m_search_index.search( m_filter, m_filter_field ) };
+			const uint32_t nb_rows{ filtered_entries != nullptr ? static_cast< uint32_t >( filtered_entries->size() ) : nb_entries };
 
-					if( no_translation )
-						ImGui::PushFont( ImGui_fzn::s_ImGuiFormatOptions.m_pFontItalic );
+			// Only the visible rows are submitted, the clipper skipping the others.
+			ImGuiListClipper clipper;
+			clipper.Begin( static_cast< int >( nb_rows ) );
 
-					ImGui::InputTextWithHint( fzn::Tools::Sprintf( "##%s_translation_%d", entry.m_name.c_str(), translation_id ).c_str(), "<No Translation>", &translation );
-
-					if( no_translation )
-						ImGui::PopFont();
-					else
-						ImGui_fzn::simple_tooltip_on_hover( translation.c_str() );
-					
-					++translation_id;
-				}
-
-				if( missing_translations.empty() == false )
-				{
-					if( entry_hovered )
-					{
-						for( const std::string& language : missing_translations )
-						{
-							fzn::Tools::sprintf_cat( missing_translations_tooltip, "%s%s", missing_translations_tooltip.empty() ? "" : ", ", language.c_str() );
-						}
-
-						ImGui::SetTooltip( "%d missing translations: %s", missing_translations.size(), missing_translations_tooltip.c_str() );
-					}
-				}
-
-				if( ImGui::TableGetHoveredRow() - 1 == entry_id )
-				{
-					ImGui::GetCurrentTable()->RowBgColor[ 1 ] = ImGui::GetColorU32( ImGui::GetStyleColorVec4( ImGuiCol_Header ) );
-					hovered_row = entry_id;
-				}
-				else if( missing_translations.empty() == false )
-				{
-					missing_translations_bg_color = ImLerp( darker_yellow, darker_red, missing_translations_ratio );
-					ImGui::GetCurrentTable()->RowBgColor[ 1 ] = ImGui::GetColorU32( missing_translations_bg_color );
-				}
-
-				++entry_id;
-				ImGui::PopID();
+			while( clipper.Step() )
+			{
+				for( int row{ clipper.DisplayStart }; row < clipper.DisplayEnd; ++row )
+					_display_entry( filtered_entries != nullptr ? ( *filtered_entries )[ row ] : static_cast< uint32_t >( row ), hovered_row );
 			}
 
-			_display_new_entry( entry_id );
-			_test_entry( entry_id );
+			clipper.End();
 
-			if( ImGui::TableGetHoveredRow() - 1 == entry_id )
+			ImGui::TableNextRow();
+			_display_new_entry( nb_entries );
+			_test_entry( nb_entries );
+
+			if( ImGui::TableGetHoveredRow() == ImGui::TableGetRowIndex() )
 			{
 				ImGui::GetCurrentTable()->RowBgColor[ 1 ] = ImGui::GetColorU32( ImGui::GetStyleColorVec4( ImGuiCol_Header ) );
 				hovered_row = -1;
@@ -375,6 +338,8 @@ namespace TR
 					if( ImGui::MenuItem( fzn::Tools::Sprintf( "Remove '%s'", m_loc_data.m_entries[ hovered_row ].m_name.c_str() ).c_str() ) )
 					{
 						m_loc_data.m_entries.erase( m_loc_data.m_entries.begin() + hovered_row );
+						m_entries_stats.on_entry_removed( hovered_row );
+						m_search_index.on_entry_removed( hovered_row );
 						hovered_row = -1;
 					}
 
@@ -398,6 +363,114 @@ namespace TR
 		}
 	}
 
+	/**
+	* @brief Display a row of the entries table.
+	* @param _entry_id The ID of the entry to display.
+	* @param [out] _hovered_row Set to the entry ID if the row is hovered.
+	**/
+	void TranslatR::_display_entry( uint32_t _entry_id, int& _hovered_row )
+	{
+		fzn::Localisation::Entry& entry{ m_loc_data.m_entries[ _entry_id ] };
+		const uint32_t nb_missing_translations{ m_entries_stats.get_nb_missing_translations( _entry_id ) };
+		float missing_translations_ratio{ 0.f };
+
+		ImGui::TableNextRow();
+		ImGui::PushID( &entry );
+
+		ImGui::TableNextColumn();
+		ImGui::AlignTextToFramePadding();
+		ImGui::Text( "%d", _entry_id );
+
+		ImGui::TableNextColumn();
+		ImGui::SetNextItemWidth( ImGui::GetContentRegionAvail().x );
+
+		if( nb_missing_translations > 0 )
+		{
+			missing_translations_ratio = entry.m_translations.size() > 1 ? static_cast< float >( nb_missing_translations - 1 ) / ( entry.m_translations.size() - 1 ) : 1.f;
+			ImGui::PushStyleColor( ImGuiCol_Text, ImLerp( ImGui_fzn::color::light_yellow, ImGui_fzn::color::light_red, missing_translations_ratio ) );
+			ImGui::PushFont( ImGui_fzn::s_ImGuiFormatOptions.m_pFontBold );
+		}
+
+		if( ImGui::InputTextWithHint( "##EntryName", "<Entry Name>", &entry.m_name ) )
+		{
+			m_entries_stats.on_name_changed( _entry_id, entry );
+			m_search_index.on_name_changed( _entry_id, entry );
+		}
+
+		if( nb_missing_translations > 0 )
+		{
+			ImGui::PopFont();
+			ImGui::PopStyleColor();
+		}
+
+		const bool entry_hovered{ ImGui::IsItemHovered() };
+
+		for( uint32_t translation_id{ 0 }; translation_id < entry.m_translations.size(); ++translation_id )
+		{
+			std::string& translation{ entry.m_translations[ translation_id ] };
+
+			ImGui::TableNextColumn();
+			ImGui::SetNextItemWidth( ImGui::GetContentRegionAvail().x );
+
+			const bool no_translation{ translation.empty() };
+
+			if( no_translation )
+				ImGui::PushFont( ImGui_fzn::s_ImGuiFormatOptions.m_pFontItalic );
+
+			ImGui::PushID( translation_id );
+			if( ImGui::InputTextWithHint( "##translation", "<No Translation>", &translation ) )
+			{
+				m_entries_stats.on_translations_changed( _entry_id, entry );
+				m_search_index.on_translation_changed( _entry_id, translation_id, entry );
+			}
+			ImGui::PopID();
+
+			if( no_translation )
+				ImGui::PopFont();
+			else
+				ImGui_fzn::simple_tooltip_on_hover( translation.c_str() );
+		}
+
+		// The list of the missing languages is only built for the hovered entry.
+		if( nb_missing_translations > 0 && entry_hovered )
+		{
+			std::string missing_translations_tooltip;
+
+			for( uint32_t translation_id{ 0 }; translation_id < entry.m_translations.size() && translation_id < m_loc_data.m_languages.size(); ++translation_id )
+			{
+				if( entry.m_translations[ translation_id ].empty() )
+					fzn::Tools::sprintf_cat( missing_translations_tooltip, "%s%s", missing_translations_tooltip.empty() ? "" : ", ", m_loc_data.m_languages[ translation_id ].c_str() );
+			}
+
+			ImGui::SetTooltip( "%d missing translations: %s", nb_missing_translations, missing_translations_tooltip.c_str() );
+		}
+
+		if( ImGui::TableGetHoveredRow() == ImGui::TableGetRowIndex() )
+		{
+			ImGui::GetCurrentTable()->RowBgColor[ 1 ] = ImGui::GetColorU32( ImGui::GetStyleColorVec4( ImGuiCol_Header ) );
+			_hovered_row = _entry_id;
+		}
+		else if( nb_missing_translations > 0 )
+		{
+			ImGui::GetCurrentTable()->RowBgColor[ 1 ] = ImGui::GetColorU32( ImLerp( darker_yellow, darker_red, missing_translations_ratio ) );
+		}
+
+		ImGui::PopID();
+	}
+
+	/**
+	* @brief Add an entry at the end of the entries list, with an empty translation for each language.
+	* @param _name The name of the new entry.
+	**/
+	void TranslatR::_add_entry( const std::string& _name )
+	{
+		fzn::Localisation::Entry new_entry{ _name };
+		new_entry.m_translations.resize( m_loc_data.m_languages.size(), "" );
+		m_loc_data.m_entries.push_back( std::move( new_entry ) );
+		m_entries_stats.on_entry_added( m_loc_data.m_entries.back() );
+		m_search_index.on_entry_added( m_loc_data.m_entries.back() );
+	}
+
 	/**
 	* @brief Display the last table line that is used to add an entry to the localisation.
 	* @param _row_id The last table row number
@@ -414,9 +487,7 @@ namespace TR
 
 		if( ImGui::IsItemDeactivatedAfterEdit() && m_new_entry.empty() == false )
 		{
-			fzn::Localisation::Entry new_entry{ m_new_entry };
-			new_entry.m_translations.resize( m_loc_data.m_languages.size(), "" );
-			m_loc_data.m_entries.push_back( std::move( new_entry ) );
+			_add_entry( m_new_entry );
 			m_new_entry.clear();
 		}
 	}
@@ -473,9 +544,7 @@ namespace TR
 			}
 			else if( ImGui::IsItemDeactivatedAfterEdit() && m_new_entry.empty() == false )
 			{
-				fzn::Localisation::Entry new_entry{ m_new_entry };
-				new_entry.m_translations.resize( m_loc_data.m_languages.size(), "" );
-				m_loc_data.m_entries.push_back( std::move( new_entry ) );
+				_add_entry( m_new_entry );
 				m_new_entry.clear();
 				clicked = false;
 			}
@@ -603,6 +672,8 @@ namespace TR
 		{
 			entry.m_translations.resize( m_loc_data.m_languages.size() );
 		}
+
+		_rebuild_entries_caches();
 	}
 
 	/**
@@ -622,6 +693,7 @@ namespace TR
 			entry.m_translations.erase( entry.m_translations.begin() + _language_id );
 
 		m_loc_data.m_languages.erase( m_loc_data.m_languages.begin() + _language_id );
+		_rebuild_entries_caches();
 
 		FZN_DBLOG( "'%s' removed successfully.", language_to_remove.c_str() );
 	}
@@ -638,6 +710,16 @@ namespace TR
 			entry.m_translations.clear();
 
 		m_loc_data.m_languages.clear();
+		_rebuild_entries_caches();
+	}
+
+	/**
+	* @brief Compute the entries statistics and search index from scratch, after the entries or languages have been replaced.
+	**/
+	void TranslatR::_rebuild_entries_caches()
+	{
+		m_entries_stats.rebuild( m_loc_data );
+		m_search_index.rebuild( m_loc_data );
 	}
 
 } // namespace TR
@@ -5,7 +5,9 @@
 #include <FZN/Defines.h>
 #include <FZN/Managers/LocalisationManager.h>
 
+#include "TR/EntriesStats.h"
 #include "TR/FileManager.h"
+#include "TR/SearchIndex.h"
 #include "TR/Options.h"
 
 
@@ -36,10 +38,25 @@ namespace TR
 		**/
 		void _display_menu_bar();
 		/**
+		* @brief Display the filter of the entries table and the field it applies to.
+		**/
+		void _display_filter();
+		/**
 		* @brief Display and manage localisation entries.
 		**/
 		void _display_entries();
 		/**
+		* @brief Display a row of the entries table.
+		* @param _entry_id The ID of the entry to display.
+		* @param [out] _hovered_row Set to the entry ID if the row is hovered.
+		**/
+		void _display_entry( uint32_t _entry_id, int& _hovered_row );
+		/**
+		* @brief Add an entry at the end of the entries list, with an empty translation for each language.
+		* @param _name The name of the new entry.
+		**/
+		void _add_entry( const std::string& _name );
+		/**
 		* @brief Display the last table line that is used to add an entry to the localisation.
 		* @param _row_id The last table row number
 		**/
@@ -67,9 +84,15 @@ namespace TR
 		* @brief Remove all the languages from the project and clear them from all the entries.
 		**/
 		void _remove_all_languages();
+		/**
+		* @brief Compute the entries statistics and search index from scratch, after the entries or languages have been replaced.
+		**/
+		void _rebuild_entries_caches();
 
 	private:
 		fzn::Localisation::LocalisationData	m_loc_data;			// Current project localisation data.
+		EntriesStats						m_entries_stats;	// Statistics about the entries, updated on each edit.
+		SearchIndex							m_search_index;		// Index of the entries names and translations used by the filter, updated on each edit.
 
 		FileManager		m_file_manager;
 		Options			m_options;
@@ -78,5 +101,7 @@ namespace TR
 		StringVector	m_new_languages{};						// The languages added by the popup.
 		std::string		m_new_language{};						// The language to add in the languages list of the popup.
 		bool			m_show_new_language_popup{ false }; 	// True if we are currently displaying the language addition popup.
+		std::string		m_filter{};								// Only the entries containing those words are displayed.
+		uint32_t		m_filter_field{ SearchIndex::all_fields };	// The field the filter applies to: all_fields, name_field or a language ID.
 	};
 }
@@ -0,0 +1,491 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Agents ticking the same behavior, with a BTElement tree each and with a shared BTFlatTree
+//------------------------------------------------------------------------
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <FZN/Includes.h>
+#include <FZN/Game/BehaviorTree/BTBasicElements.h>
+#include <FZN/Game/BehaviorTree/BTComposites.h>
+#include <FZN/Game/BehaviorTree/BTDecorators.h>
+#include <FZN/Game/BehaviorTree/BTFlatTree.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		using State = fzn::BTElement::State;
+
+		static constexpr int	NbAgents{ 1000 };
+		static constexpr int	NbTicks{ 50 };
+		static constexpr int	NbRuns{ 5 };
+		static constexpr float	DeltaTime{ 1.f / 60.f };
+		static constexpr int	NbRandomTrees{ 2000 };
+		static constexpr int	NbRandomTicks{ 30 };
+		static constexpr int	MaxScriptedLeaves{ 64 };
+
+		/////////////////AGENTS/////////////////
+
+		//The leaves only use the agent data, so both trees make the agents evolve the same way as long as they call the same leaves in the same order.
+		struct Agent
+		{
+			uint32_t Next()
+			{
+				m_uRandom ^= m_uRandom << 13;
+				m_uRandom ^= m_uRandom >> 17;
+				m_uRandom ^= m_uRandom << 5;
+				return m_uRandom;
+			}
+
+			bool operator==( const Agent& _oAgent ) const
+			{
+				return m_uRandom == _oAgent.m_uRandom && m_fThreat == _oAgent.m_fThreat && m_iAmmo == _oAgent.m_iAmmo && m_fHunger == _oAgent.m_fHunger && m_iNbActions == _oAgent.m_iNbActions;
+			}
+
+			uint32_t	m_uRandom{ 1 };
+			float		m_fThreat{ 0.f };
+			int			m_iAmmo{ 0 };
+			float		m_fHunger{ 0.f };
+			int			m_iNbActions{ 0 };
+		};
+
+		bool IsThreatened( const Agent& _oAgent )	{ return _oAgent.m_fThreat > 0.5f; }
+		bool HasAmmo( const Agent& _oAgent )		{ return _oAgent.m_iAmmo > 0; }
+		bool IsHungry( const Agent& _oAgent )		{ return _oAgent.m_fHunger > 0.8f; }
+
+		State Shoot( Agent& _oAgent )
+		{
+			--_oAgent.m_iAmmo;
+			_oAgent.m_fThreat -= 0.3f;
+			++_oAgent.m_iNbActions;
+			return _oAgent.Next() % 3 == 0 ? State::Running : State::Success;
+		}
+
+		State Reload( Agent& _oAgent )
+		{
+			++_oAgent.m_iNbActions;
+
+			if( _oAgent.Next() % 2 == 0 )
+				return State::Running;
+
+			_oAgent.m_iAmmo = 5;
+			return State::Success;
+		}
+
+		State Eat( Agent& _oAgent )
+		{
+			_oAgent.m_fHunger = 0.f;
+			++_oAgent.m_iNbActions;
+			return State::Success;
+		}
+
+		State Walk( Agent& _oAgent )
+		{
+			_oAgent.m_fHunger += 0.01f;
+			++_oAgent.m_iNbActions;
+			return _oAgent.Next() % 4 == 0 ? State::Running : State::Success;
+		}
+
+		State LookAround( Agent& _oAgent )
+		{
+			_oAgent.m_fThreat += (float)( _oAgent.Next() % 100 ) * 0.003f;
+			++_oAgent.m_iNbActions;
+			return State::Success;
+		}
+
+		State Idle( Agent& _oAgent )
+		{
+			_oAgent.m_fHunger += 0.002f;
+			return State::Success;
+		}
+
+		std::vector< Agent > CreateAgents( fzn::Random& _oRandom, int _iNbAgents )
+		{
+			std::vector< Agent > oAgents( _iNbAgents );
+
+			for( Agent& oAgent : oAgents )
+			{
+				oAgent.m_uRandom	= _oRandom.GetValue( 1, UINT32_MAX );
+				oAgent.m_fThreat	= _oRandom.GetFloat();
+				oAgent.m_iAmmo		= _oRandom.GetInt( 0, 5 );
+				oAgent.m_fHunger	= _oRandom.GetFloat();
+			}
+
+			return oAgents;
+		}
+
+
+		/////////////////POINTER TREE/////////////////
+
+		class ActionLeaf : public fzn::BTElement
+		{
+		public:
+			ActionLeaf( State ( *_pFct )( Agent& ), Agent& _oAgent ) : m_pFct( _pFct ), m_pAgent( &_oAgent ) {}
+			State Update() override { return m_pFct( *m_pAgent ); }
+
+		private:
+			State	( *m_pFct )( Agent& );
+			Agent*	m_pAgent;
+		};
+
+		class ConditionLeaf : public fzn::BTElement
+		{
+		public:
+			ConditionLeaf( bool ( *_pFct )( const Agent& ), Agent& _oAgent ) : m_pFct( _pFct ), m_pAgent( &_oAgent ) {}
+			State Update() override { return m_pFct( *m_pAgent ) ? State::Success : State::Failure; }
+
+		private:
+			bool	( *m_pFct )( const Agent& );
+			Agent*	m_pAgent;
+		};
+
+		template< typename CompositeType >
+		fzn::BTElement* CreateComposite( std::initializer_list< fzn::BTElement* > _oChildren )
+		{
+			CompositeType* pComposite = new CompositeType;
+
+			for( fzn::BTElement* pChild : _oChildren )
+				pComposite->AddChild( pChild );
+
+			return pComposite;
+		}
+
+		//Each agent needs its own tree, the nodes holding the execution state.
+		fzn::BTElement* CreatePointerTree( Agent& _oAgent )
+		{
+			fzn::Repeat* pPatrol = new fzn::Repeat( CreateComposite< fzn::Sequence >( { new ActionLeaf( &Walk, _oAgent ), new ActionLeaf( &LookAround, _oAgent ) } ) );
+			pPatrol->SetCount( 3 );
+
+			return CreateComposite< fzn::Selector >(
+			{
+				CreateComposite< fzn::Sequence >(
+				{
+					new ConditionLeaf( &IsThreatened, _oAgent ),
+					CreateComposite< fzn::Selector >(
+					{
+						CreateComposite< fzn::Sequence >( { new ConditionLeaf( &HasAmmo, _oAgent ), new ActionLeaf( &Shoot, _oAgent ) } ),
+						new ActionLeaf( &Reload, _oAgent ),
+					} ),
+				} ),
+				CreateComposite< fzn::Sequence >( { new ConditionLeaf( &IsHungry, _oAgent ), new ActionLeaf( &Eat, _oAgent ) } ),
+				CreateComposite< fzn::Sequence >( { new fzn::Reverse( new ConditionLeaf( &IsThreatened, _oAgent ) ), pPatrol } ),
+				new ActionLeaf( &Idle, _oAgent ),
+			} );
+		}
+
+
+		/////////////////FLAT TREE/////////////////
+
+		template< State ( *Fct )( Agent& ) >
+		State FlatAction( void* _pAgent, fzn::BTBlackboard& /*_oBlackboard*/, float /*_fDeltaTime*/ )
+		{
+			return Fct( *static_cast< Agent* >( _pAgent ) );
+		}
+
+		template< bool ( *Fct )( const Agent& ) >
+		bool FlatCondition( void* _pAgent, const fzn::BTBlackboard& /*_oBlackboard*/ )
+		{
+			return Fct( *static_cast< const Agent* >( _pAgent ) );
+		}
+
+		//Same behavior as CreatePointerTree, built once for all the agents.
+		bool BuildFlatTree( fzn::BTFlatTree& _oTree )
+		{
+			_oTree.AddSelector();
+				_oTree.AddSequence();
+					_oTree.AddCondition( &FlatCondition< &IsThreatened > );
+					_oTree.AddSelector();
+						_oTree.AddSequence();
+							_oTree.AddCondition( &FlatCondition< &HasAmmo > );
+							_oTree.AddAction( &FlatAction< &Shoot > );
+						_oTree.EndNode();
+						_oTree.AddAction( &FlatAction< &Reload > );
+					_oTree.EndNode();
+				_oTree.EndNode();
+				_oTree.AddSequence();
+					_oTree.AddCondition( &FlatCondition< &IsHungry > );
+					_oTree.AddAction( &FlatAction< &Eat > );
+				_oTree.EndNode();
+				_oTree.AddSequence();
+					_oTree.AddReverse();
+						_oTree.AddCondition( &FlatCondition< &IsThreatened > );
+					_oTree.EndNode();
+					_oTree.AddRepeat( 3 );
+						_oTree.AddSequence();
+							_oTree.AddAction( &FlatAction< &Walk > );
+							_oTree.AddAction( &FlatAction< &LookAround > );
+						_oTree.EndNode();
+					_oTree.EndNode();
+				_oTree.EndNode();
+				_oTree.AddAction( &FlatAction< &Idle > );
+			_oTree.EndNode();
+
+			return _oTree.Build();
+		}
+
+
+		/////////////////RANDOM TREES/////////////////
+
+		//Leaves returning a scripted sequence of states, and recording the order they are called in.
+		struct ScriptedRun
+		{
+			State Call( int _iLeaf )
+			{
+				m_oCalls.push_back( _iLeaf );
+
+				const std::vector< State >& oScript = ( *m_pScripts )[ _iLeaf ];
+				return oScript[ m_oPositions[ _iLeaf ]++ % oScript.size() ];
+			}
+
+			const std::vector< std::vector< State > >*	m_pScripts{ nullptr };
+			std::vector< size_t >						m_oPositions;
+			std::vector< int >							m_oCalls;
+		};
+
+		class ScriptedLeaf : public fzn::BTElement
+		{
+		public:
+			ScriptedLeaf( ScriptedRun& _oRun, int _iLeaf ) : m_pRun( &_oRun ), m_iLeaf( _iLeaf ) {}
+			State Update() override { return m_pRun->Call( m_iLeaf ); }
+
+		private:
+			ScriptedRun*	m_pRun;
+			int				m_iLeaf;
+		};
+
+		template< int Leaf >
+		State ScriptedAction( void* _pRun, fzn::BTBlackboard& /*_oBlackboard*/, float /*_fDeltaTime*/ )
+		{
+			return static_cast< ScriptedRun* >( _pRun )->Call( Leaf );
+		}
+
+		//The flat tree actions are plain functions, so each leaf index gets its own.
+		template< int... Leaves >
+		constexpr std::array< fzn::BTActionFct, sizeof...( Leaves ) > GetScriptedActions( std::integer_sequence< int, Leaves... > )
+		{
+			return { &ScriptedAction< Leaves >... };
+		}
+
+		static constexpr std::array< fzn::BTActionFct, MaxScriptedLeaves > s_aScriptedActions = GetScriptedActions( std::make_integer_sequence< int, MaxScriptedLeaves >{} );
+
+		//Builds the same random tree with both implementations. The Timers and Delayers aren't used: the BTElement ones read the time service, the flat ones the ticks delta time.
+		fzn::BTElement* CreateRandomTree( fzn::Random& _oRandom, fzn::BTFlatTree& _oTree, ScriptedRun& _oRun, int _iDepth, int& _iNbLeaves )
+		{
+			const int iNodeType = _iDepth > 3 || _iNbLeaves >= MaxScriptedLeaves - 4 ? 5 : _oRandom.GetInt( 0, 5 );
+
+			if( iNodeType <= 2 )
+			{
+				fzn::Composite* pComposite = nullptr;
+
+				if( iNodeType == 0 )
+				{
+					pComposite = new fzn::Sequence;
+					_oTree.AddSequence();
+				}
+				else if( iNodeType == 1 )
+				{
+					pComposite = new fzn::Selector;
+					_oTree.AddSelector();
+				}
+				else
+				{
+					pComposite = new fzn::Loop;
+					_oTree.AddLoop();
+				}
+
+				const int iNbChildren = _oRandom.GetInt( 1, 3 );
+
+				for( int iChild = 0; iChild < iNbChildren; ++iChild )
+					pComposite->AddChild( CreateRandomTree( _oRandom, _oTree, _oRun, _iDepth + 1, _iNbLeaves ) );
+
+				_oTree.EndNode();
+				return pComposite;
+			}
+
+			if( iNodeType == 3 )
+			{
+				const int iCount = _oRandom.GetInt( 1, 3 );
+				_oTree.AddRepeat( iCount );
+
+				fzn::Repeat* pRepeat = new fzn::Repeat( CreateRandomTree( _oRandom, _oTree, _oRun, _iDepth + 1, _iNbLeaves ) );
+				pRepeat->SetCount( iCount );
+
+				_oTree.EndNode();
+				return pRepeat;
+			}
+
+			if( iNodeType == 4 )
+			{
+				_oTree.AddReverse();
+				fzn::Reverse* pReverse = new fzn::Reverse( CreateRandomTree( _oRandom, _oTree, _oRun, _iDepth + 1, _iNbLeaves ) );
+				_oTree.EndNode();
+				return pReverse;
+			}
+
+			const int iLeaf = _iNbLeaves++;
+			_oTree.AddAction( s_aScriptedActions[ iLeaf ] );
+			return new ScriptedLeaf( _oRun, iLeaf );
+		}
+
+		int CheckRandomTrees( fzn::Random& _oRandom )
+		{
+			int iNbFailures = 0;
+
+			for( int iTree = 0; iTree < NbRandomTrees; ++iTree )
+			{
+				std::vector< std::vector< State > > oScripts;
+				ScriptedRun oPointerRun;
+				ScriptedRun oFlatRun;
+				fzn::BTFlatTree oTree;
+				int iNbLeaves = 0;
+
+				std::unique_ptr< fzn::BTElement > pRoot( CreateRandomTree( _oRandom, oTree, oPointerRun, 0, iNbLeaves ) );
+
+				if( oTree.Build() == false )
+				{
+					++iNbFailures;
+					continue;
+				}
+
+				oScripts.resize( iNbLeaves );
+
+				for( std::vector< State >& oScript : oScripts )
+				{
+					const int iScriptSize = _oRandom.GetInt( 1, 4 );
+
+					for( int iStep = 0; iStep < iScriptSize; ++iStep )
+					{
+						const int iState = _oRandom.GetInt( 0, 2 );
+						oScript.push_back( iState == 0 ? State::Success : iState == 1 ? State::Failure : State::Running );
+					}
+				}
+
+				for( ScriptedRun* pRun : { &oPointerRun, &oFlatRun } )
+				{
+					pRun->m_pScripts = &oScripts;
+					pRun->m_oPositions.assign( iNbLeaves, 0 );
+				}
+
+				fzn::BTFlatTreeInstance oInstance( oTree, &oFlatRun );
+
+				for( int iTick = 0; iTick < NbRandomTicks; ++iTick )
+				{
+					oPointerRun.m_oCalls.clear();
+					oFlatRun.m_oCalls.clear();
+
+					if( pRoot->Tick() != oInstance.Tick( DeltaTime ) || oPointerRun.m_oCalls != oFlatRun.m_oCalls )
+					{
+						++iNbFailures;
+						break;
+					}
+				}
+			}
+
+			return LogCheck( "Random trees, root states and leaves order", iNbFailures, NbRandomTrees );
+		}
+	}
+
+	int BehaviorTreeScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = CheckRandomTrees( oRandom );
+
+		fzn::BTFlatTree oTree;
+
+		if( BuildFlatTree( oTree ) == false )
+			return LogCheck( "Flat tree build", 1, 1 );
+
+		//A small population whose trees stay in the caches, then one where they don't.
+		for( const int iNbAgents : { NbAgents, NbAgents * 10 } )
+		{
+			const std::string sAgents = std::to_string( iNbAgents ) + " agents";
+			const std::vector< Agent > oInitialAgents = CreateAgents( oRandom, iNbAgents );
+			std::vector< Agent > oPointerAgents = oInitialAgents;
+			std::vector< Agent > oFlatAgents = oInitialAgents;
+
+			std::vector< std::unique_ptr< fzn::BTElement > > oPointerTrees;
+			oPointerTrees.reserve( iNbAgents );
+
+			for( Agent& oAgent : oPointerAgents )
+				oPointerTrees.emplace_back( CreatePointerTree( oAgent ) );
+
+			std::vector< fzn::BTFlatTreeInstance > oInstances;
+			oInstances.reserve( iNbAgents );
+
+			for( Agent& oAgent : oFlatAgents )
+				oInstances.emplace_back( oTree, &oAgent );
+
+			//Both versions have to give the same states and leave the agents in the same state.
+			int iNbMismatches = 0;
+
+			for( int iTick = 0; iTick < NbTicks; ++iTick )
+			{
+				for( int iAgent = 0; iAgent < iNbAgents; ++iAgent )
+					iNbMismatches += oPointerTrees[ iAgent ]->Tick() != oInstances[ iAgent ].Tick( DeltaTime ) ? 1 : 0;
+			}
+
+			for( int iAgent = 0; iAgent < iNbAgents; ++iAgent )
+				iNbMismatches += oPointerAgents[ iAgent ] == oFlatAgents[ iAgent ] ? 0 : 1;
+
+			iNbFailures += LogCheck( ( "Ticks of " + sAgents + ", pointer against flat tree" ).c_str(), iNbMismatches, iNbAgents * ( NbTicks + 1 ) );
+
+			const double dPointerTicks = Measure( NbRuns, [&]()
+			{
+				for( int iTick = 0; iTick < NbTicks; ++iTick )
+				{
+					for( std::unique_ptr< fzn::BTElement >& pTree : oPointerTrees )
+						pTree->Tick();
+				}
+			} );
+
+			const double dFlatTicks = Measure( NbRuns, [&]()
+			{
+				for( int iTick = 0; iTick < NbTicks; ++iTick )
+				{
+					for( fzn::BTFlatTreeInstance& oInstance : oInstances )
+						oInstance.Tick( DeltaTime );
+				}
+			} );
+
+			const double dPointerCreation = Measure( NbRuns, [&]()
+			{
+				std::vector< std::unique_ptr< fzn::BTElement > > oTrees;
+				oTrees.reserve( iNbAgents );
+
+				for( Agent& oAgent : oPointerAgents )
+					oTrees.emplace_back( CreatePointerTree( oAgent ) );
+
+				Consume( (double)oTrees.size() );
+			} );
+
+			const double dFlatCreation = Measure( NbRuns, [&]()
+			{
+				std::vector< fzn::BTFlatTreeInstance > oNewInstances;
+				oNewInstances.reserve( iNbAgents );
+
+				for( Agent& oAgent : oFlatAgents )
+					oNewInstances.emplace_back( oTree, &oAgent );
+
+				Consume( (double)oNewInstances.size() );
+			} );
+
+			LogTime( ( "Ticks, " + sAgents + ", BTElement trees" ).c_str(), dPointerTicks, iNbAgents * NbTicks );
+			LogTime( ( "Ticks, " + sAgents + ", shared BTFlatTree" ).c_str(), dFlatTicks, iNbAgents * NbTicks );
+			LogSpeedup( "BTFlatTree against BTElement", dPointerTicks, dFlatTicks );
+			LogTime( ( "Creation, " + sAgents + ", BTElement trees" ).c_str(), dPointerCreation, iNbAgents );
+			LogTime( ( "Creation, " + sAgents + ", BTFlatTree instances" ).c_str(), dFlatCreation, iNbAgents );
+			LogSpeedup( "BTFlatTree against BTElement", dPointerCreation, dFlatCreation );
+		}
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Timing and cross-check helpers shared by the benchmark scenes
+//------------------------------------------------------------------------
+
+#include <FZN/Includes.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	static volatile double g_dSink{ 0. };
+
+	void Consume( double _dValue )
+	{
+		g_dSink = g_dSink + _dValue;
+	}
+
+	void LogScene( const char* _sName )
+	{
+		FZN_COLOR_LOG( fzn::DBG_MSG_COL_CYAN, "========== %s ==========", _sName );
+	}
+
+	void LogTime( const char* _sLabel, double _dMilliseconds, int _iNbItems )
+	{
+		FZN_LOG( "%-48s %10.4f ms %12.2f ns/item", _sLabel, _dMilliseconds, _iNbItems > 0 ? _dMilliseconds * 1000000. / _iNbItems : 0. );
+	}
+
+	void LogSpeedup( const char* _sLabel, double _dReferenceMilliseconds, double _dMilliseconds )
+	{
+		FZN_COLOR_LOG( fzn::DBG_MSG_COL_GREEN, "%-48s x%.2f", _sLabel, _dMilliseconds > 0. ? _dReferenceMilliseconds / _dMilliseconds : 0. );
+	}
+
+	int LogCheck( const char* _sLabel, int _iNbFailures, int _iNbChecks )
+	{
+		if( _iNbFailures > 0 )
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "%-48s %d / %d mismatches", _sLabel, _iNbFailures, _iNbChecks );
+		else
+			FZN_COLOR_LOG( fzn::DBG_MSG_COL_GREEN, "%-48s %d checks passed", _sLabel, _iNbChecks );
+
+		return _iNbFailures;
+	}
+} //namespace Benchmark
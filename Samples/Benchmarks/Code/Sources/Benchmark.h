@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Timing and cross-check helpers shared by the benchmark scenes
+//------------------------------------------------------------------------
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace Benchmark
+{
+	static constexpr uint64_t Seed{ 19102026 };				//Same data at each run, so two runs (or two machines) can be compared
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Runs a function several times and measures the average duration of a run
+	//Parameter 1 : Number of measured runs, one more is done before to warm the caches
+	//Parameter 2 : Function to measure
+	//Return value : Average duration of a run (ms)
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	template< typename Function >
+	double Measure( int _iNbRuns, Function&& _fnRun )
+	{
+		_fnRun();
+
+		const std::chrono::steady_clock::time_point oStart = std::chrono::steady_clock::now();
+
+		for( int iRun = 0; iRun < _iNbRuns; ++iRun )
+			_fnRun();
+
+		const std::chrono::duration< double, std::milli > oDuration = std::chrono::steady_clock::now() - oStart;
+
+		return oDuration.count() / ( _iNbRuns > 0 ? _iNbRuns : 1 );
+	}
+
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Keeps the compiler from removing a computation whose result isn't used
+	//Parameter : Result of the computation
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void Consume( double _dValue );
+
+	void LogScene( const char* _sName );
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Logs the duration of a run and of each of its items
+	//Parameter 1 : Name of the measure
+	//Parameter 2 : Duration of a run (ms)
+	//Parameter 3 : Number of items processed by a run
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	void LogTime( const char* _sLabel, double _dMilliseconds, int _iNbItems );
+	void LogSpeedup( const char* _sLabel, double _dReferenceMilliseconds, double _dMilliseconds );
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	//Logs the result of a cross-check
+	//Parameter 1 : Name of the check
+	//Parameter 2 : Number of mismatches
+	//Parameter 3 : Number of compared values
+	//Return value : Number of mismatches
+	//------------------------------------------------------------------------------------------------------------------------------------------------------------------
+	int LogCheck( const char* _sLabel, int _iNbFailures, int _iNbChecks );
+
+
+	/////////////////SCENES/////////////////
+
+	//Each scene logs its timings and returns its number of mismatches.
+	int LocalisationScene();
+	int ContainersScene();
+	int BehaviorTreeScene();
+	int FormationScene();
+	int MathBatchScene();
+	int ConvexCollisionScene();
+	int VoicesScene();
+	int StateTableScene();
+	int SplineScene();
+	int CollisionWorldScene();
+	int RandomScene();
+} //namespace Benchmark
+
+#endif //_BENCHMARK_H_
@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Contacts of a collision world full of moving colliders against a brute force test of every pair, results and frame times
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <FZN/Includes.h>
+#include <FZN/Tools/CollisionWorld.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		static constexpr int	NbColliders{ 4000 };
+		static constexpr int	NbCheckedFrames{ 40 };						//Compared with the brute force at each frame
+		static constexpr int	NbTimedFrames{ 300 };
+		static constexpr int	NbReplacedPerFrame{ 20 };					//Colliders removed then added again somewhere else at each frame
+		static constexpr int	WorldSize{ 1200 };
+		static constexpr int	MaxSpeed{ 3 };
+
+		//Whole coordinates, so a lot of colliders exactly touch each other (shared edges, tangent circles).
+		struct Body
+		{
+			int				m_iCollider{ fzn::CollisionWorld::InvalidCollider };
+			uint32_t		m_uSerial{ 0 };								//Unique for each added collider, given as user data since the identifiers are reused
+			bool			m_bCircle{ false };
+			sf::Vector2f	m_vPosition{ 0.f, 0.f };					//Top left corner of the box or center of the circle
+			sf::Vector2f	m_vSize{ 0.f, 0.f };						//Box only
+			float			m_fRadius{ 0.f };							//Circle only
+			sf::Vector2f	m_vVelocity{ 0.f, 0.f };
+		};
+
+		sf::FloatRect GetBox( const Body& _oBody )
+		{
+			return sf::FloatRect( _oBody.m_vPosition, _oBody.m_vSize );
+		}
+
+		void AddBody( fzn::CollisionWorld& _oWorld, fzn::Random& _oRandom, Body& _oBody, uint32_t& _uNextSerial )
+		{
+			_oBody.m_uSerial = _uNextSerial++;
+			_oBody.m_bCircle = _oRandom.GetInt( 0, 1 ) == 0;
+			_oBody.m_vPosition = sf::Vector2f( (float)_oRandom.GetInt( 0, WorldSize ), (float)_oRandom.GetInt( 0, WorldSize ) );
+			_oBody.m_vVelocity = sf::Vector2f( (float)_oRandom.GetInt( -MaxSpeed, MaxSpeed ), (float)_oRandom.GetInt( -MaxSpeed, MaxSpeed ) );
+
+			void* pUserData = reinterpret_cast< void* >( (uintptr_t)_oBody.m_uSerial );
+
+			if( _oBody.m_bCircle )
+			{
+				_oBody.m_fRadius = (float)_oRandom.GetInt( 2, 12 );
+				_oBody.m_iCollider = _oWorld.AddCircle( _oBody.m_vPosition, _oBody.m_fRadius, pUserData );
+			}
+			else
+			{
+				_oBody.m_vSize = sf::Vector2f( (float)_oRandom.GetInt( 4, 24 ), (float)_oRandom.GetInt( 4, 24 ) );
+				_oBody.m_iCollider = _oWorld.AddAABB( GetBox( _oBody ), pUserData );
+			}
+		}
+
+		void MoveBody( fzn::CollisionWorld& _oWorld, Body& _oBody )
+		{
+			_oBody.m_vPosition += _oBody.m_vVelocity;
+
+			if( _oBody.m_vPosition.x < 0.f || _oBody.m_vPosition.x > WorldSize )
+				_oBody.m_vVelocity.x = -_oBody.m_vVelocity.x;
+
+			if( _oBody.m_vPosition.y < 0.f || _oBody.m_vPosition.y > WorldSize )
+				_oBody.m_vVelocity.y = -_oBody.m_vVelocity.y;
+
+			if( _oBody.m_bCircle )
+				_oWorld.SetCircle( _oBody.m_iCollider, _oBody.m_vPosition, _oBody.m_fRadius );
+			else
+				_oWorld.SetAABB( _oBody.m_iCollider, GetBox( _oBody ) );
+		}
+
+		//Reference test, touching colliders being in contact.
+		bool AreTouching( const Body& _oBodyA, const Body& _oBodyB )
+		{
+			if( _oBodyA.m_bCircle && _oBodyB.m_bCircle )
+				return fzn::Tools::CollisionCircleCircle( _oBodyA.m_vPosition, _oBodyA.m_fRadius, _oBodyB.m_vPosition, _oBodyB.m_fRadius );
+
+			if( _oBodyA.m_bCircle )
+				return fzn::Tools::CollisionAABBCircle( GetBox( _oBodyB ), _oBodyA.m_vPosition, _oBodyA.m_fRadius );
+
+			if( _oBodyB.m_bCircle )
+				return fzn::Tools::CollisionAABBCircle( GetBox( _oBodyA ), _oBodyB.m_vPosition, _oBodyB.m_fRadius );
+
+			const sf::FloatRect oBoxA = GetBox( _oBodyA );
+			const sf::FloatRect oBoxB = GetBox( _oBodyB );
+
+			return oBoxA.left <= oBoxB.left + oBoxB.width && oBoxB.left <= oBoxA.left + oBoxA.width && oBoxA.top <= oBoxB.top + oBoxB.height && oBoxB.top <= oBoxA.top + oBoxA.height;
+		}
+
+		uint64_t GetPairKey( uint32_t _uSerialA, uint32_t _uSerialB )
+		{
+			return _uSerialA < _uSerialB ? ( (uint64_t)_uSerialA << 32 ) | _uSerialB : ( (uint64_t)_uSerialB << 32 ) | _uSerialA;
+		}
+
+		std::vector< uint64_t > GetBruteForceContacts( const std::vector< Body >& _oBodies )
+		{
+			std::vector< uint64_t > oContacts;
+
+			for( size_t uBodyA = 0; uBodyA < _oBodies.size(); ++uBodyA )
+			{
+				for( size_t uBodyB = uBodyA + 1; uBodyB < _oBodies.size(); ++uBodyB )
+				{
+					if( AreTouching( _oBodies[ uBodyA ], _oBodies[ uBodyB ] ) )
+						oContacts.push_back( GetPairKey( _oBodies[ uBodyA ].m_uSerial, _oBodies[ uBodyB ].m_uSerial ) );
+				}
+			}
+
+			std::sort( oContacts.begin(), oContacts.end() );
+
+			return oContacts;
+		}
+
+		std::vector< uint64_t > GetKeys( const std::vector< fzn::CollisionWorld::Contact >& _oContacts )
+		{
+			std::vector< uint64_t > oKeys;
+
+			for( const fzn::CollisionWorld::Contact& oContact : _oContacts )
+				oKeys.push_back( GetPairKey( (uint32_t)reinterpret_cast< uintptr_t >( oContact.m_pUserDataA ), (uint32_t)reinterpret_cast< uintptr_t >( oContact.m_pUserDataB ) ) );
+
+			std::sort( oKeys.begin(), oKeys.end() );
+
+			return oKeys;
+		}
+
+		//Pairs of the first list missing from the second one, both being sorted.
+		std::vector< uint64_t > GetDifference( const std::vector< uint64_t >& _oKeys, const std::vector< uint64_t >& _oRemovedKeys )
+		{
+			std::vector< uint64_t > oDifference;
+			std::set_difference( _oKeys.begin(), _oKeys.end(), _oRemovedKeys.begin(), _oRemovedKeys.end(), std::back_inserter( oDifference ) );
+
+			return oDifference;
+		}
+
+		//Counts the pairs found in only one of the two lists.
+		int CompareKeys( const std::vector< uint64_t >& _oKeys, const std::vector< uint64_t >& _oReference, int _iFrame, const char* _sWhat, int& _iNbChecks )
+		{
+			const int iNbMissing = (int)GetDifference( _oReference, _oKeys ).size();
+			const int iNbExtra = (int)GetDifference( _oKeys, _oReference ).size();
+
+			_iNbChecks += (int)_oReference.size() + iNbExtra;
+
+			if( iNbMissing + iNbExtra > 0 )
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Frame %d, %s: %d missing, %d extra", _iFrame, _sWhat, iNbMissing, iNbExtra );
+
+			return iNbMissing + iNbExtra;
+		}
+	}
+
+	int CollisionWorldScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = 0;
+		int iNbChecks = 0;
+
+		fzn::CollisionWorld oWorld;
+		std::vector< Body > oBodies( NbColliders );
+		uint32_t uNextSerial = 1;
+
+		for( Body& oBody : oBodies )
+			AddBody( oWorld, oRandom, oBody, uNextSerial );
+
+		std::vector< uint64_t > oPreviousContacts;
+		double dUpdates = 0.;
+		double dWorstUpdate = 0.;
+		double dRemovals = 0.;
+		double dBruteForce = 0.;
+		int iNbContacts = 0;
+
+		for( int iFrame = 0; iFrame < NbCheckedFrames + NbTimedFrames; ++iFrame )
+		{
+			const bool bChecked = iFrame < NbCheckedFrames;
+
+			//The removed contacts are reported as ended with the user data of the removed collider, even if a new one gets its identifier later.
+			const std::chrono::steady_clock::time_point oRemovalStart = std::chrono::steady_clock::now();
+
+			for( int iReplaced = 0; iReplaced < NbReplacedPerFrame; ++iReplaced )
+			{
+				const int iCollider = oBodies[ oRandom.GetInt( 0, NbColliders - 1 ) ].m_iCollider;
+
+				if( oWorld.IsColliderValid( iCollider ) )
+					oWorld.RemoveCollider( iCollider );
+			}
+
+			const std::chrono::duration< double, std::milli > oRemovals = std::chrono::steady_clock::now() - oRemovalStart;
+
+			for( Body& oBody : oBodies )
+			{
+				//Its identifier can belong to a new collider once an update freed it.
+				if( oWorld.IsColliderValid( oBody.m_iCollider ) && oWorld.GetUserData( oBody.m_iCollider ) == reinterpret_cast< void* >( (uintptr_t)oBody.m_uSerial ) )
+					MoveBody( oWorld, oBody );
+				else
+					AddBody( oWorld, oRandom, oBody, uNextSerial );
+			}
+
+			const std::chrono::steady_clock::time_point oUpdateStart = std::chrono::steady_clock::now();
+			oWorld.Update();
+			const std::chrono::duration< double, std::milli > oUpdate = std::chrono::steady_clock::now() - oUpdateStart;
+
+			iNbContacts += (int)oWorld.GetContacts().size();
+
+			if( bChecked == false )
+			{
+				dUpdates += oUpdate.count();
+				dWorstUpdate = fzn::Math::Max( dWorstUpdate, oUpdate.count() );
+				dRemovals += oRemovals.count();
+				continue;
+			}
+
+			const std::chrono::steady_clock::time_point oBruteForceStart = std::chrono::steady_clock::now();
+			const std::vector< uint64_t > oContacts = GetBruteForceContacts( oBodies );
+			const std::chrono::duration< double, std::milli > oBruteForce = std::chrono::steady_clock::now() - oBruteForceStart;
+
+			dBruteForce += oBruteForce.count();
+
+			iNbFailures += CompareKeys( GetKeys( oWorld.GetContacts() ), oContacts, iFrame, "contacts", iNbChecks );
+			iNbFailures += CompareKeys( GetKeys( oWorld.GetBeginContacts() ), GetDifference( oContacts, oPreviousContacts ), iFrame, "begin contacts", iNbChecks );
+			iNbFailures += CompareKeys( GetKeys( oWorld.GetEndContacts() ), GetDifference( oPreviousContacts, oContacts ), iFrame, "end contacts", iNbChecks );
+
+			oPreviousContacts = oContacts;
+		}
+
+		const std::string sColliders = std::to_string( NbColliders ) + " colliders";
+
+		LogTime( ( "Brute force, " + sColliders ).c_str(), dBruteForce / NbCheckedFrames, NbColliders );
+		LogTime( ( "CollisionWorld::Update, " + sColliders ).c_str(), dUpdates / NbTimedFrames, NbColliders );
+		LogSpeedup( "Update against the brute force", dBruteForce / NbCheckedFrames, dUpdates / NbTimedFrames );
+		LogTime( "RemoveCollider", dRemovals / NbTimedFrames, NbReplacedPerFrame );
+
+		FZN_LOG( "%-48s %10.4f ms", "Worst update", dWorstUpdate );
+		FZN_LOG( "%-48s %10d", "Contacts per frame", iNbContacts / ( NbCheckedFrames + NbTimedFrames ) );
+
+		iNbFailures = LogCheck( "Contacts against the brute force", iNbFailures, iNbChecks );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
@@ -0,0 +1,399 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Entity registration and lookup of the managers, with the old fzn containers, the std ones and DenseArray / HashMap
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <FZN/Includes.h>
+#include <FZN/DataStructure/DenseArray.h>
+#include <FZN/DataStructure/HashMap.h>
+#include <FZN/DataStructure/Map.h>
+#include <FZN/DataStructure/Vector.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		static constexpr int	NbEntities{ 2000 };				//Registered at the start, like the steering entities of a level
+		static constexpr int	NbFrames{ 100 };
+		static constexpr int	NbChangesPerFrame{ 20 };		//Entities unregistered then registered each frame
+		static constexpr int	NbLookups{ 4000 };
+		static constexpr int	NbRuns{ 20 };
+		static constexpr int	NbMapOperations{ 200000 };		//Random insertions, removals and searches compared to std::unordered_map
+
+		struct Entity
+		{
+			float m_fPosition{ 0.f };
+			float m_fVelocity{ 0.f };
+		};
+
+		//The same registrations and removals are replayed by each container.
+		struct Frame
+		{
+			std::vector< Entity* > m_oRemoved;
+			std::vector< Entity* > m_oAdded;
+		};
+
+		std::vector< Frame > BuildFrames( std::vector< Entity >& _oPool, fzn::Random& _oRandom )
+		{
+			std::vector< Entity* > oAlive;
+			std::vector< Entity* > oFree;
+
+			for( int iEntity = 0; iEntity < NbEntities; ++iEntity )
+				oAlive.push_back( &_oPool[ iEntity ] );
+
+			for( size_t uEntity = NbEntities; uEntity < _oPool.size(); ++uEntity )
+				oFree.push_back( &_oPool[ uEntity ] );
+
+			std::vector< Frame > oFrames( NbFrames );
+
+			for( Frame& oFrame : oFrames )
+			{
+				for( int iChange = 0; iChange < NbChangesPerFrame; ++iChange )
+				{
+					const int iRemoved = _oRandom.GetInt( 0, (int)oAlive.size() - 1 );
+					oFrame.m_oRemoved.push_back( oAlive[ iRemoved ] );
+					oFree.push_back( oAlive[ iRemoved ] );
+					oAlive[ iRemoved ] = oAlive.back();
+					oAlive.pop_back();
+				}
+
+				for( int iChange = 0; iChange < NbChangesPerFrame; ++iChange )
+				{
+					const int iAdded = _oRandom.GetInt( 0, (int)oFree.size() - 1 );
+					oFrame.m_oAdded.push_back( oFree[ iAdded ] );
+					oAlive.push_back( oFree[ iAdded ] );
+					oFree[ iAdded ] = oFree.back();
+					oFree.pop_back();
+				}
+			}
+
+			return oFrames;
+		}
+
+		//What SteeringManager and AIManager did before: the array is searched to find the entity to remove, and the removal shifts the ones after it.
+		struct OldRegistry
+		{
+			void Add( Entity* _pEntity ) { m_oEntities.PushBack( _pEntity ); }
+			void Remove( Entity* _pEntity ) { m_oEntities.Remove( m_oEntities.FindIndex( _pEntity ) ); }
+			int Size() const { return m_oEntities.Size(); }
+			Entity* Get( int _iIndex ) { return m_oEntities[ _iIndex ]; }
+
+			fzn::Vector< Entity* > m_oEntities{ NbEntities };
+		};
+
+		struct StdRegistry
+		{
+			void Add( Entity* _pEntity )
+			{
+				m_oIndices[ _pEntity ] = m_oEntities.size();
+				m_oEntities.push_back( _pEntity );
+			}
+
+			void Remove( Entity* _pEntity )
+			{
+				std::unordered_map< Entity*, size_t >::iterator itEntity = m_oIndices.find( _pEntity );
+
+				if( itEntity == m_oIndices.end() )
+					return;
+
+				const size_t uIndex = itEntity->second;
+				m_oIndices.erase( itEntity );
+
+				if( uIndex + 1 < m_oEntities.size() )
+				{
+					m_oEntities[ uIndex ] = m_oEntities.back();
+					m_oIndices[ m_oEntities[ uIndex ] ] = uIndex;
+				}
+
+				m_oEntities.pop_back();
+			}
+
+			int Size() const { return (int)m_oEntities.size(); }
+			Entity* Get( int _iIndex ) { return m_oEntities[ _iIndex ]; }
+
+			std::vector< Entity* >					m_oEntities;
+			std::unordered_map< Entity*, size_t >	m_oIndices;
+		};
+
+		//What SteeringManager does now.
+		struct DenseRegistry
+		{
+			using Handle = fzn::DenseArray< Entity* >::Handle;
+
+			void Add( Entity* _pEntity )
+			{
+				const int iIndex = m_oEntities.PushBack( _pEntity );
+				m_oHandles.Insert( _pEntity, m_oEntities.GetHandle( iIndex ) );
+			}
+
+			void Remove( Entity* _pEntity )
+			{
+				fzn::HashMap< Entity*, Handle >::Element* pHandle = m_oHandles.Find( _pEntity );
+
+				if( pHandle == nullptr )
+					return;
+
+				m_oEntities.Remove( pHandle->data );
+				m_oHandles.Remove( _pEntity );
+			}
+
+			int Size() const { return m_oEntities.Size(); }
+			Entity* Get( int _iIndex ) { return m_oEntities[ _iIndex ]; }
+
+			fzn::DenseArray< Entity* >			m_oEntities{ NbEntities };
+			fzn::HashMap< Entity*, Handle >		m_oHandles{ NbEntities };
+		};
+
+		template< typename Registry >
+		void Register( Registry& _oRegistry, std::vector< Entity >& _oPool )
+		{
+			for( int iEntity = 0; iEntity < NbEntities; ++iEntity )
+				_oRegistry.Add( &_oPool[ iEntity ] );
+		}
+
+		template< typename Registry >
+		void PlayFrames( Registry& _oRegistry, const std::vector< Frame >& _oFrames )
+		{
+			for( const Frame& oFrame : _oFrames )
+			{
+				for( Entity* pEntity : oFrame.m_oRemoved )
+					_oRegistry.Remove( pEntity );
+
+				for( Entity* pEntity : oFrame.m_oAdded )
+					_oRegistry.Add( pEntity );
+			}
+		}
+
+		//The update of the managers: every registered entity is read once per frame.
+		template< typename Registry >
+		double Update( Registry& _oRegistry )
+		{
+			double dPosition = 0.;
+
+			for( int iEntity = 0; iEntity < _oRegistry.Size(); ++iEntity )
+			{
+				const Entity* pEntity = _oRegistry.Get( iEntity );
+				dPosition += pEntity->m_fPosition + pEntity->m_fVelocity;
+			}
+
+			return dPosition;
+		}
+
+		template< typename Registry >
+		std::vector< Entity* > GetSortedEntities( Registry& _oRegistry )
+		{
+			std::vector< Entity* > oEntities;
+
+			for( int iEntity = 0; iEntity < _oRegistry.Size(); ++iEntity )
+				oEntities.push_back( _oRegistry.Get( iEntity ) );
+
+			std::sort( oEntities.begin(), oEntities.end() );
+			return oEntities;
+		}
+
+		int CheckRegistries( std::vector< Entity >& _oPool, const std::vector< Frame >& _oFrames )
+		{
+			OldRegistry oOld;
+			StdRegistry oStd;
+			DenseRegistry oDense;
+			Register( oOld, _oPool );
+			Register( oStd, _oPool );
+			Register( oDense, _oPool );
+			PlayFrames( oOld, _oFrames );
+			PlayFrames( oStd, _oFrames );
+			PlayFrames( oDense, _oFrames );
+
+			int iNbFailures = 0;
+			int iNbChecks = 2;
+			const std::vector< Entity* > oReference = GetSortedEntities( oOld );
+
+			iNbFailures += GetSortedEntities( oStd ) != oReference ? 1 : 0;
+			iNbFailures += GetSortedEntities( oDense ) != oReference ? 1 : 0;
+
+			//Every entity still registered has to be found through its handle, the removed ones must not.
+			for( Entity& oEntity : _oPool )
+			{
+				const bool bRegistered = std::binary_search( oReference.begin(), oReference.end(), &oEntity );
+				const fzn::HashMap< Entity*, DenseRegistry::Handle >::Element* pHandle = oDense.m_oHandles.Find( &oEntity );
+				Entity** pFound = pHandle != nullptr ? oDense.m_oEntities.Get( pHandle->data ) : nullptr;
+
+				iNbFailures += bRegistered != ( pFound != nullptr && *pFound == &oEntity ) ? 1 : 0;
+				++iNbChecks;
+			}
+
+			return LogCheck( "Registered entities and handles", iNbFailures, iNbChecks );
+		}
+
+		//Random operations on a small key range so the keys are often removed and inserted again.
+		int CheckHashMap( fzn::Random& _oRandom )
+		{
+			fzn::HashMap< uint32_t, uint32_t > oHashMap;
+			std::unordered_map< uint32_t, uint32_t > oReference;
+			int iNbFailures = 0;
+
+			for( int iOperation = 0; iOperation < NbMapOperations; ++iOperation )
+			{
+				const uint32_t uKey = _oRandom.GetValue( 0, 4999 );
+
+				switch( _oRandom.GetInt( 0, 2 ) )
+				{
+				case 0:
+					oHashMap.Insert( uKey, (uint32_t)iOperation );
+					oReference[ uKey ] = (uint32_t)iOperation;
+					break;
+				case 1:
+					iNbFailures += oHashMap.Remove( uKey ) != ( oReference.erase( uKey ) > 0 ) ? 1 : 0;
+					break;
+				default:
+				{
+					const fzn::HashMap< uint32_t, uint32_t >::Element* pElement = oHashMap.Find( uKey );
+					std::unordered_map< uint32_t, uint32_t >::const_iterator itElement = oReference.find( uKey );
+
+					if( ( pElement != nullptr ) != ( itElement != oReference.end() ) || ( pElement != nullptr && pElement->data != itElement->second ) )
+						++iNbFailures;
+
+					break;
+				}
+				}
+			}
+
+			iNbFailures += oHashMap.Size() != (int)oReference.size() ? 1 : 0;
+
+			for( const fzn::HashMap< uint32_t, uint32_t >::Element& oElement : oHashMap )
+			{
+				std::unordered_map< uint32_t, uint32_t >::const_iterator itElement = oReference.find( oElement.key );
+				iNbFailures += itElement == oReference.end() || itElement->second != oElement.data ? 1 : 0;
+			}
+
+			return LogCheck( "HashMap against std::unordered_map", iNbFailures, NbMapOperations + 1 + oHashMap.Size() );
+		}
+	}
+
+	int ContainersScene()
+	{
+		fzn::Random oRandom( Seed );
+		std::vector< Entity > oPool( NbEntities + NbFrames * NbChangesPerFrame );
+
+		for( Entity& oEntity : oPool )
+			oEntity = { oRandom.GetFloat( -100.f, 100.f ), oRandom.GetFloat( -1.f, 1.f ) };
+
+		const std::vector< Frame > oFrames = BuildFrames( oPool, oRandom );
+
+		int iNbFailures = CheckRegistries( oPool, oFrames );
+		iNbFailures += CheckHashMap( oRandom );
+
+		//Registration and removals.
+		const double dOldChanges = Measure( NbRuns, [&]() { OldRegistry oRegistry; Register( oRegistry, oPool ); PlayFrames( oRegistry, oFrames ); Consume( oRegistry.Size() ); } );
+		const double dStdChanges = Measure( NbRuns, [&]() { StdRegistry oRegistry; Register( oRegistry, oPool ); PlayFrames( oRegistry, oFrames ); Consume( oRegistry.Size() ); } );
+		const double dDenseChanges = Measure( NbRuns, [&]() { DenseRegistry oRegistry; Register( oRegistry, oPool ); PlayFrames( oRegistry, oFrames ); Consume( oRegistry.Size() ); } );
+
+		const int iNbChanges = NbEntities + 2 * NbFrames * NbChangesPerFrame;
+		LogTime( "Registrations, fzn::Vector", dOldChanges, iNbChanges );
+		LogTime( "Registrations, std::vector + unordered_map", dStdChanges, iNbChanges );
+		LogTime( "Registrations, DenseArray + HashMap", dDenseChanges, iNbChanges );
+		LogSpeedup( "DenseArray against fzn::Vector", dOldChanges, dDenseChanges );
+		LogSpeedup( "DenseArray against std", dStdChanges, dDenseChanges );
+
+		//Update pass on the registered entities.
+		OldRegistry oOld;
+		StdRegistry oStd;
+		DenseRegistry oDense;
+		Register( oOld, oPool );
+		Register( oStd, oPool );
+		Register( oDense, oPool );
+
+		const double dOldUpdate = Measure( NbRuns * 10, [&]() { Consume( Update( oOld ) ); } );
+		const double dStdUpdate = Measure( NbRuns * 10, [&]() { Consume( Update( oStd ) ); } );
+		const double dDenseUpdate = Measure( NbRuns * 10, [&]() { Consume( Update( oDense ) ); } );
+
+		//operator[] checks the index, the range for reads the elements directly.
+		const double dDenseRangeUpdate = Measure( NbRuns * 10, [&]()
+		{
+			double dPosition = 0.;
+
+			for( const Entity* pEntity : oDense.m_oEntities )
+				dPosition += pEntity->m_fPosition + pEntity->m_fVelocity;
+
+			Consume( dPosition );
+		} );
+
+		LogTime( "Update pass, fzn::Vector", dOldUpdate, NbEntities );
+		LogTime( "Update pass, std::vector", dStdUpdate, NbEntities );
+		LogTime( "Update pass, DenseArray", dDenseUpdate, NbEntities );
+		LogTime( "Update pass, DenseArray (range for)", dDenseRangeUpdate, NbEntities );
+		LogSpeedup( "DenseArray against fzn::Vector", dOldUpdate, dDenseUpdate );
+		LogSpeedup( "DenseArray range for against fzn::Vector", dOldUpdate, dDenseRangeUpdate );
+
+		//Lookups by key, like the IDs of AIManager::GetGameObject.
+		fzn::Map< uint32_t, uint32_t > oOldMap;
+		std::unordered_map< uint32_t, uint32_t > oStdMap;
+		fzn::HashMap< uint32_t, uint32_t > oHashMap;
+		std::vector< uint32_t > oKeys( NbLookups );
+
+		for( uint32_t uKey = 0; uKey < NbEntities; ++uKey )
+		{
+			oOldMap[ uKey * 7 ] = uKey;
+			oStdMap[ uKey * 7 ] = uKey;
+			oHashMap.Insert( uKey * 7, uKey );
+		}
+
+		//Half of the searched keys are missing.
+		for( uint32_t& uKey : oKeys )
+			uKey = oRandom.GetValue( 0, NbEntities * 14 - 1 ) / 7 * 7 + ( oRandom.GetBool() ? 0 : 1 );
+
+		const double dOldLookups = Measure( NbRuns, [&]()
+		{
+			uint32_t uSum = 0;
+
+			for( uint32_t uKey : oKeys )
+			{
+				fzn::Map< uint32_t, uint32_t >::MapElement* pElement = oOldMap.Find( uKey );
+				uSum += pElement != nullptr ? pElement->data : 0;
+			}
+
+			Consume( uSum );
+		} );
+
+		const double dStdLookups = Measure( NbRuns, [&]()
+		{
+			uint32_t uSum = 0;
+
+			for( uint32_t uKey : oKeys )
+			{
+				std::unordered_map< uint32_t, uint32_t >::const_iterator itElement = oStdMap.find( uKey );
+				uSum += itElement != oStdMap.end() ? itElement->second : 0;
+			}
+
+			Consume( uSum );
+		} );
+
+		const double dHashLookups = Measure( NbRuns, [&]()
+		{
+			uint32_t uSum = 0;
+
+			for( uint32_t uKey : oKeys )
+			{
+				const fzn::HashMap< uint32_t, uint32_t >::Element* pElement = oHashMap.Find( uKey );
+				uSum += pElement != nullptr ? pElement->data : 0;
+			}
+
+			Consume( uSum );
+		} );
+
+		LogTime( "Lookups, fzn::Map", dOldLookups, NbLookups );
+		LogTime( "Lookups, std::unordered_map", dStdLookups, NbLookups );
+		LogTime( "Lookups, HashMap", dHashLookups, NbLookups );
+		LogSpeedup( "HashMap against fzn::Map", dOldLookups, dHashLookups );
+		LogSpeedup( "HashMap against std::unordered_map", dStdLookups, dHashLookups );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
@@ -0,0 +1,345 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : GJK and EPA queries against a separating axis reference on random polygons, circles, capsules and boxes
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <string>
+
+#include <FZN/Includes.h>
+#include <FZN/Tools/ConvexCollision.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		using Type = fzn::ConvexCollider::Type;
+
+		static constexpr int	NbPairs{ 20000 };					//Per combination of types
+		static constexpr int	NbTimedPairs{ 10000 };
+		static constexpr int	NbRuns{ 20 };
+		static constexpr float	WorldSize{ 50.f };
+		static constexpr float	Tolerance{ 2e-2f };					//Absolute, EPA stops once the polytope is this close to the shape
+		static constexpr float	ContactTolerance{ 1e-3f };			//Pairs touching within this distance aren't checked for collision
+
+		static const Type s_aTypes[] = { Type::Polygon, Type::Circle, Type::Capsule, Type::OBB };
+		static const char* s_aTypeNames[] = { "polygon", "circle", "capsule", "OBB" };
+
+		//Shape described as the collider sees it: a core and a radius. The reference only works on the core points, the collider keeps a pointer on them.
+		struct Shape
+		{
+			Type						m_eType;
+			std::vector< sf::Vector2f >	m_oCore;
+			float						m_fRadius{ 0.f };
+			sf::Vector2f				m_vCenter;
+			sf::Vector2f				m_vHalfExtents;
+			float						m_fAngle{ 0.f };
+		};
+
+		Shape CreateShape( fzn::Random& _oRandom, Type _eType )
+		{
+			Shape oShape;
+			oShape.m_eType = _eType;
+			oShape.m_vCenter = { _oRandom.GetFloat( -WorldSize, WorldSize ), _oRandom.GetFloat( -WorldSize, WorldSize ) };
+
+			switch( _eType )
+			{
+				case Type::Polygon:
+				{
+					//Points on a circle at sorted angles, so the polygon is convex.
+					std::vector< float > oAngles( _oRandom.GetInt( 3, 8 ) );
+					const float fRadius = _oRandom.GetFloat( 5.f, 40.f );
+
+					for( float& fAngle : oAngles )
+						fAngle = _oRandom.GetFloat( 0.f, 2.f * fzn::Math::PI );
+
+					std::sort( oAngles.begin(), oAngles.end() );
+
+					for( float fAngle : oAngles )
+						oShape.m_oCore.push_back( oShape.m_vCenter + sf::Vector2f( std::cos( fAngle ), std::sin( fAngle ) ) * fRadius );
+
+					break;
+				}
+				case Type::Circle:
+				{
+					oShape.m_oCore.push_back( oShape.m_vCenter );
+					oShape.m_fRadius = _oRandom.GetFloat( 1.f, 30.f );
+					break;
+				}
+				case Type::Capsule:
+				{
+					const sf::Vector2f vHalfSegment( _oRandom.GetFloat( -25.f, 25.f ), _oRandom.GetFloat( -25.f, 25.f ) );
+					oShape.m_oCore.push_back( oShape.m_vCenter - vHalfSegment );
+					oShape.m_oCore.push_back( oShape.m_vCenter + vHalfSegment );
+					oShape.m_fRadius = _oRandom.GetFloat( 1.f, 20.f );
+					break;
+				}
+				case Type::OBB:
+				{
+					oShape.m_vHalfExtents = { _oRandom.GetFloat( 2.f, 30.f ), _oRandom.GetFloat( 2.f, 30.f ) };
+					oShape.m_fAngle = _oRandom.GetFloat( 0.f, 2.f * fzn::Math::PI );
+
+					const sf::Vector2f vAxisX = sf::Vector2f( std::cos( oShape.m_fAngle ), std::sin( oShape.m_fAngle ) ) * oShape.m_vHalfExtents.x;
+					const sf::Vector2f vAxisY = sf::Vector2f( -std::sin( oShape.m_fAngle ), std::cos( oShape.m_fAngle ) ) * oShape.m_vHalfExtents.y;
+					oShape.m_oCore = { oShape.m_vCenter - vAxisX - vAxisY, oShape.m_vCenter + vAxisX - vAxisY, oShape.m_vCenter + vAxisX + vAxisY, oShape.m_vCenter - vAxisX + vAxisY };
+					break;
+				}
+				default:
+					break;
+			}
+
+			return oShape;
+		}
+
+		fzn::ConvexCollider GetCollider( const Shape& _oShape )
+		{
+			switch( _oShape.m_eType )
+			{
+				case Type::Circle:	return fzn::ConvexCollider::Circle( _oShape.m_vCenter, _oShape.m_fRadius );
+				case Type::Capsule:	return fzn::ConvexCollider::Capsule( _oShape.m_oCore[ 0 ], _oShape.m_oCore[ 1 ], _oShape.m_fRadius );
+				case Type::OBB:		return fzn::ConvexCollider::OBB( _oShape.m_vCenter, _oShape.m_vHalfExtents, _oShape.m_fAngle );
+				default:			return fzn::ConvexCollider::Polygon( _oShape.m_oCore.data(), (int)_oShape.m_oCore.size() );
+			}
+		}
+
+		//Gap between the shapes along a unit axis going from A to B, negative when their projections overlap.
+		float GetGap( const Shape& _oShapeA, const Shape& _oShapeB, const sf::Vector2f& _vAxis )
+		{
+			float fMaxA = -FLT_MAX;
+			float fMinB = FLT_MAX;
+
+			for( const sf::Vector2f& vPoint : _oShapeA.m_oCore )
+				fMaxA = fzn::Math::Max( fMaxA, fzn::Math::VectorDot( vPoint, _vAxis ) );
+
+			for( const sf::Vector2f& vPoint : _oShapeB.m_oCore )
+				fMinB = fzn::Math::Min( fMinB, fzn::Math::VectorDot( vPoint, _vAxis ) );
+
+			return fMinB - fMaxA - _oShapeA.m_fRadius - _oShapeB.m_fRadius;
+		}
+
+		//Separating axis reference: the signed distance between two convex shapes is the largest gap over all the axes.
+		//For cores made of points, the best axis is an edge normal (vertex against edge) or the direction between two points (vertex against vertex, round shapes).
+		float GetSignedDistance( const Shape& _oShapeA, const Shape& _oShapeB )
+		{
+			float fBestGap = -FLT_MAX;
+
+			auto TestAxis = [&]( const sf::Vector2f& _vDirection )
+			{
+				if( fzn::Math::VectorLengthSq( _vDirection ) < 1e-12f )
+					return;
+
+				const sf::Vector2f vAxis = fzn::Math::VectorNormalization( _vDirection );
+
+				fBestGap = fzn::Math::Max( fBestGap, fzn::Math::Max( GetGap( _oShapeA, _oShapeB, vAxis ), GetGap( _oShapeA, _oShapeB, -vAxis ) ) );
+			};
+
+			for( const Shape* pShape : { &_oShapeA, &_oShapeB } )
+			{
+				const std::vector< sf::Vector2f >& oCore = pShape->m_oCore;
+
+				for( size_t uPoint = 0; oCore.size() > 1 && uPoint < oCore.size(); ++uPoint )
+				{
+					const sf::Vector2f vEdge = oCore[ ( uPoint + 1 ) % oCore.size() ] - oCore[ uPoint ];
+					TestAxis( { vEdge.y, -vEdge.x } );
+				}
+			}
+
+			for( const sf::Vector2f& vPointA : _oShapeA.m_oCore )
+			{
+				for( const sf::Vector2f& vPointB : _oShapeB.m_oCore )
+					TestAxis( vPointB - vPointA );
+			}
+
+			return fBestGap;
+		}
+
+		//Usual SAT on polygons, only testing the edge normals: what the GJK queries replace on polygons and boxes.
+		float GetPolygonsOverlap( const Shape& _oShapeA, const Shape& _oShapeB )
+		{
+			float fMinOverlap = FLT_MAX;
+
+			for( const Shape* pShape : { &_oShapeA, &_oShapeB } )
+			{
+				const std::vector< sf::Vector2f >& oCore = pShape->m_oCore;
+
+				for( size_t uPoint = 0; uPoint < oCore.size(); ++uPoint )
+				{
+					const sf::Vector2f vEdge = oCore[ ( uPoint + 1 ) % oCore.size() ] - oCore[ uPoint ];
+					const float fOverlap = -GetGap( _oShapeA, _oShapeB, fzn::Math::VectorNormalization( { vEdge.y, -vEdge.x } ) );
+
+					if( fOverlap < 0.f )
+						return fOverlap;
+
+					fMinOverlap = fzn::Math::Min( fMinOverlap, fOverlap );
+				}
+			}
+
+			return fMinOverlap;
+		}
+
+		//Compares the three queries with the reference on random pairs of two types, returns the number of mismatches.
+		int CheckPairs( fzn::Random& _oRandom, Type _eTypeA, Type _eTypeB, int& _iNbChecks )
+		{
+			int iNbFailures = 0;
+			int iNbOverlaps = 0;
+
+			auto Check = [&]( bool _bValid, const char* _sWhat, float _fValue, float _fReference )
+			{
+				++_iNbChecks;
+
+				if( _bValid )
+					return;
+
+				if( iNbFailures++ < 3 )
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "%s against %s, %s: %f instead of %f", s_aTypeNames[ (int)_eTypeA ], s_aTypeNames[ (int)_eTypeB ], _sWhat, _fValue, _fReference );
+			};
+
+			for( int iPair = 0; iPair < NbPairs; ++iPair )
+			{
+				const Shape oShapeA = CreateShape( _oRandom, _eTypeA );
+				const Shape oShapeB = CreateShape( _oRandom, _eTypeB );
+				const fzn::ConvexCollider oColliderA = GetCollider( oShapeA );
+				const fzn::ConvexCollider oColliderB = GetCollider( oShapeB );
+
+				const float fSignedDistance = GetSignedDistance( oShapeA, oShapeB );
+
+				if( std::abs( fSignedDistance ) < ContactTolerance )
+					continue;
+
+				const bool bOverlap = fSignedDistance < 0.f;
+				const fzn::ConvexContact oContact = fzn::Math::GJKCollide( oColliderA, oColliderB );
+
+				Check( fzn::Math::GJKIntersect( oColliderA, oColliderB ) == bOverlap, "intersection", (float)!bOverlap, (float)bOverlap );
+				Check( oContact.m_bColliding == bOverlap, "collision", (float)oContact.m_bColliding, (float)bOverlap );
+
+				if( oContact.m_bColliding != bOverlap )
+					continue;
+
+				if( bOverlap )
+				{
+					++iNbOverlaps;
+					Check( fzn::Math::GJKDistance( oColliderA, oColliderB ) == 0.f, "GJKDistance", fzn::Math::GJKDistance( oColliderA, oColliderB ), 0.f );
+					Check( std::abs( oContact.m_fPenetration + fSignedDistance ) <= Tolerance, "penetration", oContact.m_fPenetration, -fSignedDistance );
+
+					//Several axes can give the same depth (parallel edges, symmetric shapes), so the normal is checked by the depth it gives rather than against the reference axis.
+					const float fNormalLength = fzn::Math::VectorLength( oContact.m_vNormal );
+					Check( std::abs( fNormalLength - 1.f ) <= 1e-3f, "normal length", fNormalLength, 1.f );
+
+					if( fNormalLength > 0.f )
+					{
+						const float fNormalGap = GetGap( oShapeA, oShapeB, oContact.m_vNormal / fNormalLength );
+						Check( fNormalGap >= fSignedDistance - Tolerance, "overlap along the normal", -fNormalGap, -fSignedDistance );
+					}
+				}
+				else
+				{
+					sf::Vector2f vPointA;
+					sf::Vector2f vPointB;
+					const float fDistance = fzn::Math::GJKDistance( oColliderA, oColliderB, &vPointA, &vPointB );
+
+					Check( std::abs( oContact.m_fDistance - fSignedDistance ) <= Tolerance, "distance", oContact.m_fDistance, fSignedDistance );
+					Check( std::abs( fDistance - fSignedDistance ) <= Tolerance, "GJKDistance", fDistance, fSignedDistance );
+					Check( std::abs( fzn::Math::VectorLength( vPointB - vPointA ) - fSignedDistance ) <= Tolerance, "closest points gap", fzn::Math::VectorLength( vPointB - vPointA ), fSignedDistance );
+				}
+			}
+
+			//Every combination has to test both cases, otherwise the world size doesn't fit the shapes anymore.
+			Check( iNbOverlaps > 0 && iNbOverlaps < NbPairs, "overlapping pairs", (float)iNbOverlaps, NbPairs * 0.5f );
+
+			return iNbFailures;
+		}
+	}
+
+	int ConvexCollisionScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = 0;
+
+		for( size_t uTypeA = 0; uTypeA < std::size( s_aTypes ); ++uTypeA )
+		{
+			for( size_t uTypeB = uTypeA; uTypeB < std::size( s_aTypes ); ++uTypeB )
+			{
+				const std::string sLabel = std::string( s_aTypeNames[ uTypeA ] ) + " against " + s_aTypeNames[ uTypeB ];
+				int iNbChecks = 0;
+				const int iNbPairFailures = CheckPairs( oRandom, s_aTypes[ uTypeA ], s_aTypes[ uTypeB ], iNbChecks );
+
+				iNbFailures += LogCheck( sLabel.c_str(), iNbPairFailures, iNbChecks );
+			}
+		}
+
+		//Timings on the same pairs for each query, about half of them overlapping.
+		for( Type eType : { Type::Polygon, Type::OBB, Type::Circle, Type::Capsule } )
+		{
+			std::vector< Shape > oShapes;
+
+			for( int iShape = 0; iShape < 2 * NbTimedPairs; ++iShape )
+				oShapes.push_back( CreateShape( oRandom, eType ) );
+
+			std::vector< fzn::ConvexCollider > oColliders;
+
+			for( const Shape& oShape : oShapes )
+				oColliders.push_back( GetCollider( oShape ) );
+
+			const double dIntersect = Measure( NbRuns, [&]()
+			{
+				int iNbIntersections = 0;
+
+				for( int iPair = 0; iPair < NbTimedPairs; ++iPair )
+					iNbIntersections += fzn::Math::GJKIntersect( oColliders[ 2 * iPair ], oColliders[ 2 * iPair + 1 ] ) ? 1 : 0;
+
+				Consume( iNbIntersections );
+			} );
+
+			const double dCollide = Measure( NbRuns, [&]()
+			{
+				float fSum = 0.f;
+
+				for( int iPair = 0; iPair < NbTimedPairs; ++iPair )
+					fSum += fzn::Math::GJKCollide( oColliders[ 2 * iPair ], oColliders[ 2 * iPair + 1 ] ).m_fPenetration;
+
+				Consume( fSum );
+			} );
+
+			const double dDistance = Measure( NbRuns, [&]()
+			{
+				float fSum = 0.f;
+
+				for( int iPair = 0; iPair < NbTimedPairs; ++iPair )
+					fSum += fzn::Math::GJKDistance( oColliders[ 2 * iPair ], oColliders[ 2 * iPair + 1 ] );
+
+				Consume( fSum );
+			} );
+
+			const std::string sType = s_aTypeNames[ (int)eType ];
+			LogTime( ( "GJKIntersect, " + sType + " pairs" ).c_str(), dIntersect, NbTimedPairs );
+			LogTime( ( "GJKCollide, " + sType + " pairs" ).c_str(), dCollide, NbTimedPairs );
+			LogTime( ( "GJKDistance, " + sType + " pairs" ).c_str(), dDistance, NbTimedPairs );
+
+			if( eType == Type::Polygon || eType == Type::OBB )
+			{
+				const double dSeparatingAxes = Measure( NbRuns, [&]()
+				{
+					float fSum = 0.f;
+
+					for( int iPair = 0; iPair < NbTimedPairs; ++iPair )
+						fSum += GetPolygonsOverlap( oShapes[ 2 * iPair ], oShapes[ 2 * iPair + 1 ] );
+
+					Consume( fSum );
+				} );
+
+				LogTime( ( "SAT on the edge normals, " + sType + " pairs" ).c_str(), dSeparatingAxes, NbTimedPairs );
+				LogSpeedup( ( "GJKIntersect against SAT, " + sType + " pairs" ).c_str(), dSeparatingAxes, dIntersect );
+				LogSpeedup( ( "GJKCollide against SAT, " + sType + " pairs" ).c_str(), dSeparatingAxes, dCollide );
+			}
+		}
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
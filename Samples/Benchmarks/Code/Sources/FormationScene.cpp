@@ -0,0 +1,364 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Slots assignment and steering of formations of growing size, compared to the optimal assignment and to every permutation for the small ones
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <string>
+
+#include <FZN/Includes.h>
+#include <FZN/Game/Steering/FormationSolver.h>
+#include <FZN/Game/Steering/SteeringEntity.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		using Shape = fzn::FormationSolver::Shape;
+
+		static constexpr int	NbRuns{ 20 };
+		static constexpr double	CostTolerance{ 1e-6 };			//Relative, the solver accumulates the costs in another order
+		static constexpr int	NbBruteForceProblems{ 400 };
+		static constexpr int	BruteForceMaxSize{ 8 };
+		static constexpr float	MoveDistance{ 2.f };			//Distance the members move between two updates when they follow their slot
+
+		struct Setup
+		{
+			int			m_iNbMembers;
+			Shape		m_eShape;
+			const char*	m_sShape;
+		};
+
+		static const Setup s_aSetups[] =
+		{
+			{ 32,	Shape::Multiline,	"multiline" },
+			{ 128,	Shape::Multiline,	"multiline" },
+			{ 512,	Shape::Multiline,	"multiline" },
+			{ 64,	Shape::V,			"V" },
+			{ 256,	Shape::V,			"V" },
+			{ 128,	Shape::Circle,		"circle" },
+			{ 512,	Shape::Circle,		"circle" },
+		};
+
+		//Reference for the solver: minimum of the sum of the squared distances between the members and their slot (Hungarian algorithm, O(n^3)).
+		double GetOptimalCost( const std::vector< sf::Vector2f >& _oMembers, const std::vector< sf::Vector2f >& _oSlots )
+		{
+			const int iSize = (int)_oMembers.size();
+			std::vector< double > oRowPotentials( iSize + 1, 0.0 );
+			std::vector< double > oColumnPotentials( iSize + 1, 0.0 );
+			std::vector< int > oColumnRows( iSize + 1, 0 );
+			std::vector< int > oPath( iSize + 1, 0 );
+
+			for( int iRow = 1; iRow <= iSize; ++iRow )
+			{
+				std::vector< double > oMinSlack( iSize + 1, DBL_MAX );
+				std::vector< bool > oUsed( iSize + 1, false );
+				int iColumn = 0;
+				oColumnRows[ 0 ] = iRow;
+
+				while( oColumnRows[ iColumn ] != 0 )
+				{
+					oUsed[ iColumn ] = true;
+
+					const int iCurrentRow = oColumnRows[ iColumn ];
+					double dDelta = DBL_MAX;
+					int iNextColumn = 0;
+
+					for( int iCandidate = 1; iCandidate <= iSize; ++iCandidate )
+					{
+						if( oUsed[ iCandidate ] )
+							continue;
+
+						const sf::Vector2f vOffset = _oSlots[ iCandidate - 1 ] - _oMembers[ iCurrentRow - 1 ];
+						const double dSlack = (double)vOffset.x * vOffset.x + (double)vOffset.y * vOffset.y - oRowPotentials[ iCurrentRow ] - oColumnPotentials[ iCandidate ];
+
+						if( dSlack < oMinSlack[ iCandidate ] )
+						{
+							oMinSlack[ iCandidate ] = dSlack;
+							oPath[ iCandidate ] = iColumn;
+						}
+
+						if( oMinSlack[ iCandidate ] < dDelta )
+						{
+							dDelta = oMinSlack[ iCandidate ];
+							iNextColumn = iCandidate;
+						}
+					}
+
+					for( int iCandidate = 0; iCandidate <= iSize; ++iCandidate )
+					{
+						if( oUsed[ iCandidate ] )
+						{
+							oRowPotentials[ oColumnRows[ iCandidate ] ] += dDelta;
+							oColumnPotentials[ iCandidate ] -= dDelta;
+						}
+						else
+							oMinSlack[ iCandidate ] -= dDelta;
+					}
+
+					iColumn = iNextColumn;
+				}
+
+				while( iColumn != 0 )
+				{
+					oColumnRows[ iColumn ] = oColumnRows[ oPath[ iColumn ] ];
+					iColumn = oPath[ iColumn ];
+				}
+			}
+
+			double dCost = 0.0;
+
+			for( int iColumn = 1; iColumn <= iSize; ++iColumn )
+			{
+				const sf::Vector2f vOffset = _oSlots[ iColumn - 1 ] - _oMembers[ oColumnRows[ iColumn ] - 1 ];
+				dCost += (double)vOffset.x * vOffset.x + (double)vOffset.y * vOffset.y;
+			}
+
+			return dCost;
+		}
+
+		//Independent reference for the small problems: every permutation is tried.
+		double GetBruteForceCost( const std::vector< sf::Vector2f >& _oMembers, const std::vector< sf::Vector2f >& _oSlots )
+		{
+			std::vector< int > oPermutation( _oMembers.size() );
+			std::iota( oPermutation.begin(), oPermutation.end(), 0 );
+			double dBestCost = DBL_MAX;
+
+			do
+			{
+				double dCost = 0.0;
+
+				for( size_t uMember = 0; uMember < _oMembers.size(); ++uMember )
+				{
+					const sf::Vector2f vOffset = _oSlots[ oPermutation[ uMember ] ] - _oMembers[ uMember ];
+					dCost += (double)vOffset.x * vOffset.x + (double)vOffset.y * vOffset.y;
+				}
+
+				dBestCost = std::min( dBestCost, dCost );
+			} while( std::next_permutation( oPermutation.begin(), oPermutation.end() ) );
+
+			return dBestCost;
+		}
+
+		//The auction can be above the optimal cost by a part of it, and by its smallest bid increment for each member.
+		bool IsCostInBounds( double _dCost, double _dOptimalCost, int _iNbMembers )
+		{
+			const double dMaxCost = _dOptimalCost * ( 1.0 + fzn::FormationSolver::AssignmentTolerance ) + _iNbMembers * fzn::FormationSolver::MinAssignmentEpsilon;
+			return _dCost <= dMaxCost * ( 1.0 + CostTolerance );
+		}
+
+		//Sum of the squared distances between the members and the slot the solver gave them.
+		double GetSolverCost( const fzn::FormationSolver& _oSolver, const std::vector< std::unique_ptr< fzn::SteeringEntity > >& _oMembers, std::vector< sf::Vector2f >& _oPositions, std::vector< sf::Vector2f >& _oSlots )
+		{
+			double dCost = 0.0;
+
+			_oPositions.clear();
+			_oSlots.clear();
+
+			for( const std::unique_ptr< fzn::SteeringEntity >& pMember : _oMembers )
+			{
+				sf::Vector2f vSlot;
+				_oSolver.GetSlotPosition( pMember.get(), vSlot );
+
+				const sf::Vector2f vOffset = vSlot - pMember->m_position;
+				dCost += (double)vOffset.x * vOffset.x + (double)vOffset.y * vOffset.y;
+				_oPositions.push_back( pMember->m_position );
+				_oSlots.push_back( vSlot );
+			}
+
+			return dCost;
+		}
+	}
+
+	int FormationScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = 0;
+		int iNbChecks = 0;
+		std::vector< sf::Vector2f > oPositions;
+		std::vector< sf::Vector2f > oSlots;
+
+		//Small groups: the reference and the solver are checked against every permutation.
+		for( int iProblem = 0; iProblem < NbBruteForceProblems; ++iProblem )
+		{
+			const Setup& oSetup = s_aSetups[ iProblem % ( sizeof( s_aSetups ) / sizeof( s_aSetups[ 0 ] ) ) ];
+			const int iNbMembers = 1 + iProblem % BruteForceMaxSize;
+
+			fzn::FormationSolver oSolver;
+			fzn::FormationSolver::Desc oDesc;
+			oDesc.m_eShape = oSetup.m_eShape;
+
+			fzn::SteeringEntity oLeader;
+			oLeader.m_velocity = { oRandom.GetFloat( -100.f, 100.f ), oRandom.GetFloat( -100.f, 100.f ) };
+
+			const int iGroup = oSolver.AddGroup( &oLeader, oDesc );
+			std::vector< std::unique_ptr< fzn::SteeringEntity > > oMembers;
+
+			for( int iMember = 0; iMember < iNbMembers; ++iMember )
+			{
+				oMembers.push_back( std::make_unique< fzn::SteeringEntity >() );
+				oMembers.back()->m_position = { oRandom.GetFloat( -150.f, 150.f ), oRandom.GetFloat( -150.f, 150.f ) };
+				oSolver.AddMember( iGroup, oMembers.back().get() );
+			}
+
+			oSolver.Update();
+
+			const double dCost = GetSolverCost( oSolver, oMembers, oPositions, oSlots );
+			const double dBruteForceCost = GetBruteForceCost( oPositions, oSlots );
+			const double dOptimalCost = GetOptimalCost( oPositions, oSlots );
+
+			iNbChecks += 2;
+
+			if( std::abs( dOptimalCost - dBruteForceCost ) > dBruteForceCost * CostTolerance || IsCostInBounds( dCost, dBruteForceCost, iNbMembers ) == false )
+			{
+				if( iNbFailures < 10 )
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "%d members: cost %f, reference %f, every permutation %f", iNbMembers, dCost, dOptimalCost, dBruteForceCost );
+
+				++iNbFailures;
+			}
+		}
+
+		for( const Setup& oSetup : s_aSetups )
+		{
+			const std::string sLabel = std::string( oSetup.m_sShape ) + " of " + std::to_string( oSetup.m_iNbMembers );
+
+			fzn::FormationSolver oSolver;
+			fzn::FormationSolver::Desc oDesc;
+			oDesc.m_eShape = oSetup.m_eShape;
+			oDesc.m_uReassignmentPeriod = 0;
+
+			//The leader goes up, so the formation is below it. The members are scattered where they would be after a regroup order.
+			fzn::SteeringEntity oLeader;
+			oLeader.m_velocity = { 0.f, -100.f };
+
+			const int iGroup = oSolver.AddGroup( &oLeader, oDesc );
+			const float fSpread = std::sqrt( (float)oSetup.m_iNbMembers ) * oDesc.m_fOffset;
+			std::vector< std::unique_ptr< fzn::SteeringEntity > > oMembers;
+
+			for( int iMember = 0; iMember < oSetup.m_iNbMembers; ++iMember )
+			{
+				oMembers.push_back( std::make_unique< fzn::SteeringEntity >() );
+				oMembers.back()->m_position = { oRandom.GetFloat( -fSpread, fSpread ), oRandom.GetFloat( -fSpread * 0.5f, fSpread * 1.5f ) };
+				oSolver.AddMember( iGroup, oMembers.back().get() );
+			}
+
+			oSolver.Update();
+
+			//Cost of the solver assignment against the optimal one.
+			double dCost = GetSolverCost( oSolver, oMembers, oPositions, oSlots );
+			double dOptimalCost = GetOptimalCost( oPositions, oSlots );
+
+			++iNbChecks;
+
+			if( IsCostInBounds( dCost, dOptimalCost, oSetup.m_iNbMembers ) == false )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "%s: cost %f, optimal %f", sLabel.c_str(), dCost, dOptimalCost );
+				++iNbFailures;
+			}
+
+			FZN_LOG( "%-48s x%.4f the optimal cost", ( "Assignment, " + sLabel ).c_str(), dOptimalCost > 0.0 ? dCost / dOptimalCost : 1.0 );
+
+			//A changed description drops the prices of the auction, so each run starts from scratch.
+			const double dAssignment = Measure( NbRuns, [&]()
+			{
+				oSolver.SetDesc( iGroup, oDesc );
+				oSolver.Update();
+			} );
+
+			const double dSteering = Measure( NbRuns * 10, [&]() { oSolver.Update(); } );
+
+			//The formation goes on while its members move a bit around their position, the auction starts from the prices of the previous update.
+			oDesc.m_uReassignmentPeriod = 1;
+			oSolver.SetDesc( iGroup, oDesc );
+
+			const double dWarmAssignment = Measure( NbRuns, [&]()
+			{
+				oLeader.m_position.y -= MoveDistance;
+
+				for( std::unique_ptr< fzn::SteeringEntity >& pMember : oMembers )
+					pMember->m_position += sf::Vector2f( oRandom.GetFloat( -MoveDistance, MoveDistance ), oRandom.GetFloat( -MoveDistance, MoveDistance ) - MoveDistance );
+
+				oSolver.Update();
+			} );
+
+			//The current assignment is only replaced by a new one saving ReassignmentGain of its cost.
+			dCost = GetSolverCost( oSolver, oMembers, oPositions, oSlots );
+			dOptimalCost = GetOptimalCost( oPositions, oSlots );
+
+			++iNbChecks;
+
+			if( IsCostInBounds( dCost * ( 1.0 - fzn::FormationSolver::ReassignmentGain ), dOptimalCost, oSetup.m_iNbMembers ) == false )
+			{
+				FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "%s, moving: cost %f, optimal %f", sLabel.c_str(), dCost, dOptimalCost );
+				++iNbFailures;
+			}
+
+			LogTime( ( "Update and assignment, " + sLabel ).c_str(), dAssignment, oSetup.m_iNbMembers );
+			LogTime( ( "Update and warm assignment, " + sLabel ).c_str(), dWarmAssignment, oSetup.m_iNbMembers );
+			LogTime( ( "Update, " + sLabel ).c_str(), dSteering, oSetup.m_iNbMembers );
+		}
+
+		//Many groups are updated in parallel, their periodic assignments are spread over the updates.
+		{
+			static constexpr int NbGroups{ 64 };
+			static constexpr int NbMembersPerGroup{ 32 };
+			static constexpr int NbUpdates{ 60 };
+
+			fzn::FormationSolver oSolver;
+			fzn::FormationSolver::Desc oDesc;
+			oDesc.m_eShape = Shape::Multiline;
+
+			std::vector< std::unique_ptr< fzn::SteeringEntity > > oEntities;
+
+			for( int iGroup = 0; iGroup < NbGroups; ++iGroup )
+			{
+				oEntities.push_back( std::make_unique< fzn::SteeringEntity >() );
+				oEntities.back()->m_position = { iGroup * 500.f, 0.f };
+				oEntities.back()->m_velocity = { 0.f, -100.f };
+
+				const int iSolverGroup = oSolver.AddGroup( oEntities.back().get(), oDesc );
+
+				for( int iMember = 0; iMember < NbMembersPerGroup; ++iMember )
+				{
+					oEntities.push_back( std::make_unique< fzn::SteeringEntity >() );
+					oEntities.back()->m_position = { iGroup * 500.f + oRandom.GetFloat( -150.f, 150.f ), oRandom.GetFloat( 0.f, 300.f ) };
+					oSolver.AddMember( iSolverGroup, oEntities.back().get() );
+				}
+			}
+
+			oSolver.Update();
+
+			double dTotal = 0.0;
+			double dWorst = 0.0;
+
+			for( int iUpdate = 0; iUpdate < NbUpdates; ++iUpdate )
+			{
+				for( std::unique_ptr< fzn::SteeringEntity >& pEntity : oEntities )
+					pEntity->m_position += sf::Vector2f( oRandom.GetFloat( -MoveDistance, MoveDistance ), oRandom.GetFloat( -MoveDistance, MoveDistance ) - MoveDistance );
+
+				const std::chrono::steady_clock::time_point oStart = std::chrono::steady_clock::now();
+				oSolver.Update();
+				const double dUpdate = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - oStart ).count();
+
+				dTotal += dUpdate;
+				dWorst = std::max( dWorst, dUpdate );
+			}
+
+			LogTime( "Update, 64 multilines of 32", dTotal / NbUpdates, NbGroups * NbMembersPerGroup );
+			LogTime( "Worst update, 64 multilines of 32", dWorst, NbGroups * NbMembersPerGroup );
+		}
+
+		iNbFailures = LogCheck( "Assignment against the optimal cost", iNbFailures, iNbChecks );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
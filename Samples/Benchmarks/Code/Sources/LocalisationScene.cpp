@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Per frame retrieval cost of the localised strings of a UI heavy screen, with and without the case cache
+//------------------------------------------------------------------------
+
+#include <FZN/Includes.h>
+#include <FZN/Managers/LocalisationManager.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		static constexpr uint32_t	NbEntries{ 2000 };
+		static constexpr int		NbLabels{ 400 };			//Labels drawn each frame, a quarter of them in upper case
+		static constexpr int		NbFrames{ 200 };
+		static constexpr char		CompiledFile[]{ "Benchmarks.trloc" };
+
+		//UTF-8 words covering the mapped ranges, written as bytes so the source doesn't depend on the code page of the compiler.
+		static const char* s_aWords[] =
+		{
+			"menu", "Options", "continuer", "OK",
+			"\xC3\xA9p\xC3\xA9" "e",							//épée
+			"ch\xC3\xA2teau",									//château
+			"\xC4\xB0stanbul",									//İstanbul
+			"\xC4\xB1l\xC4\xB1k",								//ılık
+			"\xC5\x81\xC3\xB3" "d\xC5\xBA",						//Łódź
+			"\xCE\xA9\xCE\xBC\xCE\xAD\xCE\xB3\xCE\xB1",			//Ωμέγα
+			"\xCF\x83\xCE\xBF\xCF\x86\xCF\x8C\xCF\x82",			//σοφός
+			"\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82",	//Привет
+			"stra\xC3\x9F" "e",									//straße
+		};
+
+		std::string GetRandomSentence( fzn::Random& _oRandom )
+		{
+			std::string sSentence;
+			const int iNbWords = _oRandom.GetInt( 1, 5 );
+
+			for( int iWord = 0; iWord < iNbWords; ++iWord )
+			{
+				if( iWord > 0 )
+					sSentence += ' ';
+
+				sSentence += s_aWords[ _oRandom.GetInt( 0, (int)std::size( s_aWords ) - 1 ) ];
+			}
+
+			return sSentence;
+		}
+
+		int CheckCodePoints()
+		{
+			struct Mapping
+			{
+				uint32_t m_uCodePoint;
+				uint32_t m_uLower;
+				uint32_t m_uUpper;
+			};
+
+			static const Mapping aMappings[] =
+			{
+				{ 'A', 'a', 'A' }, { 'z', 'z', 'Z' }, { 0xC9, 0xE9, 0xC9 }, { 0xFF, 0xFF, 0x178 }, { 0xD7, 0xD7, 0xD7 },
+				{ 0x12E, 0x12F, 0x12E }, { 0x12F, 0x12F, 0x12E },
+				{ 0x130, 'i', 0x130 },				//Dotted capital I
+				{ 0x131, 0x131, 'I' },				//Dotless small i
+				{ 0x132, 0x133, 0x132 }, { 0x137, 0x137, 0x136 }, { 0x138, 0x138, 0x138 },
+				{ 0x141, 0x142, 0x141 }, { 0x17D, 0x17E, 0x17D }, { 0x3A3, 0x3C3, 0x3A3 }, { 0x3C2, 0x3C2, 0x3A3 }, { 0x401, 0x451, 0x401 },
+			};
+
+			int iNbFailures = 0;
+
+			for( const Mapping& oMapping : aMappings )
+			{
+				if( fzn::Tools::to_lower_code_point( oMapping.m_uCodePoint ) != oMapping.m_uLower || fzn::Tools::to_upper_code_point( oMapping.m_uCodePoint ) != oMapping.m_uUpper )
+				{
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "U+%04X: lower U+%04X, upper U+%04X", oMapping.m_uCodePoint, fzn::Tools::to_lower_code_point( oMapping.m_uCodePoint ), fzn::Tools::to_upper_code_point( oMapping.m_uCodePoint ) );
+					++iNbFailures;
+				}
+			}
+
+			return LogCheck( "Code point case mapping", iNbFailures, (int)std::size( aMappings ) );
+		}
+	}
+
+	int LocalisationScene()
+	{
+		int iNbFailures = CheckCodePoints();
+
+		fzn::Random oRandom( Seed );
+		fzn::Localisation::LocalisationData oData;
+		oData.m_languages = { "First", "Second" };
+
+		for( uint32_t uEntry = 0; uEntry < NbEntries; ++uEntry )
+			oData.m_entries.push_back( { "ENTRY_" + std::to_string( uEntry ), { GetRandomSentence( oRandom ), GetRandomSentence( oRandom ) } } );
+
+		if( fzn::Localisation::Manager::save_compiled_entries( CompiledFile, oData ) == false )
+			return LogCheck( "Compiled localisation file", 1, 1 );
+
+		fzn::Localisation::Manager oManager;
+		oManager.load_entries( CompiledFile );
+
+		//The labels of the screen, the same ones are drawn each frame.
+		std::vector< uint32_t > oLabels( NbLabels );
+
+		for( uint32_t& uLabel : oLabels )
+			uLabel = (uint32_t)oRandom.GetInt( 0, NbEntries - 1 );
+
+		auto DrawFrame = [&]( auto&& _fnGetString )
+		{
+			size_t uSize = 0;
+
+			for( int iLabel = 0; iLabel < NbLabels; ++iLabel )
+				uSize += _fnGetString( oLabels[ iLabel ], iLabel % 4 == 0 ).size();
+
+			Consume( (double)uSize );
+		};
+
+		const double dRaw = Measure( NbFrames, [&]() { DrawFrame( [&]( uint32_t _uEntry, bool /*_bUpper*/ ) { return oManager.get_string( _uEntry ); } ); } );
+
+		//What the callers did before the cache: transforming the translation each time it is drawn.
+		const double dTransformed = Measure( NbFrames, [&]()
+		{
+			DrawFrame( [&]( uint32_t _uEntry, bool _bUpper ) { return _bUpper ? fzn::Tools::get_utf8_upper_string( oManager.get_string( _uEntry ) ) : std::string( oManager.get_string( _uEntry ) ); } );
+		} );
+
+		const double dCached = Measure( NbFrames, [&]()
+		{
+			DrawFrame( [&]( uint32_t _uEntry, bool _bUpper ) { return oManager.get_string( _uEntry, _bUpper ? fzn::Localisation::Case::all_upper : fzn::Localisation::Case::COUNT ); } );
+		} );
+
+		//Switching the language back and forth frees the cache of the first language, so each of these frames fills it again.
+		const double dAfterSwitch = Measure( NbFrames, [&]()
+		{
+			oManager.set_current_language( 1u );
+			oManager.set_current_language( 0u );
+			DrawFrame( [&]( uint32_t _uEntry, bool _bUpper ) { return oManager.get_string( _uEntry, _bUpper ? fzn::Localisation::Case::all_upper : fzn::Localisation::Case::COUNT ); } );
+		} );
+
+		LogTime( "Frame, no case transform", dRaw, NbLabels );
+		LogTime( "Frame, upper case transformed when drawn", dTransformed, NbLabels );
+		LogTime( "Frame, upper case from the cache", dCached, NbLabels );
+		LogTime( "Frame after a language switch (cache filled)", dAfterSwitch, NbLabels );
+		LogSpeedup( "Cache against transform when drawn", dTransformed, dCached );
+
+		//The cached variants have to be the ones the UTF-8 helpers give.
+		int iNbMismatches = 0;
+
+		for( uint32_t uLanguage = 0; uLanguage < oData.m_languages.size(); ++uLanguage )
+		{
+			for( uint32_t uEntry = 0; uEntry < NbEntries; ++uEntry )
+			{
+				const std::string_view sTranslation = oManager.get_string( uEntry, uLanguage );
+
+				if( oManager.get_string( uEntry, uLanguage, fzn::Localisation::Case::all_upper ) != fzn::Tools::get_utf8_upper_string( sTranslation ) )
+					++iNbMismatches;
+
+				if( oManager.get_string( uEntry, uLanguage, fzn::Localisation::Case::all_lower ) != fzn::Tools::get_utf8_lower_string( sTranslation ) )
+					++iNbMismatches;
+			}
+		}
+
+		iNbFailures += LogCheck( "Cached case variants", iNbMismatches, 2 * NbEntries * (int)oData.m_languages.size() );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
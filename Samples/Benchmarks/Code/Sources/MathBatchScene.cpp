@@ -0,0 +1,270 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Batch math functions against the per vector helpers, results and timings
+//------------------------------------------------------------------------
+
+#include <cmath>
+#include <string>
+
+#include <FZN/Includes.h>
+#include <FZN/Tools/MathBatch.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		static constexpr int	NbValues{ 100000 };
+		static constexpr int	NbRuns{ 200 };
+		static constexpr int	MaxSmallCount{ 19 };				//Counts of 0 to this one go through the leftover code, with and without a SIMD pack
+		static constexpr float	Tolerance{ 1e-5f };					//Relative, the batch functions don't do the operations in the same order as the helpers
+
+		//Data of the checks and timings, the vectors being stored both as separate arrays (batch functions) and as sf::Vector2f (helpers).
+		struct Data
+		{
+			std::vector< float >		m_oX;
+			std::vector< float >		m_oY;
+			std::vector< float >		m_oToX;
+			std::vector< float >		m_oToY;
+			std::vector< float >		m_oRatios;
+			std::vector< sf::Vector2f >	m_oVectors;
+			std::vector< sf::Vector2f >	m_oToVectors;
+			std::vector< sf::Color >	m_oColors;
+			std::vector< sf::Color >	m_oToColors;
+		};
+
+		Data CreateData( fzn::Random& _oRandom, int _iCount )
+		{
+			Data oData;
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+			{
+				oData.m_oX.push_back( _oRandom.GetFloat( -1000.f, 1000.f ) );
+				oData.m_oY.push_back( _oRandom.GetFloat( -1000.f, 1000.f ) );
+				oData.m_oToX.push_back( _oRandom.GetFloat( -1000.f, 1000.f ) );
+				oData.m_oToY.push_back( _oRandom.GetFloat( -1000.f, 1000.f ) );
+				oData.m_oRatios.push_back( _oRandom.GetFloat( -0.5f, 1.5f ) );
+				oData.m_oColors.push_back( sf::Color( (sf::Uint8)_oRandom.GetInt( 0, 255 ), (sf::Uint8)_oRandom.GetInt( 0, 255 ), (sf::Uint8)_oRandom.GetInt( 0, 255 ), (sf::Uint8)_oRandom.GetInt( 0, 255 ) ) );
+				oData.m_oToColors.push_back( sf::Color( (sf::Uint8)_oRandom.GetInt( 0, 255 ), (sf::Uint8)_oRandom.GetInt( 0, 255 ), (sf::Uint8)_oRandom.GetInt( 0, 255 ), (sf::Uint8)_oRandom.GetInt( 0, 255 ) ) );
+			}
+
+			//Null vectors have to stay null once normalized.
+			for( int iValue = 0; iValue < _iCount; iValue += 7 )
+			{
+				oData.m_oX[ iValue ] = 0.f;
+				oData.m_oY[ iValue ] = 0.f;
+			}
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+			{
+				oData.m_oVectors.push_back( { oData.m_oX[ iValue ], oData.m_oY[ iValue ] } );
+				oData.m_oToVectors.push_back( { oData.m_oToX[ iValue ], oData.m_oToY[ iValue ] } );
+			}
+
+			return oData;
+		}
+
+		bool IsClose( float _fValue, float _fReference )
+		{
+			return std::abs( _fValue - _fReference ) <= Tolerance * fzn::Math::Max( 1.f, std::abs( _fReference ) );
+		}
+
+		sf::Color LerpColor( const sf::Color& _oFrom, const sf::Color& _oTo, float _fRatio )
+		{
+			auto Lerp = [_fRatio]( sf::Uint8 _uFrom, sf::Uint8 _uTo ) { return (sf::Uint8)std::nearbyint( _uFrom + ( _uTo - _uFrom ) * _fRatio ); };
+
+			return sf::Color( Lerp( _oFrom.r, _oTo.r ), Lerp( _oFrom.g, _oTo.g ), Lerp( _oFrom.b, _oTo.b ), Lerp( _oFrom.a, _oTo.a ) );
+		}
+
+		//Compares each batch function with the helpers on _iCount values starting at _iOffset, so the arrays aren't aligned on the SIMD registers.
+		int CheckFunctions( const Data& _oData, const sf::Transform& _oTransform, int _iOffset, int _iCount, int& _iNbChecks )
+		{
+			static constexpr float Ratio{ 0.37f };
+
+			std::vector< float > oOutX( _iOffset + _iCount );
+			std::vector< float > oOutY( _iOffset + _iCount );
+			std::vector< sf::Color > oOutColors( _iOffset + _iCount );
+			int iNbFailures = 0;
+
+			auto Check = [&]( bool _bValid )
+			{
+				++_iNbChecks;
+
+				if( _bValid == false )
+					++iNbFailures;
+			};
+
+			const float* pX = _oData.m_oX.data() + _iOffset;
+			const float* pY = _oData.m_oY.data() + _iOffset;
+			const sf::Vector2f* pVectors = _oData.m_oVectors.data() + _iOffset;
+
+			fzn::Math::BatchLerp( pX, _oData.m_oToX.data() + _iOffset, Ratio, oOutX.data() + _iOffset, _iCount );
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+				Check( IsClose( oOutX[ _iOffset + iValue ], fzn::Math::Interpolate( 0.f, 1.f, pX[ iValue ], _oData.m_oToX[ _iOffset + iValue ], Ratio, false ) ) );
+
+			fzn::Math::BatchLerp( pX, _oData.m_oToX.data() + _iOffset, _oData.m_oRatios.data() + _iOffset, oOutX.data() + _iOffset, _iCount );
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+				Check( IsClose( oOutX[ _iOffset + iValue ], fzn::Math::Interpolate( 0.f, 1.f, pX[ iValue ], _oData.m_oToX[ _iOffset + iValue ], _oData.m_oRatios[ _iOffset + iValue ], false ) ) );
+
+			fzn::Math::BatchVectorLength( pX, pY, oOutX.data() + _iOffset, _iCount );
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+				Check( IsClose( oOutX[ _iOffset + iValue ], fzn::Math::VectorLength( pVectors[ iValue ] ) ) );
+
+			//In place, as the function is meant to be used.
+			std::copy( pX, pX + _iCount, oOutX.begin() + _iOffset );
+			std::copy( pY, pY + _iCount, oOutY.begin() + _iOffset );
+			fzn::Math::BatchVectorNormalize( oOutX.data() + _iOffset, oOutY.data() + _iOffset, _iCount );
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+			{
+				const sf::Vector2f vNormalized = fzn::Math::VectorNormalization( pVectors[ iValue ] );
+				Check( IsClose( oOutX[ _iOffset + iValue ], vNormalized.x ) && IsClose( oOutY[ _iOffset + iValue ], vNormalized.y ) );
+			}
+
+			fzn::Math::BatchTransformPoints( _oTransform, pX, pY, oOutX.data() + _iOffset, oOutY.data() + _iOffset, _iCount );
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+			{
+				const sf::Vector2f vTransformed = _oTransform.transformPoint( pVectors[ iValue ] );
+				Check( IsClose( oOutX[ _iOffset + iValue ], vTransformed.x ) && IsClose( oOutY[ _iOffset + iValue ], vTransformed.y ) );
+			}
+
+			//The colors have to be the same bytes, whichever code converted them.
+			fzn::Math::BatchColorLerp( _oData.m_oColors.data() + _iOffset, _oData.m_oToColors.data() + _iOffset, Ratio, oOutColors.data() + _iOffset, _iCount );
+
+			for( int iValue = 0; iValue < _iCount; ++iValue )
+				Check( oOutColors[ _iOffset + iValue ] == LerpColor( _oData.m_oColors[ _iOffset + iValue ], _oData.m_oToColors[ _iOffset + iValue ], Ratio ) );
+
+			return iNbFailures;
+		}
+	}
+
+	int MathBatchScene()
+	{
+		fzn::Random oRandom( Seed );
+		const Data oData = CreateData( oRandom, NbValues + 1 );
+
+		sf::Transform oTransform;
+		oTransform.translate( 120.f, -45.f ).rotate( 33.f ).scale( 1.5f, 0.75f );
+
+		//Results against the helpers, on the sizes covering the leftover values and on the whole arrays.
+		int iNbChecks = 0;
+		int iNbFailures = 0;
+
+		for( int iCount = 0; iCount <= MaxSmallCount; ++iCount )
+			iNbFailures += CheckFunctions( oData, oTransform, 1, iCount, iNbChecks );
+
+		iNbFailures += CheckFunctions( oData, oTransform, 0, NbValues, iNbChecks );
+		iNbFailures += CheckFunctions( oData, oTransform, 1, NbValues, iNbChecks );
+
+		iNbFailures = LogCheck( "Batch functions against the helpers", iNbFailures, iNbChecks );
+
+		//Timings, the helpers being called on each sf::Vector2f as the callers do.
+		std::vector< float > oOutX( NbValues );
+		std::vector< float > oOutY( NbValues );
+		std::vector< sf::Vector2f > oOutVectors( NbValues );
+		std::vector< sf::Color > oOutColors( NbValues );
+
+		const double dLerp = Measure( NbRuns, [&]()
+		{
+			for( int iVector = 0; iVector < NbValues; ++iVector )
+				oOutVectors[ iVector ] = fzn::Math::Interpolate( 0.f, 1.f, oData.m_oVectors[ iVector ], oData.m_oToVectors[ iVector ], 0.37f, false );
+
+			Consume( oOutVectors[ NbValues - 1 ].x );
+		} );
+
+		const double dBatchLerp = Measure( NbRuns, [&]()
+		{
+			fzn::Math::BatchLerp( oData.m_oX.data(), oData.m_oToX.data(), 0.37f, oOutX.data(), NbValues );
+			fzn::Math::BatchLerp( oData.m_oY.data(), oData.m_oToY.data(), 0.37f, oOutY.data(), NbValues );
+			Consume( oOutX[ NbValues - 1 ] );
+		} );
+
+		const double dLength = Measure( NbRuns, [&]()
+		{
+			for( int iVector = 0; iVector < NbValues; ++iVector )
+				oOutX[ iVector ] = fzn::Math::VectorLength( oData.m_oVectors[ iVector ] );
+
+			Consume( oOutX[ NbValues - 1 ] );
+		} );
+
+		const double dBatchLength = Measure( NbRuns, [&]()
+		{
+			fzn::Math::BatchVectorLength( oData.m_oX.data(), oData.m_oY.data(), oOutX.data(), NbValues );
+			Consume( oOutX[ NbValues - 1 ] );
+		} );
+
+		//The normalisation is done on copies, so each run normalizes the same vectors.
+		const double dNormalize = Measure( NbRuns, [&]()
+		{
+			for( int iVector = 0; iVector < NbValues; ++iVector )
+			{
+				oOutVectors[ iVector ] = oData.m_oVectors[ iVector ];
+				fzn::Math::VectorNormalize( oOutVectors[ iVector ] );
+			}
+
+			Consume( oOutVectors[ NbValues - 1 ].x );
+		} );
+
+		const double dBatchNormalize = Measure( NbRuns, [&]()
+		{
+			std::copy( oData.m_oX.begin(), oData.m_oX.begin() + NbValues, oOutX.begin() );
+			std::copy( oData.m_oY.begin(), oData.m_oY.begin() + NbValues, oOutY.begin() );
+			fzn::Math::BatchVectorNormalize( oOutX.data(), oOutY.data(), NbValues );
+			Consume( oOutX[ NbValues - 1 ] );
+		} );
+
+		const double dTransform = Measure( NbRuns, [&]()
+		{
+			for( int iVector = 0; iVector < NbValues; ++iVector )
+				oOutVectors[ iVector ] = oTransform.transformPoint( oData.m_oVectors[ iVector ] );
+
+			Consume( oOutVectors[ NbValues - 1 ].x );
+		} );
+
+		const double dBatchTransform = Measure( NbRuns, [&]()
+		{
+			fzn::Math::BatchTransformPoints( oTransform, oData.m_oX.data(), oData.m_oY.data(), oOutX.data(), oOutY.data(), NbValues );
+			Consume( oOutX[ NbValues - 1 ] );
+		} );
+
+		const double dColor = Measure( NbRuns, [&]()
+		{
+			for( int iColor = 0; iColor < NbValues; ++iColor )
+				oOutColors[ iColor ] = LerpColor( oData.m_oColors[ iColor ], oData.m_oToColors[ iColor ], 0.37f );
+
+			Consume( oOutColors[ NbValues - 1 ].r );
+		} );
+
+		const double dBatchColor = Measure( NbRuns, [&]()
+		{
+			fzn::Math::BatchColorLerp( oData.m_oColors.data(), oData.m_oToColors.data(), 0.37f, oOutColors.data(), NbValues );
+			Consume( oOutColors[ NbValues - 1 ].r );
+		} );
+
+		LogTime( "Lerp, Interpolate", dLerp, NbValues );
+		LogTime( "Lerp, BatchLerp on X and Y", dBatchLerp, NbValues );
+		LogSpeedup( "Lerp", dLerp, dBatchLerp );
+		LogTime( "Length, VectorLength", dLength, NbValues );
+		LogTime( "Length, BatchVectorLength", dBatchLength, NbValues );
+		LogSpeedup( "Length", dLength, dBatchLength );
+		LogTime( "Normalisation, VectorNormalize", dNormalize, NbValues );
+		LogTime( "Normalisation, BatchVectorNormalize", dBatchNormalize, NbValues );
+		LogSpeedup( "Normalisation", dNormalize, dBatchNormalize );
+		LogTime( "Transform, transformPoint", dTransform, NbValues );
+		LogTime( "Transform, BatchTransformPoints", dBatchTransform, NbValues );
+		LogSpeedup( "Transform", dTransform, dBatchTransform );
+		LogTime( "Colors, lerp per channel", dColor, NbValues );
+		LogTime( "Colors, BatchColorLerp", dBatchColor, NbValues );
+		LogSpeedup( "Colors", dColor, dBatchColor );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Random generator against the PCG32 reference sequence, Advance against stepping and default generators of the threads
+//------------------------------------------------------------------------
+
+#include <thread>
+#include <vector>
+
+#include <FZN/Includes.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		static constexpr int		NbRuns{ 20 };
+		static constexpr int		NbValues{ 1000000 };
+		static constexpr int		NbAdvances{ 200 };
+		static constexpr uint64_t	MaxSteppedAdvance{ 100000 };
+		static constexpr int		NbThreads{ 8 };
+
+		//First values of the reference implementation of PCG32 (pcg32-demo), seeded with 42 on the stream 54.
+		static constexpr uint64_t	ReferenceSeed{ 42 };
+		static constexpr uint64_t	ReferenceStream{ 54 };
+		static constexpr sf::Uint32	ReferenceValues[]{ 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+
+		bool IsSameState( const fzn::Random::State& _oStateA, const fzn::Random::State& _oStateB )
+		{
+			return _oStateA.m_uState == _oStateB.m_uState && _oStateA.m_uIncrement == _oStateB.m_uIncrement;
+		}
+	}
+
+	int RandomScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = 0;
+		int iNbChecks = 0;
+
+		//Same values as the reference implementation, so the sequences can be reproduced outside of the engine.
+		fzn::Random oReference( ReferenceSeed, ReferenceStream );
+
+		for( sf::Uint32 uExpected : ReferenceValues )
+		{
+			const sf::Uint32 uValue = oReference.Next();
+			++iNbChecks;
+
+			if( uValue != uExpected )
+			{
+				if( iNbFailures < 10 )
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Reference value %08x, expected %08x", uValue, uExpected );
+
+				++iNbFailures;
+			}
+		}
+
+		//Advance has to land on the state given by as many steps, and going round the period has to come back to the start.
+		for( int iAdvance = 0; iAdvance < NbAdvances; ++iAdvance )
+		{
+			const uint64_t uDelta = iAdvance < 64 ? (uint64_t)iAdvance : oRandom.GetValue( 0, MaxSteppedAdvance );
+			fzn::Random oStepped( oRandom.Split() );
+			fzn::Random oAdvanced( oStepped );
+			const fzn::Random::State oStart = oStepped.GetState();
+
+			for( uint64_t uStep = 0; uStep < uDelta; ++uStep )
+				oStepped.Next();
+
+			oAdvanced.Advance( uDelta );
+			++iNbChecks;
+
+			if( IsSameState( oStepped.GetState(), oAdvanced.GetState() ) == false || oStepped.Next() != oAdvanced.Next() )
+			{
+				if( iNbFailures < 10 )
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Advance of %llu differs from stepping", (unsigned long long)uDelta );
+
+				++iNbFailures;
+			}
+
+			//One step was taken after the comparison, the rest of the period leads back to the start.
+			oAdvanced.Advance( 0ull - uDelta - 1u );
+			++iNbChecks;
+
+			if( IsSameState( oAdvanced.GetState(), oStart ) == false )
+			{
+				if( iNbFailures < 10 )
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Advance of the period after %llu values doesn't come back to the start", (unsigned long long)uDelta );
+
+				++iNbFailures;
+			}
+		}
+
+		//Each thread has its own default generator, split from the master on its first use.
+		std::vector< fzn::Random::State > oThreadStates( NbThreads + 1 );
+		std::vector< std::thread > oThreads;
+
+		for( int iThread = 0; iThread < NbThreads; ++iThread )
+			oThreads.emplace_back( [&oThreadStates, iThread]() { oThreadStates[ iThread ] = fzn::Random::GetDefault().GetState(); } );
+
+		for( std::thread& oThread : oThreads )
+			oThread.join();
+
+		oThreadStates[ NbThreads ] = fzn::Random::GetDefault().GetState();
+
+		for( int iThread = 0; iThread < NbThreads + 1; ++iThread )
+		{
+			for( int iOtherThread = iThread + 1; iOtherThread < NbThreads + 1; ++iOtherThread )
+			{
+				++iNbChecks;
+
+				if( oThreadStates[ iThread ].m_uIncrement == oThreadStates[ iOtherThread ].m_uIncrement )
+				{
+					if( iNbFailures < 10 )
+						FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Threads %d and %d have the same default stream", iThread, iOtherThread );
+
+					++iNbFailures;
+				}
+			}
+		}
+
+		const double dLocal = Measure( NbRuns, [&]()
+		{
+			int iSum = 0;
+
+			for( int iValue = 0; iValue < NbValues; ++iValue )
+				iSum += oRandom.GetInt( 0, 99 );
+
+			Consume( iSum );
+		} );
+
+		const double dDefault = Measure( NbRuns, [&]()
+		{
+			int iSum = 0;
+
+			for( int iValue = 0; iValue < NbValues; ++iValue )
+				iSum += Rand( 0, 100 );
+
+			Consume( iSum );
+		} );
+
+		LogTime( "Local generator", dLocal, NbValues );
+		LogTime( "Default generator of the thread (Rand)", dDefault, NbValues );
+
+		iNbFailures = LogCheck( "Reference sequence, Advance and thread streams", iNbFailures, iNbChecks );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
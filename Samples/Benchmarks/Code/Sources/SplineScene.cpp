@@ -0,0 +1,249 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Evaluation of a spline by distance with the flat arc length tables against the former std::map lookup, results and timings
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <FZN/Includes.h>
+#include <FZN/Tools/HermiteCubicSpline.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		using ControlPoints = std::vector< fzn::HermiteCubicSpline::SplineControlPoint >;
+		using MapTable = std::map< float, float >;					//Distance along the polyline of the spline to its progression
+
+		static constexpr int	NbRuns{ 20 };
+		static constexpr int	NbControlPoints{ 64 };
+		static constexpr int	NbSegments{ NbControlPoints - 1 };
+		static constexpr int	SamplesPerSegment{ 32 };				//As many as the arc length tables of the spline, so both lookups have the same resolution
+		static constexpr int	ReferenceSamplesPerSegment{ 4096 };
+		static constexpr int	NbLookups{ 100000 };
+		static constexpr float	Tolerance{ 2e-4f };						//Relative to the distance, the tables add up chords so they are slightly shorter than the curve
+
+		//Position at a progression of the whole spline, as the spline computed it before its segment polynomials.
+		sf::Vector2f GetPositionAtProgression( const ControlPoints& _oControlPoints, float _fProgression )
+		{
+			const float fScaledProgression = _fProgression * NbSegments;
+			const int iSegment = fzn::Math::Clamp( (int)fScaledProgression, 0, NbSegments - 1 );
+			const float fT = fScaledProgression - iSegment;
+			const float fT2 = fT * fT;
+			const float fT3 = fT2 * fT;
+
+			const fzn::HermiteCubicSpline::SplineControlPoint& oStart = _oControlPoints[ iSegment ];
+			const fzn::HermiteCubicSpline::SplineControlPoint& oEnd = _oControlPoints[ iSegment + 1 ];
+
+			return ( 2.f * fT3 - 3.f * fT2 + 1.f ) * oStart.m_vPosition + ( -2.f * fT3 + 3.f * fT2 ) * oEnd.m_vPosition
+				+ ( fT3 - 2.f * fT2 + fT ) * oStart.m_vTangent + ( fT3 - fT2 ) * oEnd.m_vTangent;
+		}
+
+		//Same table as the former HermiteCubicSpline::_GenerateLookUpTable, one entry per vertex of the built spline.
+		MapTable CreateMapTable( const sf::VertexArray& _oVertices )
+		{
+			MapTable oTable;
+			oTable[ 0.f ] = 0.f;
+
+			const float fStep = 1.f / ( _oVertices.getVertexCount() - 1 );
+			float fDistance = 0.f;
+
+			for( unsigned int uVertex = 1; uVertex < _oVertices.getVertexCount(); ++uVertex )
+			{
+				fDistance += fzn::Math::VectorLength( _oVertices[ uVertex ].position - _oVertices[ uVertex - 1 ].position );
+				oTable[ fDistance ] = fzn::Math::Min( uVertex * fStep, 1.f );
+			}
+
+			return oTable;
+		}
+
+		//Same interpolation as the former HermiteCubicSpline::_MakeUniform.
+		sf::Vector2f GetMapPosition( const MapTable& _oTable, const ControlPoints& _oControlPoints, float _fDistance )
+		{
+			MapTable::const_iterator itUpper = _oTable.upper_bound( _fDistance );
+
+			if( itUpper == _oTable.cend() )
+				return GetPositionAtProgression( _oControlPoints, 1.f );
+
+			MapTable::const_iterator itLower = itUpper;
+			--itLower;
+
+			const float fInterpolationCoeff = ( _fDistance - itLower->first ) / ( itUpper->first - itLower->first );
+
+			return GetPositionAtProgression( _oControlPoints, itLower->second * ( 1.f - fInterpolationCoeff ) + itUpper->second * fInterpolationCoeff );
+		}
+
+		//Much finer polyline of the spline, in double, giving the reference positions.
+		struct Reference
+		{
+			std::vector< double >		m_oDistances;
+			std::vector< sf::Vector2f >	m_oPositions;
+		};
+
+		Reference CreateReference( const ControlPoints& _oControlPoints )
+		{
+			static constexpr int NbSamples{ NbSegments * ReferenceSamplesPerSegment };
+
+			Reference oReference;
+			oReference.m_oDistances.push_back( 0. );
+			oReference.m_oPositions.push_back( _oControlPoints.front().m_vPosition );
+
+			for( int iSample = 1; iSample <= NbSamples; ++iSample )
+			{
+				const sf::Vector2f vPosition = GetPositionAtProgression( _oControlPoints, (float)( (double)iSample / NbSamples ) );
+				const sf::Vector2f vDelta = vPosition - oReference.m_oPositions.back();
+
+				oReference.m_oDistances.push_back( oReference.m_oDistances.back() + std::sqrt( (double)vDelta.x * vDelta.x + (double)vDelta.y * vDelta.y ) );
+				oReference.m_oPositions.push_back( vPosition );
+			}
+
+			return oReference;
+		}
+
+		sf::Vector2f GetReferencePosition( const Reference& _oReference, float _fDistance )
+		{
+			const std::vector< double >& oDistances = _oReference.m_oDistances;
+			const int iUpper = fzn::Math::Clamp( (int)( std::upper_bound( oDistances.begin(), oDistances.end(), (double)_fDistance ) - oDistances.begin() ), 1, (int)oDistances.size() - 1 );
+			const double dSampleLength = oDistances[ iUpper ] - oDistances[ iUpper - 1 ];
+			const float fRatio = dSampleLength > 0. ? (float)fzn::Math::Clamp( ( _fDistance - oDistances[ iUpper - 1 ] ) / dSampleLength, 0., 1. ) : 0.f;
+
+			return _oReference.m_oPositions[ iUpper - 1 ] + ( _oReference.m_oPositions[ iUpper ] - _oReference.m_oPositions[ iUpper - 1 ] ) * fRatio;
+		}
+	}
+
+	int SplineScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = 0;
+		int iNbChecks = 0;
+
+		//Irregular spacing between the control points, so the distance isn't proportional to the progression.
+		std::vector< sf::Vector2f > oPositions;
+		sf::Vector2f vPosition( 0.f, 0.f );
+
+		for( int iControlPoint = 0; iControlPoint < NbControlPoints; ++iControlPoint )
+		{
+			oPositions.push_back( vPosition );
+			vPosition += sf::Vector2f( oRandom.GetFloat( 10.f, 300.f ), oRandom.GetFloat( -200.f, 200.f ) );
+		}
+
+		fzn::HermiteCubicSpline oSpline;
+		oSpline.SetControlPoints( oPositions );
+		oSpline.SetSteps( NbSegments * SamplesPerSegment );
+		oSpline.Build();
+
+		const ControlPoints& oControlPoints = oSpline.GetControlPoints();
+		const MapTable oTable = CreateMapTable( oSpline.GetVertices() );
+		const Reference oReference = CreateReference( oControlPoints );
+		const float fLength = oSpline.GetLength();
+
+		std::vector< float > oDistances( NbLookups );
+
+		for( float& fDistance : oDistances )
+			fDistance = oRandom.GetFloat( 0.f, fLength );
+
+		std::vector< float > oSortedDistances = oDistances;
+		std::sort( oSortedDistances.begin(), oSortedDistances.end() );
+
+		//Positions against the reference, the former lookup is only reported.
+		float fMaxMapError = 0.f;
+		float fMaxTablesError = 0.f;
+
+		for( float fDistance : oDistances )
+		{
+			const sf::Vector2f vReference = GetReferencePosition( oReference, fDistance );
+			const float fMapError = fzn::Math::VectorLength( GetMapPosition( oTable, oControlPoints, fDistance ) - vReference );
+			const float fTablesError = fzn::Math::VectorLength( oSpline.GetPositionAtDistance( fDistance ) - vReference );
+
+			fMaxMapError = fzn::Math::Max( fMaxMapError, fMapError );
+			fMaxTablesError = fzn::Math::Max( fMaxTablesError, fTablesError );
+			++iNbChecks;
+
+			if( fTablesError > Tolerance * fzn::Math::Max( fDistance, 100.f ) )
+			{
+				if( iNbFailures < 10 )
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Distance %f: %f pixels from the reference", fDistance, fTablesError );
+
+				++iNbFailures;
+			}
+		}
+
+		//The sorted samples follow the segments instead of searching them, they have to give the same positions.
+		std::vector< sf::Vector2f > oSamples( NbLookups );
+		oSpline.SampleAtDistances( oSortedDistances.data(), NbLookups, oSamples.data() );
+
+		for( int iSample = 0; iSample < NbLookups; ++iSample )
+		{
+			++iNbChecks;
+
+			if( oSamples[ iSample ] != oSpline.GetPositionAtDistance( oSortedDistances[ iSample ] ) )
+			{
+				if( iNbFailures < 10 )
+					FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Sorted distance %f: sampled position differs", oSortedDistances[ iSample ] );
+
+				++iNbFailures;
+			}
+		}
+
+		const double dMap = Measure( NbRuns, [&]()
+		{
+			double dSum = 0.;
+
+			for( float fDistance : oDistances )
+				dSum += GetMapPosition( oTable, oControlPoints, fDistance ).x;
+
+			Consume( dSum );
+		} );
+
+		const double dTables = Measure( NbRuns, [&]()
+		{
+			double dSum = 0.;
+
+			for( float fDistance : oDistances )
+				dSum += oSpline.GetPositionAtDistance( fDistance ).x;
+
+			Consume( dSum );
+		} );
+
+		const double dSortedMap = Measure( NbRuns, [&]()
+		{
+			double dSum = 0.;
+
+			for( float fDistance : oSortedDistances )
+				dSum += GetMapPosition( oTable, oControlPoints, fDistance ).x;
+
+			Consume( dSum );
+		} );
+
+		const double dSortedTables = Measure( NbRuns, [&]()
+		{
+			oSpline.SampleAtDistances( oSortedDistances.data(), NbLookups, oSamples.data() );
+			Consume( oSamples.back().x );
+		} );
+
+		const std::string sEntries = std::to_string( oTable.size() ) + " entries";
+
+		LogTime( ( "std::map lookup, " + sEntries ).c_str(), dMap, NbLookups );
+		LogTime( "Flat arc length tables", dTables, NbLookups );
+		LogSpeedup( "Flat tables against std::map", dMap, dTables );
+		LogTime( ( "std::map lookup, sorted, " + sEntries ).c_str(), dSortedMap, NbLookups );
+		LogTime( "SampleAtDistances, sorted", dSortedTables, NbLookups );
+		LogSpeedup( "SampleAtDistances against std::map", dSortedMap, dSortedTables );
+
+		FZN_LOG( "%-48s %10.4f px", "Max error, std::map lookup", fMaxMapError );
+		FZN_LOG( "%-48s %10.4f px", "Max error, flat tables", fMaxTablesError );
+
+		iNbFailures = LogCheck( "Positions against the reference polyline", iNbFailures, iNbChecks );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
@@ -0,0 +1,350 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Hierarchical states of a FZNStateTable, checked against a reference model of the transitions and timed
+//------------------------------------------------------------------------
+
+#include <memory>
+#include <vector>
+
+#include <FZN/Includes.h>
+#include <FZN/Game/StateMachine/FZNStateTable.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		static constexpr int	NbRuns{ 20 };
+		static constexpr int	NbAgents{ 10000 };
+		static constexpr int	NbCheckedAgents{ 200 };
+		static constexpr int	NbCheckedSteps{ 500 };
+		static constexpr int	NoState{ -1 };
+
+		//Alive
+		//	Patrol		(Walk, Look)
+		//	Combat		(Shoot, Reload)
+		//Dead
+		enum class AgentState
+		{
+			Alive,
+			Patrol,
+			Walk,
+			Look,
+			Combat,
+			Shoot,
+			Reload,
+			Dead,
+			COUNT,
+		};
+
+		static constexpr int NbStates{ (int)AgentState::COUNT };
+
+		//Description of the states used by the reference model, independently of the table.
+		static const int s_aParents[ NbStates ]			= { NoState, 0, 1, 1, 0, 4, 4, NoState };
+		static const bool s_aOwnUpdates[ NbStates ]		= { true, true, false, false, false, true, false, false };
+		static const int s_aChainedOnEnter[ NbStates ]	= { NoState, NoState, NoState, NoState, NoState, NoState, (int)AgentState::Shoot, NoState };	//Enter called by the enter function
+		static const int s_aQueuedOnEnter[ NbStates ]	= { NoState, NoState, NoState, (int)AgentState::Walk, NoState, NoState, NoState, NoState };	//QueueTransition called by the enter function
+
+		enum EventType
+		{
+			eEnter,
+			eExit,
+			eUpdate,
+		};
+
+		int GetEvent( EventType _eType, int _iState, int _iOtherState )
+		{
+			return ( _eType << 16 ) | ( _iState << 8 ) | ( _iOtherState & 0xff );
+		}
+
+		class Agent
+		{
+		public:
+			typedef fzn::FZNStateTable< Agent, AgentState > Table;
+
+			Agent( const Table& _oTable ) : m_oMachine( _oTable, this ) {}
+
+			template< AgentState eState >
+			void OnEnter( AgentState _ePreviousState )
+			{
+				if( m_bRecord )
+					m_oEvents.push_back( GetEvent( eEnter, (int)eState, (int)_ePreviousState ) );
+
+				if( s_aChainedOnEnter[ (int)eState ] != NoState )
+					m_oMachine.Enter( (AgentState)s_aChainedOnEnter[ (int)eState ] );
+
+				if( s_aQueuedOnEnter[ (int)eState ] != NoState )
+					m_oMachine.QueueTransition( (AgentState)s_aQueuedOnEnter[ (int)eState ] );
+			}
+
+			template< AgentState eState >
+			void OnExit( AgentState _eNextState )
+			{
+				if( m_bRecord )
+					m_oEvents.push_back( GetEvent( eExit, (int)eState, (int)_eNextState ) );
+			}
+
+			template< AgentState eState >
+			AgentState OnUpdate()
+			{
+				const AgentState eNextState = m_bStay ? m_oMachine.GetCurrentState() : m_eNextState;
+
+				if( m_bRecord )
+					m_oEvents.push_back( GetEvent( eUpdate, (int)eState, (int)eNextState ) );
+
+				++m_iNbUpdates;
+				return eNextState;
+			}
+
+			fzn::FZNTableStateMachine< Agent, AgentState >	m_oMachine;
+			AgentState										m_eNextState{ AgentState::Alive };		//Returned by the update functions, unless they stay in the current state
+			bool											m_bStay{ false };
+			std::vector< int >								m_oEvents;
+			bool											m_bRecord{ false };
+			int												m_iNbUpdates{ 0 };
+		};
+
+		template< AgentState eState >
+		void SetState( Agent::Table& _oTable, bool _bOwnUpdate )
+		{
+			_oTable.SetState( eState, &Agent::OnEnter< eState >, &Agent::OnExit< eState >, _bOwnUpdate ? &Agent::OnUpdate< eState > : nullptr );
+
+			if( s_aParents[ (int)eState ] != NoState )
+				_oTable.SetParent( eState, (AgentState)s_aParents[ (int)eState ] );
+		}
+
+		bool BuildTable( Agent::Table& _oTable )
+		{
+			SetState< AgentState::Alive >( _oTable, s_aOwnUpdates[ 0 ] );
+			SetState< AgentState::Patrol >( _oTable, s_aOwnUpdates[ 1 ] );
+			SetState< AgentState::Walk >( _oTable, s_aOwnUpdates[ 2 ] );
+			SetState< AgentState::Look >( _oTable, s_aOwnUpdates[ 3 ] );
+			SetState< AgentState::Combat >( _oTable, s_aOwnUpdates[ 4 ] );
+			SetState< AgentState::Shoot >( _oTable, s_aOwnUpdates[ 5 ] );
+			SetState< AgentState::Reload >( _oTable, s_aOwnUpdates[ 6 ] );
+			SetState< AgentState::Dead >( _oTable, s_aOwnUpdates[ 7 ] );
+
+			return _oTable.Build();
+		}
+
+
+		/////////////////REFERENCE MODEL/////////////////
+
+		//Straightforward version of the documented behaviour: the paths from the roots are compared to find the exited and entered states.
+		struct ReferenceMachine
+		{
+			static std::vector< int > GetPath( int _iState )
+			{
+				std::vector< int > oPath;
+
+				for( int iState = _iState ; iState != NoState ; iState = s_aParents[ iState ] )
+					oPath.insert( oPath.begin(), iState );
+
+				return oPath;
+			}
+
+			void Transition( int _iState )
+			{
+				const std::vector< int > oFrom = GetPath( m_iCurrentState );
+				const std::vector< int > oTo = GetPath( _iState );
+				size_t uNbCommonStates = 0;
+
+				while( uNbCommonStates < oFrom.size() && uNbCommonStates < oTo.size() && oFrom[ uNbCommonStates ] == oTo[ uNbCommonStates ] )
+					++uNbCommonStates;
+
+				//Entering the current state again only exits and enters it.
+				if( m_iCurrentState == _iState )
+					uNbCommonStates = oTo.size() - 1;
+
+				for( size_t uExited = oFrom.size() ; uExited > uNbCommonStates ; --uExited )
+					m_oEvents.push_back( GetEvent( eExit, oFrom[ uExited - 1 ], _iState ) );
+
+				const int iPreviousState = m_iCurrentState;
+				m_iCurrentState = _iState;
+
+				for( size_t uEntered = uNbCommonStates ; uEntered < oTo.size() ; ++uEntered )
+				{
+					m_oEvents.push_back( GetEvent( eEnter, oTo[ uEntered ], iPreviousState ) );
+
+					if( s_aChainedOnEnter[ oTo[ uEntered ] ] != NoState )
+						m_oChained.push_back( s_aChainedOnEnter[ oTo[ uEntered ] ] );
+
+					if( s_aQueuedOnEnter[ oTo[ uEntered ] ] != NoState )
+						m_oQueued.push_back( s_aQueuedOnEnter[ oTo[ uEntered ] ] );
+				}
+			}
+
+			void Enter( int _iState )
+			{
+				Transition( _iState );
+
+				while( m_oChained.empty() == false )
+				{
+					const int iState = m_oChained.front();
+					m_oChained.erase( m_oChained.begin() );
+					Transition( iState );
+				}
+			}
+
+			void Update( int _iNextState, bool _bStay )
+			{
+				const size_t uNbQueued = m_oQueued.size();
+
+				for( size_t uQueued = 0 ; uQueued < uNbQueued ; ++uQueued )
+				{
+					const int iState = m_oQueued.front();
+					m_oQueued.erase( m_oQueued.begin() );
+					Enter( iState );
+				}
+
+				int iUpdate = m_iCurrentState;
+
+				while( iUpdate != NoState && s_aOwnUpdates[ iUpdate ] == false )
+					iUpdate = s_aParents[ iUpdate ];
+
+				if( iUpdate == NoState )
+					return;
+
+				if( _bStay )
+					_iNextState = m_iCurrentState;
+
+				m_oEvents.push_back( GetEvent( eUpdate, iUpdate, _iNextState ) );
+
+				if( _iNextState != m_iCurrentState )
+					Enter( _iNextState );
+			}
+
+			int					m_iCurrentState{ NoState };
+			std::vector< int >	m_oChained;
+			std::vector< int >	m_oQueued;
+			std::vector< int >	m_oEvents;
+		};
+	}
+
+	int StateTableScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = 0;
+		int iNbChecks = 0;
+
+		Agent::Table oTable;
+
+		if( BuildTable( oTable ) == false )
+			return LogCheck( "Build of the table", 1, 1 );
+
+		//Random Enter, QueueTransition and Update calls, the events of the machine have to match the model.
+		for( int iAgent = 0; iAgent < NbCheckedAgents; ++iAgent )
+		{
+			Agent oAgent( oTable );
+			oAgent.m_bRecord = true;
+			ReferenceMachine oReference;
+
+			for( int iStep = 0; iStep < NbCheckedSteps; ++iStep )
+			{
+				int iAction = oRandom.GetInt( 0, 3 );
+				const int iState = oRandom.GetInt( 0, NbStates - 1 );
+
+				//The queue of the machine is bounded and the model doesn't drop anything, so it is emptied by an update before it fills up.
+				if( oReference.m_oQueued.size() >= 4 )
+					iAction = 2;
+
+				if( iAction == 0 )
+				{
+					oAgent.m_oMachine.Enter( (AgentState)iState );
+					oReference.Enter( iState );
+				}
+				else if( iAction == 1 )
+				{
+					oAgent.m_oMachine.QueueTransition( (AgentState)iState );
+					oReference.m_oQueued.push_back( iState );
+				}
+				else
+				{
+					//Half of the updates stay in the current state.
+					oAgent.m_eNextState = (AgentState)iState;
+					oAgent.m_bStay = iAction == 3;
+					oAgent.m_oMachine.Update();
+					oReference.Update( iState, iAction == 3 );
+				}
+
+				++iNbChecks;
+
+				if( oAgent.m_oEvents != oReference.m_oEvents || oAgent.m_oMachine.GetCurrentStateID() != oReference.m_iCurrentState )
+				{
+					if( iNbFailures < 10 )
+						FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Agent %d, step %d (action %d, state %d): %d events, %d expected, state %d, %d expected", iAgent, iStep, iAction, iState, (int)oAgent.m_oEvents.size(), (int)oReference.m_oEvents.size(), oAgent.m_oMachine.GetCurrentStateID(), oReference.m_iCurrentState );
+
+					++iNbFailures;
+					break;
+				}
+
+				oAgent.m_oEvents.clear();
+				oReference.m_oEvents.clear();
+			}
+		}
+
+		//Timings, without recording the events.
+		std::vector< std::unique_ptr< Agent > > oAgents;
+
+		for( int iAgent = 0; iAgent < NbAgents; ++iAgent )
+			oAgents.push_back( std::make_unique< Agent >( oTable ) );
+
+		auto EnterAll = [&]( AgentState _eState )
+		{
+			for( std::unique_ptr< Agent >& pAgent : oAgents )
+			{
+				pAgent->m_oMachine.Enter( _eState );
+				pAgent->m_eNextState = _eState;
+			}
+		};
+
+		auto UpdateAll = [&]()
+		{
+			for( std::unique_ptr< Agent >& pAgent : oAgents )
+				pAgent->m_oMachine.Update();
+
+			Consume( oAgents.front()->m_iNbUpdates );
+		};
+
+		EnterAll( AgentState::Patrol );
+		const double dOwnUpdate = Measure( NbRuns, UpdateAll );
+
+		//Walk uses the update of Patrol, found by Build.
+		EnterAll( AgentState::Walk );
+		const double dInheritedUpdate = Measure( NbRuns, UpdateAll );
+
+		//Walk and Shoot only share Alive: two states are exited and two are entered.
+		const double dTransitions = Measure( NbRuns, [&]()
+		{
+			for( std::unique_ptr< Agent >& pAgent : oAgents )
+			{
+				pAgent->m_oMachine.Enter( AgentState::Shoot );
+				pAgent->m_oMachine.Enter( AgentState::Walk );
+			}
+		} );
+
+		const double dQueuedTransitions = Measure( NbRuns, [&]()
+		{
+			for( std::unique_ptr< Agent >& pAgent : oAgents )
+			{
+				pAgent->m_oMachine.QueueTransition( AgentState::Shoot );
+				pAgent->m_oMachine.QueueTransition( AgentState::Walk );
+			}
+
+			UpdateAll();
+		} );
+
+		LogTime( "Update, own function", dOwnUpdate, NbAgents );
+		LogTime( "Update, function inherited from the parent", dInheritedUpdate, NbAgents );
+		LogTime( "Transition through the common ancestor", dTransitions, NbAgents * 2 );
+		LogTime( "Two queued transitions and an update", dQueuedTransitions, NbAgents );
+
+		iNbFailures = LogCheck( "Transitions against the reference model", iNbFailures, iNbChecks );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
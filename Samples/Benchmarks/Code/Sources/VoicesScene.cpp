@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19.10.26
+//Description : Lookup of the voice of a sound with the null backend, by handle (what the AudioManager does) and by scanning the active voices
+//------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include <SFML/Audio/SoundBuffer.hpp>
+
+#include <FZN/Includes.h>
+#include <FZN/Audio/VoiceManager.h>
+#include <FZN/Tools/Random.h>
+
+#include "Benchmark.h"
+
+
+namespace Benchmark
+{
+	namespace
+	{
+		static constexpr int	NbRuns{ 20 };
+		static constexpr int	NbSounds{ 1024 };			//More sounds than voices, so the voices are stolen
+		static constexpr int	NbSteps{ 600 };
+		static constexpr int	NbRequestsPerStep{ 32 };
+		static constexpr int	NbLookups{ 100000 };
+		static constexpr float	DeltaTime{ 1.f / 60.f };
+		static constexpr int	SampleRate{ 44100 };
+	}
+
+	int VoicesScene()
+	{
+		fzn::Random oRandom( Seed );
+		int iNbFailures = 0;
+		int iNbChecks = 0;
+
+		//One second of silence, the null backend never reads it.
+		const std::vector< sf::Int16 > oSamples( SampleRate, 0 );
+		sf::SoundBuffer oBuffer;
+		oBuffer.loadFromSamples( oSamples.data(), oSamples.size(), 1, SampleRate );
+
+		fzn::VoiceManager oVoices( new fzn::NullVoiceBackend() );
+
+		//Last voice started for each sound, as in AudioManager::ResolvedSound.
+		//Each sound is played "only one" at a time, so its voice is the only one the scan can find.
+		std::vector< fzn::VoiceHandle > oSoundVoices( NbSounds, fzn::INVALID_VOICE );
+
+		for( int iStep = 0; iStep < NbSteps; ++iStep )
+		{
+			for( int iRequest = 0; iRequest < NbRequestsPerStep; ++iRequest )
+			{
+				const int iSound = oRandom.GetInt( 0, NbSounds - 1 );
+				fzn::VoiceHandle& uVoice = oSoundVoices[ iSound ];
+
+				if( oRandom.GetInt( 0, 3 ) == 0 )
+				{
+					oVoices.Stop( uVoice );
+					continue;
+				}
+
+				if( oVoices.IsValid( uVoice ) )
+					continue;
+
+				fzn::VoiceManager::PlayDesc oDesc;
+				oDesc.m_uSound		= (uint32_t)iSound;
+				oDesc.m_iPriority	= oRandom.GetInt( 0, 255 );
+				oDesc.m_bLoop		= oRandom.GetInt( 0, 3 ) == 0;
+
+				const fzn::VoiceHandle uNewVoice = oVoices.Play( oBuffer, oDesc );
+
+				if( uNewVoice != fzn::INVALID_VOICE )
+					uVoice = uNewVoice;
+			}
+
+			oVoices.Update( DeltaTime );
+
+			for( int iSound = 0; iSound < NbSounds; ++iSound )
+			{
+				const fzn::VoiceHandle uVoice = oVoices.IsValid( oSoundVoices[ iSound ] ) ? oSoundVoices[ iSound ] : fzn::INVALID_VOICE;
+				const fzn::VoiceHandle uFoundVoice = oVoices.FindVoice( (uint32_t)iSound );
+
+				++iNbChecks;
+
+				if( uVoice != uFoundVoice )
+				{
+					if( iNbFailures < 10 )
+						FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "Step %d, sound %d: handle %08x, found %08x", iStep, iSound, uVoice, uFoundVoice );
+
+					++iNbFailures;
+				}
+			}
+		}
+
+		//Lookups with a full pool of voices.
+		for( int iSound = 0; iSound < NbSounds; ++iSound )
+		{
+			if( oVoices.IsValid( oSoundVoices[ iSound ] ) )
+				continue;
+
+			fzn::VoiceManager::PlayDesc oDesc;
+			oDesc.m_uSound	= (uint32_t)iSound;
+			oDesc.m_bLoop	= true;
+
+			const fzn::VoiceHandle uNewVoice = oVoices.Play( oBuffer, oDesc );
+
+			if( uNewVoice != fzn::INVALID_VOICE )
+				oSoundVoices[ iSound ] = uNewVoice;
+		}
+
+		std::vector< int > oLookups( NbLookups );
+
+		for( int& iSound : oLookups )
+			iSound = oRandom.GetInt( 0, NbSounds - 1 );
+
+		const double dScan = Measure( NbRuns, [&]()
+		{
+			int iNbFound = 0;
+
+			for( int iSound : oLookups )
+				iNbFound += oVoices.FindVoice( (uint32_t)iSound ) != fzn::INVALID_VOICE ? 1 : 0;
+
+			Consume( iNbFound );
+		} );
+
+		const double dHandle = Measure( NbRuns, [&]()
+		{
+			int iNbFound = 0;
+
+			for( int iSound : oLookups )
+				iNbFound += oVoices.IsValid( oSoundVoices[ iSound ] ) ? 1 : 0;
+
+			Consume( iNbFound );
+		} );
+
+		const std::string sVoices = std::to_string( oVoices.GetNbActiveVoices() ) + " voices";
+
+		LogTime( ( "Scan of the active voices, " + sVoices ).c_str(), dScan, NbLookups );
+		LogTime( ( "Handle with generation, " + sVoices ).c_str(), dHandle, NbLookups );
+		LogSpeedup( "Handle against scan", dScan, dHandle );
+
+		iNbFailures = LogCheck( "Handles against the scan of the voices", iNbFailures, iNbChecks );
+
+		return iNbFailures;
+	}
+} //namespace Benchmark
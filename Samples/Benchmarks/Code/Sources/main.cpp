@@ -0,0 +1,69 @@
+﻿//------------------------------------------------------------------------
+//Author : Philippe OFFERMANN
+//Date : 19/10/2026
+//Description : Entry point of the program
+//------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include <FZN/Includes.h>
+
+#include "Benchmark.h"
+
+
+struct Scene
+{
+	const char*	m_sName;
+	int			( *m_pFunction )();
+};
+
+static const Scene g_aScenes[] =
+{
+	{ "Localisation",		Benchmark::LocalisationScene },
+	{ "Containers",			Benchmark::ContainersScene },
+	{ "BehaviorTree",		Benchmark::BehaviorTreeScene },
+	{ "Formation",			Benchmark::FormationScene },
+	{ "MathBatch",			Benchmark::MathBatchScene },
+	{ "ConvexCollision",	Benchmark::ConvexCollisionScene },
+	{ "Voices",				Benchmark::VoicesScene },
+	{ "StateTable",			Benchmark::StateTableScene },
+	{ "Spline",				Benchmark::SplineScene },
+	{ "CollisionWorld",		Benchmark::CollisionWorldScene },
+	{ "Random",				Benchmark::RandomScene },
+};
+
+
+int main( int _iNbArgs, char* _pArgs[] )
+{
+	fzn::FazonCore::CreateInstance( { "Benchmarks", FZNProjectType::Application } );
+
+	//Changing the titles of the window and the console
+	g_pFZN_Core->ConsoleTitle( g_pFZN_Core->GetProjectName().c_str() );
+
+	g_pFZN_Core->GreetingMessage();
+
+#ifdef _DEBUG
+	FZN_COLOR_LOG( fzn::DBG_MSG_COL_YELLOW, "Debug build, the timings aren't representative (use Release or Retail)." );
+#endif
+
+	//The scenes to run can be given as arguments ("Benchmarks.exe Localisation"), all of them are run otherwise.
+	int iNbFailures = 0;
+
+	for( const Scene& oScene : g_aScenes )
+	{
+		if( _iNbArgs > 1 && std::none_of( _pArgs + 1, _pArgs + _iNbArgs, [&oScene]( const char* _sArg ) { return strcmp( _sArg, oScene.m_sName ) == 0; } ) )
+			continue;
+
+		Benchmark::LogScene( oScene.m_sName );
+		iNbFailures += oScene.m_pFunction();
+	}
+
+	if( iNbFailures > 0 )
+		FZN_COLOR_LOG( fzn::DBG_MSG_COL_RED, "%d mismatches.", iNbFailures );
+	else
+		FZN_COLOR_LOG( fzn::DBG_MSG_COL_GREEN, "All the cross-checks passed." );
+
+	fzn::FazonCore::DestroyInstance();
+
+	return iNbFailures;
+}